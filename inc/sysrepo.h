@@ -347,6 +347,9 @@ typedef enum sr_session_flag_e {
     SR_SESS_CONFIG_ONLY = 1,   /**< Session will process only configuration data (e.g. sysrepo won't
                                     return any state data by ::sr_get_items / ::sr_get_items_iter calls). */
     SR_SESS_ENABLE_NACM = 2,   /**< Enable NETCONF access control for this session (disabled by default). */
+    SR_SESS_TRUSTED = 4,       /**< Trusted session - content of its RPCs, actions and ephemeral event notifications
+                                    is not validated, they are forwarded to the subscribers as they are. Only root
+                                    and the user / group configured at build time can start a trusted session. */
 
     SR_SESS_MUTABLE_OPTS = 3   /**< Bit-mask of options that can be set by the user
                                     (immutable flags are defined in sysrepo.proto file). */
@@ -1181,14 +1184,32 @@ typedef enum sr_subscr_flag_e {
      * and replay has finished (::SR_EV_NOTIF_REPLAY_COMPLETE is delivered).
      */
     SR_SUBSCR_NOTIF_REPLAY_FIRST = 32,
+
+    /**
+     * @brief Changes selected by the subscription are delivered together with the module / subtree change
+     * notification, so that ::sr_get_changes_iter called with the subscribed xpath (or "/<module>:*" for module
+     * change subscriptions) does not need to ask Sysrepo Engine for them. Changes selected by any other xpath
+     * are still retrieved from Sysrepo Engine.
+     */
+    SR_SUBSCR_INLINE_CHANGES = 64,
 } sr_subscr_flag_t;
 
+/**
+ * @brief Maximum validity period (in milliseconds) of operational data that can be declared
+ * by ::sr_dp_get_items_subscribe_cached and ::sr_dp_get_items_batch_subscribe_cached (one day).
+ */
+#define SR_DP_CACHE_TTL_MAX (24 * 60 * 60 * 1000)
+
 /**
  * @brief Type of the notification event that has occurred (passed to notification callbacks).
  *
  * @note Each change is normally notified twice: first as ::SR_EV_VERIFY event and then as ::SR_EV_APPLY or ::SR_EV_ABORT
  * event. If the subscriber does not support verification, it can subscribe only to ::SR_EV_APPLY event by providing
  * ::SR_SUBSCR_APPLY_ONLY subscription flag.
+ *
+ * @note ::SR_EV_VERIFY is delivered to all verifiers with the same priority at once, verifiers with lower priority
+ * are notified only after all verifiers with higher priority have accepted the changes. Once a verifier denies
+ * the changes, the remaining verifiers are not notified at all (and they do not receive ::SR_EV_ABORT either).
  */
 typedef enum sr_notif_event_e {
     SR_EV_VERIFY,  /**< Occurs just before the changes are committed to the datastore,
@@ -1793,6 +1814,35 @@ int sr_event_notif_send(sr_session_ctx_t *session, const char *xpath, const sr_v
 int sr_event_notif_send_tree(sr_session_ctx_t *session, const char *xpath, const sr_node_t *trees,
         const size_t tree_cnt, sr_ev_notif_flag_t opts);
 
+/**
+ * @brief Event notification to be sent within a batch by ::sr_event_notif_send_batch.
+ * The notification data are represented either by values or by trees.
+ */
+typedef struct sr_event_notif_entry_s {
+    const char *xpath;          /**< XPath identifying the event notification. */
+    const sr_val_t *values;     /**< Array of all nodes that hold some data in event notification subtree. */
+    size_t values_cnt;          /**< Number of items inside the values array. */
+    const sr_node_t *trees;     /**< Array of subtrees carrying event notification data (used instead of values if set). */
+    size_t tree_cnt;            /**< Number of subtrees with data. */
+    time_t timestamp;           /**< Time when the notification has been generated, 0 stands for the time of sending. */
+} sr_event_notif_entry_t;
+
+/**
+ * @brief Sends a batch of event notifications in a single request and waits for the result.
+ * All the notifications are validated first (the batch is rejected as a whole if any of them is invalid),
+ * then stored in the notification store at once and delivered to the subscribers in the order of the array.
+ *
+ * @param[in] session Session context acquired with ::sr_session_start call.
+ * @param[in] entries Array of event notifications.
+ * @param[in] entry_cnt Number of items inside the entries array.
+ * @param[in] opts Options overriding default handling of the notifications, it is supposed to be
+ * a bitwise OR-ed value of any ::sr_ev_notif_flag_t flags.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+int sr_event_notif_send_batch(sr_session_ctx_t *session, const sr_event_notif_entry_t *entries, size_t entry_cnt,
+        sr_ev_notif_flag_t opts);
+
 /**
  * @brief Replays already generated notifications stored in the notification store related to
  * the provided notification subscription (or subscriptions, in case that ::SR_SUBSCR_CTX_REUSE
@@ -1832,6 +1882,12 @@ int sr_event_notif_replay(sr_session_ctx_t *session, sr_subscription_ctx_t *subs
  * The xpath argument passed to callback can be only the xpath that was used for the subscription, or xpath of
  * any nested lists or containers.
  *
+ * @note Requests for the same level in multiple list instances are delivered to the subscriber in one message,
+ * the callback is then called for each of the xpaths. Use ::sr_dp_get_items_batch_cb to process them in one call.
+ * If the callback fails for one of the xpaths, only the data of that xpath are missing.
+ * @note If the subscription declared a validity period of the data (::sr_dp_get_items_subscribe_cached), the callback
+ * is not called until the previously provided data expire.
+ *
  * @param[in] xpath XPath identifying the level under which the nodes are requested.
  * @param[out] values Array of values at the selected level (allocated by the provider).
  * @param[out] values_cnt Number of values returned.
@@ -1862,6 +1918,193 @@ typedef int (*sr_dp_get_items_cb)(const char *xpath, sr_val_t **values, size_t *
 int sr_dp_get_items_subscribe(sr_session_ctx_t *session, const char *xpath, sr_dp_get_items_cb callback, void *private_ctx,
         sr_subscr_options_t opts, sr_subscription_ctx_t **subscription);
 
+/**
+ * @brief Callback to be called when operational data at multiple levels is requested at once.
+ * Subscribe to it by ::sr_dp_get_items_batch_subscribe call.
+ *
+ * Sysrepo groups the requests addressed to the same data provider (e.g. the same nested container
+ * in all instances of a list) and asks for all of them in one call. For each of the xpaths, the provider
+ * is supposed to return the same values as described for ::sr_dp_get_items_cb, values of all xpaths
+ * are returned in one array (in any order).
+ *
+ * @param[in] xpaths Array of XPaths identifying the levels under which the nodes are requested.
+ * @param[in] xpath_cnt Number of XPaths in the array.
+ * @param[out] values Array of values at all of the selected levels (allocated by the provider).
+ * @param[out] values_cnt Number of values returned.
+ * @param[in] private_ctx Private context opaque to sysrepo, as passed to ::sr_dp_get_items_batch_subscribe call.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+typedef int (*sr_dp_get_items_batch_cb)(const char **xpaths, size_t xpath_cnt, sr_val_t **values, size_t *values_cnt,
+        void *private_ctx);
+
+/**
+ * @brief Registers for providing of operational data under given xpath, with the data of multiple
+ * xpaths being requested in one callback call.
+ *
+ * @note The XPath must be generic - must not include any list key values.
+ * @note This API works only for operational data (subtrees marked in YANG as "config false").
+ * Subscribing as a data provider for configuration data does not have any effect.
+ *
+ * @param[in] session Session context acquired with ::sr_session_start call.
+ * @param[in] xpath XPath identifying the subtree under which the provider is able to provide
+ * operational data.
+ * @param[in] callback Callback to be called when the operational data under given xpath is needed.
+ * @param[in] private_ctx Private context passed to the callback function, opaque to sysrepo.
+ * @param[in] opts Options overriding default behavior of the subscription, it is supposed to be
+ * a bitwise OR-ed value of any ::sr_subscr_flag_t flags.
+ * @param[in,out] subscription Subscription context that is supposed to be released by ::sr_unsubscribe.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+int sr_dp_get_items_batch_subscribe(sr_session_ctx_t *session, const char *xpath, sr_dp_get_items_batch_cb callback,
+        void *private_ctx, sr_subscr_options_t opts, sr_subscription_ctx_t **subscription);
+
+/**
+ * @brief Registers for providing of operational data under given xpath, declaring that the provided data
+ * stay valid for the given period. Sysrepo caches the data returned for each requested xpath and serves
+ * subsequent requests from the cache until the data expire or are invalidated by ::sr_dp_cache_invalidate.
+ * Otherwise behaves the same as ::sr_dp_get_items_subscribe.
+ *
+ * @param[in] session Session context acquired with ::sr_session_start call.
+ * @param[in] xpath XPath identifying the subtree under which the provider is able to provide
+ * operational data.
+ * @param[in] callback Callback to be called when the operational data under given xpath is needed.
+ * @param[in] private_ctx Private context passed to the callback function, opaque to sysrepo.
+ * @param[in] cache_ttl Validity period of the provided data in milliseconds, up to ::SR_DP_CACHE_TTL_MAX
+ * (0 = data are not cached).
+ * @param[in] opts Options overriding default behavior of the subscription, it is supposed to be
+ * a bitwise OR-ed value of any ::sr_subscr_flag_t flags.
+ * @param[in,out] subscription Subscription context that is supposed to be released by ::sr_unsubscribe.
+ *
+ * @return Error code (SR_ERR_OK on success, SR_ERR_INVAL_ARG if cache_ttl is out of range).
+ */
+int sr_dp_get_items_subscribe_cached(sr_session_ctx_t *session, const char *xpath, sr_dp_get_items_cb callback,
+        void *private_ctx, uint32_t cache_ttl, sr_subscr_options_t opts, sr_subscription_ctx_t **subscription);
+
+/**
+ * @brief Registers for providing of operational data under given xpath in batches, declaring that the provided
+ * data stay valid for the given period. Behaves the same as ::sr_dp_get_items_batch_subscribe, the data are
+ * cached as described for ::sr_dp_get_items_subscribe_cached.
+ *
+ * @param[in] session Session context acquired with ::sr_session_start call.
+ * @param[in] xpath XPath identifying the subtree under which the provider is able to provide
+ * operational data.
+ * @param[in] callback Callback to be called when the operational data under given xpath is needed.
+ * @param[in] private_ctx Private context passed to the callback function, opaque to sysrepo.
+ * @param[in] cache_ttl Validity period of the provided data in milliseconds, up to ::SR_DP_CACHE_TTL_MAX
+ * (0 = data are not cached).
+ * @param[in] opts Options overriding default behavior of the subscription, it is supposed to be
+ * a bitwise OR-ed value of any ::sr_subscr_flag_t flags.
+ * @param[in,out] subscription Subscription context that is supposed to be released by ::sr_unsubscribe.
+ *
+ * @return Error code (SR_ERR_OK on success, SR_ERR_INVAL_ARG if cache_ttl is out of range).
+ */
+int sr_dp_get_items_batch_subscribe_cached(sr_session_ctx_t *session, const char *xpath,
+        sr_dp_get_items_batch_cb callback, void *private_ctx, uint32_t cache_ttl, sr_subscr_options_t opts,
+        sr_subscription_ctx_t **subscription);
+
+/**
+ * @brief Callback to be called when operational data at the selected level is requested.
+ * This data provider callback variant operates with sysrepo trees rather than with sysrepo values,
+ * use it with ::sr_dp_get_items_subscribe_tree.
+ *
+ * The provider is supposed to return instances of the node identified by the xpath argument, each represented
+ * as one tree:
+ *
+ * - If the xpath identifies a container, the provider is supposed to return one tree rooted in the container.
+ * - If the xpath identifies a list, the provider is supposed to return one tree for each instance of the list
+ * (the trees must contain the list keys).
+ * - If the xpath identifies a leaf or leaf-list, the provider is supposed to return one tree (one node)
+ * for the leaf or for each of the leaf-list values.
+ *
+ * Unlike ::sr_dp_get_items_cb, the trees are supposed to contain the whole subtree including nested lists
+ * and containers. Sysrepo asks in subsequent calls only for the nested data provided by other subscriptions.
+ *
+ * @param[in] xpath XPath identifying the requested node.
+ * @param[out] trees Array of trees with instances of the requested node (allocated by the provider).
+ * @param[out] tree_cnt Number of trees returned.
+ * @param[in] private_ctx Private context opaque to sysrepo, as passed to ::sr_dp_get_items_subscribe_tree call.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+typedef int (*sr_dp_get_items_tree_cb)(const char *xpath, sr_node_t **trees, size_t *tree_cnt, void *private_ctx);
+
+/**
+ * @brief Registers for providing of operational data under given xpath, with the data being provided
+ * in the form of sysrepo trees.
+ *
+ * @note The XPath must be generic - must not include any list key values.
+ * @note This API works only for operational data (subtrees marked in YANG as "config false").
+ * Subscribing as a data provider for configuration data does not have any effect.
+ *
+ * @param[in] session Session context acquired with ::sr_session_start call.
+ * @param[in] xpath XPath identifying the subtree under which the provider is able to provide
+ * operational data.
+ * @param[in] callback Callback to be called when the operational data under given xpath is needed.
+ * @param[in] private_ctx Private context passed to the callback function, opaque to sysrepo.
+ * @param[in] opts Options overriding default behavior of the subscription, it is supposed to be
+ * a bitwise OR-ed value of any ::sr_subscr_flag_t flags.
+ * @param[in,out] subscription Subscription context that is supposed to be released by ::sr_unsubscribe.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+int sr_dp_get_items_subscribe_tree(sr_session_ctx_t *session, const char *xpath, sr_dp_get_items_tree_cb callback,
+        void *private_ctx, sr_subscr_options_t opts, sr_subscription_ctx_t **subscription);
+
+/**
+ * @brief Invalidates operational data cached by sysrepo for the data providers that declared a validity
+ * period of their data (see ::sr_dp_get_items_subscribe_cached). Cached data of the subtree identified by the xpath,
+ * as well as cached data containing the subtree, will be requested from the data providers again on the next read.
+ * The user of the session needs write access to the module.
+ *
+ * @param[in] session Session context acquired with ::sr_session_start call.
+ * @param[in] xpath XPath identifying the subtree whose cached data are no longer valid.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+int sr_dp_cache_invalidate(sr_session_ctx_t *session, const char *xpath);
+
+/**
+ * @brief Flags used to override default behavior of ::sr_oper_data_push.
+ */
+typedef enum sr_oper_push_flag_e {
+    SR_OPER_PUSH_DEFAULT = 0,   /**< Default behavior - pushed values are merged with the data pushed before
+                                     (a value with the same xpath is overwritten). */
+    SR_OPER_PUSH_REPLACE = 1,   /**< All data pushed into the subtree before are replaced by the pushed values.
+                                     Pushing no values with this flag removes the pushed data of the subtree. */
+} sr_oper_push_flag_t;
+
+/**
+ * @brief Options overriding default behavior of ::sr_oper_data_push,
+ * it is supposed to be bitwise OR-ed value of any ::sr_oper_push_flag_t flags.
+ */
+typedef uint32_t sr_oper_push_options_t;
+
+/**
+ * @brief Pushes operational data into the in-memory operational datastore held by sysrepo.
+ *
+ * Requests for operational data of the subtrees that contain pushed values are served directly
+ * from the pushed data, without calling any data provider callback. Data providers registered by
+ * ::sr_dp_get_items_subscribe keep being asked for the subtrees without any pushed data. This is
+ * suitable for data that the application updates periodically anyway (e.g. counters).
+ *
+ * @note The pushed data are kept by sysrepo until they are replaced or removed using ::SR_OPER_PUSH_REPLACE,
+ * or until the session that pushed them is stopped (including when its connection is closed).
+ * @note Pushed state data nested in a configuration list are returned only for the configured list instances.
+ *
+ * @param[in] session Session context acquired with ::sr_session_start call.
+ * @param[in] xpath XPath identifying the operational data subtree (may include list keys).
+ * All the values must be placed in this subtree.
+ * @param[in] values Array of values to be pushed.
+ * @param[in] values_cnt Number of values in the array.
+ * @param[in] opts Options overriding default behavior, bitwise OR-ed value of any ::sr_oper_push_flag_t flags.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+int sr_oper_data_push(sr_session_ctx_t *session, const char *xpath, const sr_val_t *values, size_t values_cnt,
+        sr_oper_push_options_t opts);
+
 
 ////////////////////////////////////////////////////////////////////////////////
 // Application-local File Descriptor Watcher API
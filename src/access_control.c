@@ -27,11 +27,29 @@
 #include <assert.h>
 #include <pwd.h>
 #include <grp.h>
+#include <sys/stat.h>
 
 #include "sr_common.h"
 #include "request_processor.h"
 #include "access_control.h"
 
+#ifdef HAVE_FSETXATTR
+#include <sys/xattr.h>
+#endif
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#endif
+
+/**
+ * @brief Watch of a directory whose changes invalidate the cached file access checks.
+ */
+typedef struct ac_dir_watch_s {
+    int wd;                 /**< Inotify watch descriptor. */
+    char *child;            /**< Name of the watched entry within the directory, NULL if all entries are watched. */
+} ac_dir_watch_t;
+
 /**
  * @brief Access Control module context.
  */
@@ -41,8 +59,50 @@ typedef struct ac_ctx_s {
     uid_t proc_euid;              /**< Effective uid of the process at the time of initialization. */
     gid_t proc_egid;              /**< Effective gid of the process at the time of initialization. */
     pthread_mutex_t lock;         /**< Context lock. Used for mutual exclusion if we are changing process-wide settings. */
+    char *watched_dir;            /**< Data search directory without the trailing slash, access checks of the files
+                                       placed directly in it are cached. */
+    uint32_t watching;            /**< Non-zero while the watched directory is being watched for changes. */
+    uint32_t permissions_version; /**< Incremented whenever the permissions of the watched files may have changed. */
+    sr_btree_t *file_access;      /**< Cached results of file access checks (ac_file_access_t *). */
+    pthread_mutex_t file_access_lock;  /**< Lock guarding the cached file access checks. */
+#ifdef __linux__
+    int inotify_fd;               /**< Inotify instance watching the data search directory and its parents. */
+    ac_dir_watch_t *watches;      /**< Watches of the data search directory (first) and its parents. */
+    size_t watch_cnt;             /**< Number of the watches. */
+    int stop_pipe[2];             /**< Pipe used to stop the watcher thread. */
+    pthread_t watcher_thread;     /**< Thread processing the inotify events. */
+    bool watcher_running;         /**< TRUE if the watcher thread has been started. */
+#endif
 } ac_ctx_t;
 
+/**
+ * @brief Name of the extended attribute holding the POSIX access ACL of a file.
+ */
+#define AC_POSIX_ACL_XATTR "system.posix_acl_access"
+
+/**
+ * @brief Metadata of a file that access control decisions are derived from.
+ */
+typedef struct ac_file_metadata_s {
+    bool exists;            /**< TRUE if the file exists. */
+    uid_t uid;              /**< Owner of the file. */
+    gid_t gid;              /**< Owning group of the file. */
+    mode_t mode;            /**< Mode (file type and permission bits) of the file. */
+    bool acl;               /**< TRUE if the file has a POSIX access ACL (the permission bits are not authoritative). */
+} ac_file_metadata_t;
+
+/**
+ * @brief Cached result of a check of the access of a user to a file.
+ */
+typedef struct ac_file_access_s {
+    char *file_name;        /**< Path to the file. */
+    uid_t uid;              /**< User the access was checked for. */
+    gid_t gid;              /**< Group of the user. */
+    ac_operation_t operation;  /**< Checked operation. */
+    uint32_t version;       /**< Permissions version the check was made at (see ac_ctx_t::permissions_version). */
+    int rc;                 /**< Result of the check (SR_ERR_OK, SR_ERR_UNAUTHORIZED or SR_ERR_NOT_FOUND). */
+} ac_file_access_t;
+
 /**
  * @brief Access Control session context.
  */
@@ -67,6 +127,8 @@ typedef enum ac_permission_e {
 typedef struct ac_module_info_s {
     const char *module_name;                /**< Name of the module. */
     const char *xpath;                      /**< XPath used only for fast lookup. */
+    char *file_name;                        /**< Data file the permissions are derived from. */
+    uint32_t file_version;                  /**< Permissions version the cached permissions were checked at. */
     ac_permission_t read_permission;        /**< Read permission is granted. */
     ac_permission_t read_write_permission;  /**< Read & write permissions are granted. */
 } ac_module_info_t;
@@ -108,10 +170,396 @@ ac_module_info_free_cb(void *item)
     ac_module_info_t *info = (ac_module_info_t *) item;
     if (NULL != info) {
         free((void*)info->module_name);
+        free(info->file_name);
     }
     free(info);
 }
 
+/**
+ * @brief Compares two ac_file_access_t structures stored in the binary tree.
+ */
+static int
+ac_file_access_cmp_cb(const void *a, const void *b)
+{
+    assert(a);
+    assert(b);
+    ac_file_access_t *access_a = (ac_file_access_t *) a;
+    ac_file_access_t *access_b = (ac_file_access_t *) b;
+    int res = 0;
+
+    if (access_a->uid != access_b->uid) {
+        return (access_a->uid < access_b->uid) ? -1 : 1;
+    }
+    if (access_a->gid != access_b->gid) {
+        return (access_a->gid < access_b->gid) ? -1 : 1;
+    }
+    if (access_a->operation != access_b->operation) {
+        return (access_a->operation < access_b->operation) ? -1 : 1;
+    }
+    res = strcmp(access_a->file_name, access_b->file_name);
+    if (res == 0) {
+        return 0;
+    } else if (res < 0) {
+        return -1;
+    } else {
+        return 1;
+    }
+}
+
+/**
+ * @brief Frees ac_file_access_t stored in the binary tree.
+ */
+static void
+ac_file_access_free_cb(void *item)
+{
+    ac_file_access_t *access = (ac_file_access_t *) item;
+    if (NULL != access) {
+        free(access->file_name);
+    }
+    free(access);
+}
+
+/**
+ * @brief Returns the current permissions version, FALSE if the watched directory is not being watched
+ * and the cached access checks must not be used.
+ */
+static bool
+ac_permissions_version(ac_ctx_t *ac_ctx, uint32_t *version)
+{
+    if (0 == __sync_fetch_and_add(&ac_ctx->watching, 0)) {
+        return false;
+    }
+    *version = __sync_fetch_and_add(&ac_ctx->permissions_version, 0);
+    return true;
+}
+
+/**
+ * @brief Returns TRUE if the file is placed directly in the watched directory,
+ * so that any change of its permissions is noticed.
+ */
+static bool
+ac_file_is_watched(ac_ctx_t *ac_ctx, const char *file_name)
+{
+    const char *slash = strrchr(file_name, '/');
+    size_t dir_len = 0;
+
+    if (NULL == ac_ctx->watched_dir || NULL == slash || '\0' == slash[1]) {
+        return false;
+    }
+    dir_len = slash - file_name;
+    while (dir_len > 1 && '/' == file_name[dir_len - 1]) {
+        dir_len--;
+    }
+    return (strlen(ac_ctx->watched_dir) == dir_len) && (0 == strncmp(ac_ctx->watched_dir, file_name, dir_len));
+}
+
+/**
+ * @brief Looks up a cached result of the file access check made at the provided permissions version.
+ */
+static bool
+ac_file_access_lookup(ac_ctx_t *ac_ctx, const char *file_name, const ac_operation_t operation,
+        const uid_t uid, const gid_t gid, const uint32_t version, int *rc)
+{
+    ac_file_access_t lookup = { .file_name = (char *) file_name, .uid = uid, .gid = gid, .operation = operation, };
+    ac_file_access_t *access = NULL;
+    bool found = false;
+
+    pthread_mutex_lock(&ac_ctx->file_access_lock);
+    access = sr_btree_search(ac_ctx->file_access, &lookup);
+    if (NULL != access && access->version == version) {
+        *rc = access->rc;
+        found = true;
+    }
+    pthread_mutex_unlock(&ac_ctx->file_access_lock);
+
+    return found;
+}
+
+/**
+ * @brief Caches the result of the file access check made at the provided permissions version.
+ */
+static void
+ac_file_access_store(ac_ctx_t *ac_ctx, const char *file_name, const ac_operation_t operation,
+        const uid_t uid, const gid_t gid, const uint32_t version, const int rc)
+{
+    ac_file_access_t lookup = { .file_name = (char *) file_name, .uid = uid, .gid = gid, .operation = operation, };
+    ac_file_access_t *access = NULL;
+
+    pthread_mutex_lock(&ac_ctx->file_access_lock);
+    access = sr_btree_search(ac_ctx->file_access, &lookup);
+    if (NULL == access) {
+        access = calloc(1, sizeof(*access));
+        if (NULL == access || NULL == (access->file_name = strdup(file_name))) {
+            free(access);
+            goto unlock;
+        }
+        access->uid = uid;
+        access->gid = gid;
+        access->operation = operation;
+        if (SR_ERR_OK != sr_btree_insert(ac_ctx->file_access, access)) {
+            ac_file_access_free_cb(access);
+            goto unlock;
+        }
+    }
+    access->version = version;
+    access->rc = rc;
+
+unlock:
+    pthread_mutex_unlock(&ac_ctx->file_access_lock);
+}
+
+#ifdef __linux__
+/**
+ * @brief Processes the inotify events of the watched directories. Any change of an entry of the data search
+ * directory and any change of the permissions or of the entries on the path to it increments the permissions
+ * version. If a watched directory is removed or moved, the cached access checks are no longer used.
+ */
+static void *
+ac_watcher_thread(void *ac_ctx_p)
+{
+    ac_ctx_t *ac_ctx = (ac_ctx_t *) ac_ctx_p;
+    char buff[4096] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+    const struct inotify_event *event = NULL;
+    struct pollfd fds[2] = { { 0, }, };
+    bool changed = false, lost = false;
+    ssize_t len = 0;
+
+    fds[0].fd = ac_ctx->inotify_fd;
+    fds[0].events = POLLIN;
+    fds[1].fd = ac_ctx->stop_pipe[0];
+    fds[1].events = POLLIN;
+
+    while (!lost) {
+        if (-1 == poll(fds, 2, -1)) {
+            if (EINTR == errno) {
+                continue;
+            }
+            SR_LOG_ERR("Polling of the data directory watch failed: %s", sr_strerror_safe(errno));
+            break;
+        }
+        if (fds[1].revents) {
+            /* stop requested */
+            break;
+        }
+        len = read(ac_ctx->inotify_fd, buff, sizeof(buff));
+        if (-1 == len) {
+            if (EINTR == errno || EAGAIN == errno) {
+                continue;
+            }
+            SR_LOG_ERR("Reading of the data directory watch failed: %s", sr_strerror_safe(errno));
+            break;
+        }
+
+        changed = false;
+        for (char *ptr = buff; ptr < buff + len; ptr += sizeof(struct inotify_event) + event->len) {
+            event = (const struct inotify_event *) ptr;
+            if (event->mask & (IN_IGNORED | IN_UNMOUNT | IN_DELETE_SELF | IN_MOVE_SELF)) {
+                lost = true;
+            } else if (event->mask & IN_Q_OVERFLOW) {
+                changed = true;
+            }
+            for (size_t i = 0; i < ac_ctx->watch_cnt; i++) {
+                if (ac_ctx->watches[i].wd == event->wd && (NULL == ac_ctx->watches[i].child || 0 == event->len ||
+                        0 == strcmp(ac_ctx->watches[i].child, event->name))) {
+                    changed = true;
+                }
+            }
+        }
+        if (changed) {
+            __sync_fetch_and_add(&ac_ctx->permissions_version, 1);
+        }
+    }
+
+    /* the changes are not noticed any more */
+    __sync_fetch_and_and(&ac_ctx->watching, 0);
+    __sync_fetch_and_add(&ac_ctx->permissions_version, 1);
+    if (lost) {
+        SR_LOG_WRN("Data directory '%s' or its parent has been moved or removed, permissions of the data files "
+                "will be checked on each access.", ac_ctx->watched_dir);
+    }
+    return NULL;
+}
+
+/**
+ * @brief Adds a watch of the directory into the context.
+ */
+static int
+ac_watch_add(ac_ctx_t *ac_ctx, const char *dir_name, const char *child, uint32_t mask)
+{
+    ac_dir_watch_t *tmp = NULL;
+    int wd = -1;
+
+    wd = inotify_add_watch(ac_ctx->inotify_fd, dir_name, mask);
+    if (-1 == wd) {
+        SR_LOG_WRN("Unable to watch directory '%s': %s", dir_name, sr_strerror_safe(errno));
+        return SR_ERR_IO;
+    }
+
+    tmp = realloc(ac_ctx->watches, (ac_ctx->watch_cnt + 1) * sizeof(*tmp));
+    CHECK_NULL_NOMEM_RETURN(tmp);
+    ac_ctx->watches = tmp;
+    ac_ctx->watches[ac_ctx->watch_cnt].wd = wd;
+    ac_ctx->watches[ac_ctx->watch_cnt].child = NULL;
+    ac_ctx->watch_cnt++;
+    if (NULL != child) {
+        ac_ctx->watches[ac_ctx->watch_cnt - 1].child = strdup(child);
+        CHECK_NULL_NOMEM_RETURN(ac_ctx->watches[ac_ctx->watch_cnt - 1].child);
+    }
+
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Starts watching the data search directory and all the directories on the path to it,
+ * so that the cached access checks can be invalidated when the permissions change.
+ */
+static int
+ac_watch_start(ac_ctx_t *ac_ctx)
+{
+    char *dir_name = NULL, *slash = NULL;
+    int ret = 0, rc = SR_ERR_OK;
+
+    ac_ctx->inotify_fd = inotify_init1(IN_CLOEXEC);
+    CHECK_NOT_MINUS1_LOG_RETURN(ac_ctx->inotify_fd, SR_ERR_IO, "Unable to initialize inotify: %s",
+            sr_strerror_safe(errno));
+
+    rc = ac_watch_add(ac_ctx, ac_ctx->watched_dir, NULL, IN_ATTRIB | IN_CREATE | IN_DELETE | IN_MOVED_FROM |
+            IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF);
+    CHECK_RC_MSG_RETURN(rc, "Unable to watch the data search directory.");
+
+    dir_name = strdup(ac_ctx->watched_dir);
+    CHECK_NULL_NOMEM_RETURN(dir_name);
+    while (SR_ERR_OK == rc && NULL != (slash = strrchr(dir_name, '/')) && '\0' != slash[1]) {
+        if (slash == dir_name) {
+            /* root directory */
+            rc = ac_watch_add(ac_ctx, "/", slash + 1, IN_ATTRIB | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO);
+            break;
+        }
+        slash[0] = '\0';
+        rc = ac_watch_add(ac_ctx, dir_name, slash + 1, IN_ATTRIB | IN_CREATE | IN_DELETE | IN_MOVED_FROM |
+                IN_MOVED_TO | IN_DELETE_SELF | IN_MOVE_SELF);
+    }
+    free(dir_name);
+    CHECK_RC_MSG_RETURN(rc, "Unable to watch the parents of the data search directory.");
+
+    ret = pipe(ac_ctx->stop_pipe);
+    CHECK_NOT_MINUS1_LOG_RETURN(ret, SR_ERR_IO, "Unable to create a pipe: %s", sr_strerror_safe(errno));
+
+    ac_ctx->watching = 1;
+    ret = pthread_create(&ac_ctx->watcher_thread, NULL, ac_watcher_thread, ac_ctx);
+    if (0 != ret) {
+        ac_ctx->watching = 0;
+        SR_LOG_ERR("Unable to start the data directory watcher thread: %s", sr_strerror_safe(ret));
+        return SR_ERR_INTERNAL;
+    }
+    ac_ctx->watcher_running = true;
+
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Stops watching the data search directory and releases the watches.
+ */
+static void
+ac_watch_stop(ac_ctx_t *ac_ctx)
+{
+    if (ac_ctx->watcher_running) {
+        if (1 != write(ac_ctx->stop_pipe[1], "", 1)) {
+            SR_LOG_WRN("Unable to stop the data directory watcher thread: %s", sr_strerror_safe(errno));
+        }
+        pthread_join(ac_ctx->watcher_thread, NULL);
+        ac_ctx->watcher_running = false;
+    }
+    ac_ctx->watching = 0;
+    for (int i = 0; i < 2; i++) {
+        if (-1 != ac_ctx->stop_pipe[i]) {
+            close(ac_ctx->stop_pipe[i]);
+            ac_ctx->stop_pipe[i] = -1;
+        }
+    }
+    if (-1 != ac_ctx->inotify_fd) {
+        close(ac_ctx->inotify_fd);
+        ac_ctx->inotify_fd = -1;
+    }
+    for (size_t i = 0; i < ac_ctx->watch_cnt; i++) {
+        free(ac_ctx->watches[i].child);
+    }
+    free(ac_ctx->watches);
+    ac_ctx->watches = NULL;
+    ac_ctx->watch_cnt = 0;
+}
+#endif
+
+/**
+ * @brief Detects whether the file (opened as @p fd, or looked up by @p file_name if @p fd is -1)
+ * has a POSIX access ACL. If the presence cannot be determined, the ACL is assumed to be present.
+ */
+static bool
+ac_file_has_acl(const char *file_name, int fd)
+{
+#if defined(HAVE_FSETXATTR) && defined(__linux__)
+    ssize_t ret = 0;
+
+    if (-1 != fd) {
+        ret = fgetxattr(fd, AC_POSIX_ACL_XATTR, NULL, 0);
+    } else {
+        ret = getxattr(file_name, AC_POSIX_ACL_XATTR, NULL, 0);
+    }
+    if (-1 == ret) {
+        if (ENODATA == errno || ENOTSUP == errno) {
+            /* no ACL / ACLs not supported by the filesystem */
+            return false;
+        }
+        SR_LOG_WRN("Unable to read the ACL of file '%s': %s", file_name, sr_strerror_safe(errno));
+    }
+    return true;
+#else
+    (void) file_name;
+    (void) fd;
+    return false;
+#endif
+}
+
+/**
+ * @brief Reads metadata of the file (of the opened file @p fd, if it is not -1) from the filesystem.
+ * The name of the owning group is returned only if requested and it can be resolved.
+ */
+static int
+ac_get_file_metadata(const char *file_name, int fd, ac_file_metadata_t *metadata, char **group_name)
+{
+    struct stat st = { 0, };
+    int ret = 0, rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG2(file_name, metadata);
+
+    memset(metadata, 0, sizeof(*metadata));
+
+    ret = (-1 != fd) ? fstat(fd, &st) : stat(file_name, &st);
+    if (-1 == ret) {
+        if (-1 == fd && (ENOENT == errno || ENOTDIR == errno)) {
+            return SR_ERR_OK;
+        }
+        SR_LOG_ERR("Unable to read the metadata of file '%s': %s", file_name, sr_strerror_safe(errno));
+        return (EACCES == errno) ? SR_ERR_UNAUTHORIZED : SR_ERR_IO;
+    }
+
+    metadata->exists = true;
+    metadata->uid = st.st_uid;
+    metadata->gid = st.st_gid;
+    metadata->mode = st.st_mode;
+    metadata->acl = ac_file_has_acl(file_name, fd);
+
+    if (NULL != group_name) {
+        rc = sr_get_group_name(st.st_gid, group_name);
+        if (SR_ERR_NOT_FOUND == rc) {
+            return SR_ERR_OK;
+        }
+        CHECK_RC_LOG_RETURN(rc, "Failed to get the name of group %d.", st.st_gid);
+    }
+
+    return SR_ERR_OK;
+}
+
 /**
  * @brief Checks if the current user is able to access provided file for specified operation.
  */
@@ -185,7 +633,8 @@ cleanup:
 }
 
 /**
- * @brief Checks if provided uid and gid can access provided file for specified operation.
+ * @brief Checks if provided user can access provided file for specified operation by switching
+ * the identity of the process and letting the kernel decide.
  */
 static int
 ac_check_file_access_with_eid(ac_ctx_t *ac_ctx, const char *file_name,
@@ -210,6 +659,132 @@ ac_check_file_access_with_eid(ac_ctx_t *ac_ctx, const char *file_name,
     return (SR_ERR_OK == rc_tmp) ? rc : rc_tmp;
 }
 
+/**
+ * @brief Evaluates the permission bits of a file or directory (opened as @p fd, if it is not -1)
+ * for provided user. Requested permissions @p user_bits are expressed as the owner bits
+ * (S_IRUSR, S_IWUSR, S_IXUSR). Metadata the decision was made from are returned in @p metadata,
+ * if ac_file_metadata_t::acl is set the decision must not be relied on.
+ */
+static int
+ac_check_mode_bits(const char *file_name, int fd, const mode_t user_bits, const uid_t uid, const gid_t gid,
+        const char *username, ac_file_metadata_t *metadata)
+{
+    char *group_name = NULL;
+    char **groups = NULL;
+    size_t group_cnt = 0;
+    mode_t bits = 0;
+    bool member = false;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG2(file_name, metadata);
+
+    rc = ac_get_file_metadata(file_name, fd, metadata, (0 != uid) ? &group_name : NULL);
+    CHECK_RC_LOG_RETURN(rc, "Unable to get the metadata of file '%s'.", file_name);
+
+    if (!metadata->exists) {
+        return SR_ERR_NOT_FOUND;
+    }
+
+    if (0 == uid) {
+        /* root is not restricted by the permission bits */
+        return SR_ERR_OK;
+    }
+
+    if (uid == metadata->uid) {
+        bits = user_bits;
+    } else {
+        member = (gid == metadata->gid);
+        if (!member && NULL != group_name && NULL != username) {
+            rc = sr_get_user_groups(username, &groups, &group_cnt);
+            CHECK_RC_LOG_GOTO(rc, cleanup, "Failed to obtain the groups of user '%s'.", username);
+            for (size_t i = 0; i < group_cnt; i++) {
+                if (0 == strcmp(groups[i], group_name)) {
+                    member = true;
+                }
+                free(groups[i]);
+            }
+            free(groups);
+        }
+        bits = member ? (user_bits >> 3) : (user_bits >> 6);
+    }
+
+    if (bits != (metadata->mode & bits)) {
+        rc = SR_ERR_UNAUTHORIZED;
+    }
+
+cleanup:
+    free(group_name);
+    return rc;
+}
+
+/**
+ * @brief Checks if provided user can access provided file (opened as @p fd, if it is not -1) for specified
+ * operation. Instead of switching the identity and opening the file, the permission bits of the file
+ * and the search permission of all its parent directories are evaluated. The identity is switched
+ * only if any of them has a POSIX access ACL, which the permission bits do not reflect.
+ *
+ * Results for the files placed directly in the watched data search directory are cached until
+ * the permissions version changes. Cached results are not used for an opened file.
+ */
+static int
+ac_check_file_access_by_metadata(ac_ctx_t *ac_ctx, const char *file_name, int fd, const ac_operation_t operation,
+        const uid_t uid, const gid_t gid, const char *username)
+{
+    ac_file_metadata_t metadata = { 0, };
+    char *dir_name = NULL, *slash = NULL;
+    struct stat st = { 0, };
+    uint32_t version = 0;
+    bool cacheable = false;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG2(ac_ctx, file_name);
+
+    cacheable = ac_permissions_version(ac_ctx, &version) && ac_file_is_watched(ac_ctx, file_name);
+    if (cacheable && -1 == fd && ac_file_access_lookup(ac_ctx, file_name, operation, uid, gid, version, &rc)) {
+        return rc;
+    }
+    if (cacheable && 0 == lstat(file_name, &st) && S_ISLNK(st.st_mode)) {
+        /* changes of the link target are not noticed */
+        cacheable = false;
+    }
+
+    rc = ac_check_mode_bits(file_name, fd, (AC_OPER_READ == operation ? S_IRUSR : (S_IRUSR | S_IWUSR)),
+            uid, gid, username, &metadata);
+    if (SR_ERR_NOT_FOUND == rc) {
+        SR_LOG_WRN("File '%s' cannot be found.", file_name);
+    }
+    if (SR_ERR_OK != rc || 0 == uid || metadata.acl) {
+        goto cleanup;
+    }
+
+    /* path resolution requires the search permission on every parent directory */
+    dir_name = strdup(file_name);
+    CHECK_NULL_NOMEM_RETURN(dir_name);
+    while (SR_ERR_OK == rc && !metadata.acl && NULL != (slash = strrchr(dir_name, '/'))) {
+        if (slash == dir_name) {
+            /* root directory */
+            slash[1] = '\0';
+        } else {
+            slash[0] = '\0';
+        }
+        rc = ac_check_mode_bits(dir_name, -1, S_IXUSR, uid, gid, username, &metadata);
+        if (slash == dir_name) {
+            break;
+        }
+    }
+
+cleanup:
+    free(dir_name);
+    if (SR_ERR_OK == rc && metadata.acl) {
+        /* the permission bits are not authoritative, let the kernel decide */
+        rc = ac_check_file_access_with_eid(ac_ctx, file_name, operation, uid, gid);
+    }
+    if (cacheable && (SR_ERR_OK == rc || SR_ERR_UNAUTHORIZED == rc || SR_ERR_NOT_FOUND == rc)) {
+        ac_file_access_store(ac_ctx, file_name, operation, uid, gid, version, rc);
+    }
+    return rc;
+}
+
 /**
  * @brief Checks if the session is authorized to perform specified operation
  * on specified module of node (one of these two can be specified).
@@ -220,7 +795,8 @@ ac_check_module_node_permissions(ac_session_t *session, const char *module_name,
 {
     ac_module_info_t lookup_info = { 0, };
     ac_module_info_t *module_info = NULL;
-    char *file_name = NULL;
+    uint32_t version = 0;
+    bool cacheable = false;
     int rc = SR_ERR_OK;
 
     CHECK_NULL_ARG2(session, session->ac_ctx);
@@ -230,8 +806,17 @@ ac_check_module_node_permissions(ac_session_t *session, const char *module_name,
     } else {
         lookup_info.xpath = node_xpath;
     }
+    /* cached permissions are valid only until the permissions of the data files change */
+    cacheable = ac_permissions_version(session->ac_ctx, &version);
+
     module_info = sr_btree_search(session->module_info_btree, &lookup_info);
     if (NULL != module_info) {
+        if (!cacheable || version != module_info->file_version) {
+            module_info->read_permission = AC_PERMISSION_UNKNOWN;
+            module_info->read_write_permission = AC_PERMISSION_UNKNOWN;
+            module_info->file_version = version;
+        }
+
         /* found match in cache, try to check from cache */
         if (AC_OPER_READ == operation && AC_PERMISSION_UNKNOWN != module_info->read_permission) {
             if (AC_PERMISSION_ALLOWED == module_info->read_permission) {
@@ -269,28 +854,30 @@ ac_check_module_node_permissions(ac_session_t *session, const char *module_name,
                 return rc;
             }
         }
+        rc = sr_get_data_file_name(session->ac_ctx->data_search_dir, module_info->module_name, SR_DS_STARTUP,
+                &module_info->file_name);
+        if (SR_ERR_OK != rc) {
+            SR_LOG_ERR_MSG("Retrieving data file name failed.");
+            ac_module_info_free_cb(module_info);
+            return rc;
+        }
+        module_info->file_version = version;
         rc = sr_btree_insert(session->module_info_btree, module_info);
         if (SR_ERR_OK != rc) {
             SR_LOG_ERR_MSG("Cannot insert new entry into binary tree for module access control info.");
-            free(module_info);
+            ac_module_info_free_cb(module_info);
             return SR_ERR_INTERNAL;
         }
     }
 
     /* do the check */
-    rc = sr_get_data_file_name(session->ac_ctx->data_search_dir, module_info->module_name, SR_DS_STARTUP, &file_name);
-    if (SR_ERR_OK != rc) {
-        SR_LOG_ERR_MSG("Retrieving data file name failed.");
-        return rc;
-    }
-    rc = ac_check_file_permissions(session, file_name, operation);
+    rc = ac_check_file_permissions(session, module_info->file_name, operation);
 
     if (SR_ERR_NOT_FOUND == rc) {
         /* there is nothing to check if the file does not exist - return OK */
-        SR_LOG_WRN("Data file '%s' not found, considering as authorized.", file_name);
+        SR_LOG_WRN("Data file '%s' not found, considering as authorized.", module_info->file_name);
         rc = SR_ERR_OK;
     }
-    free(file_name);
 
     /* save correct results in the cache */
     if (SR_ERR_OK == rc || SR_ERR_UNAUTHORIZED == rc) {
@@ -317,10 +904,33 @@ ac_init(const char *data_search_dir, ac_ctx_t **ac_ctx)
     CHECK_NULL_NOMEM_RETURN(ctx);
 
     pthread_mutex_init(&ctx->lock, NULL);
+    pthread_mutex_init(&ctx->file_access_lock, NULL);
+#ifdef __linux__
+    ctx->inotify_fd = -1;
+    ctx->stop_pipe[0] = ctx->stop_pipe[1] = -1;
+#endif
+
+    rc = sr_btree_init(ac_file_access_cmp_cb, ac_file_access_free_cb, &ctx->file_access);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Cannot allocate binary tree for file access checks.");
 
     ctx->data_search_dir = strdup(data_search_dir);
     CHECK_NULL_NOMEM_GOTO(ctx->data_search_dir, rc, cleanup);
 
+    ctx->watched_dir = strdup(data_search_dir);
+    CHECK_NULL_NOMEM_GOTO(ctx->watched_dir, rc, cleanup);
+    for (size_t len = strlen(ctx->watched_dir); len > 1 && '/' == ctx->watched_dir[len - 1]; len--) {
+        ctx->watched_dir[len - 1] = '\0';
+    }
+
+#ifdef __linux__
+    /* access checks are cached only while the changes of the permissions are noticed */
+    if (SR_ERR_OK != ac_watch_start(ctx)) {
+        SR_LOG_WRN("Unable to watch data directory '%s', permissions of the data files will be checked on each access.",
+                ctx->watched_dir);
+        ac_watch_stop(ctx);
+    }
+#endif
+
     /* save current euid and egid */
     ctx->proc_euid = geteuid();
     ctx->proc_egid = getegid();
@@ -344,8 +954,14 @@ void
 ac_cleanup(ac_ctx_t *ac_ctx)
 {
     if (NULL != ac_ctx) {
+#ifdef __linux__
+        ac_watch_stop(ac_ctx);
+#endif
         free((void*)ac_ctx->data_search_dir);
+        free(ac_ctx->watched_dir);
+        sr_btree_cleanup(ac_ctx->file_access);
         pthread_mutex_destroy(&ac_ctx->lock);
+        pthread_mutex_destroy(&ac_ctx->file_access_lock);
         free(ac_ctx);
     }
 }
@@ -435,25 +1051,19 @@ ac_check_file_permissions(ac_session_t *session, const char *file_name, const ac
         return rc;
     }
 
-    /* sysrepo engine runs within a privileged process */
-
-    if (0 != session->user_credentials->r_uid) {
-        /* real uid of the peer is not a root, check the permissions with real user identity */
-        rc = ac_check_file_access_with_eid(session->ac_ctx, file_name, operation,
-                session->user_credentials->r_uid, session->user_credentials->r_gid);
-        if (SR_ERR_UNAUTHORIZED == rc) {
-            SR_LOG_ERR("User '%s' not authorized for %s access to the file '%s'.", session->user_credentials->r_username,
-                    (AC_OPER_READ == operation ? "read" : "write"), file_name);
-        }
-    } else {
-        /* check the access with the current identity */
-        rc = ac_check_file_access(file_name, operation);
+    /* sysrepo engine runs within a privileged process, check the permissions with real user identity */
+    rc = ac_check_file_access_by_metadata(session->ac_ctx, file_name, -1, operation,
+            session->user_credentials->r_uid, session->user_credentials->r_gid, session->user_credentials->r_username);
+    if (SR_ERR_UNAUTHORIZED == rc) {
+        SR_LOG_ERR("User '%s' not authorized for %s access to the file '%s'.", session->user_credentials->r_username,
+                (AC_OPER_READ == operation ? "read" : "write"), file_name);
     }
 
     if ((SR_ERR_OK == rc) && (NULL != session->user_credentials->e_username)) {
         /* effective username was set, check the permissions with effective user identity */
-        rc = ac_check_file_access_with_eid(session->ac_ctx, file_name, operation,
-                session->user_credentials->e_uid, session->user_credentials->e_gid);
+        rc = ac_check_file_access_by_metadata(session->ac_ctx, file_name, -1, operation,
+                session->user_credentials->e_uid, session->user_credentials->e_gid,
+                session->user_credentials->e_username);
         if (SR_ERR_UNAUTHORIZED == rc) {
             SR_LOG_ERR("User '%s' not authorized for %s access to the file '%s'.", session->user_credentials->e_username,
                     (AC_OPER_READ == operation ? "read" : "write"), file_name);
@@ -463,6 +1073,47 @@ ac_check_file_permissions(ac_session_t *session, const char *file_name, const ac
     return rc;
 }
 
+int
+ac_check_trusted_user(const ac_ucred_t *user_credentials)
+{
+    char **groups = NULL;
+    size_t group_cnt = 0;
+    bool trusted = false;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG(user_credentials);
+
+    if (0 == user_credentials->r_uid) {
+        /* root is always trusted */
+        return SR_ERR_OK;
+    }
+
+    if (NULL != user_credentials->r_username) {
+        if ('\0' != SR_TRUSTED_SESSION_USER[0] && 0 == strcmp(user_credentials->r_username, SR_TRUSTED_SESSION_USER)) {
+            trusted = true;
+        }
+        if (!trusted && '\0' != SR_TRUSTED_SESSION_GROUP[0]) {
+            rc = sr_get_user_groups(user_credentials->r_username, &groups, &group_cnt);
+            CHECK_RC_LOG_RETURN(rc, "Failed to obtain the groups of user '%s'.", user_credentials->r_username);
+            for (size_t i = 0; i < group_cnt; i++) {
+                if (0 == strcmp(groups[i], SR_TRUSTED_SESSION_GROUP)) {
+                    trusted = true;
+                }
+                free(groups[i]);
+            }
+            free(groups);
+        }
+    }
+
+    if (!trusted) {
+        SR_LOG_DBG("User '%s' (uid=%d) is not a trusted user.",
+                NULL != user_credentials->r_username ? user_credentials->r_username : "", user_credentials->r_uid);
+        return SR_ERR_UNAUTHORIZED;
+    }
+
+    return SR_ERR_OK;
+}
+
 int
 ac_set_user_identity(ac_ctx_t *ac_ctx, const ac_ucred_t *user_credentials)
 {
@@ -514,3 +1165,107 @@ ac_unset_user_identity(ac_ctx_t *ac_ctx, const ac_ucred_t *user_credentials)
 
     return rc;
 }
+
+int
+ac_open_file(ac_ctx_t *ac_ctx, const ac_ucred_t *user_credentials, const char *file_name, int flags, mode_t mode)
+{
+    const char *username = NULL;
+    ac_operation_t operation = AC_OPER_READ;
+    uint32_t version = 0;
+    uid_t uid = 0;
+    gid_t gid = 0;
+    int fd = -1, error = 0;
+    int rc = SR_ERR_OK;
+
+    if (NULL == ac_ctx || NULL == file_name) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    if (NULL == user_credentials || !ac_ctx->priviledged_process) {
+        /* no identity switch would take place */
+        return open(file_name, flags, mode);
+    }
+
+    if (0 != user_credentials->r_uid) {
+        /* real user-id is non-root, act as the real user */
+        uid = user_credentials->r_uid;
+        gid = user_credentials->r_gid;
+        username = user_credentials->r_username;
+    } else if (NULL != user_credentials->e_username) {
+        /* effective username was set, act as the effective user */
+        uid = user_credentials->e_uid;
+        gid = user_credentials->e_gid;
+        username = user_credentials->e_username;
+    } else {
+        return open(file_name, flags, mode);
+    }
+
+    operation = (O_RDONLY == (flags & O_ACCMODE)) ? AC_OPER_READ : AC_OPER_READ_WRITE;
+
+    /* use the result of a previous check if the permissions have not changed since */
+    if (ac_permissions_version(ac_ctx, &version) && ac_file_is_watched(ac_ctx, file_name) &&
+            ac_file_access_lookup(ac_ctx, file_name, operation, uid, gid, version, &rc)) {
+        if (SR_ERR_UNAUTHORIZED == rc) {
+            errno = EACCES;
+            return -1;
+        }
+        if (SR_ERR_OK == rc) {
+            if ((O_CREAT | O_EXCL) == (flags & (O_CREAT | O_EXCL))) {
+                errno = EEXIST;
+                return -1;
+            }
+            fd = open(file_name, flags & ~(O_CREAT | O_EXCL), mode);
+            if (-1 != fd || ENOENT != errno || !(flags & O_CREAT)) {
+                return fd;
+            }
+        }
+        /* the file is going to be created */
+    }
+
+    /* open the existing file first and check the permissions of the opened inode, so that the file cannot
+     * be replaced in between; nothing is created or truncated and no FIFO is blocked on until the user
+     * is authorized */
+    fd = open(file_name, (flags & ~(O_CREAT | O_EXCL | O_TRUNC)) | O_NONBLOCK);
+    if (-1 == fd) {
+        if (ENOENT == errno && (flags & O_CREAT)) {
+            /* the file is going to be created, it must be owned by the user */
+            ac_set_user_identity(ac_ctx, user_credentials);
+            fd = open(file_name, flags, mode);
+            error = errno;
+            ac_unset_user_identity(ac_ctx, user_credentials);
+            errno = error;
+        }
+        return fd;
+    }
+
+    rc = ac_check_file_access_by_metadata(ac_ctx, file_name, fd, operation, uid, gid, username);
+    if (SR_ERR_OK == rc && (O_CREAT | O_EXCL) == (flags & (O_CREAT | O_EXCL))) {
+        rc = SR_ERR_DATA_EXISTS;
+    }
+    if (SR_ERR_OK == rc) {
+        /* apply the flags deferred until the user was authorized */
+        if (!(flags & O_NONBLOCK) && -1 == fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) & ~O_NONBLOCK)) {
+            rc = SR_ERR_IO;
+        } else if ((flags & O_TRUNC) && O_RDONLY != (flags & O_ACCMODE) && -1 == ftruncate(fd, 0)) {
+            rc = SR_ERR_IO;
+        }
+    }
+
+    switch (rc) {
+    case SR_ERR_OK:
+        return fd;
+    case SR_ERR_DATA_EXISTS:
+        error = EEXIST;
+        break;
+    case SR_ERR_UNAUTHORIZED:
+        error = EACCES;
+        break;
+    default:
+        error = EIO;
+        break;
+    }
+    close(fd);
+    errno = error;
+    return -1;
+}
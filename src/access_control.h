@@ -30,7 +30,12 @@
  * to temporarily switch the identity of the process according to the provided
  * user credentials.
  *
- * For authorization purposes, ACM temporarily switches filesystem UID and GID
+ * Permissions are authorized against the ownership and mode of the data files and their parent directories.
+ * The results are cached until a change of the data search directory or of the directories on the path to it
+ * is reported by inotify (the change is noticed asynchronously, shortly after it has been made). Where the
+ * directory cannot be watched, the permissions are checked on each access.
+ *
+ * For creation of new files, ACM temporarily switches filesystem UID and GID
  * on Linux, or effective UID and GID on non-Linux platforms.
  */
 
@@ -144,6 +149,17 @@ int ac_check_node_permissions(ac_session_t *session, const char *node_xpath, con
  */
 int ac_check_file_permissions(ac_session_t *session, const char *file_name, const ac_operation_t operation);
 
+/**
+ * @brief Check if the user is allowed to start a trusted session (see ::SR_SESS_TRUSTED). Trusted sessions
+ * can be started by root and by the user / members of the group configured at build time
+ * (::SR_TRUSTED_SESSION_USER, ::SR_TRUSTED_SESSION_GROUP). The real identity of the connected process is checked.
+ *
+ * @param[in] user_credentials Credentials of a sysrepo user.
+ *
+ * @return Error code (SR_ERR_OK if allowed, SR_ERR_UNAUTHORIZED if not).
+ */
+int ac_check_trusted_user(const ac_ucred_t *user_credentials);
+
 /**
  * @brief Switches the filesystem / effective uid and gid according to provided
  * user credentials, so that this thread / process will act as the specified user,
@@ -175,6 +191,24 @@ int ac_set_user_identity(ac_ctx_t *ac_ctx, const ac_ucred_t *user_credentials);
  */
 int ac_unset_user_identity(ac_ctx_t *ac_ctx, const ac_ucred_t *user_credentials);
 
+/**
+ * @brief Opens the file on behalf of the user. Instead of switching the identity around the open
+ * call, the file is opened with the process identity and the permissions of the user (as would be set
+ * by ::ac_set_user_identity) are checked against the ownership and mode of the opened file and the search
+ * permission of its parent directories, or taken from the cache if they have not changed since the last check.
+ * The identity is switched only if a POSIX ACL is present or if a new file is going to be created (O_CREAT),
+ * so that it is owned by the user.
+ *
+ * @param[in] ac_ctx Access Control module context acquired by ::ac_init call.
+ * @param[in] user_credentials Credentials of a sysrepo user, NULL to open the file with the process identity.
+ * @param[in] file_name Path to the file to be opened.
+ * @param[in] flags Flags passed to open().
+ * @param[in] mode Mode of a newly created file passed to open().
+ *
+ * @return File descriptor, -1 on error with errno set (EACCES if the user is not authorized).
+ */
+int ac_open_file(ac_ctx_t *ac_ctx, const ac_ucred_t *user_credentials, const char *file_name, int flags, mode_t mode);
+
 /**@} ac */
 
 #endif /* ACCESS_CONTROL_H_ */
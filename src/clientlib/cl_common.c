@@ -486,11 +486,19 @@ cl_request_process(sr_session_ctx_t *session, Sr__Msg *msg_req, Sr__Msg **msg_re
 {
     int rc = SR_ERR_OK;
     struct timeval tv = { 0, };
+    sr_trace_span_t span = { 0, };
 
     CHECK_NULL_ARG4(session, session->conn_ctx, msg_req, msg_resp);
 
     SR_LOG_DBG("Sending %s request.", sr_gpb_operation_name(expected_response_op));
 
+#ifdef ENABLE_REQUEST_TRACING
+    /* start a new trace for the request */
+    msg_req->trace_id = sr_trace_new_id();
+    msg_req->has_trace_id = (0 != msg_req->trace_id);
+#endif
+    SR_TRACE_BEGIN(&span, msg_req->trace_id, "client", sr_gpb_operation_name(expected_response_op));
+
     pthread_mutex_lock(&session->conn_ctx->lock);
     /* some operation may take more time, raise the timeout */
     if (SR__OPERATION__COMMIT == expected_response_op || SR__OPERATION__COPY_CONFIG == expected_response_op ||
@@ -516,6 +524,7 @@ cl_request_process(sr_session_ctx_t *session, Sr__Msg *msg_req, Sr__Msg **msg_re
 
     /* receive the response */
     rc = cl_message_recv(session->conn_ctx, msg_resp, sr_mem_resp);
+    SR_TRACE_END(&span);
     if (SR_ERR_OK != rc) {
         SR_LOG_ERR("Unable to receive the message with response (session id=%"PRIu32", operation=%s).",
                 session->id, sr_gpb_operation_name(msg_req->request->operation));
@@ -562,6 +571,9 @@ cl_request_process(sr_session_ctx_t *session, Sr__Msg *msg_req, Sr__Msg **msg_re
                         (*msg_resp)->response->error->message : sr_strerror((*msg_resp)->response->result));
         }
         return (*msg_resp)->response->result;
+    } else if (NULL != (*msg_resp)->response->error) {
+        /* successful response with partial result, e.g. some operational data have not been provided in time */
+        rc = cl_session_set_error(session, (*msg_resp)->response->error->message, (*msg_resp)->response->error->xpath);
     }
 
     return rc;
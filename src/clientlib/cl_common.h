@@ -58,6 +58,9 @@ typedef struct sr_session_ctx_s {
     bool notif_session;           /**< Distinguishes internal notification session from other ones. */
     uint32_t commit_id;           /**< ID of the commit in case that this is a notification session (0 otherwise). */
     uint32_t nc_session_id;                  /**< Assigned session identifier. */
+    const Sr__Notification *inline_changes;  /**< Change notification with inlined changes being processed by the callback (notification sessions only). */
+    const char *inline_changes_module;       /**< Module whose changes are inlined in case of module change notification. */
+    const char *inline_changes_xpath;        /**< Xpath whose changes are inlined in case of subtree change notification. */
 } sr_session_ctx_t;
 
 /**
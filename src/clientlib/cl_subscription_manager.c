@@ -35,6 +35,8 @@
 #include "cl_subscription_manager.h"
 #include "sr_common.h"
 #include "cl_common.h"
+#include "values_internal.h"
+#include "trees_internal.h"
 
 #define CL_SM_IN_BUFF_MIN_SPACE 512  /**< Minimal empty space in the input buffer. */
 #define CL_SM_BUFF_ALLOC_CHUNK 1024  /**< Chunk size for buffer expansions. */
@@ -698,19 +700,31 @@ cl_sm_notif_process(cl_sm_ctx_t *sm_ctx, cl_sm_conn_ctx_t *conn, Sr__Msg *msg)
             break;
         case SR__SUBSCRIPTION_TYPE__MODULE_CHANGE_SUBS:
             SR_LOG_DBG("Calling module-change callback for subscription id=%"PRIu32".", subscription->id);
+            if (msg->notification->changes_inlined) {
+                data_session->inline_changes = msg->notification;
+                data_session->inline_changes_module = msg->notification->module_change_notif->module_name;
+            }
             rc = subscription->callback.module_change_cb(
                     data_session,
                     msg->notification->module_change_notif->module_name,
                     sr_notification_event_gpb_to_sr(msg->notification->module_change_notif->event),
                     subscription->private_ctx);
+            data_session->inline_changes = NULL;
+            data_session->inline_changes_module = NULL;
             break;
         case SR__SUBSCRIPTION_TYPE__SUBTREE_CHANGE_SUBS:
             SR_LOG_DBG("Calling subtree-change callback for subscription id=%"PRIu32".", subscription->id);
+            if (msg->notification->changes_inlined) {
+                data_session->inline_changes = msg->notification;
+                data_session->inline_changes_xpath = msg->notification->subtree_change_notif->xpath;
+            }
             rc = subscription->callback.subtree_change_cb(
                     data_session,
                     msg->notification->subtree_change_notif->xpath,
                     sr_notification_event_gpb_to_sr(msg->notification->subtree_change_notif->event),
                     subscription->private_ctx);
+            data_session->inline_changes = NULL;
+            data_session->inline_changes_xpath = NULL;
             break;
         case SR__SUBSCRIPTION_TYPE__HELLO_SUBS:
             SR_LOG_DBG("HELLO notification received on subscription id=%"PRIu32".", subscription->id);
@@ -774,6 +788,118 @@ ack:
     return rc;
 }
 
+/**
+ * @brief Calls the data provider callback of a subscription that does not support batched requests
+ * for each of the requested xpaths and merges the provided values into one array. If the callback fails
+ * for any of the xpaths, the xpath is marked in @p failed and the values of the other xpaths are still provided.
+ */
+static int
+cl_sm_dp_get_items_merged(cl_sm_subscription_ctx_t *subscription, const char **xpaths, size_t xpath_cnt,
+        sr_val_t **values_p, size_t *values_cnt_p, bool *failed)
+{
+    sr_val_t **partial = NULL, *values = NULL;
+    size_t *partial_cnt = NULL, values_cnt = 0, pos = 0;
+    int rc = SR_ERR_OK, cb_rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG5(subscription, xpaths, values_p, values_cnt_p, failed);
+
+    if (1 == xpath_cnt) {
+        cb_rc = subscription->callback.dp_get_items_cb(xpaths[0], values_p, values_cnt_p, subscription->private_ctx);
+        failed[0] = (SR_ERR_OK != cb_rc);
+        return cb_rc;
+    }
+
+    partial = calloc(xpath_cnt, sizeof(*partial));
+    CHECK_NULL_NOMEM_GOTO(partial, rc, cleanup);
+    partial_cnt = calloc(xpath_cnt, sizeof(*partial_cnt));
+    CHECK_NULL_NOMEM_GOTO(partial_cnt, rc, cleanup);
+
+    for (size_t i = 0; i < xpath_cnt; i++) {
+        rc = subscription->callback.dp_get_items_cb(xpaths[i], &partial[i], &partial_cnt[i], subscription->private_ctx);
+        if (SR_ERR_OK != rc) {
+            /* data of the other xpaths can still be provided */
+            SR_LOG_WRN("Data provider failed to provide data for xpath '%s': %s.", xpaths[i], sr_strerror(rc));
+            partial[i] = NULL;
+            partial_cnt[i] = 0;
+            failed[i] = true;
+            cb_rc = rc;
+            rc = SR_ERR_OK;
+            continue;
+        }
+        values_cnt += partial_cnt[i];
+    }
+
+    if (0 == values_cnt) {
+        goto cleanup;
+    }
+
+    rc = sr_new_values(values_cnt, &values);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to allocate array of values.");
+
+    for (size_t i = 0; i < xpath_cnt; i++) {
+        for (size_t j = 0; j < partial_cnt[i]; j++, pos++) {
+            rc = sr_val_set_xpath(&values[pos], partial[i][j].xpath);
+            CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to duplicate value xpath.");
+            rc = sr_dup_val_data(&values[pos], &partial[i][j]);
+            CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to duplicate value data.");
+        }
+    }
+
+    *values_p = values;
+    *values_cnt_p = values_cnt;
+    values = NULL;
+
+cleanup:
+    if (NULL != partial && NULL != partial_cnt) {
+        for (size_t i = 0; i < xpath_cnt; i++) {
+            sr_free_values(partial[i], partial_cnt[i]);
+        }
+    }
+    free(partial);
+    free(partial_cnt);
+    sr_free_values(values, values_cnt);
+
+    return (SR_ERR_OK == rc) ? cb_rc : rc;
+}
+
+/**
+ * @brief Calls the tree data provider callback of a subscription for each of the requested xpaths
+ * and duplicates the provided trees into the memory context of the response. Xpaths the callback
+ * failed for are marked in @p failed.
+ */
+static int
+cl_sm_dp_get_items_trees(cl_sm_subscription_ctx_t *subscription, const char **xpaths, size_t xpath_cnt,
+        sr_mem_ctx_t *sr_mem, sr_node_t **trees, size_t *tree_cnts, bool *failed)
+{
+    sr_node_t *partial = NULL;
+    size_t partial_cnt = 0;
+    int rc = SR_ERR_OK, cb_rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG5(subscription, xpaths, sr_mem, trees, tree_cnts);
+    CHECK_NULL_ARG(failed);
+
+    for (size_t i = 0; i < xpath_cnt; i++) {
+        partial = NULL;
+        partial_cnt = 0;
+        rc = subscription->callback.dp_get_items_tree_cb(xpaths[i], &partial, &partial_cnt, subscription->private_ctx);
+        if (SR_ERR_OK != rc) {
+            /* data of the other xpaths can still be provided */
+            SR_LOG_WRN("Data provider failed to provide data for xpath '%s': %s.", xpaths[i], sr_strerror(rc));
+            failed[i] = true;
+            cb_rc = rc;
+            continue;
+        }
+        if (partial_cnt > 0) {
+            rc = sr_dup_trees_ctx(partial, partial_cnt, sr_mem, &trees[i]);
+            sr_free_trees(partial, partial_cnt);
+            CHECK_RC_MSG_RETURN(rc, "Unable to duplicate provided trees.");
+            tree_cnts[i] = partial_cnt;
+        }
+    }
+
+    return cb_rc;
+}
+
 /**
  * @brief Processes an incoming data-provide request message.
  */
@@ -782,52 +908,137 @@ cl_sm_dp_request_process(cl_sm_ctx_t *sm_ctx, cl_sm_conn_ctx_t *conn, Sr__Msg *m
 {
     cl_sm_subscription_ctx_t *subscription = NULL;
     cl_sm_subscription_ctx_t subscription_lookup = { 0, };
+    Sr__DataProvideReq *dp_req = NULL;
+    Sr__DataProvideResp *dp_resp = NULL;
     Sr__Msg *resp = NULL;
     sr_mem_ctx_t *sr_mem_resp = NULL;
     sr_val_t *values = NULL;
-    size_t values_cnt = 0;
+    sr_node_t **trees = NULL;
+    size_t values_cnt = 0, *tree_cnts = NULL, pos = 0;
+    const char **xpaths = NULL;
+    size_t xpath_cnt = 0, failed_cnt = 0;
+    bool *failed = NULL;
     int rc = SR_ERR_OK, cb_rc = SR_ERR_OK;
 
     CHECK_NULL_ARG4(sm_ctx, msg, msg->request, msg->request->data_provide_req);
+    dp_req = msg->request->data_provide_req;
 
-    SR_LOG_DBG("Received a data-provide request for subscription id=%"PRIu32".", msg->request->data_provide_req->subscription_id);
+    SR_LOG_DBG("Received a data-provide request for subscription id=%"PRIu32".", dp_req->subscription_id);
+
+    /* single or batched request */
+    if (dp_req->n_xpaths > 0) {
+        xpaths = (const char **) dp_req->xpaths;
+        xpath_cnt = dp_req->n_xpaths;
+    } else {
+        xpaths = (const char **) &dp_req->xpath;
+        xpath_cnt = 1;
+    }
+    failed = calloc(xpath_cnt, sizeof(*failed));
+    CHECK_NULL_NOMEM_GOTO(failed, rc, cleanup);
 
     pthread_mutex_lock(&sm_ctx->subscriptions_lock);
 
     /* find the subscription according to id */
-    subscription_lookup.id = msg->request->data_provide_req->subscription_id;
+    subscription_lookup.id = dp_req->subscription_id;
     subscription = sr_btree_search(sm_ctx->subscriptions_btree, &subscription_lookup);
     if (NULL == subscription) {
         pthread_mutex_unlock(&sm_ctx->subscriptions_lock);
-        SR_LOG_ERR("No matching subscription for subscription id=%"PRIu32".", msg->request->data_provide_req->subscription_id);
+        SR_LOG_ERR("No matching subscription for subscription id=%"PRIu32".", dp_req->subscription_id);
         goto cleanup;
     }
 
-    SR_LOG_DBG("Calling dp_get_items_cb callback for subscription id=%"PRIu32".", subscription->id);
+    SR_LOG_DBG("Calling dp_get_items_cb callback for subscription id=%"PRIu32" (%zu xpath(s)).", subscription->id, xpath_cnt);
 
-    cb_rc = subscription->callback.dp_get_items_cb(
-            msg->request->data_provide_req->xpath,
-            &values, &values_cnt,
-            subscription->private_ctx);
+    if (SR_API_TREES == subscription->api_variant) {
+        /* provided trees are duplicated directly into the memory context of the response */
+        trees = calloc(xpath_cnt, sizeof(*trees));
+        tree_cnts = calloc(xpath_cnt, sizeof(*tree_cnts));
+        rc = (NULL == trees || NULL == tree_cnts) ? SR_ERR_NOMEM : sr_mem_new(0, &sr_mem_resp);
+        if (SR_ERR_OK != rc) {
+            pthread_mutex_unlock(&sm_ctx->subscriptions_lock);
+            SR_LOG_ERR_MSG("Unable to allocate data-provide response context.");
+            goto cleanup;
+        }
+        cb_rc = cl_sm_dp_get_items_trees(subscription, xpaths, xpath_cnt, sr_mem_resp, trees, tree_cnts, failed);
+    } else if (subscription->dp_batch) {
+        cb_rc = subscription->callback.dp_get_items_batch_cb(xpaths, xpath_cnt, &values, &values_cnt,
+                subscription->private_ctx);
+        for (size_t i = 0; i < xpath_cnt; i++) {
+            /* the batch fails as a whole */
+            failed[i] = (SR_ERR_OK != cb_rc);
+        }
+    } else {
+        cb_rc = cl_sm_dp_get_items_merged(subscription, xpaths, xpath_cnt, &values, &values_cnt, failed);
+    }
 
     pthread_mutex_unlock(&sm_ctx->subscriptions_lock);
 
+    for (size_t i = 0; i < xpath_cnt; i++) {
+        failed_cnt += failed[i] ? 1 : 0;
+    }
+
     /* allocate the response and send it */
     if (NULL != values) {
         sr_mem_resp = values[0]._sr_mem;
     }
     rc = sr_gpb_resp_alloc(sr_mem_resp, SR__OPERATION__DATA_PROVIDE, msg->session_id, &resp);
-    CHECK_RC_MSG_RETURN(rc, "Allocation of data-provide response failed.");
-
-    resp->response->result = cb_rc;
-    resp->response->data_provide_resp->request_id = msg->request->data_provide_req->request_id;
-    sr_mem_edit_string(sr_mem_resp, &resp->response->data_provide_resp->xpath, msg->request->data_provide_req->xpath);
-    CHECK_NULL_NOMEM_GOTO(resp->response->data_provide_resp->xpath, rc, cleanup);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Allocation of data-provide response failed.");
+    dp_resp = resp->response->data_provide_resp;
+
+    /* the error is reported for the whole response only if no data could be provided */
+    resp->response->result = (failed_cnt == xpath_cnt) ? cb_rc : SR_ERR_OK;
+    dp_resp->request_id = dp_req->request_id;
+    sr_mem_edit_string(sr_mem_resp, &dp_resp->xpath, dp_req->xpath);
+    CHECK_NULL_NOMEM_GOTO(dp_resp->xpath, rc, cleanup);
+
+    if (dp_req->n_xpaths > 0) {
+        /* batched response - list all xpaths the values belong to */
+        dp_resp->xpaths = sr_calloc(sr_mem_resp, dp_req->n_xpaths, sizeof(*dp_resp->xpaths));
+        CHECK_NULL_NOMEM_GOTO(dp_resp->xpaths, rc, cleanup);
+        dp_resp->n_xpaths = dp_req->n_xpaths;
+        for (size_t i = 0; i < dp_req->n_xpaths; i++) {
+            sr_mem_edit_string(sr_mem_resp, &dp_resp->xpaths[i], dp_req->xpaths[i]);
+            CHECK_NULL_NOMEM_GOTO(dp_resp->xpaths[i], rc, cleanup);
+        }
+    }
+    if (failed_cnt > 0 && failed_cnt < xpath_cnt) {
+        /* list the xpaths the data could not be provided for */
+        dp_resp->failed = sr_calloc(sr_mem_resp, failed_cnt, sizeof(*dp_resp->failed));
+        CHECK_NULL_NOMEM_GOTO(dp_resp->failed, rc, cleanup);
+        for (size_t i = 0; i < xpath_cnt; i++) {
+            if (failed[i]) {
+                dp_resp->failed[dp_resp->n_failed++] = i;
+            }
+        }
+    }
 
     /* copy output values to GPB */
-    if (SR_ERR_OK == cb_rc) {
-        rc = sr_values_sr_to_gpb(values, values_cnt, &resp->response->data_provide_resp->values,
-                &resp->response->data_provide_resp->n_values);
+    if (NULL != trees) {
+        /* trees of all xpaths with the number of trees provided for each of them */
+        dp_resp->tree_cnts = sr_calloc(sr_mem_resp, xpath_cnt, sizeof(*dp_resp->tree_cnts));
+        CHECK_NULL_NOMEM_GOTO(dp_resp->tree_cnts, rc, cleanup);
+        dp_resp->n_tree_cnts = xpath_cnt;
+        for (size_t i = 0; i < xpath_cnt; i++) {
+            dp_resp->tree_cnts[i] = tree_cnts[i];
+            pos += tree_cnts[i];
+        }
+        if (pos > 0) {
+            dp_resp->trees = sr_calloc(sr_mem_resp, pos, sizeof(*dp_resp->trees));
+            CHECK_NULL_NOMEM_GOTO(dp_resp->trees, rc, cleanup);
+        }
+        for (size_t i = 0; i < xpath_cnt && SR_ERR_OK == rc; i++) {
+            for (size_t j = 0; j < tree_cnts[i] && SR_ERR_OK == rc; j++) {
+                rc = sr_dup_tree_to_gpb(&trees[i][j], &dp_resp->trees[dp_resp->n_trees]);
+                if (SR_ERR_OK == rc) {
+                    dp_resp->n_trees++;
+                }
+            }
+        }
+        if (SR_ERR_OK != rc) {
+            SR_LOG_ERR_MSG("Error by copying output trees to GPB.");
+        }
+    } else if (failed_cnt < xpath_cnt) {
+        rc = sr_values_sr_to_gpb(values, values_cnt, &dp_resp->values, &dp_resp->n_values);
         if (SR_ERR_OK != rc) {
             SR_LOG_ERR_MSG("Error by copying output values to GPB.");
         }
@@ -837,7 +1048,19 @@ cl_sm_dp_request_process(cl_sm_ctx_t *sm_ctx, cl_sm_conn_ctx_t *conn, Sr__Msg *m
     rc = cl_sm_msg_send_connection(sm_ctx, conn, resp);
 
 cleanup:
+    if (NULL == resp && NULL != trees && NULL != sr_mem_resp && 0 == sr_mem_resp->obj_count) {
+        /* the context of the response is not referenced by any tree nor message */
+        sr_mem_free(sr_mem_resp);
+    }
     sr_free_values(values, values_cnt);
+    if (NULL != trees && NULL != tree_cnts) {
+        for (size_t i = 0; i < xpath_cnt; i++) {
+            sr_free_trees(trees[i], tree_cnts[i]);
+        }
+    }
+    free(trees);
+    free(tree_cnts);
+    free(failed);
     sr_msg_free(resp);
     return rc;
 }
@@ -1035,6 +1258,7 @@ cl_sm_conn_msg_process(cl_sm_ctx_t *sm_ctx, cl_sm_conn_ctx_t *conn, uint8_t *msg
 {
     Sr__Msg *msg = NULL;
     sr_mem_ctx_t *sr_mem = NULL;
+    sr_trace_span_t span = { 0, };
     int rc = SR_ERR_OK;
 
     CHECK_NULL_ARG3(sm_ctx, conn, msg_data);
@@ -1059,6 +1283,9 @@ cl_sm_conn_msg_process(cl_sm_ctx_t *sm_ctx, cl_sm_conn_ctx_t *conn, uint8_t *msg
         ++sr_mem->obj_count;
     }
 
+    SR_TRACE_BEGIN(&span, msg->trace_id, "subscriber", (SR__MSG__MSG_TYPE__REQUEST == msg->type && NULL != msg->request) ?
+            sr_gpb_operation_name(msg->request->operation) : "notification");
+
     /* check the message */
     if (SR__MSG__MSG_TYPE__NOTIFICATION == msg->type) {
         /* notification */
@@ -1078,6 +1305,8 @@ cl_sm_conn_msg_process(cl_sm_ctx_t *sm_ctx, cl_sm_conn_ctx_t *conn, uint8_t *msg
         rc = SR_ERR_INVAL_ARG;
     }
 
+    SR_TRACE_END(&span);
+
     /* release the message */
     sr_msg_free(msg);
 
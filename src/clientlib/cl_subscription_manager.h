@@ -51,6 +51,8 @@ typedef union cl_sm_callback_u {
         sr_module_change_cb module_change_cb;    /**< Callback to be called by module change event. */
         sr_subtree_change_cb subtree_change_cb;  /**< Callback to be called by subtree change event. */
         sr_dp_get_items_cb dp_get_items_cb;      /**< Callback to be called by operational data requests. */
+        sr_dp_get_items_batch_cb dp_get_items_batch_cb;  /**< Callback to be called by operational data requests -- the *batch* variant. */
+        sr_dp_get_items_tree_cb dp_get_items_tree_cb;  /**< Callback to be called by operational data requests -- the *tree* variant. */
         sr_rpc_cb rpc_cb;                        /**< Callback to be called by RPC delivery. */
         sr_rpc_tree_cb rpc_tree_cb;              /**< Callback to be called by RPC delivery -- the *tree* variant */
         sr_action_cb action_cb;                  /**< Callback to be called by Action delivery. */
@@ -70,6 +72,7 @@ typedef struct cl_sm_subscription_ctx_s {
     const char *xpath;                           /**< XPath of the subscribed subtree, if applicable. */
     cl_sm_callback_t callback;                   /**< Callback to be called when the associated notification/action triggers. */
     sr_api_variant_t api_variant;                /**< API variant -- values vs. trees (relevant for the callback type only) */
+    bool dp_batch;                               /**< TRUE if the data provider callback is the *batch* variant. */
     cl_sm_ctx_t *sm_ctx;                         /**< Associated Subscription Manager context. */
     sr_session_ctx_t *data_session;              /**< Pointer to a data session that can be used from notification callbacks. */
     void *private_ctx;                           /**< Private context pointer, opaque to sysrepo. */
@@ -93,6 +93,7 @@ typedef struct sr_change_iter_s {
     sr_val_t **old_values;          /**< Buffered old values. */
     size_t index;                   /**< Index into buff_values pointing to the value to be returned by next call. */
     size_t count;                   /**< Number of elements currently buffered. */
+    bool complete;                  /**< All changes are buffered (they were delivered inline with the notification). */
 } sr_change_iter_t;
 
 static int connections_cnt = 0;               /**< Number of active connections to the Sysrepo Engine. */
@@ -256,6 +257,7 @@ cleanup:
     }
     if ((0 == subscriptions_cnt) && (0 == connections_cnt)) {
         /* destroy library-global resources */
+        sr_trace_flush();
         sr_logger_cleanup();
     }
     pthread_mutex_unlock(&global_lock);
@@ -483,9 +485,13 @@ sr_disconnect(sr_conn_ctx_t *conn_ctx)
             cm_stop(local_cm_ctx);
             cm_cleanup(local_cm_ctx);
             local_cm_ctx = NULL;
+#ifdef ENABLE_LOCK_PROFILING
+            sr_lock_prof_dump();
+#endif
         }
         if ((0 == subscriptions_cnt) && (0 == connections_cnt)) {
             /* destroy library-global resources */
+            sr_trace_flush();
             sr_logger_cleanup();
         }
         pthread_mutex_unlock(&global_lock);
@@ -2556,6 +2562,8 @@ sr_module_change_subscribe(sr_session_ctx_t *session, const char *module_name, s
     msg_req->request->subscribe_req->enable_running = !(opts & SR_SUBSCR_PASSIVE);
     msg_req->request->subscribe_req->has_enable_event = true;
     msg_req->request->subscribe_req->enable_event = (opts & SR_SUBSCR_EV_ENABLED);
+    msg_req->request->subscribe_req->has_inline_changes = true;
+    msg_req->request->subscribe_req->inline_changes = (opts & SR_SUBSCR_INLINE_CHANGES);
 
     /* send the request and receive the response */
     rc = cl_request_process(session, msg_req, &msg_resp, NULL, SR__OPERATION__SUBSCRIBE);
@@ -2629,6 +2637,8 @@ sr_subtree_change_subscribe(sr_session_ctx_t *session, const char *xpath, sr_sub
     msg_req->request->subscribe_req->enable_running = !(opts & SR_SUBSCR_PASSIVE);
     msg_req->request->subscribe_req->has_enable_event = true;
     msg_req->request->subscribe_req->enable_event = (opts & SR_SUBSCR_EV_ENABLED);
+    msg_req->request->subscribe_req->has_inline_changes = true;
+    msg_req->request->subscribe_req->inline_changes = (opts & SR_SUBSCR_INLINE_CHANGES);
 
     /* send the request and receive the response */
     rc = cl_request_process(session, msg_req, &msg_resp, NULL, SR__OPERATION__SUBSCRIBE);
@@ -2657,10 +2667,36 @@ cleanup:
     return cl_session_return(session, rc);
 }
 
+/**
+ * @brief Returns true if the changes delivered inline with the notification being processed
+ * in the session are exactly the changes selected by the xpath.
+ */
+static bool
+cl_inline_changes_match(sr_session_ctx_t *session, const char *xpath)
+{
+    size_t len = 0;
+
+    if (NULL == session->inline_changes) {
+        return false;
+    }
+    if (NULL != session->inline_changes_xpath) {
+        return 0 == strcmp(session->inline_changes_xpath, xpath);
+    }
+    if (NULL != session->inline_changes_module) {
+        /* module change subscription selects "/<module>:*" */
+        len = strlen(session->inline_changes_module);
+        return '/' == xpath[0] && 0 == strncmp(xpath + 1, session->inline_changes_module, len) &&
+                0 == strcmp(xpath + 1 + len, ":*");
+    }
+    return false;
+}
+
 int
 sr_get_changes_iter(sr_session_ctx_t *session, const char *xpath, sr_change_iter_t **iter)
 {
     Sr__Msg *msg_resp = NULL;
+    sr_mem_ctx_t *sr_mem = NULL;
+    Sr__Change **changes = NULL;
     sr_change_iter_t *it = NULL;
     int rc = SR_ERR_OK;
 
@@ -2668,20 +2704,30 @@ sr_get_changes_iter(sr_session_ctx_t *session, const char *xpath, sr_change_iter
 
     cl_session_clear_errors(session);
 
-    rc = cl_send_get_changes(session, xpath, 0, CL_GET_ITEMS_FETCH_LIMIT, &msg_resp);
-    if (SR_ERR_NOT_FOUND == rc) {
-        SR_LOG_DBG("No items found for xpath '%s'", xpath);
-        /* SR_ERR_NOT_FOUND will be returned on get_change_next call */
-        rc = SR_ERR_OK;
-    } else {
-        CHECK_RC_LOG_GOTO(rc, cleanup, "Sending get_changes request failed '%s'", xpath);
-    }
-
     it = calloc(1, sizeof(*it));
     CHECK_NULL_NOMEM_GOTO(it, rc, cleanup);
 
+    if (cl_inline_changes_match(session, xpath)) {
+        /* all changes have been delivered with the notification, no need to ask for them */
+        SR_LOG_DBG("Using the changes delivered inline with the notification for xpath '%s'", xpath);
+        it->complete = true;
+        it->count = session->inline_changes->n_changes;
+        changes = session->inline_changes->changes;
+    } else {
+        rc = cl_send_get_changes(session, xpath, 0, CL_GET_ITEMS_FETCH_LIMIT, &msg_resp);
+        if (SR_ERR_NOT_FOUND == rc) {
+            SR_LOG_DBG("No items found for xpath '%s'", xpath);
+            /* SR_ERR_NOT_FOUND will be returned on get_change_next call */
+            rc = SR_ERR_OK;
+        } else {
+            CHECK_RC_LOG_GOTO(rc, cleanup, "Sending get_changes request failed '%s'", xpath);
+        }
+        sr_mem = (sr_mem_ctx_t *)msg_resp->_sysrepo_mem_ctx;
+        it->count = msg_resp->response->get_changes_resp->n_changes;
+        changes = msg_resp->response->get_changes_resp->changes;
+    }
+
     it->index = 0;
-    it->count = msg_resp->response->get_changes_resp->n_changes;
     it->offset = it->count;
 
     it->xpath = strdup(xpath);
@@ -2698,17 +2744,15 @@ sr_get_changes_iter(sr_session_ctx_t *session, const char *xpath, sr_change_iter
 
     /* copy the content of gpb to sr_val_t */
     for (size_t i = 0; i < it->count; i++) {
-        if (NULL != msg_resp->response->get_changes_resp->changes[i]->new_value) {
-            rc = sr_dup_gpb_to_val_t((sr_mem_ctx_t *)msg_resp->_sysrepo_mem_ctx,
-                                     msg_resp->response->get_changes_resp->changes[i]->new_value, &it->new_values[i]);
+        if (NULL != changes[i]->new_value) {
+            rc = sr_dup_gpb_to_val_t(sr_mem, changes[i]->new_value, &it->new_values[i]);
             CHECK_RC_MSG_GOTO(rc, cleanup, "Copying from gpb to sr_val_t failed");
         }
-        if (NULL != msg_resp->response->get_changes_resp->changes[i]->old_value) {
-            rc = sr_dup_gpb_to_val_t((sr_mem_ctx_t *)msg_resp->_sysrepo_mem_ctx,
-                                     msg_resp->response->get_changes_resp->changes[i]->old_value, &it->old_values[i]);
+        if (NULL != changes[i]->old_value) {
+            rc = sr_dup_gpb_to_val_t(sr_mem, changes[i]->old_value, &it->old_values[i]);
             CHECK_RC_MSG_GOTO(rc, cleanup, "Copying from gpb to sr_val_t failed");
         }
-        it->operations[i] = sr_change_op_gpb_to_sr(msg_resp->response->get_changes_resp->changes[i]->changeoperation);
+        it->operations[i] = sr_change_op_gpb_to_sr(changes[i]->changeoperation);
     }
 
     *iter = it;
@@ -2738,7 +2782,7 @@ sr_get_change_next(sr_session_ctx_t *session, sr_change_iter_t *iter, sr_change_
 
     cl_session_clear_errors(session);
 
-    if (0 == iter->count) {
+    if (0 == iter->count || (iter->complete && iter->index >= iter->count)) {
         /* No more data to be read */
         *new_value = NULL;
         *old_value = NULL;
@@ -3410,9 +3454,26 @@ sr_action_send_tree(sr_session_ctx_t *session, const char *xpath,
     return cl_rpc_send_tree(session, xpath, true, input, input_cnt, output, output_cnt);
 }
 
-int
-sr_dp_get_items_subscribe(sr_session_ctx_t *session, const char *xpath, sr_dp_get_items_cb callback, void *private_ctx,
-        sr_subscr_options_t opts, sr_subscription_ctx_t **subscription_p)
+/**
+ * @brief Subscribes for providing of operational data under given xpath.
+ *
+ * @param[in] session Session context acquired with ::sr_session_start call.
+ * @param[in] xpath XPath identifying the subtree under which the provider is able to provide operational data.
+ * @param[in] callback Callback to be called when the operational data under given xpath is needed.
+ * @param[in] api_variant API variant of the callback -- values vs. trees.
+ * @param[in] batch TRUE if the callback is the *batch* variant.
+ * @param[in] private_ctx Private context passed to the callback function, opaque to sysrepo.
+ * @param[in] cache_ttl Validity period of the provided data in milliseconds (0 = data are not cached).
+ * @param[in] opts Options overriding default behavior of the subscription, it is supposed to be
+ * a bitwise OR-ed value of any ::sr_subscr_flag_t flags.
+ * @param[in,out] subscription Subscription context that is supposed to be released by ::sr_unsubscribe.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+static int
+cl_dp_get_items_subscribe(sr_session_ctx_t *session, const char *xpath, cl_sm_callback_t callback,
+        sr_api_variant_t api_variant, bool batch, void *private_ctx, uint32_t cache_ttl, sr_subscr_options_t opts,
+        sr_subscription_ctx_t **subscription_p)
 {
     Sr__Msg *msg_req = NULL, *msg_resp = NULL;
     sr_subscription_ctx_t *sr_subscription = NULL;
@@ -3421,10 +3482,15 @@ sr_dp_get_items_subscribe(sr_session_ctx_t *session, const char *xpath, sr_dp_ge
     sr_mem_ctx_t *sr_mem = NULL;
     int rc = SR_ERR_OK;
 
-    CHECK_NULL_ARG3(session, callback, subscription_p);
+    CHECK_NULL_ARG2(session, subscription_p);
 
     cl_session_clear_errors(session);
 
+    if (cache_ttl > SR_DP_CACHE_TTL_MAX) {
+        SR_LOG_ERR("Validity period of the provided data out of range (%"PRIu32" ms).", cache_ttl);
+        return cl_session_return(session, SR_ERR_INVAL_ARG);
+    }
+
     /* extract module name from xpath */
     rc = sr_copy_first_ns(xpath, &module_name);
     CHECK_RC_MSG_GOTO(rc, cleanup, "Error by extracting module name from xpath.");
@@ -3433,11 +3499,12 @@ sr_dp_get_items_subscribe(sr_session_ctx_t *session, const char *xpath, sr_dp_ge
     if (opts & SR_SUBSCR_CTX_REUSE) {
         sr_subscription = *subscription_p;
     }
-    rc = cl_subscription_init(session, SR__SUBSCRIPTION_TYPE__DP_GET_ITEMS_SUBS, module_name, SR_API_VALUES, opts,
+    rc = cl_subscription_init(session, SR__SUBSCRIPTION_TYPE__DP_GET_ITEMS_SUBS, module_name, api_variant, opts,
             private_ctx, &sr_subscription, &sm_subscription, &msg_req);
     CHECK_RC_MSG_GOTO(rc, cleanup, "Error by initialization of the subscription in the client library.");
 
-    sm_subscription->callback.dp_get_items_cb = callback;
+    sm_subscription->callback = callback;
+    sm_subscription->dp_batch = batch;
 
     /* Fill-in GPB subscription information */
     sr_mem = (sr_mem_ctx_t *)msg_req->_sysrepo_mem_ctx;
@@ -3450,6 +3517,12 @@ sr_dp_get_items_subscribe(sr_session_ctx_t *session, const char *xpath, sr_dp_ge
     msg_req->request->subscribe_req->has_enable_running = true;
     msg_req->request->subscribe_req->enable_running = !(opts & SR_SUBSCR_PASSIVE);
 
+    /* validity period of the provided data (trees are not cached) */
+    if (0 != cache_ttl && SR_API_VALUES == api_variant) {
+        msg_req->request->subscribe_req->has_dp_cache_ttl = true;
+        msg_req->request->subscribe_req->dp_cache_ttl = cache_ttl;
+    }
+
     /* send the request and receive the response */
     rc = cl_request_process(session, msg_req, &msg_resp, NULL, SR__OPERATION__SUBSCRIBE);
     CHECK_RC_MSG_GOTO(rc, cleanup, "Error by processing of the request.");
@@ -3477,6 +3550,175 @@ cleanup:
     return cl_session_return(session, rc);
 }
 
+int
+sr_dp_get_items_subscribe(sr_session_ctx_t *session, const char *xpath, sr_dp_get_items_cb callback, void *private_ctx,
+        sr_subscr_options_t opts, sr_subscription_ctx_t **subscription_p)
+{
+    cl_sm_callback_t callback_u;
+
+    CHECK_NULL_ARG(callback);
+
+    callback_u.dp_get_items_cb = callback;
+    return cl_dp_get_items_subscribe(session, xpath, callback_u, SR_API_VALUES, false, private_ctx, 0, opts, subscription_p);
+}
+
+int
+sr_dp_get_items_batch_subscribe(sr_session_ctx_t *session, const char *xpath, sr_dp_get_items_batch_cb callback,
+        void *private_ctx, sr_subscr_options_t opts, sr_subscription_ctx_t **subscription_p)
+{
+    cl_sm_callback_t callback_u;
+
+    CHECK_NULL_ARG(callback);
+
+    callback_u.dp_get_items_batch_cb = callback;
+    return cl_dp_get_items_subscribe(session, xpath, callback_u, SR_API_VALUES, true, private_ctx, 0, opts, subscription_p);
+}
+
+int
+sr_dp_get_items_subscribe_cached(sr_session_ctx_t *session, const char *xpath, sr_dp_get_items_cb callback,
+        void *private_ctx, uint32_t cache_ttl, sr_subscr_options_t opts, sr_subscription_ctx_t **subscription_p)
+{
+    cl_sm_callback_t callback_u;
+
+    CHECK_NULL_ARG(callback);
+
+    callback_u.dp_get_items_cb = callback;
+    return cl_dp_get_items_subscribe(session, xpath, callback_u, SR_API_VALUES, false, private_ctx, cache_ttl, opts,
+            subscription_p);
+}
+
+int
+sr_dp_get_items_batch_subscribe_cached(sr_session_ctx_t *session, const char *xpath,
+        sr_dp_get_items_batch_cb callback, void *private_ctx, uint32_t cache_ttl, sr_subscr_options_t opts,
+        sr_subscription_ctx_t **subscription_p)
+{
+    cl_sm_callback_t callback_u;
+
+    CHECK_NULL_ARG(callback);
+
+    callback_u.dp_get_items_batch_cb = callback;
+    return cl_dp_get_items_subscribe(session, xpath, callback_u, SR_API_VALUES, true, private_ctx, cache_ttl, opts,
+            subscription_p);
+}
+
+int
+sr_dp_get_items_subscribe_tree(sr_session_ctx_t *session, const char *xpath, sr_dp_get_items_tree_cb callback,
+        void *private_ctx, sr_subscr_options_t opts, sr_subscription_ctx_t **subscription_p)
+{
+    cl_sm_callback_t callback_u;
+
+    CHECK_NULL_ARG(callback);
+
+    callback_u.dp_get_items_tree_cb = callback;
+    return cl_dp_get_items_subscribe(session, xpath, callback_u, SR_API_TREES, false, private_ctx, 0, opts, subscription_p);
+}
+
+int
+sr_dp_cache_invalidate(sr_session_ctx_t *session, const char *xpath)
+{
+    Sr__Msg *msg_req = NULL, *msg_resp = NULL;
+    sr_mem_ctx_t *sr_mem = NULL;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG2(session, xpath);
+
+    cl_session_clear_errors(session);
+
+    /* prepare request message */
+    rc = sr_mem_new(0, &sr_mem);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to create a new Sysrepo memory context.");
+    rc = sr_gpb_req_alloc(sr_mem, SR__OPERATION__DP_CACHE_INVALIDATE, session->id, &msg_req);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Cannot allocate GPB message.");
+
+    /* fill-in xpath */
+    sr_mem_edit_string(sr_mem, &msg_req->request->dp_cache_invalidate_req->xpath, xpath);
+    CHECK_NULL_NOMEM_GOTO(msg_req->request->dp_cache_invalidate_req->xpath, rc, cleanup);
+
+    /* send the request and receive the response */
+    rc = cl_request_process(session, msg_req, &msg_resp, NULL, SR__OPERATION__DP_CACHE_INVALIDATE);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Error by processing of the request.");
+
+    sr_msg_free(msg_req);
+    sr_msg_free(msg_resp);
+
+    return cl_session_return(session, SR_ERR_OK);
+
+cleanup:
+    if (NULL != msg_req) {
+        sr_msg_free(msg_req);
+    } else {
+        sr_mem_free(sr_mem);
+    }
+    if (NULL != msg_resp) {
+        sr_msg_free(msg_resp);
+    }
+    return cl_session_return(session, rc);
+}
+
+int
+sr_oper_data_push(sr_session_ctx_t *session, const char *xpath, const sr_val_t *values, size_t values_cnt,
+        sr_oper_push_options_t opts)
+{
+    Sr__Msg *msg_req = NULL, *msg_resp = NULL;
+    sr_mem_ctx_t *sr_mem = NULL;
+    sr_mem_snapshot_t snapshot = { 0, };
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG3(session, session->conn_ctx, xpath);
+    if (values_cnt > 0) {
+        CHECK_NULL_ARG(values);
+    }
+
+    if (NULL != values) {
+        sr_mem = values[0]._sr_mem;
+        sr_mem_snapshot(sr_mem, &snapshot);
+    }
+
+    cl_session_clear_errors(session);
+
+    /* prepare oper-data-push message */
+    rc = sr_gpb_req_alloc(sr_mem, SR__OPERATION__OPER_DATA_PUSH, session->id, &msg_req);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Cannot allocate GPB message.");
+
+    /* set arguments */
+    sr_mem_edit_string(sr_mem, &msg_req->request->oper_data_push_req->xpath, xpath);
+    CHECK_NULL_NOMEM_GOTO(msg_req->request->oper_data_push_req->xpath, rc, cleanup);
+    if (opts & SR_OPER_PUSH_REPLACE) {
+        msg_req->request->oper_data_push_req->has_replace = true;
+        msg_req->request->oper_data_push_req->replace = true;
+    }
+
+    /* set values */
+    rc = sr_values_sr_to_gpb(values, values_cnt, &msg_req->request->oper_data_push_req->values,
+                             &msg_req->request->oper_data_push_req->n_values);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Error by copying operational data values to GPB.");
+
+    /* send the request and receive the response */
+    rc = cl_request_process(session, msg_req, &msg_resp, NULL, SR__OPERATION__OPER_DATA_PUSH);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Error by processing of the request.");
+
+    sr_msg_free(msg_req);
+    sr_msg_free(msg_resp);
+
+    if (snapshot.sr_mem) {
+        sr_mem_restore(&snapshot);
+    }
+
+    return cl_session_return(session, SR_ERR_OK);
+
+cleanup:
+    if (NULL != msg_req) {
+        sr_msg_free(msg_req);
+    }
+    if (NULL != msg_resp) {
+        sr_msg_free(msg_resp);
+    }
+    if (snapshot.sr_mem) {
+        sr_mem_restore(&snapshot);
+    }
+    return cl_session_return(session, rc);
+}
+
 /**
  * @brief Subscribes for delivery of event notification specified by xpath.
  *
@@ -3702,6 +3944,94 @@ cleanup:
     return cl_session_return(session, rc);
 }
 
+int
+sr_event_notif_send_batch(sr_session_ctx_t *session, const sr_event_notif_entry_t *entries, size_t entry_cnt,
+        sr_ev_notif_flag_t opts)
+{
+    Sr__Msg *msg_req = NULL, *msg_resp = NULL;
+    Sr__EventNotifBatchReq *batch_req = NULL;
+    Sr__EventNotifReq *notif_req = NULL;
+    sr_mem_snapshot_t *snapshots = NULL;
+    time_t now = time(NULL);
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG3(session, session->conn_ctx, entries);
+
+    cl_session_clear_errors(session);
+
+    /* data of the entries may be allocated in different memory contexts, the message itself is not */
+    rc = sr_gpb_req_alloc(NULL, SR__OPERATION__EVENT_NOTIF_BATCH, session->id, &msg_req);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Cannot allocate GPB message.");
+    batch_req = msg_req->request->event_notif_batch_req;
+
+    if (entry_cnt > 0) {
+        snapshots = calloc(entry_cnt, sizeof(*snapshots));
+        CHECK_NULL_NOMEM_GOTO(snapshots, rc, cleanup);
+        batch_req->notifications = calloc(entry_cnt, sizeof(*batch_req->notifications));
+        CHECK_NULL_NOMEM_GOTO(batch_req->notifications, rc, cleanup);
+    }
+
+    for (size_t i = 0; i < entry_cnt; i++) {
+        CHECK_NULL_ARG_NORET(rc, entries[i].xpath);
+        if (SR_ERR_OK != rc) {
+            goto cleanup;
+        }
+
+        notif_req = calloc(1, sizeof(*notif_req));
+        CHECK_NULL_NOMEM_GOTO(notif_req, rc, cleanup);
+        sr__event_notif_req__init(notif_req);
+        batch_req->notifications[batch_req->n_notifications++] = notif_req;
+
+        /* set arguments */
+        notif_req->type = SR__EVENT_NOTIF_REQ__NOTIF_TYPE__REALTIME;
+        notif_req->options = opts;
+        notif_req->xpath = strdup(entries[i].xpath);
+        CHECK_NULL_NOMEM_GOTO(notif_req->xpath, rc, cleanup);
+        notif_req->timestamp = (0 != entries[i].timestamp) ? entries[i].timestamp : now;
+
+        /* set trees / values */
+        if (NULL != entries[i].trees && entries[i].tree_cnt > 0) {
+            if (NULL != entries[i].trees[0]._sr_mem) {
+                sr_mem_snapshot(entries[i].trees[0]._sr_mem, &snapshots[i]);
+            }
+            rc = sr_trees_sr_to_gpb(entries[i].trees, entries[i].tree_cnt, &notif_req->trees, &notif_req->n_trees);
+            CHECK_RC_MSG_GOTO(rc, cleanup, "Error by copying event notification trees to GPB.");
+        } else if (NULL != entries[i].values && entries[i].values_cnt > 0) {
+            if (NULL != entries[i].values[0]._sr_mem) {
+                sr_mem_snapshot(entries[i].values[0]._sr_mem, &snapshots[i]);
+            }
+            rc = sr_values_sr_to_gpb(entries[i].values, entries[i].values_cnt, &notif_req->values,
+                    &notif_req->n_values);
+            CHECK_RC_MSG_GOTO(rc, cleanup, "Error by copying event notification values to GPB.");
+        }
+    }
+
+    /* send the request and receive the response */
+    rc = cl_request_process(session, msg_req, &msg_resp, NULL, SR__OPERATION__EVENT_NOTIF_BATCH);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Error by processing of the request.");
+
+cleanup:
+    if (NULL != msg_req) {
+        /* data allocated in memory contexts are released by restoring the snapshots (the latest first) */
+        for (size_t i = batch_req->n_notifications; NULL != snapshots && i > 0; i--) {
+            if (snapshots[i - 1].sr_mem) {
+                notif_req = batch_req->notifications[i - 1];
+                notif_req->values = NULL;
+                notif_req->n_values = 0;
+                notif_req->trees = NULL;
+                notif_req->n_trees = 0;
+                sr_mem_restore(&snapshots[i - 1]);
+            }
+        }
+        sr_msg_free(msg_req);
+    }
+    if (NULL != msg_resp) {
+        sr_msg_free(msg_resp);
+    }
+    free(snapshots);
+    return cl_session_return(session, rc);
+}
+
 int
 sr_event_notif_replay(sr_session_ctx_t *session, sr_subscription_ctx_t *subscription,
         time_t start_time, time_t stop_time)
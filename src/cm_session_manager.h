@@ -101,6 +101,7 @@ typedef struct sm_connection_s {
 
     uid_t uid;                        /**< Peer's effective user ID. */
     gid_t gid;                        /**< Peer's effective group ID. */
+    bool trusted;                     /**< Peer is a trusted user (see ::ac_check_trusted_user), set by type == CM_AF_UNIX_SERVER. */
     bool close_requested;             /**< Connection close requested. */
     bool established;                 /**< Necessary checks done */
 
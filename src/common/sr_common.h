@@ -47,6 +47,9 @@
 #include "sr_logger.h"
 #include "sr_protobuf.h"
 #include "sr_mem_mgmt.h"
+#include "sr_probes.h"
+#include "sr_trace.h"
+#include "sr_lock_prof.h"
 
 /**@} common */
 
@@ -988,3 +988,30 @@ sr_bitset_disjoint(sr_bitset_t *bitset1, sr_bitset_t *bitset2, bool *disjoint)
     return SR_ERR_OK;
 }
 
+int
+sr_bitset_union(sr_bitset_t *bitset, sr_bitset_t *other)
+{
+    CHECK_NULL_ARG2(bitset, other);
+
+    for (size_t i = 0; i < UINT32_STORAGE_SIZE(MIN(bitset->bit_count, other->bit_count)); ++i) {
+        bitset->bits[i] |= other->bits[i];
+    }
+
+    return SR_ERR_OK;
+}
+
+int
+sr_bitset_contains(sr_bitset_t *bitset, sr_bitset_t *subset, bool *contains)
+{
+    CHECK_NULL_ARG3(bitset, subset, contains);
+
+    *contains = true;
+    for (size_t i = 0; i < UINT32_STORAGE_SIZE(subset->bit_count); ++i) {
+        if (subset->bits[i] & ~(i < UINT32_STORAGE_SIZE(bitset->bit_count) ? bitset->bits[i] : 0)) {
+            *contains = false;
+            break;
+        }
+    }
+
+    return SR_ERR_OK;
+}
@@ -476,6 +476,27 @@ bool sr_bitset_empty(sr_bitset_t *bitset);
  */
 int sr_bitset_disjoint(sr_bitset_t *bitset1, sr_bitset_t *bitset2, bool *disjoint);
 
+/**
+ * @brief Set all bits of the first bitset that are set in the second bitset (union of the sets).
+ *
+ * @param[in] bitset Pointer to the bitset structure to be updated.
+ * @param[in] other Pointer to the bitset structure with bits to add.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+int sr_bitset_union(sr_bitset_t *bitset, sr_bitset_t *other);
+
+/**
+ * @brief Check if all bits set in the second bitset are also set in the first one.
+ *
+ * @param[in] bitset Pointer to the bitset structure.
+ * @param[in] subset Pointer to the bitset structure tested for being a subset.
+ * @param[out] contains *true* if subset is a subset of bitset, *false* otherwise.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+int sr_bitset_contains(sr_bitset_t *bitset, sr_bitset_t *subset, bool *contains);
+
 /**@} data_structs */
 
 #endif /* SR_DATA_STRUCTS_H_ */
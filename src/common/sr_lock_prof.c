@@ -0,0 +1,304 @@
+/**
+ * @file sr_lock_prof.c
+ * @brief Sysrepo lock contention profiler - collection of lock statistics and the report.
+ *
+ * @copyright
+ * Copyright 2016 Cisco Systems, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include <pthread.h>
+
+#include "sr_common.h"
+#include "sr_lock_prof.h"
+
+/**
+ * @brief Lock held by a thread.
+ */
+typedef struct sr_lock_prof_held_s {
+    const void *lock;              /**< Pointer to the lock. */
+    sr_lock_prof_site_t *site;     /**< Site where the lock has been acquired. */
+    struct timespec acquired;      /**< Time of the acquisition. */
+} sr_lock_prof_held_t;
+
+/**
+ * @brief Profiler state of a thread.
+ */
+typedef struct sr_lock_prof_thread_s {
+    struct timespec wait_start;                      /**< Time when the thread started waiting for a lock. */
+    size_t held_cnt;                                 /**< Number of held locks. */
+    sr_lock_prof_held_t held[SR_LOCK_PROF_MAX_HELD]; /**< Held locks, the most recently acquired last. */
+} sr_lock_prof_thread_t;
+
+static sr_lock_prof_site_t *sr_lock_prof_sites = NULL;              /**< List of all registered lock sites. */
+static pthread_once_t sr_lock_prof_init_once = PTHREAD_ONCE_INIT;  /**< Used to control that ::sr_lock_prof_init is called only once. */
+static pthread_key_t sr_lock_prof_thread_key;                      /**< Key for thread-specific profiler state. */
+
+/**
+ * @brief Initializes the thread-specific key. Should be called only once.
+ */
+static void
+sr_lock_prof_init(void)
+{
+    while (pthread_key_create(&sr_lock_prof_thread_key, free) == EAGAIN);
+    pthread_setspecific(sr_lock_prof_thread_key, NULL);
+}
+
+/**
+ * @brief Returns profiler state of the calling thread, allocates it if needed.
+ */
+static sr_lock_prof_thread_t *
+sr_lock_prof_thread_get()
+{
+    sr_lock_prof_thread_t *thread = NULL;
+
+    pthread_once(&sr_lock_prof_init_once, sr_lock_prof_init);
+
+    thread = pthread_getspecific(sr_lock_prof_thread_key);
+    if (NULL == thread) {
+        thread = calloc(1, sizeof(*thread));
+        if (NULL != thread) {
+            pthread_setspecific(sr_lock_prof_thread_key, thread);
+        }
+    }
+    return thread;
+}
+
+/**
+ * @brief Returns the time elapsed since given time in microseconds.
+ */
+static uint64_t
+sr_lock_prof_elapsed(const struct timespec *since)
+{
+    struct timespec now = { 0, };
+    int64_t diff = 0;
+
+    sr_clock_get_time(CLOCK_MONOTONIC, &now);
+    diff = (int64_t)(now.tv_sec - since->tv_sec) * 1000000 + (now.tv_nsec - since->tv_nsec) / 1000;
+
+    return (diff > 0) ? (uint64_t)diff : 0;
+}
+
+/**
+ * @brief Records a value into the statistics.
+ */
+static void
+sr_lock_prof_record(uint64_t value, uint64_t *total, uint64_t *max, uint64_t *hist)
+{
+    uint64_t prev_max = 0;
+    size_t bucket = 0;
+
+    while (value >> bucket && bucket < SR_LOCK_PROF_HIST_SIZE - 1) {
+        bucket++;
+    }
+    __sync_fetch_and_add(&hist[bucket], 1);
+    __sync_fetch_and_add(total, value);
+
+    prev_max = *max;
+    while (value > prev_max && !__sync_bool_compare_and_swap(max, prev_max, value)) {
+        prev_max = *max;
+    }
+}
+
+void
+sr_lock_prof_wait_begin()
+{
+    sr_lock_prof_thread_t *thread = sr_lock_prof_thread_get();
+
+    if (NULL != thread) {
+        sr_clock_get_time(CLOCK_MONOTONIC, &thread->wait_start);
+    }
+}
+
+void
+sr_lock_prof_acquired(sr_lock_prof_site_t *site, const void *lock)
+{
+    sr_lock_prof_thread_t *thread = NULL;
+    uint64_t wait = 0;
+
+    CHECK_NULL_ARG_VOID2(site, lock);
+
+    thread = sr_lock_prof_thread_get();
+    if (NULL == thread) {
+        return;
+    }
+
+    /* register the site on its first use */
+    if (!__sync_fetch_and_or(&site->registered, 1)) {
+        do {
+            site->next = sr_lock_prof_sites;
+        } while (!__sync_bool_compare_and_swap(&sr_lock_prof_sites, site->next, site));
+    }
+
+    wait = sr_lock_prof_elapsed(&thread->wait_start);
+    __sync_fetch_and_add(&site->acq_cnt, 1);
+    if (wait >= SR_LOCK_PROF_CONTENDED_US) {
+        __sync_fetch_and_add(&site->contended_cnt, 1);
+    }
+    sr_lock_prof_record(wait, &site->wait_total, &site->wait_max, site->wait_hist);
+
+    if (SR_LOCK_PROF_MAX_HELD == thread->held_cnt) {
+        /* forget the oldest held lock */
+        memmove(&thread->held[0], &thread->held[1], (SR_LOCK_PROF_MAX_HELD - 1) * sizeof(*thread->held));
+        thread->held_cnt--;
+    }
+    thread->held[thread->held_cnt].lock = lock;
+    thread->held[thread->held_cnt].site = site;
+    sr_clock_get_time(CLOCK_MONOTONIC, &thread->held[thread->held_cnt].acquired);
+    thread->held_cnt++;
+}
+
+void
+sr_lock_prof_released(const void *lock)
+{
+    sr_lock_prof_thread_t *thread = NULL;
+    sr_lock_prof_site_t *site = NULL;
+    size_t i = 0;
+
+    CHECK_NULL_ARG_VOID(lock);
+
+    thread = sr_lock_prof_thread_get();
+    if (NULL == thread) {
+        return;
+    }
+
+    /* find the most recent acquisition of the lock */
+    for (i = thread->held_cnt; i > 0; i--) {
+        if (lock == thread->held[i - 1].lock) {
+            break;
+        }
+    }
+    if (0 == i) {
+        /* acquisition not tracked */
+        return;
+    }
+    i--;
+
+    site = thread->held[i].site;
+    sr_lock_prof_record(sr_lock_prof_elapsed(&thread->held[i].acquired), &site->hold_total, &site->hold_max, site->hold_hist);
+
+    memmove(&thread->held[i], &thread->held[i + 1], (thread->held_cnt - i - 1) * sizeof(*thread->held));
+    thread->held_cnt--;
+}
+
+/**
+ * @brief Compares two lock sites by their total wait time (descending).
+ */
+static int
+sr_lock_prof_site_cmp(const void *a, const void *b)
+{
+    const sr_lock_prof_site_t *site_a = *(const sr_lock_prof_site_t **)a;
+    const sr_lock_prof_site_t *site_b = *(const sr_lock_prof_site_t **)b;
+
+    if (site_a->wait_total == site_b->wait_total) {
+        return 0;
+    }
+    return (site_a->wait_total < site_b->wait_total) ? 1 : -1;
+}
+
+/**
+ * @brief Prints non-empty buckets of a histogram.
+ */
+static void
+sr_lock_prof_hist_print(FILE *stream, const char *label, const uint64_t *hist)
+{
+    fprintf(stream, "    %s:", label);
+    for (size_t i = 0; i < SR_LOCK_PROF_HIST_SIZE; i++) {
+        if (0 == hist[i]) {
+            continue;
+        }
+        if (0 == i) {
+            fprintf(stream, " <1us=%" PRIu64, hist[i]);
+        } else if (SR_LOCK_PROF_HIST_SIZE - 1 == i) {
+            fprintf(stream, " >=%" PRIu64 "us=%" PRIu64, (uint64_t)1 << (i - 1), hist[i]);
+        } else {
+            fprintf(stream, " <%" PRIu64 "us=%" PRIu64, (uint64_t)1 << i, hist[i]);
+        }
+    }
+    fprintf(stream, "\n");
+}
+
+void
+sr_lock_prof_report(FILE *stream)
+{
+    sr_lock_prof_site_t *site = NULL, **sites = NULL;
+    size_t site_cnt = 0, i = 0;
+
+    CHECK_NULL_ARG_VOID(stream);
+
+    for (site = sr_lock_prof_sites; NULL != site; site = site->next) {
+        site_cnt++;
+    }
+    sites = calloc(site_cnt, sizeof(*sites));
+    if (0 != site_cnt && NULL == sites) {
+        SR_LOG_ERR_MSG("Unable to allocate memory for the lock profile report.");
+        return;
+    }
+    for (site = sr_lock_prof_sites; NULL != site && i < site_cnt; site = site->next) {
+        sites[i++] = site;
+    }
+    qsort(sites, site_cnt, sizeof(*sites), sr_lock_prof_site_cmp);
+
+    fprintf(stream, "Sysrepo lock contention profile (pid %d, %zu lock sites)\n\n", (int)getpid(), site_cnt);
+    fprintf(stream, "%-24s %-40s %12s %12s %14s %12s %14s %12s\n", "lock", "site", "acquired", "contended",
+            "wait-total-us", "wait-max-us", "hold-total-us", "hold-max-us");
+    for (i = 0; i < site_cnt; i++) {
+        char location[PATH_MAX] = { 0, };
+        const char *file = strrchr(sites[i]->file, '/');
+        snprintf(location, PATH_MAX, "%s:%d", (NULL != file ? file + 1 : sites[i]->file), sites[i]->line);
+        fprintf(stream, "%-24s %-40s %12" PRIu64 " %12" PRIu64 " %14" PRIu64 " %12" PRIu64 " %14" PRIu64 " %12" PRIu64 "\n",
+                sites[i]->name, location, sites[i]->acq_cnt, sites[i]->contended_cnt,
+                sites[i]->wait_total, sites[i]->wait_max, sites[i]->hold_total, sites[i]->hold_max);
+    }
+
+    fprintf(stream, "\nHistograms:\n");
+    for (i = 0; i < site_cnt; i++) {
+        fprintf(stream, "  %s (%s:%d)\n", sites[i]->name, sites[i]->file, sites[i]->line);
+        sr_lock_prof_hist_print(stream, "wait", sites[i]->wait_hist);
+        sr_lock_prof_hist_print(stream, "hold", sites[i]->hold_hist);
+    }
+
+    free(sites);
+}
+
+void
+sr_lock_prof_dump()
+{
+    char filename[PATH_MAX] = { 0, };
+    const char *env = getenv(SR_LOCK_PROF_FILE_ENV);
+    FILE *file = NULL;
+
+    if (NULL != env && '\0' != env[0]) {
+        snprintf(filename, PATH_MAX, "%s", env);
+    } else {
+        snprintf(filename, PATH_MAX, "%s-%d.txt", SR_LOCK_PROF_DEFAULT_FILE, (int)getpid());
+    }
+
+    file = fopen(filename, "w");
+    if (NULL == file) {
+        SR_LOG_ERR("Unable to open lock profile file '%s': %s.", filename, sr_strerror_safe(errno));
+        return;
+    }
+    sr_lock_prof_report(file);
+    fclose(file);
+
+    SR_LOG_INF("Lock contention profile written into '%s'.", filename);
+}
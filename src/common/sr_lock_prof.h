@@ -0,0 +1,180 @@
+/**
+ * @file sr_lock_prof.h
+ * @brief Sysrepo lock contention profiler API.
+ *
+ * Profiling is compiled in only if ENABLE_LOCK_PROFILING is defined. Each place where a profiled
+ * lock is acquired represents a lock site. For each site the profiler counts the acquisitions and keeps
+ * histograms of the time spent waiting for the lock and of the time the lock has been held. Hold time
+ * is measured until the lock is released with one of the profiled unlock macros by the same thread.
+ * The report can be written into a file using ::sr_lock_prof_dump.
+ *
+ * With profiling disabled, the macros expand to plain pthread calls.
+ *
+ * @copyright
+ * Copyright 2016 Cisco Systems, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SR_LOCK_PROF_H_
+#define SR_LOCK_PROF_H_
+
+#include <stdio.h>
+#include <stdint.h>
+#include <pthread.h>
+
+/**
+ * @defgroup lock_prof Lock Contention Profiler
+ * @ingroup common
+ * @{
+ */
+
+#define SR_LOCK_PROF_FILE_ENV "SYSREPO_LOCK_PROFILE"  /**< Environment variable with the path of the report file. */
+#define SR_LOCK_PROF_DEFAULT_FILE "/tmp/sysrepo-lock-profile"  /**< Default report file prefix (PID is appended). */
+#define SR_LOCK_PROF_HIST_SIZE 24        /**< Number of histogram buckets (bucket i > 0 covers [2^(i-1), 2^i) microseconds). */
+#define SR_LOCK_PROF_MAX_HELD 32         /**< Maximum number of profiled locks tracked as held by one thread. */
+#define SR_LOCK_PROF_CONTENDED_US 2      /**< Wait time (in microseconds) from which an acquisition counts as contended. */
+
+/**
+ * @brief Statistics of a lock site.
+ */
+typedef struct sr_lock_prof_site_s {
+    const char *name;                /**< Name of the lock. */
+    const char *file;                /**< Source file of the lock site. */
+    int line;                        /**< Source line of the lock site. */
+    int registered;                  /**< Set once the site has been added into the list of sites. */
+    uint64_t acq_cnt;                /**< Number of acquisitions. */
+    uint64_t contended_cnt;          /**< Number of acquisitions that had to wait. */
+    uint64_t wait_total;             /**< Total wait time (in microseconds). */
+    uint64_t wait_max;               /**< Maximal wait time (in microseconds). */
+    uint64_t hold_total;             /**< Total hold time (in microseconds). */
+    uint64_t hold_max;               /**< Maximal hold time (in microseconds). */
+    uint64_t wait_hist[SR_LOCK_PROF_HIST_SIZE];  /**< Histogram of wait times. */
+    uint64_t hold_hist[SR_LOCK_PROF_HIST_SIZE];  /**< Histogram of hold times. */
+    struct sr_lock_prof_site_s *next;            /**< Next site in the list of sites. */
+} sr_lock_prof_site_t;
+
+/**
+ * @brief Marks the start of waiting for a lock by the calling thread.
+ */
+void sr_lock_prof_wait_begin();
+
+/**
+ * @brief Records acquisition of a lock by the calling thread.
+ *
+ * @param [in] site Lock site where the lock has been acquired.
+ * @param [in] lock Pointer to the acquired lock.
+ */
+void sr_lock_prof_acquired(sr_lock_prof_site_t *site, const void *lock);
+
+/**
+ * @brief Records release of a lock by the calling thread.
+ *
+ * @param [in] lock Pointer to the released lock.
+ */
+void sr_lock_prof_released(const void *lock);
+
+/**
+ * @brief Prints the report of all lock sites, ordered by the total wait time.
+ *
+ * @param [in] stream Stream where the report should be printed.
+ */
+void sr_lock_prof_report(FILE *stream);
+
+/**
+ * @brief Writes the report into the file specified by SR_LOCK_PROF_FILE_ENV
+ * environment variable (or into the default file).
+ */
+void sr_lock_prof_dump();
+
+#ifdef ENABLE_LOCK_PROFILING
+    #define SR_LOCK_PROF_WAIT(LOCK) \
+        sr_lock_prof_wait_begin()
+    #define SR_LOCK_PROF_ACQUIRED(LOCK, NAME) \
+        do { \
+            static sr_lock_prof_site_t lock_site = { .name = NAME, .file = __FILE__, .line = __LINE__, }; \
+            sr_lock_prof_acquired(&lock_site, LOCK); \
+        } while(0)
+    #define SR_LOCK_PROF_RELEASED(LOCK) \
+        sr_lock_prof_released(LOCK)
+#else
+    #define SR_LOCK_PROF_WAIT(LOCK) \
+        do { (void) sizeof(LOCK); } while(0)
+    #define SR_LOCK_PROF_ACQUIRED(LOCK, NAME) \
+        do { (void) sizeof(LOCK); } while(0)
+    #define SR_LOCK_PROF_RELEASED(LOCK) \
+        do { (void) sizeof(LOCK); } while(0)
+#endif
+
+/**
+ * @brief Profiled pthread_mutex_lock.
+ */
+#define SR_MUTEX_LOCK(MUTEX, NAME) \
+    do { \
+        SR_LOCK_PROF_WAIT(MUTEX); \
+        pthread_mutex_lock(MUTEX); \
+        SR_LOCK_PROF_ACQUIRED(MUTEX, NAME); \
+    } while(0)
+
+/**
+ * @brief Profiled pthread_mutex_unlock.
+ */
+#define SR_MUTEX_UNLOCK(MUTEX) \
+    do { \
+        SR_LOCK_PROF_RELEASED(MUTEX); \
+        pthread_mutex_unlock(MUTEX); \
+    } while(0)
+
+/**
+ * @brief Profiled pthread_cond_wait. The mutex is reported as released for the time of waiting.
+ */
+#define SR_COND_WAIT(COND, MUTEX, NAME) \
+    do { \
+        SR_LOCK_PROF_RELEASED(MUTEX); \
+        pthread_cond_wait(COND, MUTEX); \
+        SR_LOCK_PROF_WAIT(MUTEX); \
+        SR_LOCK_PROF_ACQUIRED(MUTEX, NAME); \
+    } while(0)
+
+/**
+ * @brief Profiled pthread_rwlock_rdlock.
+ */
+#define SR_RWLOCK_RDLOCK(RWLOCK, NAME) \
+    do { \
+        SR_LOCK_PROF_WAIT(RWLOCK); \
+        pthread_rwlock_rdlock(RWLOCK); \
+        SR_LOCK_PROF_ACQUIRED(RWLOCK, NAME); \
+    } while(0)
+
+/**
+ * @brief Profiled pthread_rwlock_wrlock.
+ */
+#define SR_RWLOCK_WRLOCK(RWLOCK, NAME) \
+    do { \
+        SR_LOCK_PROF_WAIT(RWLOCK); \
+        pthread_rwlock_wrlock(RWLOCK); \
+        SR_LOCK_PROF_ACQUIRED(RWLOCK, NAME); \
+    } while(0)
+
+/**
+ * @brief Profiled pthread_rwlock_unlock.
+ */
+#define SR_RWLOCK_UNLOCK(RWLOCK) \
+    do { \
+        SR_LOCK_PROF_RELEASED(RWLOCK); \
+        pthread_rwlock_unlock(RWLOCK); \
+    } while(0)
+
+/**@} lock_prof */
+
+#endif /* SR_LOCK_PROF_H_ */
@@ -48,6 +48,7 @@ typedef struct fctx_pool_s {
 } fctx_pool_t;
 
 static pthread_key_t fctx_key; /**< Key to the pool of free memory contexts. */
+static size_t sr_mem_peak_usage = 0; /**< Maximal peak usage observed across all memory contexts. */
 static pthread_once_t fctx_init_once = PTHREAD_ONCE_INIT; /**< For initialization of the key. */
 
 /* Forward declaration. */
@@ -330,6 +331,12 @@ sr_mem_free(sr_mem_ctx_t *sr_mem)
     if (NULL == fctx_pool) {
         SR_LOG_WRN_MSG("Failed to get pool of free memory contexts.");
     } else {
+        /* update the global maximum of the peak memory usage */
+        size_t global_peak = sr_mem_peak_usage;
+        while (sr_mem->peak > global_peak &&
+                !__sync_bool_compare_and_swap(&sr_mem_peak_usage, global_peak, sr_mem->peak)) {
+            global_peak = sr_mem_peak_usage;
+        }
         /* store the information about the peak memory usage into a fixed-size queue */
         fctx_pool->peak_history[fctx_pool->peak_history_head++] = sr_mem->peak;
         fctx_pool->peak_history_head %= MEM_PEAK_USAGE_HISTORY_LENGTH;
@@ -387,6 +394,12 @@ sr_protobuf_free(void *sr_mem, void *ptr)
     /* else do nothing */
 }
 
+size_t
+sr_mem_get_peak_usage()
+{
+    return __sync_fetch_and_add(&sr_mem_peak_usage, 0);
+}
+
 ProtobufCAllocator
 sr_get_protobuf_allocator(sr_mem_ctx_t *sr_mem)
 {
@@ -107,6 +107,14 @@ void *sr_calloc(sr_mem_ctx_t *sr_mem, size_t nmemb, size_t size);
  */
 void sr_mem_free(sr_mem_ctx_t *sr_mem);
 
+/**
+ * @brief Returns the maximal peak usage of a Sysrepo memory context observed so far
+ * (updated whenever a memory context is deallocated).
+ *
+ * @return Peak memory usage in bytes.
+ */
+size_t sr_mem_get_peak_usage();
+
 /**
  * @brief Get allocator for the protobuf-c library that will use specified Sysrepo
  * memory context for all the allocation.
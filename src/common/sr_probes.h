@@ -0,0 +1,96 @@
+/**
+ * @file sr_probes.h
+ * @brief Sysrepo USDT (user-level statically defined tracing) probes.
+ *
+ * Probes are compiled in only if ENABLE_USDT_PROBES is defined, in which case
+ * they are provided by <sys/sdt.h> (systemtap) under the provider name "sysrepo"
+ * and can be attached to with bpftrace, perf or systemtap. Otherwise the probe
+ * macros expand to empty statements and their arguments are not evaluated.
+ *
+ * List of probes (provider "sysrepo"):
+ *  - request-receive (session_id, operation)    - request received by Connection Manager
+ *  - request-dispatch (session_id, operation)   - request dispatched by Request Processor
+ *  - request-complete (session_id, operation, rc) - request processed by Request Processor
+ *  - commit-state (commit_id, state)            - transition of the commit state machine
+ *  - data-load-begin (module_name, file_name)   - parsing of a data file started
+ *  - data-load-end (module_name, success)       - parsing of a data file finished
+ *  - lock-wait-begin (lock_name, lock_ptr)      - waiting for a lock started
+ *  - lock-wait-end (lock_name, lock_ptr)        - lock has been acquired
+ *  - notif-send (dst_address, dst_id, type)     - notification sent to a subscriber
+ *  - notif-ack (commit_id, event, result)       - notification acknowledged by a subscriber
+ *
+ * @copyright
+ * Copyright 2016 Cisco Systems, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SR_PROBES_H_
+#define SR_PROBES_H_
+
+#ifdef ENABLE_USDT_PROBES
+
+#include <sys/sdt.h>
+
+#define SR_PROBE0(NAME) \
+    DTRACE_PROBE(sysrepo, NAME)
+
+#define SR_PROBE1(NAME, ARG1) \
+    DTRACE_PROBE1(sysrepo, NAME, ARG1)
+
+#define SR_PROBE2(NAME, ARG1, ARG2) \
+    DTRACE_PROBE2(sysrepo, NAME, ARG1, ARG2)
+
+#define SR_PROBE3(NAME, ARG1, ARG2, ARG3) \
+    DTRACE_PROBE3(sysrepo, NAME, ARG1, ARG2, ARG3)
+
+#else /* ENABLE_USDT_PROBES */
+
+/* sizeof does not evaluate its operand, it only marks the arguments as used */
+#define SR_PROBE0(NAME) \
+    do { } while(0)
+
+#define SR_PROBE1(NAME, ARG1) \
+    do { (void) sizeof(ARG1); } while(0)
+
+#define SR_PROBE2(NAME, ARG1, ARG2) \
+    do { (void) sizeof(ARG1); (void) sizeof(ARG2); } while(0)
+
+#define SR_PROBE3(NAME, ARG1, ARG2, ARG3) \
+    do { (void) sizeof(ARG1); (void) sizeof(ARG2); (void) sizeof(ARG3); } while(0)
+
+#endif /* ENABLE_USDT_PROBES */
+
+/**
+ * @brief Acquires a read lock on a rwlock, firing lock-wait probes around the wait.
+ * The acquisition is also recorded by the lock profiler (see sr_lock_prof.h).
+ */
+#define SR_PROBED_RWLOCK_RDLOCK(LOCK, NAME) \
+    do { \
+        SR_PROBE2(lock__wait__begin, NAME, (void *)(LOCK)); \
+        SR_RWLOCK_RDLOCK(LOCK, NAME); \
+        SR_PROBE2(lock__wait__end, NAME, (void *)(LOCK)); \
+    } while(0)
+
+/**
+ * @brief Acquires a write lock on a rwlock, firing lock-wait probes around the wait.
+ * The acquisition is also recorded by the lock profiler (see sr_lock_prof.h).
+ */
+#define SR_PROBED_RWLOCK_WRLOCK(LOCK, NAME) \
+    do { \
+        SR_PROBE2(lock__wait__begin, NAME, (void *)(LOCK)); \
+        SR_RWLOCK_WRLOCK(LOCK, NAME); \
+        SR_PROBE2(lock__wait__end, NAME, (void *)(LOCK)); \
+    } while(0)
+
+#endif /* SR_PROBES_H_ */
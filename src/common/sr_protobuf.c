@@ -103,16 +103,22 @@ sr_gpb_operation_name(Sr__Operation operation)
         return "event-notification";
     case SR__OPERATION__EVENT_NOTIF_REPLAY:
         return "event-notification-replay";
+    case SR__OPERATION__DP_CACHE_INVALIDATE:
+        return "dp-cache-invalidate";
+    case SR__OPERATION__OPER_DATA_PUSH:
+        return "oper-data-push";
+    case SR__OPERATION__EVENT_NOTIF_BATCH:
+        return "event-notification-batch";
     case SR__OPERATION__OPER_DATA_TIMEOUT:
         return "oper-data-timeout";
     case SR__OPERATION__INTERNAL_STATE_DATA:
         return "internal-state-data";
-    case SR__OPERATION__NOTIF_STORE_CLEANUP:
-        return "notif-store-cleanup";
     case SR__OPERATION__DELAYED_MSG:
         return "delayed-msg";
     case SR__OPERATION__NACM_RELOAD:
         return "nacm-reload";
+    case SR__OPERATION__NOTIF_REPLAY_STEP:
+        return "notif-replay-step";
     case _SR__OPERATION_IS_INT_SIZE:
         return "unknown";
     }
@@ -361,6 +367,24 @@ sr_gpb_req_alloc(sr_mem_ctx_t *sr_mem, const Sr__Operation operation, const uint
             sr__event_notif_replay_req__init((Sr__EventNotifReplayReq*)sub_msg);
             req->event_notif_replay_req = (Sr__EventNotifReplayReq*)sub_msg;
             break;
+        case SR__OPERATION__DP_CACHE_INVALIDATE:
+            sub_msg = sr_calloc(sr_mem, 1, sizeof(Sr__DpCacheInvalidateReq));
+            CHECK_NULL_NOMEM_GOTO(sub_msg, rc, error);
+            sr__dp_cache_invalidate_req__init((Sr__DpCacheInvalidateReq*)sub_msg);
+            req->dp_cache_invalidate_req = (Sr__DpCacheInvalidateReq*)sub_msg;
+            break;
+        case SR__OPERATION__OPER_DATA_PUSH:
+            sub_msg = sr_calloc(sr_mem, 1, sizeof(Sr__OperDataPushReq));
+            CHECK_NULL_NOMEM_GOTO(sub_msg, rc, error);
+            sr__oper_data_push_req__init((Sr__OperDataPushReq*)sub_msg);
+            req->oper_data_push_req = (Sr__OperDataPushReq*)sub_msg;
+            break;
+        case SR__OPERATION__EVENT_NOTIF_BATCH:
+            sub_msg = sr_calloc(sr_mem, 1, sizeof(Sr__EventNotifBatchReq));
+            CHECK_NULL_NOMEM_GOTO(sub_msg, rc, error);
+            sr__event_notif_batch_req__init((Sr__EventNotifBatchReq*)sub_msg);
+            req->event_notif_batch_req = (Sr__EventNotifBatchReq*)sub_msg;
+            break;
         default:
             rc = SR_ERR_UNSUPPORTED;
             goto error;
@@ -629,6 +653,24 @@ sr_gpb_resp_alloc(sr_mem_ctx_t *sr_mem, const Sr__Operation operation, const uin
             sr__event_notif_replay_resp__init((Sr__EventNotifReplayResp*)sub_msg);
             resp->event_notif_replay_resp = (Sr__EventNotifReplayResp*)sub_msg;
             break;
+        case SR__OPERATION__DP_CACHE_INVALIDATE:
+            sub_msg = sr_calloc(sr_mem, 1, sizeof(Sr__DpCacheInvalidateResp));
+            CHECK_NULL_NOMEM_GOTO(sub_msg, rc, error);
+            sr__dp_cache_invalidate_resp__init((Sr__DpCacheInvalidateResp*)sub_msg);
+            resp->dp_cache_invalidate_resp = (Sr__DpCacheInvalidateResp*)sub_msg;
+            break;
+        case SR__OPERATION__OPER_DATA_PUSH:
+            sub_msg = sr_calloc(sr_mem, 1, sizeof(Sr__OperDataPushResp));
+            CHECK_NULL_NOMEM_GOTO(sub_msg, rc, error);
+            sr__oper_data_push_resp__init((Sr__OperDataPushResp*)sub_msg);
+            resp->oper_data_push_resp = (Sr__OperDataPushResp*)sub_msg;
+            break;
+        case SR__OPERATION__EVENT_NOTIF_BATCH:
+            sub_msg = sr_calloc(sr_mem, 1, sizeof(Sr__EventNotifBatchResp));
+            CHECK_NULL_NOMEM_GOTO(sub_msg, rc, error);
+            sr__event_notif_batch_resp__init((Sr__EventNotifBatchResp*)sub_msg);
+            resp->event_notif_batch_resp = (Sr__EventNotifBatchResp*)sub_msg;
+            break;
         default:
             rc = SR_ERR_UNSUPPORTED;
             goto error;
@@ -848,12 +890,6 @@ sr_gpb_internal_req_alloc(sr_mem_ctx_t *sr_mem, const Sr__Operation operation, S
             sr__internal_state_data_req__init((Sr__InternalStateDataReq*)sub_msg);
             req->internal_state_data_req = (Sr__InternalStateDataReq*) sub_msg;
             break;
-        case SR__OPERATION__NOTIF_STORE_CLEANUP:
-            sub_msg = sr_calloc(sr_mem, 1, sizeof(Sr__NotifStoreCleanupReq));
-            CHECK_NULL_NOMEM_GOTO(sub_msg, rc, error);
-            sr__notif_store_cleanup_req__init((Sr__NotifStoreCleanupReq*)sub_msg);
-            req->notif_store_cleanup_req = (Sr__NotifStoreCleanupReq*) sub_msg;
-            break;
         case SR__OPERATION__DELAYED_MSG:
             sub_msg = sr_calloc(sr_mem, 1, sizeof(Sr__DelayedMsgReq));
             CHECK_NULL_NOMEM_GOTO(sub_msg, rc, error);
@@ -866,6 +902,16 @@ sr_gpb_internal_req_alloc(sr_mem_ctx_t *sr_mem, const Sr__Operation operation, S
             sr__nacm_reload_req__init((Sr__NacmReloadReq*)sub_msg);
             req->nacm_reload_req = (Sr__NacmReloadReq*)sub_msg;
             break;
+        case SR__OPERATION__NOTIF_REPLAY_STEP:
+            sub_msg = sr_calloc(sr_mem, 1, sizeof(Sr__NotifReplayStepReq));
+            CHECK_NULL_NOMEM_GOTO(sub_msg, rc, error);
+            sr__notif_replay_step_req__init((Sr__NotifReplayStepReq*)sub_msg);
+            req->notif_replay_step_req = (Sr__NotifReplayStepReq*)sub_msg;
+            sub_msg = sr_calloc(sr_mem, 1, sizeof(Sr__EventNotifReplayReq));
+            CHECK_NULL_NOMEM_GOTO(sub_msg, rc, error);
+            sr__event_notif_replay_req__init((Sr__EventNotifReplayReq*)sub_msg);
+            req->notif_replay_step_req->replay_req = (Sr__EventNotifReplayReq*)sub_msg;
+            break;
 
         default:
             break;
@@ -1009,6 +1055,15 @@ sr_gpb_msg_validate(const Sr__Msg *msg, const Sr__Msg__MsgType type, const Sr__O
             case SR__OPERATION__EVENT_NOTIF_REPLAY:
                 CHECK_NULL_RETURN(msg->request->event_notif_replay_req, SR_ERR_MALFORMED_MSG);
                 break;
+            case SR__OPERATION__DP_CACHE_INVALIDATE:
+                CHECK_NULL_RETURN(msg->request->dp_cache_invalidate_req, SR_ERR_MALFORMED_MSG);
+                break;
+            case SR__OPERATION__OPER_DATA_PUSH:
+                CHECK_NULL_RETURN(msg->request->oper_data_push_req, SR_ERR_MALFORMED_MSG);
+                break;
+            case SR__OPERATION__EVENT_NOTIF_BATCH:
+                CHECK_NULL_RETURN(msg->request->event_notif_batch_req, SR_ERR_MALFORMED_MSG);
+                break;
             default:
                 return SR_ERR_MALFORMED_MSG;
         }
@@ -1125,6 +1180,15 @@ sr_gpb_msg_validate(const Sr__Msg *msg, const Sr__Msg__MsgType type, const Sr__O
             case SR__OPERATION__EVENT_NOTIF_REPLAY:
                 CHECK_NULL_RETURN(msg->response->event_notif_replay_resp, SR_ERR_MALFORMED_MSG);
                 break;
+            case SR__OPERATION__DP_CACHE_INVALIDATE:
+                CHECK_NULL_RETURN(msg->response->dp_cache_invalidate_resp, SR_ERR_MALFORMED_MSG);
+                break;
+            case SR__OPERATION__OPER_DATA_PUSH:
+                CHECK_NULL_RETURN(msg->response->oper_data_push_resp, SR_ERR_MALFORMED_MSG);
+                break;
+            case SR__OPERATION__EVENT_NOTIF_BATCH:
+                CHECK_NULL_RETURN(msg->response->event_notif_batch_resp, SR_ERR_MALFORMED_MSG);
+                break;
             default:
                 return SR_ERR_MALFORMED_MSG;
         }
@@ -2812,3 +2876,188 @@ sr_gpb_fill_errors(sr_error_info_t *sr_errors, size_t sr_error_cnt, sr_mem_ctx_t
 
     return SR_ERR_OK;
 }
+
+/**
+ * @brief Encodes the value as a varint into the buffer (if not NULL), returns the length of the encoding.
+ */
+static size_t
+sr_gpb_varint_pack(uint64_t value, uint8_t *out)
+{
+    size_t len = 0;
+
+    do {
+        if (NULL != out) {
+            out[len] = (value & 0x7f) | (value > 0x7f ? 0x80 : 0);
+        }
+        value >>= 7;
+        len++;
+    } while (0 != value);
+
+    return len;
+}
+
+/**
+ * @brief Encodes GPB values or trees (selected by the API variant) as the fields of the shared payload.
+ */
+static int
+sr_gpb_shared_payload_pack(sr_api_variant_t api_variant, ProtobufCMessage **items, size_t item_cnt,
+        sr_gpb_shared_payload_t *payload)
+{
+    const ProtobufCFieldDescriptor *field = NULL;
+    size_t *item_sizes = NULL, size = 0, pos = 0;
+    int rc = SR_ERR_OK;
+
+    field = protobuf_c_message_descriptor_get_field_by_name(&sr__event_notif_req__descriptor,
+            (SR_API_TREES == api_variant) ? "trees" : "values");
+    CHECK_NULL_ARG(field);
+
+    if (0 == item_cnt) {
+        return SR_ERR_OK;
+    }
+
+    payload->fields = calloc(item_cnt, sizeof(*payload->fields));
+    CHECK_NULL_NOMEM_GOTO(payload->fields, rc, cleanup);
+    item_sizes = calloc(item_cnt, sizeof(*item_sizes));
+    CHECK_NULL_NOMEM_GOTO(item_sizes, rc, cleanup);
+
+    /* each item is encoded as a length-delimited field */
+    for (size_t i = 0; i < item_cnt; i++) {
+        item_sizes[i] = protobuf_c_message_get_packed_size(items[i]);
+        payload->fields[i].tag = field->id;
+        payload->fields[i].wire_type = PROTOBUF_C_WIRE_TYPE_LENGTH_PREFIXED;
+        payload->fields[i].len = sr_gpb_varint_pack(item_sizes[i], NULL) + item_sizes[i];
+        size += payload->fields[i].len;
+    }
+
+    payload->data = malloc(size);
+    CHECK_NULL_NOMEM_GOTO(payload->data, rc, cleanup);
+
+    for (size_t i = 0; i < item_cnt; i++) {
+        payload->fields[i].data = payload->data + pos;
+        pos += sr_gpb_varint_pack(item_sizes[i], payload->data + pos);
+        pos += protobuf_c_message_pack(items[i], payload->data + pos);
+    }
+    payload->field_cnt = item_cnt;
+
+cleanup:
+    free(item_sizes);
+    return rc;
+}
+
+int
+sr_gpb_shared_payload_create(sr_api_variant_t api_variant, const sr_val_t *sr_values, size_t sr_value_cnt,
+        const sr_node_t *sr_trees, size_t sr_tree_cnt, sr_gpb_shared_payload_t **payload_p)
+{
+    sr_gpb_shared_payload_t *payload = NULL;
+    Sr__Value **gpb_values = NULL;
+    Sr__Node **gpb_trees = NULL;
+    ProtobufCMessage **items = NULL;
+    size_t item_cnt = 0;
+    sr_mem_ctx_t *sr_mem = NULL;
+    sr_mem_snapshot_t snapshot = { 0, };
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG(payload_p);
+
+    payload = calloc(1, sizeof(*payload));
+    CHECK_NULL_NOMEM_RETURN(payload);
+    payload->refcount = 1;
+
+    /* convert the data into GPB (once for all the messages) */
+    if (SR_API_VALUES == api_variant) {
+        sr_mem = (NULL != sr_values && sr_value_cnt > 0) ? sr_values[0]._sr_mem : NULL;
+        if (NULL != sr_mem) {
+            sr_mem_snapshot(sr_mem, &snapshot);
+        }
+        rc = sr_values_sr_to_gpb(sr_values, sr_value_cnt, &gpb_values, &item_cnt);
+        items = (ProtobufCMessage **) gpb_values;
+    } else {
+        sr_mem = (NULL != sr_trees && sr_tree_cnt > 0) ? sr_trees[0]._sr_mem : NULL;
+        if (NULL != sr_mem) {
+            sr_mem_snapshot(sr_mem, &snapshot);
+        }
+        rc = sr_trees_sr_to_gpb(sr_trees, sr_tree_cnt, &gpb_trees, &item_cnt);
+        items = (ProtobufCMessage **) gpb_trees;
+    }
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to convert the shared payload to GPB.");
+
+    rc = sr_gpb_shared_payload_pack(api_variant, items, item_cnt, payload);
+
+cleanup:
+    if (NULL != sr_mem) {
+        sr_mem_restore(&snapshot);
+    } else if (NULL != items) {
+        for (size_t i = 0; i < item_cnt; i++) {
+            protobuf_c_message_free_unpacked(items[i], NULL);
+        }
+        free(items);
+    }
+
+    if (SR_ERR_OK != rc) {
+        sr_gpb_shared_payload_release(payload);
+        return rc;
+    }
+
+    *payload_p = payload;
+    return SR_ERR_OK;
+}
+
+int
+sr_gpb_shared_payload_create_gpb(sr_api_variant_t api_variant, Sr__Value **gpb_values, size_t gpb_value_cnt,
+        Sr__Node **gpb_trees, size_t gpb_tree_cnt, sr_gpb_shared_payload_t **payload_p)
+{
+    sr_gpb_shared_payload_t *payload = NULL;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG(payload_p);
+
+    payload = calloc(1, sizeof(*payload));
+    CHECK_NULL_NOMEM_RETURN(payload);
+    payload->refcount = 1;
+
+    if (SR_API_VALUES == api_variant) {
+        rc = sr_gpb_shared_payload_pack(api_variant, (ProtobufCMessage **) gpb_values, gpb_value_cnt, payload);
+    } else {
+        rc = sr_gpb_shared_payload_pack(api_variant, (ProtobufCMessage **) gpb_trees, gpb_tree_cnt, payload);
+    }
+    if (SR_ERR_OK != rc) {
+        sr_gpb_shared_payload_release(payload);
+        return rc;
+    }
+
+    *payload_p = payload;
+    return SR_ERR_OK;
+}
+
+void
+sr_gpb_shared_payload_release(sr_gpb_shared_payload_t *payload)
+{
+    if (NULL != payload && 0 == __sync_sub_and_fetch(&payload->refcount, 1)) {
+        free(payload->fields);
+        free(payload->data);
+        free(payload);
+    }
+}
+
+void
+sr_gpb_event_notif_attach_payload(Sr__EventNotifReq *event_notif_req, sr_gpb_shared_payload_t *payload)
+{
+    if (NULL == event_notif_req || NULL == payload) {
+        return;
+    }
+
+    event_notif_req->base.n_unknown_fields = payload->field_cnt;
+    event_notif_req->base.unknown_fields = payload->fields;
+}
+
+void
+sr_gpb_event_notif_detach_payload(Sr__EventNotifReq *event_notif_req, sr_gpb_shared_payload_t *payload)
+{
+    if (NULL == event_notif_req || NULL == payload || event_notif_req->base.unknown_fields != payload->fields) {
+        return;
+    }
+
+    /* the fields are owned by the payload, not by the message */
+    event_notif_req->base.n_unknown_fields = 0;
+    event_notif_req->base.unknown_fields = NULL;
+}
@@ -450,6 +450,77 @@ int sr_gpb_fill_error(const char *error_message, const char *error_path, sr_mem_
 int sr_gpb_fill_errors(sr_error_info_t *sr_errors, size_t sr_error_cnt, sr_mem_ctx_t *sr_mem, Sr__Error ***gpb_errors,
         size_t *gpb_error_cnt);
 
+/**
+ * @brief Values or trees encoded once and shared by multiple event notification messages with the same content.
+ *
+ * The encoded fields are attached to the messages as unknown fields, so that they are written by the packing
+ * of each message without being converted or encoded again.
+ */
+typedef struct sr_gpb_shared_payload_s {
+    uint32_t refcount;                          /**< Number of references held on the payload (updated atomically). */
+    uint8_t *data;                              /**< Encoded fields. */
+    size_t field_cnt;                           /**< Number of the encoded fields. */
+    ProtobufCMessageUnknownField *fields;       /**< Encoded fields as unknown fields pointing into the data. */
+} sr_gpb_shared_payload_t;
+
+/**
+ * @brief Encodes values or trees into a payload which can be shared by multiple event notification messages.
+ * The returned payload holds one reference released by ::sr_gpb_shared_payload_release.
+ *
+ * @param[in] api_variant Variant of the payload (values or trees).
+ * @param[in] sr_values Array of sysrepo values (used for ::SR_API_VALUES).
+ * @param[in] sr_value_cnt Number of values.
+ * @param[in] sr_trees Array of sysrepo trees (used for ::SR_API_TREES).
+ * @param[in] sr_tree_cnt Number of trees.
+ * @param[out] payload Allocated shared payload.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+int sr_gpb_shared_payload_create(sr_api_variant_t api_variant, const sr_val_t *sr_values, size_t sr_value_cnt,
+        const sr_node_t *sr_trees, size_t sr_tree_cnt, sr_gpb_shared_payload_t **payload);
+
+/**
+ * @brief Encodes values or trees already in GPB format (e.g. received in a message) into a payload which can be shared
+ * by multiple event notification messages. The returned payload holds one reference released
+ * by ::sr_gpb_shared_payload_release.
+ *
+ * @param[in] api_variant Variant of the payload (values or trees).
+ * @param[in] gpb_values Array of GPB values (used for ::SR_API_VALUES).
+ * @param[in] gpb_value_cnt Number of values.
+ * @param[in] gpb_trees Array of GPB trees (used for ::SR_API_TREES).
+ * @param[in] gpb_tree_cnt Number of trees.
+ * @param[out] payload Allocated shared payload.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+int sr_gpb_shared_payload_create_gpb(sr_api_variant_t api_variant, Sr__Value **gpb_values, size_t gpb_value_cnt,
+        Sr__Node **gpb_trees, size_t gpb_tree_cnt, sr_gpb_shared_payload_t **payload);
+
+/**
+ * @brief Releases a reference held on the shared payload, frees the payload when the last reference is released.
+ *
+ * @param[in] payload Shared payload.
+ */
+void sr_gpb_shared_payload_release(sr_gpb_shared_payload_t *payload);
+
+/**
+ * @brief Attaches the shared payload to an event notification request (in place of its values / trees) for packing.
+ * The request does not hold a reference on the payload, the payload has to be detached by
+ * ::sr_gpb_event_notif_detach_payload before the request is freed.
+ *
+ * @param[in] event_notif_req Event notification request with no values or trees.
+ * @param[in] payload Shared payload.
+ */
+void sr_gpb_event_notif_attach_payload(Sr__EventNotifReq *event_notif_req, sr_gpb_shared_payload_t *payload);
+
+/**
+ * @brief Detaches the shared payload attached by ::sr_gpb_event_notif_attach_payload from an event notification request.
+ *
+ * @param[in] event_notif_req Event notification request.
+ * @param[in] payload Shared payload attached to the request.
+ */
+void sr_gpb_event_notif_detach_payload(Sr__EventNotifReq *event_notif_req, sr_gpb_shared_payload_t *payload);
+
 /**@} gpb_wrappers */
 
 #endif /* SR_PROTOBUF_H_ */
@@ -0,0 +1,242 @@
+/**
+ * @file sr_trace.c
+ * @brief Sysrepo end-to-end request tracing - span recording and Chrome trace format export.
+ *
+ * @copyright
+ * Copyright 2016 Cisco Systems, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#include <inttypes.h>
+#include <pthread.h>
+
+#include "sr_common.h"
+#include "sr_trace.h"
+
+/**
+ * @brief A recorded span.
+ */
+typedef struct sr_trace_event_s {
+    uint64_t trace_id;          /**< ID of the trace. */
+    const char *component;      /**< Component that recorded the span. */
+    const char *name;           /**< Name of the span. */
+    uint64_t ts;                /**< Start time (in microseconds since the Epoch). */
+    uint64_t dur;               /**< Duration (in microseconds). */
+    unsigned long tid;          /**< Thread that recorded the span. */
+} sr_trace_event_t;
+
+/**
+ * @brief Context of the tracing in this process.
+ */
+typedef struct sr_trace_ctx_s {
+    char *dir;                  /**< Directory where the trace files are written, NULL if tracing is not active. */
+    sr_trace_event_t *events;   /**< Buffered spans. */
+    size_t event_cnt;           /**< Number of buffered spans. */
+    time_t window_start;        /**< Time when the first of the buffered spans has been recorded. */
+    uint32_t id_cnt;            /**< Counter used for trace ID generation. */
+    uint32_t file_cnt;          /**< Number of trace files written by this process. */
+    pthread_mutex_t lock;       /**< Mutex guarding the context. */
+} sr_trace_ctx_t;
+
+static sr_trace_ctx_t sr_trace_ctx = { .lock = PTHREAD_MUTEX_INITIALIZER, };  /**< Tracing context. */
+static pthread_once_t sr_trace_init_once = PTHREAD_ONCE_INIT;  /**< Used to control that ::sr_trace_init is called only once. */
+static pthread_key_t sr_trace_id_key;                          /**< Key for thread-specific trace ID of the current request. */
+
+/**
+ * @brief Initializes tracing according to the environment. Should be called only once.
+ */
+static void
+sr_trace_init(void)
+{
+    const char *dir = NULL;
+
+    while (pthread_key_create(&sr_trace_id_key, free) == EAGAIN);
+    pthread_setspecific(sr_trace_id_key, NULL);
+
+#ifdef ENABLE_REQUEST_TRACING
+    dir = getenv(SR_TRACE_DIR_ENV);
+#endif
+    if (NULL != dir && '\0' != dir[0]) {
+        sr_trace_ctx.events = calloc(SR_TRACE_BUFFER_SIZE, sizeof(*sr_trace_ctx.events));
+        if (NULL != sr_trace_ctx.events) {
+            sr_trace_ctx.dir = strdup(dir);
+        }
+        if (NULL == sr_trace_ctx.dir) {
+            free(sr_trace_ctx.events);
+            sr_trace_ctx.events = NULL;
+            SR_LOG_WRN_MSG("Unable to initialize request tracing.");
+        }
+    }
+}
+
+/**
+ * @brief Writes buffered spans into a new trace file. Trace context lock is expected to be held.
+ */
+static void
+sr_trace_flush_locked()
+{
+    char filename[PATH_MAX] = { 0, };
+    FILE *file = NULL;
+    pid_t pid = getpid();
+
+    if (NULL == sr_trace_ctx.dir || 0 == sr_trace_ctx.event_cnt) {
+        return;
+    }
+
+    snprintf(filename, PATH_MAX, "%s/sysrepo-trace-%d-%lld-%" PRIu32 ".json", sr_trace_ctx.dir, (int)pid,
+            (long long)sr_trace_ctx.window_start, sr_trace_ctx.file_cnt++);
+    file = fopen(filename, "w");
+    if (NULL == file) {
+        SR_LOG_WRN("Unable to open trace file '%s': %s.", filename, sr_strerror_safe(errno));
+    } else {
+        fprintf(file, "{\"traceEvents\":[\n");
+        for (size_t i = 0; i < sr_trace_ctx.event_cnt; i++) {
+            sr_trace_event_t *ev = &sr_trace_ctx.events[i];
+            fprintf(file, "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%" PRIu64 ",\"dur\":%" PRIu64
+                    ",\"pid\":%d,\"tid\":%lu,\"args\":{\"trace_id\":\"%016" PRIx64 "\"}}%s\n",
+                    ev->name, ev->component, ev->ts, ev->dur, (int)pid, ev->tid, ev->trace_id,
+                    (i + 1 < sr_trace_ctx.event_cnt) ? "," : "");
+        }
+        fprintf(file, "],\"displayTimeUnit\":\"ms\"}\n");
+        fclose(file);
+    }
+    sr_trace_ctx.event_cnt = 0;
+}
+
+bool
+sr_trace_enabled()
+{
+    pthread_once(&sr_trace_init_once, sr_trace_init);
+    return NULL != sr_trace_ctx.dir;
+}
+
+uint64_t
+sr_trace_new_id()
+{
+    uint64_t id = 0;
+
+    if (!sr_trace_enabled()) {
+        return 0;
+    }
+
+    pthread_mutex_lock(&sr_trace_ctx.lock);
+    id = ((uint64_t)getpid() << 32) | ++sr_trace_ctx.id_cnt;
+    pthread_mutex_unlock(&sr_trace_ctx.lock);
+
+    return id;
+}
+
+void
+sr_trace_set_current(uint64_t trace_id)
+{
+    uint64_t *current = NULL;
+
+    if (!sr_trace_enabled()) {
+        return;
+    }
+
+    current = pthread_getspecific(sr_trace_id_key);
+    if (NULL == current) {
+        current = calloc(1, sizeof(*current));
+        if (NULL == current) {
+            return;
+        }
+        pthread_setspecific(sr_trace_id_key, current);
+    }
+    *current = trace_id;
+}
+
+uint64_t
+sr_trace_get_current()
+{
+    uint64_t *current = NULL;
+
+    if (!sr_trace_enabled()) {
+        return 0;
+    }
+
+    current = pthread_getspecific(sr_trace_id_key);
+    return (NULL != current) ? *current : 0;
+}
+
+void
+sr_trace_span_begin(sr_trace_span_t *span, uint64_t trace_id, const char *component, const char *name)
+{
+    CHECK_NULL_ARG_VOID(span);
+
+    span->trace_id = sr_trace_enabled() ? trace_id : 0;
+    if (0 != span->trace_id) {
+        span->component = component;
+        span->name = name;
+        sr_clock_get_time(CLOCK_REALTIME, &span->start);
+    }
+}
+
+void
+sr_trace_span_end(sr_trace_span_t *span)
+{
+    struct timespec now = { 0, };
+    sr_trace_event_t *ev = NULL;
+
+    CHECK_NULL_ARG_VOID(span);
+
+    if (0 == span->trace_id) {
+        return;
+    }
+
+    sr_clock_get_time(CLOCK_REALTIME, &now);
+
+    pthread_mutex_lock(&sr_trace_ctx.lock);
+    if (0 != sr_trace_ctx.event_cnt && (now.tv_sec - sr_trace_ctx.window_start) >= SR_TRACE_TIME_WINDOW) {
+        /* time window elapsed */
+        sr_trace_flush_locked();
+    }
+    if (0 == sr_trace_ctx.event_cnt) {
+        sr_trace_ctx.window_start = now.tv_sec;
+    }
+
+    ev = &sr_trace_ctx.events[sr_trace_ctx.event_cnt++];
+    ev->trace_id = span->trace_id;
+    ev->component = span->component;
+    ev->name = span->name;
+    ev->ts = (uint64_t)span->start.tv_sec * 1000000 + span->start.tv_nsec / 1000;
+    ev->dur = ((uint64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000) - ev->ts;
+    ev->tid = (unsigned long)pthread_self();
+
+    if (SR_TRACE_BUFFER_SIZE == sr_trace_ctx.event_cnt) {
+        /* buffer is full */
+        sr_trace_flush_locked();
+    }
+    pthread_mutex_unlock(&sr_trace_ctx.lock);
+
+    span->trace_id = 0;
+}
+
+void
+sr_trace_flush()
+{
+    if (!sr_trace_enabled()) {
+        return;
+    }
+
+    pthread_mutex_lock(&sr_trace_ctx.lock);
+    sr_trace_flush_locked();
+    pthread_mutex_unlock(&sr_trace_ctx.lock);
+}
@@ -0,0 +1,110 @@
+/**
+ * @file sr_trace.h
+ * @brief Sysrepo end-to-end request tracing API.
+ *
+ * Tracing is compiled in only if ENABLE_REQUEST_TRACING is defined and it is activated at runtime
+ * by setting the SR_TRACE_DIR_ENV environment variable to an existing directory. Each traced request
+ * gets a trace ID that travels in the Sr__Msg between the processes. Every component records spans
+ * (name, start, duration) tagged with the trace ID, the spans are buffered and periodically written
+ * into the trace directory as Chrome trace event format JSON files (loadable by chrome://tracing or Perfetto).
+ *
+ * @copyright
+ * Copyright 2016 Cisco Systems, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SR_TRACE_H_
+#define SR_TRACE_H_
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+/**
+ * @defgroup trace Request Tracing
+ * @ingroup common
+ * @{
+ */
+
+#define SR_TRACE_DIR_ENV "SYSREPO_TRACE_DIR"  /**< Environment variable with the directory for the trace files. */
+#define SR_TRACE_BUFFER_SIZE 4096            /**< Maximum number of spans buffered before they are written into a file. */
+#define SR_TRACE_TIME_WINDOW 10              /**< Maximum time window (in seconds) covered by one trace file. */
+
+/**
+ * @brief A span being measured.
+ */
+typedef struct sr_trace_span_s {
+    uint64_t trace_id;          /**< ID of the trace the span belongs to (0 = span is not recorded). */
+    const char *component;      /**< Component that recorded the span (static string). */
+    const char *name;           /**< Name of the span (static string). */
+    struct timespec start;      /**< Start time of the span. */
+} sr_trace_span_t;
+
+/**
+ * @brief Returns true if tracing is active in this process.
+ */
+bool sr_trace_enabled();
+
+/**
+ * @brief Generates a new (process-wide unique) trace ID, or 0 if tracing is not active.
+ */
+uint64_t sr_trace_new_id();
+
+/**
+ * @brief Sets the trace ID of the request that is currently processed by the calling thread.
+ *
+ * @param [in] trace_id Trace ID, 0 means that the thread does not process any traced request.
+ */
+void sr_trace_set_current(uint64_t trace_id);
+
+/**
+ * @brief Returns the trace ID of the request that is currently processed by the calling thread.
+ */
+uint64_t sr_trace_get_current();
+
+/**
+ * @brief Starts measurement of a span.
+ *
+ * @param [out] span Span context to be initialized.
+ * @param [in] trace_id ID of the trace, if 0 the span is not recorded.
+ * @param [in] component Name of the component (must be a static string).
+ * @param [in] name Name of the span (must be a static string).
+ */
+void sr_trace_span_begin(sr_trace_span_t *span, uint64_t trace_id, const char *component, const char *name);
+
+/**
+ * @brief Finishes measurement of a span and records it.
+ *
+ * @param [in] span Span context initialized by ::sr_trace_span_begin.
+ */
+void sr_trace_span_end(sr_trace_span_t *span);
+
+/**
+ * @brief Writes all buffered spans into a trace file.
+ */
+void sr_trace_flush();
+
+#ifdef ENABLE_REQUEST_TRACING
+    #define SR_TRACE_BEGIN(SPAN, TRACE_ID, COMPONENT, NAME) sr_trace_span_begin(SPAN, TRACE_ID, COMPONENT, NAME)
+    #define SR_TRACE_END(SPAN) sr_trace_span_end(SPAN)
+#else
+    #define SR_TRACE_BEGIN(SPAN, TRACE_ID, COMPONENT, NAME) \
+        do { (void) sizeof(SPAN); (void) sizeof(TRACE_ID); } while(0)
+    #define SR_TRACE_END(SPAN) \
+        do { (void) sizeof(SPAN); } while(0)
+#endif
+
+/**@} trace */
+
+#endif /* SR_TRACE_H_ */
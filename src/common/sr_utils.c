@@ -33,6 +33,7 @@
 #include <grp.h>
 #define __USE_XOPEN
 #include <time.h>
+#include <pthread.h>
 #include <libyang/libyang.h>
 
 #include "sr_common.h"
@@ -365,6 +366,53 @@ sr_cmp_first_ns(const char *xpath, const char *ns)
 
 }
 
+bool
+sr_xpath_in_subtree(const char *xpath, const char *subtree)
+{
+    size_t len = 0;
+
+    if (NULL == xpath || NULL == subtree) {
+        return false;
+    }
+    len = strlen(subtree);
+    if (0 != strncmp(xpath, subtree, len)) {
+        return false;
+    }
+    return '\0' == xpath[len] || '/' == xpath[len] || '[' == xpath[len];
+}
+
+void
+sr_xpath_normalize_quotes(char *xpath)
+{
+    char *opening = NULL, *closing = NULL;
+
+    if (NULL == xpath) {
+        return;
+    }
+
+    for (char *c = xpath; '\0' != *c; c++) {
+        if ('\'' == *c) {
+            /* skip a value enclosed in single quotes */
+            closing = strchr(c + 1, '\'');
+            if (NULL == closing) {
+                return;
+            }
+            c = closing;
+        } else if ('"' == *c) {
+            opening = c;
+            closing = strchr(c + 1, '"');
+            if (NULL == closing) {
+                return;
+            }
+            if (NULL == memchr(opening + 1, '\'', closing - opening - 1)) {
+                *opening = '\'';
+                *closing = '\'';
+            }
+            c = closing;
+        }
+    }
+}
+
 int
 sr_get_lock_data_file_name(const char *data_search_dir, const char *module_name,
         const sr_datastore_t ds, char **file_name)
@@ -2631,7 +2679,151 @@ cleanup:
     return rc;
 }
 
-int sr_get_user_name(uid_t uid, char **username_p)
+/**
+ * @brief Maximum number of entries in each of the user lookup caches.
+ */
+#define SR_USER_CACHE_MAX_ENTRIES 128
+
+/**
+ * @brief Cached username of a UID.
+ */
+typedef struct sr_user_name_entry_s {
+    uid_t uid;          /**< UID of the user. */
+    char *username;     /**< Name of the user. */
+    time_t expires;     /**< Time (CLOCK_MONOTONIC) when the entry expires. */
+} sr_user_name_entry_t;
+
+/**
+ * @brief Cached system groups of a user.
+ */
+typedef struct sr_user_groups_entry_s {
+    char *username;     /**< Name of the user. */
+    char **groups;      /**< Names of the groups that the user is member of. */
+    size_t group_cnt;   /**< Number of the groups. */
+    time_t expires;     /**< Time (CLOCK_MONOTONIC) when the entry expires. */
+} sr_user_groups_entry_t;
+
+/**
+ * @brief Cache of the password and group database lookups (these may be slow with network-backed NSS),
+ * entries are kept for ::SR_USER_GROUPS_CACHE_TTL seconds.
+ */
+static struct {
+    pthread_mutex_t lock;   /**< Mutex guarding the cache. */
+    sr_list_t *names;       /**< Cached usernames (sr_user_name_entry_t *). */
+    sr_list_t *groups;      /**< Cached groups of users (sr_user_groups_entry_t *). */
+} sr_user_cache = { PTHREAD_MUTEX_INITIALIZER, NULL, NULL };
+
+/**
+ * @brief Returns current time in seconds (CLOCK_MONOTONIC).
+ */
+static time_t
+sr_user_cache_now()
+{
+    struct timespec ts = { 0, };
+
+    sr_clock_get_time(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec;
+}
+
+static void
+sr_free_user_name_entry(sr_user_name_entry_t *entry)
+{
+    if (NULL != entry) {
+        free(entry->username);
+        free(entry);
+    }
+}
+
+static void
+sr_free_user_groups_entry(sr_user_groups_entry_t *entry)
+{
+    if (NULL != entry) {
+        for (size_t i = 0; i < entry->group_cnt; ++i) {
+            free(entry->groups[i]);
+        }
+        free(entry->groups);
+        free(entry->username);
+        free(entry);
+    }
+}
+
+/**
+ * @brief Duplicates an array of group names.
+ */
+static int
+sr_dup_group_names(char **groups, size_t group_cnt, char ***dup_p)
+{
+    char **dup = NULL;
+
+    *dup_p = NULL;
+    if (0 == group_cnt) {
+        return SR_ERR_OK;
+    }
+
+    dup = calloc(group_cnt, sizeof *dup);
+    CHECK_NULL_NOMEM_RETURN(dup);
+    for (size_t i = 0; i < group_cnt; ++i) {
+        dup[i] = strdup(groups[i]);
+        if (NULL == dup[i]) {
+            for (size_t j = 0; j < i; ++j) {
+                free(dup[j]);
+            }
+            free(dup);
+            SR_LOG_ERR_MSG("Unable to allocate memory.");
+            return SR_ERR_NOMEM;
+        }
+    }
+
+    *dup_p = dup;
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Adds an entry into a user lookup cache list, the oldest entry is dropped if the list is full.
+ * The cache mutex is expected to be held.
+ */
+static int
+sr_user_cache_add_locked(sr_list_t **list_p, void *entry, void (*free_cb)(void *))
+{
+    int rc = SR_ERR_OK;
+
+    if (NULL == *list_p) {
+        rc = sr_list_init(list_p);
+        CHECK_RC_MSG_RETURN(rc, "List init failed");
+    }
+    if ((*list_p)->count >= SR_USER_CACHE_MAX_ENTRIES) {
+        free_cb((*list_p)->data[0]);
+        sr_list_rm_at(*list_p, 0);
+    }
+    return sr_list_add(*list_p, entry);
+}
+
+void
+sr_user_cache_cleanup()
+{
+    pthread_mutex_lock(&sr_user_cache.lock);
+    if (NULL != sr_user_cache.names) {
+        for (size_t i = 0; i < sr_user_cache.names->count; ++i) {
+            sr_free_user_name_entry(sr_user_cache.names->data[i]);
+        }
+        sr_list_cleanup(sr_user_cache.names);
+        sr_user_cache.names = NULL;
+    }
+    if (NULL != sr_user_cache.groups) {
+        for (size_t i = 0; i < sr_user_cache.groups->count; ++i) {
+            sr_free_user_groups_entry(sr_user_cache.groups->data[i]);
+        }
+        sr_list_cleanup(sr_user_cache.groups);
+        sr_user_cache.groups = NULL;
+    }
+    pthread_mutex_unlock(&sr_user_cache.lock);
+}
+
+/**
+ * @brief Looks up the username of a UID in the password database.
+ */
+static int
+sr_lookup_user_name(uid_t uid, char **username_p)
 {
     int rc = SR_ERR_OK, ret = 0;
     size_t max_attempts = MAX_BUF_REALLOC_ATEMPTS;
@@ -2676,6 +2868,76 @@ cleanup:
     return rc;
 }
 
+int sr_get_user_name(uid_t uid, char **username_p)
+{
+    int rc = SR_ERR_OK;
+    time_t now = 0;
+    char *username = NULL;
+    sr_user_name_entry_t *entry = NULL;
+
+    if (0 == SR_USER_GROUPS_CACHE_TTL) {
+        return sr_lookup_user_name(uid, username_p);
+    }
+
+    now = sr_user_cache_now();
+
+    /* search the cache */
+    pthread_mutex_lock(&sr_user_cache.lock);
+    for (size_t i = 0; NULL != sr_user_cache.names && i < sr_user_cache.names->count; ++i) {
+        entry = sr_user_cache.names->data[i];
+        if (entry->uid == uid) {
+            if (entry->expires > now) {
+                if (NULL != username_p) {
+                    username = strdup(entry->username);
+                    CHECK_NULL_NOMEM_GOTO(username, rc, unlock);
+                    *username_p = username;
+                }
+                goto unlock;
+            }
+            /* expired */
+            sr_free_user_name_entry(entry);
+            sr_list_rm_at(sr_user_cache.names, i);
+            break;
+        }
+    }
+    entry = NULL;
+    pthread_mutex_unlock(&sr_user_cache.lock);
+
+    /* not cached, look it up */
+    rc = sr_lookup_user_name(uid, &username);
+    if (SR_ERR_OK != rc) {
+        return rc;
+    }
+
+    entry = calloc(1, sizeof *entry);
+    CHECK_NULL_NOMEM_GOTO(entry, rc, cleanup);
+    entry->uid = uid;
+    entry->username = strdup(username);
+    CHECK_NULL_NOMEM_GOTO(entry->username, rc, cleanup);
+    entry->expires = now + SR_USER_GROUPS_CACHE_TTL;
+
+    pthread_mutex_lock(&sr_user_cache.lock);
+    rc = sr_user_cache_add_locked(&sr_user_cache.names, entry, (void (*)(void *))sr_free_user_name_entry);
+    pthread_mutex_unlock(&sr_user_cache.lock);
+    if (SR_ERR_OK == rc) {
+        entry = NULL;
+    }
+    rc = SR_ERR_OK; /* failure to cache is not an error */
+
+cleanup:
+    sr_free_user_name_entry(entry);
+    if (SR_ERR_OK == rc && NULL != username_p) {
+        *username_p = username;
+    } else {
+        free(username);
+    }
+    return rc;
+
+unlock:
+    pthread_mutex_unlock(&sr_user_cache.lock);
+    return rc;
+}
+
 int sr_get_user_id(const char *username, uid_t *uid_p, gid_t *gid_p)
 {
     int rc = SR_ERR_OK, ret = 0;
@@ -2808,8 +3070,11 @@ cleanup:
     return rc;
 }
 
-int
-sr_get_user_groups(const char *username, char ***groups_p, size_t *group_cnt_p)
+/**
+ * @brief Looks up all system groups that the given user is member of.
+ */
+static int
+sr_lookup_user_groups(const char *username, char ***groups_p, size_t *group_cnt_p)
 {
     int rc = SR_ERR_OK, ret = 0;
     size_t max_attempts = MAX_BUF_REALLOC_ATEMPTS;
@@ -2887,6 +3152,80 @@ cleanup:
     return rc;
 }
 
+int
+sr_get_user_groups(const char *username, char ***groups_p, size_t *group_cnt_p)
+{
+    int rc = SR_ERR_OK;
+    time_t now = 0;
+    char **groups = NULL;
+    size_t group_cnt = 0;
+    sr_user_groups_entry_t *entry = NULL;
+    CHECK_NULL_ARG3(username, groups_p, group_cnt_p);
+
+    if (0 == SR_USER_GROUPS_CACHE_TTL) {
+        return sr_lookup_user_groups(username, groups_p, group_cnt_p);
+    }
+
+    now = sr_user_cache_now();
+
+    /* search the cache */
+    pthread_mutex_lock(&sr_user_cache.lock);
+    for (size_t i = 0; NULL != sr_user_cache.groups && i < sr_user_cache.groups->count; ++i) {
+        entry = sr_user_cache.groups->data[i];
+        if (0 == strcmp(entry->username, username)) {
+            if (entry->expires > now) {
+                rc = sr_dup_group_names(entry->groups, entry->group_cnt, groups_p);
+                if (SR_ERR_OK == rc) {
+                    *group_cnt_p = entry->group_cnt;
+                }
+                pthread_mutex_unlock(&sr_user_cache.lock);
+                return rc;
+            }
+            /* expired */
+            sr_free_user_groups_entry(entry);
+            sr_list_rm_at(sr_user_cache.groups, i);
+            break;
+        }
+    }
+    pthread_mutex_unlock(&sr_user_cache.lock);
+
+    /* not cached, look them up */
+    rc = sr_lookup_user_groups(username, &groups, &group_cnt);
+    if (SR_ERR_OK != rc) {
+        return rc;
+    }
+
+    entry = calloc(1, sizeof *entry);
+    CHECK_NULL_NOMEM_GOTO(entry, rc, cleanup);
+    entry->username = strdup(username);
+    CHECK_NULL_NOMEM_GOTO(entry->username, rc, cleanup);
+    rc = sr_dup_group_names(groups, group_cnt, &entry->groups);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to duplicate the groups of a user.");
+    entry->group_cnt = group_cnt;
+    entry->expires = now + SR_USER_GROUPS_CACHE_TTL;
+
+    pthread_mutex_lock(&sr_user_cache.lock);
+    rc = sr_user_cache_add_locked(&sr_user_cache.groups, entry, (void (*)(void *))sr_free_user_groups_entry);
+    pthread_mutex_unlock(&sr_user_cache.lock);
+    if (SR_ERR_OK == rc) {
+        entry = NULL;
+    }
+    rc = SR_ERR_OK; /* failure to cache is not an error */
+
+cleanup:
+    sr_free_user_groups_entry(entry);
+    if (SR_ERR_OK == rc) {
+        *groups_p = groups;
+        *group_cnt_p = group_cnt;
+    } else {
+        for (size_t i = 0; i < group_cnt; ++i) {
+            free(groups[i]);
+        }
+        free(groups);
+    }
+    return rc;
+}
+
 void
 sr_free_list_of_strings(sr_list_t *list)
 {
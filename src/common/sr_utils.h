@@ -229,6 +229,23 @@ int sr_copy_all_ns(const char *xpath, char ***namespaces, size_t *ns_count);
  */
 int sr_cmp_first_ns(const char *xpath, const char *ns);
 
+/**
+ * @brief Returns true if the xpath lies in the subtree identified by the subtree xpath
+ * (the subtree xpath is a prefix of the xpath ending at a node boundary).
+ * @param [in] xpath
+ * @param [in] subtree
+ * @return True if the xpath identifies the subtree root or a node under it.
+ */
+bool sr_xpath_in_subtree(const char *xpath, const char *subtree);
+
+/**
+ * @brief Rewrites predicate values enclosed in double quotes to be enclosed in single quotes
+ * (as printed by libyang), so that xpaths of the same node can be compared as strings.
+ * Values containing a single quote are left untouched.
+ * @param [in,out] xpath
+ */
+void sr_xpath_normalize_quotes(char *xpath);
+
 
 /**
  * @brief Creates the file name of the data lock file
@@ -738,7 +755,7 @@ int sr_print(sr_print_ctx_t *print_ctx, const char *format, ...);
 int sr_create_uri_for_module(const struct lys_module *module, char **uri);
 
 /**
- * @brief Get username from UID.
+ * @brief Get username from UID. The result is cached for ::SR_USER_GROUPS_CACHE_TTL seconds.
  *
  * @param [in] uid UID of the user to get the name of.
  * @param [out] username Returned username. Deallocate with ::free.
@@ -772,6 +789,7 @@ int sr_get_group_id(const char *groupname, gid_t *gid);
 
 /**
  * @brief Returns an array of all system groups that the given user is member of.
+ * The result is cached for ::SR_USER_GROUPS_CACHE_TTL seconds.
  *
  * @param [in] username Name of the user to search for in the group database.
  * @param [out] groups Array of groups (their names) that the user is member of.
@@ -779,6 +797,11 @@ int sr_get_group_id(const char *groupname, gid_t *gid);
  */
 int sr_get_user_groups(const char *username, char ***groups, size_t *group_cnt);
 
+/**
+ * @brief Frees all entries cached by ::sr_get_user_name and ::sr_get_user_groups.
+ */
+void sr_user_cache_cleanup();
+
 /**
  * @brief Frees the list and that contains allocated strings (they are freed as well).
  * @param [in] list
@@ -67,7 +67,7 @@ typedef struct cm_ctx_s {
     /** Socket descriptor used to listen & accept new unix-domain connections. */
     int listen_socket_fd;
 
-    /** Queue of messages to be sent to their recipients. */
+    /** Queue of messages to be sent to their recipients (cm_out_msg_t). */
     sr_cbuff_t *msg_queue;
     /** Message queue mutex. */
     pthread_mutex_t msg_queue_mutex;
@@ -127,6 +127,14 @@ typedef struct cm_connection_ctx_s {
     ev_io write_watcher;   /**< Watcher for writable events on connection's socket. */
 } cm_connection_ctx_t;
 
+/**
+ * @brief Message in the queue of messages to be sent to their recipients.
+ */
+typedef struct cm_out_msg_s {
+    Sr__Msg *msg;                           /**< Message to be sent. */
+    sr_gpb_shared_payload_t *payload;       /**< Shared payload packed in place of the values / trees of an event notification. */
+} cm_out_msg_t;
+
 /**
  * @brief Context of a delayed request (request to be sent to the Request Processor after some timeout).
  */
@@ -861,6 +869,7 @@ cleanup:
 static int
 cm_req_process(cm_ctx_t *cm_ctx, sm_connection_t *conn, sm_session_t *session, Sr__Msg *msg)
 {
+    sr_trace_span_t span = { 0, };
     int rc = SR_ERR_OK;
 
     CHECK_NULL_ARG4(cm_ctx, conn, msg, msg->request);
@@ -871,6 +880,10 @@ cm_req_process(cm_ctx_t *cm_ctx, sm_connection_t *conn, sm_session_t *session, S
         return SR_ERR_INVAL_ARG;
     }
 
+    SR_PROBE2(request__receive, msg->session_id, msg->request->operation);
+    /* the message may be released or handed over to RP, the span covers only the processing in CM */
+    SR_TRACE_BEGIN(&span, msg->trace_id, "cm", sr_gpb_operation_name(msg->request->operation));
+
     rc = sr_gpb_msg_validate(msg, SR__MSG__MSG_TYPE__REQUEST, msg->request->operation);
     if (SR_ERR_OK != rc) {
         SR_LOG_ERR("Invalid request received (conn=%p).", (void*)conn);
@@ -917,9 +930,11 @@ cm_req_process(cm_ctx_t *cm_ctx, sm_connection_t *conn, sm_session_t *session, S
             break;
     }
 
+    SR_TRACE_END(&span);
     return rc;
 
 cleanup:
+    SR_TRACE_END(&span);
     sr_msg_free(msg);
     return rc;
 }
@@ -950,7 +965,11 @@ cm_resp_process(cm_ctx_t *cm_ctx, sm_connection_t *conn, sm_session_t *session,
 
     if (session->cm_data->rp_resp_expected > 0) {
         /* the response is expected, forward it to Request Processor */
-        rc = rp_msg_process(cm_ctx->rp_ctx, session->cm_data->rp_session, msg);
+        if (conn->trusted) {
+            rc = rp_trusted_msg_process(cm_ctx->rp_ctx, session->cm_data->rp_session, msg);
+        } else {
+            rc = rp_msg_process(cm_ctx->rp_ctx, session->cm_data->rp_session, msg);
+        }
         session->cm_data->rp_resp_expected -= 1;
     } else {
         /* the response is unexpected */
@@ -1353,6 +1372,8 @@ cm_subscr_conn_create(cm_ctx_t *cm_ctx, const char *socket_path, sm_connection_t
     int fd = -1;
     struct sockaddr_un addr = { 0, };
     sm_connection_t *connection = NULL;
+    ac_ucred_t peer_credentials = { 0, };
+    char *username = NULL;
     int rc = SR_ERR_OK;
 
     /* prepare a socket */
@@ -1420,6 +1441,15 @@ cm_subscr_conn_create(cm_ctx_t *cm_ctx, const char *socket_path, sm_connection_t
         return SR_ERR_INTERNAL;
     }
 
+    /* responses of a trusted subscriber can be forwarded to trusted sessions without validation */
+    if (SR_ERR_OK == sr_get_user_name(connection->uid, &username)) {
+        peer_credentials.r_username = username;
+        peer_credentials.r_uid = connection->uid;
+        peer_credentials.r_gid = connection->gid;
+        connection->trusted = (SR_ERR_OK == ac_check_trusted_user(&peer_credentials));
+        free(username);
+    }
+
     *connection_p = connection;
     return SR_ERR_OK;
 
@@ -1601,16 +1631,22 @@ cm_out_rpc_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
 
 /**
  * @brief Processes an outgoing event notification (notification to be sent to the client library).
+ * The shared payload (if any) is packed in place of the values / trees of the notification and its reference
+ * is released afterwards.
  */
 static int
-cm_out_event_notif_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
+cm_out_event_notif_process(cm_ctx_t *cm_ctx, Sr__Msg *msg, sr_gpb_shared_payload_t *payload)
 {
     sm_session_t *session = NULL;
     sm_connection_t *connection = NULL;
     char *destination_address = NULL;
     int rc = SR_ERR_OK;
 
-    CHECK_NULL_ARG4(cm_ctx, msg, msg->request, msg->request->event_notif_req);
+    CHECK_NULL_ARG_NORET4(rc, cm_ctx, msg, msg->request, msg->request->event_notif_req);
+    if (SR_ERR_OK != rc) {
+        sr_gpb_shared_payload_release(payload);
+        return rc;
+    }
 
     destination_address = msg->request->event_notif_req->subscriber_address;
 
@@ -1623,11 +1659,13 @@ cm_out_event_notif_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
             SR_LOG_ERR("Unable to find the session matching with id specified in the message "
                     "(id=%"PRIu32").", msg->session_id);
             sr_msg_free(msg);
+            sr_gpb_shared_payload_release(payload);
             return SR_ERR_INTERNAL;
         }
         if ((NULL == session) || (NULL == session->cm_data)) {
             SR_LOG_ERR("invalid session context - NULL value detected (id=%"PRIu32").", msg->session_id);
             sr_msg_free(msg);
+            sr_gpb_shared_payload_release(payload);
             return SR_ERR_INTERNAL;
         }
     } else {
@@ -1648,7 +1686,9 @@ cm_out_event_notif_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
 
     /* send the message */
     if (SR_ERR_OK == rc) {
+        sr_gpb_event_notif_attach_payload(msg->request->event_notif_req, payload);
         rc = cm_msg_send_connection(cm_ctx, connection, msg);
+        sr_gpb_event_notif_detach_payload(msg->request->event_notif_req, payload);
     }
 
     if (SR_ERR_OK != rc && SR_ERR_DISCONNECT != rc) {
@@ -1657,6 +1697,7 @@ cm_out_event_notif_process(cm_ctx_t *cm_ctx, Sr__Msg *msg)
     }
 
     sr_msg_free(msg);
+    sr_gpb_shared_payload_release(payload);
 
     return rc;
 }
@@ -1788,13 +1829,15 @@ cm_msg_enqueue_cb(struct ev_loop *loop, ev_async *w, int revents)
     SR_LOG_DBG_MSG("New message enqueued into CM message queue.");
 
     do {
+        cm_out_msg_t out_msg = { 0, };
         Sr__Msg *msg = NULL;
 
         pthread_mutex_lock(&cm_ctx->msg_queue_mutex);
-        dequeued = sr_cbuff_dequeue(cm_ctx->msg_queue, &msg);
+        dequeued = sr_cbuff_dequeue(cm_ctx->msg_queue, &out_msg);
         pthread_mutex_unlock(&cm_ctx->msg_queue_mutex);
 
         if (dequeued) {
+            msg = out_msg.msg;
             if (SR__MSG__MSG_TYPE__NOTIFICATION == msg->type) {
                 /* send the notification via subscriber connection */
                 cm_out_notif_process(cm_ctx, msg);
@@ -1810,11 +1853,14 @@ cm_msg_enqueue_cb(struct ev_loop *loop, ev_async *w, int revents)
             } else if ((SR__MSG__MSG_TYPE__REQUEST == msg->type) &&
                    (SR__OPERATION__EVENT_NOTIF == msg->request->operation)) {
                /* send the event notification via subscriber connection */
-               cm_out_event_notif_process(cm_ctx, msg);
+               cm_out_event_notif_process(cm_ctx, msg, out_msg.payload);
+               out_msg.payload = NULL;
            } else {
                 /* process as a normal message */
                 cm_out_msg_process(cm_ctx, msg);
             }
+            /* only event notifications carry a shared payload */
+            sr_gpb_shared_payload_release(out_msg.payload);
         }
     } while (dequeued);
 }
@@ -1910,7 +1956,7 @@ cm_init(const cm_connection_mode_t mode, const char *socket_path, cm_ctx_t **cm_
 
     /* initialize message queue */
     pthread_mutex_init(&ctx->msg_queue_mutex, NULL);
-    rc = sr_cbuff_init(CM_INIT_MSG_QUEUE_SIZE, sizeof(Sr__Msg*), &ctx->msg_queue);
+    rc = sr_cbuff_init(CM_INIT_MSG_QUEUE_SIZE, sizeof(cm_out_msg_t), &ctx->msg_queue);
     if (SR_ERR_OK != rc){
         SR_LOG_ERR_MSG("CM message queue initialization failed.");
         goto cleanup;
@@ -1972,7 +2018,7 @@ cm_cleanup(cm_ctx_t *cm_ctx)
 {
     size_t i = 0;
     sm_session_t *session = NULL;
-    Sr__Msg *msg = NULL;
+    cm_out_msg_t out_msg = { 0, };
     cm_delayed_request_ctx_t *req = NULL, *tmp = NULL;
     int rc = SR_ERR_OK;
 
@@ -1991,8 +2037,9 @@ cm_cleanup(cm_ctx_t *cm_ctx)
         ev_loop_destroy(cm_ctx->event_loop);
         cm_server_cleanup(cm_ctx);
 
-        while (sr_cbuff_dequeue(cm_ctx->msg_queue, &msg)) {
-            sr_msg_free(msg);
+        while (sr_cbuff_dequeue(cm_ctx->msg_queue, &out_msg)) {
+            sr_msg_free(out_msg.msg);
+            sr_gpb_shared_payload_release(out_msg.payload);
         }
         sr_cbuff_cleanup(cm_ctx->msg_queue);
         pthread_mutex_destroy(&cm_ctx->msg_queue_mutex);
@@ -2054,6 +2101,13 @@ cm_stop(cm_ctx_t *cm_ctx)
 int
 cm_msg_send(cm_ctx_t *cm_ctx, Sr__Msg *msg)
 {
+    return cm_msg_send_shared(cm_ctx, msg, NULL);
+}
+
+int
+cm_msg_send_shared(cm_ctx_t *cm_ctx, Sr__Msg *msg, sr_gpb_shared_payload_t *payload)
+{
+    cm_out_msg_t out_msg = { msg, payload };
     int rc = SR_ERR_OK;
 
     CHECK_NULL_ARG_NORET2(rc, cm_ctx, msg);
@@ -2065,8 +2119,21 @@ cm_msg_send(cm_ctx_t *cm_ctx, Sr__Msg *msg)
         return rc;
     }
 
+    if (NULL != payload) {
+        /* the queued message holds its own reference */
+        __sync_fetch_and_add(&payload->refcount, 1);
+    }
+
+#ifdef ENABLE_REQUEST_TRACING
+    if (!msg->has_trace_id) {
+        /* propagate the trace of the request being processed by this thread */
+        msg->trace_id = sr_trace_get_current();
+        msg->has_trace_id = (0 != msg->trace_id);
+    }
+#endif
+
     pthread_mutex_lock(&cm_ctx->msg_queue_mutex);
-    rc = sr_cbuff_enqueue(cm_ctx->msg_queue, &msg);
+    rc = sr_cbuff_enqueue(cm_ctx->msg_queue, &out_msg);
     pthread_mutex_unlock(&cm_ctx->msg_queue_mutex);
 
     if (SR_ERR_OK == rc) {
@@ -2076,6 +2143,7 @@ cm_msg_send(cm_ctx_t *cm_ctx, Sr__Msg *msg)
         /* release the message by error */
         SR_LOG_ERR_MSG("Unable to send the message, skipping.");
         sr_msg_free(msg);
+        sr_gpb_shared_payload_release(payload);
     }
 
     return rc;
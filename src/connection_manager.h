@@ -138,6 +138,22 @@ int cm_stop(cm_ctx_t *cm_ctx);
  */
 int cm_msg_send(cm_ctx_t *cm_ctx, Sr__Msg *msg);
 
+/**
+ * @brief Sends an event notification with the values / trees replaced by a shared payload,
+ * which is packed into the message right before it is written to the subscriber connection.
+ *
+ * @note This function is thread safe, can be called from any thread.
+ *
+ * @param[in] cm_ctx Connection Manager context.
+ * @param[in] msg Event notification request with no values or trees. @note Message will be freed
+ * automatically after sending, also in case of error.
+ * @param[in] payload Shared payload, can be NULL. The caller keeps its reference, the message holds
+ * its own one until it is sent.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+int cm_msg_send_shared(cm_ctx_t *cm_ctx, Sr__Msg *msg, sr_gpb_shared_payload_t *payload);
+
 /**
  * @brief Callback to be called when a watched signal (registered with
  * ::cm_watch_signal) has been caught.
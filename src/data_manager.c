@@ -98,15 +98,31 @@ typedef struct dm_session_s {
 
 /**
  * @brief Info structure for the node which holds its state in the running data store,
- * hash of its xpath in the schema tree and its depth in the data tree.
+ * hash of its xpath in the schema tree, its depth in the data tree and its unique ID.
  * (It will hold information about notification subscriptions.)
  */
 typedef struct dm_node_info_s {
     dm_node_state_t state;
     uint32_t xpath_hash;
     uint16_t data_depth;
+    uint32_t id;
 } dm_node_info_t;
 
+/**
+ * @brief Last assigned schema node ID, IDs are never reused (not even across schema reloads).
+ */
+static uint32_t dm_node_id_last = 0;
+
+/**
+ * @brief Entry of the subscription index of a module - subscriptions that may be interested in the changes
+ * of one schema node.
+ */
+typedef struct dm_subscription_index_s {
+    const struct lys_node *node;    /**< Schema node (key of the entry). */
+    sr_bitset_t *subscribed;        /**< Subscriptions tied to the node itself. */
+    sr_bitset_t *nested;            /**< Subscriptions tied to a descendant of the node. */
+} dm_subscription_index_t;
+
 /**
  * @brief Kind of procedure that DM can validate.
  */
@@ -287,6 +303,21 @@ dm_set_node_data_depth(struct lys_node *node, uint16_t depth)
     return SR_ERR_OK;
 }
 
+/**
+ * @brief Assigns a new unique ID to the given schema node.
+ */
+static int
+dm_set_node_id(struct lys_node *node)
+{
+    CHECK_NULL_ARG(node);
+    if (NULL == node->priv) {
+        node->priv = calloc(1, sizeof(dm_node_info_t));
+        CHECK_NULL_NOMEM_RETURN(node->priv);
+    }
+    ((dm_node_info_t *) node->priv)->id = __sync_add_and_fetch(&dm_node_id_last, 1);
+    return SR_ERR_OK;
+}
+
 static void
 dm_free_lys_private_data(const struct lys_node *node, void *private)
 {
@@ -328,6 +359,32 @@ dm_data_info_free(void *item)
     free(info);
 }
 
+/**
+ * @brief Frees the changes generated from the difflist of the module together with the views into them.
+ */
+static void
+dm_model_subscription_free_changes(dm_model_subscription_t *ms)
+{
+    dm_change_view_t *view = NULL;
+
+    if (NULL != ms->changes) {
+        for (int i = 0; i < ms->changes->count; i++) {
+            sr_free_changes(ms->changes->data[i], 1);
+        }
+        sr_list_cleanup(ms->changes);
+        ms->changes = NULL;
+    }
+    if (NULL != ms->change_views) {
+        for (size_t i = 0; i < ms->change_views->count; i++) {
+            view = ms->change_views->data[i];
+            free(view->positions);
+            free(view);
+        }
+        sr_list_cleanup(ms->change_views);
+        ms->change_views = NULL;
+    }
+}
+
 static void
 dm_model_subscription_free(void *sub)
 {
@@ -335,14 +392,12 @@ dm_model_subscription_free(void *sub)
     if (NULL != ms) {
         np_subscriptions_list_cleanup(ms->subscriptions);
         free(ms->nodes);
+        sr_btree_cleanup(ms->node_index);
+        sr_bitset_cleanup(ms->module_subs);
         lyd_free_diff(ms->difflist);
-        if (NULL != ms->changes) {
-            for (int i = 0; i < ms->changes->count; i++) {
-                sr_free_changes(ms->changes->data[i], 1);
-            }
-            sr_list_cleanup(ms->changes);
-        }
+        dm_model_subscription_free_changes(ms);
         pthread_rwlock_destroy(&ms->changes_lock);
+        pthread_mutex_destroy(&ms->change_views_lock);
     }
     free(ms);
 }
@@ -429,7 +484,7 @@ dm_enable_features_in_tmp_module(dm_ctx_t *dm_ctx, md_module_t *md_module, const
 
 cleanup:
     if (locked) {
-        pthread_rwlock_unlock(&si->model_lock);
+        SR_RWLOCK_UNLOCK(&si->model_lock);
     }
     free(features_state);
     free(features);
@@ -742,6 +797,10 @@ dm_init_missing_node_priv_data(dm_schema_info_t *schema_info)
                 if (SR_ERR_OK != rc) {
                     return rc;
                 }
+                rc = dm_set_node_id(node);
+                if (SR_ERR_OK != rc) {
+                    return rc;
+                }
             }
             if (!(node->nodetype & (LYS_LEAF | LYS_LEAFLIST | LYS_ANYDATA)) && node->child) {
                 if (sr_lys_data_node(node)) {
@@ -1031,7 +1090,9 @@ dm_load_module(dm_ctx_t *dm_ctx, const char *module_name, const char *revision,
     si->can_not_be_locked = !module->has_data;
 
     /* insert schema info into schema tree */
+    SR_LOCK_PROF_WAIT(&dm_ctx->schema_tree_lock);
     RWLOCK_WRLOCK_TIMED_CHECK_GOTO(&dm_ctx->schema_tree_lock, rc, cleanup);
+    SR_LOCK_PROF_ACQUIRED(&dm_ctx->schema_tree_lock, "schema_tree_lock");
 
     rc = sr_btree_insert(dm_ctx->schema_info_tree, si);
     if (SR_ERR_OK != rc) {
@@ -1052,7 +1113,7 @@ dm_load_module(dm_ctx_t *dm_ctx, const char *module_name, const char *revision,
     }
 
 unlock:
-    pthread_rwlock_unlock(&dm_ctx->schema_tree_lock);
+    SR_RWLOCK_UNLOCK(&dm_ctx->schema_tree_lock);
 cleanup:
     if (SR_ERR_OK == rc) {
         *schema_info = si;
@@ -1141,7 +1202,9 @@ dm_load_data_tree_file(dm_ctx_t *dm_ctx, int fd, const char *data_filename, dm_s
             md_ctx_lock(dm_ctx->md_ctx, false);
             ly_ctx_set_module_data_clb(tmp_ctx->ctx, dm_module_clb, dm_ctx);
 
+            SR_PROBE2(data__load__begin, schema_info->module_name, data_filename);
             tmp_node = lyd_parse_fd(tmp_ctx->ctx, fd, LYD_XML, LYD_OPT_TRUSTED | LYD_OPT_CONFIG);
+            SR_PROBE2(data__load__end, schema_info->module_name, (NULL != tmp_node || LY_SUCCESS == ly_errno));
             md_ctx_unlock(dm_ctx->md_ctx);
 
             if (NULL == tmp_node && LY_SUCCESS != ly_errno) {
@@ -1160,7 +1223,9 @@ dm_load_data_tree_file(dm_ctx_t *dm_ctx, int fd, const char *data_filename, dm_s
         } else {
             ly_errno = 0;
             /* use LYD_OPT_TRUSTED, validation will be done later */
+            SR_PROBE2(data__load__begin, schema_info->module_name, data_filename);
             data_tree = lyd_parse_fd(schema_info->ly_ctx, fd, LYD_XML, LYD_OPT_TRUSTED | LYD_OPT_CONFIG);
+            SR_PROBE2(data__load__end, schema_info->module_name, (NULL != data_tree || LY_SUCCESS == ly_errno));
             if (NULL == data_tree && LY_SUCCESS != ly_errno) {
                 SR_LOG_ERR("Parsing data tree from file %s failed: %s", data_filename, ly_errmsg());
                 free(data);
@@ -1236,11 +1301,7 @@ dm_load_data_tree(dm_ctx_t *dm_ctx, dm_session_t *dm_session_ctx, dm_schema_info
     rc = sr_get_data_file_name(dm_ctx->data_search_dir, schema_info->module->name, ds, &data_filename);
     CHECK_RC_LOG_RETURN(rc, "Get data_filename failed for %s", schema_info->module->name);
 
-    ac_set_user_identity(dm_ctx->ac_ctx, dm_session_ctx->user_credentials);
-
-    int fd = open(data_filename, O_RDONLY);
-
-    ac_unset_user_identity(dm_ctx->ac_ctx, dm_session_ctx->user_credentials);
+    int fd = ac_open_file(dm_ctx->ac_ctx, dm_session_ctx->user_credentials, data_filename, O_RDONLY, 0);
 
     if (-1 != fd) {
         /* lock, read-only, blocking */
@@ -1382,7 +1443,7 @@ dm_lock_module(dm_ctx_t *dm_ctx, dm_session_t *session, const char *modul_name)
         pthread_mutex_unlock(&si->usage_count_mutex);
     }
 cleanup:
-    pthread_rwlock_unlock(&si->model_lock);
+    SR_RWLOCK_UNLOCK(&si->model_lock);
     return rc;
 }
 
@@ -1426,7 +1487,7 @@ dm_unlock_module(dm_ctx_t *dm_ctx, dm_session_t *session, char *modul_name)
     }
 cleanup:
     free(lock_file);
-    pthread_rwlock_unlock(&si->model_lock);
+    SR_RWLOCK_UNLOCK(&si->model_lock);
     return rc;
 }
 
@@ -1445,15 +1506,15 @@ dm_lock_datastore(dm_ctx_t *dm_ctx, dm_session_t *session)
     rc = dm_list_schemas(dm_ctx, session, &schemas, &schema_count);
     CHECK_RC_MSG_GOTO(rc, cleanup, "List schemas failed");
 
-    pthread_mutex_lock(&dm_ctx->ds_lock_mutex);
+    SR_MUTEX_LOCK(&dm_ctx->ds_lock_mutex, "ds_lock_mutex");
     if (dm_ctx->ds_lock[session->datastore]) {
         SR_LOG_ERR_MSG("Datastore lock is hold by other session");
         rc = SR_ERR_LOCKED;
-        pthread_mutex_unlock(&dm_ctx->ds_lock_mutex);
+        SR_MUTEX_UNLOCK(&dm_ctx->ds_lock_mutex);
         goto cleanup;
     }
     dm_ctx->ds_lock[session->datastore] = true;
-    pthread_mutex_unlock(&dm_ctx->ds_lock_mutex);
+    SR_MUTEX_UNLOCK(&dm_ctx->ds_lock_mutex);
     session->holds_ds_lock[session->datastore] = true;
 
     for (size_t i = 0; i < schema_count; i++) {
@@ -1468,9 +1529,9 @@ dm_lock_datastore(dm_ctx_t *dm_ctx, dm_session_t *session)
             for (size_t l = 0; l < locked->count; l++) {
                 dm_unlock_module(dm_ctx, session, (char *) locked->data[l]);
             }
-            pthread_mutex_lock(&dm_ctx->ds_lock_mutex);
+            SR_MUTEX_LOCK(&dm_ctx->ds_lock_mutex, "ds_lock_mutex");
             dm_ctx->ds_lock[session->datastore] = false;
-            pthread_mutex_unlock(&dm_ctx->ds_lock_mutex);
+            SR_MUTEX_UNLOCK(&dm_ctx->ds_lock_mutex);
             session->holds_ds_lock[session->datastore] = false;
             goto cleanup;
         }
@@ -1544,7 +1605,7 @@ dm_unlock_datastore(dm_ctx_t *dm_ctx, dm_session_t *session)
             si->usage_count--;
             SR_LOG_DBG("Usage count %s decremented (value=%zu)", si->module_name, si->usage_count);
             pthread_mutex_unlock(&si->usage_count_mutex);
-            pthread_rwlock_unlock(&si->model_lock);
+            SR_RWLOCK_UNLOCK(&si->model_lock);
         } else {
             SR_LOG_WRN("Get schema info by lock file failed %s", (char *) session->locked_files->data[0]);
         }
@@ -1555,10 +1616,10 @@ dm_unlock_datastore(dm_ctx_t *dm_ctx, dm_session_t *session)
     }
     for (int i = 0; i < DM_DATASTORE_COUNT; i++) {
         if (session->holds_ds_lock[i]) {
-            pthread_mutex_lock(&dm_ctx->ds_lock_mutex);
+            SR_MUTEX_LOCK(&dm_ctx->ds_lock_mutex, "ds_lock_mutex");
             dm_ctx->ds_lock[i] = false;
             session->holds_ds_lock[i] = false;
-            pthread_mutex_unlock(&dm_ctx->ds_lock_mutex);
+            SR_MUTEX_UNLOCK(&dm_ctx->ds_lock_mutex);
         }
     }
     return SR_ERR_OK;
@@ -1602,6 +1663,16 @@ dm_get_node_data_depth(struct lys_node *node)
     return n_info->data_depth;
 }
 
+uint32_t
+dm_get_node_id(struct lys_node *node)
+{
+    if (NULL == node || NULL == node->priv) {
+        return 0;
+    }
+    dm_node_info_t *n_info = (dm_node_info_t *) node->priv;
+    return n_info->id;
+}
+
 static int
 dm_alloc_operation(dm_session_t *session, dm_operation_t op, const char *xpath)
 {
@@ -2706,7 +2777,7 @@ dm_get_data_info_internal(dm_ctx_t *dm_ctx, dm_session_t *dm_session_ctx, const
     *info = di;
 
 cleanup:
-    pthread_rwlock_unlock(&schema_info->model_lock);
+    SR_RWLOCK_UNLOCK(&schema_info->model_lock);
     return rc;
 }
 
@@ -2742,22 +2813,30 @@ dm_get_module_internal(dm_ctx_t *dm_ctx, const char *module_name, bool lock, boo
     dm_schema_info_t *sch_info = NULL;
 
     lookup.module_name = (char *) module_name;
+    SR_LOCK_PROF_WAIT(&dm_ctx->schema_tree_lock);
     RWLOCK_RDLOCK_TIMED_CHECK_RETURN(&dm_ctx->schema_tree_lock);
+    SR_LOCK_PROF_ACQUIRED(&dm_ctx->schema_tree_lock, "schema_tree_lock");
     sch_info = sr_btree_search(dm_ctx->schema_info_tree, &lookup);
 
     if (NULL != sch_info) {
         /* there is matching item in schema info tree */
         if (lock) {
 
+            SR_PROBE2(lock__wait__begin, "model_lock", (void *)&sch_info->model_lock);
             if (write) {
+                SR_LOCK_PROF_WAIT(&sch_info->model_lock);
                 RWLOCK_WRLOCK_TIMED_CHECK_GOTO(&sch_info->model_lock, rc, cleanup);
+                SR_LOCK_PROF_ACQUIRED(&sch_info->model_lock, "model_lock");
             } else {
+                SR_LOCK_PROF_WAIT(&sch_info->model_lock);
                 RWLOCK_RDLOCK_TIMED_CHECK_GOTO(&sch_info->model_lock, rc, cleanup);
+                SR_LOCK_PROF_ACQUIRED(&sch_info->model_lock, "model_lock");
             }
+            SR_PROBE2(lock__wait__end, "model_lock", (void *)&sch_info->model_lock);
 
             if (NULL == sch_info->ly_ctx) {
                 SR_LOG_DBG("Module %s has been uninstalled", sch_info->module_name);
-                pthread_rwlock_unlock(&sch_info->model_lock);
+                SR_RWLOCK_UNLOCK(&sch_info->model_lock);
                 rc = SR_ERR_UNKNOWN_MODEL;
                 goto cleanup;
             }
@@ -2766,18 +2845,24 @@ dm_get_module_internal(dm_ctx_t *dm_ctx, const char *module_name, bool lock, boo
         goto cleanup;
     } else {
         /* try to load schema */
-        pthread_rwlock_unlock(&dm_ctx->schema_tree_lock);
+        SR_RWLOCK_UNLOCK(&dm_ctx->schema_tree_lock);
         rc = dm_load_module(dm_ctx, module_name, NULL, &sch_info);
         if (SR_ERR_OK == rc && lock) {
+            SR_PROBE2(lock__wait__begin, "model_lock", (void *)&sch_info->model_lock);
             if (write) {
+                SR_LOCK_PROF_WAIT(&sch_info->model_lock);
                 RWLOCK_WRLOCK_TIMED_CHECK_GOTO(&sch_info->model_lock, rc, cleanup);
+                SR_LOCK_PROF_ACQUIRED(&sch_info->model_lock, "model_lock");
             } else {
+                SR_LOCK_PROF_WAIT(&sch_info->model_lock);
                 RWLOCK_RDLOCK_TIMED_CHECK_GOTO(&sch_info->model_lock, rc, cleanup);
+                SR_LOCK_PROF_ACQUIRED(&sch_info->model_lock, "model_lock");
             }
+            SR_PROBE2(lock__wait__end, "model_lock", (void *)&sch_info->model_lock);
 
             if (NULL == sch_info->ly_ctx) {
                 SR_LOG_DBG("Module %s has been uninstalled", sch_info->module_name);
-                pthread_rwlock_unlock(&sch_info->model_lock);
+                SR_RWLOCK_UNLOCK(&sch_info->model_lock);
                 rc = SR_ERR_UNKNOWN_MODEL;
             } else {
                 *schema_info = sch_info;
@@ -2789,7 +2874,7 @@ dm_get_module_internal(dm_ctx_t *dm_ctx, const char *module_name, bool lock, boo
     return rc;
 
 cleanup:
-    pthread_rwlock_unlock(&dm_ctx->schema_tree_lock);
+    SR_RWLOCK_UNLOCK(&dm_ctx->schema_tree_lock);
     return rc;
 }
 
@@ -2813,7 +2898,7 @@ dm_get_module_without_lock(dm_ctx_t *dm_ctx, const char *module_name, dm_schema_
 
     rc = dm_get_module_and_lock(dm_ctx, module_name, schema_info);
     if (SR_ERR_OK == rc) {
-        pthread_rwlock_unlock(&(*schema_info)->model_lock);
+        SR_RWLOCK_UNLOCK(&(*schema_info)->model_lock);
     }
     return rc;
 }
@@ -3094,7 +3179,7 @@ dm_get_schema(dm_ctx_t *dm_ctx, const char *module_name, const char *module_revi
     CHECK_ZERO_LOG_GOTO(ret, rc, SR_ERR_INTERNAL, cleanup, "Module %s print failed.", si->module_name);
 
 cleanup:
-    pthread_rwlock_unlock(&si->model_lock);
+    SR_RWLOCK_UNLOCK(&si->model_lock);
     return rc;
 }
 
@@ -3254,9 +3339,7 @@ dm_update_session_data_trees(dm_ctx_t *dm_ctx, dm_session_t *session, sr_list_t
                 SR_DS_CANDIDATE == session->datastore ? SR_DS_RUNNING : session->datastore,
                 &file_name);
         CHECK_RC_MSG_GOTO(rc, cleanup, "Get data file name failed");
-        ac_set_user_identity(dm_ctx->ac_ctx, session->user_credentials);
-        fd = open(file_name, O_RDONLY);
-        ac_unset_user_identity(dm_ctx->ac_ctx, session->user_credentials);
+        fd = ac_open_file(dm_ctx->ac_ctx, session->user_credentials, file_name, O_RDONLY, 0);
 
         if (-1 == fd) {
             SR_LOG_DBG("File %s can not be opened for read write", file_name);
@@ -3332,6 +3415,176 @@ dm_remove_operations_with_error(dm_session_t *session)
     }
 }
 
+/**
+ * @brief Compares two subscription index entries by their schema node.
+ */
+static int
+dm_subscription_index_cmp(const void *a, const void *b)
+{
+    const dm_subscription_index_t *entry_a = (const dm_subscription_index_t *) a;
+    const dm_subscription_index_t *entry_b = (const dm_subscription_index_t *) b;
+
+    if (entry_a->node == entry_b->node) {
+        return 0;
+    }
+    return (entry_a->node < entry_b->node) ? -1 : 1;
+}
+
+/**
+ * @brief Frees a subscription index entry.
+ */
+static void
+dm_subscription_index_free(void *item)
+{
+    dm_subscription_index_t *entry = (dm_subscription_index_t *) item;
+
+    if (NULL != entry) {
+        sr_bitset_cleanup(entry->subscribed);
+        sr_bitset_cleanup(entry->nested);
+        free(entry);
+    }
+}
+
+/**
+ * @brief Returns the subscription index entry of the schema node, creates it if it does not exist yet.
+ */
+static int
+dm_subscription_index_get(dm_model_subscription_t *ms, const struct lys_node *node, dm_subscription_index_t **entry_p)
+{
+    dm_subscription_index_t lookup = { 0, }, *entry = NULL;
+    int rc = SR_ERR_OK;
+
+    lookup.node = node;
+    entry = sr_btree_search(ms->node_index, &lookup);
+    if (NULL != entry) {
+        *entry_p = entry;
+        return SR_ERR_OK;
+    }
+
+    entry = calloc(1, sizeof(*entry));
+    CHECK_NULL_NOMEM_RETURN(entry);
+    entry->node = node;
+
+    rc = sr_bitset_init(ms->subscriptions->count, &entry->subscribed);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Bitset init failed");
+    rc = sr_bitset_init(ms->subscriptions->count, &entry->nested);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Bitset init failed");
+
+    rc = sr_btree_insert(ms->node_index, entry);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to insert a subscription index entry");
+
+    *entry_p = entry;
+    return SR_ERR_OK;
+
+cleanup:
+    dm_subscription_index_free(entry);
+    return rc;
+}
+
+/**
+ * @brief Builds the index of the module subscriptions by schema nodes. Each subscription is recorded
+ * in the entry of its node and, as a nested one, in the entries of all ancestors of the node, so that
+ * the subscriptions matching a change can be found without testing each of them separately.
+ */
+static int
+dm_build_subscription_index(dm_model_subscription_t *ms)
+{
+    dm_subscription_index_t *entry = NULL;
+    const struct lys_node *n = NULL;
+    int rc = SR_ERR_OK;
+
+    rc = sr_btree_init(dm_subscription_index_cmp, dm_subscription_index_free, &ms->node_index);
+    CHECK_RC_MSG_RETURN(rc, "Binary tree allocation failed");
+
+    rc = sr_bitset_init(ms->subscriptions->count, &ms->module_subs);
+    CHECK_RC_MSG_RETURN(rc, "Bitset init failed");
+
+    for (size_t s = 0; s < ms->subscriptions->count; s++) {
+        if (NULL == ms->nodes[s]) {
+            /* subscription to the whole module or unresolved node - matches any change */
+            rc = sr_bitset_set(ms->module_subs, s, true);
+            CHECK_RC_MSG_RETURN(rc, "Bitset set failed");
+            continue;
+        }
+
+        rc = dm_subscription_index_get(ms, ms->nodes[s], &entry);
+        CHECK_RC_MSG_RETURN(rc, "Failed to build the subscription index");
+        rc = sr_bitset_set(entry->subscribed, s, true);
+        CHECK_RC_MSG_RETURN(rc, "Bitset set failed");
+
+        for (n = lys_parent(ms->nodes[s]); NULL != n; n = lys_parent(n)) {
+            rc = dm_subscription_index_get(ms, n, &entry);
+            CHECK_RC_MSG_RETURN(rc, "Failed to build the subscription index");
+            rc = sr_bitset_set(entry->nested, s, true);
+            CHECK_RC_MSG_RETURN(rc, "Bitset set failed");
+        }
+    }
+
+    return rc;
+}
+
+/**
+ * @brief Adds the subscriptions matching the changed node into the bitset. Equivalent to testing
+ * each subscription by ::dm_match_subscription, using the subscription index.
+ *
+ * @param [in] ms Module subscriptions with built index.
+ * @param [in] node Changed node.
+ * @param [in,out] matched Bitset of the matching subscriptions.
+ * @return Error code (SR_ERR_OK on success)
+ */
+static int
+dm_match_subscriptions_indexed(dm_model_subscription_t *ms, const struct lyd_node *node, sr_bitset_t *matched)
+{
+    dm_subscription_index_t lookup = { 0, }, *entry = NULL, *node_entry = NULL;
+    struct lyd_node *next = NULL, *iter = NULL;
+    const struct lys_node *n = NULL;
+    bool contains = false;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG5(ms, ms->node_index, ms->module_subs, node, matched);
+
+    rc = sr_bitset_union(matched, ms->module_subs);
+    CHECK_RC_MSG_RETURN(rc, "Bitset union failed");
+
+    /* subscriptions to the node or any of its ancestors */
+    for (n = node->schema; NULL != n; n = lys_parent(n)) {
+        lookup.node = n;
+        entry = sr_btree_search(ms->node_index, &lookup);
+        if (NULL != entry) {
+            if (n == node->schema) {
+                node_entry = entry;
+            }
+            rc = sr_bitset_union(matched, entry->subscribed);
+            CHECK_RC_MSG_RETURN(rc, "Bitset union failed");
+        }
+    }
+
+    /* a container/list has been created/deleted - subscriptions to its descendants
+     * match if an instance of the subscribed node is present in the subtree */
+    if (NULL == node_entry || !((LYS_CONTAINER | LYS_LIST) & node->schema->nodetype) || sr_bitset_empty(node_entry->nested)) {
+        return SR_ERR_OK;
+    }
+    rc = sr_bitset_contains(matched, node_entry->nested, &contains);
+    CHECK_RC_MSG_RETURN(rc, "Bitset test failed");
+    if (contains) {
+        return SR_ERR_OK;
+    }
+
+    LY_TREE_DFS_BEGIN((struct lyd_node *) node, next, iter) {
+        if (iter != node) {
+            lookup.node = iter->schema;
+            entry = sr_btree_search(ms->node_index, &lookup);
+            if (NULL != entry) {
+                rc = sr_bitset_union(matched, entry->subscribed);
+                CHECK_RC_MSG_RETURN(rc, "Bitset union failed");
+            }
+        }
+        LYD_TREE_DFS_END(node, next, iter);
+    }
+
+    return SR_ERR_OK;
+}
+
 /**
  * @brief whether the node match the subscribed one - if it is the same node or children
  * of the subscribed one
@@ -3511,6 +3764,7 @@ dm_prepare_module_subscriptions(dm_ctx_t *dm_ctx, dm_session_t *session, dm_sche
     CHECK_NULL_NOMEM_RETURN(ms);
 
     pthread_rwlock_init(&ms->changes_lock, NULL);
+    pthread_mutex_init(&ms->change_views_lock, NULL);
 
     rc = np_get_module_change_subscriptions(dm_ctx->np_ctx,
             session->user_credentials,
@@ -3536,9 +3790,13 @@ dm_prepare_module_subscriptions(dm_ctx_t *dm_ctx, dm_session_t *session, dm_sche
                         &ms->nodes[s]);
                 if (SR_ERR_OK != rc || NULL == ms->nodes[s]) {
                     SR_LOG_WRN("Node for xpath %s has not been found", sub->xpath);
+                    ms->nodes[s] = NULL;
                 }
             }
         }
+
+        rc = dm_build_subscription_index(ms);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to build the subscription index");
     }
 
     ms->schema_info = schema_info;
@@ -3594,7 +3852,9 @@ dm_insert_commit_context(dm_ctx_t *dm_ctx, dm_commit_context_t *c_ctx)
 {
     CHECK_NULL_ARG2(dm_ctx, c_ctx);
     int rc = SR_ERR_OK;
+    SR_LOCK_PROF_WAIT(&dm_ctx->commit_ctxs.lock);
     RWLOCK_WRLOCK_TIMED_CHECK_RETURN(&dm_ctx->commit_ctxs.lock);
+    SR_LOCK_PROF_ACQUIRED(&dm_ctx->commit_ctxs.lock, "commit_ctxs_lock");
     pthread_mutex_lock(&dm_ctx->commit_ctxs.empty_mutex);
     if (!dm_ctx->commit_ctxs.commits_blocked) {
         rc = sr_btree_insert(dm_ctx->commit_ctxs.tree, c_ctx);
@@ -3607,14 +3867,14 @@ dm_insert_commit_context(dm_ctx_t *dm_ctx, dm_commit_context_t *c_ctx)
         rc = SR_ERR_OPERATION_FAILED;
     }
     pthread_mutex_unlock(&dm_ctx->commit_ctxs.empty_mutex);
-    pthread_rwlock_unlock(&dm_ctx->commit_ctxs.lock);
+    SR_RWLOCK_UNLOCK(&dm_ctx->commit_ctxs.lock);
     return rc;
 }
 
 static int
 dm_remove_commit_context(dm_ctx_t *dm_ctx, uint32_t c_ctx_id)
 {
-    pthread_rwlock_wrlock(&dm_ctx->commit_ctxs.lock);
+    SR_RWLOCK_WRLOCK(&dm_ctx->commit_ctxs.lock, "commit_ctxs_lock");
     dm_commit_context_t *c_ctx = NULL;
     dm_commit_context_t lookup = {0};
     lookup.id = c_ctx_id;
@@ -3631,7 +3891,7 @@ dm_remove_commit_context(dm_ctx_t *dm_ctx, uint32_t c_ctx_id)
         }
         pthread_mutex_unlock(&dm_ctx->commit_ctxs.empty_mutex);
     }
-    pthread_rwlock_unlock(&dm_ctx->commit_ctxs.lock);
+    SR_RWLOCK_UNLOCK(&dm_ctx->commit_ctxs.lock);
     return SR_ERR_OK;
 }
 
@@ -3681,7 +3941,7 @@ static int
 dm_create_commit_ctx_id(dm_ctx_t *dm_ctx, dm_commit_context_t *c_ctx) {
     CHECK_NULL_ARG2(dm_ctx, c_ctx);
 
-    pthread_rwlock_rdlock(&dm_ctx->commit_ctxs.lock);
+    SR_RWLOCK_RDLOCK(&dm_ctx->commit_ctxs.lock, "commit_ctxs_lock");
     size_t attempts = 0;
     /* generate unique id */
     do {
@@ -3691,12 +3951,12 @@ dm_create_commit_ctx_id(dm_ctx_t *dm_ctx, dm_commit_context_t *c_ctx) {
         }
         if (++attempts > DM_COMMIT_CTX_ID_MAX_ATTEMPTS) {
             SR_LOG_ERR_MSG("Unable to generate an unique session_id.");
-            pthread_rwlock_unlock(&dm_ctx->commit_ctxs.lock);
+            SR_RWLOCK_UNLOCK(&dm_ctx->commit_ctxs.lock);
             return SR_ERR_INTERNAL;
         }
     } while (DM_COMMIT_CTX_ID_INVALID == c_ctx->id);
 
-    pthread_rwlock_unlock(&dm_ctx->commit_ctxs.lock);
+    SR_RWLOCK_UNLOCK(&dm_ctx->commit_ctxs.lock);
     return SR_ERR_OK;
 }
 
@@ -3894,8 +4154,6 @@ dm_commit_load_modified_models(dm_ctx_t *dm_ctx, const dm_session_t *session, dm
     }
     i = 0;
 
-    ac_set_user_identity(dm_ctx->ac_ctx, session->user_credentials);
-
     while (NULL != (info = sr_btree_get_at(session->session_modules[session->datastore], i++))) {
         if (!info->modified) {
             continue;
@@ -3903,7 +4161,7 @@ dm_commit_load_modified_models(dm_ctx_t *dm_ctx, const dm_session_t *session, dm
         rc = sr_get_data_file_name(dm_ctx->data_search_dir, info->schema->module->name, c_ctx->session->datastore, &file_name);
         CHECK_RC_MSG_GOTO(rc, cleanup, "Get data file name failed");
 
-        c_ctx->fds[count] = open(file_name, O_RDWR);
+        c_ctx->fds[count] = ac_open_file(dm_ctx->ac_ctx, session->user_credentials, file_name, O_RDWR, 0);
         if (-1 == c_ctx->fds[count]) {
             SR_LOG_DBG("File %s can not be opened for read write", file_name);
             if (EACCES == errno) {
@@ -3919,7 +4177,8 @@ dm_commit_load_modified_models(dm_ctx_t *dm_ctx, const dm_session_t *session, dm
 
             if (ENOENT == errno) {
                 SR_LOG_DBG("File %s does not exist, trying to create an empty one", file_name);
-                c_ctx->fds[count] = open(file_name, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+                c_ctx->fds[count] = ac_open_file(dm_ctx->ac_ctx, session->user_credentials, file_name, O_RDWR | O_CREAT,
+                        S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
                 CHECK_NOT_MINUS1_LOG_GOTO(c_ctx->fds[count], rc, SR_ERR_IO, cleanup, "File %s can not be created", file_name);
             }
         } else {
@@ -4018,12 +4277,9 @@ dm_commit_load_modified_models(dm_ctx_t *dm_ctx, const dm_session_t *session, dm
         count++;
     }
 
-    ac_unset_user_identity(dm_ctx->ac_ctx, session->user_credentials);
-
     return rc;
 
 cleanup:
-    ac_unset_user_identity(dm_ctx->ac_ctx, session->user_credentials);
     free(file_name);
     return rc;
 }
@@ -4354,6 +4610,7 @@ dm_commit_notify(dm_ctx_t *dm_ctx, dm_session_t *session, sr_notif_event_t ev, d
     size_t i = 0;
     dm_data_info_t *info = NULL, *commit_info = NULL, *prev_info = NULL, lookup_info = {0};
     dm_model_subscription_t *ms = NULL;
+    sr_bitset_t *matched = NULL;
     bool match = false;
     sr_list_t *notified_notif = NULL;
     dm_module_difflist_t *module_difflist = NULL, lookup_difflist = {0};
@@ -4433,13 +4690,7 @@ dm_commit_notify(dm_ctx_t *dm_ctx, dm_session_t *session, sr_notif_event_t ev, d
             }
 
             /* remove changes generated during verify phase */
-            if (NULL != ms->changes) {
-                for (int i = 0; i < ms->changes->count; i++) {
-                    sr_free_changes(ms->changes->data[i], 1);
-                }
-                sr_list_cleanup(ms->changes);
-            }
-            ms->changes = NULL;
+            dm_model_subscription_free_changes(ms);
 
             lyd_free_diff(ms->difflist);
             ms->changes_generated = false;
@@ -4461,55 +4712,78 @@ dm_commit_notify(dm_ctx_t *dm_ctx, dm_session_t *session, sr_notif_event_t ev, d
             continue;
         }
 
-        /* loop through subscription test if they should be notified */
-        if (NULL != ms->subscriptions) {
-            for (size_t s = 0; s < ms->subscriptions->count; s++) {
-                np_subscription_t *sub = ms->subscriptions->data[s];
-                if (dm_should_skip_subscription(sub, c_ctx, ev)) {
+        /* find the subscriptions matching any of the changes */
+        if (NULL == ms->subscriptions || 0 == ms->subscriptions->count) {
+            continue;
+        }
+        rc = sr_bitset_init(ms->subscriptions->count, &matched);
+        if (SR_ERR_OK != rc) {
+            SR_LOG_ERR("Bitset init failed, no notifications sent for module %s", info->schema->module->name);
+            continue;
+        }
+
+        const struct lys_node *last_schema = NULL;
+        for (d_cnt = 0; LYD_DIFF_END != ms->difflist->type[d_cnt]; d_cnt++) {
+            if ((ms->difflist->type[d_cnt] == LYD_DIFF_CHANGED)
+                    && ((ms->difflist->first[d_cnt]->schema->nodetype == LYS_LEAF)
+                    || (ms->difflist->first[d_cnt]->schema->nodetype == LYS_LEAFLIST))
+                    && !strcmp(((struct lyd_node_leaf_list *)ms->difflist->first[d_cnt])->value_str,
+                               ((struct lyd_node_leaf_list *)ms->difflist->second[d_cnt])->value_str)) {
+                /* skip implicit default changed to explicit or vice versa */
+                if (((struct lyd_node_leaf_list *)ms->difflist->first[d_cnt])->dflt
+                        == ((struct lyd_node_leaf_list *)ms->difflist->second[d_cnt])->dflt) {
+                    SR_LOG_ERR_MSG("Invalid lyd_diff() return value");
                     continue;
                 }
+                continue;
+            }
 
-                for (d_cnt = 0; LYD_DIFF_END != ms->difflist->type[d_cnt]; d_cnt++) {
-                    if ((ms->difflist->type[d_cnt] == LYD_DIFF_CHANGED)
-                            && ((ms->difflist->first[d_cnt]->schema->nodetype == LYS_LEAF)
-                            || (ms->difflist->first[d_cnt]->schema->nodetype == LYS_LEAFLIST))
-                            && !strcmp(((struct lyd_node_leaf_list *)ms->difflist->first[d_cnt])->value_str,
-                                       ((struct lyd_node_leaf_list *)ms->difflist->second[d_cnt])->value_str)) {
-                        /* skip implicit default changed to explicit or vice versa */
-                        if (((struct lyd_node_leaf_list *)ms->difflist->first[d_cnt])->dflt
-                                == ((struct lyd_node_leaf_list *)ms->difflist->second[d_cnt])->dflt) {
-                            SR_LOG_ERR_MSG("Invalid lyd_diff() return value");
-                            continue;
-                        }
-                        continue;
-                    }
+            const struct lyd_node *cmp_node = dm_get_notification_match_node(ms->difflist, d_cnt);
+            if (cmp_node->schema == last_schema && !((LYS_CONTAINER | LYS_LIST) & cmp_node->schema->nodetype)) {
+                /* subscriptions matching this schema node have been already added */
+                continue;
+            }
+            last_schema = cmp_node->schema;
+            rc = dm_match_subscriptions_indexed(ms, cmp_node, matched);
+            if (SR_ERR_OK != rc) {
+                SR_LOG_WRN_MSG("Subscription match failed");
+                continue;
+            }
+        }
 
-                    const struct lyd_node *cmp_node = dm_get_notification_match_node(ms->difflist, d_cnt);
-                    rc = dm_match_subscription(ms->nodes[s], cmp_node, &match);
+        /* notify the matching subscriptions in the order of priority */
+        for (size_t s = 0; s < ms->subscriptions->count; s++) {
+            np_subscription_t *sub = ms->subscriptions->data[s];
+            if (dm_should_skip_subscription(sub, c_ctx, ev)) {
+                continue;
+            }
+            sr_bitset_get(matched, s, &match);
+            if (match) {
+                /* something has been changed for this subscription, send notification */
+                sr_list_t *inline_changes = NULL;
+                if (sub->inline_changes) {
+                    rc = rp_dt_get_subscription_changes(ms, ms->nodes[s], &inline_changes);
                     if (SR_ERR_OK != rc) {
-                        SR_LOG_WRN_MSG("Subscription match failed");
-                        continue;
-                    }
-                    if (match) {
-                        break;
+                        SR_LOG_WRN("Unable to select the changes to be sent inline for the subscription in module %s xpath %s.",
+                                sub->module_name, sub->xpath);
+                        inline_changes = NULL;
                     }
                 }
-
-                if (match) {
-                    /* something has been changed for this subscription, send notification */
-                    rc = np_subscription_notify(dm_ctx->np_ctx, sub, ev, c_ctx->id);
-                    if (SR_ERR_OK != rc) {
-                       SR_LOG_WRN("Unable to send notifications about the changes for the subscription in module %s xpath %s.",
-                               sub->module_name,
-                               sub->xpath);
-                    }
-                    rc = sr_list_add(notified_notif, sub);
-                    if (SR_ERR_OK != rc) {
-                       SR_LOG_WRN_MSG("List add failed");
-                    }
+                rc = np_subscription_notify(dm_ctx->np_ctx, sub, ev, c_ctx->id, inline_changes);
+                if (SR_ERR_OK != rc) {
+                   SR_LOG_WRN("Unable to send notifications about the changes for the subscription in module %s xpath %s.",
+                           sub->module_name,
+                           sub->xpath);
+                }
+                sr_list_cleanup(inline_changes);
+                rc = sr_list_add(notified_notif, sub);
+                if (SR_ERR_OK != rc) {
+                   SR_LOG_WRN_MSG("List add failed");
                 }
             }
         }
+        sr_bitset_cleanup(matched);
+        matched = NULL;
     }
 
     if (SR_EV_VERIFY == ev) {
@@ -4565,12 +4839,12 @@ dm_feature_enable(dm_ctx_t *dm_ctx, const char *module_name, const char *feature
     CHECK_RC_LOG_RETURN(rc, "dm_get_module %s and lock failed", module_name);
 
     rc = dm_feature_enable_internal(dm_ctx, schema_info, module_name, feature_name, enable);
-    pthread_rwlock_unlock(&schema_info->model_lock);
+    SR_RWLOCK_UNLOCK(&schema_info->model_lock);
     CHECK_RC_LOG_RETURN(rc, "Failed to %s feature '%s' in module '%s'.", enable ? "enable" : "disable", feature_name, module_name);
 
     /* apply the change in all loaded schema infos */
     md_ctx_lock(dm_ctx->md_ctx, true);
-    pthread_rwlock_wrlock(&dm_ctx->schema_tree_lock);
+    SR_RWLOCK_WRLOCK(&dm_ctx->schema_tree_lock, "schema_tree_lock");
     rc = md_get_module_info(dm_ctx->md_ctx, module_name, NULL, &module);
     CHECK_RC_LOG_GOTO(rc, cleanup, "Get module %s info failed", module_name);
 
@@ -4586,7 +4860,7 @@ dm_feature_enable(dm_ctx_t *dm_ctx, const char *module_name, const char *feature
                 CHECK_RC_LOG_GOTO(rc, cleanup, "Failed to lock schema info %s", si->module_name);
 
                 rc = dm_feature_enable_internal(dm_ctx, si, module_name, feature_name, enable);
-                pthread_rwlock_unlock(&si->model_lock);
+                SR_RWLOCK_UNLOCK(&si->model_lock);
                 CHECK_RC_LOG_GOTO(rc, cleanup, "Failed to load schema %s", module->filepath);
             }
         }
@@ -4594,7 +4868,7 @@ dm_feature_enable(dm_ctx_t *dm_ctx, const char *module_name, const char *feature
     }
 
 cleanup:
-    pthread_rwlock_unlock(&dm_ctx->schema_tree_lock);
+    SR_RWLOCK_UNLOCK(&dm_ctx->schema_tree_lock);
     md_ctx_unlock(dm_ctx->md_ctx);
 
     return rc;
@@ -4616,7 +4890,7 @@ dm_install_module(dm_ctx_t *dm_ctx, dm_session_t *session, const char *module_na
 
     /* insert module into the dependency graph */
     md_ctx_lock(dm_ctx->md_ctx, true);
-    pthread_rwlock_wrlock(&dm_ctx->schema_tree_lock);
+    SR_RWLOCK_WRLOCK(&dm_ctx->schema_tree_lock, "schema_tree_lock");
 
     rc = md_insert_module(dm_ctx->md_ctx, file_name, &implicitly_installed);
     CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to insert module into the dependency graph");
@@ -4627,7 +4901,9 @@ dm_install_module(dm_ctx_t *dm_ctx, dm_session_t *session, const char *module_na
     lookup.module_name = (char *) module_name;
     si = sr_btree_search(dm_ctx->schema_info_tree, &lookup);
     if (NULL != si) {
+        SR_LOCK_PROF_WAIT(&si->model_lock);
         RWLOCK_WRLOCK_TIMED_CHECK_GOTO(&si->model_lock, rc, cleanup);
+        SR_LOCK_PROF_ACQUIRED(&si->model_lock, "model_lock");
         if (NULL != si->ly_ctx) {
             SR_LOG_WRN("Module %s already loaded", si->module_name);
             goto unlock;
@@ -4711,14 +4987,14 @@ dm_install_module(dm_ctx_t *dm_ctx, dm_session_t *session, const char *module_na
             ll_node = ll_node->next;
         }
 unlock:
-        pthread_rwlock_unlock(&si->model_lock);
+        SR_RWLOCK_UNLOCK(&si->model_lock);
     } else {
         /* module is installed for the first time, will be loaded when a request
          * into this module is received */
         SR_LOG_DBG("Module %s will be loaded when a request for it comes", module_name);
     }
 cleanup:
-    pthread_rwlock_unlock(&dm_ctx->schema_tree_lock);
+    SR_RWLOCK_UNLOCK(&dm_ctx->schema_tree_lock);
     md_ctx_unlock(dm_ctx->md_ctx);
     if (SR_ERR_OK == rc) {
         *implicitly_installed_p = implicitly_installed;
@@ -4743,12 +5019,14 @@ dm_uninstall_module_schema(dm_ctx_t *dm_ctx, const char *module_name, const char
     dm_schema_info_t lookup = {0};
     dm_schema_info_t *schema_info = NULL;
 
+    SR_LOCK_PROF_WAIT(&dm_ctx->schema_tree_lock);
     RWLOCK_RDLOCK_TIMED_CHECK_RETURN(&dm_ctx->schema_tree_lock);
+    SR_LOCK_PROF_ACQUIRED(&dm_ctx->schema_tree_lock, "schema_tree_lock");
     lookup.module_name = (char *) module_name;
 
     schema_info = sr_btree_search(dm_ctx->schema_info_tree, &lookup);
     if (NULL != schema_info) {
-        pthread_rwlock_wrlock(&schema_info->model_lock);
+        SR_RWLOCK_WRLOCK(&schema_info->model_lock, "model_lock");
         if (NULL != schema_info->ly_ctx){
             pthread_mutex_lock(&schema_info->usage_count_mutex);
             if (0 != schema_info->usage_count) {
@@ -4762,12 +5040,12 @@ dm_uninstall_module_schema(dm_ctx_t *dm_ctx, const char *module_name, const char
             }
             pthread_mutex_unlock(&schema_info->usage_count_mutex);
         }
-        pthread_rwlock_unlock(&schema_info->model_lock);
+        SR_RWLOCK_UNLOCK(&schema_info->model_lock);
     } else {
         SR_LOG_DBG("Module %s is not loaded, can be uninstalled safely", module_name);
     }
 
-    pthread_rwlock_unlock(&dm_ctx->schema_tree_lock);
+    SR_RWLOCK_UNLOCK(&dm_ctx->schema_tree_lock);
 
     CHECK_RC_LOG_RETURN(rc, "Uninstallation of module %s was not successful", module_name);
     return rc;
@@ -4936,6 +5214,8 @@ dm_create_difflist_for_enabled_notif(dm_ctx_t *dm_ctx, const ac_ucred_t *user_cr
     ms = calloc(1, sizeof(*ms));
     CHECK_NULL_NOMEM_RETURN(ms);
 
+    pthread_rwlock_init(&ms->changes_lock, NULL);
+    pthread_mutex_init(&ms->change_views_lock, NULL);
     ms->schema_info = copied_di->schema;
 
     ms->difflist = lyd_diff(NULL, copied_di->node, LYD_DIFFOPT_WITHDEFAULTS);
@@ -4977,12 +5257,17 @@ static int
 dm_send_enabled_notification(dm_ctx_t *dm_ctx, dm_commit_context_t *c_ctx, const np_subscription_t *subscription) {
     int rc = SR_ERR_OK;
     sr_list_t *notif_list = NULL;
+    sr_list_t *inline_changes = NULL;
+    dm_model_subscription_t *ms = NULL;
 
     CHECK_NULL_ARG_NORET3(rc, dm_ctx, c_ctx, subscription);
     if (SR_ERR_OK != rc) {
         goto cleanup;
     }
 
+    /* the diff of the only module has been already restricted to the subscription */
+    ms = sr_btree_get_at(c_ctx->subscriptions, 0);
+
     rc = dm_insert_commit_context(dm_ctx, c_ctx);
     CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to insert commit context");
 
@@ -4996,7 +5281,12 @@ dm_send_enabled_notification(dm_ctx_t *dm_ctx, dm_commit_context_t *c_ctx, const
     rc = sr_list_add(notif_list, (void *) subscription);
     CHECK_RC_MSG_GOTO(rc, cleanup, "List insert failed");
 
-    rc = np_subscription_notify(dm_ctx->np_ctx, (np_subscription_t *) subscription, SR_EV_ENABLED, commit_id);
+    if (subscription->inline_changes && NULL != ms) {
+        rc = rp_dt_get_subscription_changes(ms, NULL, &inline_changes);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to select the changes to be sent inline");
+    }
+
+    rc = np_subscription_notify(dm_ctx->np_ctx, (np_subscription_t *) subscription, SR_EV_ENABLED, commit_id, inline_changes);
     CHECK_RC_MSG_GOTO(rc, cleanup, "Sending of SR_EV_ENABLED notification failed");
 
     rc = np_commit_notifications_sent(dm_ctx->np_ctx, commit_id, true, notif_list);
@@ -5006,6 +5296,7 @@ cleanup:
     if (SR_ERR_OK != rc) {
         dm_free_commit_context(c_ctx);
     }
+    sr_list_cleanup(inline_changes);
     sr_list_cleanup(notif_list);
     return rc;
 }
@@ -5106,13 +5397,8 @@ dm_copy_config(dm_ctx_t *dm_ctx, dm_session_t *session, const sr_list_t *module_
             rc = sr_get_data_file_name(dm_ctx->data_search_dir, module_name, dst_session->datastore, &file_name);
             CHECK_RC_MSG_GOTO(rc, cleanup, "Get data file name failed");
 
-            if (NULL != session) {
-                ac_set_user_identity(dm_ctx->ac_ctx, session->user_credentials);
-            }
-            fds[opened_files] = open(file_name, O_RDWR | O_TRUNC);
-            if (NULL != session) {
-                ac_unset_user_identity(dm_ctx->ac_ctx, session->user_credentials);
-            }
+            fds[opened_files] = ac_open_file(dm_ctx->ac_ctx, NULL != session ? session->user_credentials : NULL,
+                    file_name, O_RDWR | O_TRUNC, 0);
             if (-1 == fds[opened_files]) {
                 SR_LOG_ERR("File %s can not be opened", file_name);
                 free(file_name);
@@ -5225,7 +5511,7 @@ dm_has_enabled_subtree(dm_ctx_t *ctx, const char *module_name, dm_schema_info_t
     if (NULL != schema) {
         *schema = schema_info;
     }
-    pthread_rwlock_unlock(&schema_info->model_lock);
+    SR_RWLOCK_UNLOCK(&schema_info->model_lock);
     return rc;
 }
 
@@ -5241,7 +5527,7 @@ dm_enable_module_running(dm_ctx_t *ctx, dm_session_t *session, const char *modul
     CHECK_RC_LOG_RETURN(rc, "Lock schema %s for write failed", module_name);
 
     rc = dm_enable_module_running_internal(ctx, session, si, module_name);
-    pthread_rwlock_unlock(&si->model_lock);
+    SR_RWLOCK_UNLOCK(&si->model_lock);
     CHECK_RC_LOG_RETURN(rc, "Enable module %s running failed", module_name);
 
     rc = dm_copy_module(ctx, session, module_name, SR_DS_STARTUP, SR_DS_RUNNING, subscription);
@@ -5425,7 +5711,7 @@ dm_enable_module_subtree_running(dm_ctx_t *ctx, dm_session_t *session, const cha
     CHECK_RC_LOG_RETURN(rc, "Lock schema %s for write failed", module_name);
 
     rc = dm_enable_module_subtree_running_internal(ctx, session, si, module_name, xpath);
-    pthread_rwlock_unlock(&si->model_lock);
+    SR_RWLOCK_UNLOCK(&si->model_lock);
     CHECK_RC_LOG_RETURN(rc, "Enabling of xpath %s failed", xpath);
 
     rc = dm_copy_subtree_startup_running(ctx, session, module_name, si, xpath, subscription);
@@ -5487,7 +5773,7 @@ dm_disable_module_running(dm_ctx_t *ctx, dm_session_t *session, const char *modu
         }
     }
 cleanup:
-    pthread_rwlock_unlock(&schema_info->model_lock);
+    SR_RWLOCK_UNLOCK(&schema_info->model_lock);
     sr_list_cleanup(stack);
 
     return rc;
@@ -5873,34 +6159,17 @@ dm_skip_procedure_content_validation(const char *xpath)
 }
 
 /**
- * @brief Validates arguments of a procedure (RPC, Event notification, Action).
- * @param [in] dm_ctx DM context.
- * @param [in] session DM session.
- * @param [in] type Type of the procedure.
- * @param [in] xpath XPath of the procedure.
- * @param [in] api_variant Variant of the API (values vs. trees)
- * @param [in] args_p Input/output arguments of the procedure.
- * @param [in] arg_cnt_p Number of input/output arguments provided.
- * @param [in] input TRUE if input arguments were provided, FALSE if output.
- * @param [out] with_def Input/Output arguments including default values represented as sysrepo values.
- * @param [out] with_def_cnt Number of items inside the *with_def* array.
- * @param [out] with_def_tree Input/Output arguments including default values represented as sysrepo trees.
- * @param [out] with_def_tree_cnt Number of items inside the *with_def_tree* array.
- * @param [out] res_data_tree Resulting data tree, can be NULL in case that the caller does not need it.
- * @return Error code (SR_ERR_OK on success)
+ * @brief Validates xpath of a procedure (RPC, Event notification, Action) - tests the presence of the procedure
+ * in the schema tree and (for event notifications and actions) of its parent node in the data tree.
  */
 static int
-dm_validate_procedure(dm_ctx_t *dm_ctx, dm_session_t *session, dm_procedure_t type, const char *xpath,
-        sr_api_variant_t api_variant, void *args_p, size_t arg_cnt, bool input,
-        sr_mem_ctx_t *sr_mem, sr_val_t **with_def, size_t *with_def_cnt, sr_node_t **with_def_tree, size_t *with_def_tree_cnt,
-        struct lyd_node **res_data_tree, struct ly_ctx **res_ctx)
+dm_validate_procedure_xpath(dm_ctx_t *dm_ctx, dm_session_t *session, dm_procedure_t type, const char *xpath,
+        dm_data_info_t **di_p, const struct lys_node **proc_node_p)
 {
     dm_data_info_t *di = NULL;
     const struct lys_node *proc_node = NULL;
-    struct lyd_node *data_tree = NULL;
     char *tmp_xpath = NULL;
     struct ly_set *nodeset = NULL;
-    struct ly_ctx *tmp_ctx = NULL;
     char *module_name = NULL;
     const char *procedure_name = NULL;
     const char *last_delim = NULL;
@@ -5971,6 +6240,54 @@ dm_validate_procedure(dm_ctx_t *dm_ctx, dm_session_t *session, dm_procedure_t ty
         }
     }
 
+    if (NULL != di_p) {
+        *di_p = di;
+    }
+    if (NULL != proc_node_p) {
+        *proc_node_p = proc_node;
+    }
+
+cleanup:
+    free(module_name);
+    return rc;
+}
+
+/**
+ * @brief Validates arguments of a procedure (RPC, Event notification, Action).
+ * @param [in] dm_ctx DM context.
+ * @param [in] session DM session.
+ * @param [in] type Type of the procedure.
+ * @param [in] xpath XPath of the procedure.
+ * @param [in] api_variant Variant of the API (values vs. trees)
+ * @param [in] args_p Input/output arguments of the procedure.
+ * @param [in] arg_cnt_p Number of input/output arguments provided.
+ * @param [in] input TRUE if input arguments were provided, FALSE if output.
+ * @param [out] with_def Input/Output arguments including default values represented as sysrepo values.
+ * @param [out] with_def_cnt Number of items inside the *with_def* array.
+ * @param [out] with_def_tree Input/Output arguments including default values represented as sysrepo trees.
+ * @param [out] with_def_tree_cnt Number of items inside the *with_def_tree* array.
+ * @param [out] res_data_tree Resulting data tree, can be NULL in case that the caller does not need it.
+ * @return Error code (SR_ERR_OK on success)
+ */
+static int
+dm_validate_procedure(dm_ctx_t *dm_ctx, dm_session_t *session, dm_procedure_t type, const char *xpath,
+        sr_api_variant_t api_variant, void *args_p, size_t arg_cnt, bool input,
+        sr_mem_ctx_t *sr_mem, sr_val_t **with_def, size_t *with_def_cnt, sr_node_t **with_def_tree, size_t *with_def_tree_cnt,
+        struct lyd_node **res_data_tree, struct ly_ctx **res_ctx)
+{
+    dm_data_info_t *di = NULL;
+    const struct lys_node *proc_node = NULL;
+    struct lyd_node *data_tree = NULL;
+    struct ly_ctx *tmp_ctx = NULL;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG3(dm_ctx, session, xpath);
+
+    rc = dm_validate_procedure_xpath(dm_ctx, session, type, xpath, &di, &proc_node);
+    if (SR_ERR_OK != rc) {
+        return rc;
+    }
+
     /* convert sysrepo values/trees to libyang data tree */
     rc = dm_sr_val_node_to_ly_datatree(session, di, xpath, args_p, arg_cnt, api_variant, input, &data_tree);
     CHECK_RC_MSG_GOTO(rc, cleanup, "Error by converting sysrepo values/trees to libyang data tree.");
@@ -6009,7 +6326,6 @@ dm_validate_procedure(dm_ctx_t *dm_ctx, dm_session_t *session, dm_procedure_t ty
     }
 
 cleanup:
-    free(module_name);
     if (NULL != data_tree) {
         lyd_free_withsiblings(data_tree);
     }
@@ -6072,6 +6388,24 @@ dm_validate_event_notif_tree(dm_ctx_t *dm_ctx, dm_session_t *session, const char
             res_data_tree, res_ctx);
 }
 
+int
+dm_validate_rpc_xpath(dm_ctx_t *dm_ctx, dm_session_t *session, const char *rpc_xpath)
+{
+    return dm_validate_procedure_xpath(dm_ctx, session, DM_PROCEDURE_RPC, rpc_xpath, NULL, NULL);
+}
+
+int
+dm_validate_action_xpath(dm_ctx_t *dm_ctx, dm_session_t *session, const char *action_xpath)
+{
+    return dm_validate_procedure_xpath(dm_ctx, session, DM_PROCEDURE_ACTION, action_xpath, NULL, NULL);
+}
+
+int
+dm_validate_event_notif_xpath(dm_ctx_t *dm_ctx, dm_session_t *session, const char *event_notif_xpath)
+{
+    return dm_validate_procedure_xpath(dm_ctx, session, DM_PROCEDURE_EVENT_NOTIF, event_notif_xpath, NULL, NULL);
+}
+
 int
 dm_parse_event_notif(dm_ctx_t *dm_ctx, dm_session_t *session, sr_mem_ctx_t *sr_mem, np_ev_notification_t *notification,
         const sr_api_variant_t api_variant)
@@ -6261,7 +6595,7 @@ dm_copy_session_tree(dm_ctx_t *dm_ctx, dm_session_t *from, dm_session_t *to, con
     lookup.schema = schema_info;
 
     info = sr_btree_search(from->session_modules[from->datastore], &lookup);
-    pthread_rwlock_unlock(&schema_info->model_lock);
+    SR_RWLOCK_UNLOCK(&schema_info->model_lock);
     if (NULL == info) {
         SR_LOG_DBG("Module %s not loaded in source session", module_name);
         return rc;
@@ -6361,7 +6695,7 @@ dm_copy_if_not_loaded(dm_ctx_t *dm_ctx, dm_session_t *from_session, dm_session_t
     if (NULL == info) {
         rc = dm_create_rdonly_ptr_data_tree(dm_ctx, from_session, session, schema_info);
     }
-    pthread_rwlock_unlock(&schema_info->model_lock);
+    SR_RWLOCK_UNLOCK(&schema_info->model_lock);
     return rc;
 }
 
@@ -6510,7 +6844,7 @@ dm_is_model_modified(dm_ctx_t *dm_ctx, dm_session_t *session, const char *module
     lookup.schema = schema_info;
 
     info = sr_btree_search(session->session_modules[session->datastore], &lookup);
-    pthread_rwlock_unlock(&schema_info->model_lock);
+    SR_RWLOCK_UNLOCK(&schema_info->model_lock);
 
     *res = NULL != info ? info->modified : false;
     return rc;
@@ -6545,12 +6879,16 @@ int
 dm_lock_schema_info(dm_schema_info_t *schema_info)
 {
     CHECK_NULL_ARG2(schema_info, schema_info->module_name);
+    SR_PROBE2(lock__wait__begin, "model_lock", (void *)&schema_info->model_lock);
+    SR_LOCK_PROF_WAIT(&schema_info->model_lock);
     RWLOCK_RDLOCK_TIMED_CHECK_RETURN(&schema_info->model_lock);
+    SR_LOCK_PROF_ACQUIRED(&schema_info->model_lock, "model_lock");
+    SR_PROBE2(lock__wait__end, "model_lock", (void *)&schema_info->model_lock);
     if (NULL != schema_info->ly_ctx && NULL != schema_info->module) {
         return SR_ERR_OK;
     } else {
         SR_LOG_ERR("Schema info can not be locked for module %s. Module has been uninstalled.", schema_info->module_name);
-        pthread_rwlock_unlock(&schema_info->model_lock);
+        SR_RWLOCK_UNLOCK(&schema_info->model_lock);
         return SR_ERR_UNKNOWN_MODEL;
     }
 }
@@ -6559,12 +6897,16 @@ int
 dm_lock_schema_info_write(dm_schema_info_t *schema_info)
 {
     CHECK_NULL_ARG2(schema_info, schema_info->module_name);
+    SR_PROBE2(lock__wait__begin, "model_lock", (void *)&schema_info->model_lock);
+    SR_LOCK_PROF_WAIT(&schema_info->model_lock);
     RWLOCK_WRLOCK_TIMED_CHECK_RETURN(&schema_info->model_lock);
+    SR_LOCK_PROF_ACQUIRED(&schema_info->model_lock, "model_lock");
+    SR_PROBE2(lock__wait__end, "model_lock", (void *)&schema_info->model_lock);
     if (NULL != schema_info->ly_ctx && NULL != schema_info->module) {
         return SR_ERR_OK;
     } else {
         SR_LOG_ERR("Schema info can not be locked for module %s. Module has been uninstalled.", schema_info->module_name);
-        pthread_rwlock_unlock(&schema_info->model_lock);
+        SR_RWLOCK_UNLOCK(&schema_info->model_lock);
         return SR_ERR_UNKNOWN_MODEL;
     }
 }
@@ -149,6 +149,16 @@ typedef struct dm_sess_op_s{
     }detail;
 }dm_sess_op_t;
 
+/**
+ * @brief Positions of the changes selected by one schema node - a view into the changes
+ * of a module shared by all subscribers.
+ */
+typedef struct dm_change_view_s {
+    const struct lys_node *node;        /**< Schema node selecting the changes */
+    size_t *positions;                  /**< Indices of the selected changes in the changes of the module */
+    size_t count;                       /**< Number of the selected changes */
+} dm_change_view_t;
+
 /**
  * @brief Holds subscriptions for the particular model
  * used in commit context
@@ -157,10 +167,14 @@ typedef struct dm_model_subscription_s {
     dm_schema_info_t *schema_info;      /**< schema info identifying the module to which the subscriptions are tied to */
     sr_list_t *subscriptions;           /**< list of struct received from np */
     struct lys_node **nodes;            /**< array of schema nodes corresponding to the subscription */
+    sr_btree_t *node_index;             /**< index of the subscriptions by schema nodes (used to match the changes) */
+    sr_bitset_t *module_subs;           /**< subscriptions to the whole module (or with unresolved node) */
     struct lyd_difflist *difflist;      /**< diff list */
     sr_list_t *changes;                 /**< set of changes for the model */
     bool changes_generated;             /**< Flag signalizing that changes has been generated */
     pthread_rwlock_t changes_lock;      /**< Lock guarding the changes member of structure */
+    sr_list_t *change_views;            /**< Views into the changes (dm_change_view_t *), built on demand */
+    pthread_mutex_t change_views_lock;  /**< Mutex guarding the change views (changes_lock is expected to be held too) */
 }dm_model_subscription_t;
 
 /**
@@ -613,6 +627,12 @@ uint32_t dm_get_node_xpath_hash(struct lys_node *node);
  */
 uint16_t dm_get_node_data_depth(struct lys_node *node);
 
+/**
+ * @brief Returns the ID of a data schema node, unique among all loaded schemas (IDs are not reused after
+ * a schema is reloaded). If NULL or a node without an ID is provided as the argument then 0 is returned.
+ */
+uint32_t dm_get_node_id(struct lys_node *node);
+
 /**
  * @brief Sets the state of the node.
  *
@@ -916,6 +936,36 @@ int dm_validate_event_notif_tree(dm_ctx_t *dm_ctx, dm_session_t *session, const
         sr_mem_ctx_t *sr_mem, sr_val_t **with_def, size_t *with_def_cnt, sr_node_t **with_def_tree, size_t *with_def_tree_cnt,
         struct lyd_node **res_data_tree, struct ly_ctx **res_ctx);
 
+/**
+ * @brief Validates only the xpath of a RPC - tests that the RPC is present in the schema, its arguments
+ * are not validated. Used for requests of trusted sessions, which are forwarded without the content validation.
+ * @param [in] dm_ctx DM context.
+ * @param [in] session DM session.
+ * @param [in] rpc_xpath XPath of the RPC.
+ * @return Error code (SR_ERR_OK on success)
+ */
+int dm_validate_rpc_xpath(dm_ctx_t *dm_ctx, dm_session_t *session, const char *rpc_xpath);
+
+/**
+ * @brief Validates only the xpath of an Action - tests that the Action is present in the schema and its parent
+ * node in the data tree, arguments of the Action are not validated.
+ * @param [in] dm_ctx DM context.
+ * @param [in] session DM session.
+ * @param [in] action_xpath XPath of the Action.
+ * @return Error code (SR_ERR_OK on success)
+ */
+int dm_validate_action_xpath(dm_ctx_t *dm_ctx, dm_session_t *session, const char *action_xpath);
+
+/**
+ * @brief Validates only the xpath of an event notification - tests that the notification is present in the schema
+ * and its parent node (if any) in the data tree, content of the notification is not validated.
+ * @param [in] dm_ctx DM context.
+ * @param [in] session DM session.
+ * @param [in] notif_xpath XPath of the notification.
+ * @return Error code (SR_ERR_OK on success)
+ */
+int dm_validate_event_notif_xpath(dm_ctx_t *dm_ctx, dm_session_t *session, const char *notif_xpath);
+
 /**
  * @brief Parses event notification with data in XML format (notification->type == NP_EV_NOTIF_DATA_XML) into desired
  * sysrepo format (values or trees).
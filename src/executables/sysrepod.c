@@ -141,7 +141,12 @@ main(int argc, char* argv[])
 cleanup:
     cm_cleanup(sr_cm_ctx);
 
+#ifdef ENABLE_LOCK_PROFILING
+    sr_lock_prof_dump();
+#endif
+
     SR_LOG_INF_MSG("Sysrepo daemon terminated.");
+    sr_trace_flush();
     sr_logger_cleanup();
 
     unlink(SR_DAEMON_PID_FILE);
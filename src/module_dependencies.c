@@ -1223,16 +1223,16 @@ void
 md_ctx_lock(md_ctx_t *md_ctx, bool write)
 {
     if (write) {
-        pthread_rwlock_wrlock(&md_ctx->lock);
+        SR_RWLOCK_WRLOCK(&md_ctx->lock, "md_ctx_lock");
     } else {
-        pthread_rwlock_rdlock(&md_ctx->lock);
+        SR_RWLOCK_RDLOCK(&md_ctx->lock, "md_ctx_lock");
     }
 }
 
 void
 md_ctx_unlock(md_ctx_t *md_ctx)
 {
-    pthread_rwlock_unlock(&md_ctx->lock);
+    SR_RWLOCK_UNLOCK(&md_ctx->lock);
 }
 
 int
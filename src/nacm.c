@@ -404,6 +404,268 @@ nacm_get_data_targets(nacm_data_val_ctx_t *nacm_data_val_ctx, uint16_t rule_id)
     return sr_btree_search(nacm_data_val_ctx->data_targets, &targets_lookup);
 }
 
+/**
+ * @brief Compare two instances of nacm_data_decision_t structure.
+ */
+static int
+nacm_compare_data_decisions(const void *decision1_ptr, const void *decision2_ptr)
+{
+    if (NULL == decision1_ptr || NULL == decision2_ptr) {
+        return 0;
+    }
+
+    nacm_data_decision_t *decision1 = (nacm_data_decision_t *)decision1_ptr;
+    nacm_data_decision_t *decision2 = (nacm_data_decision_t *)decision2_ptr;
+
+    if (decision1->rule_list_set != decision2->rule_list_set) {
+        return decision1->rule_list_set < decision2->rule_list_set ? -1 : 1;
+    }
+    if (decision1->node_id != decision2->node_id) {
+        return decision1->node_id < decision2->node_id ? -1 : 1;
+    }
+    return (int)decision1->access_type - (int)decision2->access_type;
+}
+
+/**
+ * @brief Get the ID of the given set of rule-lists, the set is registered if it has not been seen yet.
+ * NACM configuration is expected to be locked.
+ */
+static int
+nacm_get_rule_list_set_id(nacm_ctx_t *nacm_ctx, sr_bitset_t *rule_lists, uint32_t *set_id_p)
+{
+    int rc = SR_ERR_OK;
+    bool contains = false;
+    sr_bitset_t *set = NULL;
+    CHECK_NULL_ARG3(nacm_ctx, rule_lists, set_id_p);
+
+    *set_id_p = NACM_RULE_LIST_SET_NONE;
+
+    pthread_rwlock_wrlock(&nacm_ctx->compiled.lock);
+
+    for (size_t i = 0; i < nacm_ctx->compiled.rule_list_sets->count; ++i) {
+        set = (sr_bitset_t *)nacm_ctx->compiled.rule_list_sets->data[i];
+        rc = sr_bitset_contains(set, rule_lists, &contains);
+        CHECK_RC_MSG_GOTO(rc, unlock, "Function sr_bitset_contains has failed.");
+        if (contains) {
+            rc = sr_bitset_contains(rule_lists, set, &contains);
+            CHECK_RC_MSG_GOTO(rc, unlock, "Function sr_bitset_contains has failed.");
+        }
+        if (contains) {
+            *set_id_p = i;
+            goto unlock;
+        }
+    }
+
+    /* new set of rule-lists */
+    set = NULL;
+    rc = sr_bitset_init(rule_lists->bit_count, &set);
+    CHECK_RC_MSG_GOTO(rc, unlock, "Failed to initialize bitset.");
+    rc = sr_bitset_union(set, rule_lists);
+    CHECK_RC_MSG_GOTO(rc, unlock, "Function sr_bitset_union has failed.");
+    rc = sr_list_add(nacm_ctx->compiled.rule_list_sets, set);
+    CHECK_RC_MSG_GOTO(rc, unlock, "Failed to add item into a list.");
+    *set_id_p = nacm_ctx->compiled.rule_list_sets->count - 1;
+    set = NULL;
+
+unlock:
+    pthread_rwlock_unlock(&nacm_ctx->compiled.lock);
+    sr_bitset_cleanup(set);
+    return rc;
+}
+
+/**
+ * @brief Deallocate all memory associated with nacm_user_rule_list_set_t.
+ */
+static void
+nacm_free_user_rule_list_set(void *user_set_ptr)
+{
+    if (NULL == user_set_ptr) {
+        return;
+    }
+
+    nacm_user_rule_list_set_t *user_set = (nacm_user_rule_list_set_t *)user_set_ptr;
+    free(user_set->username);
+    free(user_set);
+}
+
+/**
+ * @brief Compare two instances of nacm_user_rule_list_set_t structure.
+ */
+static int
+nacm_compare_user_rule_list_sets(const void *user_set1_ptr, const void *user_set2_ptr)
+{
+    if (NULL == user_set1_ptr || NULL == user_set2_ptr) {
+        return 0;
+    }
+
+    nacm_user_rule_list_set_t *user_set1 = (nacm_user_rule_list_set_t *)user_set1_ptr;
+    nacm_user_rule_list_set_t *user_set2 = (nacm_user_rule_list_set_t *)user_set2_ptr;
+    return strcmp(user_set1->username, user_set2->username);
+}
+
+/**
+ * @brief Returns current time in seconds (CLOCK_MONOTONIC).
+ */
+static time_t
+nacm_monotonic_now()
+{
+    struct timespec ts = { 0, };
+
+    sr_clock_get_time(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec;
+}
+
+/**
+ * @brief Get the set of rule-lists recently matched for the given user (if any) and its ID.
+ * NACM configuration is expected to be locked.
+ */
+static int
+nacm_get_user_rule_list_set(nacm_ctx_t *nacm_ctx, const char *username, sr_bitset_t *rule_lists,
+        uint32_t *set_id_p, bool *found)
+{
+    int rc = SR_ERR_OK;
+    nacm_user_rule_list_set_t lookup = { (char *)username, 0, 0 };
+    nacm_user_rule_list_set_t *user_set = NULL;
+
+    *found = false;
+    if (0 == SR_USER_GROUPS_CACHE_TTL) {
+        return rc;
+    }
+
+    pthread_rwlock_rdlock(&nacm_ctx->compiled.lock);
+    user_set = sr_btree_search(nacm_ctx->compiled.users, &lookup);
+    if (NULL != user_set && user_set->expires > nacm_monotonic_now()) {
+        rc = sr_bitset_union(rule_lists, (sr_bitset_t *)nacm_ctx->compiled.rule_list_sets->data[user_set->rule_list_set]);
+        if (SR_ERR_OK == rc) {
+            *set_id_p = user_set->rule_list_set;
+            *found = true;
+        }
+    }
+    pthread_rwlock_unlock(&nacm_ctx->compiled.lock);
+
+    return rc;
+}
+
+/**
+ * @brief Remember the set of rule-lists matched for the given user.
+ * NACM configuration is expected to be locked.
+ */
+static int
+nacm_add_user_rule_list_set(nacm_ctx_t *nacm_ctx, const char *username, uint32_t set_id)
+{
+    int rc = SR_ERR_OK;
+    nacm_user_rule_list_set_t lookup = { (char *)username, 0, 0 };
+    nacm_user_rule_list_set_t *user_set = NULL;
+
+    if (0 == SR_USER_GROUPS_CACHE_TTL) {
+        return rc;
+    }
+
+    pthread_rwlock_wrlock(&nacm_ctx->compiled.lock);
+
+    user_set = sr_btree_search(nacm_ctx->compiled.users, &lookup);
+    if (NULL == user_set) {
+        if (NACM_MAX_CACHED_USERS <= nacm_ctx->compiled.user_cnt) {
+            goto unlock;
+        }
+        user_set = calloc(1, sizeof *user_set);
+        CHECK_NULL_NOMEM_GOTO(user_set, rc, unlock);
+        user_set->username = strdup(username);
+        if (NULL == user_set->username) {
+            free(user_set);
+            SR_LOG_ERR_MSG("Unable to allocate memory.");
+            rc = SR_ERR_NOMEM;
+            goto unlock;
+        }
+        rc = sr_btree_insert(nacm_ctx->compiled.users, user_set);
+        if (SR_ERR_OK != rc) {
+            nacm_free_user_rule_list_set(user_set);
+            SR_LOG_ERR_MSG("Failed to insert item into a binary tree.");
+            goto unlock;
+        }
+        ++nacm_ctx->compiled.user_cnt;
+    }
+    user_set->rule_list_set = set_id;
+    user_set->expires = nacm_monotonic_now() + SR_USER_GROUPS_CACHE_TTL;
+
+unlock:
+    pthread_rwlock_unlock(&nacm_ctx->compiled.lock);
+    return rc;
+}
+
+/**
+ * @brief Search for a compiled data access decision, copy of the decision is returned.
+ */
+static bool
+nacm_get_data_decision(nacm_ctx_t *nacm_ctx, uint32_t rule_list_set, uint32_t node_id, nacm_access_flag_t access_type,
+        nacm_data_decision_t *decision)
+{
+    nacm_data_decision_t decision_lookup = { 0, };
+    nacm_data_decision_t *found = NULL;
+
+    decision_lookup.rule_list_set = rule_list_set;
+    decision_lookup.node_id = node_id;
+    decision_lookup.access_type = access_type;
+
+    pthread_rwlock_rdlock(&nacm_ctx->compiled.lock);
+    found = sr_btree_search(nacm_ctx->compiled.decisions, &decision_lookup);
+    if (NULL != found) {
+        *decision = *found;
+    }
+    pthread_rwlock_unlock(&nacm_ctx->compiled.lock);
+
+    return NULL != found;
+}
+
+/**
+ * @brief Check if the limit of compiled data access decisions has been reached.
+ */
+static bool
+nacm_data_decisions_full(nacm_ctx_t *nacm_ctx)
+{
+    bool full = false;
+
+    pthread_rwlock_rdlock(&nacm_ctx->compiled.lock);
+    full = (NACM_MAX_DATA_DECISIONS <= nacm_ctx->compiled.decision_cnt);
+    pthread_rwlock_unlock(&nacm_ctx->compiled.lock);
+
+    return full;
+}
+
+/**
+ * @brief Store a newly compiled data access decision (unless the limit of compiled decisions has been reached).
+ */
+static int
+nacm_add_data_decision(nacm_ctx_t *nacm_ctx, const nacm_data_decision_t *decision)
+{
+    int rc = SR_ERR_OK;
+    nacm_data_decision_t *new_decision = NULL;
+
+    pthread_rwlock_wrlock(&nacm_ctx->compiled.lock);
+
+    if (NACM_MAX_DATA_DECISIONS <= nacm_ctx->compiled.decision_cnt ||
+        NULL != sr_btree_search(nacm_ctx->compiled.decisions, decision)) {
+        /* limit reached or compiled concurrently */
+        goto unlock;
+    }
+
+    new_decision = calloc(1, sizeof *new_decision);
+    CHECK_NULL_NOMEM_GOTO(new_decision, rc, unlock);
+    *new_decision = *decision;
+
+    rc = sr_btree_insert(nacm_ctx->compiled.decisions, new_decision);
+    if (SR_ERR_OK != rc) {
+        free(new_decision);
+        SR_LOG_ERR_MSG("Failed to insert item into a binary tree.");
+        goto unlock;
+    }
+    ++nacm_ctx->compiled.decision_cnt;
+
+unlock:
+    pthread_rwlock_unlock(&nacm_ctx->compiled.lock);
+    return rc;
+}
+
 /**
  * @brief Get NACM flag from schema node.
  */
@@ -481,6 +743,15 @@ nacm_load_config(nacm_ctx_t *nacm_ctx, const sr_datastore_t ds)
     rc = sr_list_init(&nacm_ctx->rule_lists);
     CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to initialize list with NACM rule-lists.");
 
+    rc = sr_list_init(&nacm_ctx->compiled.rule_list_sets);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to initialize list with sets of NACM rule-lists.");
+
+    rc = sr_btree_init(nacm_compare_data_decisions, free, &nacm_ctx->compiled.decisions);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to initialize binary tree with compiled NACM decisions.");
+
+    rc = sr_btree_init(nacm_compare_user_rule_list_sets, nacm_free_user_rule_list_set, &nacm_ctx->compiled.users);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to initialize binary tree with rule-lists matched for the users.");
+
     rc = sr_get_data_file_name(nacm_ctx->data_search_dir, NACM_MODULE_NAME, ds, &ds_filepath);
     CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to get the file-path of NACM startup datastore.");
     fd = open(ds_filepath, O_RDONLY);
@@ -490,6 +761,7 @@ nacm_load_config(nacm_ctx_t *nacm_ctx, const sr_datastore_t ds)
     data_tree = lyd_parse_fd(nacm_ctx->schema_info->ly_ctx, fd, LYD_XML, LYD_OPT_TRUSTED | LYD_OPT_CONFIG);
     if (NULL == data_tree && LY_SUCCESS != ly_errno) {
         SR_LOG_ERR("Parsing of data tree from file %s failed: %s", ds_filepath, ly_errmsg());
+        rc = SR_ERR_INTERNAL;
         goto cleanup;
     }
     close(fd);
@@ -835,6 +1107,10 @@ nacm_init(dm_ctx_t *dm_ctx, const char *data_search_dir, nacm_ctx_t **nacm_ctx)
     rc = pthread_rwlock_init(&ctx->lock, NULL);
     CHECK_ZERO_MSG_GOTO(rc, rc, SR_ERR_INTERNAL, cleanup, "RW-lock initialization failed");
 
+    /* initialize RW lock for compiled decisions */
+    rc = pthread_rwlock_init(&ctx->compiled.lock, NULL);
+    CHECK_ZERO_MSG_GOTO(rc, rc, SR_ERR_INTERNAL, cleanup, "RW-lock initialization failed");
+
     /* initialize mutex for stats */
     rc = pthread_rwlock_init(&ctx->stats.lock, NULL);
     CHECK_ZERO_MSG_GOTO(rc, rc, SR_ERR_INTERNAL, cleanup, "Mutex initialization failed");
@@ -878,7 +1154,7 @@ nacm_init(dm_ctx_t *dm_ctx, const char *data_search_dir, nacm_ctx_t **nacm_ctx)
     SR_LOG_INF_MSG("NACM configuration was loaded from the startup datastore.");
 
 unlock:
-    pthread_rwlock_unlock(&ctx->schema_info->model_lock);
+    SR_RWLOCK_UNLOCK(&ctx->schema_info->model_lock);
 
     if (SR_ERR_OK == rc) {
         /* enable module in the running datastore */
@@ -897,23 +1173,58 @@ cleanup:
     return rc;
 }
 
+/**
+ * @brief Exchange NACM configurations (including the decisions compiled from them) of two NACM contexts.
+ */
+static void
+nacm_swap_config(nacm_ctx_t *nacm_ctx1, nacm_ctx_t *nacm_ctx2)
+{
+    nacm_ctx_t tmp = { 0, };
+
+#define NACM_SWAP_MEMBER(MEMBER) \
+    tmp.MEMBER = nacm_ctx1->MEMBER; \
+    nacm_ctx1->MEMBER = nacm_ctx2->MEMBER; \
+    nacm_ctx2->MEMBER = tmp.MEMBER;
+
+    NACM_SWAP_MEMBER(enabled);
+    NACM_SWAP_MEMBER(dflt);
+    NACM_SWAP_MEMBER(external_groups);
+    NACM_SWAP_MEMBER(groups);
+    NACM_SWAP_MEMBER(users);
+    NACM_SWAP_MEMBER(rule_lists);
+    NACM_SWAP_MEMBER(compiled.rule_list_sets);
+    NACM_SWAP_MEMBER(compiled.decisions);
+    NACM_SWAP_MEMBER(compiled.decision_cnt);
+    NACM_SWAP_MEMBER(compiled.users);
+    NACM_SWAP_MEMBER(compiled.user_cnt);
+
+#undef NACM_SWAP_MEMBER
+}
+
 int
 nacm_reload(nacm_ctx_t *nacm_ctx, const sr_datastore_t ds)
 {
     int rc = SR_ERR_OK;
+    nacm_ctx_t staged = { 0, };
     CHECK_NULL_ARG(nacm_ctx);
 
-    pthread_rwlock_wrlock(&nacm_ctx->lock);
-
-    rc = nacm_cleanup_internal(nacm_ctx, true);
-    CHECK_RC_MSG_GOTO(rc, unlock, "Failed to clean the outdated NACM configuration.");
+    /* load the new configuration aside, ongoing validation requests are not blocked meanwhile */
+    staged.dm_ctx = nacm_ctx->dm_ctx;
+    staged.schema_info = nacm_ctx->schema_info;
+    staged.data_search_dir = nacm_ctx->data_search_dir;
 
-    rc = nacm_load_config(nacm_ctx, ds);
-    CHECK_RC_LOG_GOTO(rc, unlock, "Failed to load NACM configuration from the %s datastore.",
-            sr_ds_to_str(ds));
+    rc = nacm_load_config(&staged, ds);
+    CHECK_RC_LOG_GOTO(rc, cleanup, "Failed to load NACM configuration from the %s datastore, "
+            "keeping the previous configuration.", sr_ds_to_str(ds));
 
-unlock:
+    /* switch to the new configuration, only this has to wait for the ongoing requests */
+    pthread_rwlock_wrlock(&nacm_ctx->lock);
+    nacm_swap_config(nacm_ctx, &staged);
     pthread_rwlock_unlock(&nacm_ctx->lock);
+
+cleanup:
+    /* release the outdated (or partially loaded) configuration */
+    nacm_cleanup_internal(&staged, true);
     return rc;
 }
 
@@ -944,15 +1255,33 @@ nacm_cleanup_internal(nacm_ctx_t *nacm_ctx, bool config_only)
         }
         sr_list_cleanup(nacm_ctx->rule_lists);
     }
+    if (NULL != nacm_ctx->compiled.rule_list_sets) {
+        for (size_t i = 0; i < nacm_ctx->compiled.rule_list_sets->count; ++i) {
+            sr_bitset_cleanup((sr_bitset_t *)nacm_ctx->compiled.rule_list_sets->data[i]);
+        }
+        sr_list_cleanup(nacm_ctx->compiled.rule_list_sets);
+    }
+    if (NULL != nacm_ctx->compiled.decisions) {
+        sr_btree_cleanup(nacm_ctx->compiled.decisions);
+    }
+    if (NULL != nacm_ctx->compiled.users) {
+        sr_btree_cleanup(nacm_ctx->compiled.users);
+    }
     nacm_ctx->groups = NULL;
     nacm_ctx->users = NULL;
     nacm_ctx->rule_lists = NULL;
+    nacm_ctx->compiled.rule_list_sets = NULL;
+    nacm_ctx->compiled.decisions = NULL;
+    nacm_ctx->compiled.decision_cnt = 0;
+    nacm_ctx->compiled.users = NULL;
+    nacm_ctx->compiled.user_cnt = 0;
 
     if (config_only) {
         return rc;
     }
 
     pthread_rwlock_destroy(&nacm_ctx->lock);
+    pthread_rwlock_destroy(&nacm_ctx->compiled.lock);
     pthread_rwlock_destroy(&nacm_ctx->stats.lock);
     free(nacm_ctx->data_search_dir);
 
@@ -1167,7 +1496,7 @@ unlock_all:
     pthread_rwlock_unlock(&nacm_ctx->lock);
 
 unlock_schema:
-    pthread_rwlock_unlock(&schema_info->model_lock);
+    SR_RWLOCK_UNLOCK(&schema_info->model_lock);
 
 cleanup:
     for (size_t i = 0; i < ext_group_cnt; ++i) {
@@ -1357,7 +1686,7 @@ unlock_all:
     pthread_rwlock_unlock(&nacm_ctx->lock);
 
 unlock_schema:
-    pthread_rwlock_unlock(&schema_info->model_lock);
+    SR_RWLOCK_UNLOCK(&schema_info->model_lock);
 
 cleanup:
     for (size_t i = 0; i < ext_group_cnt; ++i) {
@@ -1401,7 +1730,7 @@ nacm_data_validation_start(nacm_ctx_t* nacm_ctx, const ac_ucred_t *user_credenti
     int rc = SR_ERR_OK;
     uid_t uid = 0;
     const char *username = NULL, *module_name = NULL;
-    bool disjoint = false, bit_val = false;
+    bool disjoint = false, bit_val = false, found = false;
     char **ext_groups = NULL;
     size_t ext_group_cnt = 0;
     struct lys_submodule *sub = NULL;
@@ -1444,6 +1773,7 @@ nacm_data_validation_start(nacm_ctx_t* nacm_ctx, const ac_ucred_t *user_credenti
     nacm_data_val_ctx->nacm_ctx = nacm_ctx;
     nacm_data_val_ctx->schema_info = schema_info;
     nacm_data_val_ctx->user_credentials = user_credentials;
+    nacm_data_val_ctx->rule_list_set = NACM_RULE_LIST_SET_NONE;
 
     /* data validation steps 1,2 */
     if (false == nacm_ctx->enabled) {
@@ -1466,6 +1796,14 @@ nacm_data_validation_start(nacm_ctx_t* nacm_ctx, const ac_ucred_t *user_credenti
         goto cleanup;
     }
 
+    /* reuse the set of rule-lists matched for this user recently (skip steps 3-5) */
+    rc = nacm_get_user_rule_list_set(nacm_ctx, username, nacm_data_val_ctx->rule_lists,
+            &nacm_data_val_ctx->rule_list_set, &found);
+    CHECK_RC_MSG_GOTO(rc, unlock_if_fail, "Failed to get the set of rule-lists matched for the user.");
+    if (found) {
+        goto unlock_if_fail;
+    }
+
     /* get the set of groups that this user is member of (step 3) */
 
     /*  -> get NACM info about this user */
@@ -1487,7 +1825,7 @@ nacm_data_validation_start(nacm_ctx_t* nacm_ctx, const ac_ucred_t *user_credenti
 
     /* if no groups are found, skip steps 5-8 (step 4) */
     if ((NULL == nacm_user || sr_bitset_empty(nacm_user->groups)) && 0 == ext_group_cnt) {
-        goto cleanup;
+        goto rule_list_set;
     }
 
     /* get the set of all matching rule-lists (pre-processing for step 5) */
@@ -1523,12 +1861,20 @@ nacm_data_validation_start(nacm_ctx_t* nacm_ctx, const ac_ucred_t *user_credenti
         }
     }
 
+rule_list_set:
+    /* decisions compiled for the same set of rule-lists are shared between users */
+    rc = nacm_get_rule_list_set_id(nacm_ctx, nacm_data_val_ctx->rule_lists, &nacm_data_val_ctx->rule_list_set);
+    CHECK_RC_MSG_GOTO(rc, unlock_if_fail, "Failed to get ID of the set of matching rule-lists.");
+    if (SR_ERR_OK != nacm_add_user_rule_list_set(nacm_ctx, username, nacm_data_val_ctx->rule_list_set)) {
+        SR_LOG_WRN("Failed to remember the set of rule-lists matched for user '%s'.", username);
+    }
+
     /* steps 6-12 are evaluated for each node in nacm_check_data */
 
 unlock_if_fail:
     if (SR_ERR_OK != rc) {
         pthread_rwlock_unlock(&nacm_ctx->lock);
-        pthread_rwlock_unlock(&schema_info->model_lock);
+        SR_RWLOCK_UNLOCK(&schema_info->model_lock);
     }
 
 cleanup:
@@ -1554,7 +1900,7 @@ nacm_data_validation_stop(nacm_data_val_ctx_t *nacm_data_val_ctx)
     }
 
     pthread_rwlock_unlock(&nacm_data_val_ctx->nacm_ctx->lock);
-    pthread_rwlock_unlock(&nacm_data_val_ctx->schema_info->model_lock);
+    SR_RWLOCK_UNLOCK(&nacm_data_val_ctx->schema_info->model_lock);
     nacm_free_data_val_ctx(nacm_data_val_ctx);
 }
 
@@ -1591,16 +1937,117 @@ nacm_default_deny_write(const struct lys_module *mod, const struct lyd_node *nod
     return false;
 }
 
+/**
+ * @brief Check the descendants of the given schema node against the rules that could apply to them
+ * but not to the node itself (see ::nacm_subtree_is_uniform).
+ */
+static bool
+nacm_subtree_is_uniform_r(const struct lys_module *nacm_mod, const struct lys_node *root, const struct lys_node *sch_node,
+        bool module_rules, sr_list_t *deep_rules)
+{
+    nacm_rule_t *nacm_rule = NULL;
 
-int
-nacm_check_data(nacm_data_val_ctx_t *nacm_data_val_ctx, nacm_access_flag_t access_type, const struct lyd_node *node,
-        nacm_action_t *action_p, const char **rule_name_p, const char **rule_info_p)
+    for (const struct lys_node *child = sch_node->child; NULL != child; child = child->next) {
+        if (child->nodetype & (LYS_GROUPING | LYS_RPC | LYS_ACTION | LYS_NOTIF)) {
+            continue;
+        }
+        if (sr_lys_data_node((struct lys_node *)child)) {
+            if (nacm_check_extension(nacm_mod, child, NACM_DENY_ALL | NACM_DENY_WRITE)) {
+                /* default action may differ */
+                return false;
+            }
+            if (module_rules && 0 != strcmp(child->module->name, root->module->name)) {
+                /* module rules may differ */
+                return false;
+            }
+            for (size_t i = 0; i < deep_rules->count; ++i) {
+                nacm_rule = (nacm_rule_t *)deep_rules->data[i];
+                if (dm_get_node_data_depth((struct lys_node *)child) == nacm_rule->data_depth &&
+                    dm_get_node_xpath_hash((struct lys_node *)child) == nacm_rule->data_hash) {
+                    /* the rule targets this descendant */
+                    return false;
+                }
+            }
+        }
+        if (!(child->nodetype & (LYS_LEAF | LYS_LEAFLIST | LYS_ANYDATA)) &&
+            !nacm_subtree_is_uniform_r(nacm_mod, root, child, module_rules, deep_rules)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Check if the outcome of the data access validation of any instance of the given schema node applies
+ * also to all its descendants, i.e. no rule from the matching rule-lists can apply to a descendant without
+ * applying also to the node itself and no descendant changes the default action by a YANG extension.
+ */
+static int
+nacm_subtree_is_uniform(nacm_data_val_ctx_t *nacm_data_val_ctx, nacm_access_flag_t access_type,
+        const struct lys_node *sch_node, bool *uniform)
+{
+    int rc = SR_ERR_OK;
+    bool bit_val = false, module_rules = false;
+    uint16_t node_data_depth = 0;
+    sr_list_t *deep_rules = NULL;
+    nacm_ctx_t *nacm_ctx = nacm_data_val_ctx->nacm_ctx;
+    nacm_rule_list_t *nacm_rule_list = NULL;
+    nacm_rule_t *nacm_rule = NULL;
+
+    *uniform = false;
+    node_data_depth = dm_get_node_data_depth((struct lys_node *)sch_node);
+
+    rc = sr_list_init(&deep_rules);
+    CHECK_RC_MSG_RETURN(rc, "Failed to initialize list");
+
+    /* collect the rules that may apply differently to the descendants */
+    for (size_t i = 0; NULL != nacm_data_val_ctx->rule_lists && i < nacm_ctx->rule_lists->count; ++i) {
+        rc = sr_bitset_get(nacm_data_val_ctx->rule_lists, i, &bit_val);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to get value of a bit in a bitset.");
+        if (false == bit_val) {
+            continue;
+        }
+        nacm_rule_list = (nacm_rule_list_t *)nacm_ctx->rule_lists->data[i];
+        for (size_t j = 0; j < nacm_rule_list->rules->count; ++j) {
+            nacm_rule = (nacm_rule_t *)nacm_rule_list->rules->data[j];
+            if (false == (access_type & nacm_rule->access) ||
+                (NACM_RULE_DATA != nacm_rule->type && NACM_RULE_NOTSET != nacm_rule->type)) {
+                continue;
+            }
+            if (0 != strcmp("*", nacm_rule->module)) {
+                module_rules = true;
+            }
+            if (NULL != nacm_rule->data.path && 0 != strcmp("/", nacm_rule->data.path) &&
+                nacm_rule->data_depth > node_data_depth) {
+                rc = sr_list_add(deep_rules, nacm_rule);
+                CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to add item into a list.");
+            }
+        }
+    }
+
+    *uniform = nacm_subtree_is_uniform_r(nacm_ctx->schema_info->module, sch_node, sch_node, module_rules, deep_rules);
+
+cleanup:
+    sr_list_cleanup(deep_rules);
+    return rc;
+}
+
+/**
+ * @brief Check if there is a permission to access the given data node, optionally find out if the outcome
+ * applies to the entire subtree of the node.
+ */
+static int
+nacm_check_data_internal(nacm_data_val_ctx_t *nacm_data_val_ctx, nacm_access_flag_t access_type,
+        const struct lyd_node *node, nacm_action_t *action_p, const char **rule_name_p, const char **rule_info_p,
+        bool *subtree_p)
 {
     int rc = SR_ERR_OK;
     uid_t uid = 0;
-    bool bit_val = true;
+    bool bit_val = true, compile = false, instance_check = false, subtree = false;
     uint16_t node_data_depth = 0;
-    uint32_t parent_xpath_hash = 0;
+    uint32_t parent_xpath_hash = 0, node_id = 0;
+    size_t first_rule_list = 0, first_rule = 0;
     struct ly_set *nodeset = NULL;
     const struct lyd_node *parent = NULL;
     struct ly_set **targets_p;
@@ -1610,6 +2057,7 @@ nacm_check_data(nacm_data_val_ctx_t *nacm_data_val_ctx, nacm_access_flag_t acces
     nacm_ctx_t *nacm_ctx = NULL;
     nacm_rule_list_t *nacm_rule_list = NULL;
     nacm_rule_t *nacm_rule = NULL;
+    nacm_data_decision_t decision = { 0, };
 
     CHECK_NULL_ARG4(nacm_data_val_ctx, nacm_data_val_ctx->nacm_ctx, node, action_p);
     if (NACM_ACCESS_ALL == access_type || NACM_ACCESS_EXEC == access_type) {
@@ -1626,25 +2074,50 @@ nacm_check_data(nacm_data_val_ctx_t *nacm_data_val_ctx, nacm_access_flag_t acces
     /* data validation steps 1,2 (perform quickly before doing anything else) */
     if (false == nacm_data_val_ctx->nacm_ctx->enabled) {
         action = NACM_ACTION_PERMIT;
+        subtree = true;
         goto cleanup;
     }
     if (SR_NACM_RECOVERY_UID == uid) {
         action = NACM_ACTION_PERMIT;
+        subtree = true;
         goto cleanup;
     }
 
     nacm_ctx = nacm_data_val_ctx->nacm_ctx;
     node_data_depth = dm_get_node_data_depth(node->schema);
 
+    /* look for a decision compiled for this schema node */
+    node_id = dm_get_node_id(node->schema);
+    if (0 != node_id && NACM_RULE_LIST_SET_NONE != nacm_data_val_ctx->rule_list_set) {
+        if (nacm_get_data_decision(nacm_ctx, nacm_data_val_ctx->rule_list_set, node_id, access_type, &decision)) {
+            subtree = decision.subtree;
+            if (decision.final) {
+                action = decision.action;
+                rule_name = decision.rule_name;
+                rule_info = decision.rule_info;
+                goto cleanup;
+            }
+            /* skip the rules that are known not to apply to this schema node */
+            first_rule_list = decision.rule_list_idx;
+            first_rule = decision.rule_idx;
+        } else if (!nacm_data_decisions_full(nacm_ctx)) {
+            /* compile the decision while evaluating the rules */
+            compile = true;
+            decision.rule_list_set = nacm_data_val_ctx->rule_list_set;
+            decision.node_id = node_id;
+            decision.access_type = access_type;
+        }
+    }
+
     /* steps 5,6,7: find matching rule */
-    for (size_t i = 0; i < nacm_ctx->rule_lists->count; ++i) {
+    for (size_t i = first_rule_list; i < nacm_ctx->rule_lists->count; ++i) {
         /* step 5: check if this rule-list matches (already evaluated in ::nacm_data_validation_start) */
         rc = sr_bitset_get(nacm_data_val_ctx->rule_lists, i, &bit_val);
         CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to get value of a bit in a bitset.");
         if (true == bit_val) {
             /* process matching rule-list */
             nacm_rule_list = (nacm_rule_list_t *)nacm_ctx->rule_lists->data[i];
-            for (size_t j = 0; j < nacm_rule_list->rules->count; ++j) {
+            for (size_t j = (i == first_rule_list ? first_rule : 0); j < nacm_rule_list->rules->count; ++j) {
                 nacm_rule = (nacm_rule_t *)nacm_rule_list->rules->data[j];
                 /* step 6: process all rules until a match is found */
                 if (false == (access_type & nacm_rule->access)) {
@@ -1674,6 +2147,12 @@ nacm_check_data(nacm_data_val_ctx_t *nacm_data_val_ctx, nacm_access_flag_t acces
                         /* path doesn't reference this schema node */
                         continue;
                     }
+                    if (!instance_check) {
+                        /* from this rule on, the outcome depends on the data node instance */
+                        instance_check = true;
+                        decision.rule_list_idx = i;
+                        decision.rule_idx = j;
+                    }
                     /* check the cache if the instance identifier has been already evaluated for this data tree */
                     nacm_data_targets = nacm_get_data_targets(nacm_data_val_ctx, nacm_rule->id);
                     if (NULL == nacm_data_targets) {
@@ -1732,6 +2211,26 @@ nacm_check_data(nacm_data_val_ctx_t *nacm_data_val_ctx, nacm_access_flag_t acces
     }
 
 cleanup:
+    if (SR_ERR_OK == rc && compile) {
+        decision.final = !instance_check;
+        if (decision.final) {
+            decision.action = action;
+            decision.rule_name = rule_name;
+            decision.rule_info = rule_info;
+        }
+        if (NACM_ACCESS_READ == access_type) {
+            /* only the read access is checked per subtree */
+            rc = nacm_subtree_is_uniform(nacm_data_val_ctx, access_type, node->schema, &decision.subtree);
+        }
+        if (SR_ERR_OK == rc) {
+            subtree = decision.subtree;
+            rc = nacm_add_data_decision(nacm_ctx, &decision);
+        }
+        if (SR_ERR_OK != rc) {
+            SR_LOG_WRN_MSG("Failed to store compiled NACM data access decision.");
+            rc = SR_ERR_OK;
+        }
+    }
     if (SR_ERR_OK == rc) {
         *action_p = action;
         if (NULL != rule_name_p) {
@@ -1740,10 +2239,29 @@ cleanup:
         if (NULL != rule_info_p) {
             *rule_info_p = rule_info;
         }
+        if (NULL != subtree_p) {
+            *subtree_p = subtree;
+        }
     }
     return rc;
 }
 
+int
+nacm_check_data(nacm_data_val_ctx_t *nacm_data_val_ctx, nacm_access_flag_t access_type, const struct lyd_node *node,
+        nacm_action_t *action_p, const char **rule_name_p, const char **rule_info_p)
+{
+    return nacm_check_data_internal(nacm_data_val_ctx, access_type, node, action_p, rule_name_p, rule_info_p, NULL);
+}
+
+int
+nacm_check_data_subtree(nacm_data_val_ctx_t *nacm_data_val_ctx, nacm_access_flag_t access_type,
+        const struct lyd_node *node, nacm_action_t *action_p, const char **rule_name_p, const char **rule_info_p,
+        bool *subtree_p)
+{
+    CHECK_NULL_ARG(subtree_p);
+    return nacm_check_data_internal(nacm_data_val_ctx, access_type, node, action_p, rule_name_p, rule_info_p, subtree_p);
+}
+
 int
 nacm_stats_add_denied_data_write(nacm_ctx_t *nacm_ctx)
 {
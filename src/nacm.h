@@ -132,6 +132,50 @@ typedef struct nacm_rule_list_s {
     sr_list_t *rules;    /**< List of rules. Items are of type nacm_rule_t. */
 } nacm_rule_list_t;
 
+/**
+ * @brief Maximum number of compiled data access decisions kept by NACM context.
+ */
+#define NACM_MAX_DATA_DECISIONS 65536
+
+/**
+ * @brief ID used for data validation requests whose decisions are not compiled.
+ */
+#define NACM_RULE_LIST_SET_NONE UINT32_MAX
+
+/**
+ * @brief Maximum number of users whose set of matching rule-lists is kept by NACM context.
+ */
+#define NACM_MAX_CACHED_USERS 1024
+
+/**
+ * @brief Set of rule-lists matched for a user, kept to skip the group lookup and rule-list matching
+ * in the subsequent data validation requests of the same user.
+ */
+typedef struct nacm_user_rule_list_set_s {
+    char *username;           /**< Name of the user. */
+    uint32_t rule_list_set;   /**< ID of the set of rule-lists that apply to the user. */
+    time_t expires;           /**< Time (CLOCK_MONOTONIC) when the entry expires (system groups of the user may change). */
+} nacm_user_rule_list_set_t;
+
+/**
+ * @brief Data access decision compiled for a set of rule-lists, schema node and access type.
+ *
+ * Unless the decision is final, the rules preceding the one at (rule_list_idx, rule_idx) are known not to apply
+ * to any instance of the schema node and the evaluation continues from there.
+ */
+typedef struct nacm_data_decision_s {
+    uint32_t rule_list_set;          /**< ID of the set of rule-lists that the decision applies to. */
+    uint32_t node_id;                /**< ID of the schema node (see ::dm_get_node_id). */
+    nacm_access_flag_t access_type;  /**< Access type that the decision applies to. */
+    bool final;                      /**< *true* if the decision does not depend on the data node instance. */
+    bool subtree;                    /**< *true* if the outcome for an instance applies also to all its descendants (read access only). */
+    nacm_action_t action;            /**< Action to be taken (valid only for a final decision). */
+    const char *rule_name;           /**< Name of the rule which has yielded the decision, if any (final decision only). */
+    const char *rule_info;           /**< Description of the rule which has yielded the decision, if any (final decision only). */
+    size_t rule_list_idx;            /**< Index of the rule-list with the first rule that needs the instance check. */
+    size_t rule_idx;                 /**< Index of the first rule that needs the instance check within the rule-list. */
+} nacm_data_decision_t;
+
 /**
  * @brief Structure that holds the context of an instance of NACM module.
  */
@@ -153,6 +197,18 @@ typedef struct nacm_ctx_s {
     sr_btree_t *users;             /**< A set of all users known from the NACM config. Items are of type nacm_user_t. */
     sr_list_t *rule_lists;         /**< List of all NACM rule-lists. Items are of type nacm_rule_list_t. */
 
+    /* data access decisions compiled from the NACM configuration, dropped with each reload */
+    struct {
+        pthread_rwlock_t lock;       /**< RW-lock used to protect the compiled decisions (these are added
+                                          while the NACM configuration is only locked for reading). */
+        sr_list_t *rule_list_sets;   /**< Distinct sets of rule-lists that apply to the users, index is the ID of the set.
+                                          Items are of type sr_bitset_t. */
+        sr_btree_t *decisions;       /**< Compiled decisions. Items are of type nacm_data_decision_t. */
+        size_t decision_cnt;         /**< Number of compiled decisions. */
+        sr_btree_t *users;           /**< Sets of rule-lists matched for the users. Items are of type nacm_user_rule_list_set_t. */
+        size_t user_cnt;             /**< Number of users with a matched set of rule-lists. */
+    } compiled;
+
     /* NACM state data */
     struct {
         pthread_rwlock_t lock;       /**< RW-lock used to protect incrementation/reading of the stats.
@@ -195,6 +251,7 @@ typedef struct nacm_data_val_ctx_s {
     dm_schema_info_t *schema_info;      /**< Schema info associated with the data tree whose nodes are being validated. */
     sr_bitset_t *rule_lists;            /**< Set of rule-lists that apply to this data validation request.
                                              (stored as bitset of their IDs). */
+    uint32_t rule_list_set;             /**< ID of the set of rule-lists used to look up the compiled decisions. */
     sr_btree_t *data_targets;           /**< A binary tree of target nodes for data-oriented NACM rules with already evaluated
                                              path. Items are of type nacm_data_targets_t. */
 } nacm_data_val_ctx_t;
@@ -212,6 +269,9 @@ int nacm_init(dm_ctx_t *dm_ctx, const char *data_search_dir, nacm_ctx_t **nacm_c
 /**
  * @brief Reload the NACM configuration from startup or running datastore.
  *
+ * The new configuration is loaded aside without blocking the ongoing access validations and replaces
+ * the current one afterwards. If the loading fails, the current configuration is kept.
+ *
  * @param [in] nacm_ctx NACM context to reload.
  * @param [in] ds Datastore to reload from.
  */
@@ -287,6 +347,26 @@ void nacm_data_validation_stop(nacm_data_val_ctx_t *nacm_data_val_ctx);
 int nacm_check_data(nacm_data_val_ctx_t *nacm_data_val_ctx, nacm_access_flag_t access_type, const struct lyd_node *node,
         nacm_action_t *action, const char **rule_name, const char **rule_info);
 
+/**
+ * @brief Same as ::nacm_check_data, additionally tells whether the outcome applies to the entire subtree
+ * of the given data node, i.e. no rule and no NACM extension can yield a different outcome for any of its
+ * descendants, which therefore do not have to be checked.
+ *
+ * @param [in] nacm_data_val_ctx_t NACM data validation context.
+ * @param [in] access_type Type of the requested access. All types except for NACM_ACCESS_EXEC are valid.
+ * @param [in] node Data node to be accessed in the given way.
+ * @param [out] action Action to take based on the NACM rules.
+ * @param [out] rule_name Name of the applied rule, if any.
+ *                        Returned string shouldn't be accessed after ::nacm_data_validation_stop is called!
+ * @param [out] rule_info A textual description of the applied rule, if any.
+ *                        Returned string shouldn't be accessed after ::nacm_data_validation_stop is called!
+ * @param [out] subtree *true* if the action applies to all descendants of the node as well
+ *                      (rules are evaluated per subtree only for NACM_ACCESS_READ).
+ */
+int nacm_check_data_subtree(nacm_data_val_ctx_t *nacm_data_val_ctx, nacm_access_flag_t access_type,
+        const struct lyd_node *node, nacm_action_t *action, const char **rule_name, const char **rule_info,
+        bool *subtree);
+
 /**
  * @brief Update NACM statistics to include another unauthorized attempt to execute operation with write effect.
  *
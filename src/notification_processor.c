@@ -37,10 +37,6 @@
 #include "request_processor.h"
 #include "data_manager.h"
 
-#define NP_NS_SCHEMA_FILE                  "sysrepo-notification-store.yang"  /**< Schema of notification store. */
-#define NP_NS_XPATH_NOTIFICATION           "/sysrepo-notification-store:notifications/notification[xpath='%s'][generated-time='%s'][logged-time='%u']"
-#define NP_NS_XPATH_NOTIFICATION_BY_XPATH  "/sysrepo-notification-store:notifications/notification[xpath='%s']"
-
 /**
  * @brief Information about a notification destination.
  */
@@ -50,6 +46,19 @@ typedef struct np_dst_info_s {
     size_t subscribed_modules_cnt;  /**< Number of the modules with subscriptions. */
 } np_dst_info_t;
 
+/**
+ * @brief Verify notification of a commit, dispatched once all verifiers with higher priority have answered.
+ */
+typedef struct np_commit_verifier_s {
+    Sr__Msg *notif;                  /**< Notification message, NULL once it has been sent. */
+    char *subs_xpath;                /**< XPath (or module name) the verifier is subscribed to. */
+    char *dst_address;               /**< Destination address of the verifier. */
+    uint32_t dst_id;                 /**< Destination ID of the verifier. */
+    uint32_t priority;               /**< Priority of the subscription. */
+    struct timespec sent;            /**< Time (CLOCK_MONOTONIC) when the notification has been sent. */
+    bool acked;                      /**< TRUE if the verifier has already answered. */
+} np_commit_verifier_t;
+
 /**
  * @brief Context holding information about notifications sent per commit.
  */
@@ -62,6 +71,8 @@ typedef struct np_commit_ctx_s {
     int result;                      /**< Used to store overall result of the commit operation. */
     sr_list_t *err_subs_xpaths;      /**< Used to store xpaths to subscribers that returned an error. */
     sr_list_t *errors;               /**< Used to store errors returned from commit verifiers. */
+    sr_list_t *verifiers;            /**< Verify notifications of the commit (np_commit_verifier_t *). */
+    bool verify_in_progress;         /**< TRUE while the verify phase is waiting for the verifiers. */
 } np_commit_ctx_t;
 
 /**
@@ -76,9 +87,9 @@ typedef struct np_ctx_s {
     pthread_rwlock_t lock;                /**< Read-write lock for the context. */
     struct ly_ctx *ly_ctx;                /**< libyang context used locally in NP. */
     const char *data_search_dir;          /**< Directory containing the data files. */
-    const struct lys_module *ns_schema;   /**< Schema tree of the notification store YANG. */
-    sr_locking_set_t *lock_ctx;           /**< Context for locking notification store files. */
+    np_notif_store_t *notif_store;        /**< Notification store. */
     bool do_notif_store_cleanup;          /**< TRUE if notification store cleanups should be performed.*/
+    rp_dp_latency_t *verify_latency;      /**< Latency statistics of commit verifiers. */
 } np_ctx_t;
 
 /**
@@ -276,18 +287,15 @@ np_commit_ctx_find(np_ctx_t *np_ctx, uint32_t commit_id, sr_llist_node_t **llist
 }
 
 /**
- * @brief Increments count of notifications sent for the commit specified by commit ID.
+ * @brief Returns the commit context for the commit ID, creates a new one if it does not exist yet.
+ * NP context lock is expected to be held for writing.
  */
 static int
-np_commit_notif_cnt_increment(np_ctx_t *np_ctx, uint32_t commit_id)
+np_commit_ctx_get_locked(np_ctx_t *np_ctx, uint32_t commit_id, np_commit_ctx_t **commit_p)
 {
     np_commit_ctx_t *commit = NULL;
     int rc = SR_ERR_OK;
 
-    CHECK_NULL_ARG(np_ctx);
-
-    pthread_rwlock_wrlock(&np_ctx->lock);
-
     commit = np_commit_ctx_find(np_ctx, commit_id, NULL);
 
     if (NULL == commit) {
@@ -295,330 +303,262 @@ np_commit_notif_cnt_increment(np_ctx_t *np_ctx, uint32_t commit_id)
         SR_LOG_DBG("Creating a new NP commit context for commit ID %"PRIu32".", commit_id);
 
         commit = calloc(1, sizeof(*commit));
-        CHECK_NULL_NOMEM_GOTO(commit, rc, unlock);
+        CHECK_NULL_NOMEM_RETURN(commit);
 
         commit->commit_id = commit_id;
         rc = sr_llist_add_new(np_ctx->commits, commit);
+        if (SR_ERR_OK != rc) {
+            free(commit);
+            return rc;
+        }
     }
 
-    commit->notifications_sent++;
-
-unlock:
-    pthread_rwlock_unlock(&np_ctx->lock);
-
+    *commit_p = commit;
     return rc;
 }
 
 /**
- * @brief Adds an error xpath into commit context.
+ * @brief Increments count of notifications sent for the commit specified by commit ID.
  */
 static int
-np_commit_error_add(np_commit_ctx_t *commit_ctx, const char *err_subs_xpath, bool do_not_send_abort,
-        const char *err_msg, const char *err_xpath)
+np_commit_notif_cnt_increment(np_ctx_t *np_ctx, uint32_t commit_id)
 {
-    sr_error_info_t *error = NULL;
+    np_commit_ctx_t *commit = NULL;
     int rc = SR_ERR_OK;
 
-    CHECK_NULL_ARG2(commit_ctx, err_subs_xpath);
+    CHECK_NULL_ARG(np_ctx);
 
-    if (do_not_send_abort) {
-        SR_LOG_DBG("Subscription '%s' doesn't want abort notification", err_subs_xpath);
-        if (NULL == commit_ctx->err_subs_xpaths) {
-            rc = sr_list_init(&commit_ctx->err_subs_xpaths);
-            CHECK_RC_MSG_RETURN(rc, "Unable to init sr_list for errored verifier xpaths.");
-        }
-        rc = sr_list_add(commit_ctx->err_subs_xpaths, strdup(err_subs_xpath));
-    }
-    if (SR_ERR_OK == rc && NULL != err_msg) {
-        if (NULL == commit_ctx->errors) {
-            rc = sr_list_init(&commit_ctx->errors);
-        }
-        if (SR_ERR_OK == rc) {
-            error = calloc(1, sizeof(*error));
-            error->message = strdup(err_msg);
-            if (NULL != err_xpath) {
-                error->xpath = strdup(err_xpath);
-            }
-            rc = sr_list_add(commit_ctx->errors, error);
-        }
+    pthread_rwlock_wrlock(&np_ctx->lock);
+
+    rc = np_commit_ctx_get_locked(np_ctx, commit_id, &commit);
+    if (SR_ERR_OK == rc) {
+        commit->notifications_sent++;
     }
 
+    pthread_rwlock_unlock(&np_ctx->lock);
+
     return rc;
 }
 
 /**
- * @brief Loads the data tree from provided file.
+ * @brief Frees a verify notification of a commit.
  */
-static int
-np_load_data_tree(np_ctx_t *np_ctx, const ac_ucred_t *user_cred, const char *data_filename,
-        const bool read_only, struct lyd_node **data_tree, int *fd_p)
+static void
+np_commit_verifier_free(np_commit_verifier_t *verifier)
 {
-    int fd = -1;
-    int rc = SR_ERR_OK;
-
-    CHECK_NULL_ARG4(np_ctx, np_ctx->rp_ctx, data_filename, data_tree);
-
-    /* open the file as the proper user */
-    if (NULL != user_cred) {
-        ac_set_user_identity(np_ctx->rp_ctx->ac_ctx, user_cred);
-    }
-
-    fd = open(data_filename, (read_only ? O_RDONLY : O_RDWR));
-
-    if (NULL != user_cred) {
-        ac_unset_user_identity(np_ctx->rp_ctx->ac_ctx, user_cred);
+    if (NULL != verifier) {
+        sr_msg_free(verifier->notif);
+        free(verifier->subs_xpath);
+        free(verifier->dst_address);
+        free(verifier);
     }
+}
 
-    if (-1 == fd) {
-        /* error by open */
-        if (ENOENT == errno) {
-            SR_LOG_DBG("Data file '%s' does not exist.", data_filename);
-            if (read_only) {
-                SR_LOG_DBG("No data for '%s' will be loaded.", data_filename);
-                rc = SR_ERR_DATA_MISSING;
-            } else {
-                /* create new persist file */
-                ac_set_user_identity(np_ctx->rp_ctx->ac_ctx, user_cred);
-                fd = open(data_filename, O_RDWR | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
-                ac_unset_user_identity(np_ctx->rp_ctx->ac_ctx, user_cred);
-                if (-1 == fd) {
-                    SR_LOG_ERR("Unable to create a new data file '%s': %s", data_filename, sr_strerror_safe(errno));
-                    rc = SR_ERR_INTERNAL;
-                }
+/**
+ * @brief Frees a commit context.
+ */
+static void
+np_commit_ctx_free(np_commit_ctx_t *commit)
+{
+    if (NULL != commit) {
+        if (NULL != commit->verifiers) {
+            for (size_t i = 0; i < commit->verifiers->count; i++) {
+                np_commit_verifier_free(commit->verifiers->data[i]);
             }
-        } else if (EACCES == errno) {
-            SR_LOG_ERR("Insufficient permissions to access the data file '%s'.", data_filename);
-            rc = SR_ERR_UNAUTHORIZED;
-        } else {
-            SR_LOG_ERR("Unable to open the data file '%s': %s.", data_filename, sr_strerror_safe(errno));
-            rc = SR_ERR_INTERNAL;
+            sr_list_cleanup(commit->verifiers);
         }
-        if (SR_ERR_OK != rc) {
-            goto cleanup;
-        }
-    }
-
-    /* lock & load the data tree */
-    rc = sr_locking_set_lock_fd(np_ctx->lock_ctx, fd, data_filename, (read_only ? false : true), true);
-    CHECK_RC_LOG_GOTO(rc, cleanup, "Unable to lock data file '%s'.", data_filename);
-
-    *data_tree = lyd_parse_fd(np_ctx->ly_ctx, fd, LYD_XML, LYD_OPT_STRICT | LYD_OPT_CONFIG | LYD_OPT_NOAUTODEL);
-    if (NULL == *data_tree && LY_SUCCESS != ly_errno) {
-        SR_LOG_ERR("Parsing data from file '%s' failed: %s", data_filename, ly_errmsg());
-        rc = SR_ERR_INTERNAL;
-    } else {
-        SR_LOG_DBG("Data successfully loaded from file '%s'.", data_filename);
-    }
-
-    if ((SR_ERR_OK != rc) || (true == read_only) || (NULL == fd_p)) {
-        /* unlock and close fd in case of read_only has been requested */
-        sr_locking_set_unlock_close_fd(np_ctx->lock_ctx, fd);
-    } else {
-        /* return open fd to locked file otherwise */
-        *fd_p = fd;
+        free(commit);
     }
-
-cleanup:
-    return rc;
 }
 
 /**
- * @brief Saves the data tree into the file specified by file descriptor.
+ * @brief Queues the verify notification for the commit specified by commit ID. The notification is sent
+ * once all notifications for the commit have been generated and all verifiers with higher priority have answered.
  */
 static int
-np_save_data_tree(struct lyd_node *data_tree, int fd)
+np_commit_verifier_add(np_ctx_t *np_ctx, uint32_t commit_id, np_subscription_t *subscription, Sr__Msg *notif)
 {
-    int ret = 0;
+    np_commit_ctx_t *commit = NULL;
+    np_commit_verifier_t *verifier = NULL;
+    int rc = SR_ERR_OK;
 
-    CHECK_NULL_ARG(data_tree);
+    verifier = calloc(1, sizeof(*verifier));
+    CHECK_NULL_NOMEM_RETURN(verifier);
 
-    /* empty file content */
-    ret = ftruncate(fd, 0);
-    CHECK_ZERO_LOG_RETURN(ret, SR_ERR_INTERNAL, "File truncate failed: %s", sr_strerror_safe(errno));
+    verifier->subs_xpath = strdup(NULL != subscription->xpath ? subscription->xpath : subscription->module_name);
+    CHECK_NULL_NOMEM_GOTO(verifier->subs_xpath, rc, cleanup);
+    verifier->dst_address = strdup(subscription->dst_address);
+    CHECK_NULL_NOMEM_GOTO(verifier->dst_address, rc, cleanup);
+    verifier->dst_id = subscription->dst_id;
+    verifier->priority = subscription->priority;
 
-    /* print data tree to file */
-    ret = lyd_print_fd(fd, data_tree, LYD_XML, LYP_WITHSIBLINGS | LYP_FORMAT | LYP_WD_EXPLICIT);
-    CHECK_ZERO_LOG_RETURN(ret, SR_ERR_INTERNAL, "Saving notification store data tree failed: %s", ly_errmsg());
+    pthread_rwlock_wrlock(&np_ctx->lock);
 
-    /* flush in-core data to the disc */
-    ret = fsync(fd);
-    CHECK_ZERO_LOG_RETURN(ret, SR_ERR_INTERNAL, "File synchronization failed: %s", sr_strerror_safe(errno));
+    rc = np_commit_ctx_get_locked(np_ctx, commit_id, &commit);
+    if (SR_ERR_OK == rc && NULL == commit->verifiers) {
+        rc = sr_list_init(&commit->verifiers);
+    }
+    if (SR_ERR_OK == rc) {
+        rc = sr_list_add(commit->verifiers, verifier);
+    }
+    if (SR_ERR_OK == rc) {
+        verifier->notif = notif;
+        commit->notifications_sent++;
+        commit->verify_in_progress = true;
+    }
 
-    SR_LOG_DBG_MSG("Data tree successfully saved.");
+    pthread_rwlock_unlock(&np_ctx->lock);
 
-    return SR_ERR_OK;
+cleanup:
+    if (SR_ERR_OK != rc) {
+        np_commit_verifier_free(verifier);
+    }
+    return rc;
 }
 
 /**
- * @brief Cleans up specified data tree and closes specified file descriptor.
+ * @brief Sends the verify notifications of the next priority level unless some verifier
+ * of the current level has not answered yet. NP context lock is expected to be held for writing.
  */
 static void
-np_cleanup_data_tree(np_ctx_t *np_ctx, struct lyd_node *data_tree, int fd)
+np_commit_verifiers_dispatch_locked(np_ctx_t *np_ctx, np_commit_ctx_t *commit)
 {
-    if (NULL != data_tree) {
-        lyd_free_withsiblings(data_tree);
+    np_commit_verifier_t *verifier = NULL;
+    bool pending = false, found = false;
+    uint32_t priority = 0;
+    int rc = SR_ERR_OK;
+
+    if (NULL == commit->verifiers || !commit->verify_in_progress) {
+        return;
     }
-    if (-1 != fd && NULL != np_ctx) {
-        sr_locking_set_unlock_close_fd(np_ctx->lock_ctx, fd);
+
+    while (true) {
+        pending = false;
+        found = false;
+        for (size_t i = 0; i < commit->verifiers->count; i++) {
+            verifier = commit->verifiers->data[i];
+            if (NULL == verifier->notif) {
+                pending = pending || !verifier->acked;
+            } else if (!found || verifier->priority > priority) {
+                priority = verifier->priority;
+                found = true;
+            }
+        }
+        if (pending || !found) {
+            /* waiting for the current level or nothing left to be sent */
+            return;
+        }
+
+        SR_LOG_DBG("Sending verify notifications with priority %"PRIu32" for commit id=%"PRIu32".",
+                priority, commit->commit_id);
+
+        for (size_t i = 0; i < commit->verifiers->count; i++) {
+            verifier = commit->verifiers->data[i];
+            if (NULL != verifier->notif && priority == verifier->priority) {
+                SR_PROBE3(notif__send, verifier->dst_address, verifier->dst_id, verifier->notif->notification->type);
+                sr_clock_get_time(CLOCK_MONOTONIC, &verifier->sent);
+                rc = cm_msg_send(np_ctx->rp_ctx->cm_ctx, verifier->notif);
+                verifier->notif = NULL;
+                if (SR_ERR_OK != rc) {
+                    /* do not wait for the verifier that can not be reached */
+                    SR_LOG_WRN("Unable to send verify notification to '%s' @ %"PRIu32".", verifier->dst_address,
+                            verifier->dst_id);
+                    verifier->acked = true;
+                    commit->notifications_sent--;
+                }
+            }
+        }
     }
 }
 
 /**
- * @brief Returns the name of a file that can be used to store a notification received in given time.
+ * @brief Drops the verify notifications that have not been sent yet (the commit is going to be aborted).
+ * The verifiers will not receive abort notification either. NP context lock is expected to be held for writing.
  */
-static int
-np_get_notif_store_filename(const char *module_name, time_t received_time, char *filename_buff, size_t filename_buff_size)
+static void
+np_commit_verifiers_drop_locked(np_commit_ctx_t *commit)
 {
-    mode_t old_umask = 0;
-    time_t raw_time = 0;
-    struct tm *tm_time = { 0, };
-    int fd = -1;
-    int ret = 0, rc = SR_ERR_OK;
-
-    /* create the parent directory for notifications (if it does not exist already) */
-    strncat(filename_buff, SR_NOTIF_DATA_SEARCH_DIR, filename_buff_size - 1);
-    strncat(filename_buff, "/", filename_buff_size - strlen(filename_buff) - 1);
-    if (-1 == access(filename_buff, F_OK)) {
-        old_umask = umask(0);
-        ret = mkdir(filename_buff, S_IRWXU | S_IRWXG | S_IRWXO);
-        umask(old_umask);
-        CHECK_ZERO_LOG_RETURN(ret, SR_ERR_INTERNAL, "Unable to create the directory '%s': %s", filename_buff,
-                sr_strerror_safe(errno));
-    }
-
-    /* create directory for module notifications (if it does not exist already) */
-    strncat(filename_buff, module_name, filename_buff_size - strlen(filename_buff) - 1);
-    strncat(filename_buff, "/", filename_buff_size - strlen(filename_buff) - 1);
-    if (-1 == access(filename_buff, F_OK)) {
-        old_umask = umask(0);
-        ret = mkdir(filename_buff, S_IRWXU | S_IRWXG | S_IRWXO);
-        umask(old_umask);
-        CHECK_ZERO_LOG_RETURN(ret, SR_ERR_INTERNAL, "Unable to create the directory '%s': %s", filename_buff,
-                sr_strerror_safe(errno));
-    }
-
-    /* generate data filename according to the current time */
-    raw_time = received_time;
-    tm_time = localtime(&raw_time);
-    /* move raw_time back to the beginning of the current NP_NOTIF_FILE_WINDOW */
-    raw_time -= (((tm_time->tm_hour * 60) + tm_time->tm_min) % SR_NOTIF_TIME_WINDOW) * 60;
-    strftime(filename_buff + strlen(filename_buff), filename_buff_size - strlen(filename_buff) - 1,
-            "%Y-%m-%d_%H-%M.xml", localtime(&raw_time));
-
-    /* create file if not exists & apply access permissions */
-    if (-1 == access(filename_buff, F_OK)) {
-        old_umask = umask(0);
-        fd = open(filename_buff, O_CREAT, S_IRUSR | S_IWUSR);
-        if (-1 == fd) {
-            SR_LOG_WRN("Error by opening file '%s': %s.", filename_buff, sr_strerror_safe(errno));
-        } else {
-            /* close and apply access permissions */
-            close(fd);
-            umask(old_umask);
-            rc = sr_set_data_file_permissions(filename_buff, false, SR_DATA_SEARCH_DIR, module_name, false);
-            if (SR_ERR_OK != rc) {
-                SR_LOG_WRN("Error by applying correct data file permissions on file '%s'.", filename_buff);
+    np_commit_verifier_t *verifier = NULL;
+
+    if (NULL == commit->verifiers) {
+        return;
+    }
+
+    for (size_t i = 0; i < commit->verifiers->count; i++) {
+        verifier = commit->verifiers->data[i];
+        if (NULL != verifier->notif) {
+            SR_LOG_DBG("Verify notification for '%s' won't be sent, commit id=%"PRIu32" is being aborted.",
+                    verifier->subs_xpath, commit->commit_id);
+            sr_msg_free(verifier->notif);
+            verifier->notif = NULL;
+            verifier->acked = true;
+            commit->notifications_sent--;
+            if (NULL == commit->err_subs_xpaths && SR_ERR_OK != sr_list_init(&commit->err_subs_xpaths)) {
+                continue;
             }
+            sr_list_add(commit->err_subs_xpaths, strdup(verifier->subs_xpath));
         }
     }
-
-    return SR_ERR_OK;
 }
 
 /**
- * @brief Get notification files of given module with last modification time from provided time interval.
+ * @brief Returns the dispatched verifier that has not answered yet.
+ * NP context lock is expected to be held for writing.
  */
-static int
-np_get_notification_files(np_ctx_t *np_ctx, const char *module_name, time_t time_from, time_t time_to,
-        sr_list_t *file_list)
+static np_commit_verifier_t *
+np_commit_verifier_find_locked(np_commit_ctx_t *commit, const char *dst_address, uint32_t dst_id)
 {
-    char dirname[PATH_MAX] = { 0, };
-    char filename[PATH_MAX] = { 0, };
-    struct dirent **entries = NULL;
-    int dir_elem_cnt = 0;
-    struct stat sb = { 0, };
-    int ret = 0, rc = SR_ERR_OK;
-
-    CHECK_NULL_ARG3(np_ctx, module_name, file_list);
+    np_commit_verifier_t *verifier = NULL;
 
-    if (sr_ll_stderr >= SR_LL_DBG) {
-        strftime(dirname, PATH_MAX - 1, "%Y-%m-%d %H:%M", localtime(&time_from));
-        strftime(filename, PATH_MAX - 1, "%Y-%m-%d %H:%M", localtime(&time_to));
+    if (NULL == commit->verifiers || NULL == dst_address) {
+        return NULL;
     }
-    SR_LOG_DBG("Listing notification data files for '%s' modified from '%s' to '%s'.", module_name, dirname, filename);
 
-    snprintf(dirname, PATH_MAX - 1, "%s/%s", SR_NOTIF_DATA_SEARCH_DIR, module_name);
-
-    /* scan files in the directory with the data files (in alphabetical order) */
-    dir_elem_cnt = scandir(dirname, &entries, NULL, alphasort);
-    if (dir_elem_cnt < 0) {
-        if (errno != ENOENT) {
-            SR_LOG_ERR("Error by scanning directory: %s.", sr_strerror_safe(errno));
-        }
-    } else {
-        for (size_t i = 0; i < dir_elem_cnt; i++) {
-            if ((DT_DIR != entries[i]->d_type) &&
-                    (0 != strcmp(entries[i]->d_name, ".")) && (0 != strcmp(entries[i]->d_name, ".."))) {
-                /* for each file */
-                snprintf(filename, PATH_MAX - 1, "%s/%s", dirname, entries[i]->d_name);
-                ret = stat(filename, &sb);
-                if ((-1 != ret) && (sb.st_mtime >= time_from) && (sb.st_mtime <= time_to)) {
-                    /* file modification time matches with provided time interval */
-                    SR_LOG_DBG("Adding file '%s', mtim=%ld", filename, sb.st_mtime);
-                    rc = sr_list_add(file_list, strdup(filename));
-                    if (SR_ERR_OK != rc) {
-                        SR_LOG_WRN("Error by adding file '%s' to the list: %s.", filename, sr_strerror(rc));
-                    }
-                }
-            }
-            free(entries[i]);
+    for (size_t i = 0; i < commit->verifiers->count; i++) {
+        verifier = commit->verifiers->data[i];
+        if (NULL == verifier->notif && !verifier->acked && dst_id == verifier->dst_id &&
+                0 == strcmp(dst_address, verifier->dst_address)) {
+            return verifier;
         }
-        free(entries);
     }
-
-    return SR_ERR_OK;
+    return NULL;
 }
 
 /**
- * @brief Get notification files of all modules with last modification time from provided time interval.
+ * @brief Adds an error xpath into commit context.
  */
 static int
-np_get_all_notification_files(np_ctx_t *np_ctx, time_t time_from, time_t time_to, sr_list_t *file_list)
+np_commit_error_add(np_commit_ctx_t *commit_ctx, const char *err_subs_xpath, bool do_not_send_abort,
+        const char *err_msg, const char *err_xpath)
 {
-    DIR *dir = { 0, };
-    struct dirent entry = { 0, }, *result = NULL;
-    int ret = 0, rc = SR_ERR_OK;
-
-    CHECK_NULL_ARG2(np_ctx, file_list);
+    sr_error_info_t *error = NULL;
+    int rc = SR_ERR_OK;
 
-    SR_LOG_DBG("Listing notification directories in '%s'.", SR_NOTIF_DATA_SEARCH_DIR);
+    CHECK_NULL_ARG2(commit_ctx, err_subs_xpath);
 
-    /* open the directory with notifications */
-    dir = opendir(SR_NOTIF_DATA_SEARCH_DIR);
-    if (NULL == dir) {
-        SR_LOG_ERR("Error by opening directory '%s': %s.", SR_NOTIF_DATA_SEARCH_DIR, sr_strerror_safe(errno));
-        return SR_ERR_INTERNAL;
+    if (do_not_send_abort) {
+        SR_LOG_DBG("Subscription '%s' doesn't want abort notification", err_subs_xpath);
+        if (NULL == commit_ctx->err_subs_xpaths) {
+            rc = sr_list_init(&commit_ctx->err_subs_xpaths);
+            CHECK_RC_MSG_RETURN(rc, "Unable to init sr_list for errored verifier xpaths.");
+        }
+        rc = sr_list_add(commit_ctx->err_subs_xpaths, strdup(err_subs_xpath));
     }
-    /* read files in the directory */
-    do {
-        ret = readdir_r(dir, &entry, &result);
-        if (0 != ret) {
-            SR_LOG_ERR("Error by reading directory: %s.", sr_strerror_safe(errno));
-            break;
+    if (SR_ERR_OK == rc && NULL != err_msg) {
+        if (NULL == commit_ctx->errors) {
+            rc = sr_list_init(&commit_ctx->errors);
         }
-        if ((NULL != result) && (0 != strcmp(entry.d_name, ".")) && (0 != strcmp(entry.d_name, ".."))) {
-            /* for each directory */
-            SR_LOG_DBG("Listing notification directory '%s'.", entry.d_name);
-            rc = np_get_notification_files(np_ctx, entry.d_name, time_from, time_to, file_list);
-            if (SR_ERR_OK != rc) {
-                SR_LOG_WRN("Error by retrieving notification files from '%s' directory: %s.",
-                        entry.d_name, sr_strerror(rc));
+        if (SR_ERR_OK == rc) {
+            error = calloc(1, sizeof(*error));
+            error->message = strdup(err_msg);
+            if (NULL != err_xpath) {
+                error->xpath = strdup(err_xpath);
             }
+            rc = sr_list_add(commit_ctx->errors, error);
         }
-    } while (NULL != result);
-    closedir(dir);
+    }
 
-    return SR_ERR_OK;
+    return rc;
 }
 
 /**
@@ -643,73 +583,16 @@ np_event_notification_content_cleanup(np_ev_notification_t *notification)
 }
 
 /**
- * @brief Fills event notification details from libyang's list instance of a notification.
+ * @brief Adjusts the retention policy of the module according to its persistent data.
  */
-static int
-np_event_notification_entry_fill(np_ev_notification_t *notification, struct lyd_node *node)
-{
-    struct lyd_node_leaf_list *node_ll = NULL;
-    struct lyd_node_anydata *node_anydata = NULL;
-    int rc = SR_ERR_OK;
-
-    CHECK_NULL_ARG3(notification, node, node->schema);
-
-    while (NULL != node) {
-        if (NULL != node->schema && NULL != node->schema->name) {
-            node_ll = (struct lyd_node_leaf_list*)node;
-            if (0 == strcmp(node->schema->name, "xpath") && NULL != node_ll->value_str) {
-                notification->xpath = strdup(node_ll->value_str);
-                CHECK_NULL_NOMEM_GOTO(notification->xpath, rc, cleanup);
-            }
-            if (0 == strcmp(node->schema->name, "generated-time") && NULL != node_ll->value_str) {
-                rc = sr_str_to_time((char*)node_ll->value_str, &notification->timestamp);
-                CHECK_RC_MSG_GOTO(rc, cleanup, "String to time conversion failed.");
-            }
-            if (0 == strcmp(node->schema->name, "data") && LYS_ANYDATA == node->schema->nodetype) {
-                node_anydata = (struct lyd_node_anydata*)node;
-                if (LYD_ANYDATA_XML == node_anydata->value_type) {
-                    notification->data.xml = node_anydata->value.xml;
-                    notification->data_type = NP_EV_NOTIF_DATA_XML;
-                } else if (LYD_ANYDATA_CONSTSTRING == node_anydata->value_type) {
-                    notification->data.string = node_anydata->value.str;
-                    notification->data_type = NP_EV_NOTIF_DATA_STRING;
-                }
-            }
-        }
-        node = node->next;
-    }
-
-    return SR_ERR_OK;
-
-cleanup:
-    np_event_notification_content_cleanup(notification);
-    return rc;
-}
-
-/**
- * @brief Sets up notification store cleanup timer.
- */
-static int
-np_setup_notif_store_cleanup_timer(np_ctx_t *np_ctx, uint32_t timeout)
+static void
+np_notif_store_retention_cb(const char *module_name, np_notif_store_retention_t *retention, void *private_ctx)
 {
-    Sr__Msg *req = NULL;
-    int rc = SR_ERR_OK;
+    np_ctx_t *np_ctx = (np_ctx_t *) private_ctx;
 
-    /* setup the timer */
-    rc = sr_gpb_internal_req_alloc(NULL, SR__OPERATION__NOTIF_STORE_CLEANUP, &req);
-    if (SR_ERR_OK == rc) {
-        req->internal_request->postpone_timeout = timeout;
-        req->internal_request->has_postpone_timeout = true;
-        /* enqueue the message */
-        rc = cm_msg_send(np_ctx->rp_ctx->cm_ctx, req);
-    }
-    if (SR_ERR_OK == rc) {
-        SR_LOG_DBG("Notification store cleanup timer set up for %"PRIu32" seconds.", timeout);
-    } else {
-        SR_LOG_ERR_MSG("Unable to setup notification store cleanup timer.");
+    if (NULL != np_ctx->rp_ctx->pm_ctx) {
+        pm_get_notif_retention(np_ctx->rp_ctx->pm_ctx, module_name, retention);
     }
-
-    return rc;
 }
 
 /**
@@ -727,7 +610,7 @@ int
 np_init(rp_ctx_t *rp_ctx, const char *schema_search_dir, const char *data_search_dir, np_ctx_t **np_ctx_p)
 {
     np_ctx_t *ctx = NULL;
-    char *schema_filename = NULL;
+    np_notif_store_retention_t retention = { 0, };
     int rc = SR_ERR_OK, ret = 0;
 
     CHECK_NULL_ARG2(rp_ctx, np_ctx_p);
@@ -750,9 +633,20 @@ np_init(rp_ctx_t *rp_ctx, const char *schema_search_dir, const char *data_search
     ret = pthread_rwlock_init(&ctx->lock, NULL);
     CHECK_ZERO_MSG_GOTO(ret, rc, SR_ERR_INTERNAL, cleanup, "Subscriptions lock initialization failed.");
 
-    /* init notif. data files locking set */
-    rc = sr_locking_set_init(&ctx->lock_ctx);
-    CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to initialize locking set.");
+    /* init notification store */
+    rc = np_notif_store_init(SR_NOTIF_DATA_SEARCH_DIR, SR_DATA_SEARCH_DIR, &ctx->notif_store);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to initialize notification store.");
+
+    /* default retention policy, can be adjusted per module in its persistent data */
+    retention.max_age = SR_NOTIF_AGE_TIMEOUT * 60;
+    retention.max_size = (uint64_t) SR_NOTIF_MAX_SIZE * 1024;
+    retention.max_count = SR_NOTIF_MAX_COUNT;
+    rc = np_notif_store_set_retention(ctx->notif_store, &retention, np_notif_store_retention_cb, ctx);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to set notification store retention policy.");
+
+    /* init latency statistics of commit verifiers */
+    rc = rp_dp_latency_init(&ctx->verify_latency);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to initialize latency statistics of commit verifiers.");
 
     /* save data search directory */
     ctx->data_search_dir = strdup(data_search_dir);
@@ -767,24 +661,11 @@ np_init(rp_ctx_t *rp_ctx, const char *schema_search_dir, const char *data_search
     }
     ly_set_log_clb(np_ly_log_cb, 0);
 
-    rc = sr_str_join(schema_search_dir, NP_NS_SCHEMA_FILE, &schema_filename);
-    if (SR_ERR_OK != rc) {
-        goto cleanup;
-    }
-
-    /* load persist files schema to the context */
-    ctx->ns_schema = lys_parse_path(ctx->ly_ctx, schema_filename, LYS_IN_YANG);
-    free(schema_filename);
-    if (NULL == ctx->ns_schema) {
-        SR_LOG_ERR("Unable to parse the schema file '%s': %s", NP_NS_SCHEMA_FILE, ly_errmsg());
-        rc = SR_ERR_INTERNAL;
-        goto cleanup;
-    }
-
-    /* if running in daemon mode, setup notif. store cleanup timer */
+    /* if running in daemon mode, enforce the retention policy in the background */
     if (CM_MODE_DAEMON == cm_get_connection_mode(rp_ctx->cm_ctx)) {
         ctx->do_notif_store_cleanup = true;
-        np_setup_notif_store_cleanup_timer(ctx, (SR_NOTIF_TIME_WINDOW * 60));
+        rc = np_notif_store_compactor_start(ctx->notif_store);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to start notification store compactor.");
     }
 
     SR_LOG_DBG_MSG("Notification Processor initialized successfully.");
@@ -813,7 +694,7 @@ np_cleanup(np_ctx_t *np_ctx)
         /* cleanup unfinished commits */
         node = np_ctx->commits->first;
         while (NULL != node) {
-            free(node->data);
+            np_commit_ctx_free(node->data);
             node = node->next;
         }
         sr_llist_cleanup(np_ctx->commits);
@@ -821,16 +702,17 @@ np_cleanup(np_ctx_t *np_ctx)
         sr_btree_cleanup(np_ctx->dst_info_btree);
         pthread_rwlock_destroy(&np_ctx->lock);
 
-        sr_locking_set_cleanup(np_ctx->lock_ctx);
+        if (np_ctx->do_notif_store_cleanup && NULL != np_ctx->notif_store) {
+            np_notification_store_cleanup(np_ctx);
+        }
+        np_notif_store_cleanup(np_ctx->notif_store);
+
+        rp_dp_latency_cleanup(np_ctx->verify_latency);
         free((void*)np_ctx->data_search_dir);
         if (NULL != np_ctx->ly_ctx) {
             ly_ctx_destroy(np_ctx->ly_ctx, NULL);
         }
 
-        if (np_ctx->do_notif_store_cleanup) {
-            np_notification_store_cleanup(np_ctx, false);
-        }
-
         free(np_ctx);
     }
 }
@@ -938,7 +820,7 @@ cleanup:
     free(module_name);
     ly_set_free(set);
     if (NULL != si) {
-        pthread_rwlock_unlock(&si->model_lock);
+        SR_RWLOCK_UNLOCK(&si->model_lock);
     }
 
     return rc;
@@ -947,7 +829,8 @@ cleanup:
 int
 np_notification_subscribe(np_ctx_t *np_ctx, const rp_session_t *rp_session, Sr__SubscriptionType type,
         const char *dst_address, uint32_t dst_id, const char *module_name, const char *xpath, const char *username,
-        Sr__NotificationEvent notif_event, uint32_t priority, sr_api_variant_t api_variant, const np_subscr_options_t opts)
+        Sr__NotificationEvent notif_event, uint32_t priority, uint32_t dp_cache_ttl, sr_api_variant_t api_variant,
+        const np_subscr_options_t opts)
 {
     np_subscription_t *subscription = NULL;
     np_subscription_t **subscriptions_tmp = NULL;
@@ -981,8 +864,11 @@ np_notification_subscribe(np_ctx_t *np_ctx, const rp_session_t *rp_session, Sr__
 
     subscription->notif_event = notif_event;
     subscription->priority = priority;
+    subscription->dp_cache_ttl = (SR__SUBSCRIPTION_TYPE__DP_GET_ITEMS_SUBS == type) ? dp_cache_ttl : 0;
     subscription->enable_running = (opts & NP_SUBSCR_ENABLE_RUNNING);
     subscription->enable_nacm = (rp_session->options & SR_SESS_ENABLE_NACM);
+    subscription->inline_changes = (opts & NP_SUBSCR_INLINE_CHANGES) &&
+            (SR__SUBSCRIPTION_TYPE__MODULE_CHANGE_SUBS == type || SR__SUBSCRIPTION_TYPE__SUBTREE_CHANGE_SUBS == type);
     subscription->api_variant = api_variant;
 
     if (NULL != xpath) {
@@ -1348,7 +1234,8 @@ np_get_data_provider_subscriptions(np_ctx_t *np_ctx, const rp_session_t *rp_sess
 }
 
 int
-np_subscription_notify(np_ctx_t *np_ctx, np_subscription_t *subscription, sr_notif_event_t event, uint32_t commit_id)
+np_subscription_notify(np_ctx_t *np_ctx, np_subscription_t *subscription, sr_notif_event_t event, uint32_t commit_id,
+        sr_list_t *changes)
 {
     Sr__Msg *notif = NULL;
     int rc = SR_ERR_OK;
@@ -1374,13 +1261,28 @@ np_subscription_notify(np_ctx_t *np_ctx, np_subscription_t *subscription, sr_not
             CHECK_NULL_NOMEM_ERROR(notif->notification->subtree_change_notif->xpath, rc);
         }
     }
+    if (SR_ERR_OK == rc && NULL != changes) {
+        /* deliver the changes within the notification */
+        rc = sr_changes_sr_to_gpb(changes, NULL, &notif->notification->changes, &notif->notification->n_changes);
+        if (SR_ERR_OK == rc) {
+            notif->notification->changes_inlined = true;
+            notif->notification->has_changes_inlined = true;
+        }
+    }
 
     if (SR_ERR_OK == rc) {
         /* save notification destination info */
         rc = np_dst_info_insert(np_ctx, subscription->dst_address, subscription->module_name);
     }
-    if (SR_ERR_OK == rc) {
+    if (SR_ERR_OK == rc && SR_EV_VERIFY == event) {
+        /* verifiers are notified level by level according to their priority */
+        rc = np_commit_verifier_add(np_ctx, commit_id, subscription, notif);
+        if (SR_ERR_OK != rc) {
+            sr_msg_free(notif);
+        }
+    } else if (SR_ERR_OK == rc) {
         /* send the message */
+        SR_PROBE3(notif__send, subscription->dst_address, subscription->dst_id, subscription->type);
         rc = cm_msg_send(np_ctx->rp_ctx->cm_ctx, notif);
         if (SR_ERR_OK == rc) {
             rc = np_commit_notif_cnt_increment(np_ctx, commit_id);
@@ -1394,30 +1296,55 @@ np_subscription_notify(np_ctx_t *np_ctx, np_subscription_t *subscription, sr_not
 
 int
 np_data_provider_request(np_ctx_t *np_ctx, np_subscription_t *subscription, rp_session_t *session, const char *xpath)
+{
+    CHECK_NULL_ARG(xpath);
+
+    return np_data_provider_request_batch(np_ctx, subscription, session, &xpath, 1);
+}
+
+int
+np_data_provider_request_batch(np_ctx_t *np_ctx, np_subscription_t *subscription, rp_session_t *session,
+        const char **xpaths, size_t xpath_cnt)
 {
     Sr__Msg *req = NULL;
+    Sr__DataProvideReq *dp_req = NULL;
     int rc = SR_ERR_OK;
 
-    CHECK_NULL_ARG5(np_ctx, np_ctx->rp_ctx, subscription, subscription->dst_address, xpath);
+    CHECK_NULL_ARG5(np_ctx, np_ctx->rp_ctx, subscription, subscription->dst_address, xpaths);
     CHECK_NULL_ARG2(session, session->req);
 
-    SR_LOG_DBG("Requesting operational data of '%s' from '%s' @ %"PRIu32".", subscription->xpath,
-            subscription->dst_address, subscription->dst_id);
+    if (0 == xpath_cnt || NULL == xpaths[0]) {
+        SR_LOG_ERR_MSG("No xpath to be requested from the data provider.");
+        return SR_ERR_INVAL_ARG;
+    }
+
+    SR_LOG_DBG("Requesting operational data of '%s' (%zu xpath(s)) from '%s' @ %"PRIu32".", subscription->xpath,
+            xpath_cnt, subscription->dst_address, subscription->dst_id);
 
     rc = sr_gpb_req_alloc(NULL, SR__OPERATION__DATA_PROVIDE, session->id, &req);
 
     if (SR_ERR_OK == rc) {
-        req->request->data_provide_req->xpath = strdup(xpath);
-        CHECK_NULL_NOMEM_ERROR(req->request->data_provide_req->xpath, rc);
-
-        if (SR_ERR_OK == rc) {
-            req->request->data_provide_req->subscription_id = subscription->dst_id;
-            req->request->data_provide_req->subscriber_address = strdup(subscription->dst_address);
-            CHECK_NULL_NOMEM_ERROR(req->request->data_provide_req->subscriber_address, rc);
-            /* identification of the request that asked for data */
-            req->request->data_provide_req->request_id = session->req->request->_id;
+        dp_req = req->request->data_provide_req;
+        dp_req->xpath = strdup(xpaths[0]);
+        CHECK_NULL_NOMEM_ERROR(dp_req->xpath, rc);
+    }
+    if (SR_ERR_OK == rc && xpath_cnt > 1) {
+        /* batched request - all xpaths are listed */
+        dp_req->xpaths = calloc(xpath_cnt, sizeof(*dp_req->xpaths));
+        CHECK_NULL_NOMEM_ERROR(dp_req->xpaths, rc);
+        for (size_t i = 0; SR_ERR_OK == rc && i < xpath_cnt; i++) {
+            dp_req->xpaths[i] = strdup(xpaths[i]);
+            CHECK_NULL_NOMEM_ERROR(dp_req->xpaths[i], rc);
+            dp_req->n_xpaths = i + 1;
         }
     }
+    if (SR_ERR_OK == rc) {
+        dp_req->subscription_id = subscription->dst_id;
+        dp_req->subscriber_address = strdup(subscription->dst_address);
+        CHECK_NULL_NOMEM_ERROR(dp_req->subscriber_address, rc);
+        /* identification of the request that asked for data */
+        dp_req->request_id = session->req->request->_id;
+    }
 
     if (SR_ERR_OK == rc) {
         /* save notification destination info */
@@ -1469,6 +1396,9 @@ np_commit_notifications_sent(np_ctx_t *np_ctx, uint32_t commit_id, bool commit_f
         commit->all_notifications_sent = true;
         commit->commit_finished = commit_finished;
 
+        /* send the verify notifications with the highest priority */
+        np_commit_verifiers_dispatch_locked(np_ctx, commit);
+
         /* setup commit timer */
         rc = sr_gpb_internal_req_alloc(NULL, SR__OPERATION__COMMIT_TIMEOUT, &req);
         if (SR_ERR_OK == rc) {
@@ -1498,22 +1428,39 @@ np_commit_notifications_sent(np_ctx_t *np_ctx, uint32_t commit_id, bool commit_f
 }
 
 int
-np_commit_notification_ack(np_ctx_t *np_ctx, uint32_t commit_id, char *subs_xpath, sr_notif_event_t event, int result,
-        bool do_not_send_abort, const char *err_msg, const char *err_xpath)
+np_commit_notification_ack(np_ctx_t *np_ctx, uint32_t commit_id, const char *dst_address, uint32_t dst_id,
+        char *subs_xpath, sr_notif_event_t event, int result, bool do_not_send_abort, const char *err_msg,
+        const char *err_xpath)
 {
     np_commit_ctx_t *commit = NULL;
+    np_commit_verifier_t *verifier = NULL;
     sr_llist_node_t *commit_node = NULL;
+    struct timespec now = { 0, };
     bool all_acks_received = false;
+    bool verify_in_progress = false;
     int rc = SR_ERR_OK;
 
     CHECK_NULL_ARG(np_ctx);
 
+    SR_PROBE3(notif__ack, commit_id, event, result);
+
     pthread_rwlock_wrlock(&np_ctx->lock);
 
     commit = np_commit_ctx_find(np_ctx, commit_id, &commit_node);
 
+    if (NULL != commit && SR_EV_VERIFY == event) {
+        verify_in_progress = commit->verify_in_progress;
+        verifier = np_commit_verifier_find_locked(commit, dst_address, dst_id);
+        if (NULL != verifier) {
+            verifier->acked = true;
+            sr_clock_get_time(CLOCK_MONOTONIC, &now);
+            rp_dp_latency_record(np_ctx->verify_latency, verifier->subs_xpath,
+                    (now.tv_sec - verifier->sent.tv_sec) * 1000 + (now.tv_nsec - verifier->sent.tv_nsec) / 1000000);
+        }
+    }
+
     if (NULL != commit) {
-        if (SR_EV_VERIFY == event && SR_ERR_OK != result) {
+        if (SR_EV_VERIFY == event && SR_ERR_OK != result && verify_in_progress) {
             /* error returned from the verifier */
             if (SR_ERR_OK == commit->result) {
                 /* if there isn't any previous error stored within the commit context, store there this one */
@@ -1526,6 +1473,17 @@ np_commit_notification_ack(np_ctx_t *np_ctx, uint32_t commit_id, char *subs_xpat
                     subs_xpath, err_msg, err_xpath);
         }
         commit->notifications_acked++;
+        if (SR_EV_VERIFY == event && verify_in_progress) {
+            if (SR_ERR_OK != commit->result) {
+                /* do not wait for the remaining verifiers, the commit is going to be aborted anyway */
+                np_commit_verifiers_drop_locked(commit);
+                commit->verify_in_progress = false;
+                all_acks_received = commit->all_notifications_sent;
+            } else {
+                /* continue with the next priority level */
+                np_commit_verifiers_dispatch_locked(np_ctx, commit);
+            }
+        }
         if (commit->all_notifications_sent && (commit->notifications_sent == commit->notifications_acked)) {
             all_acks_received = true;
         }
@@ -1543,6 +1501,14 @@ np_commit_notification_ack(np_ctx_t *np_ctx, uint32_t commit_id, char *subs_xpat
     return rc;
 }
 
+int
+np_get_verifier_stats(np_ctx_t *np_ctx, rp_dp_latency_stats_t **stats, size_t *stats_cnt)
+{
+    CHECK_NULL_ARG(np_ctx);
+
+    return rp_dp_latency_get_stats(np_ctx->verify_latency, stats, stats_cnt);
+}
+
 int
 np_commit_notifications_complete(np_ctx_t *np_ctx, uint32_t commit_id, bool timeout_expired)
 {
@@ -1558,6 +1524,17 @@ np_commit_notifications_complete(np_ctx_t *np_ctx, uint32_t commit_id, bool time
     pthread_rwlock_wrlock(&np_ctx->lock);
 
     commit = np_commit_ctx_find(np_ctx, commit_id, &commit_node);
+    if (NULL != commit && commit->verify_in_progress) {
+        /* verify phase has finished (possibly by timeout) */
+        np_commit_verifiers_drop_locked(commit);
+        for (size_t i = 0; NULL != commit->verifiers && i < commit->verifiers->count; i++) {
+            np_commit_verifier_t *verifier = commit->verifiers->data[i];
+            if (timeout_expired && !verifier->acked) {
+                rp_dp_latency_record_timeout(np_ctx->verify_latency, verifier->subs_xpath);
+            }
+        }
+        commit->verify_in_progress = false;
+    }
     if (NULL != commit) {
         found = true;
         result = commit->result;
@@ -1568,7 +1545,7 @@ np_commit_notifications_complete(np_ctx_t *np_ctx, uint32_t commit_id, bool time
             /* commit has finished, release commit context */
             SR_LOG_DBG("Releasing commit id=%"PRIu32".", commit_id);
             sr_llist_rm(np_ctx->commits, commit_node);
-            free(commit);
+            np_commit_ctx_free(commit);
             commit = NULL;
         } else {
             /* reset the context for the next commit phase */
@@ -1631,116 +1608,165 @@ np_subscriptions_list_cleanup(sr_list_t *subscriptions_list)
     }
 }
 
-int
-np_store_event_notification(np_ctx_t *np_ctx, const ac_ucred_t *user_cred, const char *xpath, const time_t generated_time,
-        struct lyd_node *notif_data_tree)
+/**
+ * @brief Serializes the event notification data for the notification store.
+ */
+static int
+np_event_notification_serialize(np_ctx_t *np_ctx, const char *xpath, struct lyd_node *notif_data_tree,
+        np_notif_store_entry_t *entry)
 {
-#define TIME_BUF_SIZE 64
-
-    char *module_name = NULL;
-    char data_filename[PATH_MAX] = { 0, };
-    char data_xpath[PATH_MAX] = { 0, };
-    char generated_time_buf[TIME_BUF_SIZE] = { 0, };
-    struct timespec logged_time_spec = { 0, };
-    struct lyd_node *data_tree = NULL, *new_node = NULL, *dt_dup = NULL;
-    int fd = -1;
-    int rc = SR_ERR_OK;
-
-    CHECK_NULL_ARG3(np_ctx, xpath, notif_data_tree);
-
-    SR_LOG_DBG("Storing notification '%s' generated on '%ld'.", xpath, generated_time);
+    char *data = NULL;
+    int ret = 0, rc = SR_ERR_OK;
 
     /* check for special notifications which are not allowed */
     if (0 == strcmp(xpath, "/nc-notifications:replayComplete")) {
         SR_LOG_ERR_MSG("Special notification \"replayComplete\" is generated only by sysrepo itself.");
-        rc = SR_ERR_BAD_ELEMENT;
-        goto cleanup;
+        return SR_ERR_BAD_ELEMENT;
     } else if (0 == strcmp(xpath, "/nc-notifications:notificationComplete")) {
         SR_LOG_ERR_MSG("Special notification \"notificationComplete\" is generated only by sysrepo itself.");
-        rc = SR_ERR_BAD_ELEMENT;
-        goto cleanup;
+        return SR_ERR_BAD_ELEMENT;
     }
 
     /* extract module name from xpath */
-    rc = sr_copy_first_ns(xpath, &module_name);
-    CHECK_RC_MSG_GOTO(rc, cleanup, "Error by extracting module name from xpath.");
+    rc = sr_copy_first_ns(xpath, (char **) &entry->module_name);
+    CHECK_RC_MSG_RETURN(rc, "Error by extracting module name from xpath.");
 
-    /* get current notification data filename */
-    rc = np_get_notif_store_filename(module_name, generated_time, data_filename, PATH_MAX);
-    CHECK_RC_LOG_GOTO(rc, cleanup, "Unable to compose notification data file name for '%s'.", module_name);
+    /* serialize notification data */
+    if (0 == strcmp("/ietf-netconf-notifications:netconf-config-change", xpath)) {
+        rc = dm_netconf_config_change_to_string(np_ctx->rp_ctx->dm_ctx, notif_data_tree, &data);
+        CHECK_RC_MSG_RETURN(rc, "Failed print config-change notif to string");
+        entry->data_type = NP_NOTIF_STORE_DATA_STRING;
+    } else {
+        ret = lyd_print_mem(&data, notif_data_tree, LYD_XML, LYP_WD_EXPLICIT);
+        CHECK_ZERO_LOG_RETURN(ret, SR_ERR_INTERNAL, "Error by printing notification data tree: %s.", ly_errmsg());
+        CHECK_NULL_NOMEM_RETURN(data);
+        entry->data_type = NP_NOTIF_STORE_DATA_XML;
+    }
 
-    /* load notif. data */
-    rc = np_load_data_tree(np_ctx, user_cred, data_filename, false, &data_tree, &fd);
-    CHECK_RC_LOG_GOTO(rc, cleanup, "Unable to load notification store data for module '%s'.", module_name);
+    entry->xpath = xpath;
+    entry->data = data;
+    return SR_ERR_OK;
+}
 
-    /* format the time & retrieve current time */
-    sr_time_to_str(generated_time, generated_time_buf, TIME_BUF_SIZE);
-    sr_clock_get_time(CLOCK_REALTIME, &logged_time_spec);
+int
+np_store_event_notification(np_ctx_t *np_ctx, const char *xpath, const time_t generated_time,
+        struct lyd_node *notif_data_tree)
+{
+    CHECK_NULL_ARG3(np_ctx, xpath, notif_data_tree);
 
-    /* create data subtree to be stored in the notif. data file */
-    snprintf(data_xpath, PATH_MAX - 1, NP_NS_XPATH_NOTIFICATION, xpath, generated_time_buf,
-            /* logged-time in hundreds of seconds */
-            (uint32_t) (((logged_time_spec.tv_sec * 100) + (uint32_t)(logged_time_spec.tv_nsec / 1.0e7)) % UINT32_MAX));
-    new_node = lyd_new_path(data_tree, np_ctx->ly_ctx, data_xpath, NULL, 0, 0);
-    if (NULL == new_node) {
-        SR_LOG_WRN("Error by adding new notification entry: %s.", ly_errmsg());
-        goto cleanup; /* do not set error code - it may be just too much notifications within the same hundred of second */
-    }
-    if (NULL == data_tree) {
-        /* if the new data tree has been just created */
-        data_tree = new_node;
-        new_node = new_node->child; /* new_node is 'notifications' container */
-    }
+    return np_store_event_notifications(np_ctx, &xpath, &generated_time, &notif_data_tree, 1);
+}
 
-    if (0 == strcmp("/ietf-netconf-notifications:netconf-config-change", xpath)) {
-        char *string_notif = NULL;
-        rc = dm_netconf_config_change_to_string(np_ctx->rp_ctx->dm_ctx, notif_data_tree, &string_notif);
-        CHECK_RC_MSG_GOTO(rc, cleanup, "Failed print config-change notif to string");
-        new_node = lyd_new_anydata(new_node, NULL, "data", string_notif, LYD_ANYDATA_STRING);
-    } else {
-        /* store notification data as anydata */
-        dt_dup = lyd_dup_to_ctx(notif_data_tree, 1, notif_data_tree->schema->module->ctx);
-        if (NULL == dt_dup) {
-            SR_LOG_ERR("Error duplicating notification data tree: %s.", ly_errmsg());
+int
+np_store_event_notifications(np_ctx_t *np_ctx, const char **xpaths, const time_t *generated_times,
+        struct lyd_node **notif_data_trees, size_t notif_cnt)
+{
+    np_notif_store_entry_t *entries = NULL;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG4(np_ctx, xpaths, generated_times, notif_data_trees);
+
+    entries = calloc(notif_cnt, sizeof(*entries));
+    CHECK_NULL_NOMEM_RETURN(entries);
+
+    for (size_t i = 0; i < notif_cnt; i++) {
+        CHECK_NULL_ARG_NORET2(rc, xpaths[i], notif_data_trees[i]);
+        if (SR_ERR_OK != rc) {
             goto cleanup;
         }
+        SR_LOG_DBG("Storing notification '%s' generated on '%ld'.", xpaths[i], generated_times[i]);
 
-        new_node = lyd_new_anydata(new_node, NULL, "data", (void*)dt_dup, LYD_ANYDATA_DATATREE);
-    }
-    if (NULL == new_node) {
-        SR_LOG_ERR("Error by adding notification content into notification store: %s.", ly_errmsg());
-        rc = SR_ERR_INTERNAL;
-        goto cleanup;
-    } else {
-        dt_dup = NULL; /* data tree freed in lyd_new_anydata */
+        entries[i].generated_time = generated_times[i];
+        rc = np_event_notification_serialize(np_ctx, xpaths[i], notif_data_trees[i], &entries[i]);
+        if (SR_ERR_OK != rc) {
+            goto cleanup;
+        }
     }
 
-    /* save notif. data */
-    rc = np_save_data_tree(data_tree, fd);
+    /* append the notifications into the store */
+    rc = np_notif_store_append_batch(np_ctx->notif_store, entries, notif_cnt);
     if (SR_ERR_OK == rc) {
-        SR_LOG_DBG("Notification successfully logged into '%s' notification store.", module_name);
+        SR_LOG_DBG("%zu notification(s) successfully logged into the notification store.", notif_cnt);
     }
 
 cleanup:
-    np_cleanup_data_tree(np_ctx, data_tree, fd);
-    free(module_name);
+    for (size_t i = 0; i < notif_cnt; i++) {
+        free((char *) entries[i].module_name);
+        free((char *) entries[i].data);
+    }
+    free(entries);
+    return rc;
+}
+
+/**
+ * @brief Context passed to ::np_event_notification_load_cb.
+ */
+typedef struct np_notif_load_ctx_s {
+    np_ctx_t *np_ctx;                   /**< Notification Processor context. */
+    const rp_session_t *rp_session;     /**< Request Processor session context. */
+    sr_api_variant_t api_variant;       /**< Requested API variant of the data. */
+    np_ev_notification_cb notif_cb;     /**< Callback to be called for each loaded notification. */
+    void *private_ctx;                  /**< Private context passed to the callback. */
+} np_notif_load_ctx_t;
+
+/**
+ * @brief Parses a notification read from the notification store and passes it to the caller's callback.
+ */
+static int
+np_event_notification_load_cb(const np_notif_store_record_t *record, void *private_ctx)
+{
+    np_notif_load_ctx_t *load_ctx = (np_notif_load_ctx_t *) private_ctx;
+    np_ev_notification_t notification = { 0, };
+    struct lyxml_elem *xml = NULL;
+    int rc = SR_ERR_OK;
+
+    notification.xpath = strdup(record->xpath);
+    CHECK_NULL_NOMEM_RETURN(notification.xpath);
+    notification.timestamp = record->generated_time;
+
+    if (NP_NOTIF_STORE_DATA_STRING == record->data_type) {
+        notification.data.string = record->data;
+        notification.data_type = NP_EV_NOTIF_DATA_STRING;
+    } else {
+        xml = lyxml_parse_mem(load_ctx->np_ctx->ly_ctx, record->data, 0);
+        if (NULL == xml) {
+            SR_LOG_ERR("Error by parsing stored notification '%s': %s", record->xpath, ly_errmsg());
+            rc = SR_ERR_INTERNAL;
+            goto cleanup;
+        }
+        notification.data.xml = xml;
+        notification.data_type = NP_EV_NOTIF_DATA_XML;
+    }
+
+    /* parse notification data */
+    rc = dm_parse_event_notif(load_ctx->np_ctx->rp_ctx->dm_ctx, load_ctx->rp_session->dm_session, NULL,
+            &notification, load_ctx->api_variant);
+    CHECK_RC_LOG_GOTO(rc, cleanup, "Error by parsing notification '%s'.", notification.xpath);
+
+    SR_LOG_DBG("Loaded notification: '%s' (time=%ld)", notification.xpath, notification.timestamp);
+
+    /* pass the notification to the caller, it is released right afterwards */
+    rc = load_ctx->notif_cb(&notification, load_ctx->private_ctx);
+
+cleanup:
+    if (NULL != xml) {
+        lyxml_free(load_ctx->np_ctx->ly_ctx, xml);
+    }
+    np_event_notification_content_cleanup(&notification);
     return rc;
 }
 
 int
 np_get_event_notifications(np_ctx_t *np_ctx, const rp_session_t *rp_session, const char *xpath,
-        const time_t start_time, const time_t stop_time, const sr_api_variant_t api_variant, sr_list_t **notifications)
+        const time_t start_time, const time_t stop_time, const sr_api_variant_t api_variant,
+        np_notif_store_cursor_t *cursor, size_t max_cnt, np_ev_notification_cb notif_cb, void *private_ctx)
 {
     char *module_name = NULL;
-    char req_xpath[PATH_MAX] = { 0, };
-    sr_list_t *file_list = NULL, *notif_list = NULL;
-    struct lyd_node *data_tree = NULL, *main_tree = NULL;
-    struct ly_set *node_set = NULL;
-    np_ev_notification_t *notification = NULL;
+    np_notif_load_ctx_t load_ctx = { 0, };
     time_t effective_stop_time = 0;
-    int rc = SR_ERR_OK, ret = 0;
+    int rc = SR_ERR_OK;
 
-    CHECK_NULL_ARG3(np_ctx, xpath, notifications);
+    CHECK_NULL_ARG4(np_ctx, rp_session, xpath, notif_cb);
 
     effective_stop_time = (0 == stop_time) ? time(NULL) : stop_time;
 
@@ -1750,85 +1776,22 @@ np_get_event_notifications(np_ctx_t *np_ctx, const rp_session_t *rp_session, con
     rc = sr_copy_first_ns(xpath, &module_name);
     CHECK_RC_MSG_GOTO(rc, cleanup, "Error by extracting module name from xpath.");
 
-    /* get all notification files matching module name and time interval */
-    rc = sr_list_init(&file_list);
-    CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to initialize file list.");
-
-    /* get all notification files matching module name and provided time interval */
-    rc = np_get_notification_files(np_ctx, module_name,
-            (0 == start_time) ? 0 : (start_time - (SR_NOTIF_TIME_WINDOW * 60)),
-            (effective_stop_time + (SR_NOTIF_TIME_WINDOW * 60)),
-            file_list);
-    CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to retrieve notification file list.");
-
-    /* load all notification files */
-    for (size_t i = 0; i < file_list->count; i++) {
-        rc = np_load_data_tree(np_ctx, rp_session->user_credentials, file_list->data[i], true, &data_tree, NULL);
-        CHECK_RC_LOG_GOTO(rc, cleanup, "Unable to load notification store data for module '%s'.", module_name);
-        if (NULL == main_tree) {
-            main_tree = data_tree;
-        } else {
-            ret = lyd_merge(main_tree, data_tree, LYD_OPT_DESTRUCT);
-            CHECK_ZERO_LOG_GOTO(ret, rc, SR_ERR_INTERNAL, cleanup, "Unable to merge notification trees: %s", ly_errmsg());
-        }
-    }
+    /* authorize (read permissions are required to replay the notifications) */
+    rc = ac_check_module_permissions(rp_session->ac_session, module_name, AC_OPER_READ);
+    CHECK_RC_LOG_GOTO(rc, cleanup, "Access control check failed for module name '%s'", module_name);
 
-    /* get all notifications matching the xpath */
-    if (xpath[strlen(xpath) - 1] == '.') {
-        node_set = lyd_find_xpath(main_tree, "/*/*");
-    } else {
-        snprintf(req_xpath, PATH_MAX, NP_NS_XPATH_NOTIFICATION_BY_XPATH, xpath);
-        node_set = lyd_find_xpath(main_tree, req_xpath);
-    }
-
-    if (NULL != node_set && node_set->number > 0) {
-        /* init the notification list */
-        rc = sr_list_init(&notif_list);
-        CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to initialize notification list.");
-
-        for (size_t i = 0; i < node_set->number; i++) {
-            /* allocate a new notification entry */
-            notification = calloc(1, sizeof(*notification));
-            CHECK_NULL_NOMEM_GOTO(notification, rc, cleanup);
-            /* fill in the notification details */
-            rc = np_event_notification_entry_fill(notification, node_set->set.d[i]->child);
-            CHECK_RC_MSG_GOTO(rc, cleanup, "Error by filling a notification entry.");
-
-            /* filter out notifications not exactly matching the time interval */
-            if (notification->timestamp < start_time || notification->timestamp > effective_stop_time) {
-                np_event_notification_cleanup(notification);
-                notification = NULL;
-                continue;
-            }
-
-            /* parse notification data */
-            rc = dm_parse_event_notif(np_ctx->rp_ctx->dm_ctx, rp_session->dm_session, NULL, notification, api_variant);
-            CHECK_RC_LOG_GOTO(rc, cleanup, "Error by parsing notification '%s'.", notification->xpath);
-
-            SR_LOG_DBG("Adding a new notification: '%s' (time=%ld)", notification->xpath, notification->timestamp);
-
-            /* add the notification into notification list */
-            rc = sr_list_add(notif_list, notification);
-            CHECK_RC_MSG_GOTO(rc, cleanup, "Error by adding notification into list.");
-            notification = NULL;
-        }
-    }
+    load_ctx.np_ctx = np_ctx;
+    load_ctx.rp_session = rp_session;
+    load_ctx.api_variant = api_variant;
+    load_ctx.notif_cb = notif_cb;
+    load_ctx.private_ctx = private_ctx;
 
-    *notifications = notif_list;
-    notif_list = NULL;
+    /* stream all notifications matching the xpath (all notifications of the module for "module:.") and time interval */
+    rc = np_notif_store_read(np_ctx->notif_store, module_name, (xpath[strlen(xpath) - 1] == '.') ? NULL : xpath,
+            start_time, effective_stop_time, cursor, max_cnt, np_event_notification_load_cb, &load_ctx);
+    CHECK_RC_LOG_GOTO(rc, cleanup, "Unable to load notification store data for module '%s'.", module_name);
 
 cleanup:
-    np_event_notification_cleanup(notification);
-    if (NULL != notif_list) {
-        /* in case of error */
-        for (size_t i = 0; i < notif_list->count; i++) {
-            np_event_notification_cleanup(notif_list->data[i]);
-        }
-        sr_list_cleanup(notif_list);
-    }
-    ly_set_free(node_set);
-    lyd_free_withsiblings(main_tree);
-    sr_free_list_of_strings(file_list);
     free(module_name);
     return rc;
 }
@@ -1843,35 +1806,22 @@ np_event_notification_cleanup(np_ev_notification_t *notification)
 }
 
 int
-np_notification_store_cleanup(np_ctx_t *np_ctx, bool reschedule)
+np_notification_store_cleanup(np_ctx_t *np_ctx)
 {
-    sr_list_t *file_list = NULL;
-    int ret = 0, rc = SR_ERR_OK;
-
     CHECK_NULL_ARG(np_ctx);
 
     SR_LOG_DBG_MSG("Notification store cleanup requested.");
 
-    rc = sr_list_init(&file_list);
-    CHECK_RC_MSG_RETURN(rc, "Unable to initialize file list.");
-
-    rc = np_get_all_notification_files(np_ctx, 0, (time(NULL) - (SR_NOTIF_AGE_TIMEOUT * 60)), file_list);
-
-    for (size_t i = 0; i < file_list->count; i++) {
-        SR_LOG_DBG("Deleting old notification data file '%s'.", (char*)file_list->data[i]);
-        ret = unlink((char*)file_list->data[i]);
-        if (-1 == ret) {
-            SR_LOG_WRN("Unable to delete notification data file '%s': %s.",
-                    (char*)file_list->data[i], sr_strerror_safe(ret));
-        }
-    }
+    /* flush the notifications stored since the last batch */
+    np_notif_store_sync(np_ctx->notif_store);
 
-    sr_free_list_of_strings(file_list);
+    return np_notif_store_enforce_retention(np_ctx->notif_store);
+}
 
-    if (reschedule) {
-        /* setup next notif. store cleanup timer */
-        np_setup_notif_store_cleanup_timer(np_ctx, (SR_NOTIF_TIME_WINDOW * 60));
-    }
+int
+np_get_notif_store_size(np_ctx_t *np_ctx, uint32_t *file_cnt, uint64_t *size)
+{
+    CHECK_NULL_ARG3(np_ctx, file_cnt, size);
 
-    return rc;
+    return np_notif_store_get_size(np_ctx->notif_store, file_cnt, size);
 }
@@ -23,6 +23,8 @@
 #define NOTIFICATION_PROCESSOR_H_
 
 #include "sysrepo.h"
+#include "rp_dp_latency.h"
+#include "np_notif_store.h"
 
 typedef struct rp_ctx_s rp_ctx_t;          /**< Forward-declaration of Request Processor context. */
 typedef struct rp_session_s rp_session_t;  /**< Forward-declaration of Request Processor session context. */
@@ -53,8 +55,10 @@ typedef struct np_subscription_s {
     const char *xpath;                 /**< XPath to the subtree where the subscription is active (if applicable). */
     const char *username;              /**< Name of the user behind the subscription (for event notifications only). */
     uint32_t priority;                 /**< Priority of the subscription by delivering notifications (0 is the lowest priority). */
+    uint32_t dp_cache_ttl;             /**< Validity period of the provided data in milliseconds (0 = data is not cached). */
     bool enable_running;               /**< TRUE if the subscription enables specified subtree in the running datastore. */
     bool enable_nacm;                  /**< TRUE if the NETCONF Access Control is enabled for this subscription. */
+    bool inline_changes;               /**< TRUE if the changes are delivered within the change notifications. */
     sr_api_variant_t api_variant;      /**< API variant -- values vs. trees (relevant for the callback type only). */
     size_t copy_cnt;                   /**< Count of other references to the primary structure. 0 means no other copies exist. */
 } np_subscription_t;
@@ -113,6 +117,7 @@ typedef enum np_subscr_flag_e {
     NP_SUBSCR_ENABLE_RUNNING = 1,
     NP_SUBSCR_EXCLUSIVE = 2,
     NP_SUBSCR_EV_EVENT = 4,
+    NP_SUBSCR_INLINE_CHANGES = 8,
 } np_subscr_flag_t;
 
 /**
@@ -134,6 +139,7 @@ typedef uint32_t np_subscr_options_t;
  * @param[in] username Effective user name used to authorize access to receive (event) notifications.
  * @param[in] notif_event Notification event which the notification subscriber is interested in.
  * @param[in] priority Priority of the subscribtion by delivering notifications (0 is the lowest priority).
+ * @param[in] dp_cache_ttl Validity period of the provided data in milliseconds (data provider subscriptions only, 0 = do not cache).
  * @param[in] api_variant Variant of the subscription API which was used to create the subscription.
  * @param[in] opts Options overriding default handling. Bitwise OR-ed value of any ::np_subscr_flag_t flags.
  *
@@ -141,7 +147,8 @@ typedef uint32_t np_subscr_options_t;
  */
 int np_notification_subscribe(np_ctx_t *np_ctx, const rp_session_t *rp_session, Sr__SubscriptionType type,
         const char *dst_address, uint32_t dst_id, const char *module_name, const char *xpath, const char *username,
-        Sr__NotificationEvent notif_event, uint32_t priority, sr_api_variant_t api_variant, const np_subscr_options_t opts);
+        Sr__NotificationEvent notif_event, uint32_t priority, uint32_t dp_cache_ttl, sr_api_variant_t api_variant,
+        const np_subscr_options_t opts);
 
 /**
  * @brief Unsubscribe the client from notifications on specified event.
@@ -243,10 +250,13 @@ int np_get_data_provider_subscriptions(np_ctx_t *np_ctx, const rp_session_t *rp_
  * @param[in] subscription Subscription context acquired by ::np_get_module_change_subscriptions call.
  * @param[in] type of event to be sent to subscription
  * @param[in] commit_id ID of the commit to be used for starting a new notification session from client library.
+ * @param[in] changes Changes (sr_change_t *) selected by the subscription to be delivered within the notification,
+ * NULL if the subscriber retrieves the changes on its own.
  *
  * @return Error code (SR_ERR_OK on success).
  */
-int np_subscription_notify(np_ctx_t *np_ctx, np_subscription_t *subscription, sr_notif_event_t event, uint32_t commit_id);
+int np_subscription_notify(np_ctx_t *np_ctx, np_subscription_t *subscription, sr_notif_event_t event, uint32_t commit_id,
+        sr_list_t *changes);
 
 /**
  * @brief Request operational data from a data provider subscription.
@@ -260,6 +270,20 @@ int np_subscription_notify(np_ctx_t *np_ctx, np_subscription_t *subscription, sr
  */
 int np_data_provider_request(np_ctx_t *np_ctx, np_subscription_t *subscription, rp_session_t *session, const char *xpath);
 
+/**
+ * @brief Request operational data of multiple subtrees from a data provider subscription in one request.
+ *
+ * @param[in] np_ctx Notification Processor context acquired by ::np_init call.
+ * @param[in] subscription Subscription context acquired by ::np_get_data_provider_subscriptions call.
+ * @param[in] session Request Processor session that is requesting the data.
+ * @param[in] xpaths Array of XPaths identifying requested operational data subtrees.
+ * @param[in] xpath_cnt Number of XPaths in the array (at least 1).
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+int np_data_provider_request_batch(np_ctx_t *np_ctx, np_subscription_t *subscription, rp_session_t *session,
+        const char **xpaths, size_t xpath_cnt);
+
 /**
  * @brief Notify NP that all notifications has been sent to the given subscribers.
  *
@@ -286,8 +310,14 @@ int np_commit_notifications_complete(np_ctx_t *np_ctx, uint32_t commit_id, bool
 /**
  * @brief Track a response to a notification (notification acknowledgment).
  *
+ * Verify notifications are sent to all verifiers with the same priority at once, verifiers with lower
+ * priority are notified after all verifiers with higher priority have answered. If a verifier refuses the changes,
+ * the verify phase finishes immediately and the verifiers that have not been notified yet are skipped.
+ *
  * @param[in] np_ctx Notification Processor context acquired by ::np_init call.
  * @param[in] commit_id Commit identifier.
+ * @param[in] dst_address Destination address of the subscription that sent the acknowledgment.
+ * @param[in] dst_id Destination ID of the subscription that sent the acknowledgment.
  * @param[in] subs_xpath XPath where the subscription is subscribed to.
  * @param[in] event Event that is currently being processed.
  * @param[in] result Result of the processing by the subscriber.
@@ -297,8 +327,21 @@ int np_commit_notifications_complete(np_ctx_t *np_ctx, uint32_t commit_id, bool
  *
  * @return Error code (SR_ERR_OK on success).
  */
-int np_commit_notification_ack(np_ctx_t *np_ctx, uint32_t commit_id, char *subs_xpath, sr_notif_event_t event,
-        int result, bool do_not_send_abort, const char *err_msg, const char *err_xpath);
+int np_commit_notification_ack(np_ctx_t *np_ctx, uint32_t commit_id, const char *dst_address, uint32_t dst_id,
+        char *subs_xpath, sr_notif_event_t event, int result, bool do_not_send_abort, const char *err_msg,
+        const char *err_xpath);
+
+/**
+ * @brief Returns a copy of the latency statistics of commit verifiers (time between sending
+ * a verify notification and receiving its acknowledgment), identified by the subscribed xpath or module name.
+ *
+ * @param[in] np_ctx Notification Processor context acquired by ::np_init call.
+ * @param[out] stats Array of statistics, to be freed by ::rp_dp_latency_free_stats.
+ * @param[out] stats_cnt Number of the array items.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+int np_get_verifier_stats(np_ctx_t *np_ctx, rp_dp_latency_stats_t **stats, size_t *stats_cnt);
 
 /**
  * @brief Cleans up a subscription context (including all its content).
@@ -324,33 +367,68 @@ void np_subscriptions_list_cleanup(sr_list_t *subscriptions_list);
 /**
  * @brief Stores an event notification in the notification datastore.
  *
+ * The notification is appended into the segment of its module covering the generation time,
+ * the data are flushed to the disk in batches (see ::SR_NOTIF_STORE_SYNC_BATCH). The caller is expected
+ * to check the permissions of the requesting user.
+ *
  * @param[in] np_ctx Notification Processor context acquired by ::np_init call.
- * @param[in] user_cred Credentials of the user requesting storing of the notification.
  * @param[in] xpath XPath of the notification to be stored.
  * @param[in] generated_time Time when notification has been generated.
  * @param[in] data_tree Pointer to the data tree of the notification.
  *
  * @return Error code (SR_ERR_OK on success).
  */
-int np_store_event_notification(np_ctx_t *np_ctx, const ac_ucred_t *user_cred, const char *xpath,
-        const time_t generated_time, struct lyd_node *data_tree);
+int np_store_event_notification(np_ctx_t *np_ctx, const char *xpath, const time_t generated_time,
+        struct lyd_node *data_tree);
+
+/**
+ * @brief Stores multiple event notifications in the notification datastore with a single store append
+ * (see ::np_store_event_notification).
+ *
+ * @param[in] np_ctx Notification Processor context acquired by ::np_init call.
+ * @param[in] xpaths Array of XPaths of the notifications to be stored.
+ * @param[in] generated_times Array of times when the notifications have been generated.
+ * @param[in] data_trees Array of pointers to the data trees of the notifications.
+ * @param[in] notif_cnt Number of the notifications.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+int np_store_event_notifications(np_ctx_t *np_ctx, const char **xpaths, const time_t *generated_times,
+        struct lyd_node **data_trees, size_t notif_cnt);
+
+/**
+ * @brief Callback called for each event notification retrieved from the notification datastore.
+ *
+ * @param[in] notification Notification with data in the requested API variant, released once the callback returns.
+ * @param[in] private_ctx Private context passed to ::np_get_event_notifications.
+ *
+ * @return Error code (SR_ERR_OK on success), any other value stops the retrieval.
+ */
+typedef int (*np_ev_notification_cb)(np_ev_notification_t *notification, void *private_ctx);
 
 /**
  * @brief Retrieves event notifications from the notification datastore.
  *
+ * The notifications are decoded one at a time in the order they have been stored and passed
+ * to the callback, so that the memory needed does not depend on the number of replayed notifications.
+ * With a cursor and a limit the retrieval can be split into several calls.
+ *
  * @param[in] np_ctx Notification Processor context acquired by ::np_init call.
  * @param[in] rp_session Request Processor session context.
- * @param[in] sr_mem Sysrepo memory context.
  * @param[in] xpath XPath of the notification to be retrieved.
  * @param[in] start_time Start time of the time window.
- * @param[in] stop_time Stop time of the time window.
- * @param[in] Requested API variant (values/trees) of the data to be retrieved.
- * @param[out] notifications List with all notifications matching requested parameters.
+ * @param[in] stop_time Stop time of the time window (0 for the current time).
+ * @param[in] api_variant Requested API variant (values/trees) of the data to be retrieved.
+ * @param[in,out] cursor Position where the previous call has stopped (zeroed for the first call), can be NULL.
+ * @param[in] max_cnt Maximum number of notifications retrieved by this call, 0 for unlimited.
+ * @param[in] notif_cb Callback called for each retrieved notification.
+ * @param[in] private_ctx Private context passed to the callback.
  *
  * @return Error code (SR_ERR_OK on success).
  */
 int np_get_event_notifications(np_ctx_t *np_ctx, const rp_session_t *rp_session, const char *xpath,
-        const time_t start_time, const time_t stop_time, const sr_api_variant_t api_variant, sr_list_t **notifications);
+        const time_t start_time, const time_t stop_time, const sr_api_variant_t api_variant,
+        np_notif_store_cursor_t *cursor, size_t max_cnt, np_ev_notification_cb notif_cb, void *private_ctx);
 
 /**
  * @brief Cleans up an event notification structure.
@@ -360,14 +438,26 @@ int np_get_event_notifications(np_ctx_t *np_ctx, const rp_session_t *rp_session,
 void np_event_notification_cleanup(np_ev_notification_t *notification);
 
 /**
- * @brief Cleans up notification store - old notification data files.
+ * @brief Cleans up notification store - flushes pending notifications and enforces the retention policies.
+ *
+ * In daemon mode this is done periodically by the background compactor thread of the notification store.
+ *
+ * @param[in] np_ctx Notification Processor context acquired by ::np_init call.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+int np_notification_store_cleanup(np_ctx_t *np_ctx);
+
+/**
+ * @brief Computes the size of the notification store - number and total size of notification data files.
  *
  * @param[in] np_ctx Notification Processor context acquired by ::np_init call.
- * @param[in] reschedule TRUE if cleanup should be rescheduled after some timeout again.
+ * @param[out] file_cnt Number of notification data files.
+ * @param[out] size Total size of notification data files (in bytes).
  *
  * @return Error code (SR_ERR_OK on success).
  */
-int np_notification_store_cleanup(np_ctx_t *np_ctx, bool reschedule);
+int np_get_notif_store_size(np_ctx_t *np_ctx, uint32_t *file_cnt, uint64_t *size);
 
 /**@} np */
 
@@ -0,0 +1,1466 @@
+/**
+ * @file np_notif_store.c
+ * @brief Append-only log of event notifications with a time/xpath index.
+ *
+ * @copyright
+ * Copyright 2016 Cisco Systems, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <inttypes.h>
+#include <pthread.h>
+#include <sys/stat.h>
+
+#include "np_notif_store.h"
+
+#define NP_NOTIF_STORE_LOG_SUFFIX    ".log"        /**< Suffix of the segment log files. */
+#define NP_NOTIF_STORE_IDX_SUFFIX    ".idx"        /**< Suffix of the segment index files. */
+#define NP_NOTIF_STORE_TMP_SUFFIX    ".tmp"        /**< Suffix of the files being written by a segment compaction. */
+#define NP_NOTIF_STORE_RECORD_MAGIC  0x53524e31    /**< Magic number starting each log record ("SRN1"). */
+#define NP_NOTIF_STORE_READ_CHUNK    256           /**< Number of index entries read at once. */
+#define NP_NOTIF_STORE_COPY_CHUNK    65536         /**< Size of the buffer used to copy records by a segment compaction. */
+
+/**
+ * @brief Length of the segment time window in seconds.
+ */
+#define NP_NOTIF_STORE_WINDOW (SR_NOTIF_TIME_WINDOW * 60)
+
+/**
+ * @brief Header of a record in the segment log, followed by the NULL-terminated xpath and data.
+ */
+typedef struct np_notif_store_hdr_s {
+    uint32_t magic;             /**< NP_NOTIF_STORE_RECORD_MAGIC. */
+    uint32_t data_type;         /**< Format of the data (np_notif_store_data_type_t). */
+    int64_t generated_time;     /**< Time when the notification has been generated. */
+    int64_t logged_time;        /**< Time when the notification has been stored. */
+    uint32_t xpath_len;         /**< Length of the xpath including the terminating NULL byte. */
+    uint32_t data_len;          /**< Length of the data including the terminating NULL byte. */
+} np_notif_store_hdr_t;
+
+/**
+ * @brief Entry of the segment index, one per log record.
+ */
+typedef struct np_notif_store_idx_s {
+    int64_t generated_time;     /**< Time when the notification has been generated. */
+    uint64_t offset;            /**< Offset of the record in the log file. */
+    uint32_t length;            /**< Length of the record (including the header). */
+    uint32_t xpath_hash;        /**< Hash of the notification xpath. */
+    uint64_t sequence;          /**< Sequence number of the record within the segment, kept by compactions. */
+} np_notif_store_idx_t;
+
+/**
+ * @brief Segment opened for appending.
+ */
+typedef struct np_notif_store_segment_s {
+    char *module_name;          /**< Name of the module the segment belongs to. */
+    int64_t window_start;       /**< Start of the time window covered by the segment. */
+    char *log_path;             /**< Path to the log file. */
+    char *idx_path;             /**< Path to the index file. */
+    int log_fd;                 /**< Descriptor of the log file. */
+    int idx_fd;                 /**< Descriptor of the index file. */
+    size_t pending;             /**< Number of records not flushed to the disk yet. */
+} np_notif_store_segment_t;
+
+/**
+ * @brief Size information about a segment stored on the disk.
+ */
+typedef struct np_notif_store_segment_info_s {
+    int64_t window_start;       /**< Start of the time window covered by the segment. */
+    uint64_t size;              /**< Total size of the log and index files. */
+    uint64_t count;             /**< Number of records in the segment. */
+    time_t mtime;               /**< Time of the last modification of the segment. */
+} np_notif_store_segment_info_t;
+
+/**
+ * @brief Notification store context.
+ */
+struct np_notif_store_s {
+    char *store_dir;            /**< Directory with the notification store. */
+    char *data_search_dir;      /**< Directory with the data files. */
+    sr_list_t *segments;        /**< Segments opened for appending, at most one per module (np_notif_store_segment_t *). */
+    size_t pending;             /**< Number of records not flushed to the disk yet (in all segments). */
+    time_t last_sync;           /**< Time (CLOCK_MONOTONIC) of the last flush. */
+    size_t appended;            /**< Number of bytes appended since the compactor has been woken up last time. */
+    pthread_mutex_t mutex;      /**< Mutex guarding the opened segments. */
+
+    np_notif_store_retention_t retention;       /**< Default retention policy. */
+    np_notif_store_retention_cb retention_cb;   /**< Callback adjusting the retention policy of a module. */
+    void *retention_ctx;                        /**< Private context of the retention callback. */
+    pthread_mutex_t retention_mutex;            /**< Mutex serializing retention passes and guarding the policy. */
+
+    pthread_t compactor_thread;                 /**< Background thread enforcing the retention policies. */
+    bool compactor_running;                     /**< TRUE if the compactor thread has been started. */
+    bool compactor_stop;                        /**< TRUE if the compactor thread has been requested to stop. */
+    bool compactor_wakeup;                      /**< TRUE if the compactor should run before its interval expires. */
+    pthread_mutex_t compactor_mutex;            /**< Mutex guarding the compactor flags. */
+    pthread_cond_t compactor_cond;              /**< Condition signalling a change of the compactor flags. */
+};
+
+/**
+ * @brief Callback called for each file of the store.
+ */
+typedef int (*np_notif_store_file_cb)(np_notif_store_t *store, const char *module_name, const char *filename,
+        const struct stat *sb, void *private_ctx);
+
+/**
+ * @brief Returns start of the time window the time belongs to.
+ */
+static int64_t
+np_notif_store_window_start(time_t time)
+{
+    int64_t t = time;
+    int64_t rem = t % NP_NOTIF_STORE_WINDOW;
+
+    return (rem < 0) ? (t - rem - NP_NOTIF_STORE_WINDOW) : (t - rem);
+}
+
+/**
+ * @brief Returns current time in seconds (CLOCK_MONOTONIC).
+ */
+static time_t
+np_notif_store_monotonic_now()
+{
+    struct timespec ts = { 0, };
+
+    sr_clock_get_time(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec;
+}
+
+/**
+ * @brief Creates the directory if it does not exist already.
+ */
+static int
+np_notif_store_mkdir(const char *dirname)
+{
+    mode_t old_umask = 0;
+    int ret = 0;
+
+    if (-1 == access(dirname, F_OK)) {
+        old_umask = umask(0);
+        ret = mkdir(dirname, S_IRWXU | S_IRWXG | S_IRWXO);
+        umask(old_umask);
+        if (-1 == ret && EEXIST != errno) {
+            SR_LOG_ERR("Unable to create the directory '%s': %s", dirname, sr_strerror_safe(errno));
+            return SR_ERR_INTERNAL;
+        }
+    }
+
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Writes the whole buffer into the file.
+ */
+static int
+np_notif_store_write(int fd, const void *buff, size_t len)
+{
+    const char *pos = buff;
+    ssize_t ret = 0;
+
+    while (len > 0) {
+        ret = write(fd, pos, len);
+        if (-1 == ret) {
+            if (EINTR == errno) {
+                continue;
+            }
+            SR_LOG_ERR("Unable to write into the notification store: %s", sr_strerror_safe(errno));
+            return SR_ERR_IO;
+        }
+        pos += ret;
+        len -= ret;
+    }
+
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Reads the whole buffer from the file at given offset.
+ *
+ * @return Number of bytes read (less than requested only at the end of the file), -1 on error.
+ */
+static ssize_t
+np_notif_store_pread(int fd, void *buff, size_t len, off_t offset)
+{
+    char *pos = buff;
+    size_t total = 0;
+    ssize_t ret = 0;
+
+    while (total < len) {
+        ret = pread(fd, pos + total, len - total, offset + total);
+        if (-1 == ret) {
+            if (EINTR == errno) {
+                continue;
+            }
+            return -1;
+        }
+        if (0 == ret) {
+            break;
+        }
+        total += ret;
+    }
+
+    return total;
+}
+
+/**
+ * @brief Opens (and creates if needed) a segment file for appending.
+ */
+static int
+np_notif_store_open_file(np_notif_store_t *store, const char *filename, const char *module_name, int *fd_p)
+{
+    mode_t old_umask = 0;
+    bool created = false;
+    int fd = -1, rc = SR_ERR_OK;
+
+    created = (-1 == access(filename, F_OK));
+
+    old_umask = umask(0);
+    fd = open(filename, O_RDWR | O_APPEND | O_CREAT, S_IRUSR | S_IWUSR);
+    umask(old_umask);
+    if (-1 == fd) {
+        rc = (EACCES == errno) ? SR_ERR_UNAUTHORIZED : SR_ERR_INTERNAL;
+        SR_LOG_ERR("Unable to open the notification store file '%s': %s", filename, sr_strerror_safe(errno));
+        return rc;
+    }
+
+    if (created) {
+        /* apply the permissions of the module */
+        rc = sr_set_data_file_permissions(filename, false, store->data_search_dir, module_name, false);
+        if (SR_ERR_OK != rc) {
+            SR_LOG_WRN("Error by applying correct data file permissions on file '%s'.", filename);
+        }
+    }
+
+    *fd_p = fd;
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Flushes pending records of the segment to the disk.
+ */
+static int
+np_notif_store_segment_sync(np_notif_store_segment_t *segment)
+{
+    int rc = SR_ERR_OK;
+
+    if (segment->pending > 0) {
+        if (-1 == fdatasync(segment->log_fd) || -1 == fdatasync(segment->idx_fd)) {
+            SR_LOG_ERR("Notification store synchronization failed: %s", sr_strerror_safe(errno));
+            rc = SR_ERR_IO;
+        }
+        segment->pending = 0;
+    }
+
+    return rc;
+}
+
+/**
+ * @brief Flushes pending records and frees the segment.
+ */
+static void
+np_notif_store_segment_close(np_notif_store_segment_t *segment)
+{
+    if (NULL != segment) {
+        np_notif_store_segment_sync(segment);
+        if (-1 != segment->log_fd) {
+            close(segment->log_fd);
+        }
+        if (-1 != segment->idx_fd) {
+            close(segment->idx_fd);
+        }
+        free(segment->module_name);
+        free(segment->log_path);
+        free(segment->idx_path);
+        free(segment);
+    }
+}
+
+/**
+ * @brief Flushes pending records of all opened segments. Store mutex is expected to be held.
+ */
+static int
+np_notif_store_sync_locked(np_notif_store_t *store)
+{
+    int rc = SR_ERR_OK, tmp_rc = SR_ERR_OK;
+
+    for (size_t i = 0; i < store->segments->count; i++) {
+        tmp_rc = np_notif_store_segment_sync(store->segments->data[i]);
+        if (SR_ERR_OK != tmp_rc) {
+            rc = tmp_rc;
+        }
+    }
+    store->pending = 0;
+    store->last_sync = np_notif_store_monotonic_now();
+
+    return rc;
+}
+
+/**
+ * @brief Closes the opened segment of the module if it covers given time window (any window if negative).
+ * Store mutex is expected to be held.
+ */
+static void
+np_notif_store_close_segment_locked(np_notif_store_t *store, const char *module_name, int64_t window_start)
+{
+    np_notif_store_segment_t *segment = NULL;
+
+    for (size_t i = 0; i < store->segments->count; i++) {
+        segment = store->segments->data[i];
+        if (0 == strcmp(segment->module_name, module_name)) {
+            if (window_start < 0 || segment->window_start == window_start) {
+                store->pending -= (store->pending >= segment->pending) ? segment->pending : store->pending;
+                sr_list_rm_at(store->segments, i);
+                np_notif_store_segment_close(segment);
+            }
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Opens a new segment of the module.
+ */
+static int
+np_notif_store_segment_open(np_notif_store_t *store, const char *module_name, int64_t window_start,
+        np_notif_store_segment_t **segment_p)
+{
+    char path[PATH_MAX] = { 0, };
+    np_notif_store_segment_t *segment = NULL;
+    int rc = SR_ERR_OK;
+
+    /* create the directories (if they do not exist already) */
+    rc = np_notif_store_mkdir(store->store_dir);
+    if (SR_ERR_OK == rc) {
+        snprintf(path, PATH_MAX, "%s/%s", store->store_dir, module_name);
+        rc = np_notif_store_mkdir(path);
+    }
+    if (SR_ERR_OK != rc) {
+        return rc;
+    }
+
+    segment = calloc(1, sizeof(*segment));
+    CHECK_NULL_NOMEM_RETURN(segment);
+    segment->log_fd = segment->idx_fd = -1;
+    segment->window_start = window_start;
+
+    segment->module_name = strdup(module_name);
+    CHECK_NULL_NOMEM_GOTO(segment->module_name, rc, cleanup);
+
+    /* the names are padded so that alphabetical order matches the time order */
+    snprintf(path, PATH_MAX, "%s/%s/%012"PRId64 NP_NOTIF_STORE_LOG_SUFFIX, store->store_dir, module_name, window_start);
+    segment->log_path = strdup(path);
+    CHECK_NULL_NOMEM_GOTO(segment->log_path, rc, cleanup);
+    snprintf(path, PATH_MAX, "%s/%s/%012"PRId64 NP_NOTIF_STORE_IDX_SUFFIX, store->store_dir, module_name, window_start);
+    segment->idx_path = strdup(path);
+    CHECK_NULL_NOMEM_GOTO(segment->idx_path, rc, cleanup);
+
+    rc = np_notif_store_open_file(store, segment->log_path, module_name, &segment->log_fd);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to open the segment log file.");
+    rc = np_notif_store_open_file(store, segment->idx_path, module_name, &segment->idx_fd);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to open the segment index file.");
+
+    SR_LOG_DBG("Notification store segment '%s' opened.", segment->log_path);
+
+    *segment_p = segment;
+    return SR_ERR_OK;
+
+cleanup:
+    np_notif_store_segment_close(segment);
+    return rc;
+}
+
+/**
+ * @brief Returns the segment for appending notifications of the module generated in given time,
+ * closes the previously opened segment of the module if it covers a different time window.
+ * Store mutex is expected to be held.
+ */
+static int
+np_notif_store_get_segment_locked(np_notif_store_t *store, const char *module_name, time_t generated_time,
+        np_notif_store_segment_t **segment_p)
+{
+    np_notif_store_segment_t *segment = NULL;
+    int64_t window_start = np_notif_store_window_start(generated_time);
+    int rc = SR_ERR_OK;
+
+    for (size_t i = 0; i < store->segments->count; i++) {
+        segment = store->segments->data[i];
+        if (0 == strcmp(segment->module_name, module_name) && segment->window_start == window_start) {
+            *segment_p = segment;
+            return SR_ERR_OK;
+        }
+    }
+
+    /* rotate the segment */
+    np_notif_store_close_segment_locked(store, module_name, -1);
+
+    rc = np_notif_store_segment_open(store, module_name, window_start, &segment);
+    CHECK_RC_LOG_RETURN(rc, "Unable to open notification store segment for module '%s'.", module_name);
+
+    rc = sr_list_add(store->segments, segment);
+    if (SR_ERR_OK != rc) {
+        np_notif_store_segment_close(segment);
+        return rc;
+    }
+
+    *segment_p = segment;
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Appends the records into the segment (with a single write into the log and the index).
+ * Offsets of the index entries are relative to the beginning of the records and are moved to the end of the log,
+ * the records are numbered after the last record of the segment.
+ * Caller is expected to hold the inter-process lock of the log file.
+ */
+static int
+np_notif_store_segment_append(np_notif_store_segment_t *segment, const char *records, size_t records_len,
+        np_notif_store_idx_t *idx_entries, size_t idx_cnt)
+{
+    struct stat log_sb = { 0, }, idx_sb = { 0, };
+    np_notif_store_idx_t last = { 0, };
+    uint64_t sequence = 0;
+    off_t idx_size = 0;
+    int rc = SR_ERR_OK;
+
+    if (-1 == fstat(segment->log_fd, &log_sb) || -1 == fstat(segment->idx_fd, &idx_sb)) {
+        SR_LOG_ERR("Unable to stat the notification store segment '%s': %s", segment->log_path, sr_strerror_safe(errno));
+        return SR_ERR_IO;
+    }
+
+    /* drop a partially written index entry (left by an interrupted append) */
+    idx_size = idx_sb.st_size - (idx_sb.st_size % sizeof(*idx_entries));
+    if (idx_size != idx_sb.st_size && -1 == ftruncate(segment->idx_fd, idx_size)) {
+        SR_LOG_ERR("Unable to truncate the notification store index '%s': %s", segment->idx_path, sr_strerror_safe(errno));
+        return SR_ERR_IO;
+    }
+    if (idx_size > 0) {
+        if (np_notif_store_pread(segment->idx_fd, &last, sizeof(last), idx_size - sizeof(last)) != sizeof(last)) {
+            SR_LOG_ERR("Unable to read the notification store index '%s'.", segment->idx_path);
+            return SR_ERR_IO;
+        }
+        sequence = last.sequence + 1;
+    }
+
+    for (size_t i = 0; i < idx_cnt; i++) {
+        idx_entries[i].offset += log_sb.st_size;
+        idx_entries[i].sequence = sequence + i;
+    }
+
+    /* the records first, so that an index entry always points to a complete record */
+    rc = np_notif_store_write(segment->log_fd, records, records_len);
+    if (SR_ERR_OK == rc) {
+        rc = np_notif_store_write(segment->idx_fd, idx_entries, idx_cnt * sizeof(*idx_entries));
+        if (SR_ERR_OK != rc && -1 == ftruncate(segment->idx_fd, idx_size)) {
+            SR_LOG_WRN("Unable to roll back the notification store index '%s'.", segment->idx_path);
+        }
+    }
+    if (SR_ERR_OK != rc && -1 == ftruncate(segment->log_fd, log_sb.st_size)) {
+        SR_LOG_WRN("Unable to roll back the notification store log '%s'.", segment->log_path);
+    }
+
+    return rc;
+}
+
+int
+np_notif_store_init(const char *store_dir, const char *data_search_dir, np_notif_store_t **store_p)
+{
+    np_notif_store_t *store = NULL;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG3(store_dir, data_search_dir, store_p);
+
+    store = calloc(1, sizeof(*store));
+    CHECK_NULL_NOMEM_RETURN(store);
+
+    store->store_dir = strdup(store_dir);
+    CHECK_NULL_NOMEM_GOTO(store->store_dir, rc, cleanup);
+    store->data_search_dir = strdup(data_search_dir);
+    CHECK_NULL_NOMEM_GOTO(store->data_search_dir, rc, cleanup);
+
+    rc = sr_list_init(&store->segments);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to initialize the list of notification store segments.");
+
+    store->last_sync = np_notif_store_monotonic_now();
+    pthread_mutex_init(&store->mutex, NULL);
+    pthread_mutex_init(&store->retention_mutex, NULL);
+    pthread_mutex_init(&store->compactor_mutex, NULL);
+    pthread_cond_init(&store->compactor_cond, NULL);
+
+    *store_p = store;
+    return SR_ERR_OK;
+
+cleanup:
+    free(store->store_dir);
+    free(store->data_search_dir);
+    free(store);
+    return rc;
+}
+
+void
+np_notif_store_cleanup(np_notif_store_t *store)
+{
+    if (NULL != store) {
+        if (store->compactor_running) {
+            /* stop the compactor thread */
+            pthread_mutex_lock(&store->compactor_mutex);
+            store->compactor_stop = true;
+            pthread_cond_signal(&store->compactor_cond);
+            pthread_mutex_unlock(&store->compactor_mutex);
+            pthread_join(store->compactor_thread, NULL);
+        }
+        for (size_t i = 0; i < store->segments->count; i++) {
+            np_notif_store_segment_close(store->segments->data[i]);
+        }
+        sr_list_cleanup(store->segments);
+        pthread_mutex_destroy(&store->mutex);
+        pthread_mutex_destroy(&store->retention_mutex);
+        pthread_mutex_destroy(&store->compactor_mutex);
+        pthread_cond_destroy(&store->compactor_cond);
+        free(store->store_dir);
+        free(store->data_search_dir);
+        free(store);
+    }
+}
+
+int
+np_notif_store_append(np_notif_store_t *store, const char *module_name, const char *xpath, time_t generated_time,
+        np_notif_store_data_type_t data_type, const char *data)
+{
+    np_notif_store_entry_t entry = { .module_name = module_name, .xpath = xpath, .generated_time = generated_time,
+            .data_type = data_type, .data = data };
+
+    CHECK_NULL_ARG4(store, module_name, xpath, data);
+
+    return np_notif_store_append_batch(store, &entry, 1);
+}
+
+int
+np_notif_store_append_batch(np_notif_store_t *store, const np_notif_store_entry_t *entries, size_t entry_cnt)
+{
+    np_notif_store_segment_t *segment = NULL;
+    np_notif_store_hdr_t hdr = { 0, };
+    np_notif_store_idx_t *idx_entries = NULL;
+    struct stat sb = { 0, };
+    char *records = NULL;
+    size_t records_len = 0, pos = 0, run_end = 0, run_len = 0;
+    uint64_t run_offset = 0;
+    time_t logged_time = time(NULL);
+    bool reopened = false;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG2(store, entries);
+
+    for (size_t i = 0; i < entry_cnt; i++) {
+        CHECK_NULL_ARG3(entries[i].module_name, entries[i].xpath, entries[i].data);
+        records_len += sizeof(hdr) + strlen(entries[i].xpath) + 1 + strlen(entries[i].data) + 1;
+    }
+    if (0 == entry_cnt) {
+        return SR_ERR_OK;
+    }
+
+    /* serialize the records */
+    records = malloc(records_len);
+    CHECK_NULL_NOMEM_RETURN(records);
+    idx_entries = calloc(entry_cnt, sizeof(*idx_entries));
+    CHECK_NULL_NOMEM_GOTO(idx_entries, rc, cleanup);
+
+    for (size_t i = 0; i < entry_cnt; i++) {
+        hdr.magic = NP_NOTIF_STORE_RECORD_MAGIC;
+        hdr.data_type = entries[i].data_type;
+        hdr.generated_time = entries[i].generated_time;
+        hdr.logged_time = logged_time;
+        hdr.xpath_len = strlen(entries[i].xpath) + 1;
+        hdr.data_len = strlen(entries[i].data) + 1;
+
+        if (sizeof(hdr) + (uint64_t) hdr.xpath_len + hdr.data_len > UINT32_MAX) {
+            SR_LOG_ERR("Notification '%s' is too large to be stored.", entries[i].xpath);
+            rc = SR_ERR_INVAL_ARG;
+            goto cleanup;
+        }
+
+        idx_entries[i].generated_time = entries[i].generated_time;
+        idx_entries[i].offset = pos;
+        idx_entries[i].length = sizeof(hdr) + hdr.xpath_len + hdr.data_len;
+        idx_entries[i].xpath_hash = sr_str_hash(entries[i].xpath);
+
+        memcpy(records + pos, &hdr, sizeof(hdr));
+        memcpy(records + pos + sizeof(hdr), entries[i].xpath, hdr.xpath_len);
+        memcpy(records + pos + sizeof(hdr) + hdr.xpath_len, entries[i].data, hdr.data_len);
+        pos += idx_entries[i].length;
+    }
+
+    SR_MUTEX_LOCK(&store->mutex, "notif_store_mutex");
+
+    for (size_t i = 0; i < entry_cnt; i = run_end) {
+        /* consecutive records of the same segment are appended at once */
+        run_end = i + 1;
+        while (run_end < entry_cnt && 0 == strcmp(entries[run_end].module_name, entries[i].module_name) &&
+                np_notif_store_window_start(entries[run_end].generated_time) ==
+                np_notif_store_window_start(entries[i].generated_time)) {
+            run_end++;
+        }
+        run_offset = idx_entries[i].offset;
+        run_len = ((run_end < entry_cnt) ? idx_entries[run_end].offset : records_len) - run_offset;
+        for (size_t j = i; j < run_end; j++) {
+            idx_entries[j].offset -= run_offset;
+        }
+        reopened = false;
+
+open_segment:
+        rc = np_notif_store_get_segment_locked(store, entries[i].module_name, entries[i].generated_time, &segment);
+        if (SR_ERR_OK != rc) {
+            goto unlock;
+        }
+
+        /* other processes may append into the same segment */
+        rc = sr_lock_fd(segment->log_fd, true, true);
+        CHECK_RC_LOG_GOTO(rc, unlock, "Unable to lock the notification store segment '%s'.", segment->log_path);
+        if (!reopened && -1 != fstat(segment->log_fd, &sb) && 0 == sb.st_nlink) {
+            /* the segment has been removed or compacted by another process */
+            sr_unlock_fd(segment->log_fd);
+            np_notif_store_close_segment_locked(store, entries[i].module_name, -1);
+            reopened = true;
+            goto open_segment;
+        }
+        rc = np_notif_store_segment_append(segment, records + run_offset, run_len, idx_entries + i, run_end - i);
+        sr_unlock_fd(segment->log_fd);
+        if (SR_ERR_OK != rc) {
+            goto unlock;
+        }
+
+        segment->pending += run_end - i;
+        store->pending += run_end - i;
+        store->appended += run_len;
+    }
+
+    /* wake up the compactor early if a lot of data has been appended */
+    if (store->appended >= NP_NOTIF_STORE_COMPACT_TRIGGER) {
+        store->appended = 0;
+        pthread_mutex_lock(&store->compactor_mutex);
+        store->compactor_wakeup = true;
+        pthread_cond_signal(&store->compactor_cond);
+        pthread_mutex_unlock(&store->compactor_mutex);
+    }
+
+    /* flush in batches */
+    if (store->pending >= SR_NOTIF_STORE_SYNC_BATCH ||
+            np_notif_store_monotonic_now() - store->last_sync >= NP_NOTIF_STORE_SYNC_INTERVAL) {
+        rc = np_notif_store_sync_locked(store);
+    }
+
+unlock:
+    SR_MUTEX_UNLOCK(&store->mutex);
+cleanup:
+    free(idx_entries);
+    free(records);
+    return rc;
+}
+
+int
+np_notif_store_sync(np_notif_store_t *store)
+{
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG(store);
+
+    SR_MUTEX_LOCK(&store->mutex, "notif_store_mutex");
+    rc = np_notif_store_sync_locked(store);
+    SR_MUTEX_UNLOCK(&store->mutex);
+
+    return rc;
+}
+
+/**
+ * @brief Filters index files of the segments when scanning a module directory.
+ */
+static int
+np_notif_store_idx_filter(const struct dirent *entry)
+{
+    size_t len = strlen(entry->d_name);
+    size_t suffix_len = strlen(NP_NOTIF_STORE_IDX_SUFFIX);
+
+    return (len > suffix_len) && (0 == strcmp(entry->d_name + len - suffix_len, NP_NOTIF_STORE_IDX_SUFFIX));
+}
+
+/**
+ * @brief Reads the matching records of one segment, starting with the record with given sequence number
+ * (or the oldest retained record, if that one has been dropped already).
+ */
+static int
+np_notif_store_read_segment(const char *idx_path, const char *log_path, const char *xpath, time_t time_from,
+        time_t time_to, uint64_t *sequence_p, size_t *remaining_p, np_notif_store_record_cb record_cb, void *private_ctx)
+{
+    np_notif_store_idx_t entries[NP_NOTIF_STORE_READ_CHUNK];
+    np_notif_store_record_t record = { 0, };
+    np_notif_store_hdr_t *hdr = NULL;
+    uint32_t xpath_hash = (NULL != xpath) ? sr_str_hash(xpath) : 0;
+    char *buff = NULL, *tmp = NULL;
+    size_t buff_size = 0, cnt = 0;
+    uint64_t idx_offset = 0, sequence = *sequence_p;
+    ssize_t ret = 0;
+    int idx_fd = -1, log_fd = -1;
+    int rc = SR_ERR_OK;
+
+    idx_fd = open(idx_path, O_RDONLY);
+    log_fd = open(log_path, O_RDONLY);
+    if (-1 == idx_fd || -1 == log_fd) {
+        if (ENOENT != errno) {
+            SR_LOG_WRN("Unable to open the notification store segment '%s': %s.", log_path, sr_strerror_safe(errno));
+        }
+        goto cleanup;
+    }
+
+    /* compactions drop only the oldest records, the sequence numbers of a segment stay contiguous */
+    ret = np_notif_store_pread(idx_fd, entries, sizeof(*entries), 0);
+    if ((ssize_t) sizeof(*entries) == ret && sequence > entries[0].sequence) {
+        idx_offset = (sequence - entries[0].sequence) * sizeof(*entries);
+    }
+
+    do {
+        ret = np_notif_store_pread(idx_fd, entries, sizeof(entries), idx_offset);
+        if (-1 == ret) {
+            SR_LOG_ERR("Unable to read the notification store index '%s': %s", idx_path, sr_strerror_safe(errno));
+            rc = SR_ERR_IO;
+            goto cleanup;
+        }
+        /* a partially written trailing entry is ignored */
+        cnt = ret / sizeof(*entries);
+
+        for (size_t i = 0; i < cnt; i++) {
+            idx_offset += sizeof(*entries);
+            sequence = entries[i].sequence + 1;
+            if (entries[i].generated_time < time_from || entries[i].generated_time > time_to ||
+                    (NULL != xpath && entries[i].xpath_hash != xpath_hash) || entries[i].length <= sizeof(*hdr)) {
+                continue;
+            }
+
+            if (entries[i].length > buff_size) {
+                tmp = realloc(buff, entries[i].length);
+                CHECK_NULL_NOMEM_GOTO(tmp, rc, cleanup);
+                buff = tmp;
+                buff_size = entries[i].length;
+            }
+            ret = np_notif_store_pread(log_fd, buff, entries[i].length, entries[i].offset);
+            hdr = (np_notif_store_hdr_t *) buff;
+            if (ret != entries[i].length || NP_NOTIF_STORE_RECORD_MAGIC != hdr->magic ||
+                    hdr->generated_time != entries[i].generated_time ||
+                    (uint64_t) sizeof(*hdr) + hdr->xpath_len + hdr->data_len != entries[i].length ||
+                    0 == hdr->xpath_len || 0 == hdr->data_len ||
+                    '\0' != buff[sizeof(*hdr) + hdr->xpath_len - 1] || '\0' != buff[entries[i].length - 1]) {
+                SR_LOG_WRN("Skipping a corrupted record in the notification store segment '%s'.", log_path);
+                continue;
+            }
+
+            record.xpath = buff + sizeof(*hdr);
+            if (NULL != xpath && 0 != strcmp(record.xpath, xpath)) {
+                /* hash collision */
+                continue;
+            }
+            record.generated_time = hdr->generated_time;
+            record.logged_time = hdr->logged_time;
+            record.data_type = hdr->data_type;
+            record.data = buff + sizeof(*hdr) + hdr->xpath_len;
+
+            rc = record_cb(&record, private_ctx);
+            if (SR_ERR_OK != rc) {
+                goto cleanup;
+            }
+            *remaining_p -= 1;
+            if (0 == *remaining_p) {
+                /* the requested number of records has been read */
+                goto cleanup;
+            }
+        }
+    } while (NP_NOTIF_STORE_READ_CHUNK == cnt);
+
+cleanup:
+    if (-1 != idx_fd) {
+        close(idx_fd);
+    }
+    if (-1 != log_fd) {
+        close(log_fd);
+    }
+    free(buff);
+    *sequence_p = sequence;
+    return rc;
+}
+
+int
+np_notif_store_read(np_notif_store_t *store, const char *module_name, const char *xpath, time_t time_from,
+        time_t time_to, np_notif_store_cursor_t *cursor, size_t max_records, np_notif_store_record_cb record_cb,
+        void *private_ctx)
+{
+    char dirname[PATH_MAX] = { 0, };
+    char idx_path[PATH_MAX] = { 0, };
+    char log_path[PATH_MAX] = { 0, };
+    struct dirent **entries = NULL;
+    int64_t window_start = 0;
+    uint64_t sequence = 0;
+    size_t remaining = (0 == max_records) ? SIZE_MAX : max_records;
+    char *endptr = NULL;
+    int dir_elem_cnt = 0, i = 0;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG3(store, module_name, record_cb);
+
+    if (NULL != cursor && cursor->done) {
+        return SR_ERR_OK;
+    }
+
+    snprintf(dirname, PATH_MAX, "%s/%s", store->store_dir, module_name);
+
+    /* scan index files of the segments (in time order) */
+    dir_elem_cnt = scandir(dirname, &entries, np_notif_store_idx_filter, alphasort);
+    if (dir_elem_cnt < 0) {
+        if (ENOENT != errno) {
+            SR_LOG_ERR("Error by scanning directory '%s': %s.", dirname, sr_strerror_safe(errno));
+        }
+        dir_elem_cnt = 0;
+    }
+
+    for (i = 0; i < dir_elem_cnt && remaining > 0; i++) {
+        /* select the segments by their time window */
+        window_start = strtoll(entries[i]->d_name, &endptr, 10);
+        if (0 != strcmp(endptr, NP_NOTIF_STORE_IDX_SUFFIX) ||
+                window_start + NP_NOTIF_STORE_WINDOW <= time_from || window_start > time_to) {
+            continue;
+        }
+        /* continue where the previous read has stopped */
+        sequence = 0;
+        if (NULL != cursor && cursor->valid) {
+            if (window_start < cursor->segment) {
+                continue;
+            }
+            if (window_start == cursor->segment) {
+                sequence = cursor->sequence;
+            }
+        }
+        snprintf(idx_path, PATH_MAX, "%s/%s", dirname, entries[i]->d_name);
+        snprintf(log_path, PATH_MAX, "%s/%012"PRId64 NP_NOTIF_STORE_LOG_SUFFIX, dirname, window_start);
+
+        SR_LOG_DBG("Reading notification store segment '%s'.", log_path);
+        rc = np_notif_store_read_segment(idx_path, log_path, xpath, time_from, time_to, &sequence, &remaining,
+                record_cb, private_ctx);
+        if (SR_ERR_OK != rc) {
+            break;
+        }
+        if (NULL != cursor) {
+            cursor->valid = true;
+            cursor->segment = window_start;
+            cursor->sequence = sequence;
+        }
+    }
+
+    if (SR_ERR_OK == rc && NULL != cursor && remaining > 0) {
+        /* all segments have been read */
+        cursor->done = true;
+    }
+
+    for (i = 0; i < dir_elem_cnt; i++) {
+        free(entries[i]);
+    }
+    free(entries);
+
+    return rc;
+}
+
+/**
+ * @brief Calls the callback for each file of the store (in all module directories).
+ */
+static int
+np_notif_store_for_each_file(np_notif_store_t *store, np_notif_store_file_cb file_cb, void *private_ctx)
+{
+    char dirname[PATH_MAX] = { 0, };
+    char filename[PATH_MAX] = { 0, };
+    struct dirent **modules = NULL, **files = NULL;
+    struct stat sb = { 0, };
+    int module_cnt = 0, file_cnt = 0, i = 0, j = 0;
+    int rc = SR_ERR_OK;
+
+    module_cnt = scandir(store->store_dir, &modules, NULL, alphasort);
+    if (module_cnt < 0) {
+        if (ENOENT != errno) {
+            SR_LOG_ERR("Error by scanning directory '%s': %s.", store->store_dir, sr_strerror_safe(errno));
+            return SR_ERR_INTERNAL;
+        }
+        return SR_ERR_OK;
+    }
+
+    for (i = 0; i < module_cnt; i++) {
+        if (SR_ERR_OK != rc || '.' == modules[i]->d_name[0]) {
+            continue;
+        }
+        snprintf(dirname, PATH_MAX, "%s/%s", store->store_dir, modules[i]->d_name);
+        file_cnt = scandir(dirname, &files, NULL, alphasort);
+        if (file_cnt < 0) {
+            continue;
+        }
+        for (j = 0; j < file_cnt; j++) {
+            snprintf(filename, PATH_MAX, "%s/%s", dirname, files[j]->d_name);
+            if (SR_ERR_OK == rc && -1 != stat(filename, &sb) && S_ISREG(sb.st_mode)) {
+                rc = file_cb(store, modules[i]->d_name, filename, &sb, private_ctx);
+            }
+            free(files[j]);
+        }
+        free(files);
+    }
+
+    for (i = 0; i < module_cnt; i++) {
+        free(modules[i]);
+    }
+    free(modules);
+
+    return rc;
+}
+
+/**
+ * @brief Sums up sizes of the store files.
+ */
+static int
+np_notif_store_size_file_cb(np_notif_store_t *store, const char *module_name, const char *filename,
+        const struct stat *sb, void *private_ctx)
+{
+    uint64_t *totals = (uint64_t *) private_ctx;
+
+    totals[0] += 1;
+    totals[1] += sb->st_size;
+
+    return SR_ERR_OK;
+}
+
+int
+np_notif_store_get_size(np_notif_store_t *store, uint32_t *file_cnt, uint64_t *size)
+{
+    uint64_t totals[2] = { 0, };
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG3(store, file_cnt, size);
+
+    rc = np_notif_store_for_each_file(store, np_notif_store_size_file_cb, totals);
+
+    *file_cnt = totals[0];
+    *size = totals[1];
+
+    return rc;
+}
+
+int
+np_notif_store_set_retention(np_notif_store_t *store, const np_notif_store_retention_t *retention,
+        np_notif_store_retention_cb retention_cb, void *private_ctx)
+{
+    CHECK_NULL_ARG2(store, retention);
+
+    SR_MUTEX_LOCK(&store->retention_mutex, "notif_store_retention_mutex");
+    store->retention = *retention;
+    store->retention_cb = retention_cb;
+    store->retention_ctx = private_ctx;
+    SR_MUTEX_UNLOCK(&store->retention_mutex);
+
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Composes the path to a file of the segment.
+ */
+static void
+np_notif_store_segment_path(np_notif_store_t *store, const char *module_name, int64_t window_start, const char *suffix,
+        char *path)
+{
+    snprintf(path, PATH_MAX, "%s/%s/%012"PRId64"%s", store->store_dir, module_name, window_start, suffix);
+}
+
+/**
+ * @brief Copies a part of the file into another file.
+ */
+static int
+np_notif_store_copy(int src_fd, uint64_t from, uint64_t to, int dst_fd)
+{
+    char buff[NP_NOTIF_STORE_COPY_CHUNK];
+    size_t len = 0;
+    ssize_t ret = 0;
+    int rc = SR_ERR_OK;
+
+    while (from < to) {
+        len = (to - from > sizeof(buff)) ? sizeof(buff) : (to - from);
+        ret = np_notif_store_pread(src_fd, buff, len, from);
+        if (ret <= 0) {
+            SR_LOG_ERR("Unable to read from the notification store: %s", (0 == ret) ? "unexpected end of file" :
+                    sr_strerror_safe(errno));
+            return SR_ERR_IO;
+        }
+        rc = np_notif_store_write(dst_fd, buff, ret);
+        if (SR_ERR_OK != rc) {
+            return rc;
+        }
+        from += ret;
+    }
+
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Drops the oldest records of the segment - at least @p drop_count records that together take
+ * at least @p drop_size bytes. The remaining records are rewritten into new segment files, which then
+ * atomically replace the original ones. If all records are to be dropped, the segment is removed.
+ *
+ * The bulk of the remaining records is copied without any lock, appends continue meanwhile. Only the records
+ * appended during the copy are copied with the store mutex and the inter-process lock of the segment held,
+ * right before the new files replace the original ones.
+ */
+static int
+np_notif_store_segment_trim(np_notif_store_t *store, const char *module_name, int64_t window_start,
+        uint64_t drop_size, uint64_t drop_count, uint64_t *dropped_size, uint64_t *dropped_count)
+{
+    char log_path[PATH_MAX] = { 0, }, idx_path[PATH_MAX] = { 0, };
+    char tmp_log_path[PATH_MAX] = { 0, }, tmp_idx_path[PATH_MAX] = { 0, };
+    np_notif_store_idx_t *entries = NULL, *tmp = NULL;
+    struct stat log_sb = { 0, }, idx_sb = { 0, };
+    size_t cnt = 0, new_cnt = 0, drop = 0;
+    uint64_t size = 0, base = 0, log_size = 0;
+    int log_fd = -1, idx_fd = -1, tmp_log_fd = -1, tmp_idx_fd = -1;
+    int rc = SR_ERR_OK;
+
+    *dropped_size = 0;
+    *dropped_count = 0;
+
+    np_notif_store_segment_path(store, module_name, window_start, NP_NOTIF_STORE_LOG_SUFFIX, log_path);
+    np_notif_store_segment_path(store, module_name, window_start, NP_NOTIF_STORE_IDX_SUFFIX, idx_path);
+    snprintf(tmp_log_path, PATH_MAX, "%s%s", log_path, NP_NOTIF_STORE_TMP_SUFFIX);
+    snprintf(tmp_idx_path, PATH_MAX, "%s%s", idx_path, NP_NOTIF_STORE_TMP_SUFFIX);
+
+    log_fd = open(log_path, O_RDWR);
+    if (-1 != log_fd) {
+        idx_fd = open(idx_path, O_RDONLY);
+    }
+    if (-1 == log_fd || -1 == idx_fd) {
+        if (ENOENT != errno) {
+            SR_LOG_ERR("Unable to open the notification store segment '%s': %s.", log_path, sr_strerror_safe(errno));
+            rc = SR_ERR_IO;
+        }
+        goto close;
+    }
+
+    /* the records present at this moment are not modified by the appends */
+    if (-1 == fstat(log_fd, &log_sb) || -1 == fstat(idx_fd, &idx_sb)) {
+        SR_LOG_ERR("Unable to stat the notification store segment '%s': %s", log_path, sr_strerror_safe(errno));
+        rc = SR_ERR_IO;
+        goto close;
+    }
+    log_size = log_sb.st_size;
+
+    cnt = idx_sb.st_size / sizeof(*entries);
+    if (cnt > 0) {
+        entries = malloc(cnt * sizeof(*entries));
+        CHECK_NULL_NOMEM_GOTO(entries, rc, close);
+        if (np_notif_store_pread(idx_fd, entries, cnt * sizeof(*entries), 0) != cnt * sizeof(*entries)) {
+            SR_LOG_ERR("Unable to read the notification store index '%s'.", idx_path);
+            rc = SR_ERR_IO;
+            goto close;
+        }
+    }
+
+    /* select the records to be dropped */
+    while (drop < cnt && (size < drop_size || drop < drop_count)) {
+        size += entries[drop].length + sizeof(*entries);
+        drop++;
+    }
+    if (0 == drop) {
+        goto close;
+    }
+
+    if (drop < cnt) {
+        base = entries[drop].offset;
+        if (base > log_size) {
+            SR_LOG_WRN("Notification store segment '%s' is corrupted, unable to compact it.", log_path);
+            goto close;
+        }
+
+        SR_LOG_DBG("Dropping %zu oldest record(s) from notification store segment '%s'.", drop, log_path);
+
+        /* write the remaining records into new files */
+        tmp_log_fd = open(tmp_log_path, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+        tmp_idx_fd = open(tmp_idx_path, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+        if (-1 == tmp_log_fd || -1 == tmp_idx_fd) {
+            SR_LOG_ERR("Unable to create notification store file '%s': %s", tmp_log_path, sr_strerror_safe(errno));
+            rc = SR_ERR_IO;
+            goto close;
+        }
+
+        rc = np_notif_store_copy(log_fd, base, log_size, tmp_log_fd);
+        if (SR_ERR_OK == rc) {
+            for (size_t i = drop; i < cnt; i++) {
+                entries[i].offset -= base;
+            }
+            rc = np_notif_store_write(tmp_idx_fd, entries + drop, (cnt - drop) * sizeof(*entries));
+        }
+        /* the copied records are flushed before the appends are blocked */
+        if (SR_ERR_OK == rc && (-1 == fdatasync(tmp_log_fd) || -1 == fdatasync(tmp_idx_fd))) {
+            SR_LOG_ERR("Notification store synchronization failed: %s", sr_strerror_safe(errno));
+            rc = SR_ERR_IO;
+        }
+        if (SR_ERR_OK != rc) {
+            goto close;
+        }
+
+        /* keep the ownership and permissions of the original files */
+        if (-1 == fchown(tmp_log_fd, log_sb.st_uid, log_sb.st_gid) ||
+                -1 == fchown(tmp_idx_fd, idx_sb.st_uid, idx_sb.st_gid)) {
+            SR_LOG_WRN("Unable to set the owner of the compacted notification store segment '%s'.", log_path);
+        }
+        fchmod(tmp_log_fd, log_sb.st_mode & 07777);
+        fchmod(tmp_idx_fd, idx_sb.st_mode & 07777);
+    }
+
+    SR_MUTEX_LOCK(&store->mutex, "notif_store_mutex");
+
+    /* block appends of other processes */
+    rc = sr_lock_fd(log_fd, true, true);
+    CHECK_RC_LOG_GOTO(rc, unlock, "Unable to lock the notification store segment '%s'.", log_path);
+
+    if (-1 == fstat(log_fd, &log_sb) || -1 == fstat(idx_fd, &idx_sb)) {
+        SR_LOG_ERR("Unable to stat the notification store segment '%s': %s", log_path, sr_strerror_safe(errno));
+        rc = SR_ERR_IO;
+        goto unlock;
+    }
+    if (0 == log_sb.st_nlink) {
+        /* the segment has been removed or compacted by another process meanwhile */
+        goto unlock;
+    }
+    new_cnt = idx_sb.st_size / sizeof(*entries);
+
+    if (drop == cnt) {
+        if (new_cnt > cnt) {
+            /* notifications have been appended meanwhile, the segment is processed again by the next pass */
+            goto unlock;
+        }
+        SR_LOG_DBG("Deleting notification store segment '%s'.", log_path);
+        if (-1 == unlink(idx_path) || -1 == unlink(log_path)) {
+            SR_LOG_WRN("Unable to delete notification store segment '%s': %s.", log_path, sr_strerror_safe(errno));
+        }
+        np_notif_store_close_segment_locked(store, module_name, window_start);
+        *dropped_size = log_sb.st_size + idx_sb.st_size;
+        *dropped_count = cnt;
+        goto unlock;
+    }
+
+    /* copy the records appended since the snapshot */
+    if (new_cnt > cnt) {
+        tmp = realloc(entries, new_cnt * sizeof(*entries));
+        CHECK_NULL_NOMEM_GOTO(tmp, rc, unlock);
+        entries = tmp;
+        if (np_notif_store_pread(idx_fd, entries + cnt, (new_cnt - cnt) * sizeof(*entries), cnt * sizeof(*entries)) !=
+                (new_cnt - cnt) * sizeof(*entries)) {
+            SR_LOG_ERR("Unable to read the notification store index '%s'.", idx_path);
+            rc = SR_ERR_IO;
+            goto unlock;
+        }
+        for (size_t i = cnt; i < new_cnt; i++) {
+            entries[i].offset -= base;
+        }
+        rc = np_notif_store_write(tmp_idx_fd, entries + cnt, (new_cnt - cnt) * sizeof(*entries));
+    }
+    if (SR_ERR_OK == rc && (uint64_t) log_sb.st_size > log_size) {
+        rc = np_notif_store_copy(log_fd, log_size, log_sb.st_size, tmp_log_fd);
+    }
+    if (SR_ERR_OK == rc && (-1 == fdatasync(tmp_log_fd) || -1 == fdatasync(tmp_idx_fd))) {
+        SR_LOG_ERR("Notification store synchronization failed: %s", sr_strerror_safe(errno));
+        rc = SR_ERR_IO;
+    }
+    if (SR_ERR_OK != rc) {
+        goto unlock;
+    }
+
+    /* readers detect the short moment when the index does not match the log */
+    if (-1 == rename(tmp_idx_path, idx_path) || -1 == rename(tmp_log_path, log_path)) {
+        SR_LOG_ERR("Unable to replace the notification store segment '%s': %s", log_path, sr_strerror_safe(errno));
+        rc = SR_ERR_IO;
+        goto unlock;
+    }
+
+    /* do not keep appending into the original files */
+    np_notif_store_close_segment_locked(store, module_name, window_start);
+
+    *dropped_size = size;
+    *dropped_count = drop;
+
+unlock:
+    /* closing the file releases the lock (and any other lock of this process on it, hence the mutex) */
+    close(log_fd);
+    log_fd = -1;
+    SR_MUTEX_UNLOCK(&store->mutex);
+
+close:
+    if (-1 != tmp_log_fd) {
+        close(tmp_log_fd);
+    }
+    if (-1 != tmp_idx_fd) {
+        close(tmp_idx_fd);
+    }
+    if (0 == *dropped_count && -1 != tmp_log_fd) {
+        unlink(tmp_log_path);
+        unlink(tmp_idx_path);
+    }
+    if (-1 != idx_fd) {
+        close(idx_fd);
+    }
+    if (-1 != log_fd) {
+        /* the file has not been locked by this process, but appends of other threads might have */
+        SR_MUTEX_LOCK(&store->mutex, "notif_store_mutex");
+        close(log_fd);
+        SR_MUTEX_UNLOCK(&store->mutex);
+    }
+    free(entries);
+    return rc;
+}
+
+/**
+ * @brief Fills size information about the segment identified by the name of its index file.
+ *
+ * @return TRUE if the file is an index of a segment with a log file.
+ */
+static bool
+np_notif_store_segment_info(const char *dirname, const char *idx_name, np_notif_store_segment_info_t *info)
+{
+    char path[PATH_MAX] = { 0, };
+    struct stat idx_sb = { 0, }, log_sb = { 0, };
+    char *endptr = NULL;
+
+    info->window_start = strtoll(idx_name, &endptr, 10);
+    if (endptr == idx_name || 0 != strcmp(endptr, NP_NOTIF_STORE_IDX_SUFFIX)) {
+        return false;
+    }
+
+    snprintf(path, PATH_MAX, "%s/%s", dirname, idx_name);
+    if (-1 == stat(path, &idx_sb)) {
+        return false;
+    }
+    snprintf(path, PATH_MAX, "%s/%012"PRId64 NP_NOTIF_STORE_LOG_SUFFIX, dirname, info->window_start);
+    if (-1 == stat(path, &log_sb)) {
+        return false;
+    }
+
+    info->size = idx_sb.st_size + log_sb.st_size;
+    info->count = idx_sb.st_size / sizeof(np_notif_store_idx_t);
+    info->mtime = (idx_sb.st_mtime > log_sb.st_mtime) ? idx_sb.st_mtime : log_sb.st_mtime;
+
+    return true;
+}
+
+/**
+ * @brief Returns TRUE if the file of the module directory belongs to a segment described in the array.
+ */
+static bool
+np_notif_store_is_segment_file(const char *filename, const np_notif_store_segment_info_t *segments, size_t segment_cnt)
+{
+    char *endptr = NULL;
+    int64_t window_start = strtoll(filename, &endptr, 10);
+
+    if (endptr == filename || (0 != strcmp(endptr, NP_NOTIF_STORE_IDX_SUFFIX) &&
+            0 != strcmp(endptr, NP_NOTIF_STORE_LOG_SUFFIX))) {
+        return false;
+    }
+    for (size_t i = 0; i < segment_cnt; i++) {
+        if (segments[i].window_start == window_start) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Enforces the retention policy on the notifications of one module, the oldest segments are
+ * removed or compacted first. Each segment is processed separately, the appends are blocked only while
+ * a segment is being replaced or removed.
+ */
+static int
+np_notif_store_enforce_module(np_notif_store_t *store, const char *module_name, const np_notif_store_retention_t *retention)
+{
+    char dirname[PATH_MAX] = { 0, }, filename[PATH_MAX] = { 0, };
+    struct dirent **entries = NULL;
+    struct stat sb = { 0, };
+    np_notif_store_segment_info_t *segments = NULL;
+    size_t segment_cnt = 0, i = 0;
+    uint64_t total_size = 0, total_count = 0, drop_size = 0, drop_count = 0, dropped_size = 0, dropped_count = 0;
+    time_t older_than = time(NULL) - retention->max_age;
+    int entry_cnt = 0, rc = SR_ERR_OK;
+
+    snprintf(dirname, PATH_MAX, "%s/%s", store->store_dir, module_name);
+
+    entry_cnt = scandir(dirname, &entries, NULL, alphasort);
+    if (entry_cnt <= 0) {
+        return SR_ERR_OK;
+    }
+    segments = calloc(entry_cnt, sizeof(*segments));
+    CHECK_NULL_NOMEM_GOTO(segments, rc, cleanup);
+
+    /* the segments are sorted by their time windows */
+    for (int j = 0; j < entry_cnt; j++) {
+        if (np_notif_store_segment_info(dirname, entries[j]->d_name, &segments[segment_cnt])) {
+            segment_cnt++;
+        }
+    }
+
+    /* remove aged out files that do not belong to any segment (e.g. left by an older version) */
+    for (int j = 0; j < entry_cnt && 0 != retention->max_age; j++) {
+        snprintf(filename, PATH_MAX, "%s/%s", dirname, entries[j]->d_name);
+        if (!np_notif_store_is_segment_file(entries[j]->d_name, segments, segment_cnt) &&
+                -1 != stat(filename, &sb) && S_ISREG(sb.st_mode) && sb.st_mtime <= older_than) {
+            SR_LOG_DBG("Deleting old notification data file '%s'.", filename);
+            if (-1 == unlink(filename)) {
+                SR_LOG_WRN("Unable to delete notification data file '%s': %s.", filename, sr_strerror_safe(errno));
+            }
+        }
+    }
+
+    for (i = 0; i < segment_cnt; i++) {
+        if (0 != retention->max_age && segments[i].mtime <= older_than) {
+            /* the whole segment has aged out */
+            rc = np_notif_store_segment_trim(store, module_name, segments[i].window_start, UINT64_MAX, UINT64_MAX,
+                    &dropped_size, &dropped_count);
+            CHECK_RC_LOG_GOTO(rc, cleanup, "Unable to remove aged out notifications of module '%s'.", module_name);
+            segments[i].size = segments[i].count = 0;
+        }
+        total_size += segments[i].size;
+        total_count += segments[i].count;
+    }
+
+    for (i = 0; i < segment_cnt; i++) {
+        drop_size = (0 != retention->max_size && total_size > retention->max_size) ? total_size - retention->max_size : 0;
+        drop_count = (0 != retention->max_count && total_count > retention->max_count) ? total_count - retention->max_count : 0;
+        if (0 == drop_size && 0 == drop_count) {
+            break;
+        }
+        if (0 == segments[i].count) {
+            continue;
+        }
+        rc = np_notif_store_segment_trim(store, module_name, segments[i].window_start, drop_size, drop_count,
+                &dropped_size, &dropped_count);
+        CHECK_RC_LOG_GOTO(rc, cleanup, "Unable to compact notifications of module '%s'.", module_name);
+        total_size -= (dropped_size < total_size) ? dropped_size : total_size;
+        total_count -= (dropped_count < total_count) ? dropped_count : total_count;
+    }
+
+cleanup:
+    for (int j = 0; j < entry_cnt; j++) {
+        free(entries[j]);
+    }
+    free(entries);
+    free(segments);
+    return rc;
+}
+
+int
+np_notif_store_enforce_retention(np_notif_store_t *store)
+{
+    np_notif_store_retention_t retention = { 0, };
+    struct dirent **modules = NULL;
+    int module_cnt = 0, rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG(store);
+
+    module_cnt = scandir(store->store_dir, &modules, NULL, alphasort);
+    if (module_cnt < 0) {
+        if (ENOENT != errno) {
+            SR_LOG_ERR("Error by scanning directory '%s': %s.", store->store_dir, sr_strerror_safe(errno));
+            return SR_ERR_INTERNAL;
+        }
+        return SR_ERR_OK;
+    }
+
+    SR_MUTEX_LOCK(&store->retention_mutex, "notif_store_retention_mutex");
+
+    for (int i = 0; i < module_cnt; i++) {
+        if ('.' != modules[i]->d_name[0]) {
+            retention = store->retention;
+            if (NULL != store->retention_cb) {
+                store->retention_cb(modules[i]->d_name, &retention, store->retention_ctx);
+            }
+            if (SR_ERR_OK != np_notif_store_enforce_module(store, modules[i]->d_name, &retention)) {
+                /* continue with the other modules */
+                rc = SR_ERR_IO;
+            }
+        }
+        free(modules[i]);
+    }
+    free(modules);
+
+    SR_MUTEX_UNLOCK(&store->retention_mutex);
+
+    return rc;
+}
+
+/**
+ * @brief Body of the compactor thread - periodically enforces the retention policies.
+ *
+ * The thread keeps the default scheduling policy: it takes the store mutex to flush the store and to replace
+ * a compacted segment, so running it with a lower priority would delay the appends waiting for the mutex.
+ * The expensive part of the compaction (copying the retained records) is done without holding any lock.
+ */
+static void *
+np_notif_store_compactor(void *arg)
+{
+    np_notif_store_t *store = (np_notif_store_t *) arg;
+    struct timespec ts = { 0, };
+    int ret = 0;
+
+    pthread_mutex_lock(&store->compactor_mutex);
+    while (!store->compactor_stop) {
+        sr_clock_get_time(CLOCK_REALTIME, &ts);
+        ts.tv_sec += NP_NOTIF_STORE_COMPACT_INTERVAL;
+        ret = 0;
+        while (!store->compactor_stop && !store->compactor_wakeup && ETIMEDOUT != ret) {
+            ret = pthread_cond_timedwait(&store->compactor_cond, &store->compactor_mutex, &ts);
+        }
+        if (store->compactor_stop) {
+            break;
+        }
+        store->compactor_wakeup = false;
+        pthread_mutex_unlock(&store->compactor_mutex);
+
+        np_notif_store_sync(store);
+        np_notif_store_enforce_retention(store);
+
+        pthread_mutex_lock(&store->compactor_mutex);
+    }
+    pthread_mutex_unlock(&store->compactor_mutex);
+
+    return NULL;
+}
+
+int
+np_notif_store_compactor_start(np_notif_store_t *store)
+{
+    int ret = 0;
+
+    CHECK_NULL_ARG(store);
+
+    if (store->compactor_running) {
+        return SR_ERR_OK;
+    }
+
+    ret = pthread_create(&store->compactor_thread, NULL, np_notif_store_compactor, store);
+    if (0 != ret) {
+        SR_LOG_ERR("Unable to start the notification store compactor thread: %s", sr_strerror_safe(ret));
+        return SR_ERR_INTERNAL;
+    }
+    store->compactor_running = true;
+
+    return SR_ERR_OK;
+}
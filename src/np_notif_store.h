@@ -0,0 +1,253 @@
+/**
+ * @defgroup np_notif_store Notification store
+ * @ingroup np
+ * @{
+ * @brief Append-only log of event notifications with a time/xpath index.
+ * @file np_notif_store.h
+ *
+ * Notifications of each module are appended into segments (one per time window of generation time),
+ * each consisting of a log file with the records and an index file with fixed-size entries
+ * (generation time, xpath hash, position of the record in the log, sequence number of the record). Storing a notification is a single
+ * append into both files, the data are flushed to the disk in batches. Replay selects the segments by their
+ * names and reads only those records of the log whose index entries match the requested time interval and xpath.
+ *
+ * Retention policies (maximum age, size and count of the notifications of a module) are enforced by a background
+ * compactor thread, which removes the oldest segments or rewrites them without their oldest records.
+ *
+ * @copyright
+ * Copyright 2016 Cisco Systems, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef NP_NOTIF_STORE_H_
+#define NP_NOTIF_STORE_H_
+
+#include <time.h>
+
+#include "sr_common.h"
+
+/**
+ * @brief Maximum time (in seconds) that an appended notification can stay not flushed to the disk.
+ */
+#define NP_NOTIF_STORE_SYNC_INTERVAL 1
+
+/**
+ * @brief Maximum time (in seconds) between two retention passes of the compactor thread.
+ */
+#define NP_NOTIF_STORE_COMPACT_INTERVAL 60
+
+/**
+ * @brief Number of bytes appended into the store after which the compactor thread runs before its interval expires.
+ */
+#define NP_NOTIF_STORE_COMPACT_TRIGGER (1024 * 1024)
+
+/**
+ * @brief Notification store context.
+ */
+typedef struct np_notif_store_s np_notif_store_t;
+
+/**
+ * @brief Format of the data of a stored notification.
+ */
+typedef enum np_notif_store_data_type_e {
+    NP_NOTIF_STORE_DATA_XML = 1,      /**< Notification data tree printed in XML. */
+    NP_NOTIF_STORE_DATA_STRING = 2,   /**< Notification in the string format (netconf-config-change). */
+} np_notif_store_data_type_t;
+
+/**
+ * @brief Notification record read from the store.
+ */
+typedef struct np_notif_store_record_s {
+    const char *xpath;                      /**< XPath of the notification. */
+    time_t generated_time;                  /**< Time when the notification has been generated. */
+    time_t logged_time;                     /**< Time when the notification has been stored. */
+    np_notif_store_data_type_t data_type;   /**< Format of the data. */
+    const char *data;                       /**< Notification data. */
+} np_notif_store_record_t;
+
+/**
+ * @brief Notification to be appended into the store by ::np_notif_store_append_batch.
+ */
+typedef struct np_notif_store_entry_s {
+    const char *module_name;                /**< Name of the module the notification belongs to. */
+    const char *xpath;                      /**< XPath of the notification. */
+    time_t generated_time;                  /**< Time when the notification has been generated. */
+    np_notif_store_data_type_t data_type;   /**< Format of the data. */
+    const char *data;                       /**< Notification data. */
+} np_notif_store_entry_t;
+
+/**
+ * @brief Position in the store where a read request has stopped, used to continue reading. The position
+ * stays valid when the oldest records of the segment are dropped by the retention meanwhile.
+ */
+typedef struct np_notif_store_cursor_s {
+    bool valid;             /**< TRUE if the position has been set. */
+    bool done;              /**< TRUE once all matching records have been read. */
+    int64_t segment;        /**< Time window of the segment to continue with. */
+    uint64_t sequence;      /**< Sequence number of the next record within the segment. */
+} np_notif_store_cursor_t;
+
+/**
+ * @brief Callback called for each notification record matching a read request.
+ *
+ * @param[in] record Record read from the store, valid only during the callback.
+ * @param[in] private_ctx Private context passed to ::np_notif_store_read.
+ *
+ * @return Error code (SR_ERR_OK on success), any other value stops the reading.
+ */
+typedef int (*np_notif_store_record_cb)(const np_notif_store_record_t *record, void *private_ctx);
+
+/**
+ * @brief Retention policy of the notifications of a module, 0 stands for unlimited.
+ */
+typedef struct np_notif_store_retention_s {
+    uint32_t max_age;       /**< Maximum age of a segment (in seconds since its last modification). */
+    uint64_t max_size;      /**< Maximum total size of the segments of the module (in bytes). */
+    uint64_t max_count;     /**< Maximum number of stored notifications of the module. */
+} np_notif_store_retention_t;
+
+/**
+ * @brief Callback called to adjust the retention policy of a module.
+ *
+ * @param[in] module_name Name of the module.
+ * @param[in,out] retention Retention policy of the module, pre-filled with the default policy.
+ * @param[in] private_ctx Private context passed to ::np_notif_store_set_retention.
+ */
+typedef void (*np_notif_store_retention_cb)(const char *module_name, np_notif_store_retention_t *retention,
+        void *private_ctx);
+
+/**
+ * @brief Initializes the notification store.
+ *
+ * @param[in] store_dir Directory with the notification store (one subdirectory per module).
+ * @param[in] data_search_dir Directory with the data files (used to derive permissions of the store files).
+ * @param[out] store Allocated store context.
+ *
+ * @return Error code (SR_ERR_OK on success)
+ */
+int np_notif_store_init(const char *store_dir, const char *data_search_dir, np_notif_store_t **store);
+
+/**
+ * @brief Flushes all pending data to the disk and frees all resources held by the store.
+ *
+ * @param[in] store Store context acquired by ::np_notif_store_init.
+ */
+void np_notif_store_cleanup(np_notif_store_t *store);
+
+/**
+ * @brief Appends a notification into the store.
+ *
+ * @param[in] store Store context.
+ * @param[in] module_name Name of the module the notification belongs to.
+ * @param[in] xpath XPath of the notification.
+ * @param[in] generated_time Time when the notification has been generated.
+ * @param[in] data_type Format of the data.
+ * @param[in] data Notification data.
+ *
+ * @return Error code (SR_ERR_OK on success)
+ */
+int np_notif_store_append(np_notif_store_t *store, const char *module_name, const char *xpath, time_t generated_time,
+        np_notif_store_data_type_t data_type, const char *data);
+
+/**
+ * @brief Appends multiple notifications into the store. Consecutive notifications belonging to the same segment
+ * are appended with a single write into its log and index.
+ *
+ * @param[in] store Store context.
+ * @param[in] entries Array of notifications to be appended.
+ * @param[in] entry_cnt Number of the notifications.
+ *
+ * @return Error code (SR_ERR_OK on success)
+ */
+int np_notif_store_append_batch(np_notif_store_t *store, const np_notif_store_entry_t *entries, size_t entry_cnt);
+
+/**
+ * @brief Flushes the notifications appended since the last flush to the disk.
+ *
+ * @param[in] store Store context.
+ *
+ * @return Error code (SR_ERR_OK on success)
+ */
+int np_notif_store_sync(np_notif_store_t *store);
+
+/**
+ * @brief Reads the notifications of a module generated within given time interval (in the order they have been stored).
+ *
+ * If a cursor is provided, reading starts at the position where the previous read with the same cursor has
+ * stopped and the cursor is updated to the position after the last record passed to the callback.
+ *
+ * @param[in] store Store context.
+ * @param[in] module_name Name of the module.
+ * @param[in] xpath XPath of the notifications to be read, NULL to read all notifications of the module.
+ * @param[in] time_from Start of the time interval (inclusive).
+ * @param[in] time_to End of the time interval (inclusive).
+ * @param[in,out] cursor Position to continue from (zeroed to start from the beginning), can be NULL.
+ * @param[in] max_records Maximum number of records to be read, 0 for unlimited.
+ * @param[in] record_cb Callback called for each matching record.
+ * @param[in] private_ctx Private context passed to the callback.
+ *
+ * @return Error code (SR_ERR_OK on success)
+ */
+int np_notif_store_read(np_notif_store_t *store, const char *module_name, const char *xpath, time_t time_from,
+        time_t time_to, np_notif_store_cursor_t *cursor, size_t max_records, np_notif_store_record_cb record_cb,
+        void *private_ctx);
+
+/**
+ * @brief Sets the retention policies enforced by ::np_notif_store_enforce_retention.
+ *
+ * @param[in] store Store context.
+ * @param[in] retention Default retention policy.
+ * @param[in] retention_cb Callback adjusting the policy of each module, can be NULL.
+ * @param[in] private_ctx Private context passed to the callback.
+ *
+ * @return Error code (SR_ERR_OK on success)
+ */
+int np_notif_store_set_retention(np_notif_store_t *store, const np_notif_store_retention_t *retention,
+        np_notif_store_retention_cb retention_cb, void *private_ctx);
+
+/**
+ * @brief Enforces the retention policies on all modules - removes the aged out segments and drops the oldest
+ * notifications of the modules that exceed their size or count limit.
+ *
+ * @param[in] store Store context.
+ *
+ * @return Error code (SR_ERR_OK on success)
+ */
+int np_notif_store_enforce_retention(np_notif_store_t *store);
+
+/**
+ * @brief Starts the compactor thread, which flushes the store and enforces the retention policies every
+ * ::NP_NOTIF_STORE_COMPACT_INTERVAL seconds (or earlier after ::NP_NOTIF_STORE_COMPACT_TRIGGER bytes have been
+ * appended). The thread is stopped by ::np_notif_store_cleanup.
+ *
+ * @param[in] store Store context.
+ *
+ * @return Error code (SR_ERR_OK on success)
+ */
+int np_notif_store_compactor_start(np_notif_store_t *store);
+
+/**
+ * @brief Computes the size of the store - number and total size of the store files.
+ *
+ * @param[in] store Store context.
+ * @param[out] file_cnt Number of the files.
+ * @param[out] size Total size of the files (in bytes).
+ *
+ * @return Error code (SR_ERR_OK on success)
+ */
+int np_notif_store_get_size(np_notif_store_t *store, uint32_t *file_cnt, uint64_t *size);
+
+/**@} np_notif_store */
+
+#endif /* NP_NOTIF_STORE_H_ */
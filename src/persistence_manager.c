@@ -51,8 +51,10 @@
 #define PM_XPATH_SUBSCRIPTION_USERNAME        PM_XPATH_SUBSCRIPTION      "/username"
 #define PM_XPATH_SUBSCRIPTION_EVENT           PM_XPATH_SUBSCRIPTION      "/event"
 #define PM_XPATH_SUBSCRIPTION_PRIORITY        PM_XPATH_SUBSCRIPTION      "/priority"
+#define PM_XPATH_SUBSCRIPTION_DP_CACHE_TTL    PM_XPATH_SUBSCRIPTION      "/dp-cache-ttl"
 #define PM_XPATH_SUBSCRIPTION_ENABLE_RUNNING  PM_XPATH_SUBSCRIPTION      "/enable-running"
 #define PM_XPATH_SUBSCRIPTION_ENABLE_NACM     PM_XPATH_SUBSCRIPTION      "/enable-nacm"
+#define PM_XPATH_SUBSCRIPTION_INLINE_CHANGES  PM_XPATH_SUBSCRIPTION      "/inline-changes"
 #define PM_XPATH_SUBSCRIPTION_API_VARIANT     PM_XPATH_SUBSCRIPTION      "/api-variant"
 
 #define PM_XPATH_SUBSCRIPTIONS_BY_TYPE        PM_XPATH_SUBSCRIPTION_LIST "[type='%s']"
@@ -61,6 +63,8 @@
 #define PM_XPATH_SUBSCRIPTIONS_BY_DST_ID      PM_XPATH_SUBSCRIPTION_LIST "[destination-address='%s'][destination-id='%"PRIu32"']"
 #define PM_XPATH_SUBSCRIPTIONS_WITH_E_RUNNING PM_XPATH_SUBSCRIPTION_LIST "[enable-running=true()]"
 
+#define PM_XPATH_NOTIF_RETENTION              PM_XPATH_MODULE "/notification-retention/*"
+
 #define PM_XATTR_NAME "user.write_time" /**< Extended attribute used to store file timestamps. */
 #define PM_BILLION 1000000000L          /**< one billion, used for time calculations. */
 
@@ -211,17 +215,9 @@ pm_load_data_tree(pm_ctx_t *pm_ctx, const ac_ucred_t *user_cred, const char *mod
     CHECK_RC_LOG_RETURN(rc, "Unable to compose persist data file name for '%s'.", module_name);
 
     /* open the file as the proper user */
-    if (NULL != user_cred) {
-        ac_set_user_identity(pm_ctx->rp_ctx->ac_ctx, user_cred);
-    }
-
-    fd = open(data_filename, (read_only ? O_RDONLY : O_RDWR));
+    fd = ac_open_file(pm_ctx->rp_ctx->ac_ctx, user_cred, data_filename, (read_only ? O_RDONLY : O_RDWR), 0);
     error = errno;
 
-    if (NULL != user_cred) {
-        ac_unset_user_identity(pm_ctx->rp_ctx->ac_ctx, user_cred);
-    }
-
     if (-1 == fd) {
         /* error by open */
         if (ENOENT == error) {
@@ -460,12 +456,18 @@ pm_subscription_entry_fill(const char *module_name, np_subscription_t *subscript
             if (0 == strcmp(node->schema->name, "priority") && NULL != node_ll->value_str) {
                 subscription->priority = atoi(node_ll->value_str);
             }
+            if (0 == strcmp(node->schema->name, "dp-cache-ttl") && NULL != node_ll->value_str) {
+                subscription->dp_cache_ttl = node_ll->value.uint32;
+            }
             if (0 == strcmp(node->schema->name, "enable-running")) {
                 subscription->enable_running = true;
             }
             if (0 == strcmp(node->schema->name, "enable-nacm")) {
                 subscription->enable_nacm = true;
             }
+            if (0 == strcmp(node->schema->name, "inline-changes")) {
+                subscription->inline_changes = true;
+            }
             if (0 == strcmp(node->schema->name, "api-variant") && NULL != node_ll->value_str) {
                 subscription->api_variant = sr_api_variant_from_str(node_ll->value_str);
             }
@@ -1123,6 +1125,12 @@ pm_add_subscription(pm_ctx_t *pm_ctx, const ac_ucred_t *user_cred, const char *m
         rc = pm_modify_persist_data_tree(pm_ctx, &data_tree, xpath, NULL, true, true, NULL);
         CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to add new leaf into the data tree.");
     }
+    if (subscription->inline_changes) {
+        snprintf(xpath, PATH_MAX, PM_XPATH_SUBSCRIPTION_INLINE_CHANGES, module_name,
+                sr_subscription_type_gpb_to_str(subscription->type), subscription->dst_address, subscription->dst_id);
+        rc = pm_modify_persist_data_tree(pm_ctx, &data_tree, xpath, NULL, true, true, NULL);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to add new leaf into the data tree.");
+    }
     if (NULL != subscription->xpath) {
         snprintf(xpath, PATH_MAX, PM_XPATH_SUBSCRIPTION_XPATH, module_name,
                 sr_subscription_type_gpb_to_str(subscription->type), subscription->dst_address, subscription->dst_id);
@@ -1162,6 +1170,14 @@ pm_add_subscription(pm_ctx_t *pm_ctx, const ac_ucred_t *user_cred, const char *m
         rc = pm_modify_persist_data_tree(pm_ctx, &data_tree, xpath, value, true, true, NULL);
         CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to add new leaf into the data tree.");
     }
+    if (SR__SUBSCRIPTION_TYPE__DP_GET_ITEMS_SUBS == subscription->type && subscription->dp_cache_ttl > 0) {
+        snprintf(xpath, PATH_MAX, PM_XPATH_SUBSCRIPTION_DP_CACHE_TTL, module_name,
+                sr_subscription_type_gpb_to_str(subscription->type), subscription->dst_address, subscription->dst_id);
+        snprintf(buff, sizeof(buff), "%"PRIu32, subscription->dp_cache_ttl);
+        value = buff;
+        rc = pm_modify_persist_data_tree(pm_ctx, &data_tree, xpath, value, true, true, NULL);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Unable to add new leaf into the data tree.");
+    }
     if (SR__SUBSCRIPTION_TYPE__RPC_SUBS == subscription->type ||
             SR__SUBSCRIPTION_TYPE__EVENT_NOTIF_SUBS == subscription->type ||
             SR__SUBSCRIPTION_TYPE__ACTION_SUBS == subscription->type) {
@@ -1338,3 +1354,49 @@ cleanup:
 
     return rc;
 }
+
+int
+pm_get_notif_retention(pm_ctx_t *pm_ctx, const char *module_name, np_notif_store_retention_t *retention)
+{
+    char xpath[PATH_MAX] = { 0, };
+    struct lyd_node *data_tree = NULL;
+    struct ly_set *node_set = NULL;
+    struct lyd_node_leaf_list *node_ll = NULL;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG3(pm_ctx, module_name, retention);
+
+    /* load the data tree from persist file */
+    rc = pm_load_data_tree(pm_ctx, NULL, module_name, true, &data_tree, NULL);
+    if (SR_ERR_DATA_MISSING == rc) {
+        /* no persistent data, keep the default policy */
+        return SR_ERR_OK;
+    }
+    CHECK_RC_LOG_RETURN(rc, "Unable to load persist data tree for module '%s'.", module_name);
+    if (NULL == data_tree) {
+        return SR_ERR_OK;
+    }
+
+    snprintf(xpath, PATH_MAX, PM_XPATH_NOTIF_RETENTION, module_name);
+    node_set = lyd_find_xpath(data_tree, xpath);
+
+    for (size_t i = 0; NULL != node_set && i < node_set->number; i++) {
+        node_ll = (struct lyd_node_leaf_list *) node_set->set.d[i];
+        if (0 == strcmp(node_ll->schema->name, "max-age")) {
+            retention->max_age = node_ll->value.uint32 * 60;
+        } else if (0 == strcmp(node_ll->schema->name, "max-size")) {
+            retention->max_size = node_ll->value.uint64;
+        } else if (0 == strcmp(node_ll->schema->name, "max-count")) {
+            retention->max_count = node_ll->value.uint64;
+        }
+    }
+
+    SR_LOG_DBG("Notification retention of module '%s': max-age=%"PRIu32"s, max-size=%"PRIu64"B, max-count=%"PRIu64".",
+            module_name, retention->max_age, retention->max_size, retention->max_count);
+
+    if (NULL != node_set) {
+        ly_set_free(node_set);
+    }
+    lyd_free_withsiblings(data_tree);
+    return SR_ERR_OK;
+}
@@ -152,6 +152,18 @@ int pm_remove_subscriptions_for_destination(pm_ctx_t *pm_ctx, const char *module
 int pm_get_subscriptions(pm_ctx_t *pm_ctx, const ac_ucred_t *user_cred, const char *module_name,
         Sr__SubscriptionType notif_type, sr_list_t **subscriptions);
 
+/**
+ * @brief Adjusts the retention policy of the notifications of the module according to its persistent data.
+ * Limits not specified in the persistent data are left untouched.
+ *
+ * @param[in] pm_ctx Persistence Manager context acquired by ::pm_init call.
+ * @param[in] module_name Name of the module.
+ * @param[in,out] retention Retention policy, pre-filled with the default values.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+int pm_get_notif_retention(pm_ctx_t *pm_ctx, const char *module_name, np_notif_store_retention_t *retention);
+
 /**@} pm */
 
 #endif /* PERSISTENCE_MANAGER_H_ */
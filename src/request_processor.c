@@ -24,6 +24,9 @@
 #include <unistd.h>
 #include <inttypes.h>
 #include <pthread.h>
+#include <limits.h>
+#include <stdarg.h>
+#include <sys/stat.h>
 
 #include "sr_common.h"
 #include "access_control.h"
@@ -32,6 +35,7 @@
 #include "data_manager.h"
 #include "rp_internal.h"
 #include "rp_dt_get.h"
+#include "rp_dp_cache.h"
 #include "rp_dt_edit.h"
 #include "rp_dt_xpath.h"
 
@@ -46,12 +50,18 @@
 #define RP_THREAD_SPIN_MIN 1000        /**< Minimum number of cycles that a thread will spin before going to sleep, if spin is enabled. */
 #define RP_THREAD_SPIN_MAX 1000000     /**< Maximum number of cycles that a thread can spin before going to sleep. */
 
+#define RP_NOTIF_REPLAY_STEP 100        /**< Number of notifications replayed before the replay continues with a new internal request. */
+
+#define RP_MONITORING_MODULE "sysrepo-monitoring"               /**< Module with internally provided performance statistics. */
+#define RP_MONITORING_XPATH  "/sysrepo-monitoring:sysrepo-state" /**< Subtree of performance statistics. */
+
 /**
  * @brief Request context (for storing requests inside of the request queue).
  */
 typedef struct rp_request_s {
     rp_session_t *session;  /**< Request Processor's session. */
     Sr__Msg *msg;           /**< Message to be processed. */
+    bool trusted;           /**< TRUE if the message was sent by a trusted peer (see ::rp_trusted_msg_process). */
 } rp_request_t;
 
 typedef enum rp_capability_change_type_e {
@@ -113,7 +123,7 @@ rp_check_notif_session(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
 
     rc = dm_get_commit_ctxs(rp_ctx->dm_ctx, &dm_ctxs);
     CHECK_RC_MSG_RETURN(rc, "Get commit ctx failed");
-    pthread_rwlock_rdlock(&dm_ctxs->lock);
+    SR_RWLOCK_RDLOCK(&dm_ctxs->lock, "commit_ctxs_lock");
 
     rc = dm_get_commit_context(rp_ctx->dm_ctx, id, &c_ctx);
     CHECK_RC_MSG_GOTO(rc, cleanup, "Get commit context failed");
@@ -147,7 +157,7 @@ rp_check_notif_session(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
 
 cleanup:
     free(module_name);
-    pthread_rwlock_unlock(&dm_ctxs->lock);
+    SR_RWLOCK_UNLOCK(&dm_ctxs->lock);
     return rc;
 }
 
@@ -228,7 +238,7 @@ rp_create_capability_change_values(rp_ctx_t *rp_ctx, rp_session_t *session, cons
 
     SR_LOG_DBG("Generated notification %s %s", val[1].xpath, val[1].data.string_val);
 unlock:
-    pthread_rwlock_unlock(&si->model_lock);
+    SR_RWLOCK_UNLOCK(&si->model_lock);
 
 cleanup:
     if (SR_ERR_OK != rc) {
@@ -1405,6 +1415,35 @@ rp_validate_req_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
     return rc;
 }
 
+/**
+ * @brief Updates commit statistics once processing of a commit request has finished.
+ */
+static void
+rp_stats_commit_finished(rp_ctx_t *rp_ctx, rp_session_t *session, int result)
+{
+    struct timespec now = { 0, };
+    uint64_t latency = 0;
+
+    CHECK_NULL_ARG_VOID3(rp_ctx, rp_ctx->stats, session);
+
+    sr_clock_get_time(CLOCK_MONOTONIC, &now);
+    latency = (1000000L * (now.tv_sec - session->commit_start.tv_sec)) +
+            (now.tv_nsec - session->commit_start.tv_nsec) / 1000;
+
+    pthread_mutex_lock(&rp_ctx->stats->mutex);
+    if (SR_ERR_OK == result) {
+        rp_ctx->stats->commit_cnt += 1;
+    } else {
+        rp_ctx->stats->commit_failed_cnt += 1;
+    }
+    rp_ctx->stats->commit_latency_last = latency;
+    rp_ctx->stats->commit_latency_total += latency;
+    if (latency > rp_ctx->stats->commit_latency_max) {
+        rp_ctx->stats->commit_latency_max = latency;
+    }
+    pthread_mutex_unlock(&rp_ctx->stats->mutex);
+}
+
 /**
  * @brief Processes a commit request.
  */
@@ -1448,6 +1487,7 @@ rp_commit_req_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg, boo
         CHECK_RC_LOG_GOTO(rc, cleanup, "Failed to resume commit, commit ctx with id %"PRIu32" not found.", session->commit_id);
         pthread_mutex_lock(&c_ctx->mutex);
     } else {
+        sr_clock_get_time(CLOCK_MONOTONIC, &session->commit_start);
         rc = rp_dt_remove_loaded_state_data(rp_ctx, session);
         if (SR_ERR_OK != rc ) {
             SR_LOG_ERR_MSG("An error occurred while removing state data");
@@ -1471,6 +1511,7 @@ cleanup:
     session->state = RP_REQ_FINISHED;
     session->req = NULL;
     if (locked) {
+        rp_stats_commit_finished(rp_ctx, session, rc);
         pthread_mutex_unlock(&session->cur_req_mutex);
     }
     /* set response code */
@@ -1672,8 +1713,9 @@ rp_session_set_opts(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
         return SR_ERR_NOMEM;
     }
 
-    /* white list options that can be set */
-    session->options = msg->request->session_set_opts_req->options & SR_SESS_MUTABLE_OPTS;
+    /* white list options that can be set, the immutable ones are preserved */
+    session->options = (session->options & ~SR_SESS_MUTABLE_OPTS) |
+            (msg->request->session_set_opts_req->options & SR_SESS_MUTABLE_OPTS);
 
     /* set response code */
     resp->response->result = rc;
@@ -1821,6 +1863,9 @@ rp_subscribe_req_process(const rp_ctx_t *rp_ctx, const rp_session_t *session, Sr
     if (subscribe_req->has_enable_event && subscribe_req->enable_event) {
         options |= NP_SUBSCR_EV_EVENT;
     }
+    if (subscribe_req->has_inline_changes && subscribe_req->inline_changes) {
+        options |= NP_SUBSCR_INLINE_CHANGES;
+    }
 
     /* subscribe to the notification */
     rc = np_notification_subscribe(rp_ctx->np_ctx, session, subscribe_req->type,
@@ -1828,6 +1873,7 @@ rp_subscribe_req_process(const rp_ctx_t *rp_ctx, const rp_session_t *session, Sr
             subscribe_req->module_name, subscribe_req->xpath, username,
             (subscribe_req->has_notif_event ? subscribe_req->notif_event : SR__NOTIFICATION_EVENT__APPLY_EV),
             (subscribe_req->has_priority ? subscribe_req->priority : 0),
+            (subscribe_req->has_dp_cache_ttl ? subscribe_req->dp_cache_ttl : 0),
             sr_api_variant_gpb_to_sr(subscribe_req->api_variant),
             options);
 
@@ -1939,6 +1985,117 @@ rp_check_enabled_running_req_process(const rp_ctx_t *rp_ctx, const rp_session_t
     return rc;
 }
 
+/**
+ * @brief Processes a dp-cache-invalidate request.
+ */
+static int
+rp_dp_cache_invalidate_req_process(const rp_ctx_t *rp_ctx, const rp_session_t *session, Sr__Msg *msg)
+{
+    Sr__Msg *resp = NULL;
+    sr_mem_ctx_t *sr_mem = NULL;
+    const char *xpath = NULL;
+    int rc = SR_ERR_OK, oper_rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG5(rp_ctx, session, msg, msg->request, msg->request->dp_cache_invalidate_req);
+
+    xpath = msg->request->dp_cache_invalidate_req->xpath;
+    SR_LOG_DBG("Processing dp-cache-invalidate request (%s).", xpath);
+
+    /* allocate the response */
+    rc = sr_mem_new(0, &sr_mem);
+    CHECK_RC_MSG_RETURN(rc, "Failed to create a new Sysrepo memory context.");
+    rc = sr_gpb_resp_alloc(sr_mem, SR__OPERATION__DP_CACHE_INVALIDATE, session->id, &resp);
+    if (SR_ERR_OK != rc) {
+        sr_mem_free(sr_mem);
+        SR_LOG_ERR_MSG("Allocation of dp-cache-invalidate response failed.");
+        return SR_ERR_NOMEM;
+    }
+
+    /* dropping the data cached for other sessions requires write access to the module */
+    oper_rc = ac_check_node_permissions(session->ac_session, xpath, AC_OPER_READ_WRITE);
+    if (SR_ERR_OK == oper_rc) {
+        oper_rc = rp_dp_cache_invalidate(rp_ctx->dp_cache, xpath);
+    } else {
+        SR_LOG_ERR("Access control check failed for xpath '%s'", xpath);
+    }
+
+    /* set response code */
+    resp->response->result = oper_rc;
+
+    /* send the response */
+    rc = cm_msg_send(rp_ctx->cm_ctx, resp);
+    return rc;
+}
+
+/**
+ * @brief Processes an oper-data-push request.
+ */
+static int
+rp_oper_data_push_req_process(const rp_ctx_t *rp_ctx, const rp_session_t *session, Sr__Msg *msg)
+{
+    Sr__Msg *resp = NULL;
+    Sr__OperDataPushReq *push_req = NULL;
+    sr_mem_ctx_t *sr_mem = NULL;
+    sr_val_t *values = NULL;
+    size_t values_cnt = 0;
+    struct lys_node *sch_node = NULL;
+    int rc = SR_ERR_OK, oper_rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG5(rp_ctx, session, msg, msg->request, msg->request->oper_data_push_req);
+
+    push_req = msg->request->oper_data_push_req;
+    SR_LOG_DBG("Processing oper-data-push request (%s, %zu values).", push_req->xpath, push_req->n_values);
+
+    /* allocate the response */
+    rc = sr_mem_new(0, &sr_mem);
+    CHECK_RC_MSG_RETURN(rc, "Failed to create a new Sysrepo memory context.");
+    rc = sr_gpb_resp_alloc(sr_mem, SR__OPERATION__OPER_DATA_PUSH, session->id, &resp);
+    if (SR_ERR_OK != rc) {
+        sr_mem_free(sr_mem);
+        SR_LOG_ERR_MSG("Allocation of oper-data-push response failed.");
+        return SR_ERR_NOMEM;
+    }
+
+    /* only operational data can be pushed */
+    oper_rc = rp_dt_validate_node_xpath(rp_ctx->dm_ctx, NULL, push_req->xpath, NULL, &sch_node);
+    if (SR_ERR_OK != oper_rc) {
+        SR_LOG_ERR("Requested xpath '%s' is not valid.", push_req->xpath);
+        goto cleanup;
+    }
+    if (!(LYS_CONFIG_R & sch_node->flags)) {
+        SR_LOG_ERR("Node '%s' does not represent operational data.", push_req->xpath);
+        oper_rc = SR_ERR_INVAL_ARG;
+        goto cleanup;
+    }
+
+    oper_rc = ac_check_node_permissions(session->ac_session, push_req->xpath, AC_OPER_READ_WRITE);
+    if (SR_ERR_OK != oper_rc) {
+        SR_LOG_ERR("Access control check failed for xpath '%s'", push_req->xpath);
+        goto cleanup;
+    }
+
+    /* copy values from GPB to sysrepo */
+    oper_rc = sr_values_gpb_to_sr((sr_mem_ctx_t *)msg->_sysrepo_mem_ctx, push_req->values, push_req->n_values,
+            &values, &values_cnt);
+    if (SR_ERR_OK != oper_rc) {
+        SR_LOG_ERR_MSG("Failed to transform gpb to sr_val_t");
+        goto cleanup;
+    }
+
+    oper_rc = rp_oper_store_push(rp_ctx->oper_store, session->id, push_req->xpath, values, values_cnt,
+            push_req->has_replace && push_req->replace);
+
+cleanup:
+    sr_free_values(values, values_cnt);
+
+    /* set response code */
+    resp->response->result = oper_rc;
+
+    /* send the response */
+    rc = cm_msg_send(rp_ctx->cm_ctx, resp);
+    return rc;
+}
+
 /**
  * @brief Process get changes request.
  */
@@ -1980,7 +2137,7 @@ rp_get_changes_req_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg
 
     rc = dm_get_commit_ctxs(rp_ctx->dm_ctx, &dm_ctxs);
     CHECK_RC_MSG_GOTO(rc, cleanup, "Get commit ctx failed");
-    pthread_rwlock_rdlock(&dm_ctxs->lock);
+    SR_RWLOCK_RDLOCK(&dm_ctxs->lock, "commit_ctxs_lock");
     locked = true;
 
     rc = dm_get_commit_context(rp_ctx->dm_ctx, id, &c_ctx);
@@ -2007,7 +2164,7 @@ rp_get_changes_req_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg
 
 cleanup:
     if (locked) {
-        pthread_rwlock_unlock(&dm_ctxs->lock);
+        SR_RWLOCK_UNLOCK(&dm_ctxs->lock);
     }
 
     /* set response code */
@@ -2049,7 +2206,7 @@ rp_match_subscription_rpc(const rp_ctx_t *rp_ctx, np_subscription_t *subscriptio
 
 cleanup:
     if (NULL != schema_info) {
-        pthread_rwlock_unlock(&schema_info->model_lock);
+        SR_RWLOCK_UNLOCK(&schema_info->model_lock);
     }
     return rc;
 }
@@ -2108,7 +2265,64 @@ rp_check_exec_perm_req_process(const rp_ctx_t *rp_ctx, const rp_session_t *sessi
 }
 
 /**
- * @brief Processes a RPC/Action request.
+ * @brief Parses and validates input / output arguments of a RPC/Action received in GPB format, returns the arguments
+ * including the default nodes in both API variants.
+ */
+static int
+rp_rpc_args_validate(const rp_ctx_t *rp_ctx, const rp_session_t *session, sr_mem_ctx_t *sr_mem, const char *xpath,
+        bool action, bool input, sr_api_variant_t api_variant, Sr__Value **gpb_values, size_t gpb_value_cnt,
+        Sr__Node **gpb_trees, size_t gpb_tree_cnt, sr_val_t **with_def, size_t *with_def_cnt,
+        sr_node_t **with_def_tree, size_t *with_def_tree_cnt)
+{
+    const char *op_name = (action ? "Action" : "RPC");
+    sr_val_t *args = NULL;
+    sr_node_t *args_tree = NULL;
+    size_t arg_cnt = 0;
+    int rc = SR_ERR_OK;
+
+    /* parse the arguments */
+    switch (api_variant) {
+        case SR_API_VALUES:
+            rc = sr_values_gpb_to_sr(sr_mem, gpb_values, gpb_value_cnt, &args, &arg_cnt);
+            break;
+        case SR_API_TREES:
+            rc = sr_trees_gpb_to_sr(sr_mem, gpb_trees, gpb_tree_cnt, &args_tree, &arg_cnt);
+            break;
+    }
+    CHECK_RC_LOG_RETURN(rc, "Failed to parse %s (%s) %s arguments from GPB message.", op_name, xpath,
+            input ? "input" : "output");
+
+    /* validate the arguments */
+    switch (api_variant) {
+        case SR_API_VALUES:
+            if (action) {
+                rc = dm_validate_action(rp_ctx->dm_ctx, session->dm_session, xpath, args, arg_cnt, input, sr_mem,
+                        with_def, with_def_cnt, with_def_tree, with_def_tree_cnt);
+            } else {
+                rc = dm_validate_rpc(rp_ctx->dm_ctx, session->dm_session, xpath, args, arg_cnt, input, sr_mem,
+                        with_def, with_def_cnt, with_def_tree, with_def_tree_cnt);
+            }
+            sr_free_values(args, arg_cnt);
+            break;
+        case SR_API_TREES:
+            if (action) {
+                rc = dm_validate_action_tree(rp_ctx->dm_ctx, session->dm_session, xpath, args_tree, arg_cnt, input,
+                        sr_mem, with_def, with_def_cnt, with_def_tree, with_def_tree_cnt);
+            } else {
+                rc = dm_validate_rpc_tree(rp_ctx->dm_ctx, session->dm_session, xpath, args_tree, arg_cnt, input,
+                        sr_mem, with_def, with_def_cnt, with_def_tree, with_def_tree_cnt);
+            }
+            sr_free_trees(args_tree, arg_cnt);
+            break;
+    }
+    CHECK_RC_LOG_RETURN(rc, "Validation of an %s (%s) message failed.", op_name, xpath);
+
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Processes a RPC/Action request. Requests of trusted sessions are validated only against the schema (the xpath),
+ * their input arguments are forwarded as received if the subscriber uses the same API variant.
  */
 static int
 rp_rpc_req_process(const rp_ctx_t *rp_ctx, const rp_session_t *session, Sr__Msg *msg)
@@ -2116,15 +2330,15 @@ rp_rpc_req_process(const rp_ctx_t *rp_ctx, const rp_session_t *session, Sr__Msg
     const char *xpath = NULL;
     char *module_name = NULL, *error_msg = NULL;
     sr_api_variant_t msg_api_variant = SR_API_VALUES;
-    sr_val_t *input = NULL, *with_def = NULL;
-    sr_node_t *input_tree = NULL, *with_def_tree = NULL;
-    size_t input_cnt = 0, with_def_cnt = 0, with_def_tree_cnt = 0;
+    sr_val_t *with_def = NULL;
+    sr_node_t *with_def_tree = NULL;
+    size_t with_def_cnt = 0, with_def_tree_cnt = 0;
     sr_list_t *subscriptions_list = NULL;
     np_subscription_t *subscription = NULL;
     Sr__Msg *req = NULL, *resp = NULL;
     sr_mem_ctx_t *sr_mem = NULL;
     const char *op_name = NULL;
-    bool action = false;
+    bool action = false, trusted = false, validated = false;
     nacm_ctx_t *nacm_ctx = NULL;
     nacm_action_t nacm_action = NACM_ACTION_PERMIT;
     char *nacm_rule = NULL, *nacm_rule_info = NULL;
@@ -2168,48 +2382,25 @@ rp_rpc_req_process(const rp_ctx_t *rp_ctx, const rp_session_t *session, Sr__Msg
         }
     }
 
-    /* parse input arguments */
+    /* validate RPC/Action request (only its xpath if the session is trusted) */
     msg_api_variant = sr_api_variant_gpb_to_sr(msg->request->rpc_req->orig_api_variant);
-    switch (msg_api_variant) {
-        case SR_API_VALUES:
-            rc = sr_values_gpb_to_sr(sr_mem, msg->request->rpc_req->input, msg->request->rpc_req->n_input,
-                    &input, &input_cnt);
-            break;
-        case SR_API_TREES:
-            rc = sr_trees_gpb_to_sr(sr_mem, msg->request->rpc_req->input_tree, msg->request->rpc_req->n_input_tree,
-                    &input_tree, &input_cnt);
-            break;
-    }
-    CHECK_RC_LOG_GOTO(rc, finalize, "Failed to parse %s (%s) input arguments from GPB message.",
-                      op_name, msg->request->rpc_req->xpath);
-
-    /* validate RPC/Action request */
-    switch (msg_api_variant) {
-        case SR_API_VALUES:
-            if (action) {
-                rc = dm_validate_action(rp_ctx->dm_ctx, session->dm_session, msg->request->rpc_req->xpath,
-                                 input, input_cnt, true, sr_mem, &with_def, &with_def_cnt,
-                                 &with_def_tree, &with_def_tree_cnt);
-
-            } else {
-                rc = dm_validate_rpc(rp_ctx->dm_ctx, session->dm_session, msg->request->rpc_req->xpath,
-                                     input, input_cnt, true, sr_mem, &with_def, &with_def_cnt,
-                                     &with_def_tree, &with_def_tree_cnt);
-            }
-            break;
-        case SR_API_TREES:
-            if (action) {
-                rc = dm_validate_action_tree(rp_ctx->dm_ctx, session->dm_session, msg->request->rpc_req->xpath,
-                                     input_tree, input_cnt, true, sr_mem, &with_def, &with_def_cnt,
-                                     &with_def_tree, &with_def_tree_cnt);
-            } else {
-                rc = dm_validate_rpc_tree(rp_ctx->dm_ctx, session->dm_session, msg->request->rpc_req->xpath,
-                                     input_tree, input_cnt, true, sr_mem, &with_def, &with_def_cnt,
-                                     &with_def_tree, &with_def_tree_cnt);
-            }
-            break;
+    trusted = (session->options & SR_SESS_TRUSTED);
+    if (trusted) {
+        if (action) {
+            rc = dm_validate_action_xpath(rp_ctx->dm_ctx, session->dm_session, xpath);
+        } else {
+            rc = dm_validate_rpc_xpath(rp_ctx->dm_ctx, session->dm_session, xpath);
+        }
+        CHECK_RC_LOG_GOTO(rc, finalize, "Validation of an %s (%s) xpath failed.", op_name, xpath);
+    } else {
+        rc = rp_rpc_args_validate(rp_ctx, session, sr_mem, xpath, action, true, msg_api_variant,
+                msg->request->rpc_req->input, msg->request->rpc_req->n_input, msg->request->rpc_req->input_tree,
+                msg->request->rpc_req->n_input_tree, &with_def, &with_def_cnt, &with_def_tree, &with_def_tree_cnt);
+        if (SR_ERR_OK != rc) {
+            goto finalize;
+        }
+        validated = true;
     }
-    CHECK_RC_LOG_GOTO(rc, finalize, "Validation of an %s (%s) message failed.", op_name, msg->request->rpc_req->xpath);
 
     /* fill-in subscription details into the request */
     bool subscription_match = false;
@@ -2247,18 +2438,41 @@ rp_rpc_req_process(const rp_ctx_t *rp_ctx, const rp_session_t *session, Sr__Msg
             /*  - api variant */
             req->request->rpc_req->orig_api_variant = msg->request->rpc_req->orig_api_variant;
             /*  - arguments */
-            switch (subscription->api_variant) {
-                case SR_API_VALUES:
-                    rc = sr_values_sr_to_gpb(with_def, with_def_cnt, &req->request->rpc_req->input,
-                                             &req->request->rpc_req->n_input);
-                    break;
-                case SR_API_TREES:
-                    rc = sr_trees_sr_to_gpb(with_def_tree, with_def_tree_cnt, &req->request->rpc_req->input_tree,
-                                            &req->request->rpc_req->n_input_tree);
-                    break;
+            if (trusted && subscription->api_variant == msg_api_variant) {
+                /* trusted request, move the arguments as received */
+                req->request->rpc_req->input = msg->request->rpc_req->input;
+                req->request->rpc_req->n_input = msg->request->rpc_req->n_input;
+                req->request->rpc_req->input_tree = msg->request->rpc_req->input_tree;
+                req->request->rpc_req->n_input_tree = msg->request->rpc_req->n_input_tree;
+                msg->request->rpc_req->input = NULL;
+                msg->request->rpc_req->n_input = 0;
+                msg->request->rpc_req->input_tree = NULL;
+                msg->request->rpc_req->n_input_tree = 0;
+            } else {
+                if (!validated) {
+                    /* trusted request, but the subscriber needs the arguments in the other API variant */
+                    rc = rp_rpc_args_validate(rp_ctx, session, sr_mem, xpath, action, true, msg_api_variant,
+                            msg->request->rpc_req->input, msg->request->rpc_req->n_input,
+                            msg->request->rpc_req->input_tree, msg->request->rpc_req->n_input_tree,
+                            &with_def, &with_def_cnt, &with_def_tree, &with_def_tree_cnt);
+                    if (SR_ERR_OK != rc) {
+                        goto finalize;
+                    }
+                    validated = true;
+                }
+                switch (subscription->api_variant) {
+                    case SR_API_VALUES:
+                        rc = sr_values_sr_to_gpb(with_def, with_def_cnt, &req->request->rpc_req->input,
+                                                 &req->request->rpc_req->n_input);
+                        break;
+                    case SR_API_TREES:
+                        rc = sr_trees_sr_to_gpb(with_def_tree, with_def_tree_cnt, &req->request->rpc_req->input_tree,
+                                                &req->request->rpc_req->n_input_tree);
+                        break;
+                }
+                CHECK_RC_LOG_GOTO(rc, finalize, "Failed to duplicate %s request (%s) input arguments.", op_name,
+                        msg->request->rpc_req->xpath);
             }
-            CHECK_RC_LOG_GOTO(rc, finalize, "Failed to duplicate %s request (%s) input arguments.", op_name,
-                    msg->request->rpc_req->xpath);
             /* subscription details */
             sr_mem_edit_string(sr_mem, &req->request->rpc_req->subscriber_address, subscription->dst_address);
             CHECK_NULL_NOMEM_GOTO(req->request->rpc_req->subscriber_address, rc, finalize);
@@ -2285,11 +2499,6 @@ finalize:
     free(error_msg);
     free(nacm_rule);
     free(nacm_rule_info);
-    if (SR_API_VALUES == msg_api_variant) {
-        sr_free_values(input, input_cnt);
-    } else {
-        sr_free_trees(input_tree, input_cnt);
-    }
     sr_free_values(with_def, with_def_cnt);
     sr_free_trees(with_def_tree, with_def_tree_cnt);
 
@@ -2332,46 +2541,78 @@ finalize:
 }
 
 /**
- * @brief Checks if the received xpath was requested and find corresponding schema node
+ * @brief Compares two schema node pointers (used to sort and search the requested schema nodes).
+ */
+static int
+rp_data_provide_sch_node_cmp(const void *a, const void *b)
+{
+    const struct lys_node *node_a = *(const struct lys_node **) a;
+    const struct lys_node *node_b = *(const struct lys_node **) b;
+
+    if (node_a == node_b) {
+        return 0;
+    }
+    return (node_a < node_b) ? -1 : 1;
+}
+
+/**
+ * @brief Checks if the received xpaths were requested and find corresponding schema nodes
  */
 static int
-rp_data_provide_resp_validate (rp_ctx_t *rp_ctx, rp_session_t *session, const char *xpath, sr_val_t *values, size_t values_cnt, struct lys_node **sch_node)
+rp_data_provide_resp_validate (rp_ctx_t *rp_ctx, rp_session_t *session, char **xpaths, size_t xpath_cnt,
+        sr_val_t *values, size_t values_cnt, struct lys_node **sch_nodes)
 {
-    CHECK_NULL_ARG3(rp_ctx, session, sch_node);
+    CHECK_NULL_ARG4(rp_ctx, session, xpaths, sch_nodes);
     if (values_cnt > 0) {
         CHECK_NULL_ARG(values);
     }
     int rc = SR_ERR_OK;
     bool found = false;
     dm_schema_info_t *si = NULL;
-    struct lys_node *value_sch_node = NULL;
+    struct lys_node *value_sch_node = NULL, *iter = NULL;
+    struct lys_node **sorted_nodes = NULL;
+    size_t sorted_cnt = 0;
+    char *xp = NULL;
 
     rc = dm_get_module_and_lock(rp_ctx->dm_ctx, session->module_name, &si);
     CHECK_RC_MSG_RETURN(rc, "Get schema info failed");
 
-    /* verify that provided xpath was requested */
-    for (size_t i = 0; i < session->state_data_ctx.requested_xpaths->count; i++) {
-        char *xp = (char *) session->state_data_ctx.requested_xpaths->data[i];
-        if (0 == strcmp(xp, xpath)) {
-            found = true;
-            *sch_node = sr_find_schema_node(si->module->data, xp, 0);
-            if (NULL == *sch_node) {
-                SR_LOG_ERR("Schema node not found for %s", xp);
-                rc = SR_ERR_INVAL_ARG;
-                goto unlock;
-            }
-            free(xp);
-            sr_list_rm_at(session->state_data_ctx.requested_xpaths, i);
-            break;
+    /* verify that provided xpaths were requested */
+    for (size_t x = 0; x < xpath_cnt; x++) {
+        xp = NULL;
+        if (NULL != session->state_data_ctx.requested_xpaths) {
+            xp = sr_btree_search(session->state_data_ctx.requested_xpaths, xpaths[x]);
         }
+        if (NULL == xp) {
+            SR_LOG_ERR("Data provider sent data for unexpected xpath %s", xpaths[x]);
+            rc = SR_ERR_INVAL_ARG;
+            goto unlock;
+        }
+        sch_nodes[x] = sr_find_schema_node(si->module->data, xp, 0);
+        if (NULL == sch_nodes[x]) {
+            SR_LOG_ERR("Schema node not found for %s", xp);
+            rc = SR_ERR_INVAL_ARG;
+            goto unlock;
+        }
+        sr_btree_delete(session->state_data_ctx.requested_xpaths, xp);
     }
-    if (!found) {
-        SR_LOG_ERR("Data provider sent data for unexpected xpath %s", xpath);
-        rc = SR_ERR_INVAL_ARG;
+
+    if (0 == values_cnt) {
         goto unlock;
     }
 
-    /* test that all values are under requested xpath */
+    /* distinct requested schema nodes, sorted for lookup */
+    sorted_nodes = calloc(xpath_cnt, sizeof(*sorted_nodes));
+    CHECK_NULL_NOMEM_GOTO(sorted_nodes, rc, unlock);
+    memcpy(sorted_nodes, sch_nodes, xpath_cnt * sizeof(*sorted_nodes));
+    qsort(sorted_nodes, xpath_cnt, sizeof(*sorted_nodes), rp_data_provide_sch_node_cmp);
+    for (size_t x = 0; x < xpath_cnt; x++) {
+        if (0 == sorted_cnt || sorted_nodes[sorted_cnt - 1] != sorted_nodes[x]) {
+            sorted_nodes[sorted_cnt++] = sorted_nodes[x];
+        }
+    }
+
+    /* test that all values are under one of the requested xpaths */
     for (size_t i = 0; i < values_cnt; i++) {
         value_sch_node = sr_find_schema_node(si->module->data, values[i].xpath, 0);
         if (NULL == value_sch_node) {
@@ -2381,7 +2622,12 @@ rp_data_provide_resp_validate (rp_ctx_t *rp_ctx, rp_session_t *session, const ch
             goto unlock;
 
         }
-        if (false == rp_dt_depth_under_subtree(*sch_node, value_sch_node, NULL)) {
+        found = false;
+        for (iter = value_sch_node; NULL != iter && !found; iter = lys_parent(iter)) {
+            found = (NULL != bsearch(&iter, sorted_nodes, sorted_cnt, sizeof(*sorted_nodes),
+                    rp_data_provide_sch_node_cmp));
+        }
+        if (!found) {
             SR_LOG_ERR("Unexpected value with xpath %s received from provider", values[i].xpath);
             rc = SR_ERR_INVAL_ARG;
             goto unlock;
@@ -2389,115 +2635,504 @@ rp_data_provide_resp_validate (rp_ctx_t *rp_ctx, rp_session_t *session, const ch
     }
 
 unlock:
-    pthread_rwlock_unlock(&si->model_lock);
+    SR_RWLOCK_UNLOCK(&si->model_lock);
+    free(sorted_nodes);
     return rc;
 }
 
 /**
- * @brief Generate requests for nested data
+ * @brief Compares two xpaths stored in a list (used to remove duplicates from a batched request).
+ */
+static int
+rp_data_provide_xpath_cmp(const void *a, const void *b)
+{
+    return strcmp(*(const char **) a, *(const char **) b);
+}
+
+/**
+ * @brief Removes duplicate xpaths from the list of xpaths to be requested.
+ */
+static void
+rp_data_provide_dedup_xpaths(sr_list_t *xpaths)
+{
+    size_t cnt = 0;
+
+    qsort(xpaths->data, xpaths->count, sizeof(*xpaths->data), rp_data_provide_xpath_cmp);
+    for (size_t i = 0; i < xpaths->count; i++) {
+        if (0 != cnt && 0 == strcmp(xpaths->data[cnt - 1], xpaths->data[i])) {
+            free(xpaths->data[i]);
+        } else {
+            xpaths->data[cnt++] = xpaths->data[i];
+        }
+    }
+    xpaths->count = cnt;
+}
+
+/**
+ * @brief Generate requests for nested data of the provided nodes. All requests addressed
+ * to the same data provider subscription are sent in one batched request. If the provider
+ * sent whole subtrees, nested data covered by the same subscription are not requested.
+ * Instances of a list are expanded only once, regardless of the number of its xpaths in the response.
  */
 static int
-rp_data_provide_request_nested(rp_ctx_t *rp_ctx, rp_session_t *session, const char *xpath, struct lys_node *sch_node)
+rp_data_provide_request_nested(rp_ctx_t *rp_ctx, rp_session_t *session, char **parent_xpaths,
+        struct lys_node **sch_nodes, size_t parent_cnt, bool whole_subtrees)
 {
     int rc = SR_ERR_OK;
     struct lys_node *iter = NULL;
-    size_t subs_index = 0;
+    size_t subs_index = 0, subs_cnt = 0, parent_subs_index = 0;
     char **xpaths = NULL;
     size_t xp_count = 0;
     char *request_xp = NULL;
+    sr_list_t **batches = NULL;
+    struct lys_node **list_nodes = NULL, **found = NULL;
+    bool *list_expanded = NULL;
+    size_t node_cnt = 0, list_cnt = 0;
 
-    /* prepare xpaths where nested data will be requested */
-    if (LYS_LIST == sch_node->nodetype) {
-        rc = rp_dt_create_instance_xps(session, sch_node, &xpaths, &xp_count);
-        CHECK_RC_MSG_RETURN(rc, "Failed to create xpaths for instances of sch node");
-    } else {
-        xpaths = calloc(1, sizeof(*xpaths));
-        CHECK_NULL_NOMEM_GOTO(xpaths, rc, cleanup);
+    subs_cnt = session->state_data_ctx.subscription_nodes->count;
+    if (0 == subs_cnt || 0 == parent_cnt) {
+        return SR_ERR_OK;
+    }
 
-        xpaths[0] = strdup(xpath);
-        CHECK_NULL_NOMEM_GOTO(xpaths[0], rc, cleanup);
-        xp_count = 1;
+    /* xpaths to be requested, grouped by the subscription */
+    batches = calloc(subs_cnt, sizeof(*batches));
+    CHECK_NULL_NOMEM_RETURN(batches);
+
+    /* distinct list nodes, all their instances are expanded at once */
+    list_nodes = calloc(parent_cnt, sizeof(*list_nodes));
+    CHECK_NULL_NOMEM_GOTO(list_nodes, rc, cleanup);
+    list_expanded = calloc(parent_cnt, sizeof(*list_expanded));
+    CHECK_NULL_NOMEM_GOTO(list_expanded, rc, cleanup);
+    for (size_t p = 0; p < parent_cnt; p++) {
+        if (LYS_LIST == sch_nodes[p]->nodetype) {
+            list_nodes[node_cnt++] = sch_nodes[p];
+        }
+    }
+    qsort(list_nodes, node_cnt, sizeof(*list_nodes), rp_data_provide_sch_node_cmp);
+    for (size_t i = 0; i < node_cnt; i++) {
+        if (0 == list_cnt || list_nodes[list_cnt - 1] != list_nodes[i]) {
+            list_nodes[list_cnt++] = list_nodes[i];
+        }
     }
 
-    /* loop through the node children */
-    LY_TREE_FOR(sch_node->child, iter) {
-        subs_index = session->state_data_ctx.subscription_nodes->count;
-        if ((LYS_LIST | LYS_CONTAINER) & iter->nodetype) {
-            /* find subscription where subsequent request will be addressed
-             * this must exists since the a parent node has been already requested
-             */
-            if (!rp_dt_find_subscription_covering_subtree(session, iter, &subs_index)) {
-                SR_LOG_ERR("Failed to find subscription for nested requests %s", xpath);
-                rc = SR_ERR_INTERNAL;
-                goto cleanup;
+    for (size_t p = 0; p < parent_cnt; p++) {
+        if (0 == ((LYS_CONTAINER | LYS_LIST) & sch_nodes[p]->nodetype)) {
+            continue;
+        }
+        if (LYS_LIST == sch_nodes[p]->nodetype) {
+            found = bsearch(&sch_nodes[p], list_nodes, list_cnt, sizeof(*list_nodes), rp_data_provide_sch_node_cmp);
+            if (NULL == found || list_expanded[found - list_nodes]) {
+                /* instances of the list under all parents have already been expanded */
+                continue;
             }
-        } else if (session->state_data_ctx.overlapping_leaf_subscription && ((LYS_LEAF | LYS_LEAFLIST) & iter->nodetype)) {
-            /* check if we have exact match for leaf or leaf-list node */
-            rp_dt_find_exact_match_subscription_for_node(session, iter, &subs_index);
+            list_expanded[found - list_nodes] = true;
+        }
+        parent_subs_index = subs_cnt;
+        if (whole_subtrees) {
+            rp_dt_find_subscription_covering_subtree(session, sch_nodes[p], &parent_subs_index);
         }
-        if (subs_index < session->state_data_ctx.subscription_nodes->count) {
-            for (size_t i = 0; i < xp_count; i++) {
-                size_t len = strlen(xpaths[i]) + strlen(iter->name) + 2 /* slash + zero byte */;
-                request_xp = calloc(len, sizeof(*request_xp));
-                CHECK_NULL_NOMEM_GOTO(request_xp, rc, cleanup);
 
-                snprintf(request_xp, len, "%s/%s", xpaths[i], iter->name);
+        /* prepare xpaths where nested data will be requested */
+        if (LYS_LIST == sch_nodes[p]->nodetype) {
+            rc = rp_dt_create_instance_xps(session, sch_nodes[p], &xpaths, &xp_count);
+            CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to create xpaths for instances of sch node");
+        } else {
+            xpaths = calloc(1, sizeof(*xpaths));
+            CHECK_NULL_NOMEM_GOTO(xpaths, rc, cleanup);
+
+            xpaths[0] = strdup(parent_xpaths[p]);
+            CHECK_NULL_NOMEM_GOTO(xpaths[0], rc, cleanup);
+            xp_count = 1;
+        }
 
-                rc = np_data_provider_request(rp_ctx->np_ctx, session->state_data_ctx.subscriptions->data[subs_index],
-                        session, request_xp);
-                SR_LOG_DBG("Sending request for nested state data: %s using subs index %zu", request_xp, subs_index);
+        /* loop through the node children */
+        LY_TREE_FOR(sch_nodes[p]->child, iter) {
+            subs_index = subs_cnt;
+            if ((LYS_LIST | LYS_CONTAINER) & iter->nodetype) {
+                /* find subscription where subsequent request will be addressed
+                 * this must exists since the a parent node has been already requested
+                 */
+                if (!rp_dt_find_subscription_covering_subtree(session, iter, &subs_index)) {
+                    SR_LOG_ERR("Failed to find subscription for nested requests %s", parent_xpaths[p]);
+                    rc = SR_ERR_INTERNAL;
+                    goto cleanup;
+                }
+            } else if (session->state_data_ctx.overlapping_leaf_subscription && ((LYS_LEAF | LYS_LEAFLIST) & iter->nodetype)) {
+                /* check if we have exact match for leaf or leaf-list node */
+                rp_dt_find_exact_match_subscription_for_node(session, iter, &subs_index);
+            }
+            if (whole_subtrees && subs_index == parent_subs_index) {
+                /* already provided within the subtree */
+                continue;
+            }
+            if (subs_index < subs_cnt) {
+                if (NULL == batches[subs_index]) {
+                    rc = sr_list_init(&batches[subs_index]);
+                    CHECK_RC_MSG_GOTO(rc, cleanup, "List init failed");
+                }
+                for (size_t i = 0; i < xp_count; i++) {
+                    size_t len = strlen(xpaths[i]) + strlen(iter->name) + 2 /* slash + zero byte */;
+                    request_xp = calloc(len, sizeof(*request_xp));
+                    CHECK_NULL_NOMEM_GOTO(request_xp, rc, cleanup);
 
-                session->dp_req_waiting += 1;
+                    snprintf(request_xp, len, "%s/%s", xpaths[i], iter->name);
 
-                rc = sr_list_add(session->state_data_ctx.requested_xpaths, request_xp);
-                CHECK_RC_MSG_GOTO(rc, cleanup, "List add failed");
-                request_xp = NULL;
+                    rc = sr_list_add(batches[subs_index], request_xp);
+                    CHECK_RC_MSG_GOTO(rc, cleanup, "List add failed");
+                    request_xp = NULL;
+                }
             }
         }
+
+        for (size_t i = 0; i < xp_count; i++) {
+            free(xpaths[i]);
+        }
+        free(xpaths);
+        xpaths = NULL;
+        xp_count = 0;
+    }
+
+    /* send one request per subscription */
+    for (size_t s = 0; s < subs_cnt; s++) {
+        if (NULL == batches[s] || 0 == batches[s]->count) {
+            continue;
+        }
+        rp_data_provide_dedup_xpaths(batches[s]);
+        SR_LOG_DBG("Requesting nested state data: %zu xpath(s) (%s, ...) using subs index %zu",
+                batches[s]->count, (char *) batches[s]->data[0], s);
+        rc = rp_dt_send_dp_requests(rp_ctx, session, s, batches[s]);
+        if (SR_ERR_OK != rc) {
+            SR_LOG_WRN("Request for nested operational data failed using subs index %zu", s);
+        }
     }
+
 cleanup:
     for (size_t i = 0; i < xp_count; i++) {
         free(xpaths[i]);
     }
     free(xpaths);
     free(request_xp);
+    for (size_t s = 0; s < subs_cnt; s++) {
+        sr_free_list_of_strings(batches[s]);
+    }
+    free(batches);
+    free(list_nodes);
+    free(list_expanded);
 
     return rc;
 }
 
 /**
- * @brief Processes an operational data provider response.
+ * @brief Looks up the data schema node of the given name and module among the children of the schema node.
  */
-static int
-rp_data_provide_resp_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
+static const struct lys_node *
+rp_data_provide_find_child_schema(const struct lys_node *parent, const struct lys_module *module, const char *name)
 {
-    sr_val_t *values = NULL;
-    size_t values_cnt = 0;
-    int rc = SR_ERR_OK;
+    const struct lys_node *sch_node = NULL;
 
-    CHECK_NULL_ARG5(rp_ctx, session, msg, msg->response, msg->response->data_provide_resp);
+    while (NULL != (sch_node = lys_getnext(sch_node, parent, NULL, 0))) {
+        if (lys_node_module(sch_node) == module && 0 == strcmp(sch_node->name, name)) {
+            return sch_node;
+        }
+    }
+    return NULL;
+}
 
-    /* copy values from GPB to sysrepo */
-    rc = sr_values_gpb_to_sr((sr_mem_ctx_t *)msg->_sysrepo_mem_ctx, msg->response->data_provide_resp->values,
-            msg->response->data_provide_resp->n_values, &values, &values_cnt);
-    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to transform gpb to sr_val_t");
+/**
+ * @brief Frees the node and all its following siblings.
+ */
+static void
+rp_data_provide_free_siblings_from(struct lyd_node *node)
+{
+    struct lyd_node *next = NULL;
 
-    MUTEX_LOCK_TIMED_CHECK_GOTO(&session->cur_req_mutex, rc, cleanup);
-    if (RP_REQ_WAITING_FOR_DATA != session->state || NULL == session->req
-            ||  msg->response->data_provide_resp->request_id != session->req->request->_id ) {
-        SR_LOG_ERR("State data arrived after timeout expiration or session id=%u is invalid "
-                "(msg=%" PRIu64 ", session->req=%" PRIu64 ").",
-                session->id, msg->response->data_provide_resp->request_id, session->req ? session->req->request->_id : 0);
-        goto error;
+    while (NULL != node) {
+        next = node->next;
+        lyd_free(node);
+        node = next;
     }
+}
 
-    char *xpath = msg->response->data_provide_resp->xpath;
-    struct lys_node *sch_node = NULL;
-
-    session->dp_req_waiting -= 1;
-    SR_LOG_DBG("Data provide response received, waiting for %zu more data providers.", session->dp_req_waiting);
+/**
+ * @brief Creates the children of the sysrepo tree under the data node. In case of an error,
+ * the nodes created under the data node are removed.
+ */
+static int
+rp_data_provide_tree_children_to_dt(struct ly_ctx *ly_ctx, const sr_node_t *tree, struct lyd_node *parent, bool skip_keys)
+{
+    const struct lys_module *module = NULL;
+    const struct lys_node *sch_node = NULL;
+    struct lyd_node *node = NULL, *first_created = NULL;
+    char *string_val = NULL;
+    int rc = SR_ERR_OK;
+
+    for (sr_node_t *child = tree->first_child; NULL != child; child = child->next) {
+        if (NULL != child->module_name) {
+            module = ly_ctx_get_module(ly_ctx, child->module_name, NULL);
+        } else {
+            module = lyd_node_module(parent);
+        }
+        if (NULL == module) {
+            SR_LOG_ERR("Failed to obtain module schema for node: %s.", child->name);
+            rc = SR_ERR_INVAL_ARG;
+            goto cleanup;
+        }
+
+        sch_node = rp_data_provide_find_child_schema(parent->schema, module, child->name);
+        if (NULL == sch_node) {
+            SR_LOG_ERR("Node '%s' received from provider doesn't correspond to any schema node.", child->name);
+            rc = SR_ERR_INVAL_ARG;
+            goto cleanup;
+        }
+        if (skip_keys && sr_is_key_node(sch_node)) {
+            /* keys have been created together with the list instance */
+            continue;
+        }
+
+        if ((LYS_CONTAINER | LYS_LIST) & sch_node->nodetype) {
+            node = lyd_new(parent, module, child->name);
+            if (NULL == node) {
+                SR_LOG_ERR("Unable to add node '%s': %s", child->name, ly_errmsg());
+                rc = SR_ERR_INVAL_ARG;
+                goto cleanup;
+            }
+            if (NULL == first_created) {
+                first_created = node;
+            }
+            rc = rp_data_provide_tree_children_to_dt(ly_ctx, child, node, false);
+            CHECK_RC_LOG_GOTO(rc, cleanup, "Failed to add children of node '%s'.", child->name);
+        } else if (!child->dflt) {
+            rc = sr_val_to_str_with_schema((sr_val_t *) child, sch_node, &string_val);
+            CHECK_RC_LOG_GOTO(rc, cleanup, "Unable to convert value of node '%s' to string.", child->name);
+            node = lyd_new_leaf(parent, module, child->name, string_val);
+            free(string_val);
+            if (NULL == node) {
+                SR_LOG_ERR("Unable to add leaf node '%s': %s", child->name, ly_errmsg());
+                rc = SR_ERR_INVAL_ARG;
+                goto cleanup;
+            }
+            if (NULL == first_created) {
+                first_created = node;
+            }
+        }
+    }
+
+cleanup:
+    if (SR_ERR_OK != rc) {
+        /* new children are appended after the existing ones */
+        rp_data_provide_free_siblings_from(first_created);
+    }
+    return rc;
+}
+
+/**
+ * @brief Merges the tree provided as an instance of the requested schema node into the data tree.
+ * For a list instance, the key values are taken from the tree to build the instance xpath.
+ * If the tree can not be merged, the nodes created for it are removed.
+ */
+static int
+rp_data_provide_tree_to_dt(dm_data_info_t *info, const char *xpath, struct lys_node *sch_node, const sr_node_t *tree)
+{
+    struct lys_node_list *list = NULL;
+    struct lyd_node *created = NULL, *node = NULL, *next = NULL, *iter = NULL;
+    struct ly_set *nodeset = NULL;
+    sr_node_t *key = NULL;
+    char *root_xpath = NULL, *key_val = NULL, *string_val = NULL, *tmp = NULL;
+    size_t len = 0;
+    int rc = SR_ERR_OK;
 
-    rc = rp_data_provide_resp_validate(rp_ctx, session, xpath, values, values_cnt, &sch_node);
+    if (NULL == tree->name || 0 != strcmp(tree->name, sch_node->name)) {
+        SR_LOG_ERR("Tree '%s' received from provider is not an instance of the requested node %s.",
+                NULL != tree->name ? tree->name : "", xpath);
+        return SR_ERR_INVAL_ARG;
+    }
+
+    root_xpath = strdup(xpath);
+    CHECK_NULL_NOMEM_RETURN(root_xpath);
+
+    /* append the key predicates for a list instance */
+    if (LYS_LIST == sch_node->nodetype) {
+        list = (struct lys_node_list *) sch_node;
+        for (size_t k = 0; k < list->keys_size; k++) {
+            for (key = tree->first_child; NULL != key; key = key->next) {
+                if (0 == strcmp(key->name, list->keys[k]->name)) {
+                    break;
+                }
+            }
+            if (NULL == key) {
+                SR_LOG_ERR("Key '%s' missing in the list instance provided for %s.", list->keys[k]->name, xpath);
+                rc = SR_ERR_INVAL_ARG;
+                goto cleanup;
+            }
+            rc = sr_val_to_str_with_schema((sr_val_t *) key, (struct lys_node *) list->keys[k], &key_val);
+            CHECK_RC_LOG_GOTO(rc, cleanup, "Unable to convert value of the key '%s' to string.", key->name);
+
+            len = strlen(root_xpath) + strlen(key->name) + strlen(key_val) + 6 /* [='']\0 */;
+            tmp = realloc(root_xpath, len);
+            CHECK_NULL_NOMEM_GOTO(tmp, rc, cleanup);
+            root_xpath = tmp;
+            snprintf(root_xpath + strlen(root_xpath), len - strlen(root_xpath), NULL == strchr(key_val, '\'') ?
+                    "[%s='%s']" : "[%s=\"%s\"]", key->name, key_val);
+            free(key_val);
+            key_val = NULL;
+        }
+    }
+
+    /* create the root node, it may already exist */
+    if ((LYS_LEAF | LYS_LEAFLIST) & sch_node->nodetype) {
+        if (tree->dflt) {
+            goto cleanup;
+        }
+        rc = sr_val_to_str_with_schema((sr_val_t *) tree, sch_node, &string_val);
+        CHECK_RC_LOG_GOTO(rc, cleanup, "Unable to convert value of node '%s' to string.", tree->name);
+    }
+    ly_errno = LY_SUCCESS;
+    created = dm_lyd_new_path(info, root_xpath, string_val, LYD_PATH_OPT_UPDATE);
+    if (LY_SUCCESS != ly_errno) {
+        SR_LOG_ERR("Failed to create node %s: %s", root_xpath, ly_errmsg());
+        rc = SR_ERR_INVAL_ARG;
+        goto cleanup;
+    }
+    if (NULL == tree->first_child) {
+        goto cleanup;
+    }
+
+    if (NULL != created) {
+        /* the first created node is the root node or its ancestor, only one instance of the node has been created */
+        LY_TREE_DFS_BEGIN(created, next, iter) {
+            if (iter->schema == sch_node) {
+                node = iter;
+                break;
+            }
+            LY_TREE_DFS_END(created, next, iter);
+        }
+    } else {
+        /* the root node already existed */
+        nodeset = lyd_find_xpath(info->node, root_xpath);
+        if (NULL != nodeset && 1 == nodeset->number) {
+            node = nodeset->set.d[0];
+        }
+        ly_set_free(nodeset);
+    }
+    if (NULL == node) {
+        SR_LOG_ERR("Failed to obtain node %s.", root_xpath);
+        rc = SR_ERR_INTERNAL;
+        goto cleanup;
+    }
+
+    rc = rp_data_provide_tree_children_to_dt(info->schema->ly_ctx, tree, node, LYS_LIST == sch_node->nodetype);
+
+cleanup:
+    if (SR_ERR_OK != rc && NULL != created) {
+        /* remove the partially built subtree */
+        if (info->node == created) {
+            info->node = created->next;
+        }
+        lyd_free(created);
+    }
+    free(root_xpath);
+    free(key_val);
+    free(string_val);
+    return rc;
+}
+
+/**
+ * @brief Loads the trees received from a data provider into the session data tree. The trees
+ * are expected to be instances of the nodes identified by the xpaths, tree_cnts denotes how many of
+ * the trees belong to each xpath.
+ */
+static int
+rp_data_provide_trees_load(rp_ctx_t *rp_ctx, rp_session_t *session, char **xpaths, struct lys_node **sch_nodes,
+        size_t xpath_cnt, const sr_node_t *trees, size_t tree_cnt, const uint32_t *tree_cnts, size_t n_tree_cnts)
+{
+    dm_data_info_t *info = NULL;
+    size_t t = 0, cnt = 0;
+    int rc = SR_ERR_OK;
+
+    if (n_tree_cnts != xpath_cnt) {
+        SR_LOG_ERR("Data provider sent tree counts of %zu xpaths, %zu expected.", n_tree_cnts, xpath_cnt);
+        return SR_ERR_INVAL_ARG;
+    }
+
+    rc = dm_get_data_info(rp_ctx->dm_ctx, session->dm_session, session->module_name, &info);
+    CHECK_RC_LOG_RETURN(rc, "Failed to get data info for module %s.", session->module_name);
+
+    for (size_t x = 0; x < xpath_cnt && t < tree_cnt; x++) {
+        cnt = tree_cnts[x];
+        if (0 == cnt) {
+            continue;
+        }
+        SR_LOG_DBG("Received %zu tree(s) from data provider for xpath '%s'.", cnt, xpaths[x]);
+        for (size_t i = 0; i < cnt && t < tree_cnt; i++, t++) {
+            rc = rp_data_provide_tree_to_dt(info, xpaths[x], sch_nodes[x], &trees[t]);
+            if (SR_ERR_OK != rc) {
+                SR_LOG_WRN("Failed to set operational data for xpath '%s'.", xpaths[x]);
+            }
+        }
+        info->modified = true;
+    }
+
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Processes an operational data provider response.
+ */
+static int
+rp_data_provide_resp_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
+{
+    Sr__DataProvideResp *dp_resp = NULL;
+    sr_val_t *values = NULL;
+    sr_node_t *trees = NULL;
+    size_t values_cnt = 0, tree_cnt = 0;
+    char **xpaths = NULL;
+    size_t xpath_cnt = 0;
+    struct lys_node **sch_nodes = NULL;
+    const np_subscription_t **subscriptions = NULL;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG5(rp_ctx, session, msg, msg->response, msg->response->data_provide_resp);
+    dp_resp = msg->response->data_provide_resp;
+
+    /* single or batched response */
+    if (dp_resp->n_xpaths > 0) {
+        xpaths = dp_resp->xpaths;
+        xpath_cnt = dp_resp->n_xpaths;
+    } else {
+        xpaths = &dp_resp->xpath;
+        xpath_cnt = 1;
+    }
+
+    sch_nodes = calloc(xpath_cnt, sizeof(*sch_nodes));
+    CHECK_NULL_NOMEM_RETURN(sch_nodes);
+
+    /* copy values from GPB to sysrepo */
+    rc = sr_values_gpb_to_sr((sr_mem_ctx_t *)msg->_sysrepo_mem_ctx, dp_resp->values, dp_resp->n_values, &values, &values_cnt);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to transform gpb to sr_val_t");
+    if (dp_resp->n_tree_cnts > 0) {
+        rc = sr_trees_gpb_to_sr((sr_mem_ctx_t *)msg->_sysrepo_mem_ctx, dp_resp->trees, dp_resp->n_trees, &trees, &tree_cnt);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to transform gpb to sr_node_t");
+    }
+
+    MUTEX_LOCK_TIMED_CHECK_GOTO(&session->cur_req_mutex, rc, cleanup);
+    if (RP_REQ_WAITING_FOR_DATA != session->state || NULL == session->req
+            ||  dp_resp->request_id != session->req->request->_id ) {
+        SR_LOG_ERR("State data arrived after timeout expiration or session id=%u is invalid "
+                "(msg=%" PRIu64 ", session->req=%" PRIu64 ").",
+                session->id, dp_resp->request_id, session->req ? session->req->request->_id : 0);
+        goto error;
+    }
+
+    if (!rp_dt_dp_response_received(rp_ctx, session, xpaths[0])) {
+        /* the request has been already given up */
+        goto error;
+    }
+
+    session->dp_req_waiting -= 1;
+    SR_LOG_DBG("Data provide response with %zu xpath(s) received, waiting for %zu more data providers.",
+            xpath_cnt, session->dp_req_waiting);
+
+    rc = rp_data_provide_resp_validate(rp_ctx, session, xpaths, xpath_cnt, values, values_cnt, sch_nodes);
     CHECK_RC_MSG_GOTO(rc, finish, "Data validation failed.");
 
     for (size_t i = 0; i < values_cnt; i++) {
@@ -2509,14 +3144,53 @@ rp_data_provide_resp_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *m
         }
     }
 
-    /* handle nested data */
-    if ((LYS_CONTAINER | LYS_LIST) & sch_node->nodetype) {
-        rc = rp_data_provide_request_nested(rp_ctx, session, xpath, sch_node);
+    /* the trees are merged into the data tree as whole subtrees */
+    if (dp_resp->n_tree_cnts > 0) {
+        rc = rp_data_provide_trees_load(rp_ctx, session, xpaths, sch_nodes, xpath_cnt, trees, tree_cnt,
+                dp_resp->tree_cnts, dp_resp->n_tree_cnts);
+        if (SR_ERR_OK != rc) {
+            SR_LOG_WRN("Failed to load operational data trees for xpath '%s'.", xpaths[0]);
+        }
+    }
+
+    for (size_t f = 0; f < dp_resp->n_failed; f++) {
+        if (dp_resp->failed[f] < xpath_cnt) {
+            SR_LOG_WRN("Data provider failed to provide data for xpath '%s'.", xpaths[dp_resp->failed[f]]);
+        }
+    }
+
+    /* cache the data if the data provider declared their validity period (values only) */
+    if (SR_ERR_OK == msg->response->result && 0 == dp_resp->n_tree_cnts) {
+        subscriptions = calloc(xpath_cnt, sizeof(*subscriptions));
+        if (NULL != subscriptions) {
+            for (size_t x = 0; x < xpath_cnt; x++) {
+                size_t subs_index = 0;
+                if (rp_dt_find_subscription_covering_subtree(session, sch_nodes[x], &subs_index)) {
+                    subscriptions[x] = session->state_data_ctx.subscriptions->data[subs_index];
+                }
+            }
+            for (size_t f = 0; f < dp_resp->n_failed; f++) {
+                if (dp_resp->failed[f] < xpath_cnt) {
+                    /* nothing to cache for a failed xpath */
+                    subscriptions[dp_resp->failed[f]] = NULL;
+                }
+            }
+            rc = rp_dp_cache_store(rp_ctx->dp_cache, subscriptions, xpaths, xpath_cnt, values, values_cnt);
+            free(subscriptions);
+        } else {
+            rc = SR_ERR_NOMEM;
+        }
         if (SR_ERR_OK != rc) {
-            SR_LOG_WRN("Requesting nested data for xpath %s was not successful", xpath);
+            SR_LOG_WRN("Failed to cache operational data for xpath '%s'.", xpaths[0]);
         }
     }
 
+    /* handle nested data */
+    rc = rp_data_provide_request_nested(rp_ctx, session, xpaths, sch_nodes, xpath_cnt, dp_resp->n_tree_cnts > 0);
+    if (SR_ERR_OK != rc) {
+        SR_LOG_WRN("Requesting nested data for xpath %s was not successful", xpaths[0]);
+    }
+
 finish:
     if (0 == session->dp_req_waiting) {
         //TODO validate data
@@ -2535,23 +3209,26 @@ error:
 
 cleanup:
     sr_free_values(values, values_cnt);
+    sr_free_trees(trees, tree_cnt);
+    free(sch_nodes);
 
     return rc;
 }
 
 /**
- * @brief Processes a RPC/Action response.
+ * @brief Processes a RPC/Action response. Responses of trusted subscribers to the requests of trusted sessions are not
+ * validated, their output arguments are forwarded as received if they are in the API variant of the originator.
  */
 static int
-rp_rpc_resp_process(const rp_ctx_t *rp_ctx, const rp_session_t *session, Sr__Msg *msg)
+rp_rpc_resp_process(const rp_ctx_t *rp_ctx, const rp_session_t *session, Sr__Msg *msg, bool trusted)
 {
     sr_api_variant_t msg_api_variant = SR_API_VALUES;
-    sr_val_t *output = NULL, *with_def = NULL;
-    sr_node_t *output_tree = NULL, *with_def_tree = NULL;
-    size_t output_cnt = 0, with_def_cnt = 0, with_def_tree_cnt = 0;
+    sr_val_t *with_def = NULL;
+    sr_node_t *with_def_tree = NULL;
+    size_t with_def_cnt = 0, with_def_tree_cnt = 0;
     Sr__Msg *resp = NULL;
     sr_mem_ctx_t *sr_mem = NULL;
-    bool action = false;
+    bool action = false, forward = false;
     int rc = SR_ERR_OK;
 
     CHECK_NULL_ARG_NORET5(rc, rp_ctx, session, msg, msg->response, msg->response->rpc_resp);
@@ -2567,33 +3244,18 @@ rp_rpc_resp_process(const rp_ctx_t *rp_ctx, const rp_session_t *session, Sr__Msg
     /* reuse memory context from msg for resp */
     sr_mem = (sr_mem_ctx_t *)msg->_sysrepo_mem_ctx;
 
-    /* validate the RPC/Action response */
-    if (msg->response->rpc_resp->n_output) {
-        rc = sr_values_gpb_to_sr(sr_mem, msg->response->rpc_resp->output,
-                                 msg->response->rpc_resp->n_output, &output, &output_cnt);
-    } else if (msg->response->rpc_resp->n_output_tree) {
+    /* validate the RPC/Action response (unless both the responder and the originator are trusted and the originator
+     * uses the same API variant) */
+    if (0 == msg->response->rpc_resp->n_output && msg->response->rpc_resp->n_output_tree) {
         msg_api_variant = SR_API_TREES;
-        rc = sr_trees_gpb_to_sr(sr_mem, msg->response->rpc_resp->output_tree,
-                                 msg->response->rpc_resp->n_output_tree, &output_tree, &output_cnt);
     }
-    if (SR_ERR_OK == rc) {
-        if (SR_API_VALUES == msg_api_variant) {
-            if (action) {
-                rc = dm_validate_action(rp_ctx->dm_ctx, session->dm_session, msg->response->rpc_resp->xpath,
-                        output, output_cnt, false, sr_mem, &with_def, &with_def_cnt, &with_def_tree, &with_def_tree_cnt);
-            } else {
-                rc = dm_validate_rpc(rp_ctx->dm_ctx, session->dm_session, msg->response->rpc_resp->xpath,
-                        output, output_cnt, false, sr_mem, &with_def, &with_def_cnt, &with_def_tree, &with_def_tree_cnt);
-            }
-        } else {
-            if (action) {
-                rc = dm_validate_action_tree(rp_ctx->dm_ctx, session->dm_session, msg->response->rpc_resp->xpath,
-                        output_tree, output_cnt, false, sr_mem, &with_def, &with_def_cnt, &with_def_tree, &with_def_tree_cnt);
-            } else {
-                rc = dm_validate_rpc_tree(rp_ctx->dm_ctx, session->dm_session, msg->response->rpc_resp->xpath,
-                        output_tree, output_cnt, false, sr_mem, &with_def, &with_def_cnt, &with_def_tree, &with_def_tree_cnt);
-            }
-        }
+    forward = trusted && (session->options & SR_SESS_TRUSTED) &&
+            (msg_api_variant == sr_api_variant_gpb_to_sr(msg->response->rpc_resp->orig_api_variant));
+    if (!forward) {
+        rc = rp_rpc_args_validate(rp_ctx, session, sr_mem, msg->response->rpc_resp->xpath, action, false,
+                msg_api_variant, msg->response->rpc_resp->output, msg->response->rpc_resp->n_output,
+                msg->response->rpc_resp->output_tree, msg->response->rpc_resp->n_output_tree,
+                &with_def, &with_def_cnt, &with_def_tree, &with_def_tree_cnt);
     }
 
     /* duplicate msg into resp with the new output values */
@@ -2611,7 +3273,17 @@ rp_rpc_resp_process(const rp_ctx_t *rp_ctx, const rp_session_t *session, Sr__Msg
         resp->response->rpc_resp->orig_api_variant = msg->response->rpc_resp->orig_api_variant;
         resp->response->result = msg->response->result;
     }
-    if (SR_ERR_OK == rc) {
+    if (SR_ERR_OK == rc && forward) {
+        /* trusted response, move the output arguments as received */
+        resp->response->rpc_resp->output = msg->response->rpc_resp->output;
+        resp->response->rpc_resp->n_output = msg->response->rpc_resp->n_output;
+        resp->response->rpc_resp->output_tree = msg->response->rpc_resp->output_tree;
+        resp->response->rpc_resp->n_output_tree = msg->response->rpc_resp->n_output_tree;
+        msg->response->rpc_resp->output = NULL;
+        msg->response->rpc_resp->n_output = 0;
+        msg->response->rpc_resp->output_tree = NULL;
+        msg->response->rpc_resp->n_output_tree = 0;
+    } else if (SR_ERR_OK == rc) {
         if (SR_API_VALUES == sr_api_variant_gpb_to_sr(msg->response->rpc_resp->orig_api_variant)) {
             rc = sr_values_sr_to_gpb(with_def, with_def_cnt, &resp->response->rpc_resp->output,
                     &resp->response->rpc_resp->n_output);
@@ -2620,11 +3292,6 @@ rp_rpc_resp_process(const rp_ctx_t *rp_ctx, const rp_session_t *session, Sr__Msg
                     &resp->response->rpc_resp->n_output_tree);
         }
     }
-    if (SR_API_VALUES == msg_api_variant) {
-        sr_free_values(output, output_cnt);
-    } else {
-        sr_free_trees(output_tree, output_cnt);
-    }
     sr_free_values(with_def, with_def_cnt);
     sr_free_trees(with_def_tree, with_def_tree_cnt);
 
@@ -2702,16 +3369,235 @@ rp_oper_data_timeout_req_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Ms
     MUTEX_LOCK_TIMED_CHECK_RETURN(&session->cur_req_mutex);
     if (RP_REQ_WAITING_FOR_DATA == session->state &&
         session->req && session->req->request->_id == msg->internal_request->oper_data_timeout_req->request_id) {
-        SR_LOG_DBG("Time out expired for operational data to be loaded. Request (id=%" PRIu64 ") processing continue, "
-                "session id = %u", session->req->request->_id, session->id);
-        rp_msg_process(rp_ctx, session, session->req);
-        session->state = RP_REQ_TIMED_OUT;
+        if (msg->internal_request->oper_data_timeout_req->provider_timeout) {
+            /* give up the data providers that have not answered in time, continue with the data received so far */
+            session->dp_req_waiting -= rp_dt_dp_requests_timeout(rp_ctx, session, false);
+            if (0 == session->dp_req_waiting) {
+                SR_LOG_DBG("No more data providers to wait for, session id = %u, re-enqueue the request id = %" PRIu64,
+                        session->id, session->req->request->_id);
+                rp_dt_free_state_data_ctx_content(&session->state_data_ctx);
+                session->state = RP_REQ_DATA_LOADED;
+                rp_msg_process(rp_ctx, session, session->req);
+                session->req = NULL;
+            }
+        } else {
+            SR_LOG_DBG("Time out expired for operational data to be loaded. Request (id=%" PRIu64 ") processing continue, "
+                    "session id = %u", session->req->request->_id, session->id);
+            rp_dt_dp_requests_timeout(rp_ctx, session, true);
+            rp_msg_process(rp_ctx, session, session->req);
+            session->state = RP_REQ_TIMED_OUT;
+        }
     }
     pthread_mutex_unlock(&session->cur_req_mutex);
 
     return rc;
 }
 
+/**
+ * @brief Sets an unsigned integer leaf of internally provided state data.
+ */
+static int
+rp_internal_state_data_set_uint(rp_ctx_t *rp_ctx, rp_session_t *session, sr_type_t type, uint64_t value,
+        const char *xpath_fmt, ...)
+{
+    char xpath[PATH_MAX] = { 0, };
+    sr_val_t val = { 0, };
+    va_list va;
+    int rc = SR_ERR_OK;
+
+    va_start(va, xpath_fmt);
+    vsnprintf(xpath, PATH_MAX, xpath_fmt, va);
+    va_end(va);
+
+    val.type = type;
+    if (SR_UINT32_T == type) {
+        val.data.uint32_val = (uint32_t) value;
+    } else {
+        val.data.uint64_val = value;
+    }
+
+    rc = rp_dt_set_item(rp_ctx->dm_ctx, session->dm_session, xpath, SR_EDIT_DEFAULT, &val, NULL);
+    if (SR_ERR_OK != rc) {
+        SR_LOG_WRN("Failed to set operational data for xpath '%s'.", xpath);
+    }
+    return rc;
+}
+
+/**
+ * @brief Fills the latency statistics into the list of sysrepo-monitoring module keyed by xpath.
+ */
+static void
+rp_monitoring_latency_fill(rp_ctx_t *rp_ctx, rp_session_t *session, const char *list,
+        const rp_dp_latency_stats_t *latency, size_t latency_cnt)
+{
+    char bound[16] = { 0, }, quote = 0;
+
+    for (size_t i = 0; i < latency_cnt; i++) {
+        /* subscribed xpath may contain quotes of its own predicates */
+        quote = (NULL != strchr(latency[i].xpath, '\'')) ? '"' : '\'';
+        rp_internal_state_data_set_uint(rp_ctx, session, SR_UINT64_T, latency[i].request_cnt,
+                RP_MONITORING_XPATH "/%s[xpath=%c%s%c]/request-count", list, quote, latency[i].xpath, quote);
+        rp_internal_state_data_set_uint(rp_ctx, session, SR_UINT64_T, latency[i].timeout_cnt,
+                RP_MONITORING_XPATH "/%s[xpath=%c%s%c]/timeout-count", list, quote, latency[i].xpath, quote);
+        rp_internal_state_data_set_uint(rp_ctx, session, SR_UINT64_T, latency[i].latency_max,
+                RP_MONITORING_XPATH "/%s[xpath=%c%s%c]/max-latency", list, quote, latency[i].xpath, quote);
+        rp_internal_state_data_set_uint(rp_ctx, session, SR_UINT64_T,
+                latency[i].request_cnt > 0 ? latency[i].latency_total / latency[i].request_cnt : 0,
+                RP_MONITORING_XPATH "/%s[xpath=%c%s%c]/average-latency", list, quote, latency[i].xpath, quote);
+        for (size_t j = 0; j < RP_DP_LATENCY_BUCKET_CNT; j++) {
+            if (0 != rp_dp_latency_bucket_bound(j)) {
+                snprintf(bound, sizeof(bound), "%" PRIu32, rp_dp_latency_bucket_bound(j));
+            } else {
+                strcpy(bound, "inf");
+            }
+            rp_internal_state_data_set_uint(rp_ctx, session, SR_UINT64_T, latency[i].buckets[j],
+                    RP_MONITORING_XPATH "/%s[xpath=%c%s%c]/latency-bucket[upper-bound='%s']/count",
+                    list, quote, latency[i].xpath, quote, bound);
+        }
+    }
+}
+
+/**
+ * @brief Fills the performance statistics of sysrepo-monitoring module into the session's data tree.
+ */
+static int
+rp_monitoring_state_data_fill(rp_ctx_t *rp_ctx, rp_session_t *session)
+{
+    CHECK_NULL_ARG3(rp_ctx, rp_ctx->stats, session);
+    rp_stats_t stats = { 0, };
+    rp_dp_cache_stats_t dp_cache_stats = { 0, };
+    rp_dp_latency_stats_t *dp_latency = NULL;
+    size_t dp_latency_cnt = 0;
+    nacm_ctx_t *nacm_ctx = NULL;
+    sr_list_t *modules = NULL;
+    char *file_name = NULL;
+    struct stat sb = { 0, };
+    uint32_t queue_depth = 0, active_threads = 0;
+    uint32_t denied_ops = 0, denied_notifs = 0, denied_writes = 0;
+    uint32_t notif_files = 0;
+    uint64_t notif_size = 0, data_size = 0;
+    int rc = SR_ERR_OK;
+
+    /* request processor */
+    SR_MUTEX_LOCK(&rp_ctx->request_queue_mutex, "request_queue_mutex");
+    queue_depth = sr_cbuff_items_in_queue(rp_ctx->request_queue);
+    active_threads = rp_ctx->active_threads;
+    SR_MUTEX_UNLOCK(&rp_ctx->request_queue_mutex);
+
+    pthread_mutex_lock(&rp_ctx->stats->mutex);
+    stats = *rp_ctx->stats;
+    pthread_mutex_unlock(&rp_ctx->stats->mutex);
+
+    rp_internal_state_data_set_uint(rp_ctx, session, SR_UINT32_T, queue_depth,
+            RP_MONITORING_XPATH "/request-processor/request-queue-depth");
+    rp_internal_state_data_set_uint(rp_ctx, session, SR_UINT32_T, active_threads,
+            RP_MONITORING_XPATH "/request-processor/active-threads");
+    rp_internal_state_data_set_uint(rp_ctx, session, SR_UINT32_T, RP_THREAD_COUNT,
+            RP_MONITORING_XPATH "/request-processor/thread-count");
+    rp_internal_state_data_set_uint(rp_ctx, session, SR_UINT32_T, stats.session_cnt,
+            RP_MONITORING_XPATH "/request-processor/session-count");
+    for (size_t op = 0; op < RP_STATS_OPERATION_CNT; op++) {
+        if (stats.request_cnt[op] > 0) {
+            rp_internal_state_data_set_uint(rp_ctx, session, SR_UINT64_T, stats.request_cnt[op],
+                    RP_MONITORING_XPATH "/request-processor/request[operation='%s']/count",
+                    sr_gpb_operation_name((Sr__Operation) op));
+        }
+    }
+
+    /* commits */
+    rp_internal_state_data_set_uint(rp_ctx, session, SR_UINT64_T, stats.commit_cnt,
+            RP_MONITORING_XPATH "/commits/commit-count");
+    rp_internal_state_data_set_uint(rp_ctx, session, SR_UINT64_T, stats.commit_failed_cnt,
+            RP_MONITORING_XPATH "/commits/failed-commit-count");
+    rp_internal_state_data_set_uint(rp_ctx, session, SR_UINT64_T, stats.commit_latency_last,
+            RP_MONITORING_XPATH "/commits/last-latency");
+    rp_internal_state_data_set_uint(rp_ctx, session, SR_UINT64_T, stats.commit_latency_max,
+            RP_MONITORING_XPATH "/commits/max-latency");
+    rp_internal_state_data_set_uint(rp_ctx, session, SR_UINT64_T,
+            (stats.commit_cnt + stats.commit_failed_cnt) > 0 ?
+                    stats.commit_latency_total / (stats.commit_cnt + stats.commit_failed_cnt) : 0,
+            RP_MONITORING_XPATH "/commits/average-latency");
+
+    /* notification store */
+#ifdef ENABLE_NOTIF_STORE
+    if (SR_ERR_OK != np_get_notif_store_size(rp_ctx->np_ctx, &notif_files, &notif_size)) {
+        SR_LOG_WRN_MSG("Failed to compute the size of the notification store.");
+    }
+#endif
+    rp_internal_state_data_set_uint(rp_ctx, session, SR_UINT32_T, notif_files,
+            RP_MONITORING_XPATH "/notification-store/file-count");
+    rp_internal_state_data_set_uint(rp_ctx, session, SR_UINT64_T, notif_size,
+            RP_MONITORING_XPATH "/notification-store/size");
+
+    /* memory */
+    rp_internal_state_data_set_uint(rp_ctx, session, SR_UINT64_T, sr_mem_get_peak_usage(),
+            RP_MONITORING_XPATH "/memory/peak-usage");
+
+    /* NACM */
+    rc = dm_get_nacm_ctx(rp_ctx->dm_ctx, &nacm_ctx);
+    if (SR_ERR_OK == rc && NULL != nacm_ctx) {
+        (void)nacm_get_stats(nacm_ctx, &denied_ops, &denied_notifs, &denied_writes);
+    }
+    rp_internal_state_data_set_uint(rp_ctx, session, SR_UINT32_T, denied_ops,
+            RP_MONITORING_XPATH "/nacm/denied-operations");
+    rp_internal_state_data_set_uint(rp_ctx, session, SR_UINT32_T, denied_writes,
+            RP_MONITORING_XPATH "/nacm/denied-data-writes");
+    rp_internal_state_data_set_uint(rp_ctx, session, SR_UINT32_T, denied_notifs,
+            RP_MONITORING_XPATH "/nacm/denied-notifications");
+
+    /* operational data provider cache */
+    rp_dp_cache_get_stats(rp_ctx->dp_cache, &dp_cache_stats);
+    rp_internal_state_data_set_uint(rp_ctx, session, SR_UINT64_T, dp_cache_stats.hits,
+            RP_MONITORING_XPATH "/dp-cache/hits");
+    rp_internal_state_data_set_uint(rp_ctx, session, SR_UINT64_T, dp_cache_stats.misses,
+            RP_MONITORING_XPATH "/dp-cache/misses");
+    rp_internal_state_data_set_uint(rp_ctx, session, SR_UINT32_T, dp_cache_stats.entries,
+            RP_MONITORING_XPATH "/dp-cache/entries");
+
+    /* latency of operational data providers */
+    if (SR_ERR_OK == rp_dp_latency_get_stats(rp_ctx->dp_latency, &dp_latency, &dp_latency_cnt)) {
+        rp_monitoring_latency_fill(rp_ctx, session, "data-provider", dp_latency, dp_latency_cnt);
+        rp_dp_latency_free_stats(dp_latency, dp_latency_cnt);
+    } else {
+        SR_LOG_WRN_MSG("Failed to retrieve the latency statistics of data providers.");
+    }
+    dp_latency = NULL;
+    dp_latency_cnt = 0;
+
+    /* latency of commit verifiers */
+    if (SR_ERR_OK == np_get_verifier_stats(rp_ctx->np_ctx, &dp_latency, &dp_latency_cnt)) {
+        rp_monitoring_latency_fill(rp_ctx, session, "verifier", dp_latency, dp_latency_cnt);
+        rp_dp_latency_free_stats(dp_latency, dp_latency_cnt);
+    } else {
+        SR_LOG_WRN_MSG("Failed to retrieve the latency statistics of commit verifiers.");
+    }
+
+    /* per-module data sizes */
+    rc = dm_get_all_modules(rp_ctx->dm_ctx, session->dm_session, false, &modules);
+    CHECK_RC_MSG_RETURN(rc, "Failed to retrieve the list of modules.");
+
+    for (size_t i = 0; i < modules->count; i++) {
+        const char *module_name = (const char *) modules->data[i];
+        for (sr_datastore_t ds = SR_DS_STARTUP; ds <= SR_DS_RUNNING; ds++) {
+            data_size = 0;
+            rc = sr_get_data_file_name(SR_DATA_SEARCH_DIR, module_name, ds, &file_name);
+            CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to get data file name.");
+            if (-1 != stat(file_name, &sb)) {
+                data_size = sb.st_size;
+            }
+            free(file_name);
+            file_name = NULL;
+            rp_internal_state_data_set_uint(rp_ctx, session, SR_UINT64_T, data_size,
+                    RP_MONITORING_XPATH "/module[name='%s']/%s-data-size", module_name,
+                    SR_DS_STARTUP == ds ? "startup" : "running");
+        }
+    }
+
+cleanup:
+    sr_list_cleanup(modules);
+    return rc;
+}
+
 /**
  * @brief Processes an internal state data request.
  */
@@ -2771,6 +3657,11 @@ rp_internal_state_data_req_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__
                 SR_LOG_WRN("Failed to set operational data for xpath '%s'.", xpath);
             }
         }
+    } else if (0 == strcmp(xpath, RP_MONITORING_XPATH)) {
+        rc = rp_monitoring_state_data_fill(rp_ctx, session);
+        if (SR_ERR_OK != rc) {
+            SR_LOG_WRN("Failed to set operational data for xpath '%s'.", xpath);
+        }
     } else {
         SR_LOG_WRN("Request for not supported internal state data %s received ", xpath);
     }
@@ -2791,22 +3682,6 @@ cleanup:
     return rc;
 }
 
-/**
- * @brief Processes a notification store cleanup internal request.
- */
-static int
-rp_notif_store_cleanup_req_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg * msg)
-{
-    CHECK_NULL_ARG(rp_ctx);
-
-    SR_LOG_DBG_MSG("Processing notif-store-cleanup request.");
-
-    np_notification_store_cleanup(rp_ctx->np_ctx, true);
-
-    return SR_ERR_OK;
-
-}
-
 /**
  * @brief Processes a delayed-msg internal request.
  */
@@ -2853,13 +3728,14 @@ rp_nacm_reload_req_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg * ms
 }
 
 /**
- * @brief Sends an event notification to specified notification subscriber.
+ * @brief Sends an event notification to specified notification subscriber. If a shared payload is provided,
+ * it is attached to the message instead of the values / trees (only for immediate delivery).
  */
 static int
 rp_event_notif_send(const rp_ctx_t *rp_ctx, const rp_session_t *session, Sr__EventNotifReq__NotifType type,
         const char *xpath, time_t timestamp, sr_api_variant_t api_variant, const sr_val_t *sr_values, size_t sr_values_cnt,
-        const sr_node_t *sr_trees, size_t sr_trees_cnt, const char *subscription_address, uint32_t subscription_id,
-        time_t delivery_time)
+        const sr_node_t *sr_trees, size_t sr_trees_cnt, sr_gpb_shared_payload_t *payload,
+        const char *subscription_address, uint32_t subscription_id, time_t delivery_time)
 {
     Sr__Msg *req = NULL, *internal_req = NULL;
     int rc = SR_ERR_OK;
@@ -2873,16 +3749,18 @@ rp_event_notif_send(const rp_ctx_t *rp_ctx, const rp_session_t *session, Sr__Eve
     CHECK_NULL_NOMEM_GOTO(req->request->event_notif_req->xpath, rc, cleanup);
     req->request->event_notif_req->timestamp = timestamp;
 
-    /* set values / trees */
-    switch (api_variant) {
-        case SR_API_VALUES:
-            rc = sr_values_sr_to_gpb(sr_values, sr_values_cnt, &req->request->event_notif_req->values,
-                    &req->request->event_notif_req->n_values);
-            break;
-        case SR_API_TREES:
-            rc = sr_trees_sr_to_gpb(sr_trees, sr_trees_cnt, &req->request->event_notif_req->trees,
-                    &req->request->event_notif_req->n_trees);
-            break;
+    /* set values / trees (unless encoded only once for all the subscribers) */
+    if (NULL == payload || 0 != delivery_time) {
+        switch (api_variant) {
+            case SR_API_VALUES:
+                rc = sr_values_sr_to_gpb(sr_values, sr_values_cnt, &req->request->event_notif_req->values,
+                        &req->request->event_notif_req->n_values);
+                break;
+            case SR_API_TREES:
+                rc = sr_trees_sr_to_gpb(sr_trees, sr_trees_cnt, &req->request->event_notif_req->trees,
+                        &req->request->event_notif_req->n_trees);
+                break;
+        }
     }
     CHECK_RC_LOG_GOTO(rc, cleanup, "Failed to duplicate event notification (%s) input data.", xpath);
 
@@ -2895,7 +3773,8 @@ rp_event_notif_send(const rp_ctx_t *rp_ctx, const rp_session_t *session, Sr__Eve
 
     if (0 == delivery_time) {
         /* send the notification immediately */
-        rc = cm_msg_send(rp_ctx->cm_ctx, req);
+        SR_PROBE3(notif__send, subscription_address, subscription_id, SR__SUBSCRIPTION_TYPE__EVENT_NOTIF_SUBS);
+        rc = cm_msg_send_shared(rp_ctx->cm_ctx, req, payload);
         req = NULL;
     } else {
         /* send the notification later */
@@ -2910,33 +3789,247 @@ rp_event_notif_send(const rp_ctx_t *rp_ctx, const rp_session_t *session, Sr__Eve
         }
     }
 
-cleanup:
-    if (NULL != req) {
-        sr_msg_free(req);
-        req = NULL;
+cleanup:
+    if (NULL != req) {
+        sr_msg_free(req);
+        req = NULL;
+    }
+
+    return rc;
+}
+
+/**
+ * @brief Checks that a notification matches a subcription.
+ * @return 0 if not, 1 if matches.
+ */
+static int
+rp_event_notif_match_subscr(const char *ntf_xpath, const char *subscr_xpath)
+{
+    /* specific subscription for this notification */
+    if (!strcmp(ntf_xpath, subscr_xpath)) {
+        return 1;
+    }
+
+    /* whole module subscription */
+    if (!strcmp(subscr_xpath + strlen(subscr_xpath) - 4, "*//.") && !strncmp(ntf_xpath, subscr_xpath, strlen(subscr_xpath) - 4)) {
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Event notification being processed - its validated data and the related contexts.
+ */
+typedef struct rp_event_notif_s {
+    Sr__EventNotifReq *req;             /**< Event notification request. */
+    char *module_name;                  /**< Name of the module the notification belongs to. */
+    sr_api_variant_t api_variant;       /**< API variant of the data in the request. */
+    sr_val_t *values;                   /**< Values of the notification as received. */
+    size_t values_cnt;                  /**< Number of values. */
+    sr_node_t *trees;                   /**< Trees of the notification as received. */
+    size_t tree_cnt;                    /**< Number of trees. */
+    sr_val_t *with_def;                 /**< Validated values including the default nodes. */
+    size_t with_def_cnt;                /**< Number of validated values. */
+    sr_node_t *with_def_tree;           /**< Validated trees including the default nodes. */
+    size_t with_def_tree_cnt;           /**< Number of validated trees. */
+    struct lyd_node *data_tree;         /**< Data tree of the notification. */
+    struct ly_ctx *ly_ctx;              /**< Libyang context of the data tree (if created for the notification). */
+    bool trusted;                       /**< Ephemeral notification of a trusted session, forwarded as received. */
+    bool validated;                     /**< TRUE once the notification has been parsed and validated. */
+    dm_session_t *dm_session;           /**< DM session used for the validation. */
+    sr_mem_ctx_t *sr_mem;               /**< Memory context of the request. */
+} rp_event_notif_t;
+
+/**
+ * @brief Parses and validates data of an event notification.
+ */
+static int
+rp_event_notif_validate(const rp_ctx_t *rp_ctx, rp_event_notif_t *notif)
+{
+    Sr__EventNotifReq *req = notif->req;
+    const char *xpath = req->xpath;
+    int rc = SR_ERR_OK;
+
+    /* parse input arguments */
+    if (SR_API_VALUES == notif->api_variant) {
+        rc = sr_values_gpb_to_sr(notif->sr_mem, req->values, req->n_values, &notif->values, &notif->values_cnt);
+    } else {
+        rc = sr_trees_gpb_to_sr(notif->sr_mem, req->trees, req->n_trees, &notif->trees, &notif->tree_cnt);
+    }
+    CHECK_RC_LOG_RETURN(rc, "Failed to parse event notification (%s) data trees from GPB message.", xpath);
+
+    /* validate event-notification request */
+    if (SR_API_VALUES == notif->api_variant) {
+        rc = dm_validate_event_notif(rp_ctx->dm_ctx, notif->dm_session, xpath, notif->values, notif->values_cnt, NULL,
+                &notif->with_def, &notif->with_def_cnt, &notif->with_def_tree, &notif->with_def_tree_cnt,
+                &notif->data_tree, &notif->ly_ctx);
+    } else {
+        rc = dm_validate_event_notif_tree(rp_ctx->dm_ctx, notif->dm_session, xpath, notif->trees, notif->tree_cnt, NULL,
+                &notif->with_def, &notif->with_def_cnt, &notif->with_def_tree, &notif->with_def_tree_cnt,
+                &notif->data_tree, &notif->ly_ctx);
+    }
+    CHECK_RC_LOG_RETURN(rc, "Validation of an event notification (%s) message failed.", xpath);
+
+    notif->validated = true;
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Parses, validates and authorizes an event notification request. Ephemeral notifications of trusted sessions
+ * are validated only against the schema (the xpath), their data are forwarded as received.
+ */
+static int
+rp_event_notif_prepare(const rp_ctx_t *rp_ctx, const rp_session_t *session, dm_session_t *dm_session,
+        sr_mem_ctx_t *sr_mem, Sr__EventNotifReq *req, rp_event_notif_t *notif)
+{
+    const char *xpath = req->xpath;
+    int rc = SR_ERR_OK;
+
+    notif->req = req;
+    notif->api_variant = (0 == req->n_values && req->n_trees) ? SR_API_TREES : SR_API_VALUES;
+    notif->dm_session = dm_session;
+    notif->sr_mem = sr_mem;
+    notif->trusted = (NULL != session) && (session->options & SR_SESS_TRUSTED) &&
+            (req->options & SR__EVENT_NOTIF_REQ__NOTIF_FLAGS__EPHEMERAL);
+
+    if (notif->trusted) {
+        rc = dm_validate_event_notif_xpath(rp_ctx->dm_ctx, dm_session, xpath);
+        CHECK_RC_LOG_RETURN(rc, "Validation of an event notification (%s) xpath failed.", xpath);
+    } else {
+        rc = rp_event_notif_validate(rp_ctx, notif);
+        if (SR_ERR_OK != rc) {
+            return rc;
+        }
+    }
+
+    /* get module name */
+    rc = sr_copy_first_ns(xpath, &notif->module_name);
+    CHECK_RC_LOG_RETURN(rc, "Failed to obtain module name for event notification request (%s).", xpath);
+
+    if (NULL != session) {
+        /* authorize (write permissions are required to deliver the event-notification) */
+        rc = ac_check_module_permissions(session->ac_session, notif->module_name, AC_OPER_READ_WRITE);
+        CHECK_RC_LOG_RETURN(rc, "Access control check failed for module name '%s'", notif->module_name);
+    }
+
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Frees all data of an event notification prepared by ::rp_event_notif_prepare.
+ */
+static void
+rp_event_notif_cleanup(rp_event_notif_t *notif)
+{
+    if (SR_API_VALUES == notif->api_variant) {
+        sr_free_values(notif->values, notif->values_cnt);
+    } else {
+        sr_free_trees(notif->trees, notif->tree_cnt);
+    }
+    sr_free_values(notif->with_def, notif->with_def_cnt);
+    sr_free_trees(notif->with_def_tree, notif->with_def_tree_cnt);
+    free(notif->module_name);
+    if (NULL != notif->data_tree) {
+        lyd_free_withsiblings(notif->data_tree);
+    }
+    if (NULL != notif->ly_ctx) {
+        ly_ctx_destroy(notif->ly_ctx, NULL);
+    }
+}
+
+#ifdef ENABLE_NOTIF_STORE
+/**
+ * @brief Returns true if the event notification is supposed to be stored in the notification store.
+ */
+static bool
+rp_event_notif_to_be_stored(const Sr__EventNotifReq *req)
+{
+#ifndef STORE_CONFIG_CHANGE_NOTIF
+    if (0 == strcmp(req->xpath, "/ietf-netconf-notifications:netconf-config-change")) {
+        return false;
     }
-
-    return rc;
+#endif /* STORE_CONFIG_CHANGE_NOTIF */
+    return !(req->options & SR__EVENT_NOTIF_REQ__NOTIF_FLAGS__EPHEMERAL);
 }
+#endif /* ENABLE_NOTIF_STORE */
 
 /**
- * @brief Checks that a notification matches a subcription.
- * @return 0 if not, 1 if matches.
+ * @brief Broadcasts a validated event notification to all matching subscribers.
  */
 static int
-rp_event_notif_match_subscr(const char *ntf_xpath, const char *subscr_xpath)
+rp_event_notif_broadcast(const rp_ctx_t *rp_ctx, const rp_session_t *session, rp_event_notif_t *notif,
+        sr_list_t *subscriptions_list, nacm_ctx_t *nacm_ctx, bool *sub_match)
 {
-    /* specific subscription for this notification */
-    if (!strcmp(ntf_xpath, subscr_xpath)) {
-        return 1;
+    const char *xpath = notif->req->xpath;
+    np_subscription_t *subscription = NULL;
+    sr_gpb_shared_payload_t *values_payload = NULL, *trees_payload = NULL, **payload = NULL;
+    nacm_action_t nacm_action = NACM_ACTION_PERMIT;
+    char *nacm_rule = NULL, *nacm_rule_info = NULL;
+    int rc = SR_ERR_OK;
+
+    if (NULL == subscriptions_list) {
+        return SR_ERR_OK;
     }
 
-    /* whole module subscription */
-    if (!strcmp(subscr_xpath + strlen(subscr_xpath) - 4, "*//.") && !strncmp(ntf_xpath, subscr_xpath, strlen(subscr_xpath) - 4)) {
-        return 1;
+    for (size_t i = 0; i < subscriptions_list->count; i++) {
+        subscription = subscriptions_list->data[i];
+        if (NULL != subscription->xpath && rp_event_notif_match_subscr(xpath, subscription->xpath)) {
+            /* duplicate msg into req with subscription details, values / trees are encoded only once
+             * for each API variant and the encoded payload is shared by all the subscribers
+             * @note we are not using memory context for the *req* message because with so many
+             * duplications it would be actually less efficient than normally.
+             */
+            *sub_match = true;
+
+            /* NACM access control */
+            if (NULL != nacm_ctx && subscription->enable_nacm) {
+                free(nacm_rule);
+                free(nacm_rule_info);
+                nacm_rule = NULL;
+                nacm_rule_info = NULL;
+                /* check if the user is authorized to receive the notification */
+                rc = nacm_check_event_notif(nacm_ctx, subscription->username, xpath, &nacm_action,
+                        &nacm_rule, &nacm_rule_info);
+                if (SR_ERR_OK != rc || NACM_ACTION_DENY == nacm_action) {
+                    nacm_report_delivery_blocked(subscription, xpath, rc, nacm_rule, nacm_rule_info);
+                    continue;
+                }
+            }
+
+            payload = (SR_API_TREES == subscription->api_variant) ? &trees_payload : &values_payload;
+            if (NULL == *payload && notif->trusted && subscription->api_variant == notif->api_variant) {
+                /* trusted notification, forward the data as received */
+                rc = sr_gpb_shared_payload_create_gpb(notif->api_variant, notif->req->values, notif->req->n_values,
+                        notif->req->trees, notif->req->n_trees, payload);
+                CHECK_RC_LOG_GOTO(rc, cleanup, "Failed to encode the notification '%s' data.", xpath);
+            } else if (NULL == *payload) {
+                if (!notif->validated) {
+                    /* trusted notification, but the subscriber needs the data in the other API variant */
+                    rc = rp_event_notif_validate(rp_ctx, notif);
+                    if (SR_ERR_OK != rc) {
+                        goto cleanup;
+                    }
+                }
+                rc = sr_gpb_shared_payload_create(subscription->api_variant, notif->with_def, notif->with_def_cnt,
+                        notif->with_def_tree, notif->with_def_tree_cnt, payload);
+                CHECK_RC_LOG_GOTO(rc, cleanup, "Failed to encode the notification '%s' data.", xpath);
+            }
+
+            rc = rp_event_notif_send(rp_ctx, session, notif->req->type, xpath, notif->req->timestamp,
+                    subscription->api_variant, notif->with_def, notif->with_def_cnt, notif->with_def_tree,
+                    notif->with_def_tree_cnt, *payload, subscription->dst_address, subscription->dst_id, 0);
+            CHECK_RC_LOG_GOTO(rc, cleanup, "Error by sending the notification '%s' to the subscriber '%s'.",
+                    subscription->xpath, subscription->dst_address);
+        }
     }
 
-    return 0;
+cleanup:
+    sr_gpb_shared_payload_release(values_payload);
+    sr_gpb_shared_payload_release(trees_payload);
+    free(nacm_rule);
+    free(nacm_rule_info);
+    return rc;
 }
 
 /**
@@ -2945,22 +4038,12 @@ rp_event_notif_match_subscr(const char *ntf_xpath, const char *subscr_xpath)
 static int
 rp_event_notif_req_process(const rp_ctx_t *rp_ctx, const rp_session_t *session, Sr__Msg *msg)
 {
-    const char *xpath = NULL;
-    char *module_name = NULL;
-    struct lyd_node *notif_data_tree = NULL;
-    struct ly_ctx *notif_ctx = NULL;
-    sr_api_variant_t msg_api_variant = SR_API_VALUES;
-    sr_val_t *values = NULL, *with_def = NULL;
-    sr_node_t *trees = NULL, *with_def_tree = NULL;
-    size_t values_cnt = 0, tree_cnt = 0, with_def_cnt = 0, with_def_tree_cnt = 0;
+    rp_event_notif_t notif = { 0, };
     sr_list_t *subscriptions_list = NULL;
-    np_subscription_t *subscription = NULL;
     bool sub_match = false;
     Sr__Msg *resp = NULL;
     sr_mem_ctx_t *sr_mem_msg = NULL;
     nacm_ctx_t *nacm_ctx = NULL;
-    nacm_action_t nacm_action = NACM_ACTION_PERMIT;
-    char *nacm_rule = NULL, *nacm_rule_info = NULL;
     dm_session_t *dm_session = NULL;
     int rc = SR_ERR_OK, rc_tmp = SR_ERR_OK;
 
@@ -2969,8 +4052,7 @@ rp_event_notif_req_process(const rp_ctx_t *rp_ctx, const rp_session_t *session,
         goto finalize;
     }
 
-    xpath = msg->request->event_notif_req->xpath;
-    SR_LOG_DBG("Processing event notification request (%s).", xpath);
+    SR_LOG_DBG("Processing event notification request (%s).", msg->request->event_notif_req->xpath);
 
     if (NULL != session) {
         dm_session = session->dm_session;
@@ -2979,110 +4061,35 @@ rp_event_notif_req_process(const rp_ctx_t *rp_ctx, const rp_session_t *session,
         CHECK_RC_MSG_GOTO(rc, finalize, "Failed to create temporary dm_session");
     }
 
-    /* parse input arguments */
+    /* parse, validate and authorize the notification */
     sr_mem_msg = (sr_mem_ctx_t *)msg->_sysrepo_mem_ctx;
-    if (msg->request->event_notif_req->n_values) {
-        rc = sr_values_gpb_to_sr(sr_mem_msg, msg->request->event_notif_req->values,
-                msg->request->event_notif_req->n_values, &values, &values_cnt);
-    } else if (msg->request->event_notif_req->n_trees) {
-        msg_api_variant = SR_API_TREES;
-        rc = sr_trees_gpb_to_sr(sr_mem_msg, msg->request->event_notif_req->trees,
-                msg->request->event_notif_req->n_trees, &trees, &tree_cnt);
-    }
-    CHECK_RC_LOG_GOTO(rc, finalize, "Failed to parse event notification (%s) data trees from GPB message.", xpath);
-
-    /* validate event-notification request */
-    if (SR_API_VALUES == msg_api_variant) {
-        rc = dm_validate_event_notif(rp_ctx->dm_ctx, dm_session, xpath, values, values_cnt, NULL,
-                &with_def, &with_def_cnt, &with_def_tree, &with_def_tree_cnt, &notif_data_tree, &notif_ctx);
-    } else {
-        rc = dm_validate_event_notif_tree(rp_ctx->dm_ctx, dm_session, xpath, trees, tree_cnt, NULL,
-                &with_def, &with_def_cnt, &with_def_tree, &with_def_tree_cnt, &notif_data_tree, &notif_ctx);
-    }
-    CHECK_RC_LOG_GOTO(rc, finalize, "Validation of an event notification (%s) message failed.", xpath);
-
-    /* get module name */
-    rc = sr_copy_first_ns(xpath, &module_name);
-    CHECK_RC_LOG_GOTO(rc, finalize, "Failed to obtain module name for event notification request (%s).", xpath);
-
-    if (NULL != session) {
-        /* authorize (write permissions are required to deliver the event-notification) */
-        rc = ac_check_module_permissions(session->ac_session, module_name, AC_OPER_READ_WRITE);
-        CHECK_RC_LOG_GOTO(rc, finalize, "Access control check failed for module name '%s'", module_name);
+    rc = rp_event_notif_prepare(rp_ctx, session, dm_session, sr_mem_msg, msg->request->event_notif_req, &notif);
+    if (SR_ERR_OK != rc) {
+        goto finalize;
     }
 
 #ifdef ENABLE_NOTIF_STORE
-#ifndef STORE_CONFIG_CHANGE_NOTIF
-    if (0 != strcmp(msg->request->event_notif_req->xpath, "/ietf-netconf-notifications:netconf-config-change")) {
-#endif /* STORE_CONFIG_CHANGE_NOTIF */
-    if (!(msg->request->event_notif_req->options & SR__EVENT_NOTIF_REQ__NOTIF_FLAGS__EPHEMERAL)) {
+    if (rp_event_notif_to_be_stored(notif.req)) {
         /* store the notification in the datastore */
-        rc = np_store_event_notification(rp_ctx->np_ctx, NULL != session ? session->user_credentials : NULL,
-                xpath, msg->request->event_notif_req->timestamp, notif_data_tree);
+        rc = np_store_event_notification(rp_ctx->np_ctx, notif.req->xpath, notif.req->timestamp, notif.data_tree);
         CHECK_RC_MSG_GOTO(rc, finalize, "Failed to save event notification");
     }
-#ifndef STORE_CONFIG_CHANGE_NOTIF
-    }
-#endif /* STORE_CONFIG_CHANGE_NOTIF */
 #endif /* ENABLE_NOTIF_STORE */
 
     /* get event-notification subscriptions */
-    rc = pm_get_subscriptions(rp_ctx->pm_ctx, (NULL != session) ? session->user_credentials : NULL, module_name,
+    rc = pm_get_subscriptions(rp_ctx->pm_ctx, (NULL != session) ? session->user_credentials : NULL, notif.module_name,
             SR__SUBSCRIPTION_TYPE__EVENT_NOTIF_SUBS, &subscriptions_list);
-    CHECK_RC_LOG_GOTO(rc, finalize, "Failed to get subscriptions for event notification request (%s).", xpath);
+    CHECK_RC_LOG_GOTO(rc, finalize, "Failed to get subscriptions for event notification request (%s).", notif.req->xpath);
 
     /* get NACM context */
     rc = dm_get_nacm_ctx(rp_ctx->dm_ctx, &nacm_ctx);
     CHECK_RC_MSG_GOTO(rc, finalize, "Failed to get NACM context");
 
     /* broadcast the notification to all subscribed processes */
-    if (NULL != subscriptions_list) {
-        for (size_t i = 0; i < subscriptions_list->count; i++) {
-            subscription = subscriptions_list->data[i];
-            if (NULL != subscription->xpath && rp_event_notif_match_subscr(msg->request->event_notif_req->xpath, subscription->xpath)) {
-                /* duplicate msg into req with values and subscription details
-                 * @note we are not using memory context for the *req* message because with so many
-                 * duplications it would be actually less efficient than normally.
-                 */
-                sub_match = true;
-
-                /* NACM access control */
-                if (NULL != nacm_ctx && subscription->enable_nacm) {
-                    free(nacm_rule);
-                    free(nacm_rule_info);
-                    nacm_rule = NULL;
-                    nacm_rule_info = NULL;
-                    /* check if the user is authorized to receive the notification */
-                    rc = nacm_check_event_notif(nacm_ctx, subscription->username, xpath, &nacm_action,
-                            &nacm_rule, &nacm_rule_info);
-                    if (SR_ERR_OK != rc || NACM_ACTION_DENY == nacm_action) {
-                        nacm_report_delivery_blocked(subscription, xpath, rc, nacm_rule, nacm_rule_info);
-                        continue;
-                    }
-                }
-
-                rc = rp_event_notif_send(rp_ctx, session, msg->request->event_notif_req->type,
-                        msg->request->event_notif_req->xpath, msg->request->event_notif_req->timestamp,
-                        subscription->api_variant, with_def, with_def_cnt, with_def_tree, with_def_tree_cnt,
-                        subscription->dst_address, subscription->dst_id, 0);
-                CHECK_RC_LOG_GOTO(rc, finalize, "Error by sending the notification '%s' to the subscriber '%s'.",
-                        subscription->xpath, subscription->dst_address);
-            }
-        }
-    }
+    rc = rp_event_notif_broadcast(rp_ctx, session, &notif, subscriptions_list, nacm_ctx, &sub_match);
 
 finalize:
     /* free all the allocated data */
-    if (SR_API_VALUES == msg_api_variant) {
-        sr_free_values(values, values_cnt);
-    } else {
-        sr_free_trees(trees, tree_cnt);
-    }
-    sr_free_values(with_def, with_def_cnt);
-    sr_free_trees(with_def_tree, with_def_tree_cnt);
-    free(module_name);
-    free(nacm_rule);
-    free(nacm_rule_info);
     np_subscriptions_list_cleanup(subscriptions_list);
 
     if (!sub_match && SR_ERR_OK == rc) {
@@ -3102,36 +4109,222 @@ finalize:
         SR_LOG_DBG("Internally generated event notification %s response not sent", msg->request->event_notif_req->xpath);
     }
 
+    rp_event_notif_cleanup(&notif);
     sr_msg_free(msg);
 
     if (NULL == session) {
         dm_session_stop(rp_ctx->dm_ctx, dm_session);
     }
-    if (NULL != notif_data_tree) {
-        lyd_free_withsiblings(notif_data_tree);
-    }
-    if (NULL != notif_ctx) {
-        ly_ctx_destroy(notif_ctx, NULL);
-    }
     return rc;
 }
 
 /**
- * @brief Processes an event notification replay request.
+ * @brief Processes a request carrying a batch of event notifications - all the notifications are validated first,
+ * then stored with a single notification store append and broadcast to their subscribers.
  */
 static int
-rp_event_notif_replay_req_process(const rp_ctx_t *rp_ctx, const rp_session_t *session, Sr__Msg *msg)
+rp_event_notif_batch_req_process(const rp_ctx_t *rp_ctx, const rp_session_t *session, Sr__Msg *msg)
 {
-    Sr__EventNotifReplayReq *replay_req = NULL;
+    Sr__EventNotifBatchReq *batch_req = NULL;
+    rp_event_notif_t *notifs = NULL;
+    size_t notif_cnt = 0;
+    sr_list_t *subscriptions_list = NULL;
+    const char *subscriptions_module = NULL;
+    bool sub_match = false;
     Sr__Msg *resp = NULL;
     sr_mem_ctx_t *sr_mem = NULL;
+    nacm_ctx_t *nacm_ctx = NULL;
+#ifdef ENABLE_NOTIF_STORE
+    const char **store_xpaths = NULL;
+    time_t *store_times = NULL;
+    struct lyd_node **store_trees = NULL;
+    size_t store_cnt = 0;
+#endif
+    int rc = SR_ERR_OK, oper_rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG5(rp_ctx, session, msg, msg->request, msg->request->event_notif_batch_req);
+
+    batch_req = msg->request->event_notif_batch_req;
+    SR_LOG_DBG("Processing event notification batch request (%zu notifications).", batch_req->n_notifications);
+
+    /* allocate the response */
+    rc = sr_mem_new(0, &sr_mem);
+    CHECK_RC_MSG_RETURN(rc, "Failed to create a new Sysrepo memory context.");
+    rc = sr_gpb_resp_alloc(sr_mem, SR__OPERATION__EVENT_NOTIF_BATCH, session->id, &resp);
+    if (SR_ERR_OK != rc) {
+        sr_mem_free(sr_mem);
+        SR_LOG_ERR_MSG("Allocation of event notification batch response failed.");
+        return SR_ERR_NOMEM;
+    }
+
+    if (0 == batch_req->n_notifications) {
+        goto cleanup;
+    }
+
+    notifs = calloc(batch_req->n_notifications, sizeof(*notifs));
+    CHECK_NULL_NOMEM_GOTO(notifs, oper_rc, cleanup);
+
+    /* parse, validate and authorize all the notifications, the batch is rejected as a whole */
+    for (notif_cnt = 0; notif_cnt < batch_req->n_notifications; notif_cnt++) {
+        oper_rc = rp_event_notif_prepare(rp_ctx, session, session->dm_session, (sr_mem_ctx_t *)msg->_sysrepo_mem_ctx,
+                batch_req->notifications[notif_cnt], &notifs[notif_cnt]);
+        if (SR_ERR_OK != oper_rc) {
+            notif_cnt++;
+            goto cleanup;
+        }
+    }
+
+#ifdef ENABLE_NOTIF_STORE
+    /* store the notifications in the datastore at once */
+    store_xpaths = calloc(notif_cnt, sizeof(*store_xpaths));
+    CHECK_NULL_NOMEM_GOTO(store_xpaths, oper_rc, cleanup);
+    store_times = calloc(notif_cnt, sizeof(*store_times));
+    CHECK_NULL_NOMEM_GOTO(store_times, oper_rc, cleanup);
+    store_trees = calloc(notif_cnt, sizeof(*store_trees));
+    CHECK_NULL_NOMEM_GOTO(store_trees, oper_rc, cleanup);
+    for (size_t i = 0; i < notif_cnt; i++) {
+        if (rp_event_notif_to_be_stored(notifs[i].req)) {
+            store_xpaths[store_cnt] = notifs[i].req->xpath;
+            store_times[store_cnt] = notifs[i].req->timestamp;
+            store_trees[store_cnt] = notifs[i].data_tree;
+            store_cnt++;
+        }
+    }
+    if (store_cnt > 0) {
+        oper_rc = np_store_event_notifications(rp_ctx->np_ctx, store_xpaths, store_times, store_trees, store_cnt);
+        CHECK_RC_MSG_GOTO(oper_rc, cleanup, "Failed to save event notifications");
+    }
+#endif /* ENABLE_NOTIF_STORE */
+
+    /* get NACM context */
+    oper_rc = dm_get_nacm_ctx(rp_ctx->dm_ctx, &nacm_ctx);
+    CHECK_RC_MSG_GOTO(oper_rc, cleanup, "Failed to get NACM context");
+
+    /* broadcast the notifications in the order they have been generated */
+    for (size_t i = 0; i < notif_cnt; i++) {
+        if (NULL == subscriptions_module || 0 != strcmp(subscriptions_module, notifs[i].module_name)) {
+            /* subscriptions are reused for consecutive notifications of the same module */
+            np_subscriptions_list_cleanup(subscriptions_list);
+            subscriptions_list = NULL;
+            subscriptions_module = notifs[i].module_name;
+            oper_rc = pm_get_subscriptions(rp_ctx->pm_ctx, session->user_credentials, subscriptions_module,
+                    SR__SUBSCRIPTION_TYPE__EVENT_NOTIF_SUBS, &subscriptions_list);
+            CHECK_RC_LOG_GOTO(oper_rc, cleanup, "Failed to get subscriptions for event notification request (%s).",
+                    notifs[i].req->xpath);
+        }
+        oper_rc = rp_event_notif_broadcast(rp_ctx, session, &notifs[i], subscriptions_list, nacm_ctx, &sub_match);
+        if (SR_ERR_OK != oper_rc) {
+            goto cleanup;
+        }
+    }
+
+    if (!sub_match) {
+        SR_LOG_DBG("No subscription found for delivery of the batch of %zu event notifications.", notif_cnt);
+    }
+
+cleanup:
+    np_subscriptions_list_cleanup(subscriptions_list);
+#ifdef ENABLE_NOTIF_STORE
+    free(store_xpaths);
+    free(store_times);
+    free(store_trees);
+#endif
+    for (size_t i = 0; i < notif_cnt; i++) {
+        rp_event_notif_cleanup(&notifs[i]);
+    }
+    free(notifs);
+
+    /* set response code */
+    resp->response->result = oper_rc;
+
+    /* send the response */
+    rc = cm_msg_send(rp_ctx->cm_ctx, resp);
+    return rc;
+}
+
+#ifdef ENABLE_NOTIF_STORE
+/**
+ * @brief Context of one step of an event notification replay.
+ */
+typedef struct rp_replay_ctx_s {
+    const rp_ctx_t *rp_ctx;                     /**< Request Processor context. */
+    const rp_session_t *session;                /**< Session that requested the replay. */
+    const Sr__EventNotifReplayReq *replay_req;  /**< Replay request. */
+} rp_replay_ctx_t;
+
+/**
+ * @brief Sends a notification loaded from the notification store to the replay subscriber.
+ */
+static int
+rp_event_notif_replay_cb(np_ev_notification_t *notification, void *private_ctx)
+{
+    rp_replay_ctx_t *replay_ctx = (rp_replay_ctx_t *) private_ctx;
+    const Sr__EventNotifReplayReq *replay_req = replay_ctx->replay_req;
     int rc = SR_ERR_OK;
 
-    CHECK_NULL_ARG5(rp_ctx, session, msg, msg->request, msg->request->event_notif_replay_req);
+    rc = rp_event_notif_send(replay_ctx->rp_ctx, replay_ctx->session, SR__EVENT_NOTIF_REQ__NOTIF_TYPE__REPLAY,
+            notification->xpath, notification->timestamp, sr_api_variant_gpb_to_sr(replay_req->api_variant),
+            notification->data.values, notification->data_cnt, notification->data.trees, notification->data_cnt, NULL,
+            replay_req->subscriber_address, replay_req->subscription_id, 0);
+    CHECK_RC_LOG_RETURN(rc, "Error by sending the replay of notification '%s' to the subscriber '%s'.",
+            notification->xpath, replay_req->subscriber_address);
 
-    SR_LOG_DBG_MSG("Processing event notification replay request.");
+    return SR_ERR_OK;
+}
 
-    replay_req = msg->request->event_notif_replay_req;
+/**
+ * @brief Enqueues an internal request to continue the replay at the position of the cursor.
+ */
+static int
+rp_event_notif_replay_enqueue(rp_ctx_t *rp_ctx, rp_session_t *session, const Sr__EventNotifReplayReq *replay_req,
+        time_t stop_time, const np_notif_store_cursor_t *cursor)
+{
+    Sr__Msg *msg = NULL;
+    Sr__NotifReplayStepReq *step_req = NULL;
+    int rc = SR_ERR_OK;
+
+    rc = sr_gpb_internal_req_alloc(NULL, SR__OPERATION__NOTIF_REPLAY_STEP, &msg);
+    CHECK_RC_MSG_RETURN(rc, "Failed to allocate the notification replay step request.");
+    msg->session_id = session->id;
+    step_req = msg->internal_request->notif_replay_step_req;
+
+    step_req->replay_req->xpath = strdup(replay_req->xpath);
+    CHECK_NULL_NOMEM_GOTO(step_req->replay_req->xpath, rc, cleanup);
+    step_req->replay_req->subscriber_address = strdup(replay_req->subscriber_address);
+    CHECK_NULL_NOMEM_GOTO(step_req->replay_req->subscriber_address, rc, cleanup);
+    step_req->replay_req->start_time = replay_req->start_time;
+    step_req->replay_req->stop_time = replay_req->stop_time;
+    step_req->replay_req->subscription_id = replay_req->subscription_id;
+    step_req->replay_req->api_variant = replay_req->api_variant;
+
+    step_req->stop_time = stop_time;
+    step_req->segment = cursor->segment;
+    step_req->sequence = cursor->sequence;
+
+    /* the message is released by rp_msg_process also in case of an error */
+    return rp_msg_process(rp_ctx, session, msg);
+
+cleanup:
+    sr_msg_free(msg);
+    return rc;
+}
+#endif
+
+/**
+ * @brief Performs one step of an event notification replay.
+ *
+ * Notifications are streamed from the notification store in steps of RP_NOTIF_REPLAY_STEP notifications.
+ * After each step an internal request to continue from the position where the replay stopped is enqueued,
+ * so that other requests are not blocked by a long replay and the Connection Manager can deliver
+ * the notifications sent so far. The response is sent after the last step.
+ */
+static int
+rp_event_notif_replay_continue(rp_ctx_t *rp_ctx, rp_session_t *session, const Sr__EventNotifReplayReq *replay_req,
+        time_t stop_time, np_notif_store_cursor_t *cursor)
+{
+    Sr__Msg *resp = NULL;
+    sr_mem_ctx_t *sr_mem = NULL;
+    int rc = SR_ERR_OK;
 
     /* allocate the response */
     rc = sr_mem_new(0, &sr_mem);
@@ -3144,48 +4337,36 @@ rp_event_notif_replay_req_process(const rp_ctx_t *rp_ctx, const rp_session_t *se
     }
 
 #ifdef ENABLE_NOTIF_STORE
-    sr_list_t *notif_list = NULL;
+    rp_replay_ctx_t replay_ctx = { rp_ctx, session, replay_req };
 
-    /* get matching notifications from the notification store */
+    /* stream matching notifications from the notification store to the subscriber */
     rc = np_get_event_notifications(rp_ctx->np_ctx, session, replay_req->xpath, replay_req->start_time,
-            replay_req->stop_time, sr_api_variant_gpb_to_sr(replay_req->api_variant), &notif_list);
+            stop_time, sr_api_variant_gpb_to_sr(replay_req->api_variant), cursor,
+            RP_NOTIF_REPLAY_STEP, rp_event_notif_replay_cb, &replay_ctx);
     CHECK_RC_LOG_GOTO(rc, finalize, "Error by loading event notifications for xpath '%s'.", replay_req->xpath);
 
-    /* send each notification to the subscriber */
-    if (NULL != notif_list) {
-        for (size_t i = 0; i < notif_list->count; i++) {
-            np_ev_notification_t *notification = notif_list->data[i];
-
-            /* send the notification */
-            rc = rp_event_notif_send(rp_ctx, session, SR__EVENT_NOTIF_REQ__NOTIF_TYPE__REPLAY, notification->xpath,
-                    notification->timestamp, sr_api_variant_gpb_to_sr(replay_req->api_variant),
-                    notification->data.values, notification->data_cnt, notification->data.trees, notification->data_cnt,
-                    replay_req->subscriber_address, replay_req->subscription_id, 0);
-            CHECK_RC_LOG_GOTO(rc, finalize, "Error by sending the replay of notification '%s' to the subscriber '%s'.",
-                    notification->xpath, replay_req->subscriber_address);
-        }
+    if (!cursor->done) {
+        /* continue with the next step after the requests waiting in the queue */
+        rc = rp_event_notif_replay_enqueue(rp_ctx, session, replay_req, stop_time, cursor);
+        CHECK_RC_LOG_GOTO(rc, finalize, "Unable to continue the replay of event notifications for session id=%"PRIu32".",
+                session->id);
+        sr_msg_free(resp);
+        return SR_ERR_OK;
     }
 
     /* send replay-complete notification */
     rc = rp_event_notif_send(rp_ctx, session, SR__EVENT_NOTIF_REQ__NOTIF_TYPE__REPLAY_COMPLETE,
             replay_req->xpath, time(NULL), sr_api_variant_gpb_to_sr(replay_req->api_variant),
-            NULL, 0, NULL, 0, replay_req->subscriber_address, replay_req->subscription_id, 0);
+            NULL, 0, NULL, 0, NULL, replay_req->subscriber_address, replay_req->subscription_id, 0);
     CHECK_RC_LOG_GOTO(rc, finalize, "Error by sending the replay-complete notification to the subscriber '%s'.",
             replay_req->subscriber_address);
 
 finalize:
-    if (NULL != notif_list) {
-        for (size_t i = 0; i < notif_list->count; i++) {
-            np_event_notification_cleanup(notif_list->data[i]);
-        }
-    }
-    sr_list_cleanup(notif_list);
 #endif
-
     /* schedule replay-stop notification */
     if ((0 != replay_req->stop_time) && (time(NULL) <= replay_req->stop_time)) {
         rc = rp_event_notif_send(rp_ctx, session, SR__EVENT_NOTIF_REQ__NOTIF_TYPE__REPLAY_STOP, replay_req->xpath,
-                replay_req->stop_time, sr_api_variant_gpb_to_sr(replay_req->api_variant), NULL, 0, NULL, 0,
+                replay_req->stop_time, sr_api_variant_gpb_to_sr(replay_req->api_variant), NULL, 0, NULL, 0, NULL,
                 replay_req->subscriber_address, replay_req->subscription_id, replay_req->stop_time);
         if (SR_ERR_OK != rc) {
             SR_LOG_ERR("Error by scheduling the replay-stop notification to the subscriber '%s'.",
@@ -3207,6 +4388,49 @@ finalize:
     return rc;
 }
 
+/**
+ * @brief Processes an event notification replay request.
+ */
+static int
+rp_event_notif_replay_req_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
+{
+    Sr__EventNotifReplayReq *replay_req = NULL;
+    np_notif_store_cursor_t cursor = { 0, };
+
+    CHECK_NULL_ARG5(rp_ctx, session, msg, msg->request, msg->request->event_notif_replay_req);
+
+    SR_LOG_DBG_MSG("Processing event notification replay request.");
+
+    replay_req = msg->request->event_notif_replay_req;
+
+    /* fix the end of the replayed interval for all steps of the replay */
+    return rp_event_notif_replay_continue(rp_ctx, session, replay_req,
+            (0 == replay_req->stop_time) ? time(NULL) : replay_req->stop_time, &cursor);
+}
+
+/**
+ * @brief Processes a notif-replay-step internal request.
+ */
+static int
+rp_notif_replay_step_req_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
+{
+    Sr__NotifReplayStepReq *step_req = NULL;
+    np_notif_store_cursor_t cursor = { 0, };
+
+    CHECK_NULL_ARG5(rp_ctx, session, msg->internal_request, msg->internal_request->notif_replay_step_req,
+            msg->internal_request->notif_replay_step_req->replay_req);
+
+    SR_LOG_DBG_MSG("Processing notif-replay-step request.");
+
+    step_req = msg->internal_request->notif_replay_step_req;
+
+    cursor.valid = true;
+    cursor.segment = step_req->segment;
+    cursor.sequence = step_req->sequence;
+
+    return rp_event_notif_replay_continue(rp_ctx, session, step_req->replay_req, step_req->stop_time, &cursor);
+}
+
 /**
  * @brief Processes an notification acknowledgment.
  */
@@ -3241,8 +4465,9 @@ rp_notification_ack_process(rp_ctx_t *rp_ctx, Sr__Msg *msg)
                 subs_xpath, sr_notification_event_gpb_to_str(event), sr_strerror(msg->notification_ack->result));
     }
 
-    rc = np_commit_notification_ack(rp_ctx->np_ctx, notif->commit_id, subs_xpath, sr_notification_event_gpb_to_sr(event),
-            msg->notification_ack->result, msg->notification_ack->do_not_send_abort, err_msg, err_xpath);
+    rc = np_commit_notification_ack(rp_ctx->np_ctx, notif->commit_id, notif->destination_address, notif->subscription_id,
+            subs_xpath, sr_notification_event_gpb_to_sr(event), msg->notification_ack->result,
+            msg->notification_ack->do_not_send_abort, err_msg, err_xpath);
 
     return rc;
 }
@@ -3272,6 +4497,10 @@ rp_req_dispatch(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg, bool *ski
         pthread_mutex_unlock(&session->total_req_cnt_mutex);
     }
 
+    if (msg->request->operation < RP_STATS_OPERATION_CNT) {
+        __sync_fetch_and_add(&rp_ctx->stats->request_cnt[msg->request->operation], 1);
+    }
+
     /* acquire lock for operation accessing data */
     switch (msg->request->operation) {
         case SR__OPERATION__GET_ITEM:
@@ -3284,14 +4513,14 @@ rp_req_dispatch(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg, bool *ski
         case SR__OPERATION__DELETE_ITEM:
         case SR__OPERATION__MOVE_ITEM:
         case SR__OPERATION__SESSION_REFRESH:
-            pthread_rwlock_rdlock(&rp_ctx->commit_lock);
+            SR_PROBED_RWLOCK_RDLOCK(&rp_ctx->commit_lock, "commit_lock");
             locked = true;
             break;
         case SR__OPERATION__COMMIT:
         case SR__OPERATION__COPY_CONFIG:
             MUTEX_LOCK_TIMED_CHECK_RETURN(&rp_ctx->commit_block_mutex);
             if (!rp_ctx->block_further_commits) {
-                pthread_rwlock_wrlock(&rp_ctx->commit_lock);
+                SR_PROBED_RWLOCK_WRLOCK(&rp_ctx->commit_lock, "commit_lock");
                 locked = true;
             }
             pthread_mutex_unlock(&rp_ctx->commit_block_mutex);
@@ -3391,9 +4620,18 @@ rp_req_dispatch(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg, bool *ski
             rc = rp_event_notif_req_process(rp_ctx, session, msg);
             *skip_msg_cleanup = true;
             return rc; /* skip further processing */
+        case SR__OPERATION__EVENT_NOTIF_BATCH:
+            rc = rp_event_notif_batch_req_process(rp_ctx, session, msg);
+            break;
         case SR__OPERATION__EVENT_NOTIF_REPLAY:
             rc = rp_event_notif_replay_req_process(rp_ctx, session, msg);
             break;
+        case SR__OPERATION__DP_CACHE_INVALIDATE:
+            rc = rp_dp_cache_invalidate_req_process(rp_ctx, session, msg);
+            break;
+        case SR__OPERATION__OPER_DATA_PUSH:
+            rc = rp_oper_data_push_req_process(rp_ctx, session, msg);
+            break;
         default:
             SR_LOG_ERR("Unsupported request received (session id=%"PRIu32", operation=%d).",
                     NULL != session ? session->id : 0, msg->request->operation);
@@ -3403,7 +4641,7 @@ rp_req_dispatch(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg, bool *ski
 
     /* release lock */
     if (locked) {
-        pthread_rwlock_unlock(&rp_ctx->commit_lock);
+        SR_RWLOCK_UNLOCK(&rp_ctx->commit_lock);
     }
 
     return rc;
@@ -3413,7 +4651,7 @@ rp_req_dispatch(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg, bool *ski
  * @brief Dispatches received response message.
  */
 static int
-rp_resp_dispatch(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg, bool *skip_msg_cleanup)
+rp_resp_dispatch(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg, bool trusted, bool *skip_msg_cleanup)
 {
     int rc = SR_ERR_OK;
 
@@ -3427,7 +4665,7 @@ rp_resp_dispatch(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg, bool *sk
             break;
         case SR__OPERATION__RPC:
         case SR__OPERATION__ACTION:
-            rc = rp_rpc_resp_process(rp_ctx, session, msg);
+            rc = rp_rpc_resp_process(rp_ctx, session, msg, trusted);
             *skip_msg_cleanup = true;
             break;
         default:
@@ -3463,15 +4701,15 @@ rp_internal_req_dispatch(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
         case SR__OPERATION__INTERNAL_STATE_DATA:
             rc = rp_internal_state_data_req_process(rp_ctx, session, msg);
             break;
-        case SR__OPERATION__NOTIF_STORE_CLEANUP:
-            rc = rp_notif_store_cleanup_req_process(rp_ctx, session, msg);
-            break;
         case SR__OPERATION__DELAYED_MSG:
             rc = rp_delayed_msg_req_process(rp_ctx, session, msg);
             break;
         case SR__OPERATION__NACM_RELOAD:
             rc = rp_nacm_reload_req_process(rp_ctx, session, msg);
             break;
+        case SR__OPERATION__NOTIF_REPLAY_STEP:
+            rc = rp_notif_replay_step_req_process(rp_ctx, session, msg);
+            break;
         default:
             SR_LOG_ERR("Unsupported internal request received (operation=%d).", msg->internal_request->operation);
             rc = SR_ERR_UNSUPPORTED;
@@ -3503,10 +4741,12 @@ rp_session_can_be_null_for_msg (Sr__Msg *msg) {
  * @brief Dispatches the received message.
  */
 static int
-rp_msg_dispatch(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
+rp_msg_dispatch(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg, bool trusted)
 {
     int rc = SR_ERR_OK;
     bool skip_msg_cleanup = false;
+    Sr__Operation operation = 0;
+    sr_trace_span_t span = { 0, };
 
     CHECK_NULL_ARG2(rp_ctx, msg);
 
@@ -3536,10 +4776,17 @@ rp_msg_dispatch(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
 
     switch (msg->type) {
         case SR__MSG__MSG_TYPE__REQUEST:
+            operation = msg->request->operation;
+            SR_PROBE2(request__dispatch, (NULL != session ? session->id : 0), operation);
+            sr_trace_set_current(msg->trace_id);
+            SR_TRACE_BEGIN(&span, msg->trace_id, "rp", sr_gpb_operation_name(operation));
             rc = rp_req_dispatch(rp_ctx, session, msg, &skip_msg_cleanup);
+            SR_TRACE_END(&span);
+            sr_trace_set_current(0);
+            SR_PROBE3(request__complete, (NULL != session ? session->id : 0), operation, rc);
             break;
         case SR__MSG__MSG_TYPE__RESPONSE:
-            rc = rp_resp_dispatch(rp_ctx, session, msg, &skip_msg_cleanup);
+            rc = rp_resp_dispatch(rp_ctx, session, msg, trusted, &skip_msg_cleanup);
             break;
         case SR__MSG__MSG_TYPE__INTERNAL_REQUEST:
             rc = rp_internal_req_dispatch(rp_ctx, session, msg);
@@ -3575,6 +4822,9 @@ rp_session_cleanup(const rp_ctx_t *rp_ctx, rp_session_t *session)
 
     SR_LOG_DBG("RP session cleanup, session id=%"PRIu32".", session->id);
 
+    /* operational data pushed by the session are no longer maintained by anyone */
+    rp_oper_store_remove_session(rp_ctx->oper_store, session->id);
+
     dm_session_stop(rp_ctx->dm_ctx, session->dm_session);
     ac_session_cleanup(session->ac_session);
 
@@ -3598,6 +4848,7 @@ rp_session_cleanup(const rp_ctx_t *rp_ctx, rp_session_t *session)
     }
     free(session->loaded_state_data);
     rp_dt_free_state_data_ctx_content(&session->state_data_ctx);
+    free(session->dp_timed_out_xpath);
     free(session);
 
     return SR_ERR_OK;
@@ -3618,18 +4869,18 @@ rp_worker_thread_execute(void *rp_ctx_p)
 
     SR_LOG_DBG("Starting worker thread id=%lu.", (unsigned long)pthread_self());
 
-    pthread_mutex_lock(&rp_ctx->request_queue_mutex);
+    SR_MUTEX_LOCK(&rp_ctx->request_queue_mutex, "request_queue_mutex");
     rp_ctx->active_threads++;
-    pthread_mutex_unlock(&rp_ctx->request_queue_mutex);
+    SR_MUTEX_UNLOCK(&rp_ctx->request_queue_mutex);
 
     do {
         /* process requests while there are some */
         dequeued_prev = false;
         do {
             /* dequeue a request */
-            pthread_mutex_lock(&rp_ctx->request_queue_mutex);
+            SR_MUTEX_LOCK(&rp_ctx->request_queue_mutex, "request_queue_mutex");
             dequeued = sr_cbuff_dequeue(rp_ctx->request_queue, &req);
-            pthread_mutex_unlock(&rp_ctx->request_queue_mutex);
+            SR_MUTEX_UNLOCK(&rp_ctx->request_queue_mutex);
 
             if (dequeued) {
                 /* process the request */
@@ -3637,7 +4888,7 @@ rp_worker_thread_execute(void *rp_ctx_p)
                     SR_LOG_DBG("Thread id=%lu received an empty request, exiting.", (unsigned long)pthread_self());
                     exit = true;
                 } else {
-                    rp_msg_dispatch(rp_ctx, req.session, req.msg);
+                    rp_msg_dispatch(rp_ctx, req.session, req.msg, req.trusted);
                     if (NULL != req.session) {
                         /* update message count and release session if needed */
                         pthread_mutex_lock(&req.session->msg_count_mutex);
@@ -3656,22 +4907,22 @@ rp_worker_thread_execute(void *rp_ctx_p)
                 if (dequeued_prev) {
                     /* only if the thread has actually processed something since the last wakeup */
                     size_t count = 0;
-                    pthread_mutex_lock(&rp_ctx->request_queue_mutex);
+                    SR_MUTEX_LOCK(&rp_ctx->request_queue_mutex, "request_queue_mutex");
                     while ((0 == sr_cbuff_items_in_queue(rp_ctx->request_queue)) && (count < rp_ctx->thread_spin_limit)) {
                         count++;
                     }
-                    pthread_mutex_unlock(&rp_ctx->request_queue_mutex);
+                    SR_MUTEX_UNLOCK(&rp_ctx->request_queue_mutex);
                 }
-                pthread_mutex_lock(&rp_ctx->request_queue_mutex);
+                SR_MUTEX_LOCK(&rp_ctx->request_queue_mutex, "request_queue_mutex");
                 if (0 != sr_cbuff_items_in_queue(rp_ctx->request_queue)) {
                     /* some items are in queue - process them */
-                    pthread_mutex_unlock(&rp_ctx->request_queue_mutex);
+                    SR_MUTEX_UNLOCK(&rp_ctx->request_queue_mutex);
                     dequeued = true;
                     continue;
                 } else {
                     /* no items in queue - go to sleep */
                     rp_ctx->active_threads--;
-                    pthread_mutex_unlock(&rp_ctx->request_queue_mutex);
+                    SR_MUTEX_UNLOCK(&rp_ctx->request_queue_mutex);
                 }
             }
         } while (dequeued && !exit);
@@ -3681,17 +4932,17 @@ rp_worker_thread_execute(void *rp_ctx_p)
             SR_LOG_DBG("Thread id=%lu will wait.",  (unsigned long)pthread_self());
 
             /* wait for a signal */
-            pthread_mutex_lock(&rp_ctx->request_queue_mutex);
+            SR_MUTEX_LOCK(&rp_ctx->request_queue_mutex, "request_queue_mutex");
             if (rp_ctx->stop_requested) {
                 /* stop has been requested, do not wait anymore */
-                pthread_mutex_unlock(&rp_ctx->request_queue_mutex);
+                SR_MUTEX_UNLOCK(&rp_ctx->request_queue_mutex);
                 break;
             }
-            pthread_cond_wait(&rp_ctx->request_queue_cv, &rp_ctx->request_queue_mutex);
+            SR_COND_WAIT(&rp_ctx->request_queue_cv, &rp_ctx->request_queue_mutex, "request_queue_mutex");
             rp_ctx->active_threads++;
 
             SR_LOG_DBG("Thread id=%lu signaled.",  (unsigned long)pthread_self());
-            pthread_mutex_unlock(&rp_ctx->request_queue_mutex);
+            SR_MUTEX_UNLOCK(&rp_ctx->request_queue_mutex);
         }
     } while (!exit);
 
@@ -3739,11 +4990,11 @@ rp_enable_xps_for_internal_state_data(rp_ctx_t *rp_ctx)
             xp_to_be_enabled = (char *) module_xps->data[x];
             rc = rp_dt_enable_xpath(rp_ctx->dm_ctx, NULL, si, xp_to_be_enabled);
             if (SR_ERR_OK != rc) {
-                pthread_rwlock_unlock(&si->model_lock);
+                SR_RWLOCK_UNLOCK(&si->model_lock);
             }
             CHECK_RC_LOG_RETURN(rc, "Failed to enable xpath %s", xp_to_be_enabled);
         }
-        pthread_rwlock_unlock(&si->model_lock);
+        SR_RWLOCK_UNLOCK(&si->model_lock);
 
     }
     return rc;
@@ -3755,6 +5006,7 @@ rp_setup_internal_state_data(rp_ctx_t *rp_ctx)
     CHECK_NULL_ARG(rp_ctx);
     nacm_ctx_t *nacm_ctx = NULL;
     sr_list_t *ietf_netconf_acm = NULL;
+    sr_list_t *monitoring = NULL;
     int rc = SR_ERR_OK;
 
     rc = dm_get_nacm_ctx(rp_ctx->dm_ctx, &nacm_ctx);
@@ -3787,12 +5039,27 @@ rp_setup_internal_state_data(rp_ctx_t *rp_ctx)
         CHECK_RC_MSG_GOTO(rc, cleanup, "List add failed");
         ietf_netconf_acm = NULL;
     }
+
+    rc = sr_list_init(&monitoring);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "List init failed");
+
+    rc = sr_list_add(monitoring, strdup(RP_MONITORING_XPATH));
+    CHECK_RC_MSG_GOTO(rc, cleanup, "List add failed");
+
+    rc = sr_list_add(rp_ctx->modules_incl_intern_op_data, strdup(RP_MONITORING_MODULE));
+    CHECK_RC_MSG_GOTO(rc, cleanup, "List add failed");
+
+    rc = sr_list_add(rp_ctx->inter_op_data_xpath, monitoring);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "List add failed");
+    monitoring = NULL;
+
     rc = rp_enable_xps_for_internal_state_data(rp_ctx);
     CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to enable xpaths for internal state data");
 
 cleanup:
     if (SR_ERR_OK != rc) {
         sr_free_list_of_strings(ietf_netconf_acm);
+        sr_free_list_of_strings(monitoring);
         rp_cleanup_internal_state_data_records(rp_ctx);
     }
     return rc;
@@ -3818,6 +5085,15 @@ rp_init(cm_ctx_t *cm_ctx, rp_ctx_t **rp_ctx_p)
     }
     ctx->cm_ctx = cm_ctx;
 
+    /* initialize performance statistics */
+    ctx->stats = calloc(1, sizeof(*ctx->stats));
+    if (NULL == ctx->stats) {
+        SR_LOG_ERR_MSG("Cannot allocate memory for Request Processor statistics.");
+        free(ctx);
+        return SR_ERR_NOMEM;
+    }
+    pthread_mutex_init(&ctx->stats->mutex, NULL);
+
     /* initialize access control module */
     rc = ac_init(SR_DATA_SEARCH_DIR, &ctx->ac_ctx);
     if (SR_ERR_OK != rc) {
@@ -3870,6 +5146,18 @@ rp_init(cm_ctx_t *cm_ctx, rp_ctx_t **rp_ctx_p)
     rc = rp_setup_internal_state_data(ctx);
     CHECK_RC_MSG_GOTO(rc, cleanup, "Set up of internal state data failed");
 
+    /* initialize operational data provider cache */
+    rc = rp_dp_cache_init(&ctx->dp_cache);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Operational data provider cache initialization failed.");
+
+    /* initialize store of pushed operational data */
+    rc = rp_oper_store_init(&ctx->oper_store);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Pushed operational data store initialization failed.");
+
+    /* initialize latency statistics of operational data providers */
+    rc = rp_dp_latency_init(&ctx->dp_latency);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Data provider latency statistics initialization failed.");
+
     pthread_mutex_init(&ctx->commit_block_mutex, NULL);
 
     /* run worker threads */
@@ -3897,6 +5185,11 @@ cleanup:
     pm_cleanup(ctx->pm_ctx);
     ac_cleanup(ctx->ac_ctx);
     sr_cbuff_cleanup(ctx->request_queue);
+    rp_dp_cache_cleanup(ctx->dp_cache);
+    rp_oper_store_cleanup(ctx->oper_store);
+    rp_dp_latency_cleanup(ctx->dp_latency);
+    pthread_mutex_destroy(&ctx->stats->mutex);
+    free(ctx->stats);
     free(ctx);
     return rc;
 }
@@ -3911,14 +5204,14 @@ rp_cleanup(rp_ctx_t *rp_ctx)
 
     if (NULL != rp_ctx) {
         /* enqueue RP_THREAD_COUNT "empty" messages and send signal to all threads */
-        pthread_mutex_lock(&rp_ctx->request_queue_mutex);
+        SR_MUTEX_LOCK(&rp_ctx->request_queue_mutex, "request_queue_mutex");
         rp_ctx->stop_requested = true;
         /* enqueue empty requests to request thread exits */
         for (i = 0; i < RP_THREAD_COUNT; i++) {
             sr_cbuff_enqueue(rp_ctx->request_queue, &req);
         }
         pthread_cond_broadcast(&rp_ctx->request_queue_cv);
-        pthread_mutex_unlock(&rp_ctx->request_queue_mutex);
+        SR_MUTEX_UNLOCK(&rp_ctx->request_queue_mutex);
 
         /* wait for threads to exit */
         for (i = 0; i < RP_THREAD_COUNT; i++) {
@@ -3938,8 +5231,14 @@ rp_cleanup(rp_ctx_t *rp_ctx)
         np_cleanup(rp_ctx->np_ctx);
         pm_cleanup(rp_ctx->pm_ctx);
         ac_cleanup(rp_ctx->ac_ctx);
+        sr_user_cache_cleanup();
         sr_cbuff_cleanup(rp_ctx->request_queue);
         rp_cleanup_internal_state_data_records(rp_ctx);
+        rp_dp_cache_cleanup(rp_ctx->dp_cache);
+        rp_oper_store_cleanup(rp_ctx->oper_store);
+        rp_dp_latency_cleanup(rp_ctx->dp_latency);
+        pthread_mutex_destroy(&rp_ctx->stats->mutex);
+        free(rp_ctx->stats);
         free(rp_ctx);
     }
 
@@ -3983,9 +5282,19 @@ rp_session_start(const rp_ctx_t *rp_ctx, const uint32_t session_id, const ac_ucr
     rc = ac_session_init(rp_ctx->ac_ctx, user_credentials, &session->ac_session);
     CHECK_RC_LOG_GOTO(rc, cleanup, "Access Control session init failed for session id=%"PRIu32".", session_id);
 
+    if (session_options & SR_SESS_TRUSTED) {
+        /* procedures of trusted sessions are not validated, only authorized users can start them */
+        rc = ac_check_trusted_user(user_credentials);
+        CHECK_RC_LOG_GOTO(rc, cleanup, "Trusted session refused for session id=%"PRIu32".", session_id);
+    }
+
     rc = dm_session_start(rp_ctx->dm_ctx, user_credentials, datastore, &session->dm_session);
     CHECK_RC_LOG_GOTO(rc, cleanup, "Init of dm_session failed for session id=%"PRIu32".", session_id);
 
+    pthread_mutex_lock(&rp_ctx->stats->mutex);
+    rp_ctx->stats->session_cnt += 1;
+    pthread_mutex_unlock(&rp_ctx->stats->mutex);
+
     *session_p = session;
 
     return rc;
@@ -4002,6 +5311,10 @@ rp_session_stop(const rp_ctx_t *rp_ctx, rp_session_t *session)
 
     SR_LOG_DBG("RP session stop, session id=%"PRIu32".", session->id);
 
+    pthread_mutex_lock(&rp_ctx->stats->mutex);
+    rp_ctx->stats->session_cnt -= 1;
+    pthread_mutex_unlock(&rp_ctx->stats->mutex);
+
     /* sanity check - normally there should not be any unprocessed messages
      * within the session when calling rp_session_stop */
     pthread_mutex_lock(&session->msg_count_mutex);
@@ -4021,8 +5334,11 @@ rp_session_stop(const rp_ctx_t *rp_ctx, rp_session_t *session)
     return SR_ERR_OK;
 }
 
-int
-rp_msg_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
+/**
+ * @brief Enqueues the message for processing in Request Processor.
+ */
+static int
+rp_msg_enqueue(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg, bool trusted)
 {
     rp_request_t req = { 0 };
     struct timespec now = { 0 };
@@ -4045,8 +5361,9 @@ rp_msg_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
 
     req.session = session;
     req.msg = msg;
+    req.trusted = trusted;
 
-    pthread_mutex_lock(&rp_ctx->request_queue_mutex);
+    SR_MUTEX_LOCK(&rp_ctx->request_queue_mutex, "request_queue_mutex");
 
     /* enqueue the request into buffer */
     rc = sr_cbuff_enqueue(rp_ctx->request_queue, &req);
@@ -4082,7 +5399,7 @@ rp_msg_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
         pthread_cond_signal(&rp_ctx->request_queue_cv);
     }
 
-    pthread_mutex_unlock(&rp_ctx->request_queue_mutex);
+    SR_MUTEX_UNLOCK(&rp_ctx->request_queue_mutex);
 
     if (SR_ERR_OK != rc) {
         /* release the message by error */
@@ -4098,6 +5415,18 @@ rp_msg_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
     return rc;
 }
 
+int
+rp_msg_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
+{
+    return rp_msg_enqueue(rp_ctx, session, msg, false);
+}
+
+int
+rp_trusted_msg_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg)
+{
+    return rp_msg_enqueue(rp_ctx, session, msg, true);
+}
+
 int
 rp_all_notifications_received(rp_ctx_t *rp_ctx, uint32_t commit_id, bool finished, int result,
         sr_list_t *err_subs_xpaths, sr_list_t *errors)
@@ -4110,7 +5439,7 @@ rp_all_notifications_received(rp_ctx_t *rp_ctx, uint32_t commit_id, bool finishe
 
     rc = dm_get_commit_ctxs(rp_ctx->dm_ctx, &dm_ctxs);
     CHECK_RC_MSG_RETURN(rc, "Get commit ctx failed");
-    pthread_rwlock_rdlock(&dm_ctxs->lock);
+    SR_RWLOCK_RDLOCK(&dm_ctxs->lock, "commit_ctxs_lock");
     locked = true;
 
     rc = dm_get_commit_context(rp_ctx->dm_ctx, commit_id, &c_ctx);
@@ -4149,10 +5478,10 @@ rp_all_notifications_received(rp_ctx_t *rp_ctx, uint32_t commit_id, bool finishe
         rc = rp_msg_process(rp_ctx, c_ctx->init_session, c_ctx->init_session->req);
         c_ctx->init_session->req = NULL;
         pthread_mutex_unlock(&c_ctx->mutex);
-        pthread_rwlock_unlock(&dm_ctxs->lock);
+        SR_RWLOCK_UNLOCK(&dm_ctxs->lock);
     } else if (finished && DM_COMMIT_FINISHED == c_ctx->state){
         pthread_mutex_unlock(&c_ctx->mutex);
-        pthread_rwlock_unlock(&dm_ctxs->lock);
+        SR_RWLOCK_UNLOCK(&dm_ctxs->lock);
         locked = false;
         /* apply or abort phase finished, release commit context */
         SR_LOG_INF("Commit id %"PRIu32" received all notifications", commit_id);
@@ -4162,7 +5491,7 @@ rp_all_notifications_received(rp_ctx_t *rp_ctx, uint32_t commit_id, bool finishe
         /* this might occurs when verify timeout expires and commit has already moved forward */
         SR_LOG_DBG("Commit id %"PRIu32" is in an unexpected state.", commit_id);
         pthread_mutex_unlock(&c_ctx->mutex);
-        pthread_rwlock_unlock(&dm_ctxs->lock);
+        SR_RWLOCK_UNLOCK(&dm_ctxs->lock);
     }
     return rc;
 
@@ -4171,7 +5500,7 @@ cleanup:
         pthread_mutex_unlock(&c_ctx->mutex);
     }
     if (locked) {
-        pthread_rwlock_unlock(&dm_ctxs->lock);
+        SR_RWLOCK_UNLOCK(&dm_ctxs->lock);
     }
     /* cleanup error lists */
     if (NULL != err_subs_xpaths) {
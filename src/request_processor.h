@@ -120,6 +120,20 @@ int rp_session_stop(const rp_ctx_t *rp_ctx, rp_session_t *session);
  */
 int rp_msg_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg);
 
+/**
+ * @brief Pass the message sent by a trusted peer (see ::ac_check_trusted_user) for processing
+ * in Request Processor. RPC/Action responses of trusted peers to the requests of trusted sessions
+ * are forwarded to the originator without validation.
+ *
+ * @param[in] rp_ctx Request Processor context.
+ * @param[in] session Request Processor session context related to the message.
+ * @param[in] msg GPB Message to be passed. @note Message will be freed.
+ * automatically after calling, also in case of error.
+ *
+ * @return Error code (SR_ERR_OK on success).
+ */
+int rp_trusted_msg_process(rp_ctx_t *rp_ctx, rp_session_t *session, Sr__Msg *msg);
+
 /**
  * @brief Called to signal that all notification has been received and commit processing
  * can continue (::SR_EV_VERIFY) or the commit context can be freed (::SR_EV_APPLY, ::SR_EV_ABORT, ::SR_EV_ENABLED).
@@ -0,0 +1,581 @@
+/**
+ * @file rp_dp_cache.c
+ * @brief Cache of the values returned by operational data providers.
+ *
+ * @copyright
+ * Copyright 2016 Cisco Systems, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include <pthread.h>
+
+#include "rp_dp_cache.h"
+#include "values_internal.h"
+
+/**
+ * @brief Values cached for one requested xpath.
+ */
+typedef struct rp_dp_cache_entry_s {
+    char *xpath;                /**< Requested xpath (key of the entry). */
+    char *dst_address;          /**< Destination address of the data provider subscription. */
+    uint32_t dst_id;            /**< Destination ID of the data provider subscription. */
+    struct timespec expiry;     /**< Time (CLOCK_MONOTONIC) when the entry expires. */
+    sr_val_t *values;           /**< Cached values. */
+    size_t values_cnt;          /**< Number of cached values. */
+} rp_dp_cache_entry_t;
+
+/**
+ * @brief Operational data provider cache context.
+ */
+struct rp_dp_cache_s {
+    sr_btree_t *entries;        /**< Cache entries (one per requested xpath) ordered by xpath. */
+    size_t entry_cnt;           /**< Number of the cache entries. */
+    rp_dp_cache_stats_t stats;  /**< Statistics of the cache. */
+    pthread_mutex_t mutex;      /**< Mutex guarding the cache. */
+};
+
+/**
+ * @brief Requested xpath whose values are being stored, used to split the provided values among the xpaths.
+ */
+typedef struct rp_dp_cache_req_s {
+    const char *xpath;              /**< Requested xpath. */
+    size_t len;                     /**< Length of the xpath. */
+    rp_dp_cache_entry_t *entry;     /**< Entry to be stored for the xpath. */
+} rp_dp_cache_req_t;
+
+/**
+ * @brief Compares two cache entries by their xpath.
+ */
+static int
+rp_dp_cache_entry_cmp(const void *a, const void *b)
+{
+    const rp_dp_cache_entry_t *entry_a = (const rp_dp_cache_entry_t *) a;
+    const rp_dp_cache_entry_t *entry_b = (const rp_dp_cache_entry_t *) b;
+    int res = strcmp(entry_a->xpath, entry_b->xpath);
+
+    if (res == 0) {
+        return 0;
+    } else if (res < 0) {
+        return -1;
+    } else {
+        return 1;
+    }
+}
+
+/**
+ * @brief Frees a cache entry.
+ */
+static void
+rp_dp_cache_entry_free(void *item)
+{
+    rp_dp_cache_entry_t *entry = (rp_dp_cache_entry_t *) item;
+
+    if (NULL != entry) {
+        free(entry->xpath);
+        free(entry->dst_address);
+        sr_free_values(entry->values, entry->values_cnt);
+        free(entry);
+    }
+}
+
+/**
+ * @brief Returns true if the time has passed the expiry time.
+ */
+static bool
+rp_dp_cache_time_passed(const struct timespec *expiry, const struct timespec *now)
+{
+    return (now->tv_sec > expiry->tv_sec) || (now->tv_sec == expiry->tv_sec && now->tv_nsec >= expiry->tv_nsec);
+}
+
+/**
+ * @brief Returns true if the entry has expired.
+ */
+static bool
+rp_dp_cache_entry_expired(const rp_dp_cache_entry_t *entry, const struct timespec *now)
+{
+    return rp_dp_cache_time_passed(&entry->expiry, now);
+}
+
+/**
+ * @brief Returns true if the entry has been stored for the data provider subscription.
+ */
+static bool
+rp_dp_cache_entry_of_provider(const rp_dp_cache_entry_t *entry, const char *dst_address, uint32_t dst_id)
+{
+    return entry->dst_id == dst_id && 0 == strcmp(entry->dst_address, dst_address);
+}
+
+/**
+ * @brief Duplicates the values into a new array without Sysrepo memory context.
+ */
+static int
+rp_dp_cache_dup_values(const sr_val_t *values, size_t values_cnt, sr_val_t **dup_p, size_t *dup_cnt_p)
+{
+    sr_val_t *dup = NULL;
+    int rc = SR_ERR_OK;
+
+    *dup_p = NULL;
+    *dup_cnt_p = 0;
+    if (0 == values_cnt) {
+        return SR_ERR_OK;
+    }
+
+    dup = calloc(values_cnt, sizeof(*dup));
+    CHECK_NULL_NOMEM_RETURN(dup);
+
+    for (size_t i = 0; i < values_cnt; i++) {
+        rc = sr_val_set_xpath(&dup[i], values[i].xpath);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to set xpath of a cached value.");
+        rc = sr_dup_val_data(&dup[i], &values[i]);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to duplicate a cached value.");
+    }
+
+cleanup:
+    if (SR_ERR_OK != rc) {
+        sr_free_values(dup, values_cnt);
+        return rc;
+    }
+    *dup_p = dup;
+    *dup_cnt_p = values_cnt;
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Compares two requested xpaths (used to sort them).
+ */
+static int
+rp_dp_cache_req_cmp(const void *a, const void *b)
+{
+    return strcmp(((const rp_dp_cache_req_t *) a)->xpath, ((const rp_dp_cache_req_t *) b)->xpath);
+}
+
+/**
+ * @brief Finds the requested xpath equal to the first len characters of the xpath in the sorted array.
+ */
+static rp_dp_cache_req_t *
+rp_dp_cache_req_find(rp_dp_cache_req_t *reqs, size_t req_cnt, const char *xpath, size_t len)
+{
+    size_t lo = 0, hi = req_cnt, mid = 0;
+    int res = 0;
+
+    while (lo < hi) {
+        mid = lo + (hi - lo) / 2;
+        res = strncmp(xpath, reqs[mid].xpath, len);
+        if (0 == res && len < reqs[mid].len) {
+            /* the prefix is shorter than the requested xpath */
+            res = -1;
+        }
+        if (0 == res) {
+            return &reqs[mid];
+        } else if (res < 0) {
+            hi = mid;
+        } else {
+            lo = mid + 1;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * @brief Calls the callback for each requested xpath whose subtree contains the value
+ * (the requested xpath is a prefix of the value xpath ending at a node or predicate boundary).
+ */
+static int
+rp_dp_cache_split_value(rp_dp_cache_req_t *reqs, size_t req_cnt, const sr_val_t *value,
+        int (*value_cb)(rp_dp_cache_req_t *req, const sr_val_t *value))
+{
+    rp_dp_cache_req_t *req = NULL;
+    const char *c = NULL;
+    char quote = 0;
+    int rc = SR_ERR_OK;
+
+    for (c = value->xpath; ; c++) {
+        if (quote) {
+            if (*c == quote) {
+                quote = 0;
+            } else if ('\0' == *c) {
+                break;
+            }
+            continue;
+        }
+        if ('\'' == *c || '"' == *c) {
+            quote = *c;
+            continue;
+        }
+        if (('/' == *c || '[' == *c || '\0' == *c) && c != value->xpath) {
+            req = rp_dp_cache_req_find(reqs, req_cnt, value->xpath, c - value->xpath);
+            if (NULL != req && NULL != req->entry) {
+                rc = value_cb(req, value);
+                CHECK_RC_MSG_RETURN(rc, "Failed to process a value to be cached.");
+            }
+        }
+        if ('\0' == *c) {
+            break;
+        }
+    }
+    return rc;
+}
+
+/**
+ * @brief Counts the value into the entry of the requested xpath.
+ */
+static int
+rp_dp_cache_count_value(rp_dp_cache_req_t *req, const sr_val_t *value)
+{
+    (void) value;
+    req->entry->values_cnt++;
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Duplicates the value into the entry of the requested xpath.
+ */
+static int
+rp_dp_cache_add_value(rp_dp_cache_req_t *req, const sr_val_t *value)
+{
+    sr_val_t *dup = &req->entry->values[req->entry->values_cnt];
+    int rc = SR_ERR_OK;
+
+    rc = sr_val_set_xpath(dup, value->xpath);
+    CHECK_RC_MSG_RETURN(rc, "Failed to set xpath of a cached value.");
+    req->entry->values_cnt++;
+    return sr_dup_val_data(dup, value);
+}
+
+/**
+ * @brief Removes the entry from the cache. Cache mutex is expected to be held.
+ */
+static void
+rp_dp_cache_remove_locked(rp_dp_cache_t *cache, rp_dp_cache_entry_t *entry)
+{
+    sr_btree_delete(cache->entries, entry);
+    cache->entry_cnt--;
+}
+
+/**
+ * @brief Removes all entries matching the condition from the cache. Cache mutex is expected to be held.
+ */
+static int
+rp_dp_cache_remove_matching_locked(rp_dp_cache_t *cache, bool (*match_cb)(const rp_dp_cache_entry_t *entry,
+        const void *arg), const void *arg)
+{
+    rp_dp_cache_entry_t *entry = NULL;
+    sr_list_t *matching = NULL;
+    size_t i = 0;
+    int rc = SR_ERR_OK;
+
+    rc = sr_list_init(&matching);
+    CHECK_RC_MSG_RETURN(rc, "List init failed");
+
+    /* the tree must not be modified while iterating */
+    while (NULL != (entry = sr_btree_get_at(cache->entries, i++))) {
+        if (match_cb(entry, arg)) {
+            rc = sr_list_add(matching, entry);
+            CHECK_RC_MSG_GOTO(rc, cleanup, "List add failed");
+        }
+    }
+
+    for (i = 0; i < matching->count; i++) {
+        entry = matching->data[i];
+        SR_LOG_DBG("Removing cached operational data of '%s'.", entry->xpath);
+        rp_dp_cache_remove_locked(cache, entry);
+    }
+
+cleanup:
+    sr_list_cleanup(matching);
+    return rc;
+}
+
+/**
+ * @brief Matches expired entries.
+ */
+static bool
+rp_dp_cache_match_expired(const rp_dp_cache_entry_t *entry, const void *now)
+{
+    return rp_dp_cache_entry_expired(entry, (const struct timespec *) now);
+}
+
+/**
+ * @brief Matches the entries in the subtree of the xpath and the entries containing the subtree.
+ */
+static bool
+rp_dp_cache_match_subtree(const rp_dp_cache_entry_t *entry, const void *xpath)
+{
+    return NULL == xpath || sr_xpath_in_subtree(entry->xpath, (const char *) xpath) ||
+            sr_xpath_in_subtree((const char *) xpath, entry->xpath);
+}
+
+/**
+ * @brief Makes room for a new entry if the cache is full - removes the expired entries and if that
+ * is not enough, the entry that expires first. Cache mutex is expected to be held.
+ */
+static int
+rp_dp_cache_make_room_locked(rp_dp_cache_t *cache, const struct timespec *now)
+{
+    rp_dp_cache_entry_t *entry = NULL, *oldest = NULL;
+    size_t i = 0;
+    int rc = SR_ERR_OK;
+
+    if (cache->entry_cnt < RP_DP_CACHE_MAX_ENTRIES) {
+        return SR_ERR_OK;
+    }
+
+    rc = rp_dp_cache_remove_matching_locked(cache, rp_dp_cache_match_expired, now);
+    CHECK_RC_MSG_RETURN(rc, "Failed to remove expired cache entries.");
+
+    if (cache->entry_cnt >= RP_DP_CACHE_MAX_ENTRIES) {
+        while (NULL != (entry = sr_btree_get_at(cache->entries, i++))) {
+            if (NULL == oldest || rp_dp_cache_time_passed(&oldest->expiry, &entry->expiry)) {
+                oldest = entry;
+            }
+        }
+        if (NULL != oldest) {
+            SR_LOG_DBG("Cache is full, evicting cached operational data of '%s'.", oldest->xpath);
+            rp_dp_cache_remove_locked(cache, oldest);
+        }
+    }
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Inserts the entry unless there is a fresh one from the same data provider.
+ * Cache mutex is expected to be held.
+ */
+static int
+rp_dp_cache_insert_locked(rp_dp_cache_t *cache, rp_dp_cache_entry_t *entry, const struct timespec *now,
+        bool *inserted)
+{
+    rp_dp_cache_entry_t *existing = NULL;
+    int rc = SR_ERR_OK;
+
+    *inserted = false;
+
+    existing = sr_btree_search(cache->entries, entry);
+    if (NULL != existing) {
+        if (!rp_dp_cache_entry_expired(existing, now) &&
+                rp_dp_cache_entry_of_provider(existing, entry->dst_address, entry->dst_id)) {
+            return SR_ERR_OK;
+        }
+        rp_dp_cache_remove_locked(cache, existing);
+    }
+
+    rc = rp_dp_cache_make_room_locked(cache, now);
+    CHECK_RC_MSG_RETURN(rc, "Failed to make room in the cache.");
+
+    rc = sr_btree_insert(cache->entries, entry);
+    CHECK_RC_MSG_RETURN(rc, "Failed to insert a cache entry.");
+    cache->entry_cnt++;
+    *inserted = true;
+
+    return SR_ERR_OK;
+}
+
+int
+rp_dp_cache_init(rp_dp_cache_t **cache_p)
+{
+    rp_dp_cache_t *cache = NULL;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG(cache_p);
+
+    cache = calloc(1, sizeof(*cache));
+    CHECK_NULL_NOMEM_RETURN(cache);
+
+    rc = sr_btree_init(rp_dp_cache_entry_cmp, rp_dp_cache_entry_free, &cache->entries);
+    if (SR_ERR_OK != rc) {
+        SR_LOG_ERR_MSG("Unable to initialize the operational data provider cache.");
+        free(cache);
+        return rc;
+    }
+    pthread_mutex_init(&cache->mutex, NULL);
+
+    *cache_p = cache;
+    return SR_ERR_OK;
+}
+
+void
+rp_dp_cache_cleanup(rp_dp_cache_t *cache)
+{
+    if (NULL != cache) {
+        sr_btree_cleanup(cache->entries);
+        pthread_mutex_destroy(&cache->mutex);
+        free(cache);
+    }
+}
+
+int
+rp_dp_cache_lookup(rp_dp_cache_t *cache, const np_subscription_t *subscription, const char *xpath,
+        sr_val_t **values, size_t *values_cnt)
+{
+    rp_dp_cache_entry_t lookup = { 0, };
+    rp_dp_cache_entry_t *entry = NULL;
+    struct timespec now = { 0, };
+    int rc = SR_ERR_NOT_FOUND;
+
+    CHECK_NULL_ARG5(cache, subscription, xpath, values, values_cnt);
+
+    if (0 == subscription->dp_cache_ttl) {
+        /* caching not enabled for the subscription */
+        return SR_ERR_NOT_FOUND;
+    }
+
+    sr_clock_get_time(CLOCK_MONOTONIC, &now);
+    lookup.xpath = (char *) xpath;
+
+    SR_MUTEX_LOCK(&cache->mutex, "dp_cache_mutex");
+
+    entry = sr_btree_search(cache->entries, &lookup);
+    if (NULL != entry && rp_dp_cache_entry_expired(entry, &now)) {
+        rp_dp_cache_remove_locked(cache, entry);
+        entry = NULL;
+    }
+    if (NULL != entry && rp_dp_cache_entry_of_provider(entry, subscription->dst_address, subscription->dst_id)) {
+        rc = rp_dp_cache_dup_values(entry->values, entry->values_cnt, values, values_cnt);
+        if (SR_ERR_OK == rc) {
+            cache->stats.hits++;
+        }
+    } else {
+        rc = SR_ERR_NOT_FOUND;
+        cache->stats.misses++;
+    }
+
+    SR_MUTEX_UNLOCK(&cache->mutex);
+
+    return rc;
+}
+
+int
+rp_dp_cache_store(rp_dp_cache_t *cache, const np_subscription_t **subscriptions, char **xpaths, size_t xpath_cnt,
+        const sr_val_t *values, size_t values_cnt)
+{
+    rp_dp_cache_req_t *reqs = NULL;
+    rp_dp_cache_entry_t *entry = NULL;
+    struct timespec now = { 0, };
+    size_t req_cnt = 0, i = 0, j = 0;
+    bool inserted = false;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG3(cache, subscriptions, xpaths);
+    if (values_cnt > 0) {
+        CHECK_NULL_ARG(values);
+    }
+
+    sr_clock_get_time(CLOCK_MONOTONIC, &now);
+
+    /* prepare an entry for each xpath whose data provider declared a validity period */
+    reqs = calloc(xpath_cnt, sizeof(*reqs));
+    CHECK_NULL_NOMEM_RETURN(reqs);
+
+    for (i = 0; i < xpath_cnt; i++) {
+        if (NULL == subscriptions[i] || 0 == subscriptions[i]->dp_cache_ttl) {
+            continue;
+        }
+        entry = calloc(1, sizeof(*entry));
+        CHECK_NULL_NOMEM_GOTO(entry, rc, cleanup);
+        reqs[req_cnt].xpath = xpaths[i];
+        reqs[req_cnt].len = strlen(xpaths[i]);
+        reqs[req_cnt++].entry = entry;
+
+        entry->xpath = strdup(xpaths[i]);
+        CHECK_NULL_NOMEM_GOTO(entry->xpath, rc, cleanup);
+        entry->dst_address = strdup(subscriptions[i]->dst_address);
+        CHECK_NULL_NOMEM_GOTO(entry->dst_address, rc, cleanup);
+        entry->dst_id = subscriptions[i]->dst_id;
+
+        entry->expiry.tv_sec = now.tv_sec + subscriptions[i]->dp_cache_ttl / 1000;
+        entry->expiry.tv_nsec = now.tv_nsec + (subscriptions[i]->dp_cache_ttl % 1000) * 1000000L;
+        if (entry->expiry.tv_nsec >= 1000000000L) {
+            entry->expiry.tv_sec++;
+            entry->expiry.tv_nsec -= 1000000000L;
+        }
+    }
+    if (0 == req_cnt) {
+        goto cleanup;
+    }
+
+    /* sort the xpaths, the same xpath is cached only once */
+    qsort(reqs, req_cnt, sizeof(*reqs), rp_dp_cache_req_cmp);
+    for (i = 1, j = 1; i < req_cnt; i++) {
+        if (0 == strcmp(reqs[j - 1].xpath, reqs[i].xpath)) {
+            rp_dp_cache_entry_free(reqs[i].entry);
+        } else {
+            reqs[j++] = reqs[i];
+        }
+    }
+    req_cnt = j;
+
+    /* split the values among the xpaths in one pass to count them and one pass to duplicate them */
+    for (i = 0; i < values_cnt; i++) {
+        rc = rp_dp_cache_split_value(reqs, req_cnt, &values[i], rp_dp_cache_count_value);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to split the values to be cached.");
+    }
+    for (i = 0; i < req_cnt; i++) {
+        entry = reqs[i].entry;
+        if (NULL != entry && entry->values_cnt > 0) {
+            entry->values = calloc(entry->values_cnt, sizeof(*entry->values));
+            CHECK_NULL_NOMEM_GOTO(entry->values, rc, cleanup);
+            entry->values_cnt = 0;
+        }
+    }
+    for (i = 0; i < values_cnt; i++) {
+        rc = rp_dp_cache_split_value(reqs, req_cnt, &values[i], rp_dp_cache_add_value);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to duplicate the values to be cached.");
+    }
+
+    /* insert the entries */
+    SR_MUTEX_LOCK(&cache->mutex, "dp_cache_mutex");
+    for (i = 0; i < req_cnt && SR_ERR_OK == rc; i++) {
+        if (NULL == reqs[i].entry) {
+            continue;
+        }
+        rc = rp_dp_cache_insert_locked(cache, reqs[i].entry, &now, &inserted);
+        if (SR_ERR_OK == rc && inserted) {
+            reqs[i].entry = NULL;
+        }
+    }
+    SR_MUTEX_UNLOCK(&cache->mutex);
+
+cleanup:
+    for (i = 0; i < req_cnt; i++) {
+        rp_dp_cache_entry_free(reqs[i].entry);
+    }
+    free(reqs);
+    return rc;
+}
+
+int
+rp_dp_cache_invalidate(rp_dp_cache_t *cache, const char *xpath)
+{
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG(cache);
+
+    SR_MUTEX_LOCK(&cache->mutex, "dp_cache_mutex");
+    rc = rp_dp_cache_remove_matching_locked(cache, rp_dp_cache_match_subtree, xpath);
+    SR_MUTEX_UNLOCK(&cache->mutex);
+
+    return rc;
+}
+
+void
+rp_dp_cache_get_stats(rp_dp_cache_t *cache, rp_dp_cache_stats_t *stats)
+{
+    CHECK_NULL_ARG_VOID2(cache, stats);
+
+    SR_MUTEX_LOCK(&cache->mutex, "dp_cache_mutex");
+    *stats = cache->stats;
+    stats->entries = cache->entry_cnt;
+    SR_MUTEX_UNLOCK(&cache->mutex);
+}
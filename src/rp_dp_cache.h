@@ -0,0 +1,126 @@
+/**
+ * @defgroup rp_dp_cache Operational data provider cache
+ * @ingroup rp
+ * @{
+ * @brief Cache of the values returned by operational data providers.
+ * @file rp_dp_cache.h
+ *
+ * Data providers may declare a validity period (TTL) of the data they provide when subscribing.
+ * Values returned for a requested xpath are then cached by the Request Processor and subsequent
+ * requests for the same xpath are served from the cache until the entry expires or is invalidated
+ * by ::rp_dp_cache_invalidate.
+ *
+ * @copyright
+ * Copyright 2016 Cisco Systems, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RP_DP_CACHE_H_
+#define RP_DP_CACHE_H_
+
+#include "sr_common.h"
+#include "notification_processor.h"
+
+/**
+ * @brief Maximum number of entries stored in the cache, the entry that expires first is evicted
+ * when a new entry is stored into a full cache.
+ */
+#define RP_DP_CACHE_MAX_ENTRIES 4096
+
+/**
+ * @brief Operational data provider cache context.
+ */
+typedef struct rp_dp_cache_s rp_dp_cache_t;
+
+/**
+ * @brief Statistics of the operational data provider cache.
+ */
+typedef struct rp_dp_cache_stats_s {
+    uint64_t hits;          /**< Number of requests served from the cache. */
+    uint64_t misses;        /**< Number of requests that had to be sent to a data provider. */
+    uint32_t entries;       /**< Number of entries currently stored in the cache. */
+} rp_dp_cache_stats_t;
+
+/**
+ * @brief Initializes the operational data provider cache.
+ *
+ * @param [out] cache Allocated cache context.
+ *
+ * @return Error code (SR_ERR_OK on success)
+ */
+int rp_dp_cache_init(rp_dp_cache_t **cache);
+
+/**
+ * @brief Frees all resources held by the cache.
+ *
+ * @param [in] cache Cache context acquired by ::rp_dp_cache_init.
+ */
+void rp_dp_cache_cleanup(rp_dp_cache_t *cache);
+
+/**
+ * @brief Looks up cached values for the xpath requested from the data provider subscription.
+ *
+ * Each call is accounted as a hit or a miss in the statistics.
+ *
+ * @param [in] cache Cache context.
+ * @param [in] subscription Data provider subscription the request would be addressed to.
+ * @param [in] xpath Requested xpath.
+ * @param [out] values Duplicated cached values (without Sysrepo memory context), to be freed by the caller.
+ * @param [out] values_cnt Number of the returned values.
+ *
+ * @return Error code (SR_ERR_OK on cache hit, SR_ERR_NOT_FOUND if there is no fresh entry
+ * for the xpath provided by the subscription)
+ */
+int rp_dp_cache_lookup(rp_dp_cache_t *cache, const np_subscription_t *subscription, const char *xpath,
+        sr_val_t **values, size_t *values_cnt);
+
+/**
+ * @brief Stores values provided for the requested xpaths of a response of the data providers that declared
+ * a validity period. The values are split among the xpaths in one pass, only the values under an xpath
+ * are stored for it. A fresh entry for an xpath is not replaced.
+ *
+ * @param [in] cache Cache context.
+ * @param [in] subscriptions Data provider subscription that provided the values of each xpath (NULL to skip the xpath).
+ * @param [in] xpaths Requested xpaths.
+ * @param [in] xpath_cnt Number of the requested xpaths.
+ * @param [in] values Values received from the data provider.
+ * @param [in] values_cnt Number of the values.
+ *
+ * @return Error code (SR_ERR_OK on success)
+ */
+int rp_dp_cache_store(rp_dp_cache_t *cache, const np_subscription_t **subscriptions, char **xpaths, size_t xpath_cnt,
+        const sr_val_t *values, size_t values_cnt);
+
+/**
+ * @brief Invalidates all cache entries of the xpaths in the subtree of the specified xpath
+ * and the entries whose subtree contains the specified xpath.
+ *
+ * @param [in] cache Cache context.
+ * @param [in] xpath XPath identifying the subtree, NULL to invalidate the whole cache.
+ *
+ * @return Error code (SR_ERR_OK on success)
+ */
+int rp_dp_cache_invalidate(rp_dp_cache_t *cache, const char *xpath);
+
+/**
+ * @brief Returns the statistics of the cache.
+ *
+ * @param [in] cache Cache context.
+ * @param [out] stats Statistics of the cache.
+ */
+void rp_dp_cache_get_stats(rp_dp_cache_t *cache, rp_dp_cache_stats_t *stats);
+
+/**@} rp_dp_cache */
+
+#endif /* RP_DP_CACHE_H_ */
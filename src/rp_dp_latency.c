@@ -0,0 +1,272 @@
+/**
+ * @file rp_dp_latency.c
+ * @brief Latency histograms of operational data providers.
+ *
+ * @copyright
+ * Copyright 2016 Cisco Systems, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include <pthread.h>
+
+#include "rp_dp_latency.h"
+
+/**
+ * @brief Upper bounds (in milliseconds) of the histogram buckets, 0 stands for unbounded.
+ */
+static const uint32_t rp_dp_latency_bounds[RP_DP_LATENCY_BUCKET_CNT] = { 1, 5, 10, 50, 100, 500, 1000, 0 };
+
+/**
+ * @brief Statistics of one data provider subscription stored in the context.
+ */
+typedef struct rp_dp_latency_entry_s {
+    rp_dp_latency_stats_t stats;    /**< Statistics of the subscription. */
+    uint64_t last_update;           /**< Sequence number of the last update of the statistics. */
+} rp_dp_latency_entry_t;
+
+/**
+ * @brief Latency statistics context.
+ */
+struct rp_dp_latency_s {
+    sr_btree_t *providers;      /**< Statistics of the data provider subscriptions (rp_dp_latency_entry_t *) ordered by xpath. */
+    size_t provider_cnt;        /**< Number of subscriptions with statistics. */
+    uint64_t update_seq;        /**< Sequence number of the last update. */
+    pthread_mutex_t mutex;      /**< Mutex guarding the statistics. */
+};
+
+/**
+ * @brief Compares two statistics entries by the xpath of the subscription.
+ */
+static int
+rp_dp_latency_entry_cmp(const void *a, const void *b)
+{
+    const rp_dp_latency_entry_t *entry_a = (const rp_dp_latency_entry_t *) a;
+    const rp_dp_latency_entry_t *entry_b = (const rp_dp_latency_entry_t *) b;
+    int res = strcmp(entry_a->stats.xpath, entry_b->stats.xpath);
+
+    if (res == 0) {
+        return 0;
+    } else if (res < 0) {
+        return -1;
+    } else {
+        return 1;
+    }
+}
+
+/**
+ * @brief Frees a statistics entry.
+ */
+static void
+rp_dp_latency_entry_free(void *item)
+{
+    rp_dp_latency_entry_t *entry = (rp_dp_latency_entry_t *) item;
+
+    if (NULL != entry) {
+        free(entry->stats.xpath);
+        free(entry);
+    }
+}
+
+/**
+ * @brief Drops the statistics that have not been updated for the longest time. Subscriptions
+ * come and go, the number of tracked xpaths is bounded. Statistics mutex is expected to be held.
+ */
+static void
+rp_dp_latency_evict_locked(rp_dp_latency_t *latency)
+{
+    rp_dp_latency_entry_t *entry = NULL, *oldest = NULL;
+    size_t i = 0;
+
+    while (NULL != (entry = sr_btree_get_at(latency->providers, i++))) {
+        if (NULL == oldest || entry->last_update < oldest->last_update) {
+            oldest = entry;
+        }
+    }
+    if (NULL != oldest) {
+        SR_LOG_DBG("Dropping latency statistics of '%s'.", oldest->stats.xpath);
+        sr_btree_delete(latency->providers, oldest);
+        latency->provider_cnt--;
+    }
+}
+
+/**
+ * @brief Returns statistics of the data provider subscription, creates them if they do not exist yet.
+ * Statistics mutex is expected to be held.
+ */
+static int
+rp_dp_latency_get_provider_locked(rp_dp_latency_t *latency, const char *xpath, rp_dp_latency_stats_t **stats_p)
+{
+    rp_dp_latency_entry_t lookup = { .stats.xpath = (char *) xpath, };
+    rp_dp_latency_entry_t *entry = NULL;
+    int rc = SR_ERR_OK;
+
+    entry = sr_btree_search(latency->providers, &lookup);
+    if (NULL == entry) {
+        if (latency->provider_cnt >= RP_DP_LATENCY_MAX_PROVIDERS) {
+            rp_dp_latency_evict_locked(latency);
+        }
+
+        entry = calloc(1, sizeof(*entry));
+        CHECK_NULL_NOMEM_RETURN(entry);
+        entry->stats.xpath = strdup(xpath);
+        CHECK_NULL_NOMEM_GOTO(entry->stats.xpath, rc, cleanup);
+
+        rc = sr_btree_insert(latency->providers, entry);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Binary tree insert failed");
+        latency->provider_cnt++;
+    }
+
+    entry->last_update = ++latency->update_seq;
+    *stats_p = &entry->stats;
+    return SR_ERR_OK;
+
+cleanup:
+    rp_dp_latency_entry_free(entry);
+    return rc;
+}
+
+int
+rp_dp_latency_init(rp_dp_latency_t **latency_p)
+{
+    rp_dp_latency_t *latency = NULL;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG(latency_p);
+
+    latency = calloc(1, sizeof(*latency));
+    CHECK_NULL_NOMEM_RETURN(latency);
+
+    rc = sr_btree_init(rp_dp_latency_entry_cmp, rp_dp_latency_entry_free, &latency->providers);
+    if (SR_ERR_OK != rc) {
+        SR_LOG_ERR_MSG("Unable to initialize the latency statistics of data providers.");
+        free(latency);
+        return rc;
+    }
+    pthread_mutex_init(&latency->mutex, NULL);
+
+    *latency_p = latency;
+    return SR_ERR_OK;
+}
+
+void
+rp_dp_latency_cleanup(rp_dp_latency_t *latency)
+{
+    if (NULL != latency) {
+        sr_btree_cleanup(latency->providers);
+        pthread_mutex_destroy(&latency->mutex);
+        free(latency);
+    }
+}
+
+int
+rp_dp_latency_record(rp_dp_latency_t *latency, const char *xpath, uint64_t latency_ms)
+{
+    rp_dp_latency_stats_t *stats = NULL;
+    size_t bucket = 0;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG2(latency, xpath);
+
+    while (bucket < RP_DP_LATENCY_BUCKET_CNT - 1 && latency_ms > rp_dp_latency_bounds[bucket]) {
+        bucket++;
+    }
+
+    pthread_mutex_lock(&latency->mutex);
+
+    rc = rp_dp_latency_get_provider_locked(latency, xpath, &stats);
+    if (SR_ERR_OK == rc) {
+        stats->request_cnt++;
+        stats->latency_total += latency_ms;
+        if (latency_ms > stats->latency_max) {
+            stats->latency_max = latency_ms;
+        }
+        stats->buckets[bucket]++;
+    }
+
+    pthread_mutex_unlock(&latency->mutex);
+
+    return rc;
+}
+
+int
+rp_dp_latency_record_timeout(rp_dp_latency_t *latency, const char *xpath)
+{
+    rp_dp_latency_stats_t *stats = NULL;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG2(latency, xpath);
+
+    pthread_mutex_lock(&latency->mutex);
+
+    rc = rp_dp_latency_get_provider_locked(latency, xpath, &stats);
+    if (SR_ERR_OK == rc) {
+        stats->timeout_cnt++;
+    }
+
+    pthread_mutex_unlock(&latency->mutex);
+
+    return rc;
+}
+
+uint32_t
+rp_dp_latency_bucket_bound(size_t bucket)
+{
+    return (bucket < RP_DP_LATENCY_BUCKET_CNT) ? rp_dp_latency_bounds[bucket] : 0;
+}
+
+int
+rp_dp_latency_get_stats(rp_dp_latency_t *latency, rp_dp_latency_stats_t **stats_p, size_t *stats_cnt_p)
+{
+    rp_dp_latency_entry_t *entry = NULL;
+    rp_dp_latency_stats_t *stats = NULL;
+    size_t cnt = 0;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG3(latency, stats_p, stats_cnt_p);
+
+    pthread_mutex_lock(&latency->mutex);
+
+    if (latency->provider_cnt > 0) {
+        stats = calloc(latency->provider_cnt, sizeof(*stats));
+        CHECK_NULL_NOMEM_GOTO(stats, rc, cleanup);
+        while (NULL != (entry = sr_btree_get_at(latency->providers, cnt))) {
+            stats[cnt] = entry->stats;
+            stats[cnt].xpath = strdup(entry->stats.xpath);
+            cnt++;
+            CHECK_NULL_NOMEM_GOTO(stats[cnt - 1].xpath, rc, cleanup);
+        }
+    }
+
+cleanup:
+    pthread_mutex_unlock(&latency->mutex);
+    if (SR_ERR_OK != rc) {
+        rp_dp_latency_free_stats(stats, cnt);
+        return rc;
+    }
+    *stats_p = stats;
+    *stats_cnt_p = cnt;
+    return SR_ERR_OK;
+}
+
+void
+rp_dp_latency_free_stats(rp_dp_latency_stats_t *stats, size_t stats_cnt)
+{
+    if (NULL != stats) {
+        for (size_t i = 0; i < stats_cnt; i++) {
+            free(stats[i].xpath);
+        }
+        free(stats);
+    }
+}
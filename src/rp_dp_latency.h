@@ -0,0 +1,128 @@
+/**
+ * @defgroup rp_dp_latency Operational data provider latency statistics
+ * @ingroup rp
+ * @{
+ * @brief Latency histograms of operational data providers.
+ * @file rp_dp_latency.h
+ *
+ * The time between sending a data provide request and receiving the response is recorded for each
+ * data provider subscription (identified by the subscribed xpath) into a histogram, together with the
+ * number of requests that have not been answered in time. The statistics are exposed
+ * in sysrepo-monitoring module so that slow providers can be identified.
+ *
+ * @copyright
+ * Copyright 2016 Cisco Systems, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RP_DP_LATENCY_H_
+#define RP_DP_LATENCY_H_
+
+#include "sr_common.h"
+
+/**
+ * @brief Number of buckets of the latency histogram (the last one is unbounded).
+ */
+#define RP_DP_LATENCY_BUCKET_CNT 8
+
+/**
+ * @brief Maximum number of subscriptions with statistics, the least recently updated ones are dropped.
+ */
+#define RP_DP_LATENCY_MAX_PROVIDERS 1024
+
+/**
+ * @brief Latency statistics context.
+ */
+typedef struct rp_dp_latency_s rp_dp_latency_t;
+
+/**
+ * @brief Latency statistics of one data provider subscription.
+ */
+typedef struct rp_dp_latency_stats_s {
+    char *xpath;                                    /**< XPath the data provider is subscribed for. */
+    uint64_t request_cnt;                           /**< Number of answered requests. */
+    uint64_t timeout_cnt;                           /**< Number of requests not answered in time. */
+    uint64_t latency_total;                         /**< Sum of latencies of answered requests (in milliseconds). */
+    uint64_t latency_max;                           /**< Maximum latency of an answered request (in milliseconds). */
+    uint64_t buckets[RP_DP_LATENCY_BUCKET_CNT];     /**< Histogram of latencies of answered requests. */
+} rp_dp_latency_stats_t;
+
+/**
+ * @brief Initializes the latency statistics.
+ *
+ * @param [out] latency Allocated statistics context.
+ *
+ * @return Error code (SR_ERR_OK on success)
+ */
+int rp_dp_latency_init(rp_dp_latency_t **latency);
+
+/**
+ * @brief Frees all resources held by the latency statistics.
+ *
+ * @param [in] latency Statistics context acquired by ::rp_dp_latency_init.
+ */
+void rp_dp_latency_cleanup(rp_dp_latency_t *latency);
+
+/**
+ * @brief Records the latency of a response received from a data provider.
+ *
+ * @param [in] latency Statistics context.
+ * @param [in] xpath XPath the data provider is subscribed for.
+ * @param [in] latency_ms Time between sending the request and receiving the response (in milliseconds).
+ *
+ * @return Error code (SR_ERR_OK on success)
+ */
+int rp_dp_latency_record(rp_dp_latency_t *latency, const char *xpath, uint64_t latency_ms);
+
+/**
+ * @brief Records a request that has not been answered by a data provider in time.
+ *
+ * @param [in] latency Statistics context.
+ * @param [in] xpath XPath the data provider is subscribed for.
+ *
+ * @return Error code (SR_ERR_OK on success)
+ */
+int rp_dp_latency_record_timeout(rp_dp_latency_t *latency, const char *xpath);
+
+/**
+ * @brief Returns the upper bound (in milliseconds) of a histogram bucket.
+ *
+ * @param [in] bucket Index of the bucket.
+ *
+ * @return Upper bound of the bucket, 0 for the last (unbounded) bucket.
+ */
+uint32_t rp_dp_latency_bucket_bound(size_t bucket);
+
+/**
+ * @brief Returns a copy of the statistics of all data provider subscriptions.
+ *
+ * @param [in] latency Statistics context.
+ * @param [out] stats Array of statistics, to be freed by ::rp_dp_latency_free_stats.
+ * @param [out] stats_cnt Number of the array items.
+ *
+ * @return Error code (SR_ERR_OK on success)
+ */
+int rp_dp_latency_get_stats(rp_dp_latency_t *latency, rp_dp_latency_stats_t **stats, size_t *stats_cnt);
+
+/**
+ * @brief Frees the statistics returned by ::rp_dp_latency_get_stats.
+ *
+ * @param [in] stats Array of statistics.
+ * @param [in] stats_cnt Number of the array items.
+ */
+void rp_dp_latency_free_stats(rp_dp_latency_stats_t *stats, size_t stats_cnt);
+
+/**@} rp_dp_latency */
+
+#endif /* RP_DP_LATENCY_H_ */
@@ -329,11 +329,11 @@ rp_dt_set_item(dm_ctx_t *dm_ctx, dm_session_t *session, const char *xpath, const
     module = schema_info->module;
     if (NULL == sch_node) {
         SR_LOG_ERR("Node can not be created or update %s", xpath);
-        pthread_rwlock_unlock(&schema_info->model_lock);
+        SR_RWLOCK_UNLOCK(&schema_info->model_lock);
         return SR_ERR_INVAL_ARG;
     }
     module_name = strdup(module->name);
-    pthread_rwlock_unlock(&schema_info->model_lock);
+    SR_RWLOCK_UNLOCK(&schema_info->model_lock);
     CHECK_NULL_NOMEM_RETURN(module_name);
 
 
@@ -467,7 +467,7 @@ rp_dt_move_list(dm_ctx_t *dm_ctx, dm_session_t *session, const char *xpath, sr_m
     CHECK_RC_LOG_RETURN(rc, "Requested node is not valid %s", xpath);
 
     module_name = strdup(schema_info->module_name);
-    pthread_rwlock_unlock(&schema_info->model_lock);
+    SR_RWLOCK_UNLOCK(&schema_info->model_lock);
     CHECK_NULL_NOMEM_RETURN(module_name);
 
     rc = dm_get_data_info(dm_ctx, session, module_name, &info);
@@ -788,6 +788,36 @@ rp_dt_reload_nacm(rp_ctx_t *rp_ctx)
     return rc;
 }
 
+/**
+ * @brief Returns name of the commit phase used in request traces.
+ */
+static const char *
+rp_dt_commit_state_name(dm_commit_state_t state)
+{
+    switch (state) {
+    case DM_COMMIT_VALIDATION:
+        return "validate";
+    case DM_COMMIT_LOAD_MODIFIED_MODELS:
+        return "load-models";
+    case DM_COMMIT_REPLAY_OPS:
+        return "replay";
+    case DM_COMMIT_VALIDATE_MERGED:
+        return "validate-merged";
+    case DM_COMMIT_NACM:
+        return "nacm";
+    case DM_COMMIT_NOTIFY_VERIFY:
+        return "notify-verify";
+    case DM_COMMIT_WRITE:
+        return "write";
+    case DM_COMMIT_NOTIFY_APPLY:
+        return "notify-apply";
+    case DM_COMMIT_NOTIFY_ABORT:
+        return "notify-abort";
+    default:
+        return "commit";
+    }
+}
+
 int
 rp_dt_commit(rp_ctx_t *rp_ctx, rp_session_t *session, dm_commit_context_t *c_ctx, sr_error_info_t **errors, size_t *err_cnt)
 {
@@ -806,8 +836,11 @@ rp_dt_commit(rp_ctx_t *rp_ctx, rp_session_t *session, dm_commit_context_t *c_ctx
     dm_commit_context_t *commit_ctx = c_ctx;
     dm_commit_state_t state = NULL != commit_ctx ? commit_ctx->state : DM_COMMIT_STARTED;
     nacm_ctx_t *nacm_ctx = NULL;
+    sr_trace_span_t span = { 0, };
 
     while (state != DM_COMMIT_FINISHED) {
+        SR_PROBE2(commit__state, (NULL != commit_ctx ? commit_ctx->id : 0), state);
+        SR_TRACE_BEGIN(&span, sr_trace_get_current(), "commit", rp_dt_commit_state_name(state));
         switch (state) {
         case DM_COMMIT_STARTED:
             SR_LOG_DBG_MSG("Commit (1/10): process started");
@@ -817,6 +850,7 @@ rp_dt_commit(rp_ctx_t *rp_ctx, rp_session_t *session, dm_commit_context_t *c_ctx
             rc = dm_validate_session_data_trees(rp_ctx->dm_ctx, session->dm_session, errors, err_cnt);
             if (SR_ERR_OK != rc) {
                 SR_LOG_ERR("Data validation failed: %s", *err_cnt > 0 ? errors[0]->message : "(no error)");
+                SR_TRACE_END(&span);
                 return SR_ERR_VALIDATION_FAILED;
             }
             SR_LOG_DBG_MSG("Commit (2/10): validation succeeded");
@@ -824,12 +858,13 @@ rp_dt_commit(rp_ctx_t *rp_ctx, rp_session_t *session, dm_commit_context_t *c_ctx
             break;
         case DM_COMMIT_LOAD_MODIFIED_MODELS:
             rc = dm_commit_prepare_context(rp_ctx->dm_ctx, session->dm_session, &commit_ctx);
-            CHECK_RC_MSG_RETURN(rc, "commit prepare context failed");
+            CHECK_RC_MSG_GOTO(rc, cleanup, "commit prepare context failed");
             commit_ctx->init_session = session;
             if (0 == commit_ctx->modif_count) {
                 SR_LOG_DBG_MSG("Commit: Finished - no model modified");
                 dm_free_commit_context(commit_ctx);
-                return SR_ERR_OK;
+                commit_ctx = NULL;
+                goto cleanup;
             }
             pthread_mutex_lock(&commit_ctx->mutex);
             commit_ctx->disabled_config_change = rp_ctx->do_not_generate_config_change;
@@ -880,6 +915,7 @@ rp_dt_commit(rp_ctx_t *rp_ctx, rp_session_t *session, dm_commit_context_t *c_ctx
             SR_LOG_DBG("Commit %"PRIu32" processing paused waiting for replies from verifiers", commit_ctx->id);
             session->state = RP_REQ_WAITING_FOR_VERIFIERS;
             pthread_mutex_unlock(&commit_ctx->mutex);
+            SR_TRACE_END(&span);
             return rc;
         case DM_COMMIT_WRITE:
             rc = dm_commit_writelock_fds(session->dm_session, commit_ctx);
@@ -921,8 +957,10 @@ rp_dt_commit(rp_ctx_t *rp_ctx, rp_session_t *session, dm_commit_context_t *c_ctx
         default:
             break;
         }
+        SR_TRACE_END(&span);
     }
 cleanup:
+    SR_TRACE_END(&span);
     if (NULL != commit_ctx) {
         remove_ctx = commit_ctx->should_be_removed;
         c_id = commit_ctx->id;
@@ -930,8 +968,8 @@ cleanup:
         if (!commit_ctx->in_btree) {
             free_ctx = true;
         }
+        pthread_mutex_unlock(&commit_ctx->mutex);
     }
-    pthread_mutex_unlock(&commit_ctx->mutex);
 
     /* cleanup commit context that was already inserted into btree */
     if (remove_ctx) {
@@ -948,7 +986,7 @@ cleanup:
         dm_free_commit_context(commit_ctx);
     }
 
-    if (SR_ERR_OK == rc) {
+    if (SR_ERR_OK == rc && DM_COMMIT_FINISHED == state) {
         /* discard changes in session in next get_data_tree call newly committed content will be loaded */
         if (SR_DS_CANDIDATE != session->datastore) {
             rc = dm_discard_changes(rp_ctx->dm_ctx, session->dm_session);
@@ -25,6 +25,19 @@
 #include "data_manager.h"
 #include "rp_dt_filter.h"
 
+/**
+ * @brief Returns true if the node is the given subtree root or one of its descendants.
+ */
+static bool
+rp_dt_node_in_subtree(const struct lyd_node *node, const struct lyd_node *root)
+{
+    for (; NULL != node; node = node->parent) {
+        if (node == root) {
+            return true;
+        }
+    }
+    return false;
+}
 
 int
 rp_dt_nacm_filtering(dm_ctx_t *dm_ctx, rp_session_t *rp_session, struct lyd_node *data_tree,
@@ -34,9 +47,10 @@ rp_dt_nacm_filtering(dm_ctx_t *dm_ctx, rp_session_t *rp_session, struct lyd_node
     unsigned int i = 0, j = 0;
     nacm_ctx_t *nacm_ctx = NULL;
     nacm_data_val_ctx_t *nacm_data_val_ctx = NULL;
-    nacm_action_t nacm_action = NACM_ACTION_PERMIT;
-    const char *rule_name = NULL, *rule_info = NULL;
-    struct lyd_node *node = NULL;
+    nacm_action_t nacm_action = NACM_ACTION_PERMIT, subtree_action = NACM_ACTION_PERMIT;
+    const char *rule_name = NULL, *rule_info = NULL, *subtree_rule_name = NULL, *subtree_rule_info = NULL;
+    bool subtree = false;
+    struct lyd_node *node = NULL, *subtree_root = NULL;
     CHECK_NULL_ARG4(dm_ctx, rp_session, nodes, node_cnt);
 
     rc = dm_get_nacm_ctx(dm_ctx, &nacm_ctx);
@@ -53,9 +67,21 @@ rp_dt_nacm_filtering(dm_ctx_t *dm_ctx, rp_session_t *rp_session, struct lyd_node
     /* check read permission for each node */
     for (i = 0; i < *node_cnt; ++i) {
         node = nodes[i];
-        rule_name = rule_info = NULL;
-        rc = nacm_check_data(nacm_data_val_ctx, NACM_ACCESS_READ, node, &nacm_action, &rule_name, &rule_info);
-        CHECK_RC_LOG_GOTO(rc, cleanup, "NACM data validation failed for node: %s.", node->schema->name);
+        if (NULL != subtree_root && rp_dt_node_in_subtree(node, subtree_root)) {
+            /* the outcome for the whole subtree is already known */
+            nacm_action = subtree_action;
+            rule_name = subtree_rule_name;
+            rule_info = subtree_rule_info;
+        } else {
+            rule_name = rule_info = NULL;
+            rc = nacm_check_data_subtree(nacm_data_val_ctx, NACM_ACCESS_READ, node, &nacm_action, &rule_name,
+                    &rule_info, &subtree);
+            CHECK_RC_LOG_GOTO(rc, cleanup, "NACM data validation failed for node: %s.", node->schema->name);
+            subtree_root = subtree ? node : NULL;
+            subtree_action = nacm_action;
+            subtree_rule_name = rule_name;
+            subtree_rule_info = rule_info;
+        }
         if (NACM_ACTION_DENY == nacm_action) {
             nacm_report_read_access_denied(rp_session->user_credentials, node, rule_name, rule_info);
             nodes[i] = NULL; /* omit the node from the result */
@@ -95,14 +121,19 @@ rp_dt_tree_pruning(void *pruning_ctx_p, const struct lyd_node *subtree, bool *pr
     int rc = SR_ERR_OK;
     nacm_action_t nacm_action = NACM_ACTION_PERMIT;
     const char *rule_name = NULL, *rule_info = NULL;
+    bool whole_subtree = false;
     rp_tree_pruning_ctx_t *pruning_ctx = (rp_tree_pruning_ctx_t *)pruning_ctx_p;
     CHECK_NULL_ARG3(pruning_ctx, subtree, prune);
 
-    /* check read access */
-    if (NULL != pruning_ctx->nacm_data_val_ctx) {
-        rc = nacm_check_data(pruning_ctx->nacm_data_val_ctx, NACM_ACCESS_READ, subtree, &nacm_action,
-                &rule_name, &rule_info);
+    /* check read access (unless the subtree lies within a subtree readable as a whole) */
+    if (NULL != pruning_ctx->nacm_data_val_ctx &&
+        (NULL == pruning_ctx->readable_subtree || !rp_dt_node_in_subtree(subtree, pruning_ctx->readable_subtree))) {
+        rc = nacm_check_data_subtree(pruning_ctx->nacm_data_val_ctx, NACM_ACCESS_READ, subtree, &nacm_action,
+                &rule_name, &rule_info, &whole_subtree);
         CHECK_RC_LOG_RETURN(rc, "NACM data validation failed for node: %s.", subtree->schema->name);
+        if (NACM_ACTION_PERMIT == nacm_action && whole_subtree) {
+            pruning_ctx->readable_subtree = subtree;
+        }
         if (NACM_ACTION_DENY == nacm_action) {
             nacm_report_read_access_denied(pruning_ctx->nacm_data_val_ctx->user_credentials, subtree,
                     rule_name, rule_info);
@@ -147,6 +178,7 @@ rp_dt_init_tree_pruning(dm_ctx_t *dm_ctx, rp_session_t *rp_session, struct lyd_n
     nacm_ctx_t *nacm_ctx = NULL;
     nacm_action_t nacm_action = NACM_ACTION_PERMIT;
     const char *rule_name = NULL, *rule_info;
+    bool whole_subtree = false;
 
     rc = dm_get_nacm_ctx(dm_ctx, &nacm_ctx);
     CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to get NACM context.");
@@ -156,9 +188,12 @@ rp_dt_init_tree_pruning(dm_ctx_t *dm_ctx, rp_session_t *rp_session, struct lyd_n
                 &pruning_ctx->nacm_data_val_ctx);
         CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to start NACM data validation.");
         if (NULL != root) {
-            rc = nacm_check_data(pruning_ctx->nacm_data_val_ctx, NACM_ACCESS_READ, root, &nacm_action,
-                    &rule_name, &rule_info);
+            rc = nacm_check_data_subtree(pruning_ctx->nacm_data_val_ctx, NACM_ACCESS_READ, root, &nacm_action,
+                    &rule_name, &rule_info, &whole_subtree);
             CHECK_RC_LOG_GOTO(rc, cleanup, "NACM data validation failed for node: %s.", root->schema->name);
+            if (NACM_ACTION_PERMIT == nacm_action && whole_subtree) {
+                pruning_ctx->readable_subtree = root;
+            }
             if (NACM_ACTION_DENY == nacm_action) {
                 nacm_report_read_access_denied(rp_session->user_credentials, root, rule_name, rule_info);
                 rc = SR_ERR_UNAUTHORIZED;
@@ -36,6 +36,8 @@
 typedef struct rp_tree_pruning_ctx_s {
     bool check_enabled;
     nacm_data_val_ctx_t *nacm_data_val_ctx;
+    const struct lyd_node *readable_subtree;  /**< Root of the last subtree readable as a whole, its descendants
+                                                   are not checked against NACM rules. */
 } rp_tree_pruning_ctx_t;
 
 /**
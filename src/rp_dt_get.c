@@ -31,6 +31,20 @@
 #include "rp_dt_xpath.h"
 #include "rp_dt_edit.h"
 #include "rp_dt_filter.h"
+#include "rp_dt_lookup.h"
+
+/**
+ * @brief Frees a record of a request sent to a data provider.
+ */
+static void
+rp_dt_free_pending_dp_req(rp_dp_pending_req_t *pending)
+{
+    if (NULL != pending) {
+        free(pending->xpath);
+        free(pending->subscription_xpath);
+        free(pending);
+    }
+}
 
 void
 rp_dt_free_state_data_ctx_content (rp_state_data_ctx_t *state_data)
@@ -54,12 +68,14 @@ rp_dt_free_state_data_ctx_content (rp_state_data_ctx_t *state_data)
         sr_list_cleanup(state_data->subscription_nodes);
         state_data->subscription_nodes = NULL;
 
-        if (NULL != state_data->requested_xpaths) {
-            for (size_t i = 0; i < state_data->requested_xpaths->count; i++) {
-                free(state_data->requested_xpaths->data[i]);
+        sr_btree_cleanup(state_data->requested_xpaths);
+        state_data->requested_xpaths = NULL;
+        if (NULL != state_data->pending_dp_reqs) {
+            for (size_t i = 0; i < state_data->pending_dp_reqs->count; i++) {
+                rp_dt_free_pending_dp_req(state_data->pending_dp_reqs->data[i]);
             }
-            sr_list_cleanup(state_data->requested_xpaths);
-            state_data->requested_xpaths = NULL;
+            sr_list_cleanup(state_data->pending_dp_reqs);
+            state_data->pending_dp_reqs = NULL;
         }
         state_data->overlapping_leaf_subscription = false;
         state_data->internal_state_data = false;
@@ -925,6 +941,360 @@ cleanup:
     return rc;
 }
 
+/**
+ * @brief Compares two requested xpaths stored in the binary tree.
+ */
+static int
+rp_dt_requested_xpath_cmp(const void *a, const void *b)
+{
+    int res = strcmp((const char *) a, (const char *) b);
+
+    if (res == 0) {
+        return 0;
+    } else if (res < 0) {
+        return -1;
+    } else {
+        return 1;
+    }
+}
+
+/**
+ * @brief Moves xpaths marked in the mask from the list into the tree of requested xpaths.
+ */
+static int
+rp_dt_move_requested_xpaths(rp_session_t *rp_session, sr_list_t *xpaths, const bool *mask)
+{
+    int rc = SR_ERR_OK;
+
+    for (size_t i = 0; i < xpaths->count; i++) {
+        if (mask[i] && NULL != xpaths->data[i]) {
+            rc = sr_btree_insert(rp_session->state_data_ctx.requested_xpaths, xpaths->data[i]);
+            if (SR_ERR_DATA_EXISTS == rc) {
+                /* already waiting for the response */
+                SR_LOG_DBG("Xpath '%s' has already been requested.", (char *) xpaths->data[i]);
+                free(xpaths->data[i]);
+                rc = SR_ERR_OK;
+            }
+            CHECK_RC_MSG_RETURN(rc, "Binary tree insert failed");
+            xpaths->data[i] = NULL;
+        }
+    }
+    return rc;
+}
+
+/**
+ * @brief Generates a data provide response with the cached values of the xpaths marked in the mask
+ * and enqueues it for processing.
+ */
+static int
+rp_dt_enqueue_cached_dp_resp(rp_ctx_t *rp_ctx, rp_session_t *rp_session, sr_list_t *xpaths, const bool *mask,
+        size_t hit_cnt, sr_val_t **values, size_t *values_cnt)
+{
+    Sr__Msg *msg = NULL;
+    Sr__DataProvideResp *dp_resp = NULL;
+    size_t total = 0, x = 0;
+    int rc = SR_ERR_OK;
+
+    rc = sr_gpb_resp_alloc(NULL, SR__OPERATION__DATA_PROVIDE, rp_session->id, &msg);
+    CHECK_RC_MSG_RETURN(rc, "Allocation of data-provide response failed.");
+    dp_resp = msg->response->data_provide_resp;
+    dp_resp->request_id = rp_session->req->request->_id;
+
+    if (hit_cnt > 1) {
+        dp_resp->xpaths = calloc(hit_cnt, sizeof(*dp_resp->xpaths));
+        CHECK_NULL_NOMEM_GOTO(dp_resp->xpaths, rc, cleanup);
+        dp_resp->n_xpaths = hit_cnt;
+    }
+    for (size_t i = 0; i < xpaths->count; i++) {
+        if (!mask[i]) {
+            continue;
+        }
+        if (NULL == dp_resp->xpath) {
+            dp_resp->xpath = strdup(xpaths->data[i]);
+            CHECK_NULL_NOMEM_GOTO(dp_resp->xpath, rc, cleanup);
+        }
+        if (hit_cnt > 1) {
+            dp_resp->xpaths[x] = strdup(xpaths->data[i]);
+            CHECK_NULL_NOMEM_GOTO(dp_resp->xpaths[x], rc, cleanup);
+        }
+        x++;
+        total += values_cnt[i];
+    }
+
+    /* copy cached values to GPB */
+    if (total > 0) {
+        dp_resp->values = calloc(total, sizeof(*dp_resp->values));
+        CHECK_NULL_NOMEM_GOTO(dp_resp->values, rc, cleanup);
+        for (size_t i = 0; i < xpaths->count; i++) {
+            for (size_t j = 0; mask[i] && j < values_cnt[i]; j++) {
+                rc = sr_dup_val_t_to_gpb(&values[i][j], &dp_resp->values[dp_resp->n_values]);
+                CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to duplicate cached value to GPB.");
+                dp_resp->n_values++;
+            }
+        }
+    }
+
+    SR_LOG_DBG("Operational data of %zu xpath(s) (%s, ...) served from the cache", hit_cnt, dp_resp->xpath);
+
+    /* the response will be processed as if it has been sent by the data provider */
+    rc = rp_dt_move_requested_xpaths(rp_session, xpaths, mask);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to store requested xpaths");
+    rp_session->dp_req_waiting += 1;
+
+    rc = rp_msg_process(rp_ctx, rp_session, msg);
+    msg = NULL;
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to enqueue cached data provide response");
+
+cleanup:
+    sr_msg_free(msg);
+    return rc;
+}
+
+/**
+ * @brief Schedules a check of the per-provider deadline of the requests sent to data providers.
+ */
+static int
+rp_dt_set_dp_provider_timeout(rp_ctx_t *rp_ctx, rp_session_t *rp_session)
+{
+    Sr__Msg *msg = NULL;
+    sr_mem_ctx_t *sr_mem = NULL;
+    int rc = SR_ERR_OK;
+
+    rc = sr_mem_new(0, &sr_mem);
+    if (SR_ERR_OK == rc) {
+        rc = sr_gpb_internal_req_alloc(sr_mem, SR__OPERATION__OPER_DATA_TIMEOUT, &msg);
+    }
+    if (SR_ERR_OK == rc) {
+        msg->session_id = rp_session->id;
+        msg->internal_request->oper_data_timeout_req->request_id = rp_session->req->request->_id;
+        msg->internal_request->oper_data_timeout_req->has_provider_timeout = true;
+        msg->internal_request->oper_data_timeout_req->provider_timeout = true;
+        msg->internal_request->postpone_timeout = SR_OPER_DATA_PROVIDER_TIMEOUT;
+        msg->internal_request->has_postpone_timeout = true;
+        rc = cm_msg_send(rp_ctx->cm_ctx, msg);
+    }
+
+    if (SR_ERR_OK != rc) {
+        sr_mem_free(sr_mem);
+        SR_LOG_ERR("Unable to setup a timeout for data provider request: %s.", sr_strerror(rc));
+    }
+
+    return rc;
+}
+
+/**
+ * @brief Returns the number of milliseconds elapsed between the two points in time.
+ */
+static uint64_t
+rp_dt_elapsed_ms(const struct timespec *from, const struct timespec *to)
+{
+    return (to->tv_sec - from->tv_sec) * 1000 + (to->tv_nsec - from->tv_nsec) / 1000000;
+}
+
+/**
+ * @brief Records a request sent to a data provider so that its latency and deadline can be tracked.
+ */
+static int
+rp_dt_add_pending_dp_req(rp_ctx_t *rp_ctx, rp_session_t *rp_session, np_subscription_t *subscription,
+        const char *xpath, size_t xpath_cnt)
+{
+    rp_dp_pending_req_t *pending = NULL;
+    int rc = SR_ERR_OK;
+
+    if (NULL == rp_session->state_data_ctx.pending_dp_reqs) {
+        rc = sr_list_init(&rp_session->state_data_ctx.pending_dp_reqs);
+        CHECK_RC_MSG_RETURN(rc, "List init failed");
+    }
+
+    pending = calloc(1, sizeof(*pending));
+    CHECK_NULL_NOMEM_RETURN(pending);
+    pending->xpath = strdup(xpath);
+    CHECK_NULL_NOMEM_GOTO(pending->xpath, rc, cleanup);
+    pending->subscription_xpath = strdup(subscription->xpath);
+    CHECK_NULL_NOMEM_GOTO(pending->subscription_xpath, rc, cleanup);
+    pending->xpath_cnt = xpath_cnt;
+    sr_clock_get_time(CLOCK_MONOTONIC, &pending->sent);
+
+    rc = sr_list_add(rp_session->state_data_ctx.pending_dp_reqs, pending);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "List add failed");
+    pending = NULL;
+
+    if (SR_OPER_DATA_PROVIDER_TIMEOUT < SR_OPER_DATA_PROVIDE_TIMEOUT) {
+        rc = rp_dt_set_dp_provider_timeout(rp_ctx, rp_session);
+    }
+
+cleanup:
+    rp_dt_free_pending_dp_req(pending);
+    return rc;
+}
+
+bool
+rp_dt_dp_response_received(rp_ctx_t *rp_ctx, rp_session_t *rp_session, const char *xpath)
+{
+    sr_list_t *pending_reqs = NULL;
+    rp_dp_pending_req_t *pending = NULL;
+    struct timespec now = { 0, };
+    uint64_t latency_ms = 0;
+    bool accept = true;
+
+    if (NULL == rp_ctx || NULL == rp_session || NULL == xpath) {
+        return true;
+    }
+
+    pending_reqs = rp_session->state_data_ctx.pending_dp_reqs;
+    if (NULL == pending_reqs) {
+        return true;
+    }
+
+    for (size_t i = 0; i < pending_reqs->count; i++) {
+        pending = pending_reqs->data[i];
+        if (0 != strcmp(pending->xpath, xpath)) {
+            continue;
+        }
+        if (pending->timed_out) {
+            SR_LOG_WRN("Data provider subscribed for '%s' answered after its deadline, the response is ignored.",
+                    pending->subscription_xpath);
+            accept = false;
+        } else {
+            sr_clock_get_time(CLOCK_MONOTONIC, &now);
+            latency_ms = rp_dt_elapsed_ms(&pending->sent, &now);
+            SR_LOG_DBG("Data provider subscribed for '%s' answered in %" PRIu64 " ms.", pending->subscription_xpath, latency_ms);
+            if (SR_ERR_OK != rp_dp_latency_record(rp_ctx->dp_latency, pending->subscription_xpath, latency_ms)) {
+                SR_LOG_WRN_MSG("Failed to record the latency of a data provider.");
+            }
+        }
+        rp_dt_free_pending_dp_req(pending);
+        sr_list_rm_at(pending_reqs, i);
+        break;
+    }
+
+    return accept;
+}
+
+size_t
+rp_dt_dp_requests_timeout(rp_ctx_t *rp_ctx, rp_session_t *rp_session, bool all)
+{
+    sr_list_t *pending_reqs = NULL;
+    rp_dp_pending_req_t *pending = NULL;
+    struct timespec now = { 0, };
+    size_t cnt = 0;
+
+    if (NULL == rp_ctx || NULL == rp_session) {
+        return 0;
+    }
+
+    pending_reqs = rp_session->state_data_ctx.pending_dp_reqs;
+    if (NULL == pending_reqs) {
+        return 0;
+    }
+
+    sr_clock_get_time(CLOCK_MONOTONIC, &now);
+
+    for (size_t i = 0; i < pending_reqs->count; i++) {
+        pending = pending_reqs->data[i];
+        if (pending->timed_out || (!all && rp_dt_elapsed_ms(&pending->sent, &now) < SR_OPER_DATA_PROVIDER_TIMEOUT * 1000)) {
+            continue;
+        }
+        SR_LOG_WRN("Data provider subscribed for '%s' has not provided data of '%s' (%zu xpath(s)) in time.",
+                pending->subscription_xpath, pending->xpath, pending->xpath_cnt);
+        pending->timed_out = true;
+        if (SR_ERR_OK != rp_dp_latency_record_timeout(rp_ctx->dp_latency, pending->subscription_xpath)) {
+            SR_LOG_WRN_MSG("Failed to record the timeout of a data provider.");
+        }
+        if (NULL == rp_session->dp_timed_out_xpath) {
+            rp_session->dp_timed_out_xpath = strdup(pending->xpath);
+        }
+        rp_session->dp_timed_out_cnt++;
+        cnt++;
+    }
+
+    return cnt;
+}
+
+int
+rp_dt_send_dp_requests(rp_ctx_t *rp_ctx, rp_session_t *rp_session, size_t subscription_index, sr_list_t *xpaths)
+{
+    CHECK_NULL_ARG5(rp_ctx, rp_session, rp_session->req, rp_session->state_data_ctx.subscriptions, xpaths);
+    int rc = SR_ERR_OK;
+    np_subscription_t *subscription = NULL;
+    sr_val_t **values = NULL;
+    size_t *values_cnt = NULL;
+    bool *hit = NULL, *miss = NULL;
+    const char **miss_xps = NULL;
+    size_t hit_cnt = 0, miss_cnt = 0;
+
+    if (0 == xpaths->count) {
+        return SR_ERR_OK;
+    }
+    subscription = rp_session->state_data_ctx.subscriptions->data[subscription_index];
+
+    hit = calloc(xpaths->count, sizeof(*hit));
+    miss = calloc(xpaths->count, sizeof(*miss));
+    miss_xps = calloc(xpaths->count, sizeof(*miss_xps));
+    values = calloc(xpaths->count, sizeof(*values));
+    values_cnt = calloc(xpaths->count, sizeof(*values_cnt));
+    if (NULL == hit || NULL == miss || NULL == miss_xps || NULL == values || NULL == values_cnt) {
+        SR_LOG_ERR_MSG("Memory allocation failed");
+        rc = SR_ERR_NOMEM;
+        goto cleanup;
+    }
+
+    /* look up the data provider cache */
+    for (size_t i = 0; i < xpaths->count; i++) {
+        if (NULL != rp_session->state_data_ctx.requested_xpaths &&
+                NULL != sr_btree_search(rp_session->state_data_ctx.requested_xpaths, xpaths->data[i])) {
+            /* already waiting for the response, the provider would send the data twice */
+            SR_LOG_DBG("Xpath '%s' has already been requested.", (char *) xpaths->data[i]);
+            continue;
+        }
+        if (subscription->dp_cache_ttl > 0 && SR_ERR_OK == rp_dp_cache_lookup(rp_ctx->dp_cache, subscription,
+                xpaths->data[i], &values[i], &values_cnt[i])) {
+            hit[i] = true;
+            hit_cnt++;
+        } else {
+            miss[i] = true;
+            miss_xps[miss_cnt++] = xpaths->data[i];
+        }
+    }
+
+    /* request the data that are not cached */
+    if (miss_cnt > 0) {
+        rc = np_data_provider_request_batch(rp_ctx->np_ctx, subscription, rp_session, miss_xps, miss_cnt);
+        SR_LOG_DBG("Sending request for state data: %s (%zu xpath(s))", miss_xps[0], miss_cnt);
+        if (SR_ERR_OK != rc) {
+            SR_LOG_WRN("Request for operational data failed with xpath %s on subscription %s", miss_xps[0], subscription->xpath);
+            goto cleanup;
+        }
+        rp_session->dp_req_waiting += 1;
+        rc = rp_dt_move_requested_xpaths(rp_session, xpaths, miss);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to store requested xpaths");
+        rc = rp_dt_add_pending_dp_req(rp_ctx, rp_session, subscription, miss_xps[0], miss_cnt);
+        if (SR_ERR_OK != rc) {
+            /* the request has been sent, it is only not going to be tracked */
+            SR_LOG_WRN("Failed to track the request sent to data provider subscribed for '%s'.", subscription->xpath);
+            rc = SR_ERR_OK;
+        }
+    }
+
+    /* answer the rest from the cache */
+    if (hit_cnt > 0) {
+        rc = rp_dt_enqueue_cached_dp_resp(rp_ctx, rp_session, xpaths, hit, hit_cnt, values, values_cnt);
+    }
+
+cleanup:
+    if (NULL != values) {
+        for (size_t i = 0; i < xpaths->count; i++) {
+            sr_free_values(values[i], values_cnt[i]);
+        }
+    }
+    free(values);
+    free(values_cnt);
+    free(miss_xps);
+    free(miss);
+    free(hit);
+    return rc;
+}
+
 /**
  *
  * @param [in] rp_ctx
@@ -944,9 +1314,10 @@ rp_dt_send_request_to_dp_subscription(rp_ctx_t *rp_ctx, rp_session_t *rp_session
     struct lys_node *parent_list = NULL;
     size_t list_depth = 0;
     size_t xp_cnt = 0;
-    np_subscription_t *subscription = NULL;
+    sr_list_t *batch = NULL;
 
-    subscription = rp_session->state_data_ctx.subscriptions->data[subscription_index];
+    rc = sr_list_init(&batch);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "List init failed");
 
     if (rp_dt_has_parent_list(sch_node, &parent_list, &list_depth)) {
         SR_LOG_DBG("State data is nested in configuration list %s", xp);
@@ -979,40 +1350,170 @@ rp_dt_send_request_to_dp_subscription(rp_ctx_t *rp_ctx, rp_session_t *rp_session
 
             snprintf(request_xp, len, "%s/%s", xpaths[i], ptr);
 
-            rc = np_data_provider_request(rp_ctx->np_ctx, subscription, rp_session, request_xp);
-            SR_LOG_DBG("Sending request for state data: %s", request_xp);
-            if (SR_ERR_OK != rc) {
-                SR_LOG_WRN("Request for operational data failed with xpath %s on subscription %s", request_xp, subscription->xpath);
-                free(request_xp);
-            } else {
-                rp_session->dp_req_waiting += 1;
-                rc = sr_list_add(rp_session->state_data_ctx.requested_xpaths, request_xp);
-            }
+            rc = sr_list_add(batch, request_xp);
+            CHECK_RC_MSG_GOTO(rc, cleanup, "List add failed");
+            request_xp = NULL;
         }
+
+        SR_LOG_DBG("Requesting state data: %s/%s of %zu instances", xp, ptr, batch->count);
         free(xp);
         xp = NULL;
 
     } else {
-        rc = np_data_provider_request(rp_ctx->np_ctx, subscription, rp_session, xp);
-        SR_LOG_DBG("Sending request for state data: %s", xp);
-        if (SR_ERR_OK != rc) {
-            SR_LOG_WRN("Request for operational data failed with xpath %s on subscription %s", xp, subscription->xpath);
-        } else {
-            rp_session->dp_req_waiting += 1;
-            rc = sr_list_add(rp_session->state_data_ctx.requested_xpaths, xp);
-        }
+        rc = sr_list_add(batch, xp);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "List add failed");
+        xp = NULL;
     }
 
+    /* request the data of all instances at once */
+    rc = rp_dt_send_dp_requests(rp_ctx, rp_session, subscription_index, batch);
+
 cleanup:
-    if (SR_ERR_OK != rc) {
-        free(xp);
-    }
+    free(xp);
     if (NULL != xpaths) {
         for (size_t i = 0; i < xp_cnt; i++) {
             free(xpaths[i]);
         }
         free(xpaths);
     }
+    free(request_xp);
+    sr_free_list_of_strings(batch);
+    return rc;
+}
+
+/**
+ * @brief Prefix of an xpath searched for in the sorted array of list instance xpaths.
+ */
+typedef struct rp_dt_xpath_prefix_s {
+    const char *xpath;      /**< XPath the prefix is taken from. */
+    size_t len;             /**< Length of the prefix. */
+} rp_dt_xpath_prefix_t;
+
+/**
+ * @brief Compares two list instance xpaths (qsort callback).
+ */
+static int
+rp_dt_instance_xp_cmp(const void *a, const void *b)
+{
+    return strcmp(*(const char **) a, *(const char **) b);
+}
+
+/**
+ * @brief Compares an xpath prefix with a list instance xpath (bsearch callback).
+ */
+static int
+rp_dt_xpath_prefix_cmp(const void *key, const void *item)
+{
+    const rp_dt_xpath_prefix_t *prefix = (const rp_dt_xpath_prefix_t *) key;
+    const char *instance = *(const char **) item;
+    int res = strncmp(prefix->xpath, instance, prefix->len);
+
+    if (0 == res && '\0' != instance[prefix->len]) {
+        /* prefix is shorter than the instance xpath */
+        res = -1;
+    }
+    return res;
+}
+
+/**
+ * @brief Returns true if the xpath identifies a node placed under one of the list instances.
+ * Each prefix of the xpath ending at a node boundary is looked up in the sorted array.
+ */
+static bool
+rp_dt_xpath_under_instance(const char *xpath, char **instances, size_t instance_cnt)
+{
+    rp_dt_xpath_prefix_t prefix = { .xpath = xpath, };
+    char quote = 0;
+
+    if (0 == instance_cnt) {
+        return false;
+    }
+
+    for (const char *c = xpath; '\0' != *c; c++) {
+        if (quote) {
+            if (*c == quote) {
+                quote = 0;
+            }
+        } else if ('\'' == *c || '"' == *c) {
+            quote = *c;
+        } else if ('/' == *c && c != xpath) {
+            prefix.len = c - xpath;
+            if (NULL != bsearch(&prefix, instances, instance_cnt, sizeof(*instances), rp_dt_xpath_prefix_cmp)) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/**
+ * @brief Loads operational data pushed by the providers into the session's data tree.
+ *
+ * @param [in] rp_ctx
+ * @param [in] rp_session
+ * @param [in] subtree Schema path of the state data subtree.
+ * @param [in] subtree_node Schema node of the subtree.
+ * @param [out] loaded Set to true if some data have been pushed into the subtree.
+ * @return Error code (SR_ERR_OK on success)
+ */
+static int
+rp_dt_load_pushed_state_data(rp_ctx_t *rp_ctx, rp_session_t *rp_session, const char *subtree,
+        struct lys_node *subtree_node, bool *loaded)
+{
+    CHECK_NULL_ARG5(rp_ctx, rp_session, subtree, subtree_node, loaded);
+    sr_val_t *values = NULL;
+    size_t values_cnt = 0;
+    struct lys_node *parent_list = NULL;
+    size_t list_depth = 0;
+    char **instances = NULL;
+    size_t instance_cnt = 0;
+    bool configured = true;
+    int rc = SR_ERR_OK;
+
+    *loaded = false;
+
+    if (0 == rp_oper_store_count(rp_ctx->oper_store)) {
+        return SR_ERR_OK;
+    }
+
+    rc = rp_oper_store_get(rp_ctx->oper_store, subtree, &values, &values_cnt);
+    CHECK_RC_LOG_RETURN(rc, "Failed to get pushed operational data of %s", subtree);
+
+    if (values_cnt > 0 && rp_dt_has_parent_list(subtree_node, &parent_list, &list_depth)) {
+        /* state data nested in a configuration list are loaded only for existing list instances */
+        rc = rp_dt_create_instance_xps(rp_session, parent_list, &instances, &instance_cnt);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to create instance xpaths for list instances");
+    }
+
+    if (instance_cnt > 1) {
+        qsort(instances, instance_cnt, sizeof(*instances), rp_dt_instance_xp_cmp);
+    }
+
+    for (size_t i = 0; i < values_cnt; i++) {
+        if (NULL != parent_list) {
+            configured = rp_dt_xpath_under_instance(values[i].xpath, instances, instance_cnt);
+            if (!configured) {
+                SR_LOG_DBG("Skipping pushed value '%s', list instance is not configured.", values[i].xpath);
+                continue;
+            }
+        }
+        rc = rp_dt_set_item(rp_ctx->dm_ctx, rp_session->dm_session, values[i].xpath, SR_EDIT_DEFAULT, &values[i], NULL);
+        if (SR_ERR_OK != rc) {
+            SR_LOG_WRN("Failed to set pushed operational data for xpath '%s'.", values[i].xpath);
+            rc = SR_ERR_OK;
+        }
+    }
+    if (values_cnt > 0) {
+        SR_LOG_DBG("Subtree %s loaded from %zu pushed value(s)", subtree, values_cnt);
+        *loaded = true;
+    }
+
+cleanup:
+    for (size_t j = 0; j < instance_cnt; j++) {
+        free(instances[j]);
+    }
+    free(instances);
+    sr_free_values(values, values_cnt);
     return rc;
 }
 
@@ -1024,6 +1525,7 @@ cleanup:
  *      3. partial subscription - no subscription is found using the two ways above Try retrieve at least some
  *          parts of the requested subtree. Data provide request will be send to all subscribers that are under requested
  *          subtree and all list in the path are covered by a data provider
+ * Subtrees with data pushed by the providers are loaded from the store of pushed data, no request is sent for them.
  * @param [in] rp_ctx
  * @param [in] rp_session
  * @return Error code (SR_ERR_OK on success)
@@ -1041,7 +1543,22 @@ rp_dt_send_first_set_of_dp_requests(rp_ctx_t *rp_ctx, rp_session_t *rp_session)
 
         struct lys_node *subtree_node = (struct lys_node *) rp_session->state_data_ctx.subtree_nodes->data[i];
         size_t match_index = 0;
-        bool match = rp_dt_find_subscription_covering_subtree(rp_session, subtree_node, &match_index);
+        bool match = false;
+
+        /* pushed data take precedence over data providers */
+        rc = rp_dt_load_pushed_state_data(rp_ctx, rp_session, subtree, subtree_node, &match);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Loading of pushed state data failed");
+        if (match) {
+            xp = strdup(subtree);
+            CHECK_NULL_NOMEM_GOTO(xp, rc, cleanup);
+
+            rc = sr_list_add(rp_session->loaded_state_data[rp_session->datastore], xp);
+            CHECK_RC_MSG_GOTO(rc, cleanup, "List add failed");
+            xp = NULL;
+            continue;
+        }
+
+        match = rp_dt_find_subscription_covering_subtree(rp_session, subtree_node, &match_index);
 
         if (match) {
             /* exact or more generic (data provider subscribed for ancestor node) */
@@ -1215,9 +1732,12 @@ rp_dt_prepare_data(rp_ctx_t *rp_ctx, rp_session_t *rp_session, const char *xpath
 
             rp_dt_free_state_data_ctx_content(&rp_session->state_data_ctx);
             rp_session->dp_req_waiting = 0;
+            rp_session->dp_timed_out_cnt = 0;
+            free(rp_session->dp_timed_out_xpath);
+            rp_session->dp_timed_out_xpath = NULL;
 
-            rc = sr_list_init(&rp_session->state_data_ctx.requested_xpaths);
-            CHECK_RC_MSG_GOTO(rc, cleanup, "List init failed");
+            rc = sr_btree_init(rp_dt_requested_xpath_cmp, free, &rp_session->state_data_ctx.requested_xpaths);
+            CHECK_RC_MSG_GOTO(rc, cleanup, "Binary tree init failed");
 
             rc = rp_dt_xpath_requests_state_data(rp_ctx, rp_session, data_info->schema, xpath, api_variant,
                     tree_depth_limit, &rp_session->state_data_ctx);
@@ -1233,6 +1753,10 @@ rp_dt_prepare_data(rp_ctx_t *rp_ctx, rp_session_t *rp_session, const char *xpath
 
             if (rp_session->dp_req_waiting > 0) {
                 rp_session->state = RP_REQ_WAITING_FOR_DATA;
+            } else {
+                /* pushed state data might have been loaded into the tree */
+                rc = dm_get_datatree(rp_ctx->dm_ctx, rp_session->dm_session, rp_session->module_name, data_tree);
+                rc = SR_ERR_NOT_FOUND == rc ? SR_ERR_OK : rc;
             }
 
         }
@@ -1240,6 +1764,13 @@ rp_dt_prepare_data(rp_ctx_t *rp_ctx, rp_session_t *rp_session, const char *xpath
 
     } else if (RP_REQ_DATA_LOADED == rp_session->state) {
         SR_LOG_DBG("Session id = %u data loaded, continue processing", rp_session->id);
+        if (rp_session->dp_timed_out_cnt > 0) {
+            /* partial result - report the data that are missing */
+            char err_msg[128] = { 0, };
+            snprintf(err_msg, sizeof(err_msg), "Operational data of %zu request(s) to data providers have not been provided in time.",
+                    rp_session->dp_timed_out_cnt);
+            dm_report_error(rp_session->dm_session, err_msg, rp_session->dp_timed_out_xpath, SR_ERR_TIME_OUT);
+        }
         rc = dm_get_datatree(rp_ctx->dm_ctx, rp_session->dm_session, rp_session->module_name, data_tree);
         /* check of data tree's emptiness is performed outside of this function -> ignore SR_ERR_NOT_FOUND */
         rc = SR_ERR_NOT_FOUND == rc ? SR_ERR_OK : rc;
@@ -1931,6 +2462,72 @@ cleanup:
     return rc;
 }
 
+/**
+ * @brief Generates the changes of the module from its difflist unless it has been already done.
+ * Returns with the read lock of the changes acquired.
+ */
+static int
+rp_dt_rdlock_changes(dm_model_subscription_t *ms)
+{
+    int rc = SR_ERR_OK;
+
+    RWLOCK_RDLOCK_TIMED_CHECK_RETURN(&ms->changes_lock);
+
+    /* generate changes on demand */
+    if (!ms->changes_generated) {
+        pthread_rwlock_unlock(&ms->changes_lock);
+        /* acquire write lock */
+        RWLOCK_WRLOCK_TIMED_CHECK_RETURN(&ms->changes_lock);
+        /* check if some generated the changes meanwhile */
+        if (!ms->changes_generated) {
+            rc = rp_dt_difflist_to_changes(ms->difflist, &ms->changes);
+            if (SR_ERR_OK != rc) {
+                SR_LOG_ERR_MSG("Difflist to changes failed");
+                pthread_rwlock_unlock(&ms->changes_lock);
+                return rc;
+            }
+            ms->changes_generated = true;
+        }
+        /* downgrade to read lock */
+        pthread_rwlock_unlock(&ms->changes_lock);
+        RWLOCK_RDLOCK_TIMED_CHECK_RETURN(&ms->changes_lock);
+    }
+
+    return rc;
+}
+
+int
+rp_dt_get_subscription_changes(dm_model_subscription_t *ms, const struct lys_node *node, sr_list_t **changes_p)
+{
+    CHECK_NULL_ARG2(ms, changes_p);
+
+    dm_change_view_t *view = NULL;
+    sr_list_t *changes = NULL;
+    int rc = SR_ERR_OK;
+
+    rc = rp_dt_rdlock_changes(ms);
+    CHECK_RC_MSG_RETURN(rc, "Failed to generate the changes");
+
+    rc = rp_dt_get_change_view(ms, node, &view);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to select the changes");
+
+    rc = sr_list_init(&changes);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "List init failed");
+    for (size_t i = 0; i < view->count; i++) {
+        rc = sr_list_add(changes, ms->changes->data[view->positions[i]]);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "List add failed");
+    }
+
+cleanup:
+    pthread_rwlock_unlock(&ms->changes_lock);
+    if (SR_ERR_OK != rc) {
+        sr_list_cleanup(changes);
+    } else {
+        *changes_p = changes;
+    }
+    return rc;
+}
+
 int
 rp_dt_get_changes(rp_ctx_t *rp_ctx, rp_session_t *rp_session, dm_commit_context_t *c_ctx, const char *xpath,
         size_t offset, size_t limit, sr_list_t **matched_changes)
@@ -1953,7 +2550,7 @@ rp_dt_get_changes(rp_ctx_t *rp_ctx, rp_session_t *rp_session, dm_commit_context_
     lookup.schema_info = schema_info;
 
     ms = sr_btree_search(c_ctx->subscriptions, &lookup);
-    pthread_rwlock_unlock(&schema_info->model_lock);
+    SR_RWLOCK_UNLOCK(&schema_info->model_lock);
     if (NULL == ms) {
         SR_LOG_ERR("Module subscription not found for module %s", lookup.schema_info->module_name);
         rc = SR_ERR_INTERNAL;
@@ -1961,24 +2558,8 @@ rp_dt_get_changes(rp_ctx_t *rp_ctx, rp_session_t *rp_session, dm_commit_context_
     }
 
 
-    RWLOCK_RDLOCK_TIMED_CHECK_GOTO(&ms->changes_lock, rc, cleanup);
-
-    /* generate changes on demand */
-    if (!ms->changes_generated) {
-        pthread_rwlock_unlock(&ms->changes_lock);
-        /* acquire write lock */
-        RWLOCK_WRLOCK_TIMED_CHECK_GOTO(&ms->changes_lock, rc, cleanup);
-        /* check if some generated the changes meanwhile */
-        if (!ms->changes_generated) {
-            rc = rp_dt_difflist_to_changes(ms->difflist, &ms->changes);
-            if (SR_ERR_OK != rc) {
-                SR_LOG_ERR_MSG("Difflist to changes failed");
-                pthread_rwlock_unlock(&ms->changes_lock);
-                goto cleanup;
-            }
-            ms->changes_generated = true;
-        }
-    }
+    rc = rp_dt_rdlock_changes(ms);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to generate the changes");
 
     rc = rp_dt_find_changes(rp_ctx->dm_ctx, rp_session->dm_session, ms, &rp_session->change_ctx, xpath, offset, limit, matched_changes);
     pthread_rwlock_unlock(&ms->changes_lock);
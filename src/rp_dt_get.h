@@ -249,6 +249,17 @@ int rp_dt_get_subtrees_wrapper_with_opts(rp_ctx_t *rp_ctx, rp_session_t *rp_sess
  */
 int rp_dt_difflist_to_changes(struct lyd_difflist *difflist, sr_list_t **changes);
 
+/**
+ * @brief Returns all changes of the module selected by the schema node of a subscription.
+ * Changes are generated from difflist if it has not been done yet.
+ * @param [in] ms - model subscriptions where changes are stored
+ * @param [in] node - schema node of the subscription, NULL selects all changes of the module
+ * @param [out] changes - list of the selected changes (sr_change_t *), the changes themselves are owned by ms
+ * and stay valid until the changes of the module are regenerated for the next commit event
+ * @return Error code (SR_ERR_OK on success)
+ */
+int rp_dt_get_subscription_changes(dm_model_subscription_t *ms, const struct lys_node *node, sr_list_t **changes);
+
 /**
  * @brief Returns the changes that match the selection based on xpath, offset and limit criteria.
  * Changes are generated from difflist when the first request came.
@@ -277,6 +288,30 @@ int rp_dt_remove_loaded_state_data(rp_ctx_t *rp_ctx, rp_session_t *rp_session);
  */
 void rp_dt_free_state_data_ctx_content (rp_state_data_ctx_t *state_data);
 
+/**
+ * @brief Matches the response of a data provider with the request sent to it and records the latency
+ * of the provider.
+ *
+ * @param [in] rp_ctx
+ * @param [in] rp_session
+ * @param [in] xpath The first xpath of the response.
+ * @return False if the response belongs to a request that has already timed out and must be ignored,
+ * true otherwise.
+ */
+bool rp_dt_dp_response_received(rp_ctx_t *rp_ctx, rp_session_t *rp_session, const char *xpath);
+
+/**
+ * @brief Marks requests sent to data providers that have not been answered in time as timed out.
+ * Responses to these requests will be ignored.
+ *
+ * @param [in] rp_ctx
+ * @param [in] rp_session
+ * @param [in] all If set, all requests still waiting for an answer are marked, otherwise only those
+ * whose per-provider deadline (SR_OPER_DATA_PROVIDER_TIMEOUT) has expired.
+ * @return Number of newly timed out requests.
+ */
+size_t rp_dt_dp_requests_timeout(rp_ctx_t *rp_ctx, rp_session_t *rp_session, bool all);
+
 /**
  * @brief Function tests whether node is located under(in schema hierarchy) subtree node.
  * @param [in] subtree
@@ -316,6 +351,20 @@ bool rp_dt_find_exact_match_subscription_for_node(rp_session_t *rp_session, stru
  */
 int rp_dt_create_instance_xps(rp_session_t *session, struct lys_node *sch_node, char ***xps, size_t *xp_count);
 
+/**
+ * @brief Requests operational data of the xpaths from the data provider subscription. Xpaths
+ * with fresh data in the data provider cache are answered by an internally generated data provide
+ * response, the others are sent to the data provider in one request. Xpaths of the successfully sent
+ * requests are moved into the list of requested xpaths (their entries in the input list are set to NULL).
+ * Xpaths that are already waiting for a response are skipped.
+ * @param [in] rp_ctx
+ * @param [in] rp_session
+ * @param [in] subscription_index - index of subscription where the request will be addressed
+ * @param [in] xpaths - list of xpaths to be requested
+ * @return Error code (SR_ERR_OK on success)
+ */
+int rp_dt_send_dp_requests(rp_ctx_t *rp_ctx, rp_session_t *rp_session, size_t subscription_index, sr_list_t *xpaths);
+
 #endif /* RP_DT_GET_H */
 
 /**
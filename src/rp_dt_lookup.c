@@ -66,7 +66,7 @@ rp_dt_find_nodes(const dm_ctx_t *dm_ctx, struct lyd_node *data_tree, const char
                 res->number--;
             }
         }
-        pthread_rwlock_unlock(&si->model_lock);
+        SR_RWLOCK_UNLOCK(&si->model_lock);
     }
 
     if (0 == res->number) {
@@ -210,75 +210,103 @@ rp_dt_match_change(const struct lys_node *selection_node, const struct lys_node
     return SR_ERR_OK;
 }
 
+int
+rp_dt_get_change_view(dm_model_subscription_t *ms, const struct lys_node *selection_node, dm_change_view_t **view_p)
+{
+    dm_change_view_t *view = NULL;
+    sr_change_t *change = NULL;
+    bool match = false;
+    int rc = SR_ERR_OK;
+
+    pthread_mutex_lock(&ms->change_views_lock);
+
+    if (NULL == ms->change_views) {
+        rc = sr_list_init(&ms->change_views);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "List init failed");
+    }
+
+    for (size_t i = 0; i < ms->change_views->count; i++) {
+        if (selection_node == ((dm_change_view_t *) ms->change_views->data[i])->node) {
+            *view_p = ms->change_views->data[i];
+            goto cleanup;
+        }
+    }
+
+    view = calloc(1, sizeof(*view));
+    CHECK_NULL_NOMEM_GOTO(view, rc, cleanup);
+    view->node = selection_node;
+    if (ms->changes->count > 0) {
+        view->positions = calloc(ms->changes->count, sizeof(*view->positions));
+        CHECK_NULL_NOMEM_GOTO(view->positions, rc, cleanup);
+    }
+
+    for (size_t position = 0; position < ms->changes->count; position++) {
+        change = (sr_change_t *) ms->changes->data[position];
+        rc = rp_dt_match_change(selection_node, change->sch_node, &match);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Match subscription failed");
+        if (match) {
+            view->positions[view->count++] = position;
+        }
+    }
+
+    rc = sr_list_add(ms->change_views, view);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "List add failed");
+    *view_p = view;
+    view = NULL;
+
+cleanup:
+    pthread_mutex_unlock(&ms->change_views_lock);
+    if (NULL != view) {
+        free(view->positions);
+        free(view);
+    }
+    return rc;
+}
+
 int
 rp_dt_find_changes(dm_ctx_t *dm_ctx, dm_session_t *session, dm_model_subscription_t *ms,
         rp_dt_change_ctx_t *change_ctx, const char *xpath, size_t offset, size_t limit, sr_list_t **changes)
 {
     CHECK_NULL_ARG(dm_ctx);
     CHECK_NULL_ARG5(session, ms, change_ctx, xpath, changes);
-    int rc = SR_ERR_OK;
+    dm_change_view_t *view = NULL;
     bool cache_hit = false;
-    char *module_name = NULL;
+    int rc = SR_ERR_OK;
 
-    if (NULL == change_ctx->xpath || 0 != strcmp(xpath, change_ctx->xpath) || offset != change_ctx->offset) {
+    /* the selection node is resolved again whenever a new iteration starts */
+    if (NULL == change_ctx->xpath || 0 != strcmp(xpath, change_ctx->xpath) || 0 == offset) {
         rc = rp_dt_validate_node_xpath(dm_ctx, session, xpath, NULL, (struct lys_node **) &change_ctx->schema_node);
         CHECK_RC_LOG_RETURN(rc, "Selection node for changes can not be found xpath '%s'", xpath);
         free(change_ctx->xpath);
         change_ctx->xpath = strdup(xpath);
         CHECK_NULL_NOMEM_RETURN(change_ctx->xpath);
-        change_ctx->offset = 0;
-        change_ctx->position = 0;
     } else {
         cache_hit = true;
     }
 
     SR_LOG_DBG("Get changes: %s limit:%zu offset:%zu cache %s", xpath, limit, offset, cache_hit ? "hit" : "miss");
 
-    size_t cnt = 0; /* number of returned changes (in offset limit range) */
-    size_t index = cache_hit ? change_ctx->offset : 0; /* number of matching changes */
-
-    rc = sr_list_init(changes);
-    CHECK_RC_MSG_GOTO(rc, cleanup, "sr_list_init failed");
-    size_t position = 0; /* index to change set */
-
-    /* selection from model changes */
-    for (position = change_ctx->position; position < ms->changes->count; position++) {
-        bool match = false;
-        sr_change_t *change = (sr_change_t *) ms->changes->data[position];
+    rc = rp_dt_get_change_view(ms, change_ctx->schema_node, &view);
+    CHECK_RC_LOG_RETURN(rc, "Failed to select the changes for xpath '%s'", xpath);
 
-        rc = rp_dt_match_change(change_ctx->schema_node, change->sch_node, &match);
-        CHECK_RC_MSG_GOTO(rc, cleanup, "Match subscription failed");
+    if (offset >= view->count || 0 == limit) {
+        *changes = NULL;
+        return SR_ERR_NOT_FOUND;
+    }
 
-        if (!match) {
-            continue;
-        }
+    rc = sr_list_init(changes);
+    CHECK_RC_MSG_RETURN(rc, "sr_list_init failed");
 
-        if (cnt >= limit) {
-            break;
-        }
-        /* append change to result if it is in the chosen range */
-        if (index >= offset) {
-            if (SR_ERR_OK != sr_list_add(*changes, change)) {
-                SR_LOG_ERR_MSG("Adding to the result changes failed");
-                sr_list_cleanup(*changes);
-                *changes = NULL;
-                return SR_ERR_INTERNAL;
-            }
-            cnt++;
+    /* append the changes in the chosen range */
+    for (size_t i = offset; i < view->count && i - offset < limit; i++) {
+        rc = sr_list_add(*changes, ms->changes->data[view->positions[i]]);
+        if (SR_ERR_OK != rc) {
+            SR_LOG_ERR_MSG("Adding to the result changes failed");
+            sr_list_cleanup(*changes);
+            *changes = NULL;
+            return SR_ERR_INTERNAL;
         }
-        index++;
-    }
-
-    /* mark the index where the processing stopped*/
-    change_ctx->offset = index;
-    change_ctx->position = position;
-    if (0 == cnt) {
-        sr_list_cleanup(*changes);
-        *changes = NULL;
-        rc = SR_ERR_NOT_FOUND;
     }
 
-cleanup:
-    free(module_name);
-    return rc;
+    return SR_ERR_OK;
 }
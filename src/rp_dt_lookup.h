@@ -73,6 +73,17 @@ int rp_dt_find_node(const dm_ctx_t *dm_ctx, struct lyd_node *data_tree, const ch
  */
 int rp_dt_find_nodes(const dm_ctx_t *dm_ctx, struct lyd_node *data_tree, const char *xpath, bool check_enable, struct ly_set **nodes);
 
+/**
+ * @brief Returns the view into the changes of the module selected by the schema node, builds it if it does not
+ * exist yet. The view is shared by all sessions reading the changes of the commit. Changes of the module
+ * are expected to be generated and read-locked by the caller.
+ * @param [in] ms - model subscriptions where changes are stored
+ * @param [in] selection_node - schema node selecting the changes, NULL selects all changes of the module
+ * @param [out] view - positions of the selected changes
+ * @return Error code (SR_ERR_OK on success)
+ */
+int rp_dt_get_change_view(dm_model_subscription_t *ms, const struct lys_node *selection_node, dm_change_view_t **view);
+
 /**
  * @brief Find matching changes
  * @param [in] dm_ctx
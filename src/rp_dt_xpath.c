@@ -155,7 +155,7 @@ rp_dt_validate_node_xpath_lock(dm_ctx_t *dm_ctx, dm_session_t *session, const ch
 cleanup:
     *schema_info = si;
     if (NULL != si && SR_ERR_OK != rc) {
-        pthread_rwlock_unlock(&si->model_lock);
+        SR_RWLOCK_UNLOCK(&si->model_lock);
         *schema_info = NULL;
     }
     free(namespace);
@@ -170,7 +170,7 @@ rp_dt_validate_node_xpath(dm_ctx_t *dm_ctx, dm_session_t *session, const char *x
     int rc = SR_ERR_OK;
     rc = rp_dt_validate_node_xpath_lock(dm_ctx, session, xpath, &si, match);
     if (SR_ERR_OK == rc) {
-        pthread_rwlock_unlock(&si->model_lock);
+        SR_RWLOCK_UNLOCK(&si->model_lock);
         if (NULL != schema_info) {
             *schema_info = si;
         }
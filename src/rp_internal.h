@@ -27,9 +27,32 @@
 #include "data_manager.h"
 #include "notification_processor.h"
 #include "persistence_manager.h"
+#include "rp_dp_cache.h"
+#include "rp_oper_store.h"
+#include "rp_dp_latency.h"
 
 #define RP_THREAD_COUNT 4  /**< Number of threads that RP uses for processing. */
 
+/**
+ * @brief Size of the array of per-operation request counters (greater than the highest Sr__Operation value).
+ */
+#define RP_STATS_OPERATION_CNT 128
+
+/**
+ * @brief Performance statistics of the Request Processor (exposed via sysrepo-monitoring module).
+ */
+typedef struct rp_stats_s {
+    uint32_t session_cnt;                    /**< Number of currently opened sessions. */
+    uint64_t commit_cnt;                     /**< Number of successfully finished commits. */
+    uint64_t commit_failed_cnt;              /**< Number of failed commits. */
+    uint64_t commit_latency_last;            /**< Duration of the last commit (in microseconds). */
+    uint64_t commit_latency_max;             /**< Maximal duration of a commit (in microseconds). */
+    uint64_t commit_latency_total;           /**< Sum of durations of all commits (in microseconds). */
+    uint64_t request_cnt[RP_STATS_OPERATION_CNT]; /**< Number of dispatched requests per operation (indexed by Sr__Operation),
+                                                    updated atomically without the mutex. */
+    pthread_mutex_t mutex;                   /**< Mutex guarding the statistics. */
+} rp_stats_t;
+
 /**
  * @brief Structure that holds the context of an instance of Request Processor.
  */
@@ -59,6 +82,11 @@ typedef struct rp_ctx_s {
 
     pthread_rwlock_t commit_lock;            /**< Lock to synchronize commit in this instance */
     bool do_not_generate_config_change;      /**< Config-change notification will not be generated */
+
+    rp_stats_t *stats;                       /**< Performance statistics of the Request Processor. */
+    rp_dp_cache_t *dp_cache;                 /**< Cache of the data provided by operational data providers. */
+    rp_oper_store_t *oper_store;             /**< Operational data pushed by the providers. */
+    rp_dp_latency_t *dp_latency;             /**< Latency statistics of operational data providers. */
 } rp_ctx_t;
 
 /**
@@ -75,9 +103,7 @@ typedef struct rp_dt_get_items_ctx {
  */
 typedef struct rp_dt_change_ctx_s {
     char *xpath;                        /**< xpath used for change identification */
-    const struct lys_node *schema_node; /**< schema node corresponding to xpath, used for matching */
-    size_t offset;                      /**< offset-th matched change to be returned */
-    size_t position;                    /**< index to the change set */
+    const struct lys_node *schema_node; /**< schema node corresponding to xpath, selects the view into the changes */
 } rp_dt_change_ctx_t;
 
 /**
@@ -93,15 +119,27 @@ typedef enum rp_request_state_e {
     RP_REQ_FINISHED                     /**< Request processing finished, request can be freed */
 } rp_request_state_t;
 
+/**
+ * @brief Data provide request sent to a data provider whose response has not been processed yet.
+ */
+typedef struct rp_dp_pending_req_s {
+    char *xpath;                       /**< First requested xpath (identifies the response) */
+    char *subscription_xpath;          /**< XPath of the data provider subscription */
+    size_t xpath_cnt;                  /**< Number of requested xpaths */
+    struct timespec sent;              /**< Time (CLOCK_MONOTONIC) when the request was sent */
+    bool timed_out;                    /**< Provider has not answered in time, its response will be ignored */
+} rp_dp_pending_req_t;
+
 typedef struct rp_state_data_ctx_s {
     sr_list_t *subscriptions;          /**< List of subscriptions from np for a module */
     sr_list_t *subtrees;               /**< List of state data subtrees to be loaded*/
     sr_list_t *subtree_nodes;          /**< List of schema nodes corresponding to state data subtrees */
     sr_list_t *subscription_nodes;     /**< Schema node corresponding to the subscriptions */
-    sr_list_t *requested_xpaths;       /**< List of xpath that has been requested and response has not been processed yet */
+    sr_btree_t *requested_xpaths;      /**< Xpaths (char *) that have been requested and response has not been processed yet */
     bool overlapping_leaf_subscription;/**< Flags signalizing that ther is a subscription for leaf or leaf-list under a container or a list */
     size_t internal_state_data_index;   /**< Index to the module of internal state data structures in rp_ctx */
     bool internal_state_data;          /**< Request contains internally handled state data */
+    sr_list_t *pending_dp_reqs;        /**< List of requests sent to data providers (rp_dp_pending_req_t *) */
 }rp_state_data_ctx_t;
 
 /**
@@ -133,6 +171,9 @@ typedef struct rp_session_s {
     pthread_mutex_t cur_req_mutex;       /**< mutex guarding information about currently processed request */
     sr_list_t **loaded_state_data;       /**< List of xpath for loaded state data in datastore */
     rp_state_data_ctx_t state_data_ctx;  /**< Context used during state data loading */
+    size_t dp_timed_out_cnt;             /**< number of data provider requests of the current request not answered in time */
+    char *dp_timed_out_xpath;            /**< first xpath whose data has not been provided in time */
+    struct timespec commit_start;        /**< Time when processing of the current commit request has started */
 } rp_session_t;
 
 #endif /* RP_INTERNAL_H_ */
@@ -0,0 +1,626 @@
+/**
+ * @file rp_oper_store.c
+ * @brief In-memory store of operational data pushed by the providers.
+ *
+ * @copyright
+ * Copyright 2016 Cisco Systems, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+#include <inttypes.h>
+#include <pthread.h>
+
+#include "rp_oper_store.h"
+#include "values_internal.h"
+
+/**
+ * @brief Pushed value together with the session that pushed it.
+ */
+typedef struct rp_oper_store_value_s {
+    sr_val_t *value;            /**< Pushed value. */
+    uint32_t session_id;        /**< ID of the session that pushed the value. */
+} rp_oper_store_value_t;
+
+/**
+ * @brief Pushed values of one schema node.
+ */
+typedef struct rp_oper_store_node_s {
+    char *schema_path;          /**< Schema path (xpath without predicates) of the node. */
+    sr_btree_t *values;         /**< Pushed values (rp_oper_store_value_t *) of the node ordered by xpath. */
+    size_t values_cnt;          /**< Number of values of the node. */
+} rp_oper_store_node_t;
+
+/**
+ * @brief Pushed values of one module.
+ */
+typedef struct rp_oper_store_module_s {
+    char *module_name;          /**< Name of the module. */
+    sr_btree_t *nodes;          /**< Schema nodes with pushed values (rp_oper_store_node_t *) ordered by schema path. */
+} rp_oper_store_module_t;
+
+/**
+ * @brief Pushed operational data store context.
+ */
+struct rp_oper_store_s {
+    sr_btree_t *modules;        /**< Modules with pushed values (rp_oper_store_module_t *) ordered by name. */
+    size_t values_cnt;          /**< Number of pushed values. */
+    pthread_mutex_t mutex;      /**< Mutex guarding the store (walking the tree modifies its state). */
+};
+
+/**
+ * @brief Compares two stored values by their xpath.
+ */
+static int
+rp_oper_store_value_cmp(const void *a, const void *b)
+{
+    const rp_oper_store_value_t *val_a = (const rp_oper_store_value_t *) a;
+    const rp_oper_store_value_t *val_b = (const rp_oper_store_value_t *) b;
+
+    return strcmp(val_a->value->xpath, val_b->value->xpath);
+}
+
+/**
+ * @brief Frees a stored value.
+ */
+static void
+rp_oper_store_value_free(void *item)
+{
+    rp_oper_store_value_t *value = (rp_oper_store_value_t *) item;
+
+    if (NULL != value) {
+        sr_free_val(value->value);
+        free(value);
+    }
+}
+
+/**
+ * @brief Compares two schema nodes by their schema path.
+ */
+static int
+rp_oper_store_node_cmp(const void *a, const void *b)
+{
+    const rp_oper_store_node_t *node_a = (const rp_oper_store_node_t *) a;
+    const rp_oper_store_node_t *node_b = (const rp_oper_store_node_t *) b;
+
+    return strcmp(node_a->schema_path, node_b->schema_path);
+}
+
+/**
+ * @brief Frees a schema node with all its values.
+ */
+static void
+rp_oper_store_node_free(void *item)
+{
+    rp_oper_store_node_t *node = (rp_oper_store_node_t *) item;
+
+    if (NULL != node) {
+        sr_btree_cleanup(node->values);
+        free(node->schema_path);
+        free(node);
+    }
+}
+
+/**
+ * @brief Compares two modules by their name.
+ */
+static int
+rp_oper_store_module_cmp(const void *a, const void *b)
+{
+    const rp_oper_store_module_t *module_a = (const rp_oper_store_module_t *) a;
+    const rp_oper_store_module_t *module_b = (const rp_oper_store_module_t *) b;
+
+    return strcmp(module_a->module_name, module_b->module_name);
+}
+
+/**
+ * @brief Frees a module with all its schema nodes.
+ */
+static void
+rp_oper_store_module_free(void *item)
+{
+    rp_oper_store_module_t *module = (rp_oper_store_module_t *) item;
+
+    if (NULL != module) {
+        sr_btree_cleanup(module->nodes);
+        free(module->module_name);
+        free(module);
+    }
+}
+
+/**
+ * @brief Duplicates the value into a newly allocated value without Sysrepo memory context.
+ */
+static int
+rp_oper_store_value_dup(const sr_val_t *value, sr_val_t *dup)
+{
+    int rc = SR_ERR_OK;
+
+    rc = sr_val_set_xpath(dup, value->xpath);
+    CHECK_RC_MSG_RETURN(rc, "Failed to set xpath of a pushed value.");
+
+    return sr_dup_val_data(dup, value);
+}
+
+/**
+ * @brief Creates a copy of the data xpath with all predicates (list keys, positions) removed.
+ */
+static int
+rp_oper_store_strip_predicates(const char *xpath, char **schema_path_p)
+{
+    char *schema_path = NULL;
+    size_t depth = 0, len = 0;
+    char quote = 0;
+
+    schema_path = calloc(strlen(xpath) + 1, sizeof(*schema_path));
+    CHECK_NULL_NOMEM_RETURN(schema_path);
+
+    for (const char *c = xpath; '\0' != *c; c++) {
+        if (quote) {
+            if (*c == quote) {
+                quote = 0;
+            }
+        } else if ('[' == *c) {
+            depth++;
+        } else if (']' == *c && depth > 0) {
+            depth--;
+        } else if (depth > 0 && ('\'' == *c || '"' == *c)) {
+            quote = *c;
+        } else if (0 == depth) {
+            schema_path[len++] = *c;
+        }
+    }
+
+    *schema_path_p = schema_path;
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Looks up the module in the store. Store mutex is expected to be held.
+ */
+static rp_oper_store_module_t *
+rp_oper_store_find_module_locked(rp_oper_store_t *store, const char *module_name)
+{
+    rp_oper_store_module_t lookup = { .module_name = (char *) module_name, };
+
+    return sr_btree_search(store->modules, &lookup);
+}
+
+/**
+ * @brief Looks up the schema node of the module in the store, creates it (and the module)
+ * if it does not exist yet. Store mutex is expected to be held.
+ */
+static int
+rp_oper_store_get_node_locked(rp_oper_store_t *store, const char *module_name, const char *schema_path,
+        rp_oper_store_node_t **node_p)
+{
+    rp_oper_store_module_t *module = NULL;
+    rp_oper_store_node_t lookup = { .schema_path = (char *) schema_path, };
+    rp_oper_store_node_t *node = NULL;
+    int rc = SR_ERR_OK;
+
+    module = rp_oper_store_find_module_locked(store, module_name);
+    if (NULL == module) {
+        module = calloc(1, sizeof(*module));
+        CHECK_NULL_NOMEM_RETURN(module);
+        module->module_name = strdup(module_name);
+        CHECK_NULL_NOMEM_GOTO(module->module_name, rc, cleanup);
+        rc = sr_btree_init(rp_oper_store_node_cmp, rp_oper_store_node_free, &module->nodes);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Binary tree init failed");
+        rc = sr_btree_insert(store->modules, module);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Binary tree insert failed");
+    }
+
+    node = sr_btree_search(module->nodes, &lookup);
+    if (NULL == node) {
+        node = calloc(1, sizeof(*node));
+        CHECK_NULL_NOMEM_RETURN(node);
+        node->schema_path = strdup(schema_path);
+        CHECK_NULL_NOMEM_GOTO(node->schema_path, rc, cleanup);
+        rc = sr_btree_init(rp_oper_store_value_cmp, rp_oper_store_value_free, &node->values);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Binary tree init failed");
+        rc = sr_btree_insert(module->nodes, node);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Binary tree insert failed");
+    }
+
+    *node_p = node;
+    return SR_ERR_OK;
+
+cleanup:
+    if (NULL != node) {
+        rp_oper_store_node_free(node);
+    } else {
+        rp_oper_store_module_free(module);
+    }
+    return rc;
+}
+
+/**
+ * @brief Collects schema nodes of the module that lie in the subtree identified by the schema path.
+ * Store mutex is expected to be held.
+ */
+static int
+rp_oper_store_collect_nodes_locked(rp_oper_store_t *store, const char *module_name, const char *subtree,
+        sr_list_t *nodes)
+{
+    rp_oper_store_module_t *module = NULL;
+    rp_oper_store_node_t *node = NULL;
+    size_t i = 0;
+    int rc = SR_ERR_OK;
+
+    module = rp_oper_store_find_module_locked(store, module_name);
+    if (NULL == module) {
+        return SR_ERR_OK;
+    }
+
+    while (NULL != (node = sr_btree_get_at(module->nodes, i++))) {
+        if (sr_xpath_in_subtree(node->schema_path, subtree)) {
+            rc = sr_list_add(nodes, node);
+            CHECK_RC_MSG_RETURN(rc, "List add failed");
+        }
+    }
+
+    return SR_ERR_OK;
+}
+
+/**
+ * @brief Removes all values in the subtree. Store mutex is expected to be held.
+ */
+static int
+rp_oper_store_remove_subtree_locked(rp_oper_store_t *store, const char *module_name, const char *xpath)
+{
+    rp_oper_store_module_t *module = NULL;
+    rp_oper_store_node_t *node = NULL;
+    sr_list_t *nodes = NULL, *matching = NULL;
+    char *schema_path = NULL;
+    rp_oper_store_value_t *value = NULL;
+    size_t i = 0, j = 0;
+    int rc = SR_ERR_OK;
+
+    rc = rp_oper_store_strip_predicates(xpath, &schema_path);
+    CHECK_RC_MSG_RETURN(rc, "Failed to create the schema path");
+
+    rc = sr_list_init(&nodes);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "List init failed");
+    rc = sr_list_init(&matching);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "List init failed");
+
+    rc = rp_oper_store_collect_nodes_locked(store, module_name, schema_path, nodes);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to collect schema nodes of the subtree");
+
+    for (i = 0; i < nodes->count; i++) {
+        node = (rp_oper_store_node_t *) nodes->data[i];
+
+        /* the tree must not be modified while iterating */
+        j = 0;
+        while (NULL != (value = sr_btree_get_at(node->values, j++))) {
+            if (sr_xpath_in_subtree(value->value->xpath, xpath)) {
+                rc = sr_list_add(matching, value);
+                CHECK_RC_MSG_GOTO(rc, cleanup, "List add failed");
+            }
+        }
+
+        for (j = 0; j < matching->count; j++) {
+            sr_btree_delete(node->values, matching->data[j]);
+            node->values_cnt--;
+            store->values_cnt--;
+        }
+        matching->count = 0; /**< clear the list */
+
+        if (0 == node->values_cnt) {
+            module = rp_oper_store_find_module_locked(store, module_name);
+            sr_btree_delete(module->nodes, node);
+        }
+    }
+
+cleanup:
+    sr_list_cleanup(nodes);
+    sr_list_cleanup(matching);
+    free(schema_path);
+    return rc;
+}
+
+int
+rp_oper_store_init(rp_oper_store_t **store_p)
+{
+    rp_oper_store_t *store = NULL;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG(store_p);
+
+    store = calloc(1, sizeof(*store));
+    CHECK_NULL_NOMEM_RETURN(store);
+
+    rc = sr_btree_init(rp_oper_store_module_cmp, rp_oper_store_module_free, &store->modules);
+    if (SR_ERR_OK != rc) {
+        SR_LOG_ERR_MSG("Unable to initialize the store of pushed operational data.");
+        free(store);
+        return rc;
+    }
+    pthread_mutex_init(&store->mutex, NULL);
+
+    *store_p = store;
+    return SR_ERR_OK;
+}
+
+void
+rp_oper_store_cleanup(rp_oper_store_t *store)
+{
+    if (NULL != store) {
+        sr_btree_cleanup(store->modules);
+        pthread_mutex_destroy(&store->mutex);
+        free(store);
+    }
+}
+
+int
+rp_oper_store_push(rp_oper_store_t *store, uint32_t session_id, const char *xpath, const sr_val_t *values,
+        size_t values_cnt, bool replace)
+{
+    char *subtree = NULL, *module_name = NULL;
+    char **schema_paths = NULL;
+    rp_oper_store_value_t **dups = NULL;
+    rp_oper_store_value_t *existing = NULL;
+    rp_oper_store_node_t *node = NULL;
+    size_t i = 0;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG2(store, xpath);
+    if (values_cnt > 0) {
+        CHECK_NULL_ARG(values);
+    }
+
+    /* keys enclosed in double quotes are stored in the form printed by libyang */
+    subtree = strdup(xpath);
+    CHECK_NULL_NOMEM_RETURN(subtree);
+    sr_xpath_normalize_quotes(subtree);
+
+    rc = sr_copy_first_ns(subtree, &module_name);
+    CHECK_RC_LOG_GOTO(rc, cleanup, "Failed to get the module name of '%s'.", xpath);
+
+    if (values_cnt > 0) {
+        dups = calloc(values_cnt, sizeof(*dups));
+        CHECK_NULL_NOMEM_GOTO(dups, rc, cleanup);
+        schema_paths = calloc(values_cnt, sizeof(*schema_paths));
+        CHECK_NULL_NOMEM_GOTO(schema_paths, rc, cleanup);
+    }
+
+    /* prepare the values before locking the store */
+    for (i = 0; i < values_cnt; i++) {
+        if (NULL == values[i].xpath) {
+            SR_LOG_ERR("Pushed value without xpath in the subtree '%s'.", xpath);
+            rc = SR_ERR_INVAL_ARG;
+            goto cleanup;
+        }
+        dups[i] = calloc(1, sizeof(**dups));
+        CHECK_NULL_NOMEM_GOTO(dups[i], rc, cleanup);
+        dups[i]->session_id = session_id;
+        dups[i]->value = calloc(1, sizeof(*dups[i]->value));
+        CHECK_NULL_NOMEM_GOTO(dups[i]->value, rc, cleanup);
+        rc = rp_oper_store_value_dup(&values[i], dups[i]->value);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to duplicate a pushed value.");
+        sr_xpath_normalize_quotes(dups[i]->value->xpath);
+
+        if (!sr_xpath_in_subtree(dups[i]->value->xpath, subtree)) {
+            SR_LOG_ERR("Pushed value '%s' does not belong to the subtree '%s'.", values[i].xpath, xpath);
+            rc = SR_ERR_INVAL_ARG;
+            goto cleanup;
+        }
+        rc = rp_oper_store_strip_predicates(dups[i]->value->xpath, &schema_paths[i]);
+        CHECK_RC_MSG_GOTO(rc, cleanup, "Failed to create the schema path of a pushed value.");
+    }
+
+    SR_MUTEX_LOCK(&store->mutex, "oper_store_mutex");
+
+    if (replace) {
+        rc = rp_oper_store_remove_subtree_locked(store, module_name, subtree);
+        CHECK_RC_MSG_GOTO(rc, unlock, "Failed to remove previously pushed data.");
+    }
+
+    for (i = 0; i < values_cnt; i++) {
+        rc = rp_oper_store_get_node_locked(store, module_name, schema_paths[i], &node);
+        CHECK_RC_MSG_GOTO(rc, unlock, "Failed to add a schema node into the store.");
+
+        /* merge - the latest value wins */
+        existing = sr_btree_search(node->values, dups[i]);
+        if (NULL != existing) {
+            sr_btree_delete(node->values, existing);
+            node->values_cnt--;
+            store->values_cnt--;
+        }
+
+        rc = sr_btree_insert(node->values, dups[i]);
+        CHECK_RC_MSG_GOTO(rc, unlock, "Failed to insert a pushed value.");
+        dups[i] = NULL;
+        node->values_cnt++;
+        store->values_cnt++;
+    }
+
+    SR_LOG_DBG("%zu value(s) pushed into '%s' (%s), %zu value(s) stored.", values_cnt, xpath,
+            replace ? "replace" : "merge", store->values_cnt);
+
+unlock:
+    SR_MUTEX_UNLOCK(&store->mutex);
+
+cleanup:
+    for (i = 0; i < values_cnt; i++) {
+        if (NULL != dups) {
+            rp_oper_store_value_free(dups[i]);
+        }
+        if (NULL != schema_paths) {
+            free(schema_paths[i]);
+        }
+    }
+    free(dups);
+    free(schema_paths);
+    free(module_name);
+    free(subtree);
+    return rc;
+}
+
+int
+rp_oper_store_get(rp_oper_store_t *store, const char *subtree, sr_val_t **values_p, size_t *values_cnt_p)
+{
+    char *module_name = NULL;
+    sr_list_t *nodes = NULL;
+    rp_oper_store_node_t *node = NULL;
+    rp_oper_store_value_t *value = NULL;
+    sr_val_t *values = NULL;
+    size_t i = 0, j = 0, total = 0, cnt = 0;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG4(store, subtree, values_p, values_cnt_p);
+
+    *values_p = NULL;
+    *values_cnt_p = 0;
+
+    rc = sr_copy_first_ns(subtree, &module_name);
+    CHECK_RC_LOG_RETURN(rc, "Failed to get the module name of '%s'.", subtree);
+
+    rc = sr_list_init(&nodes);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "List init failed");
+
+    SR_MUTEX_LOCK(&store->mutex, "oper_store_mutex");
+
+    /* only the schema nodes of the module are walked, values are indexed by their schema path */
+    rc = rp_oper_store_collect_nodes_locked(store, module_name, subtree, nodes);
+    CHECK_RC_MSG_GOTO(rc, unlock, "Failed to collect schema nodes of the subtree");
+
+    for (i = 0; i < nodes->count; i++) {
+        total += ((rp_oper_store_node_t *) nodes->data[i])->values_cnt;
+    }
+
+    if (total > 0) {
+        values = calloc(total, sizeof(*values));
+        CHECK_NULL_NOMEM_GOTO(values, rc, unlock);
+        for (i = 0; i < nodes->count; i++) {
+            node = (rp_oper_store_node_t *) nodes->data[i];
+            j = 0;
+            while (NULL != (value = sr_btree_get_at(node->values, j++))) {
+                rc = rp_oper_store_value_dup(value->value, &values[cnt]);
+                cnt++;
+                CHECK_RC_MSG_GOTO(rc, unlock, "Failed to duplicate a pushed value.");
+            }
+        }
+    }
+
+unlock:
+    SR_MUTEX_UNLOCK(&store->mutex);
+
+cleanup:
+    sr_list_cleanup(nodes);
+    free(module_name);
+    if (SR_ERR_OK != rc) {
+        sr_free_values(values, cnt);
+        return rc;
+    }
+    *values_p = values;
+    *values_cnt_p = cnt;
+    return SR_ERR_OK;
+}
+
+int
+rp_oper_store_remove_session(rp_oper_store_t *store, uint32_t session_id)
+{
+    rp_oper_store_module_t *module = NULL;
+    rp_oper_store_node_t *node = NULL;
+    rp_oper_store_value_t *value = NULL;
+    sr_list_t *matching = NULL, *empty_nodes = NULL, *empty_modules = NULL;
+    size_t i = 0, j = 0, k = 0, removed = 0;
+    int rc = SR_ERR_OK;
+
+    CHECK_NULL_ARG(store);
+
+    rc = sr_list_init(&matching);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "List init failed");
+    rc = sr_list_init(&empty_nodes);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "List init failed");
+    rc = sr_list_init(&empty_modules);
+    CHECK_RC_MSG_GOTO(rc, cleanup, "List init failed");
+
+    SR_MUTEX_LOCK(&store->mutex, "oper_store_mutex");
+
+    if (0 == store->values_cnt) {
+        goto unlock;
+    }
+
+    /* the trees must not be modified while iterating */
+    i = 0;
+    while (NULL != (module = sr_btree_get_at(store->modules, i++))) {
+        j = 0;
+        while (NULL != (node = sr_btree_get_at(module->nodes, j++))) {
+            k = 0;
+            while (NULL != (value = sr_btree_get_at(node->values, k++))) {
+                if (session_id == value->session_id) {
+                    rc = sr_list_add(matching, value);
+                    CHECK_RC_MSG_GOTO(rc, unlock, "List add failed");
+                }
+            }
+
+            for (k = 0; k < matching->count; k++) {
+                sr_btree_delete(node->values, matching->data[k]);
+                node->values_cnt--;
+                store->values_cnt--;
+            }
+            removed += matching->count;
+            matching->count = 0; /**< clear the list */
+
+            if (0 == node->values_cnt) {
+                rc = sr_list_add(empty_nodes, node);
+                CHECK_RC_MSG_GOTO(rc, unlock, "List add failed");
+            }
+        }
+
+        for (j = 0; j < empty_nodes->count; j++) {
+            sr_btree_delete(module->nodes, empty_nodes->data[j]);
+        }
+        empty_nodes->count = 0; /**< clear the list */
+
+        if (NULL == sr_btree_get_at(module->nodes, 0)) {
+            rc = sr_list_add(empty_modules, module);
+            CHECK_RC_MSG_GOTO(rc, unlock, "List add failed");
+        }
+    }
+
+    for (i = 0; i < empty_modules->count; i++) {
+        sr_btree_delete(store->modules, empty_modules->data[i]);
+    }
+
+    if (removed > 0) {
+        SR_LOG_DBG("%zu value(s) pushed by the session id=%"PRIu32" removed, %zu value(s) stored.", removed,
+                session_id, store->values_cnt);
+    }
+
+unlock:
+    SR_MUTEX_UNLOCK(&store->mutex);
+
+cleanup:
+    sr_list_cleanup(matching);
+    sr_list_cleanup(empty_nodes);
+    sr_list_cleanup(empty_modules);
+    return rc;
+}
+
+size_t
+rp_oper_store_count(rp_oper_store_t *store)
+{
+    size_t cnt = 0;
+
+    if (NULL != store) {
+        SR_MUTEX_LOCK(&store->mutex, "oper_store_mutex");
+        cnt = store->values_cnt;
+        SR_MUTEX_UNLOCK(&store->mutex);
+    }
+    return cnt;
+}
@@ -0,0 +1,104 @@
+/**
+ * @defgroup rp_oper_store Pushed operational data store
+ * @ingroup rp
+ * @{
+ * @brief In-memory store of operational data pushed by the providers.
+ * @file rp_oper_store.h
+ *
+ * Instead of (or in addition to) answering data provide requests, providers may push the operational
+ * data into the store held by the Request Processor by ::sr_oper_data_push. Requests for state data
+ * of subtrees that contain pushed values are then served from the store without waiting for any callback.
+ *
+ * @copyright
+ * Copyright 2016 Cisco Systems, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RP_OPER_STORE_H_
+#define RP_OPER_STORE_H_
+
+#include "sr_common.h"
+
+/**
+ * @brief Pushed operational data store context.
+ */
+typedef struct rp_oper_store_s rp_oper_store_t;
+
+/**
+ * @brief Initializes the store of pushed operational data.
+ *
+ * @param [out] store Allocated store context.
+ *
+ * @return Error code (SR_ERR_OK on success)
+ */
+int rp_oper_store_init(rp_oper_store_t **store);
+
+/**
+ * @brief Frees all resources held by the store.
+ *
+ * @param [in] store Store context acquired by ::rp_oper_store_init.
+ */
+void rp_oper_store_cleanup(rp_oper_store_t *store);
+
+/**
+ * @brief Pushes values into the store.
+ *
+ * @param [in] store Store context.
+ * @param [in] session_id ID of the pushing session, the values are removed when the session stops.
+ * @param [in] xpath XPath of the subtree the values belong to. All values must be placed in this subtree.
+ * @param [in] values Values to be stored.
+ * @param [in] values_cnt Number of the values.
+ * @param [in] replace If set, all values previously pushed into the subtree are dropped first,
+ * otherwise the values are merged with the stored ones (a value with the same xpath is overwritten).
+ *
+ * @return Error code (SR_ERR_OK on success, SR_ERR_INVAL_ARG if a value lies outside of the subtree)
+ */
+int rp_oper_store_push(rp_oper_store_t *store, uint32_t session_id, const char *xpath, const sr_val_t *values,
+        size_t values_cnt, bool replace);
+
+/**
+ * @brief Removes all values pushed by the session (called when the session stops).
+ *
+ * @param [in] store Store context.
+ * @param [in] session_id ID of the session.
+ *
+ * @return Error code (SR_ERR_OK on success)
+ */
+int rp_oper_store_remove_session(rp_oper_store_t *store, uint32_t session_id);
+
+/**
+ * @brief Returns copies of all values stored in the subtree identified by the schema path
+ * (the path of a state data subtree without list keys, as used in module dependency info).
+ *
+ * @param [in] store Store context.
+ * @param [in] subtree Schema path of the subtree.
+ * @param [out] values Duplicated values (without Sysrepo memory context), to be freed by the caller.
+ * @param [out] values_cnt Number of the returned values, 0 if no data have been pushed into the subtree.
+ *
+ * @return Error code (SR_ERR_OK on success)
+ */
+int rp_oper_store_get(rp_oper_store_t *store, const char *subtree, sr_val_t **values, size_t *values_cnt);
+
+/**
+ * @brief Returns the number of values in the store.
+ *
+ * @param [in] store Store context.
+ *
+ * @return Number of stored values.
+ */
+size_t rp_oper_store_count(rp_oper_store_t *store);
+
+/**@} rp_oper_store */
+
+#endif /* RP_OPER_STORE_H_ */
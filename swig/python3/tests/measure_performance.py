@@ -2,7 +2,7 @@ from time import time
 
 import libsysrepoPython3 as sr
 
-# Tests are created to follow already existing performance test implemented in c in tests/measure_performance.c
+# Tests are created to follow already existing performance test implemented in c in tests/sysrepo_bench.c
 # They are meant to compare python2 bindings for sysrepo with the original and as an overall measure for
 # bindings clients.
 
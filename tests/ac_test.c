@@ -26,6 +26,10 @@
 #include <setjmp.h>
 #include <cmocka.h>
 #include <fcntl.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <limits.h>
+#include <pwd.h>
 
 #include "sr_common.h"
 #include "access_control.h"
@@ -360,6 +364,234 @@ ac_test_negative(void **state)
     ac_cleanup(ctx);
 }
 
+/**
+ * @brief Waits until the permission check of the module returns the expected result,
+ * changes of the permissions are noticed asynchronously.
+ */
+static void
+ac_test_wait_for_module_permissions(ac_session_t *session, const char *module_name, const ac_operation_t operation,
+        int expected_rc)
+{
+    int rc = SR_ERR_OK;
+
+    for (size_t i = 0; i < 1000; i++) {
+        rc = ac_check_module_permissions(session, module_name, operation);
+        if (expected_rc == rc) {
+            break;
+        }
+        usleep(1000);
+    }
+    assert_int_equal(rc, expected_rc);
+}
+
+/**
+ * @brief Test opening of files on behalf of the user and invalidation of cached permissions
+ * by a change of the file metadata.
+ */
+static void
+ac_test_file_metadata(void **state)
+{
+    ac_ctx_t *ctx = NULL;
+    ac_session_t *session = NULL;
+    int fd = -1;
+    int rc = SR_ERR_OK;
+
+    /* set real user to current user */
+    ac_ucred_t credentials = { 0 };
+    credentials.r_username = getenv("USER");
+    credentials.r_uid = getuid();
+    credentials.r_gid = getgid();
+
+    /* init */
+    rc = ac_init(TEST_DATA_SEARCH_DIR, &ctx);
+    assert_int_equal(rc, SR_ERR_OK);
+    rc = ac_session_init(ctx, &credentials, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = ac_check_module_permissions(session, "test-module", AC_OPER_READ_WRITE);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* open files on behalf of the user */
+    fd = ac_open_file(ctx, &credentials, TEST_MODULE_DATA_FILE_NAME, O_RDWR, 0);
+    assert_int_not_equal(fd, -1);
+    close(fd);
+
+    fd = ac_open_file(ctx, &credentials, TEST_DATA_SEARCH_DIR "non-existing-module" SR_STARTUP_FILE_EXT, O_RDONLY, 0);
+    assert_int_equal(fd, -1);
+    assert_int_equal(errno, ENOENT);
+
+    if (0 != getuid()) {
+        /* revoke write permission, cached permissions must not be used after the change */
+        assert_int_equal(chmod(TEST_MODULE_DATA_FILE_NAME, S_IRUSR), 0);
+
+        ac_test_wait_for_module_permissions(session, "test-module", AC_OPER_READ_WRITE, SR_ERR_UNAUTHORIZED);
+        rc = ac_check_module_permissions(session, "test-module", AC_OPER_READ);
+        assert_int_equal(rc, SR_ERR_OK);
+
+        fd = ac_open_file(ctx, &credentials, TEST_MODULE_DATA_FILE_NAME, O_RDWR, 0);
+        assert_int_equal(fd, -1);
+        assert_int_equal(errno, EACCES);
+
+        /* granting the permission back is noticed as well */
+        assert_int_equal(chmod(TEST_MODULE_DATA_FILE_NAME, S_IRUSR | S_IWUSR), 0);
+        ac_test_wait_for_module_permissions(session, "test-module", AC_OPER_READ_WRITE, SR_ERR_OK);
+    }
+
+    /* cleanup */
+    ac_session_cleanup(session);
+    ac_cleanup(ctx);
+}
+
+/**
+ * @brief Creates a file with provided ownership and mode.
+ */
+static void
+ac_test_create_file(const char *file_name, const uid_t uid, const gid_t gid, const mode_t mode)
+{
+    int fd = open(file_name, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    assert_int_not_equal(fd, -1);
+    close(fd);
+    assert_int_equal(chown(file_name, uid, gid), 0);
+    assert_int_equal(chmod(file_name, mode), 0);
+}
+
+/**
+ * @brief Checks that the file permissions of the user evaluated by the Access Control module match
+ * the expected ones, both by permission checks and by opening the file on behalf of the user.
+ */
+static void
+ac_test_check_file_access(ac_ctx_t *ctx, ac_session_t *session, const ac_ucred_t *credentials,
+        const char *file_name, bool can_read, bool can_write)
+{
+    int fd = -1;
+    int rc = SR_ERR_OK;
+
+    rc = ac_check_file_permissions(session, file_name, AC_OPER_READ);
+    assert_int_equal(rc, can_read ? SR_ERR_OK : SR_ERR_UNAUTHORIZED);
+    rc = ac_check_file_permissions(session, file_name, AC_OPER_READ_WRITE);
+    assert_int_equal(rc, (can_read && can_write) ? SR_ERR_OK : SR_ERR_UNAUTHORIZED);
+
+    fd = ac_open_file(ctx, credentials, file_name, O_RDONLY, 0);
+    if (can_read) {
+        assert_int_not_equal(fd, -1);
+        close(fd);
+    } else {
+        assert_int_equal(fd, -1);
+        assert_int_equal(errno, EACCES);
+    }
+    fd = ac_open_file(ctx, credentials, file_name, O_RDWR, 0);
+    if (can_read && can_write) {
+        assert_int_not_equal(fd, -1);
+        close(fd);
+    } else {
+        assert_int_equal(fd, -1);
+        assert_int_equal(errno, EACCES);
+    }
+}
+
+/**
+ * @brief Test file permissions of a non-root user evaluated by a privileged process from the metadata
+ * of the files and their parent directories.
+ */
+static void
+ac_test_file_metadata_priviledged(void **state)
+{
+    ac_ctx_t *ctx = NULL;
+    ac_session_t *session = NULL;
+    struct passwd *pw = NULL;
+    char dir_name[] = "/tmp/ac_test_XXXXXX";
+    char owner_file[PATH_MAX] = { 0, }, owner_ro_file[PATH_MAX] = { 0, }, owner_none_file[PATH_MAX] = { 0, };
+    char group_file[PATH_MAX] = { 0, }, group_ro_file[PATH_MAX] = { 0, }, other_file[PATH_MAX] = { 0, };
+    char none_file[PATH_MAX] = { 0, }, link_file[PATH_MAX] = { 0, };
+    int rc = SR_ERR_OK;
+
+    if (0 != getuid()) {
+        /* run the test only for privileged user */
+        return;
+    }
+    pw = getpwnam("nobody");
+    if (NULL == pw || 0 == pw->pw_uid || 0 == pw->pw_gid) {
+        /* an unprivileged user is needed */
+        return;
+    }
+
+    /* act as an unprivileged user */
+    ac_ucred_t credentials = { 0 };
+    credentials.r_username = "nobody";
+    credentials.r_uid = pw->pw_uid;
+    credentials.r_gid = pw->pw_gid;
+
+    /* files with the permissions granted to the owner, group and others */
+    assert_non_null(mkdtemp(dir_name));
+    assert_int_equal(chmod(dir_name, S_IRWXU | S_IXGRP | S_IXOTH), 0);
+    snprintf(owner_file, PATH_MAX, "%s/owner", dir_name);
+    snprintf(owner_ro_file, PATH_MAX, "%s/owner-ro", dir_name);
+    snprintf(owner_none_file, PATH_MAX, "%s/owner-none", dir_name);
+    snprintf(group_file, PATH_MAX, "%s/group", dir_name);
+    snprintf(group_ro_file, PATH_MAX, "%s/group-ro", dir_name);
+    snprintf(other_file, PATH_MAX, "%s/other", dir_name);
+    snprintf(none_file, PATH_MAX, "%s/none", dir_name);
+    snprintf(link_file, PATH_MAX, "%s/link", dir_name);
+    ac_test_create_file(owner_file, credentials.r_uid, 0, S_IRUSR | S_IWUSR);
+    ac_test_create_file(owner_ro_file, credentials.r_uid, 0, S_IRUSR);
+    ac_test_create_file(owner_none_file, credentials.r_uid, 0, S_IRWXG | S_IRWXO);
+    ac_test_create_file(group_file, 0, credentials.r_gid, S_IRGRP | S_IWGRP);
+    ac_test_create_file(group_ro_file, 0, credentials.r_gid, S_IRGRP);
+    ac_test_create_file(other_file, 0, 0, S_IROTH | S_IWOTH);
+    ac_test_create_file(none_file, credentials.r_uid, credentials.r_gid, 0);
+    assert_int_equal(symlink(owner_file, link_file), 0);
+
+    /* init */
+    rc = ac_init(TEST_DATA_SEARCH_DIR, &ctx);
+    assert_int_equal(rc, SR_ERR_OK);
+    rc = ac_session_init(ctx, &credentials, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    ac_test_check_file_access(ctx, session, &credentials, owner_file, true, true);
+    ac_test_check_file_access(ctx, session, &credentials, owner_ro_file, true, false);
+    ac_test_check_file_access(ctx, session, &credentials, owner_none_file, false, false);
+    ac_test_check_file_access(ctx, session, &credentials, group_file, true, true);
+    ac_test_check_file_access(ctx, session, &credentials, group_ro_file, true, false);
+    ac_test_check_file_access(ctx, session, &credentials, other_file, true, true);
+    ac_test_check_file_access(ctx, session, &credentials, none_file, false, false);
+
+    /* a change of the mode is noticed immediately */
+    assert_int_equal(chmod(owner_file, 0), 0);
+    ac_test_check_file_access(ctx, session, &credentials, owner_file, false, false);
+    assert_int_equal(chmod(owner_file, S_IRUSR | S_IWUSR), 0);
+    ac_test_check_file_access(ctx, session, &credentials, owner_file, true, true);
+
+    /* a change of the ownership is noticed immediately */
+    assert_int_equal(chown(other_file, 0, 0), 0);
+    assert_int_equal(chmod(other_file, S_IRUSR | S_IWUSR), 0);
+    ac_test_check_file_access(ctx, session, &credentials, other_file, false, false);
+    assert_int_equal(chown(other_file, credentials.r_uid, 0), 0);
+    ac_test_check_file_access(ctx, session, &credentials, other_file, true, true);
+
+    /* the parent directory must be searchable */
+    assert_int_equal(chmod(dir_name, S_IRWXU), 0);
+    ac_test_check_file_access(ctx, session, &credentials, owner_file, false, false);
+    assert_int_equal(chmod(dir_name, S_IRWXU | S_IXGRP | S_IXOTH), 0);
+    ac_test_check_file_access(ctx, session, &credentials, owner_file, true, true);
+
+    /* symbolic links are followed */
+    ac_test_check_file_access(ctx, session, &credentials, link_file, true, true);
+
+    /* cleanup */
+    ac_session_cleanup(session);
+    ac_cleanup(ctx);
+
+    unlink(link_file);
+    unlink(owner_file);
+    unlink(owner_ro_file);
+    unlink(owner_none_file);
+    unlink(group_file);
+    unlink(group_ro_file);
+    unlink(other_file);
+    unlink(none_file);
+    rmdir(dir_name);
+}
+
 int
 main() {
     const struct CMUnitTest tests[] = {
@@ -367,6 +599,8 @@ main() {
             cmocka_unit_test_setup_teardown(ac_test_priviledged, ac_test_setup, ac_test_teardown),
             cmocka_unit_test_setup_teardown(ac_test_identity_switch, ac_test_setup, ac_test_teardown),
             cmocka_unit_test_setup_teardown(ac_test_negative, ac_test_setup, ac_test_teardown),
+            cmocka_unit_test_setup_teardown(ac_test_file_metadata, ac_test_setup, ac_test_teardown),
+            cmocka_unit_test_setup_teardown(ac_test_file_metadata_priviledged, ac_test_setup, ac_test_teardown),
     };
 
     watchdog_start(300);
@@ -1224,6 +1224,83 @@ cl_invalid_change_xpath_cb(sr_session_ctx_t *session, const char *module_name, s
     return SR_ERR_OK;
 }
 
+/**
+ * @brief Returns the number of get-changes requests processed by the engine so far.
+ */
+static uint64_t
+cl_get_changes_request_count(sr_session_ctx_t *session)
+{
+    sr_val_t *value = NULL;
+    uint64_t cnt = 0;
+
+    if (SR_ERR_OK == sr_get_item(session,
+            "/sysrepo-monitoring:sysrepo-state/request-processor/request[operation='get changes']/count", &value)) {
+        cnt = value->data.uint64_val;
+        sr_free_val(value);
+    }
+    return cnt;
+}
+
+static void
+cl_inline_changes_test(void **state)
+{
+    sr_conn_ctx_t *conn = *state;
+    assert_non_null(conn);
+    sr_session_ctx_t *session = NULL;
+    sr_subscription_ctx_t *subscription = NULL;
+    changes_t changes = {.mutex = PTHREAD_MUTEX_INITIALIZER, .cv = PTHREAD_COND_INITIALIZER, 0};
+    struct timespec ts;
+    uint64_t get_changes_cnt = 0;
+    int rc = SR_ERR_OK;
+
+    /* start session */
+    rc = sr_session_start(conn, SR_DS_RUNNING, SR_SESS_DEFAULT, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_module_change_subscribe(session, "test-module", list_changes_cb, &changes,
+            0, SR_SUBSCR_INLINE_CHANGES, &subscription);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    sr_val_t v = {0};
+    v.type = SR_UINT8_T;
+    v.data.uint8_val = 21;
+
+    rc = sr_set_item(session, "/test-module:main/ui8", &v, SR_EDIT_DEFAULT);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    get_changes_cnt = cl_get_changes_request_count(session);
+
+    pthread_mutex_lock(&changes.mutex);
+    rc = sr_commit(session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    sr_clock_get_time(CLOCK_REALTIME, &ts);
+    ts.tv_sec += COND_WAIT_SEC;
+    pthread_cond_timedwait(&changes.cv, &changes.mutex, &ts);
+
+    assert_int_equal(changes.cnt, 1);
+    assert_int_equal(changes.oper[0], SR_OP_MODIFIED);
+    assert_non_null(changes.new_values[0]);
+    assert_non_null(changes.old_values[0]);
+    assert_string_equal("/test-module:main/ui8", changes.new_values[0]->xpath);
+    assert_int_equal(21, changes.new_values[0]->data.uint8_val);
+
+    for (size_t i = 0; i < changes.cnt; i++) {
+        sr_free_val(changes.new_values[i]);
+        sr_free_val(changes.old_values[i]);
+    }
+    pthread_mutex_unlock(&changes.mutex);
+
+    /* the changes have been delivered with the notification, no get-changes request has been sent */
+    assert_int_equal(get_changes_cnt, cl_get_changes_request_count(session));
+
+    pthread_mutex_destroy(&changes.mutex);
+    pthread_cond_destroy(&changes.cv);
+
+    sr_unsubscribe(session, subscription);
+    sr_session_stop(session);
+}
+
 static void
 cl_invalid_xpath_test(void **state)
 {
@@ -1827,6 +1904,62 @@ cl_refused_by_verifier(void **state)
     assert_int_equal(rc, SR_ERR_OK);
 }
 
+static void
+cl_refused_by_priority_verifier(void **state)
+{
+    /* verifier with lower priority is not notified if the changes are refused by the one with higher priority */
+    sr_conn_ctx_t *conn = *state;
+    assert_non_null(conn);
+    sr_session_ctx_t *session = NULL;
+    sr_subscription_ctx_t *subscriptionA = NULL, *subscriptionB = NULL;
+    changes_t changesA = {.mutex = PTHREAD_MUTEX_INITIALIZER, .cv = PTHREAD_COND_INITIALIZER, 0};
+    changes_t changesB = {.mutex = PTHREAD_MUTEX_INITIALIZER, .cv = PTHREAD_COND_INITIALIZER, 0};
+    int rc = SR_ERR_OK;
+
+    /* start session */
+    rc = sr_session_start(conn, SR_DS_CANDIDATE, SR_SESS_DEFAULT, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_module_change_subscribe(session, "example-module", list_changes_cb, &changesA,
+            0, SR_SUBSCR_DEFAULT, &subscriptionA);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_module_change_subscribe(session, "test-module", list_changes_cb, &changesB,
+            10, SR_SUBSCR_DEFAULT | SR_SUBSCR_NO_ABORT_FOR_REFUSED_CFG, &subscriptionB);
+    assert_int_equal(rc, SR_ERR_OK);
+    changesB.verify_fails = true;
+
+    rc = sr_set_item(session, "/example-module:container/list[key1='abc'][key2='def']", NULL, SR_EDIT_DEFAULT);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_delete_item(session, "/test-module:main/i8", SR_EDIT_STRICT);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_commit(session);
+    assert_int_equal(rc, SR_ERR_OPERATION_FAILED);
+
+    assert_true(changesB.events_received & VERIFY_CALLED);
+    assert_false(changesB.events_received & APPLY_CALLED);
+    assert_false(changesB.events_received & ABORT_CALLED);
+
+    /* lower priority verifier has been skipped */
+    assert_int_equal(changesA.events_received, 0);
+
+    pthread_mutex_destroy(&changesA.mutex);
+    pthread_cond_destroy(&changesA.cv);
+    pthread_mutex_destroy(&changesB.mutex);
+    pthread_cond_destroy(&changesB.cv);
+
+    rc = sr_unsubscribe(NULL, subscriptionA);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_unsubscribe(NULL, subscriptionB);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_session_stop(session);
+    assert_int_equal(rc, SR_ERR_OK);
+}
+
 static void
 cl_no_abort_notifications(void **state)
 {
@@ -2849,6 +2982,7 @@ main()
         cmocka_unit_test_setup_teardown(cl_get_changes_parents_test, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_notif_priority_test, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_whole_module_changes, sysrepo_setup, sysrepo_teardown),
+        cmocka_unit_test_setup_teardown(cl_inline_changes_test, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_invalid_xpath_test, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_children_subscription_test, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_subscribe_top_level_mandatory, sysrepo_setup, sysrepo_teardown),
@@ -2856,6 +2990,7 @@ main()
         cmocka_unit_test_setup_teardown(cl_combined_subscribers, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_successful_verifiers, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_refused_by_verifier, sysrepo_setup, sysrepo_teardown),
+        cmocka_unit_test_setup_teardown(cl_refused_by_priority_verifier, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_no_abort_notifications, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_one_abort_notification, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_subtree_verifier, sysrepo_setup, sysrepo_teardown),
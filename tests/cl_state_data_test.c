@@ -569,6 +569,80 @@ cl_dp_traffic_stats(const char *xpath, sr_val_t **values, size_t *values_cnt, vo
     return 0;
 }
 
+/**
+ * @brief Fails to provide the traffic lights of the second cross road, provides the rest as cl_dp_traffic_stats.
+ */
+int
+cl_dp_traffic_stats_partial(const char *xpath, sr_val_t **values, size_t *values_cnt, void *private_ctx)
+{
+    if (0 == strcmp("/state-module:traffic_stats/cross_road[id='1']/traffic_light", xpath)) {
+        *values = NULL;
+        *values_cnt = 0;
+        return SR_ERR_INTERNAL;
+    }
+    return cl_dp_traffic_stats(xpath, values, values_cnt, private_ctx);
+}
+
+/**
+ * @brief Counts the batched data provider calls.
+ */
+typedef struct cl_dp_batch_ctx_s {
+    sr_list_t *xpaths;   /**< All requested xpaths. */
+    size_t calls;        /**< Number of callback calls. */
+} cl_dp_batch_ctx_t;
+
+int
+cl_dp_traffic_stats_batch(const char **xpaths, size_t xpath_cnt, sr_val_t **values, size_t *values_cnt, void *private_ctx)
+{
+    cl_dp_batch_ctx_t *ctx = (cl_dp_batch_ctx_t *) private_ctx;
+    size_t cnt = 0, pos = 0;
+    int rc = SR_ERR_OK;
+
+    ctx->calls++;
+
+    /* count the values */
+    for (size_t i = 0; i < xpath_cnt; i++) {
+        if (0 != sr_list_add(ctx->xpaths, strdup(xpaths[i]))) {
+            SR_LOG_ERR_MSG("Error while adding into list");
+        }
+        if (0 == strcmp("/state-module:traffic_stats", xpaths[i])) {
+            cnt += 1;
+        } else if (0 == strcmp("/state-module:traffic_stats/cross_road", xpaths[i])) {
+            cnt += 3;
+        } else if (0 == strcmp("traffic_light", sr_xpath_node_name(xpaths[i]))) {
+            cnt += 1;
+        }
+    }
+
+    rc = sr_new_values(cnt, values);
+    if (SR_ERR_OK != rc) {
+        return rc;
+    }
+    *values_cnt = cnt;
+
+    /* fill the values of all requested xpaths */
+    for (size_t i = 0; i < xpath_cnt; i++) {
+        if (0 == strcmp("/state-module:traffic_stats", xpaths[i])) {
+            sr_val_set_xpath(&(*values)[pos], "/state-module:traffic_stats/number_of_accidents");
+            (*values)[pos].type = SR_UINT8_T;
+            (*values)[pos].data.uint8_val = 4;
+            pos++;
+        } else if (0 == strcmp("/state-module:traffic_stats/cross_road", xpaths[i])) {
+            for (int id = 0; id < 3; id++) {
+                sr_val_build_xpath(&(*values)[pos], "/state-module:traffic_stats/cross_road[id='%d']/status", id);
+                sr_val_set_str_data(&(*values)[pos], SR_ENUM_T, "automatic");
+                pos++;
+            }
+        } else if (0 == strcmp("traffic_light", sr_xpath_node_name(xpaths[i]))) {
+            sr_val_build_xpath(&(*values)[pos], "%s[name='a']/color", xpaths[i]);
+            sr_val_set_str_data(&(*values)[pos], SR_ENUM_T, "green");
+            pos++;
+        }
+    }
+
+    return SR_ERR_OK;
+}
+
 int
 cl_dp_cross_road(const char *xpath, sr_val_t **values, size_t *values_cnt, void *private_ctx)
 {
@@ -741,6 +815,52 @@ cl_dp_card_state(const char *xpath, sr_val_t **values, size_t *values_cnt, void
 }
 
 
+static int
+cl_dp_traffic_stats_tree(const char *xpath, sr_node_t **trees, size_t *tree_cnt, void *private_ctx)
+{
+    sr_node_t *tree = NULL, *road = NULL, *light = NULL, *info = NULL, *node = NULL;
+    int rc = SR_ERR_OK;
+
+    sr_list_t *l = (sr_list_t *) private_ctx;
+    if (0 != sr_list_add(l, strdup(xpath))) {
+        SR_LOG_ERR_MSG("Error while adding into list");
+    }
+
+    /* the whole subtree is provided in one tree */
+    rc = sr_new_tree("traffic_stats", "state-module", &tree);
+    if (SR_ERR_OK != rc) {
+        return rc;
+    }
+    tree->type = SR_CONTAINER_T;
+
+    sr_node_add_child(tree, "number_of_accidents", NULL, &node);
+    node->type = SR_UINT8_T;
+    node->data.uint8_val = 2;
+
+    for (uint32_t id = 1; id <= 2; id++) {
+        sr_node_add_child(tree, "cross_road", NULL, &road);
+        road->type = SR_LIST_T;
+        sr_node_add_child(road, "id", NULL, &node);
+        node->type = SR_UINT32_T;
+        node->data.uint32_val = id;
+        sr_node_add_child(road, "traffic_light", NULL, &light);
+        light->type = SR_LIST_T;
+        sr_node_add_child(light, "name", NULL, &node);
+        sr_node_set_str_data(node, SR_STRING_T, "a");
+        sr_node_add_child(light, "color", NULL, &node);
+        sr_node_set_str_data(node, SR_ENUM_T, 1 == id ? "red" : "green");
+        sr_node_add_child(road, "advanced_info", NULL, &info);
+        info->type = SR_CONTAINER_T;
+        sr_node_add_child(info, "latitude", NULL, &node);
+        sr_node_set_str_data(node, SR_STRING_T, "48.729885N");
+    }
+
+    *trees = tree;
+    *tree_cnt = 1;
+
+    return SR_ERR_OK;
+}
+
 static void
 cl_parent_subscription(void **state)
 {
@@ -2202,6 +2322,133 @@ cl_nested_data_subscription_tree(void **state)
     sr_list_cleanup(xpath_retrieved);
 }
 
+static void
+cl_nested_data_batch_subscription(void **state)
+{
+    sr_conn_ctx_t *conn = *state;
+    assert_non_null(conn);
+    sr_session_ctx_t *session = NULL;
+    sr_subscription_ctx_t *subscription = NULL;
+    cl_dp_batch_ctx_t ctx = { 0, };
+    sr_val_t *values = NULL, *value = NULL;
+    size_t cnt = 0;
+    int rc = SR_ERR_OK;
+
+    rc = sr_list_init(&ctx.xpaths);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* start session */
+    rc = sr_session_start(conn, SR_DS_RUNNING, SR_SESS_DEFAULT, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_module_change_subscribe(session, "state-module", cl_whole_module_cb, NULL,
+            0, SR_SUBSCR_DEFAULT, &subscription);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* subscribe data provider */
+    rc = sr_dp_get_items_batch_subscribe(session, "/state-module:traffic_stats", cl_dp_traffic_stats_batch, &ctx, SR_SUBSCR_CTX_REUSE, &subscription);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* retrieve data */
+    rc = sr_get_items(session, "/state-module:traffic_stats/*", &values, &cnt);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* check data */
+    assert_non_null(values);
+    assert_int_equal(4, cnt);
+    sr_free_values(values, cnt);
+
+    /* nested data of all list instances were requested at once */
+    const char *xpath_expected_to_be_loaded [] = {
+        "/state-module:traffic_stats",
+        "/state-module:traffic_stats/cross_road",
+        "/state-module:traffic_stats/cross_road[id='0']/traffic_light",
+        "/state-module:traffic_stats/cross_road[id='0']/advanced_info",
+        "/state-module:traffic_stats/cross_road[id='1']/traffic_light",
+        "/state-module:traffic_stats/cross_road[id='1']/advanced_info",
+        "/state-module:traffic_stats/cross_road[id='2']/traffic_light",
+        "/state-module:traffic_stats/cross_road[id='2']/advanced_info",
+    };
+    CHECK_LIST_OF_STRINGS(ctx.xpaths, xpath_expected_to_be_loaded);
+    assert_int_equal(3, ctx.calls);
+
+    rc = sr_get_item(session, "/state-module:traffic_stats/cross_road[id='2']/traffic_light[name='a']/color", &value);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_int_equal(SR_ENUM_T, value->type);
+    assert_string_equal("green", value->data.enum_val);
+    sr_free_val(value);
+
+    /* cleanup */
+    sr_unsubscribe(session, subscription);
+    sr_session_stop(session);
+
+    for (size_t i = 0; i < ctx.xpaths->count; i++) {
+        free(ctx.xpaths->data[i]);
+    }
+    sr_list_cleanup(ctx.xpaths);
+}
+
+static void
+cl_nested_data_batch_partial_failure(void **state)
+{
+    sr_conn_ctx_t *conn = *state;
+    assert_non_null(conn);
+    sr_session_ctx_t *session = NULL;
+    sr_subscription_ctx_t *subscription = NULL;
+    sr_list_t *xpath_retrieved = NULL;
+    sr_val_t *values = NULL;
+    size_t cnt = 0, lights[3] = { 0, }, advanced_info = 0;
+    int rc = SR_ERR_OK;
+
+    rc = sr_list_init(&xpath_retrieved);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* start session */
+    rc = sr_session_start(conn, SR_DS_RUNNING, SR_SESS_DEFAULT, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_module_change_subscribe(session, "state-module", cl_whole_module_cb, NULL,
+            0, SR_SUBSCR_DEFAULT, &subscription);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* subscribe data provider that fails for one of the nested xpaths */
+    rc = sr_dp_get_items_subscribe(session, "/state-module:traffic_stats", cl_dp_traffic_stats_partial, xpath_retrieved,
+            SR_SUBSCR_CTX_REUSE, &subscription);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* retrieve data */
+    rc = sr_get_items(session, "/state-module:traffic_stats//*", &values, &cnt);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* the data of the other xpaths in the batch were kept */
+    for (size_t i = 0; i < cnt; i++) {
+        for (int id = 0; id < 3; id++) {
+            char prefix[MAX_LEN] = { 0, };
+            snprintf(prefix, MAX_LEN, "/state-module:traffic_stats/cross_road[id='%d']/traffic_light[", id);
+            if (0 == strncmp(prefix, values[i].xpath, strlen(prefix)) && NULL != strstr(values[i].xpath, "/color")) {
+                lights[id]++;
+            }
+        }
+        if (0 == strcmp("/state-module:traffic_stats/cross_road[id='0']/advanced_info/latitude", values[i].xpath)) {
+            advanced_info++;
+        }
+    }
+    sr_free_values(values, cnt);
+    assert_int_equal(3, lights[0]);
+    assert_int_equal(0, lights[1]);
+    assert_int_equal(3, lights[2]);
+    assert_int_equal(1, advanced_info);
+
+    /* cleanup */
+    sr_unsubscribe(session, subscription);
+    sr_session_stop(session);
+
+    for (size_t i = 0; i < xpath_retrieved->count; i++) {
+        free(xpath_retrieved->data[i]);
+    }
+    sr_list_cleanup(xpath_retrieved);
+}
+
 static void
 cl_nested_data_subscription2(void **state)
 {
@@ -3097,6 +3344,397 @@ cl_state_data_in_grouping(void **state)
 
 }
 
+static void
+cl_dp_cache(void **state)
+{
+    sr_conn_ctx_t *conn = *state;
+    assert_non_null(conn);
+    sr_session_ctx_t *session = NULL;
+    sr_subscription_ctx_t *subscription = NULL;
+    sr_list_t *xpath_retrieved = NULL;
+    sr_val_t *values = NULL, *value = NULL;
+    size_t cnt = 0;
+    int rc = SR_ERR_OK;
+
+    rc = sr_list_init(&xpath_retrieved);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* start session */
+    rc = sr_session_start(conn, SR_DS_RUNNING, SR_SESS_DEFAULT, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_module_change_subscribe(session, "state-module", cl_whole_module_cb, NULL,
+            0, SR_SUBSCR_DEFAULT, &subscription);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* subscribe data provider with data valid for one minute */
+    rc = sr_dp_get_items_subscribe_cached(session, "/state-module:cards/card/state", cl_dp_card_state, xpath_retrieved,
+            SR_DP_CACHE_TTL_MAX + 1, SR_SUBSCR_CTX_REUSE, &subscription);
+    assert_int_equal(rc, SR_ERR_INVAL_ARG);
+
+    rc = sr_dp_get_items_subscribe_cached(session, "/state-module:cards/card/state", cl_dp_card_state, xpath_retrieved,
+            60000, SR_SUBSCR_CTX_REUSE, &subscription);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_set_item(session, "/state-module:cards/card[dn='abc']", NULL, SR_EDIT_DEFAULT);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* the first request is served by the data provider */
+    rc = sr_get_items(session, "/state-module:cards//*", &values, &cnt);
+    assert_int_equal(rc, SR_ERR_OK);
+    sr_free_values(values, cnt);
+    assert_int_equal(1, xpath_retrieved->count);
+
+    /* the second one from the cache */
+    rc = sr_get_item(session, "/state-module:cards/card[dn='abc']/state/c_state", &value);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_string_equal("OK", value->data.string_val);
+    sr_free_val(value);
+    assert_int_equal(1, xpath_retrieved->count);
+
+    rc = sr_get_item(session, "/sysrepo-monitoring:sysrepo-state/dp-cache/hits", &value);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_int_equal(SR_UINT64_T, value->type);
+    assert_true(value->data.uint64_val >= 1);
+    sr_free_val(value);
+
+    /* latency of the data provider is recorded */
+    rc = sr_get_item(session, "/sysrepo-monitoring:sysrepo-state/data-provider[xpath='/state-module:cards/card/state']/request-count", &value);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_int_equal(SR_UINT64_T, value->type);
+    assert_true(value->data.uint64_val >= 1);
+    sr_free_val(value);
+
+    /* invalidated entry is requested again */
+    rc = sr_dp_cache_invalidate(session, "/state-module:cards");
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_get_items(session, "/state-module:cards//*", &values, &cnt);
+    assert_int_equal(rc, SR_ERR_OK);
+    sr_free_values(values, cnt);
+    assert_int_equal(2, xpath_retrieved->count);
+
+    for (size_t i = 0; i < xpath_retrieved->count; i++) {
+        free(xpath_retrieved->data[i]);
+    }
+    sr_list_cleanup(xpath_retrieved);
+
+    /* cleanup */
+    sr_unsubscribe(session, subscription);
+    sr_session_stop(session);
+}
+
+static void
+cl_oper_data_push(void **state)
+{
+    sr_conn_ctx_t *conn = *state;
+    assert_non_null(conn);
+    sr_session_ctx_t *session = NULL, *push_session = NULL;
+    sr_subscription_ctx_t *subscription = NULL;
+    sr_val_t value = { 0, }, *result = NULL;
+    int rc = SR_ERR_OK;
+
+    /* start session */
+    rc = sr_session_start(conn, SR_DS_RUNNING, SR_SESS_DEFAULT, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_module_change_subscribe(session, "state-module", cl_whole_module_cb, NULL,
+            0, SR_SUBSCR_DEFAULT, &subscription);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_set_item(session, "/state-module:cards/card[dn='abc']", NULL, SR_EDIT_DEFAULT);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* configuration data can not be pushed */
+    value.xpath = "/state-module:cards/card[dn='abc']/dn";
+    value.type = SR_STRING_T;
+    value.data.string_val = "abc";
+    rc = sr_oper_data_push(session, "/state-module:cards/card[dn='abc']", &value, 1, SR_OPER_PUSH_DEFAULT);
+    assert_int_equal(rc, SR_ERR_INVAL_ARG);
+
+    /* values must belong to the subtree */
+    value.xpath = "/state-module:cards/card[dn='def']/state/c_state";
+    value.data.string_val = "OK";
+    rc = sr_oper_data_push(session, "/state-module:cards/card[dn='abc']/state", &value, 1, SR_OPER_PUSH_DEFAULT);
+    assert_int_equal(rc, SR_ERR_INVAL_ARG);
+
+    /* push the state of a configured and a not configured card */
+    rc = sr_oper_data_push(session, "/state-module:cards/card[dn='def']/state", &value, 1, SR_OPER_PUSH_DEFAULT);
+    assert_int_equal(rc, SR_ERR_OK);
+    value.xpath = "/state-module:cards/card[dn='abc']/state/c_state";
+    rc = sr_oper_data_push(session, "/state-module:cards/card[dn='abc']/state", &value, 1, SR_OPER_PUSH_DEFAULT);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* no data provider is needed */
+    rc = sr_get_item(session, "/state-module:cards/card[dn='abc']/state/c_state", &result);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_string_equal("OK", result->data.string_val);
+    sr_free_val(result);
+
+    rc = sr_get_item(session, "/state-module:cards/card[dn='def']/state/c_state", &result);
+    assert_int_equal(rc, SR_ERR_NOT_FOUND);
+
+    /* incremental update */
+    value.data.string_val = "FAILED";
+    rc = sr_oper_data_push(session, "/state-module:cards/card[dn='abc']/state/c_state", &value, 1, SR_OPER_PUSH_DEFAULT);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_get_item(session, "/state-module:cards/card[dn='abc']/state/c_state", &result);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_string_equal("FAILED", result->data.string_val);
+    sr_free_val(result);
+
+    /* keys enclosed in double quotes identify the same list instance */
+    value.xpath = "/state-module:cards/card[dn=\"abc\"]/state/c_state";
+    value.data.string_val = "OK";
+    rc = sr_oper_data_push(session, "/state-module:cards/card[dn=\"abc\"]/state", &value, 1, SR_OPER_PUSH_DEFAULT);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_get_item(session, "/state-module:cards/card[dn='abc']/state/c_state", &result);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_string_equal("OK", result->data.string_val);
+    sr_free_val(result);
+
+    /* remove the pushed data */
+    rc = sr_oper_data_push(session, "/state-module:cards/card[dn='abc']/state", NULL, 0, SR_OPER_PUSH_REPLACE);
+    assert_int_equal(rc, SR_ERR_OK);
+    rc = sr_oper_data_push(session, "/state-module:cards/card[dn='def']/state", NULL, 0, SR_OPER_PUSH_REPLACE);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_get_item(session, "/state-module:cards/card[dn='abc']/state/c_state", &result);
+    assert_int_equal(rc, SR_ERR_NOT_FOUND);
+
+    /* data pushed by another session are removed when the session stops */
+    rc = sr_session_start(conn, SR_DS_RUNNING, SR_SESS_DEFAULT, &push_session);
+    assert_int_equal(rc, SR_ERR_OK);
+    rc = sr_oper_data_push(push_session, "/state-module:cards/card[dn='abc']/state", &value, 1, SR_OPER_PUSH_DEFAULT);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_get_item(session, "/state-module:cards/card[dn='abc']/state/c_state", &result);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_string_equal("OK", result->data.string_val);
+    sr_free_val(result);
+
+    rc = sr_session_stop(push_session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_get_item(session, "/state-module:cards/card[dn='abc']/state/c_state", &result);
+    assert_int_equal(rc, SR_ERR_NOT_FOUND);
+
+    /* cleanup */
+    sr_unsubscribe(session, subscription);
+    sr_session_stop(session);
+}
+
+static void
+cl_dp_tree_provider(void **state)
+{
+    sr_conn_ctx_t *conn = *state;
+    assert_non_null(conn);
+    sr_session_ctx_t *session = NULL;
+    sr_subscription_ctx_t *subscription = NULL;
+    sr_list_t *xpath_retrieved = NULL;
+    sr_val_t *values = NULL, *value = NULL;
+    size_t cnt = 0;
+    int rc = SR_ERR_OK;
+
+    rc = sr_list_init(&xpath_retrieved);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* start session */
+    rc = sr_session_start(conn, SR_DS_RUNNING, SR_SESS_DEFAULT, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_dp_get_items_subscribe_tree(session, "/state-module:traffic_stats", cl_dp_traffic_stats_tree, xpath_retrieved,
+            SR_SUBSCR_DEFAULT, &subscription);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_get_items(session, "/state-module:traffic_stats//*", &values, &cnt);
+    assert_int_equal(rc, SR_ERR_OK);
+    /* number_of_accidents + 2 x (cross_road, id, traffic_light, name, color, advanced_info, latitude) */
+    assert_int_equal(15, cnt);
+    sr_free_values(values, cnt);
+
+    rc = sr_get_item(session, "/state-module:traffic_stats/cross_road[id='2']/traffic_light[name='a']/color", &value);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_int_equal(SR_ENUM_T, value->type);
+    assert_string_equal("green", value->data.enum_val);
+    sr_free_val(value);
+
+    rc = sr_get_item(session, "/state-module:traffic_stats/number_of_accidents", &value);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_int_equal(2, value->data.uint8_val);
+    sr_free_val(value);
+
+    /* nested data provided within the tree are not requested separately */
+    assert_int_equal(3, xpath_retrieved->count);
+    for (size_t i = 0; i < xpath_retrieved->count; i++) {
+        assert_string_equal("/state-module:traffic_stats", xpath_retrieved->data[i]);
+        free(xpath_retrieved->data[i]);
+    }
+    sr_list_cleanup(xpath_retrieved);
+
+    /* cleanup */
+    sr_unsubscribe(session, subscription);
+    sr_session_stop(session);
+}
+
+static int
+cl_dp_humidity(const char *xpath, sr_val_t **values, size_t *values_cnt, void *private_ctx)
+{
+    sr_list_t *l = (sr_list_t *) private_ctx;
+
+    if (0 != sr_list_add(l, strdup(xpath))) {
+        SR_LOG_ERR_MSG("Error while adding into list");
+    }
+
+    *values = calloc(1, sizeof(**values));
+    if (NULL == *values) {
+        SR_LOG_ERR_MSG("Allocation failed");
+        return SR_ERR_NOMEM;
+    }
+    (*values)[0].xpath = strdup("/state-module:weather/humidity");
+    (*values)[0].type = SR_UINT8_T;
+    (*values)[0].data.uint8_val = 50;
+    *values_cnt = 1;
+
+    return SR_ERR_OK;
+}
+
+static int
+cl_dp_number_of_accidents_slow(const char *xpath, sr_val_t **values, size_t *values_cnt, void *private_ctx)
+{
+    sr_list_t *l = (sr_list_t *) private_ctx;
+
+    if (0 != sr_list_add(l, strdup(xpath))) {
+        SR_LOG_ERR_MSG("Error while adding into list");
+    }
+
+    /* answer after the deadline of the data provider */
+    sleep(SR_OPER_DATA_PROVIDER_TIMEOUT + 1);
+
+    *values = calloc(1, sizeof(**values));
+    if (NULL == *values) {
+        SR_LOG_ERR_MSG("Allocation failed");
+        return SR_ERR_NOMEM;
+    }
+    (*values)[0].xpath = strdup("/state-module:traffic_stats/number_of_accidents");
+    (*values)[0].type = SR_UINT8_T;
+    (*values)[0].data.uint8_val = 2;
+    *values_cnt = 1;
+
+    return SR_ERR_OK;
+}
+
+static void
+cl_dp_provider_deadline(void **state)
+{
+    sr_conn_ctx_t *conn = *state;
+    assert_non_null(conn);
+    sr_session_ctx_t *session = NULL;
+    sr_subscription_ctx_t *subscription = NULL;
+    sr_list_t *xpath_retrieved = NULL;
+    const sr_error_info_t *err_info = NULL;
+    sr_val_t *values = NULL, *value = NULL;
+    size_t cnt = 0;
+    int rc = SR_ERR_OK;
+
+    rc = sr_list_init(&xpath_retrieved);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* start session */
+    rc = sr_session_start(conn, SR_DS_RUNNING, SR_SESS_DEFAULT, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* the request for weather precedes the one for traffic stats (schema order), so the fast
+     * provider is called before the slow one blocks the subscription thread */
+    rc = sr_dp_get_items_subscribe(session, "/state-module:weather/humidity", cl_dp_humidity, xpath_retrieved,
+            SR_SUBSCR_DEFAULT, &subscription);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = sr_dp_get_items_subscribe(session, "/state-module:traffic_stats/number_of_accidents", cl_dp_number_of_accidents_slow,
+            xpath_retrieved, SR_SUBSCR_CTX_REUSE, &subscription);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* the read does not wait for the slow provider, the data of the fast one are returned */
+    rc = sr_get_items(session, "/state-module:*//*", &values, &cnt);
+    assert_int_equal(rc, SR_ERR_OK);
+    for (size_t i = 0; i < cnt; i++) {
+        assert_string_not_equal("/state-module:traffic_stats/number_of_accidents", values[i].xpath);
+    }
+    sr_free_values(values, cnt);
+    assert_int_equal(2, xpath_retrieved->count);
+
+    /* the missing data are reported in the error info of the successful response */
+    rc = sr_get_last_error(session, &err_info);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_non_null(err_info);
+    assert_non_null(err_info->xpath);
+    assert_string_equal("/state-module:traffic_stats/number_of_accidents", err_info->xpath);
+
+    /* let the slow provider answer, the late answer is ignored */
+    sleep(2);
+
+    rc = sr_get_item(session, "/state-module:weather/humidity", &value);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_int_equal(50, value->data.uint8_val);
+    sr_free_val(value);
+
+    rc = sr_get_item(session, "/sysrepo-monitoring:sysrepo-state/data-provider[xpath='/state-module:traffic_stats/number_of_accidents']/timeout-count", &value);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_int_equal(SR_UINT64_T, value->type);
+    assert_int_equal(1, value->data.uint64_val);
+    sr_free_val(value);
+
+    rc = sr_get_item(session, "/sysrepo-monitoring:sysrepo-state/data-provider[xpath='/state-module:traffic_stats/number_of_accidents']/request-count", &value);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_int_equal(0, value->data.uint64_val);
+    sr_free_val(value);
+
+    for (size_t i = 0; i < xpath_retrieved->count; i++) {
+        free(xpath_retrieved->data[i]);
+    }
+    sr_list_cleanup(xpath_retrieved);
+
+    /* cleanup */
+    sr_unsubscribe(session, subscription);
+    sr_session_stop(session);
+}
+
+static void
+cl_monitoring_state_data(void **state)
+{
+    sr_conn_ctx_t *conn = *state;
+    assert_non_null(conn);
+    sr_session_ctx_t *session = NULL;
+    sr_val_t *value = NULL;
+    int rc = SR_ERR_OK;
+
+    /* start session */
+    rc = sr_session_start(conn, SR_DS_RUNNING, SR_SESS_DEFAULT, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* statistics are provided internally, no data provider is needed */
+    rc = sr_get_item(session, "/sysrepo-monitoring:sysrepo-state/request-processor/thread-count", &value);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_int_equal(SR_UINT32_T, value->type);
+    assert_true(value->data.uint32_val > 0);
+    sr_free_val(value);
+
+    rc = sr_get_item(session, "/sysrepo-monitoring:sysrepo-state/request-processor/session-count", &value);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_true(value->data.uint32_val >= 1);
+    sr_free_val(value);
+
+    rc = sr_get_item(session, "/sysrepo-monitoring:sysrepo-state/module[name='state-module']/running-data-size", &value);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_int_equal(SR_UINT64_T, value->type);
+    sr_free_val(value);
+
+    /* cleanup */
+    sr_session_stop(session);
+}
+
 int
 main()
 {
@@ -3114,6 +3752,8 @@ main()
         cmocka_unit_test_setup_teardown(cl_dp_neg_subscription, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_nested_data_subscription, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_nested_data_subscription_tree, sysrepo_setup, sysrepo_teardown),
+        cmocka_unit_test_setup_teardown(cl_nested_data_batch_subscription, sysrepo_setup, sysrepo_teardown),
+        cmocka_unit_test_setup_teardown(cl_nested_data_batch_partial_failure, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_nested_data_subscription2, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_nested_data_subscription2_tree, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_all_state_data, sysrepo_setup, sysrepo_teardown),
@@ -3128,6 +3768,11 @@ main()
         cmocka_unit_test_setup_teardown(cl_no_dp_subscription, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_type_not_filled_by_dp, sysrepo_setup, sysrepo_teardown),
         cmocka_unit_test_setup_teardown(cl_state_data_in_grouping, sysrepo_setup, sysrepo_teardown),
+        cmocka_unit_test_setup_teardown(cl_dp_cache, sysrepo_setup, sysrepo_teardown),
+        cmocka_unit_test_setup_teardown(cl_oper_data_push, sysrepo_setup, sysrepo_teardown),
+        cmocka_unit_test_setup_teardown(cl_dp_tree_provider, sysrepo_setup, sysrepo_teardown),
+        cmocka_unit_test_setup_teardown(cl_dp_provider_deadline, sysrepo_setup, sysrepo_teardown),
+        cmocka_unit_test_setup_teardown(cl_monitoring_state_data, sysrepo_setup, sysrepo_teardown),
     };
 
     watchdog_start(300);
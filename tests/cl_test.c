@@ -2556,6 +2556,83 @@ cl_rpc_test(void **state)
     assert_int_equal(rc, SR_ERR_OK);
 }
 
+static int
+test_rpc_trusted_cb(const char *xpath, const sr_val_t *input, const size_t input_cnt,
+        sr_val_t **output, size_t *output_cnt, void *private_ctx)
+{
+    int *callback_called = (int*)private_ctx;
+    *callback_called += 1;
+
+    /* input is forwarded as sent, without the default nodes */
+    assert_int_equal(1, input_cnt);
+    assert_string_equal("/test-module:activate-software-image/image-name", input[0].xpath);
+    assert_string_equal("acmefw-2.3", input[0].data.string_val);
+
+    *output_cnt = 1;
+    *output = calloc(*output_cnt, sizeof(**output));
+    (*output)[0].xpath = strdup("/test-module:activate-software-image/status");
+    (*output)[0].type = SR_STRING_T;
+    (*output)[0].data.string_val = strdup("The image acmefw-2.3 is being installed.");
+
+    return SR_ERR_OK;
+}
+
+static void
+cl_rpc_trusted_test(void **state)
+{
+    sr_conn_ctx_t *conn = *state;
+    assert_non_null(conn);
+
+    sr_session_ctx_t *session = NULL, *trusted_session = NULL;
+    sr_subscription_ctx_t *subscription = NULL;
+    int callback_called = 0;
+    int rc = SR_ERR_OK;
+
+    if (0 != getuid()) {
+        /* trusted sessions of the other users are covered by rp_session_trusted_test */
+        skip();
+    }
+
+    /* start a trusted session */
+    rc = sr_session_start(conn, SR_DS_RUNNING, SR_SESS_TRUSTED, &trusted_session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* subscribe for RPC */
+    rc = sr_session_start(conn, SR_DS_RUNNING, SR_SESS_DEFAULT, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+    rc = sr_rpc_subscribe(session, "/test-module:activate-software-image", test_rpc_trusted_cb, &callback_called,
+            SR_SUBSCR_DEFAULT, &subscription);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    sr_val_t input = { 0, };
+    sr_val_t *output = NULL;
+    size_t output_cnt = 0;
+    input.xpath = "/test-module:activate-software-image/image-name";
+    input.type = SR_STRING_T;
+    input.data.string_val = "acmefw-2.3";
+
+    /* the RPC must still exist in the schema */
+    rc = sr_rpc_send(trusted_session, "/test-module:non-existing-rpc", &input, 1, &output, &output_cnt);
+    assert_int_equal(rc, SR_ERR_VALIDATION_FAILED);
+    assert_int_equal(0, callback_called);
+
+    /* send a RPC, neither input nor output is extended with the default nodes */
+    rc = sr_rpc_send(trusted_session, "/test-module:activate-software-image", &input, 1, &output, &output_cnt);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_int_equal(1, callback_called);
+    assert_int_equal(1, output_cnt);
+    assert_string_equal("/test-module:activate-software-image/status", output[0].xpath);
+    assert_string_equal("The image acmefw-2.3 is being installed.", output[0].data.string_val);
+    sr_free_values(output, output_cnt);
+
+    rc = sr_unsubscribe(NULL, subscription);
+    assert_int_equal(rc, SR_ERR_OK);
+    rc = sr_session_stop(session);
+    assert_int_equal(rc, SR_ERR_OK);
+    rc = sr_session_stop(trusted_session);
+    assert_int_equal(rc, SR_ERR_OK);
+}
+
 static int
 test_rpc_tree_cb(const char *xpath, const sr_node_t *input, const size_t input_cnt,
         sr_node_t **output, size_t *output_cnt, void *private_ctx)
@@ -4509,6 +4586,231 @@ cl_event_notif_test(void **state)
     assert_int_equal(0, pthread_cond_destroy(&cb_status.cond));
 }
 
+typedef struct cl_test_trusted_notif_s {
+    int received;
+    size_t values_cnt;
+    pthread_mutex_t mutex;
+    pthread_cond_t cond;
+} cl_test_trusted_notif_t;
+
+static void
+test_event_notif_trusted_cb(const sr_ev_notif_type_t notif_type, const char *xpath,
+        const sr_val_t *values, const size_t values_cnt, time_t timestamp, void *private_ctx)
+{
+    cl_test_trusted_notif_t *status = (cl_test_trusted_notif_t*)private_ctx;
+
+    assert_string_equal("/test-module:link-removed", xpath);
+
+    assert_int_equal(0, pthread_mutex_lock(&status->mutex));
+    status->received += 1;
+    status->values_cnt = values_cnt;
+    assert_int_equal(0, pthread_cond_signal(&status->cond));
+    assert_int_equal(0, pthread_mutex_unlock(&status->mutex));
+}
+
+static void
+cl_event_notif_trusted_test(void **state)
+{
+    sr_conn_ctx_t *conn = *state;
+    assert_non_null(conn);
+
+    sr_session_ctx_t *session = NULL, *trusted_session = NULL;
+    sr_subscription_ctx_t *subscription = NULL;
+    cl_test_trusted_notif_t status = { 0, };
+    struct timespec ts = { 0, };
+    sr_val_t values[4];
+    int rc = SR_ERR_OK;
+
+    if (0 != getuid()) {
+        /* trusted sessions of the other users are covered by rp_session_trusted_test */
+        skip();
+    }
+
+    memset(&values, '\0', sizeof(values));
+    assert_int_equal(0, pthread_mutex_init(&status.mutex, NULL));
+    assert_int_equal(0, pthread_cond_init(&status.cond, NULL));
+
+    /* start sessions */
+    rc = sr_session_start(conn, SR_DS_RUNNING, SR_SESS_TRUSTED, &trusted_session);
+    assert_int_equal(rc, SR_ERR_OK);
+    rc = sr_session_start(conn, SR_DS_RUNNING, SR_SESS_DEFAULT, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* subscribe for link removal */
+    rc = sr_event_notif_subscribe(session, "/test-module:link-removed", test_event_notif_trusted_cb,
+            &status, SR_SUBSCR_DEFAULT, &subscription);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    values[0].xpath = "/test-module:link-removed/source/address";
+    values[0].type = SR_STRING_T;
+    values[0].data.string_val = "10.10.2.4";
+    values[1].xpath = "/test-module:link-removed/source/interface";
+    values[1].type = SR_STRING_T;
+    values[1].data.string_val = "eth0";
+    values[2].xpath = "/test-module:link-removed/destination/address";
+    values[2].type = SR_STRING_T;
+    values[2].data.string_val = "10.10.2.5";
+    values[3].xpath = "/test-module:link-removed/destination/interface";
+    values[3].type = SR_STRING_T;
+    values[3].data.string_val = "eth2";
+
+    /* the notification must still exist in the schema */
+    rc = sr_event_notif_send(trusted_session, "/test-module:non-existing-notif", values, 4, SR_EV_NOTIF_EPHEMERAL);
+    assert_int_equal(rc, SR_ERR_VALIDATION_FAILED);
+
+    assert_int_equal(0, pthread_mutex_lock(&status.mutex));
+
+    /* ephemeral notification of a trusted session is forwarded as sent, without the containers and default nodes */
+    rc = sr_event_notif_send(trusted_session, "/test-module:link-removed", values, 4, SR_EV_NOTIF_EPHEMERAL);
+    assert_int_equal(rc, SR_ERR_OK);
+    sr_clock_get_time(CLOCK_REALTIME, &ts);
+    ts.tv_sec += COND_WAIT_SEC;
+    while (1 > status.received) {
+        assert_int_equal(0, pthread_cond_timedwait(&status.cond, &status.mutex, &ts));
+    }
+    assert_int_equal(4, status.values_cnt);
+
+    /* stored notification of a trusted session is validated */
+    rc = sr_event_notif_send(trusted_session, "/test-module:link-removed", values, 4, SR_EV_NOTIF_DEFAULT);
+    assert_int_equal(rc, SR_ERR_OK);
+    sr_clock_get_time(CLOCK_REALTIME, &ts);
+    ts.tv_sec += COND_WAIT_SEC;
+    while (2 > status.received) {
+        assert_int_equal(0, pthread_cond_timedwait(&status.cond, &status.mutex, &ts));
+    }
+    assert_int_equal(7, status.values_cnt);
+
+    assert_int_equal(0, pthread_mutex_unlock(&status.mutex));
+
+    /* cleanup */
+    rc = sr_unsubscribe(NULL, subscription);
+    assert_int_equal(rc, SR_ERR_OK);
+    rc = sr_session_stop(session);
+    assert_int_equal(rc, SR_ERR_OK);
+    rc = sr_session_stop(trusted_session);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_int_equal(0, pthread_mutex_destroy(&status.mutex));
+    assert_int_equal(0, pthread_cond_destroy(&status.cond));
+}
+
+static void
+cl_event_notif_batch_test(void **state)
+{
+    sr_conn_ctx_t *conn = *state;
+    assert_non_null(conn);
+
+    cl_test_en_session_t sub_session[CL_TEST_EN_NUM_SESSIONS] = {{0}, };
+    sr_session_ctx_t *notif_session = NULL;
+    cl_test_en_cb_status_t cb_status;
+    sr_val_t discovered[4], removed[4], overutilized[1];
+    sr_event_notif_entry_t entries[2];
+    size_t i;
+    int rc = SR_ERR_OK;
+
+    memset(&discovered, '\0', sizeof(discovered));
+    memset(&removed, '\0', sizeof(removed));
+    memset(&overutilized, '\0', sizeof(overutilized));
+    memset(&entries, '\0', sizeof(entries));
+    cb_status.link_discovered = 0;
+    cb_status.link_removed = 0;
+    cb_status.status_change = 0;
+    assert_int_equal(0, pthread_mutex_init(&cb_status.mutex, NULL));
+    assert_int_equal(0, pthread_cond_init(&cb_status.cond, NULL));
+    assert_int_equal(0, pthread_mutex_lock(&cb_status.mutex));
+
+    /* start sessions and subscribe for link discovery and removal in every session */
+    rc = sr_session_start(conn, SR_DS_RUNNING, SR_SESS_DEFAULT, &notif_session);
+    assert_int_equal(rc, SR_ERR_OK);
+    for (i = 0; i < CL_TEST_EN_NUM_SESSIONS; ++i) {
+        rc = sr_session_start(conn, SR_DS_RUNNING, SR_SESS_DEFAULT, &sub_session[i].session);
+        assert_int_equal(rc, SR_ERR_OK);
+        rc = sr_event_notif_subscribe(sub_session[i].session, "/test-module:link-discovered", test_event_notif_link_discovery_cb,
+                &cb_status, SR_SUBSCR_DEFAULT, &sub_session[i].subscription_ld);
+        assert_int_equal(rc, SR_ERR_OK);
+        rc = sr_event_notif_subscribe(sub_session[i].session, "/test-module:link-removed", test_event_notif_link_removed_cb,
+                &cb_status, SR_SUBSCR_DEFAULT, &sub_session[i].subscription_lr);
+        assert_int_equal(rc, SR_ERR_OK);
+    }
+
+    discovered[0].xpath = "/test-module:link-discovered/source/address";
+    discovered[0].type = SR_STRING_T;
+    discovered[0].data.string_val = "10.10.1.5";
+    discovered[1].xpath = "/test-module:link-discovered/source/interface";
+    discovered[1].type = SR_STRING_T;
+    discovered[1].data.string_val = "eth1";
+    discovered[2].xpath = "/test-module:link-discovered/destination/address";
+    discovered[2].type = SR_STRING_T;
+    discovered[2].data.string_val = "10.10.1.8";
+    discovered[3].xpath = "/test-module:link-discovered/destination/interface";
+    discovered[3].type = SR_STRING_T;
+    discovered[3].data.string_val = "eth0";
+
+    removed[0].xpath = "/test-module:link-removed/source/address";
+    removed[0].type = SR_STRING_T;
+    removed[0].data.string_val = "10.10.2.4";
+    removed[1].xpath = "/test-module:link-removed/source/interface";
+    removed[1].type = SR_STRING_T;
+    removed[1].data.string_val = "eth0";
+    removed[2].xpath = "/test-module:link-removed/destination/address";
+    removed[2].type = SR_STRING_T;
+    removed[2].data.string_val = "10.10.2.5";
+    removed[3].xpath = "/test-module:link-removed/destination/interface";
+    removed[3].type = SR_STRING_T;
+    removed[3].data.string_val = "eth2";
+
+    overutilized[0].xpath = "/test-module:link-overutilized/source/address";
+    overutilized[0].type = SR_STRING_T;
+    overutilized[0].data.string_val = "10.10.1.5";
+
+    /* a batch with an invalid notification is rejected as a whole */
+    entries[0].xpath = "/test-module:link-discovered";
+    entries[0].values = discovered;
+    entries[0].values_cnt = 4;
+    entries[1].xpath = "/test-module:link-overutilized";
+    entries[1].values = overutilized;
+    entries[1].values_cnt = 1;
+    rc = sr_event_notif_send_batch(notif_session, entries, 2, SR_EV_NOTIF_DEFAULT);
+    assert_int_equal(rc, SR_ERR_VALIDATION_FAILED);
+
+    /* send both notifications in one batch */
+    entries[1].xpath = "/test-module:link-removed";
+    entries[1].values = removed;
+    entries[1].values_cnt = 4;
+    entries[1].timestamp = time(NULL) - 1;
+    rc = sr_event_notif_send_batch(notif_session, entries, 2, SR_EV_NOTIF_DEFAULT);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* empty batch */
+    rc = sr_event_notif_send_batch(notif_session, entries, 0, SR_EV_NOTIF_DEFAULT);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* wait at most 5 seconds for all callbacks to get called */
+    struct timespec ts;
+    sr_clock_get_time(CLOCK_REALTIME, &ts);
+    ts.tv_sec += 5;
+    while (ETIMEDOUT != pthread_cond_timedwait(&cb_status.cond, &cb_status.mutex, &ts)
+            && (cb_status.link_removed < CL_TEST_EN_NUM_SESSIONS || cb_status.link_discovered < CL_TEST_EN_NUM_SESSIONS));
+    assert_int_equal(CL_TEST_EN_NUM_SESSIONS, cb_status.link_discovered);
+    assert_int_equal(CL_TEST_EN_NUM_SESSIONS, cb_status.link_removed);
+    assert_int_equal(0, pthread_mutex_unlock(&cb_status.mutex));
+
+    /* unsubscribe and stop sessions */
+    for (i = 0; i < CL_TEST_EN_NUM_SESSIONS; ++i) {
+        rc = sr_unsubscribe(NULL, sub_session[i].subscription_ld);
+        assert_int_equal(rc, SR_ERR_OK);
+        rc = sr_unsubscribe(NULL, sub_session[i].subscription_lr);
+        assert_int_equal(rc, SR_ERR_OK);
+        rc = sr_session_stop(sub_session[i].session);
+        assert_int_equal(rc, SR_ERR_OK);
+    }
+    rc = sr_session_stop(notif_session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* cleanup */
+    assert_int_equal(0, pthread_mutex_destroy(&cb_status.mutex));
+    assert_int_equal(0, pthread_cond_destroy(&cb_status.cond));
+}
+
 static void
 test_event_notif_link_discovery_tree_cb(const sr_ev_notif_type_t notif_type, const char *xpath,
         const sr_node_t *trees, const size_t tree_cnt, time_t timestamp, void *private_ctx)
@@ -5904,6 +6206,7 @@ main()
             cmocka_unit_test_setup_teardown(cl_copy_config_test, sysrepo_setup, sysrepo_teardown),
             cmocka_unit_test_setup_teardown(cl_copy_config_test2, sysrepo_setup, sysrepo_teardown),
             cmocka_unit_test_setup_teardown(cl_rpc_test, sysrepo_setup, sysrepo_teardown),
+            cmocka_unit_test_setup_teardown(cl_rpc_trusted_test, sysrepo_setup, sysrepo_teardown),
             cmocka_unit_test_setup_teardown(cl_rpc_tree_test, sysrepo_setup, sysrepo_teardown),
             cmocka_unit_test_setup_teardown(cl_rpc_combo_test, sysrepo_setup, sysrepo_teardown),
             cmocka_unit_test_setup_teardown(cl_failed_rpc_test, sysrepo_setup, sysrepo_teardown),
@@ -5920,6 +6223,8 @@ main()
             cmocka_unit_test_setup_teardown(cl_dp_get_items_test, sysrepo_setup, sysrepo_teardown),
             cmocka_unit_test_setup_teardown(cl_session_set_opts, sysrepo_setup, sysrepo_teardown),
             cmocka_unit_test_setup_teardown(cl_event_notif_test, sysrepo_setup, sysrepo_teardown),
+            cmocka_unit_test_setup_teardown(cl_event_notif_trusted_test, sysrepo_setup, sysrepo_teardown),
+            cmocka_unit_test_setup_teardown(cl_event_notif_batch_test, sysrepo_setup, sysrepo_teardown),
             cmocka_unit_test_setup_teardown(cl_event_notif_tree_test, sysrepo_setup, sysrepo_teardown),
             cmocka_unit_test_setup_teardown(cl_event_notif_combo_test, sysrepo_setup, sysrepo_teardown),
             cmocka_unit_test_setup_teardown(cl_event_notif_replay_test, sysrepo_setup, sysrepo_teardown),
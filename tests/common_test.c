@@ -458,7 +458,7 @@ sr_bitset_test(void **state)
 {
     sr_bitset_t *bitset1 = NULL, *bitset2 = NULL;
     const size_t bit_count1 = 33, bit_count2 = 80;
-    bool value = false, disjoint = false;
+    bool value = false, disjoint = false, contains = false;
     size_t i = 0;
     int rc = SR_ERR_OK;
 
@@ -582,6 +582,36 @@ sr_bitset_test(void **state)
     assert_int_equal(SR_ERR_OK, rc);
     assert_true(disjoint);
 
+    /* union */
+    rc = sr_bitset_contains(bitset2, bitset1, &contains);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_false(contains);
+    rc = sr_bitset_union(bitset2, bitset1);
+    assert_int_equal(SR_ERR_OK, rc);
+    rc = sr_bitset_contains(bitset2, bitset1, &contains);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_true(contains);
+    rc = sr_bitset_contains(bitset1, bitset2, &contains);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_false(contains);
+    for (i = 0; i < bit_count2; i++) {
+        rc = sr_bitset_get(bitset2, i, &value);
+        assert_int_equal(SR_ERR_OK, rc);
+        switch (i) {
+            case 0:
+            case 6:
+            case 12:
+            case 13:
+            case 32:
+            case 41:
+            case 70:
+                assert_true(value);
+                break;
+            default:
+                assert_false(value);
+        }
+    }
+
     /* reset all bits to zero */
     sr_bitset_reset(bitset1);
     sr_bitset_reset(bitset2);
@@ -1380,6 +1410,22 @@ sr_copy_first_ns_from_expr_test(void **state)
     assert_int_equal(SR_ERR_INVAL_ARG, rc);
 }
 
+static void
+sr_xpath_subtree_test(void **state)
+{
+    char xpath[] = "/m:list[key=\"a\"][name='b\"c'][other=\"d'e\"]/leaf";
+
+    assert_true(sr_xpath_in_subtree("/m:cont", "/m:cont"));
+    assert_true(sr_xpath_in_subtree("/m:cont/leaf", "/m:cont"));
+    assert_true(sr_xpath_in_subtree("/m:list[key='a']/leaf", "/m:list"));
+    assert_false(sr_xpath_in_subtree("/m:cont2/leaf", "/m:cont"));
+    assert_false(sr_xpath_in_subtree("/m:cont", "/m:cont/leaf"));
+    assert_false(sr_xpath_in_subtree(NULL, "/m:cont"));
+
+    sr_xpath_normalize_quotes(xpath);
+    assert_string_equal("/m:list[key='a'][name='b\"c'][other=\"d'e\"]/leaf", xpath);
+}
+
 static void
 sr_error_info_test(void **state)
 {
@@ -1530,6 +1576,120 @@ sr_dup_data_tree_to_ctx_test(void **state)
     ly_ctx_destroy(ctx_B, NULL);
 }
 
+static void
+sr_lock_prof_test(void **state)
+{
+    /* sites stay registered in the global list of sites, the site must outlive the test (as in SR_MUTEX_LOCK) */
+    static sr_lock_prof_site_t site = { .name = "test_lock", .file = __FILE__, .line = __LINE__, };
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    uint64_t wait_cnt = 0, hold_cnt = 0;
+    char buffer[4096] = { 0, };
+    FILE *report = NULL;
+
+    /* two nested acquisitions */
+    for (int i = 0; i < 2; i++) {
+        sr_lock_prof_wait_begin();
+        sr_lock_prof_acquired(&site, &mutex);
+    }
+    assert_int_equal(2, site.acq_cnt);
+    assert_int_equal(1, site.registered);
+
+    sr_lock_prof_released(&mutex);
+    sr_lock_prof_released(&mutex);
+    /* release of a lock that is not held is ignored */
+    sr_lock_prof_released(&mutex);
+
+    for (size_t i = 0; i < SR_LOCK_PROF_HIST_SIZE; i++) {
+        wait_cnt += site.wait_hist[i];
+        hold_cnt += site.hold_hist[i];
+    }
+    assert_int_equal(2, wait_cnt);
+    assert_int_equal(2, hold_cnt);
+    assert_true(site.hold_max <= site.hold_total);
+
+    /* the site is listed in the report */
+    report = tmpfile();
+    assert_non_null(report);
+    sr_lock_prof_report(report);
+    rewind(report);
+    assert_true(fread(buffer, 1, sizeof(buffer) - 1, report) > 0);
+    assert_non_null(strstr(buffer, "test_lock"));
+    fclose(report);
+}
+
+static void
+sr_gpb_shared_payload_test(void **state)
+{
+    sr_val_t *values = NULL, *unpacked_values = NULL;
+    size_t unpacked_cnt = 0;
+    sr_gpb_shared_payload_t *payload = NULL;
+    Sr__Msg *msg[2] = { NULL, }, *unpacked = NULL;
+    uint8_t *buff = NULL;
+    size_t size = 0;
+    int rc = SR_ERR_OK;
+
+    rc = sr_new_values(2, &values);
+    assert_int_equal(SR_ERR_OK, rc);
+    rc = sr_val_set_xpath(&values[0], "/test-module:link-removed/source/address");
+    assert_int_equal(SR_ERR_OK, rc);
+    rc = sr_val_set_str_data(&values[0], SR_STRING_T, "10.10.1.5");
+    assert_int_equal(SR_ERR_OK, rc);
+    rc = sr_val_set_xpath(&values[1], "/test-module:link-removed/source/interface");
+    assert_int_equal(SR_ERR_OK, rc);
+    rc = sr_val_set_str_data(&values[1], SR_STRING_T, "eth0");
+    assert_int_equal(SR_ERR_OK, rc);
+
+    rc = sr_gpb_shared_payload_create(SR_API_VALUES, values, 2, NULL, 0, &payload);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_equal(2, payload->field_cnt);
+
+    /* the same payload attached to two messages for different subscribers */
+    for (int i = 0; i < 2; i++) {
+        rc = sr_gpb_req_alloc(NULL, SR__OPERATION__EVENT_NOTIF, 0, &msg[i]);
+        assert_int_equal(SR_ERR_OK, rc);
+        msg[i]->request->event_notif_req->xpath = strdup("/test-module:link-removed");
+        msg[i]->request->event_notif_req->subscriber_address = strdup(i ? "address-b" : "address-a");
+        sr_gpb_event_notif_attach_payload(msg[i]->request->event_notif_req, payload);
+    }
+    /* the messages do not hold any reference */
+    assert_int_equal(1, payload->refcount);
+
+    /* the payload is packed as regular values */
+    size = sr__msg__get_packed_size(msg[1]);
+    buff = calloc(1, size);
+    assert_non_null(buff);
+    sr__msg__pack(msg[1], buff);
+
+    unpacked = sr__msg__unpack(NULL, size, buff);
+    assert_non_null(unpacked);
+    assert_string_equal("address-b", unpacked->request->event_notif_req->subscriber_address);
+    rc = sr_values_gpb_to_sr(NULL, unpacked->request->event_notif_req->values, unpacked->request->event_notif_req->n_values,
+            &unpacked_values, &unpacked_cnt);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_equal(2, unpacked_cnt);
+    assert_string_equal(values[1].xpath, unpacked_values[1].xpath);
+    assert_string_equal("eth0", unpacked_values[1].data.string_val);
+
+    /* the received message is a regular message not related to the payload */
+    assert_int_equal(0, unpacked->request->event_notif_req->base.n_unknown_fields);
+    sr_gpb_event_notif_detach_payload(unpacked->request->event_notif_req, payload);
+    assert_int_equal(2, unpacked->request->event_notif_req->n_values);
+
+    /* the payload has to be detached before the messages are freed */
+    for (int i = 0; i < 2; i++) {
+        sr_gpb_event_notif_detach_payload(msg[i]->request->event_notif_req, payload);
+        assert_null(msg[i]->request->event_notif_req->base.unknown_fields);
+        sr_msg_free(msg[i]);
+    }
+    assert_int_equal(1, payload->refcount);
+    sr_gpb_shared_payload_release(payload);
+
+    sr_free_values(unpacked_values, unpacked_cnt);
+    sr__msg__free_unpacked(unpacked, NULL);
+    sr_free_values(values, 2);
+    free(buff);
+}
+
 int
 main() {
     const struct CMUnitTest tests[] = {
@@ -1548,11 +1708,14 @@ main() {
             cmocka_unit_test_setup_teardown(sr_node_t_rpc_output_test, logging_setup, logging_cleanup),
             cmocka_unit_test_setup_teardown(sr_free_schema_test, logging_setup, logging_cleanup),
             cmocka_unit_test_setup_teardown(sr_copy_first_ns_from_expr_test, logging_setup, logging_cleanup),
+            cmocka_unit_test_setup_teardown(sr_xpath_subtree_test, logging_setup, logging_cleanup),
             cmocka_unit_test_setup_teardown(sr_error_info_test, logging_setup, logging_cleanup),
             cmocka_unit_test_setup_teardown(sr_create_uri_test, logging_setup, logging_cleanup),
             cmocka_unit_test_setup_teardown(sr_get_system_groups_test, logging_setup, logging_cleanup),
             cmocka_unit_test_setup_teardown(sr_free_list_of_strings_test, logging_setup, logging_cleanup),
             cmocka_unit_test_setup_teardown(sr_dup_data_tree_to_ctx_test, logging_setup, logging_cleanup),
+            cmocka_unit_test_setup_teardown(sr_lock_prof_test, logging_setup, logging_cleanup),
+            cmocka_unit_test_setup_teardown(sr_gpb_shared_payload_test, logging_setup, logging_cleanup),
     };
 
     watchdog_start(300);
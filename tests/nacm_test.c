@@ -292,6 +292,57 @@ nacm_get_rule(nacm_rule_list_t *rule_list, size_t index)
     return (nacm_rule_t *)rule_list->rules->data[index];
 }
 
+static struct lyd_node *
+get_data_node(struct lyd_node *data_tree, const char *xpath)
+{
+    struct ly_set *nodeset = NULL;
+    struct lyd_node *node = NULL;
+
+    nodeset = lyd_find_xpath(data_tree, xpath);
+    assert_non_null_bt(nodeset);
+    assert_int_equal_bt(1, nodeset->number);
+    node = nodeset->set.d[0];
+    ly_set_free(nodeset);
+
+    return node;
+}
+
+static nacm_action_t
+check_data_access(nacm_data_val_ctx_t *nacm_data_val_ctx, struct lyd_node *data_tree, const char *xpath,
+        nacm_access_flag_t access_type)
+{
+    nacm_action_t action = NACM_ACTION_PERMIT;
+    const char *rule_name = NULL, *rule_info = NULL;
+
+    assert_int_equal_bt(SR_ERR_OK, nacm_check_data(nacm_data_val_ctx, access_type, get_data_node(data_tree, xpath),
+                &action, &rule_name, &rule_info));
+    return action;
+}
+
+static nacm_action_t
+check_data_subtree_access(nacm_data_val_ctx_t *nacm_data_val_ctx, struct lyd_node *data_tree, const char *xpath,
+        nacm_access_flag_t access_type, bool *subtree)
+{
+    nacm_action_t action = NACM_ACTION_PERMIT;
+    const char *rule_name = NULL, *rule_info = NULL;
+
+    assert_int_equal_bt(SR_ERR_OK, nacm_check_data_subtree(nacm_data_val_ctx, access_type,
+                get_data_node(data_tree, xpath), &action, &rule_name, &rule_info, subtree));
+    return action;
+}
+
+static nacm_data_decision_t *
+get_compiled_decision(nacm_data_val_ctx_t *nacm_data_val_ctx, struct lyd_node *data_tree, const char *xpath,
+        nacm_access_flag_t access_type)
+{
+    nacm_data_decision_t decision_lookup = { 0, };
+
+    decision_lookup.rule_list_set = nacm_data_val_ctx->rule_list_set;
+    decision_lookup.node_id = dm_get_node_id(get_data_node(data_tree, xpath)->schema);
+    decision_lookup.access_type = access_type;
+    return sr_btree_search(nacm_data_val_ctx->nacm_ctx->compiled.decisions, &decision_lookup);
+}
+
 static void
 nacm_test_empty_config(void **state)
 {
@@ -3378,6 +3429,390 @@ nacm_test_read_access_with_empty_config(void **state)
     }
 }
 
+static void
+nacm_test_compiled_data_decisions(void **state)
+{
+    int rc = 0;
+    dm_ctx_t *dm_ctx = rp_ctx->dm_ctx;
+    rp_session_t *rp_session[NUM_OF_USERS] = {NULL,};
+    struct lyd_node *data_tree[NUM_OF_USERS] = {NULL,};
+    nacm_data_val_ctx_t *nacm_data_val_ctx = NULL;
+    nacm_ctx_t *nacm_ctx = get_nacm_ctx();
+    size_t decision_cnt = 0;
+#define CHECKED_NODES 6
+    const char *xpaths[CHECKED_NODES] = { XP_TEST_MODULE_BOOL, LIST_K1_UNION, LIST_K1_KEY, LIST_K2_UNION,
+                                          MAIN_NUMBER_2, MAIN_NUMBER_42 };
+    /* the same outcomes as in nacm_test_read_access_single_value (the last user does not use NACM) */
+    const nacm_action_t expected[NUM_OF_USERS-1][CHECKED_NODES] = {
+        { NACM_ACTION_DENY, NACM_ACTION_PERMIT, NACM_ACTION_PERMIT, NACM_ACTION_PERMIT, NACM_ACTION_PERMIT, NACM_ACTION_DENY },
+        { NACM_ACTION_PERMIT, NACM_ACTION_DENY, NACM_ACTION_PERMIT, NACM_ACTION_PERMIT, NACM_ACTION_DENY, NACM_ACTION_PERMIT },
+        { NACM_ACTION_DENY, NACM_ACTION_PERMIT, NACM_ACTION_PERMIT, NACM_ACTION_DENY, NACM_ACTION_DENY, NACM_ACTION_DENY },
+        { NACM_ACTION_PERMIT, NACM_ACTION_PERMIT, NACM_ACTION_PERMIT, NACM_ACTION_PERMIT, NACM_ACTION_PERMIT, NACM_ACTION_PERMIT }};
+
+    /* datastore content */
+    createDataTreeTestModule();
+
+    /* NACM config, no decisions are compiled after the reload */
+    nacm_config_for_basic_read_access_tests(false, NULL);
+    assert_int_equal(0, nacm_ctx->compiled.decision_cnt);
+
+    for (int i = 0; i < NUM_OF_USERS-1; ++i) {
+        test_rp_session_create_user(rp_ctx, SR_DS_STARTUP, user_credentials[i], SR_SESS_ENABLE_NACM, &rp_session[i]);
+        rc = dm_get_datatree(dm_ctx, rp_session[i]->dm_session, "test-module", &data_tree[i]);
+        assert_int_equal(SR_ERR_OK, rc);
+        assert_non_null(data_tree[i]);
+    }
+
+    /* the first round evaluates the rules and compiles the decisions */
+    for (int i = 0; i < NUM_OF_USERS-1; ++i) {
+        rc = nacm_data_validation_start(nacm_ctx, rp_session[i]->user_credentials, data_tree[i]->schema,
+                &nacm_data_val_ctx);
+        assert_int_equal(SR_ERR_OK, rc);
+        for (int j = 0; j < CHECKED_NODES; ++j) {
+            assert_int_equal(expected[i][j], check_data_access(nacm_data_val_ctx, data_tree[i], xpaths[j],
+                        NACM_ACCESS_READ));
+        }
+        nacm_data_validation_stop(nacm_data_val_ctx);
+    }
+    decision_cnt = nacm_ctx->compiled.decision_cnt;
+    assert_true(0 < decision_cnt);
+
+    /* the next rounds (in the reverse order) use the compiled decisions with the same outcome */
+    for (int round = 0; round < 2; ++round) {
+        for (int i = NUM_OF_USERS-2; i >= 0; --i) {
+            rc = nacm_data_validation_start(nacm_ctx, rp_session[i]->user_credentials, data_tree[i]->schema,
+                    &nacm_data_val_ctx);
+            assert_int_equal(SR_ERR_OK, rc);
+            for (int j = CHECKED_NODES-1; j >= 0; --j) {
+                assert_int_equal(expected[i][j], check_data_access(nacm_data_val_ctx, data_tree[i], xpaths[j],
+                            NACM_ACCESS_READ));
+            }
+            nacm_data_validation_stop(nacm_data_val_ctx);
+        }
+        assert_int_equal(decision_cnt, nacm_ctx->compiled.decision_cnt);
+    }
+
+    /* a reload drops the compiled decisions */
+    nacm_config_for_basic_read_access_tests(false, NULL);
+    assert_int_equal(0, nacm_ctx->compiled.decision_cnt);
+
+    /* cleanup */
+    for (int i = 0; i < NUM_OF_USERS-1; ++i) {
+        test_rp_session_cleanup(rp_ctx, rp_session[i]);
+    }
+}
+
+static void
+nacm_test_compiled_data_decisions_with_keys(void **state)
+{
+    int rc = 0;
+    dm_ctx_t *dm_ctx = rp_ctx->dm_ctx;
+    rp_session_t *rp_session = NULL;
+    struct lyd_node *data_tree = NULL;
+    nacm_data_val_ctx_t *nacm_data_val_ctx = NULL;
+    nacm_data_decision_t *decision = NULL;
+    nacm_ctx_t *nacm_ctx = get_nacm_ctx();
+
+    /* datastore content */
+    createDataTreeTestModule();
+
+    /* NACM config */
+    nacm_config_for_basic_read_access_tests(false, NULL);
+
+    /* user3 is matched by acl1 (permit-access-to-list-k1) and acl3 (deny-test-module) */
+    test_rp_session_create_user(rp_ctx, SR_DS_STARTUP, user_credentials[2], SR_SESS_ENABLE_NACM, &rp_session);
+    rc = dm_get_datatree(dm_ctx, rp_session->dm_session, "test-module", &data_tree);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_non_null(data_tree);
+
+    for (int round = 0; round < 3; ++round) {
+        rc = nacm_data_validation_start(nacm_ctx, rp_session->user_credentials, data_tree->schema, &nacm_data_val_ctx);
+        assert_int_equal(SR_ERR_OK, rc);
+        /* the outcome depends on the key of the list instance, alternate the instances */
+        assert_int_equal(NACM_ACTION_DENY, check_data_access(nacm_data_val_ctx, data_tree, LIST_K2_UNION, NACM_ACCESS_READ));
+        assert_int_equal(NACM_ACTION_PERMIT, check_data_access(nacm_data_val_ctx, data_tree, LIST_K1_UNION, NACM_ACCESS_READ));
+        assert_int_equal(NACM_ACTION_DENY, check_data_access(nacm_data_val_ctx, data_tree, LIST_K2_UNION, NACM_ACCESS_READ));
+        assert_int_equal(NACM_ACTION_DENY, check_data_access(nacm_data_val_ctx, data_tree,
+                    "/test-module:list[key='k2']", NACM_ACCESS_READ));
+        assert_int_equal(NACM_ACTION_PERMIT, check_data_access(nacm_data_val_ctx, data_tree,
+                    "/test-module:list[key='k1']", NACM_ACCESS_READ));
+        /* no path of a rule applies to this leaf, only the module rule of acl3 */
+        assert_int_equal(NACM_ACTION_DENY, check_data_access(nacm_data_val_ctx, data_tree, XP_TEST_MODULE_STRING, NACM_ACCESS_READ));
+
+        /* decisions depending on the path of a rule are not final, the others are */
+        decision = get_compiled_decision(nacm_data_val_ctx, data_tree, LIST_K1_UNION, NACM_ACCESS_READ);
+        assert_non_null(decision);
+        assert_false(decision->final);
+        decision = get_compiled_decision(nacm_data_val_ctx, data_tree, "/test-module:list[key='k1']", NACM_ACCESS_READ);
+        assert_non_null(decision);
+        assert_false(decision->final);
+        decision = get_compiled_decision(nacm_data_val_ctx, data_tree, XP_TEST_MODULE_STRING, NACM_ACCESS_READ);
+        assert_non_null(decision);
+        assert_true(decision->final);
+        assert_int_equal(NACM_ACTION_DENY, decision->action);
+        nacm_data_validation_stop(nacm_data_val_ctx);
+    }
+
+    /* cleanup */
+    test_rp_session_cleanup(rp_ctx, rp_session);
+}
+
+static void
+nacm_test_read_access_subtree_decisions(void **state)
+{
+    int rc = 0;
+    dm_ctx_t *dm_ctx = rp_ctx->dm_ctx;
+    rp_session_t *rp_session[2] = {NULL,};
+    struct lyd_node *data_tree[2] = {NULL,}, *if_data_tree = NULL;
+    nacm_data_val_ctx_t *nacm_data_val_ctx = NULL;
+    nacm_ctx_t *nacm_ctx = get_nacm_ctx();
+    bool subtree = false;
+    const char *list_k1_nodes[] = { "/test-module:list[key='k1']/key", "/test-module:list[key='k1']/id_ref",
+                                    LIST_K1_UNION, "/test-module:list[key='k1']/wireless" };
+
+    /* datastore content */
+    createDataTreeTestModule();
+    createDataTreeIETFinterfacesModule();
+
+    /* NACM config */
+    nacm_config_for_basic_read_access_tests(false, NULL);
+
+    /* user1 (acl1) and user2 (acl2) */
+    for (int i = 0; i < 2; ++i) {
+        test_rp_session_create_user(rp_ctx, SR_DS_STARTUP, user_credentials[i], SR_SESS_ENABLE_NACM, &rp_session[i]);
+        rc = dm_get_datatree(dm_ctx, rp_session[i]->dm_session, "test-module", &data_tree[i]);
+        assert_int_equal(SR_ERR_OK, rc);
+        assert_non_null(data_tree[i]);
+    }
+    rc = dm_get_datatree(dm_ctx, rp_session[0]->dm_session, "ietf-interfaces", &if_data_tree);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_non_null(if_data_tree);
+
+    /* repeat to get the same outcome also from the compiled decisions */
+    for (int round = 0; round < 2; ++round) {
+        /* user1 */
+        rc = nacm_data_validation_start(nacm_ctx, rp_session[0]->user_credentials, data_tree[0]->schema,
+                &nacm_data_val_ctx);
+        assert_int_equal(SR_ERR_OK, rc);
+        /*  -> no rule applies below the list instance, the whole subtree is permitted */
+        subtree = false;
+        assert_int_equal(NACM_ACTION_PERMIT, check_data_subtree_access(nacm_data_val_ctx, data_tree[0],
+                    "/test-module:list[key='k1']", NACM_ACCESS_READ, &subtree));
+        assert_true(subtree);
+        for (size_t i = 0; i < sizeof list_k1_nodes / sizeof *list_k1_nodes; ++i) {
+            assert_int_equal(NACM_ACTION_PERMIT, check_data_access(nacm_data_val_ctx, data_tree[0], list_k1_nodes[i],
+                        NACM_ACCESS_READ));
+        }
+        /*  -> write access is never decided per subtree */
+        subtree = true;
+        assert_int_equal(NACM_ACTION_PERMIT, check_data_subtree_access(nacm_data_val_ctx, data_tree[0],
+                    "/test-module:list[key='k1']", NACM_ACCESS_UPDATE, &subtree));
+        assert_false(subtree);
+        /*  -> the container is permitted but a deeper rule denies its descendant */
+        subtree = true;
+        assert_int_equal(NACM_ACTION_PERMIT, check_data_subtree_access(nacm_data_val_ctx, data_tree[0],
+                    "/test-module:main", NACM_ACCESS_READ, &subtree));
+        assert_false(subtree);
+        assert_int_equal(NACM_ACTION_DENY, check_data_access(nacm_data_val_ctx, data_tree[0], XP_TEST_MODULE_BOOL,
+                    NACM_ACCESS_READ));
+        assert_int_equal(NACM_ACTION_PERMIT, check_data_access(nacm_data_val_ctx, data_tree[0], XP_TEST_MODULE_STRING,
+                    NACM_ACCESS_READ));
+        nacm_data_validation_stop(nacm_data_val_ctx);
+
+        /*  -> a rule of any module applies deep in the permitted interface */
+        rc = nacm_data_validation_start(nacm_ctx, rp_session[0]->user_credentials, if_data_tree->schema,
+                &nacm_data_val_ctx);
+        assert_int_equal(SR_ERR_OK, rc);
+        subtree = true;
+        assert_int_equal(NACM_ACTION_PERMIT, check_data_subtree_access(nacm_data_val_ctx, if_data_tree,
+                    "/ietf-interfaces:interfaces/interface[name='eth0']", NACM_ACCESS_READ, &subtree));
+        assert_false(subtree);
+        assert_int_equal(NACM_ACTION_DENY, check_data_access(nacm_data_val_ctx, if_data_tree,
+                    "/ietf-interfaces:interfaces/interface[name='eth0']/enabled", NACM_ACCESS_READ));
+        assert_int_equal(NACM_ACTION_PERMIT, check_data_access(nacm_data_val_ctx, if_data_tree,
+                    "/ietf-interfaces:interfaces/interface[name='eth0']/description", NACM_ACCESS_READ));
+        nacm_data_validation_stop(nacm_data_val_ctx);
+
+        /* user2 */
+        rc = nacm_data_validation_start(nacm_ctx, rp_session[1]->user_credentials, data_tree[1]->schema,
+                &nacm_data_val_ctx);
+        assert_int_equal(SR_ERR_OK, rc);
+        /*  -> the list instance is permitted but a deeper rule with a key predicate denies its leaf */
+        for (int i = 0; i < 2; ++i) {
+            subtree = true;
+            assert_int_equal(NACM_ACTION_PERMIT, check_data_subtree_access(nacm_data_val_ctx, data_tree[1],
+                        i ? "/test-module:list[key='k2']" : "/test-module:list[key='k1']", NACM_ACCESS_READ, &subtree));
+            assert_false(subtree);
+        }
+        assert_int_equal(NACM_ACTION_DENY, check_data_access(nacm_data_val_ctx, data_tree[1], LIST_K1_UNION,
+                    NACM_ACCESS_READ));
+        assert_int_equal(NACM_ACTION_PERMIT, check_data_access(nacm_data_val_ctx, data_tree[1], LIST_K2_UNION,
+                    NACM_ACCESS_READ));
+        nacm_data_validation_stop(nacm_data_val_ctx);
+    }
+
+    /* cleanup */
+    for (int i = 0; i < 2; ++i) {
+        test_rp_session_cleanup(rp_ctx, rp_session[i]);
+    }
+}
+
+static void
+nacm_test_shared_rule_list_sets(void **state)
+{
+    int rc = 0;
+    dm_ctx_t *dm_ctx = rp_ctx->dm_ctx;
+    rp_session_t *rp_session = NULL;
+    struct lyd_node *data_tree = NULL;
+    nacm_data_val_ctx_t *nacm_data_val_ctx[3] = {NULL,};
+    test_nacm_cfg_t *nacm_config = NULL;
+    nacm_ctx_t *nacm_ctx = get_nacm_ctx();
+    const ac_ucred_t credentials[3] = {{"user1", 10, 10, NULL, 10, 10},
+                                       {"user2", 20, 20, NULL, 20, 20},
+                                       {"user3", 30, 30, NULL, 30, 30}};
+
+    /* datastore content */
+    createDataTreeTestModule();
+
+    /* NACM config: user1 and user2 are members of the same groups */
+    new_nacm_config(&nacm_config);
+    add_nacm_user(nacm_config, "user1", "group1");
+    add_nacm_user(nacm_config, "user2", "group1");
+    add_nacm_user(nacm_config, "user3", "group1");
+    add_nacm_user(nacm_config, "user3", "group2");
+    add_nacm_rule_list(nacm_config, "acl1", "group1", NULL);
+    add_nacm_rule_list(nacm_config, "acl2", "group2", NULL);
+    add_nacm_rule(nacm_config, "acl1", "deny-boolean", "test-module", NACM_RULE_DATA,
+            XP_TEST_MODULE_BOOL, "*", "deny", NULL);
+    add_nacm_rule(nacm_config, "acl2", "deny-string", "test-module", NACM_RULE_DATA,
+            XP_TEST_MODULE_STRING, "*", "deny", NULL);
+    save_nacm_config(nacm_config);
+    nacm_reload(nacm_ctx, SR_DS_STARTUP);
+    assert_int_equal(0, nacm_ctx->compiled.user_cnt);
+    assert_int_equal(0, nacm_ctx->compiled.decision_cnt);
+
+    test_rp_session_create_user(rp_ctx, SR_DS_STARTUP, user_credentials[0], SR_SESS_ENABLE_NACM, &rp_session);
+    rc = dm_get_datatree(dm_ctx, rp_session->dm_session, "test-module", &data_tree);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_non_null(data_tree);
+
+    /* repeat to get the same outcome also from the cached sets of rule-lists */
+    for (int round = 0; round < 2; ++round) {
+        for (int i = 0; i < 3; ++i) {
+            rc = nacm_data_validation_start(nacm_ctx, &credentials[i], data_tree->schema, &nacm_data_val_ctx[i]);
+            assert_int_equal(SR_ERR_OK, rc);
+        }
+        assert_int_equal(3, nacm_ctx->compiled.user_cnt);
+        /*  -> users with the same groups share the set of rule-lists */
+        assert_int_equal(nacm_data_val_ctx[0]->rule_list_set, nacm_data_val_ctx[1]->rule_list_set);
+        assert_int_not_equal(nacm_data_val_ctx[0]->rule_list_set, nacm_data_val_ctx[2]->rule_list_set);
+        /*  -> and the decisions compiled for it (all compiled in the first round) */
+        assert_int_equal(NACM_ACTION_DENY, check_data_access(nacm_data_val_ctx[0], data_tree, XP_TEST_MODULE_BOOL,
+                    NACM_ACCESS_READ));
+        assert_int_equal(round ? 4 : 1, nacm_ctx->compiled.decision_cnt);
+        assert_int_equal(NACM_ACTION_DENY, check_data_access(nacm_data_val_ctx[1], data_tree, XP_TEST_MODULE_BOOL,
+                    NACM_ACCESS_READ));
+        assert_int_equal(round ? 4 : 1, nacm_ctx->compiled.decision_cnt);
+        assert_int_equal(NACM_ACTION_DENY, check_data_access(nacm_data_val_ctx[2], data_tree, XP_TEST_MODULE_BOOL,
+                    NACM_ACCESS_READ));
+        assert_int_equal(round ? 4 : 2, nacm_ctx->compiled.decision_cnt);
+        assert_int_equal(NACM_ACTION_PERMIT, check_data_access(nacm_data_val_ctx[1], data_tree, XP_TEST_MODULE_STRING,
+                    NACM_ACCESS_READ));
+        assert_int_equal(NACM_ACTION_DENY, check_data_access(nacm_data_val_ctx[2], data_tree, XP_TEST_MODULE_STRING,
+                    NACM_ACCESS_READ));
+        assert_int_equal(4, nacm_ctx->compiled.decision_cnt);
+        for (int i = 0; i < 3; ++i) {
+            nacm_data_validation_stop(nacm_data_val_ctx[i]);
+        }
+    }
+
+    /* user2 joins group2, the sets of rule-lists matched before the reload are not used anymore */
+    add_nacm_user(nacm_config, "user2", "group2");
+    save_nacm_config(nacm_config);
+    nacm_reload(nacm_ctx, SR_DS_STARTUP);
+    assert_int_equal(0, nacm_ctx->compiled.user_cnt);
+    for (int i = 0; i < 3; ++i) {
+        rc = nacm_data_validation_start(nacm_ctx, &credentials[i], data_tree->schema, &nacm_data_val_ctx[i]);
+        assert_int_equal(SR_ERR_OK, rc);
+    }
+    assert_int_not_equal(nacm_data_val_ctx[0]->rule_list_set, nacm_data_val_ctx[1]->rule_list_set);
+    assert_int_equal(nacm_data_val_ctx[1]->rule_list_set, nacm_data_val_ctx[2]->rule_list_set);
+    assert_int_equal(NACM_ACTION_PERMIT, check_data_access(nacm_data_val_ctx[0], data_tree, XP_TEST_MODULE_STRING,
+                NACM_ACCESS_READ));
+    assert_int_equal(NACM_ACTION_DENY, check_data_access(nacm_data_val_ctx[1], data_tree, XP_TEST_MODULE_STRING,
+                NACM_ACCESS_READ));
+    for (int i = 0; i < 3; ++i) {
+        nacm_data_validation_stop(nacm_data_val_ctx[i]);
+    }
+
+    /* cleanup */
+    delete_nacm_config(nacm_config);
+    test_rp_session_cleanup(rp_ctx, rp_session);
+}
+
+static void
+nacm_test_failed_reload(void **state)
+{
+    int rc = 0;
+    dm_ctx_t *dm_ctx = rp_ctx->dm_ctx;
+    rp_session_t *rp_session = NULL;
+    struct lyd_node *data_tree = NULL;
+    nacm_data_val_ctx_t *nacm_data_val_ctx = NULL;
+    nacm_ctx_t *nacm_ctx = get_nacm_ctx();
+    size_t rule_list_cnt = 0, decision_cnt = 0;
+    FILE *file = NULL;
+
+    /* datastore content */
+    createDataTreeTestModule();
+
+    /* NACM config */
+    nacm_config_for_basic_read_access_tests(false, NULL);
+    rule_list_cnt = nacm_ctx->rule_lists->count;
+    assert_int_equal(3, rule_list_cnt);
+
+    test_rp_session_create_user(rp_ctx, SR_DS_STARTUP, user_credentials[0], SR_SESS_ENABLE_NACM, &rp_session);
+    rc = dm_get_datatree(dm_ctx, rp_session->dm_session, "test-module", &data_tree);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_non_null(data_tree);
+
+    rc = nacm_data_validation_start(nacm_ctx, rp_session->user_credentials, data_tree->schema, &nacm_data_val_ctx);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_equal(NACM_ACTION_DENY, check_data_access(nacm_data_val_ctx, data_tree, XP_TEST_MODULE_BOOL, NACM_ACCESS_READ));
+    nacm_data_validation_stop(nacm_data_val_ctx);
+    decision_cnt = nacm_ctx->compiled.decision_cnt;
+    assert_true(0 < decision_cnt);
+
+    /* corrupt the NACM startup datastore */
+    file = fopen(TEST_DATA_SEARCH_DIR "ietf-netconf-acm" SR_STARTUP_FILE_EXT, "w");
+    assert_non_null(file);
+    assert_true(0 < fputs("<nacm xmlns=\"urn:ietf:params:xml:ns:yang:ietf-netconf-acm\"><enable-nacm>", file));
+    assert_int_equal(0, fclose(file));
+
+    /* the reload fails, the previous configuration and its compiled decisions are kept */
+    rc = nacm_reload(nacm_ctx, SR_DS_STARTUP);
+    assert_int_not_equal(SR_ERR_OK, rc);
+    assert_true(nacm_ctx->enabled);
+    assert_int_equal(rule_list_cnt, nacm_ctx->rule_lists->count);
+    assert_int_equal(decision_cnt, nacm_ctx->compiled.decision_cnt);
+    assert_string_equal("acl1", nacm_get_rule_list(nacm_ctx, 0)->name);
+    nacm_get_user(nacm_ctx, "user1");
+
+    rc = nacm_data_validation_start(nacm_ctx, rp_session->user_credentials, data_tree->schema, &nacm_data_val_ctx);
+    assert_int_equal(SR_ERR_OK, rc);
+    assert_int_equal(NACM_ACTION_DENY, check_data_access(nacm_data_val_ctx, data_tree, XP_TEST_MODULE_BOOL, NACM_ACCESS_READ));
+    assert_int_equal(NACM_ACTION_DENY, check_data_access(nacm_data_val_ctx, data_tree, MAIN_NUMBER_42, NACM_ACCESS_READ));
+    assert_int_equal(NACM_ACTION_PERMIT, check_data_access(nacm_data_val_ctx, data_tree, MAIN_NUMBER_2, NACM_ACCESS_READ));
+    nacm_data_validation_stop(nacm_data_val_ctx);
+
+    /* a valid configuration is loaded again */
+    nacm_config_for_basic_read_access_tests(false, NULL);
+    assert_int_equal(rule_list_cnt, nacm_ctx->rule_lists->count);
+    assert_int_equal(0, nacm_ctx->compiled.decision_cnt);
+
+    /* cleanup */
+    test_rp_session_cleanup(rp_ctx, rp_session);
+}
+
 int main() {
     const struct CMUnitTest tests[] = {
             cmocka_unit_test(nacm_test_empty_config),
@@ -3393,6 +3828,11 @@ int main() {
             cmocka_unit_test(nacm_test_read_access_with_disabled_nacm),
             cmocka_unit_test(nacm_test_read_access_denied_by_default),
             cmocka_unit_test(nacm_test_read_access_with_empty_config),
+            cmocka_unit_test(nacm_test_compiled_data_decisions),
+            cmocka_unit_test(nacm_test_compiled_data_decisions_with_keys),
+            cmocka_unit_test(nacm_test_read_access_subtree_decisions),
+            cmocka_unit_test(nacm_test_shared_rule_list_sets),
+            cmocka_unit_test(nacm_test_failed_reload),
     };
 
     sr_log_stderr(SR_LL_DBG);
@@ -99,17 +99,17 @@ np_tmp_subscription_test(void **state)
 
     /* create subscription 1 */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__MODULE_INSTALL_SUBS,
-            "addr1", 123, NULL, NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, SR_API_VALUES, NP_SUBSCR_DEFAULT);
+            "addr1", 123, NULL, NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, 0, SR_API_VALUES, NP_SUBSCR_DEFAULT);
     assert_int_equal(rc, SR_ERR_OK);
 
     /* create subscription 2 */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__MODULE_INSTALL_SUBS,
-            "addr2", 123, NULL, NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, SR_API_VALUES, NP_SUBSCR_DEFAULT);
+            "addr2", 123, NULL, NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, 0, SR_API_VALUES, NP_SUBSCR_DEFAULT);
     assert_int_equal(rc, SR_ERR_OK);
 
     /* create subscription 3 */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__FEATURE_ENABLE_SUBS,
-            "addr1", 456, NULL, NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, SR_API_VALUES, NP_SUBSCR_DEFAULT);
+            "addr1", 456, NULL, NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, 0, SR_API_VALUES, NP_SUBSCR_DEFAULT);
     assert_int_equal(rc, SR_ERR_OK);
 
     /* module install notify */
@@ -146,39 +146,39 @@ np_persistent_subscription_test(void **state)
 
     /* create subscription to example-module @ addr1 */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__MODULE_CHANGE_SUBS,
-            "addr1", 123, "example-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
+            "addr1", 123, "example-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, 0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
     assert_int_equal(rc, SR_ERR_OK);
 
     /* create subscription to test-module @ addr1 */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__MODULE_CHANGE_SUBS,
-            "addr1", 456, "test-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
+            "addr1", 456, "test-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, 0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
     assert_int_equal(rc, SR_ERR_OK);
 
     /* create subscription to small-module @ addr1 */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__MODULE_CHANGE_SUBS,
-            "addr1", 789, "small-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
+            "addr1", 789, "small-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, 0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
     assert_int_equal(rc, SR_ERR_OK);
 
     /* create subscription to test-module @ addr1 */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__EVENT_NOTIF_SUBS,
             "addr1", 999, "test-module", "/test-module:link-removed", "user2", SR__NOTIFICATION_EVENT__APPLY_EV, 0,
-            SR_API_VALUES, NP_SUBSCR_DEFAULT);
+            0, SR_API_VALUES, NP_SUBSCR_DEFAULT);
     assert_int_equal(rc, SR_ERR_OK);
 
     /* create subscription to example-module @ addr2 */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__MODULE_CHANGE_SUBS,
-            "addr2", 123, "example-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, SR_API_VALUES, NP_SUBSCR_DEFAULT);
+            "addr2", 123, "example-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, 0, SR_API_VALUES, NP_SUBSCR_DEFAULT);
     assert_int_equal(rc, SR_ERR_OK);
 
     /* create subscription to test-module @ addr2 */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__MODULE_CHANGE_SUBS,
-            "addr2", 456, "test-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, SR_API_VALUES, NP_SUBSCR_DEFAULT);
+            "addr2", 456, "test-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, 0, SR_API_VALUES, NP_SUBSCR_DEFAULT);
     assert_int_equal(rc, SR_ERR_OK);
 
     /* create subscription to test-module @ addr2 */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__EVENT_NOTIF_SUBS,
             "addr2", 789, "test-module", "/test-module:link-discovered", "user1", SR__NOTIFICATION_EVENT__APPLY_EV, 0,
-            SR_API_VALUES, NP_SUBSCR_DEFAULT);
+            0, SR_API_VALUES, NP_SUBSCR_DEFAULT);
     assert_int_equal(rc, SR_ERR_OK);
 
     /* unsubscribe addr1 per partes */
@@ -220,12 +220,12 @@ np_negative_subscription_test(void **state)
 
     /* subscribe */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__MODULE_CHANGE_SUBS,
-            "addr2", 456, "example-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
+            "addr2", 456, "example-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, 0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
     assert_int_equal(rc, SR_ERR_OK);
 
     /* try to subscribe again for the same */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__MODULE_CHANGE_SUBS,
-            "addr2", 456, "example-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
+            "addr2", 456, "example-module", NULL, NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 0, 0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
     assert_int_equal(rc, SR_ERR_DATA_EXISTS);
 
     /* try to unsubscribe from module-change subscription without specifying module name */
@@ -291,17 +291,17 @@ np_module_subscriptions_test(void **state)
 
     /* subscribe */
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__MODULE_CHANGE_SUBS,
-            "addr3", 123, "example-module", NULL, NULL, SR__NOTIFICATION_EVENT__VERIFY_EV, 10, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
+            "addr3", 123, "example-module", NULL, NULL, SR__NOTIFICATION_EVENT__VERIFY_EV, 10, 0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
     assert_int_equal(rc, SR_ERR_OK);
 
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__SUBTREE_CHANGE_SUBS,
             "addr3", 456, "example-module", "/example-module:container", NULL, SR__NOTIFICATION_EVENT__VERIFY_EV, 20,
-            SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
+            0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
     assert_int_equal(rc, SR_ERR_OK);
 
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__SUBTREE_CHANGE_SUBS,
             "addr3", 789, "example-module", "/example-module:container", NULL, SR__NOTIFICATION_EVENT__APPLY_EV, 20,
-            SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
+            0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
     assert_int_equal(rc, SR_ERR_OK);
 
     /* get all subscriptions */
@@ -321,7 +321,7 @@ np_module_subscriptions_test(void **state)
                 (SR__NOTIFICATION_EVENT__APPLY_EV == subscription->notif_event));
 
         /* notify */
-        rc = np_subscription_notify(np_ctx, subscription, SR_EV_APPLY, 0);
+        rc = np_subscription_notify(np_ctx, subscription, SR_EV_APPLY, 0, NULL);
         assert_int_equal(rc, SR_ERR_OK);
     }
 
@@ -363,12 +363,12 @@ np_dp_subscriptions_test(void **state)
 
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__DP_GET_ITEMS_SUBS,
             "addr4", 789, "example-module", "/example-module:container", NULL, SR__NOTIFICATION_EVENT__VERIFY_EV, 20,
-            SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
+            0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
     assert_int_equal(rc, SR_ERR_OK);
 
     rc = np_notification_subscribe(np_ctx, test_ctx->rp_session_ctx, SR__SUBSCRIPTION_TYPE__DP_GET_ITEMS_SUBS,
             "addr5", 1011, "example-module", "/example-module:container", NULL, SR__NOTIFICATION_EVENT__VERIFY_EV, 20,
-            SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
+            0, SR_API_VALUES, NP_SUBSCR_ENABLE_RUNNING);
     assert_int_equal(rc, SR_ERR_OK);
 
     /* get subscriptions */
@@ -404,6 +404,30 @@ np_dp_subscriptions_test(void **state)
     assert_int_equal(rc, SR_ERR_OK);
 }
 
+#ifdef ENABLE_NOTIF_STORE
+typedef struct np_notif_store_check_ctx_s {
+    time_t now;
+    size_t count;
+    bool removed_found;
+} np_notif_store_check_ctx_t;
+
+static int
+np_notif_store_check_cb(np_ev_notification_t *notification, void *private_ctx)
+{
+    np_notif_store_check_ctx_t *check_ctx = private_ctx;
+
+    assert_true(notification->timestamp >= check_ctx->now - 60 && notification->timestamp <= check_ctx->now);
+    if (0 == strcmp(notification->xpath, "/test-module:link-removed")) {
+        check_ctx->removed_found = true;
+    } else {
+        assert_string_equal(notification->xpath, "/test-module:link-discovered");
+    }
+    check_ctx->count++;
+
+    return SR_ERR_OK;
+}
+#endif
+
 static void
 np_notif_store_test(void **state)
 {
@@ -417,8 +441,12 @@ np_notif_store_test(void **state)
 
     struct ly_ctx *ctx = NULL;
     const struct lys_module *module = NULL;
-    struct lyd_node *node = NULL;
-    sr_list_t *notif_list = NULL;
+    struct lyd_node *node = NULL, *removed_node = NULL;
+    np_notif_store_check_ctx_t check_ctx = { 0, };
+    np_notif_store_cursor_t cursor = { 0, };
+    time_t now = time(NULL);
+    uint32_t file_cnt = 0;
+    uint64_t size = 0;
 
     /* create notif. data tree */
     ctx = ly_ctx_new(TEST_SCHEMA_SEARCH_DIR);
@@ -427,32 +455,121 @@ np_notif_store_test(void **state)
     assert_non_null(module);
     node = lyd_new_path(NULL, ctx, "/test-module:link-discovered/source/interface", "eth0", 0, 0);
     assert_non_null(node);
+    removed_node = lyd_new_path(NULL, ctx, "/test-module:link-removed/source/interface", "eth1", 0, 0);
+    assert_non_null(removed_node);
 
-    /* store notification */
-    rc = np_store_event_notification(np_ctx, test_ctx->rp_session_ctx->user_credentials, "/test-module:link-discovered",
-            time(NULL), node);
+    /* store notifications (one of them into an older segment) */
+    rc = np_store_event_notification(np_ctx, "/test-module:link-discovered", now, node);
+    assert_int_equal(rc, SR_ERR_OK);
+    rc = np_store_event_notification(np_ctx, "/test-module:link-removed", now, removed_node);
+    assert_int_equal(rc, SR_ERR_OK);
+    rc = np_store_event_notification(np_ctx, "/test-module:link-discovered", now - 7200, node);
     assert_int_equal(rc, SR_ERR_OK);
 
-    /* retrieve notifications  */
-    rc = np_get_event_notifications(np_ctx, test_ctx->rp_session_ctx, "/test-module:link-discovered", 0, time(NULL),
-            SR_API_VALUES, &notif_list);
+    rc = np_get_notif_store_size(np_ctx, &file_cnt, &size);
     assert_int_equal(rc, SR_ERR_OK);
-    assert_non_null(notif_list);
+    assert_true(file_cnt >= 4);
+    assert_true(size > 0);
 
-    for (size_t i = 0; i < notif_list->count; i++) {
-        np_ev_notification_t *notification = notif_list->data[i];
-        assert_string_equal(notification->xpath, "/test-module:link-discovered");
-        np_event_notification_cleanup(notification);
-    }
-    sr_list_cleanup(notif_list);
+    /* retrieve notifications  */
+    check_ctx.now = now;
+    rc = np_get_event_notifications(np_ctx, test_ctx->rp_session_ctx, "/test-module:link-discovered", now - 60, now,
+            SR_API_VALUES, NULL, 0, np_notif_store_check_cb, &check_ctx);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_true(check_ctx.count >= 1);
+
+    /* retrieve all notifications of the module, one notification per call */
+    memset(&check_ctx, 0, sizeof(check_ctx));
+    check_ctx.now = now;
+    do {
+        rc = np_get_event_notifications(np_ctx, test_ctx->rp_session_ctx, "/test-module:.", now - 60, now,
+                SR_API_TREES, &cursor, 1, np_notif_store_check_cb, &check_ctx);
+        assert_int_equal(rc, SR_ERR_OK);
+    } while (!cursor.done);
+    assert_true(check_ctx.count >= 2);
+    assert_true(check_ctx.removed_found);
 
-    rc = np_notification_store_cleanup(np_ctx, false);
+    rc = np_notification_store_cleanup(np_ctx);
     assert_int_equal(rc, SR_ERR_OK);
     lyd_free_withsiblings(node);
+    lyd_free_withsiblings(removed_node);
     ly_ctx_destroy(ctx, NULL);
 #endif
 }
 
+static int
+np_notif_store_count_cb(const np_notif_store_record_t *record, void *private_ctx)
+{
+    size_t *count = private_ctx;
+
+    (*count)++;
+    return SR_ERR_OK;
+}
+
+static void
+np_notif_store_retention_test(void **state)
+{
+    np_notif_store_t *store = NULL;
+    np_notif_store_retention_t retention = { 0, };
+    np_notif_store_cursor_t cursor = { 0, };
+    time_t now = time(NULL);
+    uint32_t file_cnt = 0;
+    uint64_t size = 0;
+    size_t count = 0;
+    int rc = SR_ERR_OK;
+
+    rc = np_notif_store_init(TEST_DATA_SEARCH_DIR "notif-retention", TEST_DATA_SEARCH_DIR, &store);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    /* start with an empty store */
+    retention.max_size = 1;
+    rc = np_notif_store_set_retention(store, &retention, NULL, NULL);
+    assert_int_equal(rc, SR_ERR_OK);
+    rc = np_notif_store_enforce_retention(store);
+    assert_int_equal(rc, SR_ERR_OK);
+    rc = np_notif_store_get_size(store, &file_cnt, &size);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_int_equal(file_cnt, 0);
+
+    /* 3 notifications in an older segment, 5 in the current one */
+    for (size_t i = 0; i < 8; i++) {
+        rc = np_notif_store_append(store, "test-module", "/test-module:link-removed", (i < 3) ? now - 7200 : now,
+                NP_NOTIF_STORE_DATA_STRING, "<link-removed/>");
+        assert_int_equal(rc, SR_ERR_OK);
+    }
+
+    /* stop reading in the middle of the current segment */
+    rc = np_notif_store_read(store, "test-module", NULL, 0, now, &cursor, 6, np_notif_store_count_cb, &count);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_int_equal(count, 6);
+    assert_false(cursor.done);
+
+    /* the older segment is removed, the current one is compacted */
+    retention.max_size = 0;
+    retention.max_count = 4;
+    rc = np_notif_store_set_retention(store, &retention, NULL, NULL);
+    assert_int_equal(rc, SR_ERR_OK);
+    rc = np_notif_store_enforce_retention(store);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    rc = np_notif_store_get_size(store, &file_cnt, &size);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_int_equal(file_cnt, 2);
+    count = 0;
+    rc = np_notif_store_read(store, "test-module", NULL, 0, now, NULL, 0, np_notif_store_count_cb, &count);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_int_equal(count, 4);
+
+    /* the cursor continues right after the last record read, although the records have moved */
+    count = 0;
+    rc = np_notif_store_read(store, "test-module", NULL, 0, now, &cursor, 0, np_notif_store_count_cb, &count);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_int_equal(count, 2);
+    assert_true(cursor.done);
+
+    np_notif_store_cleanup(store);
+}
+
 int
 main() {
     const struct CMUnitTest tests[] = {
@@ -463,6 +580,7 @@ main() {
             cmocka_unit_test_setup_teardown(np_module_subscriptions_test, test_setup, test_teardown),
             cmocka_unit_test_setup_teardown(np_dp_subscriptions_test, test_setup, test_teardown),
             cmocka_unit_test_setup_teardown(np_notif_store_test, test_setup, test_teardown),
+            cmocka_unit_test_setup_teardown(np_notif_store_retention_test, test_setup, test_teardown),
     };
 
     watchdog_start(300);
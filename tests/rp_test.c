@@ -88,6 +88,49 @@ rp_session_test(void **state)
     }
 }
 
+/*
+ * Test starting trusted RP sessions.
+ */
+static void
+rp_session_trusted_test(void **state)
+{
+    int rc = 0;
+    rp_session_t *session = NULL;
+
+    ac_ucred_t credentials = { 0 };
+    credentials.e_uid = getuid();
+    credentials.e_gid = getgid();
+
+    rp_ctx_t *rp_ctx = *state;
+    assert_non_null(rp_ctx);
+
+    /* root is always allowed to start a trusted session */
+    rc = rp_session_start(rp_ctx, 123456, &credentials, SR_DS_STARTUP, SR_SESS_TRUSTED, 0, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_non_null(session);
+    rc = rp_session_stop(rp_ctx, session);
+    assert_int_equal(rc, SR_ERR_OK);
+
+    if (0 == strcmp(SR_TRUSTED_SESSION_USER, "nobody") ||
+            SR_ERR_OK != sr_get_user_id("nobody", &credentials.r_uid, &credentials.r_gid)) {
+        skip();
+    }
+    credentials.r_username = "nobody";
+
+    /* other users are not allowed (unless configured at build time) */
+    session = NULL;
+    rc = rp_session_start(rp_ctx, 123456, &credentials, SR_DS_STARTUP, SR_SESS_TRUSTED, 0, &session);
+    assert_int_equal(rc, SR_ERR_UNAUTHORIZED);
+    assert_null(session);
+
+    /* but can start ordinary sessions */
+    rc = rp_session_start(rp_ctx, 123456, &credentials, SR_DS_STARTUP, SR_SESS_DEFAULT, 0, &session);
+    assert_int_equal(rc, SR_ERR_OK);
+    assert_non_null(session);
+    rc = rp_session_stop(rp_ctx, session);
+    assert_int_equal(rc, SR_ERR_OK);
+}
+
 /**
  * Test RP processing of an invalid messages.
  */
@@ -146,6 +189,7 @@ int
 main() {
     const struct CMUnitTest tests[] = {
             cmocka_unit_test_setup_teardown(rp_session_test, rp_setup, rp_teardown),
+            cmocka_unit_test_setup_teardown(rp_session_trusted_test, rp_setup, rp_teardown),
             cmocka_unit_test_setup_teardown(rp_msg_neg_test, rp_setup, rp_teardown),
     };
 
@@ -0,0 +1,801 @@
+/**
+ * @file sysrepo_bench.c
+ * @brief Sysrepo benchmark suite. Runs parameterized scenarios with concurrent clients
+ * and reports latency percentiles and throughput, optionally as JSON.
+ *
+ * @copyright
+ * Copyright 2016 Cisco Systems, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <unistd.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "sysrepo.h"
+#include "sysrepo/values.h"
+#include "sysrepo/xpath.h"
+#include "test_module_helper.h"
+
+#define BENCH_DEFAULT_OPS 1000          /**< Default number of operations performed by each client. */
+#define BENCH_DEFAULT_READ_RATIO 90     /**< Default percentage of reads in the mixed scenario. */
+#define BENCH_MAX_SIZES 16              /**< Maximum number of data sizes in one run. */
+#define BENCH_MIN_SIZE 10               /**< Minimal data size (list entries). */
+#define BENCH_MAX_SIZE 1000000          /**< Maximal data size (list entries). */
+#define BENCH_DRAIN_TIMEOUT 30          /**< Timeout (in seconds) for delivery of all notifications. */
+#define BENCH_XPATH_MAX 256             /**< Maximal length of an xpath used by the benchmark. */
+
+#define BENCH_LEAF_XPATH "/example-module:container/list[key1='key1'][key2='key2']/leaf"
+#define BENCH_LIST_XPATH "/example-module:container/list[key1='key1'][key2='key2']"
+#define BENCH_ALL_LEAVES_XPATH "/example-module:container/list/leaf"
+#define BENCH_OPER_XPATH "/ietf-interfaces:interfaces-state/interface"
+#define BENCH_RPC_XPATH "/test-module:activate-software-image"
+#define BENCH_NOTIF_XPATH "/test-module:link-discovered"
+
+/**
+ * @brief Options of the benchmark run.
+ */
+typedef struct bench_opts_s {
+    size_t clients;                     /**< Number of concurrent clients (each with own connection, session and thread). */
+    size_t ops;                         /**< Number of operations performed by each client. */
+    size_t sizes[BENCH_MAX_SIZES];      /**< Data sizes (number of list entries) to run the scenarios with. */
+    size_t size_cnt;                    /**< Number of data sizes. */
+    unsigned read_ratio;                /**< Percentage of reads in the mixed scenario. */
+    size_t verifiers;                   /**< Number of verifiers subscribed for commits. */
+    size_t subscribers;                 /**< Number of notification subscribers. */
+    const char *scenarios;              /**< Comma-separated list of scenarios to run, NULL for all. */
+    const char *json_file;              /**< File where JSON results are written, NULL if not requested. */
+} bench_opts_t;
+
+/**
+ * @brief Context shared by all clients of a scenario run.
+ */
+typedef struct bench_ctx_s {
+    const bench_opts_t *opts;           /**< Benchmark options. */
+    size_t size;                        /**< Current data size. */
+    sr_conn_ctx_t *conn;                /**< Connection used by the subscribers. */
+    sr_session_ctx_t *session;          /**< Session used by the subscribers. */
+    sr_subscription_ctx_t *subscription;/**< Subscriptions made by the scenario setup. */
+    size_t delivered;                   /**< Number of delivered notifications. */
+} bench_ctx_t;
+
+/**
+ * @brief State of one benchmark client.
+ */
+typedef struct bench_client_s {
+    bench_ctx_t *ctx;                   /**< Shared context. */
+    const struct bench_scenario_s *scenario;  /**< Scenario being run. */
+    size_t id;                          /**< Client ID. */
+    sr_conn_ctx_t *conn;                /**< Client's connection. */
+    sr_session_ctx_t *session;          /**< Client's session. */
+    uint64_t *latencies;                /**< Latencies of the performed operations (in nanoseconds). */
+    size_t op_cnt;                      /**< Number of performed operations. */
+    size_t err_cnt;                     /**< Number of failed operations. */
+    unsigned seed;                      /**< Seed of the client's random generator. */
+    pthread_t thread;                   /**< Client's thread. */
+} bench_client_t;
+
+/**
+ * @brief Benchmark scenario.
+ */
+typedef struct bench_scenario_s {
+    const char *name;                   /**< Name of the scenario. */
+    const char *description;            /**< Short description. */
+    sr_datastore_t datastore;           /**< Datastore of the client sessions. */
+    int (*setup)(bench_ctx_t *ctx);     /**< Optional setup (subscriptions). */
+    int (*op)(bench_client_t *client, size_t i);  /**< Measured operation. */
+    void (*drain)(bench_ctx_t *ctx, size_t total_ops);  /**< Optional wait for asynchronous completion. */
+} bench_scenario_t;
+
+/**
+ * @brief Results of a scenario run.
+ */
+typedef struct bench_result_s {
+    const char *scenario;               /**< Name of the scenario. */
+    size_t size;                        /**< Data size. */
+    size_t clients;                     /**< Number of clients. */
+    size_t ops;                         /**< Total number of performed operations. */
+    size_t errors;                      /**< Total number of failed operations. */
+    double seconds;                     /**< Wall-clock duration of the run. */
+    double throughput;                  /**< Operations per second. */
+    double mean_us;                     /**< Mean latency (in microseconds). */
+    double p50_us;                      /**< 50th percentile of latency (in microseconds). */
+    double p99_us;                      /**< 99th percentile of latency (in microseconds). */
+    double p999_us;                     /**< 99.9th percentile of latency (in microseconds). */
+    double max_us;                      /**< Maximal latency (in microseconds). */
+} bench_result_t;
+
+static uint64_t
+bench_now_ns()
+{
+    struct timespec ts = { 0, };
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+/**
+ * @brief Writes example-module startup data with given number of list entries.
+ *
+ * The file is written directly (not through libyang) so that even the largest sizes are generated quickly.
+ */
+static int
+bench_create_data(size_t size)
+{
+    FILE *file = fopen(EXAMPLE_MODULE_DATA_FILE_NAME, "w");
+    if (NULL == file) {
+        fprintf(stderr, "Unable to open the data file '%s'.\n", EXAMPLE_MODULE_DATA_FILE_NAME);
+        return SR_ERR_IO;
+    }
+    fprintf(file, "<container xmlns=\"urn:ietf:params:xml:ns:yang:example\">\n");
+    fprintf(file, "  <list><key1>key1</key1><key2>key2</key2><leaf>Leaf value</leaf></list>\n");
+    for (size_t i = 1; i < size; i++) {
+        fprintf(file, "  <list><key1>k1%zu</key1><key2>k2%zu</key2><leaf>Leaf value</leaf></list>\n", i, i);
+    }
+    fprintf(file, "</container>\n");
+    fclose(file);
+    return SR_ERR_OK;
+}
+
+/* ---------------------------------------------------------------------------------------------- */
+/* subscriber callbacks */
+
+static int
+bench_module_change_cb(sr_session_ctx_t *session, const char *module_name, sr_notif_event_t event, void *private_ctx)
+{
+    return SR_ERR_OK;
+}
+
+static int
+bench_dp_get_items_cb(const char *xpath, sr_val_t **values, size_t *values_cnt, void *private_ctx)
+{
+    bench_ctx_t *ctx = (bench_ctx_t *)private_ctx;
+    sr_val_t *v = NULL;
+    int rc = SR_ERR_OK;
+
+    *values = NULL;
+    *values_cnt = 0;
+
+    if (sr_xpath_node_name_eq(xpath, "interface")) {
+        rc = sr_new_values(ctx->size * 2, &v);
+        if (SR_ERR_OK != rc) {
+            return rc;
+        }
+        for (size_t i = 0; i < ctx->size; i++) {
+            sr_val_build_xpath(&v[2*i], BENCH_OPER_XPATH "[name='eth%zu']", i);
+            v[2*i].type = SR_LIST_T;
+            sr_val_build_xpath(&v[2*i+1], BENCH_OPER_XPATH "[name='eth%zu']/oper-status", i);
+            sr_val_set_str_data(&v[2*i+1], SR_ENUM_T, "up");
+        }
+        *values = v;
+        *values_cnt = ctx->size * 2;
+    } else if (sr_xpath_node_name_eq(xpath, "statistics")) {
+        rc = sr_new_values(3, &v);
+        if (SR_ERR_OK != rc) {
+            return rc;
+        }
+        sr_val_build_xpath(&v[0], "%s/in-octets", xpath);
+        v[0].type = SR_UINT64_T;
+        v[0].data.uint64_val = 456213;
+        sr_val_build_xpath(&v[1], "%s/in-unicast-pkts", xpath);
+        v[1].type = SR_UINT64_T;
+        v[1].data.uint64_val = 45213;
+        sr_val_build_xpath(&v[2], "%s/in-broadcast-pkts", xpath);
+        v[2].type = SR_UINT64_T;
+        v[2].data.uint64_val = 4213;
+        *values = v;
+        *values_cnt = 3;
+    }
+
+    return rc;
+}
+
+static int
+bench_rpc_cb(const char *xpath, const sr_val_t *input, const size_t input_cnt,
+        sr_val_t **output, size_t *output_cnt, void *private_ctx)
+{
+    sr_val_t *v = NULL;
+    int rc = SR_ERR_OK;
+
+    rc = sr_new_values(1, &v);
+    if (SR_ERR_OK != rc) {
+        return rc;
+    }
+    sr_val_set_xpath(v, BENCH_RPC_XPATH "/status");
+    sr_val_set_str_data(v, SR_STRING_T, "The image acmefw-2.3 is being installed.");
+
+    *output = v;
+    *output_cnt = 1;
+    return SR_ERR_OK;
+}
+
+static void
+bench_event_notif_cb(const sr_ev_notif_type_t notif_type, const char *xpath,
+        const sr_val_t *values, const size_t values_cnt, time_t timestamp, void *private_ctx)
+{
+    bench_ctx_t *ctx = (bench_ctx_t *)private_ctx;
+    __sync_fetch_and_add(&ctx->delivered, 1);
+}
+
+/* ---------------------------------------------------------------------------------------------- */
+/* scenario setups */
+
+/**
+ * @brief Enables example-module in running datastore and subscribes the requested number of verifiers.
+ */
+static int
+bench_commit_setup(bench_ctx_t *ctx)
+{
+    int rc = SR_ERR_OK;
+
+    /* passive subscription only enables the running datastore */
+    rc = sr_module_change_subscribe(ctx->session, "example-module", bench_module_change_cb, ctx, 0,
+            SR_SUBSCR_CTX_REUSE | SR_SUBSCR_PASSIVE | SR_SUBSCR_APPLY_ONLY, &ctx->subscription);
+    for (size_t i = 0; SR_ERR_OK == rc && i < ctx->opts->verifiers; i++) {
+        rc = sr_module_change_subscribe(ctx->session, "example-module", bench_module_change_cb, ctx, 0,
+                SR_SUBSCR_CTX_REUSE, &ctx->subscription);
+    }
+    return rc;
+}
+
+static int
+bench_oper_setup(bench_ctx_t *ctx)
+{
+    return sr_dp_get_items_subscribe(ctx->session, BENCH_OPER_XPATH, bench_dp_get_items_cb, ctx,
+            SR_SUBSCR_CTX_REUSE, &ctx->subscription);
+}
+
+static int
+bench_rpc_setup(bench_ctx_t *ctx)
+{
+    return sr_rpc_subscribe(ctx->session, BENCH_RPC_XPATH, bench_rpc_cb, ctx, SR_SUBSCR_CTX_REUSE, &ctx->subscription);
+}
+
+static int
+bench_notif_setup(bench_ctx_t *ctx)
+{
+    int rc = SR_ERR_OK;
+
+    for (size_t i = 0; SR_ERR_OK == rc && i < ctx->opts->subscribers; i++) {
+        rc = sr_event_notif_subscribe(ctx->session, BENCH_NOTIF_XPATH, bench_event_notif_cb, ctx,
+                SR_SUBSCR_CTX_REUSE, &ctx->subscription);
+    }
+    return rc;
+}
+
+/**
+ * @brief Waits until all sent notifications are delivered to all subscribers.
+ */
+static void
+bench_notif_drain(bench_ctx_t *ctx, size_t total_ops)
+{
+    size_t expected = total_ops * ctx->opts->subscribers;
+    uint64_t deadline = bench_now_ns() + (uint64_t)BENCH_DRAIN_TIMEOUT * 1000000000;
+
+    while (__sync_fetch_and_add(&ctx->delivered, 0) < expected && bench_now_ns() < deadline) {
+        usleep(100);
+    }
+    if (ctx->delivered < expected) {
+        fprintf(stderr, "Only %zu of %zu notifications have been delivered.\n", ctx->delivered, expected);
+    }
+}
+
+/* ---------------------------------------------------------------------------------------------- */
+/* measured operations */
+
+static int
+bench_get_item_op(bench_client_t *client, size_t i)
+{
+    sr_val_t *value = NULL;
+    int rc = sr_get_item(client->session, BENCH_LEAF_XPATH, &value);
+    sr_free_val(value);
+    return rc;
+}
+
+static int
+bench_get_items_op(bench_client_t *client, size_t i)
+{
+    sr_val_iter_t *iter = NULL;
+    sr_val_t *value = NULL;
+    int rc = sr_get_items_iter(client->session, BENCH_ALL_LEAVES_XPATH, &iter);
+    if (SR_ERR_OK == rc) {
+        while (SR_ERR_OK == sr_get_item_next(client->session, iter, &value)) {
+            sr_free_val(value);
+        }
+        sr_free_val_iter(iter);
+    }
+    return rc;
+}
+
+static int
+bench_get_subtree_op(bench_client_t *client, size_t i)
+{
+    sr_node_t *tree = NULL;
+    int rc = sr_get_subtree(client->session, BENCH_LIST_XPATH, 0, &tree);
+    sr_free_tree(tree);
+    return rc;
+}
+
+static int
+bench_set_commit_op(bench_client_t *client, size_t i)
+{
+    char xpath[BENCH_XPATH_MAX] = { 0, };
+    char value[BENCH_XPATH_MAX] = { 0, };
+    int rc = SR_ERR_OK;
+
+    /* each client edits its own list entry to avoid conflicts */
+    snprintf(xpath, BENCH_XPATH_MAX, "/example-module:container/list[key1='bench'][key2='client%zu']/leaf", client->id);
+    snprintf(value, BENCH_XPATH_MAX, "value%zu", i);
+
+    rc = sr_set_item_str(client->session, xpath, value, SR_EDIT_DEFAULT);
+    if (SR_ERR_OK == rc) {
+        rc = sr_commit(client->session);
+    }
+    if (SR_ERR_OK != rc) {
+        sr_discard_changes(client->session);
+    }
+    return rc;
+}
+
+static int
+bench_mixed_op(bench_client_t *client, size_t i)
+{
+    if ((unsigned)(rand_r(&client->seed) % 100) < client->ctx->opts->read_ratio) {
+        return bench_get_item_op(client, i);
+    } else {
+        return bench_set_commit_op(client, i);
+    }
+}
+
+static int
+bench_oper_op(bench_client_t *client, size_t i)
+{
+    sr_val_iter_t *iter = NULL;
+    sr_val_t *value = NULL;
+    int rc = sr_get_items_iter(client->session, BENCH_OPER_XPATH "/statistics//*", &iter);
+    if (SR_ERR_OK == rc) {
+        while (SR_ERR_OK == sr_get_item_next(client->session, iter, &value)) {
+            sr_free_val(value);
+        }
+        sr_free_val_iter(iter);
+    }
+    return rc;
+}
+
+static int
+bench_rpc_op(bench_client_t *client, size_t i)
+{
+    sr_val_t input = { 0, }, *output = NULL;
+    size_t output_cnt = 0;
+    int rc = SR_ERR_OK;
+
+    input.xpath = BENCH_RPC_XPATH "/image-name";
+    input.type = SR_STRING_T;
+    input.data.string_val = "acmefw-2.3";
+
+    rc = sr_rpc_send(client->session, BENCH_RPC_XPATH, &input, 1, &output, &output_cnt);
+    sr_free_values(output, output_cnt);
+    return rc;
+}
+
+static int
+bench_notif_op(bench_client_t *client, size_t i)
+{
+    sr_val_t values[4] = { { 0, }, };
+
+    values[0].xpath = BENCH_NOTIF_XPATH "/source/address";
+    values[0].type = SR_STRING_T;
+    values[0].data.string_val = "10.10.1.5";
+    values[1].xpath = BENCH_NOTIF_XPATH "/source/interface";
+    values[1].type = SR_STRING_T;
+    values[1].data.string_val = "eth1";
+    values[2].xpath = BENCH_NOTIF_XPATH "/destination/address";
+    values[2].type = SR_STRING_T;
+    values[2].data.string_val = "10.10.1.8";
+    values[3].xpath = BENCH_NOTIF_XPATH "/destination/interface";
+    values[3].type = SR_STRING_T;
+    values[3].data.string_val = "eth0";
+
+    return sr_event_notif_send(client->session, BENCH_NOTIF_XPATH, values, 4, SR_EV_NOTIF_EPHEMERAL);
+}
+
+static const bench_scenario_t bench_scenarios[] = {
+    { "get-item", "get one leaf", SR_DS_STARTUP, NULL, bench_get_item_op, NULL },
+    { "get-items", "iterate over leaves of all list entries", SR_DS_STARTUP, NULL, bench_get_items_op, NULL },
+    { "get-subtree", "get subtree of one list entry", SR_DS_STARTUP, NULL, bench_get_subtree_op, NULL },
+    { "commit", "set one leaf and commit, with K verifiers", SR_DS_RUNNING, bench_commit_setup, bench_set_commit_op, NULL },
+    { "mixed", "mix of get-item and commit given by the read ratio", SR_DS_RUNNING, bench_commit_setup, bench_mixed_op, NULL },
+    { "oper-data", "get operational data from a provider with N interfaces", SR_DS_RUNNING, bench_oper_setup, bench_oper_op, NULL },
+    { "rpc", "send RPC and wait for output", SR_DS_RUNNING, bench_rpc_setup, bench_rpc_op, NULL },
+    { "notif-fanout", "send event notification to F subscribers", SR_DS_RUNNING, bench_notif_setup, bench_notif_op, bench_notif_drain },
+};
+
+/* ---------------------------------------------------------------------------------------------- */
+/* runner */
+
+static void *
+bench_client_thread(void *arg)
+{
+    bench_client_t *client = (bench_client_t *)arg;
+    uint64_t start = 0;
+
+    for (size_t i = 0; i < client->ctx->opts->ops; i++) {
+        start = bench_now_ns();
+        if (SR_ERR_OK != client->scenario->op(client, i)) {
+            client->err_cnt++;
+        }
+        client->latencies[client->op_cnt++] = bench_now_ns() - start;
+    }
+    return NULL;
+}
+
+static int
+bench_uint64_cmp(const void *a, const void *b)
+{
+    uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Returns given percentile of sorted latencies in microseconds.
+ */
+static double
+bench_percentile(const uint64_t *sorted, size_t count, double percentile)
+{
+    size_t idx = 0;
+
+    if (0 == count) {
+        return 0;
+    }
+    idx = (size_t)(percentile * count + 0.999999);
+    idx = (idx > 0) ? idx - 1 : 0;
+    idx = (idx < count) ? idx : count - 1;
+    return sorted[idx] / 1000.0;
+}
+
+/**
+ * @brief Runs one scenario with given data size and fills in the results.
+ */
+static int
+bench_run(const bench_opts_t *opts, const bench_scenario_t *scenario, size_t size, bench_result_t *result)
+{
+    bench_ctx_t ctx = { 0, };
+    bench_client_t *clients = NULL;
+    uint64_t *all = NULL, start = 0, sum = 0;
+    size_t total = 0;
+    int rc = SR_ERR_OK;
+
+    ctx.opts = opts;
+    ctx.size = size;
+
+    clients = calloc(opts->clients, sizeof(*clients));
+    if (NULL == clients) {
+        return SR_ERR_NOMEM;
+    }
+
+    /* subscriber side */
+    rc = sr_connect("sysrepo-bench-subscriber", SR_CONN_DEFAULT, &ctx.conn);
+    if (SR_ERR_OK == rc) {
+        rc = sr_session_start(ctx.conn, SR_DS_RUNNING, SR_SESS_DEFAULT, &ctx.session);
+    }
+    if (SR_ERR_OK == rc && NULL != scenario->setup) {
+        rc = scenario->setup(&ctx);
+    }
+    if (SR_ERR_OK != rc) {
+        fprintf(stderr, "Setup of scenario '%s' failed: %s.\n", scenario->name, sr_strerror(rc));
+        goto cleanup;
+    }
+
+    /* clients */
+    for (size_t i = 0; i < opts->clients; i++) {
+        clients[i].ctx = &ctx;
+        clients[i].scenario = scenario;
+        clients[i].id = i;
+        clients[i].seed = (unsigned)(i + 1);
+        clients[i].latencies = calloc(opts->ops, sizeof(*clients[i].latencies));
+        if (NULL == clients[i].latencies) {
+            rc = SR_ERR_NOMEM;
+            goto cleanup;
+        }
+        rc = sr_connect("sysrepo-bench", SR_CONN_DEFAULT, &clients[i].conn);
+        if (SR_ERR_OK == rc) {
+            rc = sr_session_start(clients[i].conn, scenario->datastore, SR_SESS_DEFAULT, &clients[i].session);
+        }
+        if (SR_ERR_OK != rc) {
+            fprintf(stderr, "Unable to start client %zu: %s.\n", i, sr_strerror(rc));
+            goto cleanup;
+        }
+    }
+
+    /* measured part */
+    start = bench_now_ns();
+    for (size_t i = 0; i < opts->clients; i++) {
+        pthread_create(&clients[i].thread, NULL, bench_client_thread, &clients[i]);
+    }
+    for (size_t i = 0; i < opts->clients; i++) {
+        pthread_join(clients[i].thread, NULL);
+        total += clients[i].op_cnt;
+    }
+    if (NULL != scenario->drain) {
+        scenario->drain(&ctx, total);
+    }
+    result->seconds = (bench_now_ns() - start) / 1000000000.0;
+
+    /* statistics */
+    all = calloc(total ? total : 1, sizeof(*all));
+    if (NULL == all) {
+        rc = SR_ERR_NOMEM;
+        goto cleanup;
+    }
+    total = 0;
+    result->errors = 0;
+    for (size_t i = 0; i < opts->clients; i++) {
+        memcpy(all + total, clients[i].latencies, clients[i].op_cnt * sizeof(*all));
+        total += clients[i].op_cnt;
+        result->errors += clients[i].err_cnt;
+    }
+    qsort(all, total, sizeof(*all), bench_uint64_cmp);
+    for (size_t i = 0; i < total; i++) {
+        sum += all[i];
+    }
+
+    result->scenario = scenario->name;
+    result->size = size;
+    result->clients = opts->clients;
+    result->ops = total;
+    result->throughput = (result->seconds > 0) ? total / result->seconds : 0;
+    result->mean_us = total ? (sum / 1000.0) / total : 0;
+    result->p50_us = bench_percentile(all, total, 0.5);
+    result->p99_us = bench_percentile(all, total, 0.99);
+    result->p999_us = bench_percentile(all, total, 0.999);
+    result->max_us = total ? all[total - 1] / 1000.0 : 0;
+
+cleanup:
+    for (size_t i = 0; i < opts->clients; i++) {
+        if (NULL != clients[i].session) {
+            sr_session_stop(clients[i].session);
+        }
+        if (NULL != clients[i].conn) {
+            sr_disconnect(clients[i].conn);
+        }
+        free(clients[i].latencies);
+    }
+    free(clients);
+    free(all);
+    if (NULL != ctx.subscription) {
+        sr_unsubscribe(ctx.session, ctx.subscription);
+    }
+    if (NULL != ctx.session) {
+        sr_session_stop(ctx.session);
+    }
+    if (NULL != ctx.conn) {
+        sr_disconnect(ctx.conn);
+    }
+    return rc;
+}
+
+/**
+ * @brief Returns true if the scenario has been selected on the command line.
+ */
+static bool
+bench_scenario_selected(const bench_opts_t *opts, const char *name)
+{
+    const char *pos = NULL;
+    size_t len = strlen(name);
+
+    if (NULL == opts->scenarios) {
+        return true;
+    }
+    for (pos = strstr(opts->scenarios, name); NULL != pos; pos = strstr(pos + 1, name)) {
+        if ((pos == opts->scenarios || ',' == pos[-1]) && ('\0' == pos[len] || ',' == pos[len])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void
+bench_print_result(const bench_result_t *r)
+{
+    printf("%-14s %9zu %7zu %9zu %6zu %12.0f %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+            r->scenario, r->size, r->clients, r->ops, r->errors, r->throughput,
+            r->mean_us, r->p50_us, r->p99_us, r->p999_us, r->max_us);
+}
+
+static int
+bench_write_json(const bench_opts_t *opts, const bench_result_t *results, size_t result_cnt)
+{
+    FILE *file = fopen(opts->json_file, "w");
+    if (NULL == file) {
+        fprintf(stderr, "Unable to open the JSON output file '%s'.\n", opts->json_file);
+        return SR_ERR_IO;
+    }
+
+    fprintf(file, "{\n  \"benchmark\": \"sysrepo-bench\",\n  \"timestamp\": %lld,\n", (long long)time(NULL));
+    fprintf(file, "  \"config\": {\"clients\": %zu, \"ops_per_client\": %zu, \"read_ratio\": %u, "
+            "\"verifiers\": %zu, \"subscribers\": %zu},\n",
+            opts->clients, opts->ops, opts->read_ratio, opts->verifiers, opts->subscribers);
+    fprintf(file, "  \"results\": [\n");
+    for (size_t i = 0; i < result_cnt; i++) {
+        const bench_result_t *r = &results[i];
+        fprintf(file, "    {\"scenario\": \"%s\", \"size\": %zu, \"clients\": %zu, \"ops\": %zu, \"errors\": %zu, "
+                "\"seconds\": %.6f, \"throughput\": %.2f, \"latency_us\": {\"mean\": %.2f, \"p50\": %.2f, "
+                "\"p99\": %.2f, \"p999\": %.2f, \"max\": %.2f}}%s\n",
+                r->scenario, r->size, r->clients, r->ops, r->errors, r->seconds, r->throughput,
+                r->mean_us, r->p50_us, r->p99_us, r->p999_us, r->max_us, (i + 1 < result_cnt) ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    fclose(file);
+    return SR_ERR_OK;
+}
+
+static void
+bench_print_help()
+{
+    printf("Usage:\n");
+    printf("  sysrepo-bench [options]\n\n");
+    printf("Options:\n");
+    printf("  -s, --scenarios <list>   Comma-separated list of scenarios to run (default: all).\n");
+    printf("  -c, --clients <N>        Number of concurrent clients (default: 1).\n");
+    printf("  -n, --ops <N>            Number of operations per client (default: %d).\n", BENCH_DEFAULT_OPS);
+    printf("  -d, --sizes <list>       Comma-separated data sizes in list entries, %d-%d (default: 10,1000).\n",
+            BENCH_MIN_SIZE, BENCH_MAX_SIZE);
+    printf("  -r, --read-ratio <PCT>   Percentage of reads in the mixed scenario (default: %d).\n", BENCH_DEFAULT_READ_RATIO);
+    printf("  -k, --verifiers <K>      Number of verifiers subscribed for commits (default: 0).\n");
+    printf("  -f, --fanout <F>         Number of notification subscribers (default: 1).\n");
+    printf("  -j, --json <file>        Write machine-readable results into the file.\n");
+    printf("  -h, --help               Print this help.\n\n");
+    printf("Scenarios:\n");
+    for (size_t i = 0; i < sizeof(bench_scenarios) / sizeof(*bench_scenarios); i++) {
+        printf("  %-14s %s\n", bench_scenarios[i].name, bench_scenarios[i].description);
+    }
+}
+
+static int
+bench_parse_sizes(const char *arg, bench_opts_t *opts)
+{
+    char *end = NULL;
+
+    opts->size_cnt = 0;
+    while ('\0' != *arg && opts->size_cnt < BENCH_MAX_SIZES) {
+        unsigned long long size = strtoull(arg, &end, 10);
+        if (end == arg || size < BENCH_MIN_SIZE || size > BENCH_MAX_SIZE) {
+            return -1;
+        }
+        opts->sizes[opts->size_cnt++] = (size_t)size;
+        arg = (',' == *end) ? end + 1 : end;
+        if (',' != end[0] && '\0' != end[0]) {
+            return -1;
+        }
+    }
+    return (0 == opts->size_cnt) ? -1 : 0;
+}
+
+int
+main(int argc, char **argv)
+{
+    bench_opts_t opts = { 0, };
+    bench_result_t *results = NULL;
+    size_t result_cnt = 0, scenario_cnt = sizeof(bench_scenarios) / sizeof(*bench_scenarios);
+    int c = 0, rc = SR_ERR_OK;
+
+    struct option longopts[] = {
+       { "scenarios",  required_argument, NULL, 's' },
+       { "clients",    required_argument, NULL, 'c' },
+       { "ops",        required_argument, NULL, 'n' },
+       { "sizes",      required_argument, NULL, 'd' },
+       { "read-ratio", required_argument, NULL, 'r' },
+       { "verifiers",  required_argument, NULL, 'k' },
+       { "fanout",     required_argument, NULL, 'f' },
+       { "json",       required_argument, NULL, 'j' },
+       { "help",       no_argument,       NULL, 'h' },
+       { 0, 0, 0, 0 }
+    };
+
+    opts.clients = 1;
+    opts.ops = BENCH_DEFAULT_OPS;
+    opts.read_ratio = BENCH_DEFAULT_READ_RATIO;
+    opts.subscribers = 1;
+    opts.sizes[0] = 10;
+    opts.sizes[1] = 1000;
+    opts.size_cnt = 2;
+
+    while ((c = getopt_long(argc, argv, "s:c:n:d:r:k:f:j:h", longopts, NULL)) != -1) {
+        switch (c) {
+            case 's':
+                opts.scenarios = optarg;
+                break;
+            case 'c':
+                opts.clients = strtoul(optarg, NULL, 10);
+                break;
+            case 'n':
+                opts.ops = strtoul(optarg, NULL, 10);
+                break;
+            case 'd':
+                if (0 != bench_parse_sizes(optarg, &opts)) {
+                    fprintf(stderr, "Invalid data sizes '%s'.\n", optarg);
+                    return EXIT_FAILURE;
+                }
+                break;
+            case 'r':
+                opts.read_ratio = (unsigned)strtoul(optarg, NULL, 10);
+                break;
+            case 'k':
+                opts.verifiers = strtoul(optarg, NULL, 10);
+                break;
+            case 'f':
+                opts.subscribers = strtoul(optarg, NULL, 10);
+                break;
+            case 'j':
+                opts.json_file = optarg;
+                break;
+            case 'h':
+                bench_print_help();
+                return EXIT_SUCCESS;
+            default:
+                bench_print_help();
+                return EXIT_FAILURE;
+        }
+    }
+    if (0 == opts.clients || 0 == opts.ops || opts.read_ratio > 100) {
+        fprintf(stderr, "Invalid arguments.\n");
+        return EXIT_FAILURE;
+    }
+
+    results = calloc(opts.size_cnt * scenario_cnt, sizeof(*results));
+    if (NULL == results) {
+        return EXIT_FAILURE;
+    }
+
+    /* turn off all logging */
+    sr_log_stderr(SR_LL_NONE);
+    sr_log_syslog(SR_LL_NONE);
+
+    printf("%-14s %9s %7s %9s %6s %12s %10s %10s %10s %10s %10s\n", "scenario", "size", "clients", "ops", "errors",
+            "ops/sec", "mean[us]", "p50[us]", "p99[us]", "p999[us]", "max[us]");
+    for (size_t s = 0; s < opts.size_cnt; s++) {
+        rc = bench_create_data(opts.sizes[s]);
+        if (SR_ERR_OK != rc) {
+            break;
+        }
+        for (size_t i = 0; i < scenario_cnt; i++) {
+            if (!bench_scenario_selected(&opts, bench_scenarios[i].name)) {
+                continue;
+            }
+            rc = bench_run(&opts, &bench_scenarios[i], opts.sizes[s], &results[result_cnt]);
+            if (SR_ERR_OK != rc) {
+                break;
+            }
+            bench_print_result(&results[result_cnt++]);
+        }
+        if (SR_ERR_OK != rc) {
+            break;
+        }
+    }
+
+    if (NULL != opts.json_file && 0 != result_cnt) {
+        bench_write_json(&opts, results, result_cnt);
+    }
+    free(results);
+
+    /* restore the original data */
+    createDataTreeExampleModule();
+
+    return (SR_ERR_OK == rc) ? EXIT_SUCCESS : EXIT_FAILURE;
+}